@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/chunk_store_test.dir/test/chunk_store_test.cpp.o"
+  "CMakeFiles/chunk_store_test.dir/test/chunk_store_test.cpp.o.d"
+  "chunk_store_test"
+  "chunk_store_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/chunk_store_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
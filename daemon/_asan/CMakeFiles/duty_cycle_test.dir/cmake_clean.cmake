@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/duty_cycle_test.dir/test/duty_cycle_test.cpp.o"
+  "CMakeFiles/duty_cycle_test.dir/test/duty_cycle_test.cpp.o.d"
+  "duty_cycle_test"
+  "duty_cycle_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/duty_cycle_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
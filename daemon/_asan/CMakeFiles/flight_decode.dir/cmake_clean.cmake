@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/flight_decode.dir/tools/flight_decode.cpp.o"
+  "CMakeFiles/flight_decode.dir/tools/flight_decode.cpp.o.d"
+  "flight_decode"
+  "flight_decode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/flight_decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
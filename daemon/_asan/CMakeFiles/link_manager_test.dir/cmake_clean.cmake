@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/link_manager_test.dir/test/link_manager_test.cpp.o"
+  "CMakeFiles/link_manager_test.dir/test/link_manager_test.cpp.o.d"
+  "link_manager_test"
+  "link_manager_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/link_manager_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
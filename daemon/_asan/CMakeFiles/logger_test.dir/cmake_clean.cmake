@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/logger_test.dir/test/logger_test.cpp.o"
+  "CMakeFiles/logger_test.dir/test/logger_test.cpp.o.d"
+  "logger_test"
+  "logger_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/logger_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/loopback_test.dir/test/loopback_test.cpp.o"
+  "CMakeFiles/loopback_test.dir/test/loopback_test.cpp.o.d"
+  "loopback_test"
+  "loopback_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/loopback_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
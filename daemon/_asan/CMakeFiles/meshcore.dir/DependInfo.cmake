@@ -0,0 +1,55 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/daemon/src/meshcore_bridge.c" "CMakeFiles/meshcore.dir/src/meshcore_bridge.c.o" "gcc" "CMakeFiles/meshcore.dir/src/meshcore_bridge.c.o.d"
+  "/root/repo/daemon/src/admission.cpp" "CMakeFiles/meshcore.dir/src/admission.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/admission.cpp.o.d"
+  "/root/repo/daemon/src/archive.cpp" "CMakeFiles/meshcore.dir/src/archive.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/archive.cpp.o.d"
+  "/root/repo/daemon/src/attachment_transfer.cpp" "CMakeFiles/meshcore.dir/src/attachment_transfer.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/attachment_transfer.cpp.o.d"
+  "/root/repo/daemon/src/blake2s.cpp" "CMakeFiles/meshcore.dir/src/blake2s.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/blake2s.cpp.o.d"
+  "/root/repo/daemon/src/chacha20_poly1305.cpp" "CMakeFiles/meshcore.dir/src/chacha20_poly1305.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/chacha20_poly1305.cpp.o.d"
+  "/root/repo/daemon/src/chunk_store.cpp" "CMakeFiles/meshcore.dir/src/chunk_store.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/chunk_store.cpp.o.d"
+  "/root/repo/daemon/src/congestion.cpp" "CMakeFiles/meshcore.dir/src/congestion.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/congestion.cpp.o.d"
+  "/root/repo/daemon/src/contact_directory.cpp" "CMakeFiles/meshcore.dir/src/contact_directory.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/contact_directory.cpp.o.d"
+  "/root/repo/daemon/src/conversation_table.cpp" "CMakeFiles/meshcore.dir/src/conversation_table.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/conversation_table.cpp.o.d"
+  "/root/repo/daemon/src/crc32.cpp" "CMakeFiles/meshcore.dir/src/crc32.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/crc32.cpp.o.d"
+  "/root/repo/daemon/src/daemon.cpp" "CMakeFiles/meshcore.dir/src/daemon.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/daemon.cpp.o.d"
+  "/root/repo/daemon/src/duty_cycle.cpp" "CMakeFiles/meshcore.dir/src/duty_cycle.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/duty_cycle.cpp.o.d"
+  "/root/repo/daemon/src/ed25519.cpp" "CMakeFiles/meshcore.dir/src/ed25519.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/ed25519.cpp.o.d"
+  "/root/repo/daemon/src/flight_recorder.cpp" "CMakeFiles/meshcore.dir/src/flight_recorder.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/flight_recorder.cpp.o.d"
+  "/root/repo/daemon/src/frame_pool.cpp" "CMakeFiles/meshcore.dir/src/frame_pool.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/frame_pool.cpp.o.d"
+  "/root/repo/daemon/src/handshake.cpp" "CMakeFiles/meshcore.dir/src/handshake.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/handshake.cpp.o.d"
+  "/root/repo/daemon/src/hibernation.cpp" "CMakeFiles/meshcore.dir/src/hibernation.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/hibernation.cpp.o.d"
+  "/root/repo/daemon/src/ingress.cpp" "CMakeFiles/meshcore.dir/src/ingress.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/ingress.cpp.o.d"
+  "/root/repo/daemon/src/link_manager.cpp" "CMakeFiles/meshcore.dir/src/link_manager.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/link_manager.cpp.o.d"
+  "/root/repo/daemon/src/logger.cpp" "CMakeFiles/meshcore.dir/src/logger.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/logger.cpp.o.d"
+  "/root/repo/daemon/src/loopback_transport.cpp" "CMakeFiles/meshcore.dir/src/loopback_transport.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/loopback_transport.cpp.o.d"
+  "/root/repo/daemon/src/lz_codec.cpp" "CMakeFiles/meshcore.dir/src/lz_codec.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/lz_codec.cpp.o.d"
+  "/root/repo/daemon/src/meshcore_impl.cpp" "CMakeFiles/meshcore.dir/src/meshcore_impl.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/meshcore_impl.cpp.o.d"
+  "/root/repo/daemon/src/message_store.cpp" "CMakeFiles/meshcore.dir/src/message_store.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/message_store.cpp.o.d"
+  "/root/repo/daemon/src/metrics.cpp" "CMakeFiles/meshcore.dir/src/metrics.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/metrics.cpp.o.d"
+  "/root/repo/daemon/src/offload_pool.cpp" "CMakeFiles/meshcore.dir/src/offload_pool.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/offload_pool.cpp.o.d"
+  "/root/repo/daemon/src/random.cpp" "CMakeFiles/meshcore.dir/src/random.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/random.cpp.o.d"
+  "/root/repo/daemon/src/scan_filter.cpp" "CMakeFiles/meshcore.dir/src/scan_filter.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/scan_filter.cpp.o.d"
+  "/root/repo/daemon/src/session_cache.cpp" "CMakeFiles/meshcore.dir/src/session_cache.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/session_cache.cpp.o.d"
+  "/root/repo/daemon/src/sha512.cpp" "CMakeFiles/meshcore.dir/src/sha512.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/sha512.cpp.o.d"
+  "/root/repo/daemon/src/signature_verifier.cpp" "CMakeFiles/meshcore.dir/src/signature_verifier.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/signature_verifier.cpp.o.d"
+  "/root/repo/daemon/src/snapshot.cpp" "CMakeFiles/meshcore.dir/src/snapshot.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/snapshot.cpp.o.d"
+  "/root/repo/daemon/src/task_scheduler.cpp" "CMakeFiles/meshcore.dir/src/task_scheduler.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/task_scheduler.cpp.o.d"
+  "/root/repo/daemon/src/tracer.cpp" "CMakeFiles/meshcore.dir/src/tracer.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/tracer.cpp.o.d"
+  "/root/repo/daemon/src/watchdog.cpp" "CMakeFiles/meshcore.dir/src/watchdog.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/watchdog.cpp.o.d"
+  "/root/repo/daemon/src/x25519.cpp" "CMakeFiles/meshcore.dir/src/x25519.cpp.o" "gcc" "CMakeFiles/meshcore.dir/src/x25519.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,83 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/meshcore.dir/src/admission.cpp.o"
+  "CMakeFiles/meshcore.dir/src/admission.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/archive.cpp.o"
+  "CMakeFiles/meshcore.dir/src/archive.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/attachment_transfer.cpp.o"
+  "CMakeFiles/meshcore.dir/src/attachment_transfer.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/blake2s.cpp.o"
+  "CMakeFiles/meshcore.dir/src/blake2s.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/chacha20_poly1305.cpp.o"
+  "CMakeFiles/meshcore.dir/src/chacha20_poly1305.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/chunk_store.cpp.o"
+  "CMakeFiles/meshcore.dir/src/chunk_store.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/congestion.cpp.o"
+  "CMakeFiles/meshcore.dir/src/congestion.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/contact_directory.cpp.o"
+  "CMakeFiles/meshcore.dir/src/contact_directory.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/conversation_table.cpp.o"
+  "CMakeFiles/meshcore.dir/src/conversation_table.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/crc32.cpp.o"
+  "CMakeFiles/meshcore.dir/src/crc32.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/daemon.cpp.o"
+  "CMakeFiles/meshcore.dir/src/daemon.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/duty_cycle.cpp.o"
+  "CMakeFiles/meshcore.dir/src/duty_cycle.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/ed25519.cpp.o"
+  "CMakeFiles/meshcore.dir/src/ed25519.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/flight_recorder.cpp.o"
+  "CMakeFiles/meshcore.dir/src/flight_recorder.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/frame_pool.cpp.o"
+  "CMakeFiles/meshcore.dir/src/frame_pool.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/handshake.cpp.o"
+  "CMakeFiles/meshcore.dir/src/handshake.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/hibernation.cpp.o"
+  "CMakeFiles/meshcore.dir/src/hibernation.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/ingress.cpp.o"
+  "CMakeFiles/meshcore.dir/src/ingress.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/link_manager.cpp.o"
+  "CMakeFiles/meshcore.dir/src/link_manager.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/logger.cpp.o"
+  "CMakeFiles/meshcore.dir/src/logger.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/loopback_transport.cpp.o"
+  "CMakeFiles/meshcore.dir/src/loopback_transport.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/lz_codec.cpp.o"
+  "CMakeFiles/meshcore.dir/src/lz_codec.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/meshcore_bridge.c.o"
+  "CMakeFiles/meshcore.dir/src/meshcore_bridge.c.o.d"
+  "CMakeFiles/meshcore.dir/src/meshcore_impl.cpp.o"
+  "CMakeFiles/meshcore.dir/src/meshcore_impl.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/message_store.cpp.o"
+  "CMakeFiles/meshcore.dir/src/message_store.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/metrics.cpp.o"
+  "CMakeFiles/meshcore.dir/src/metrics.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/offload_pool.cpp.o"
+  "CMakeFiles/meshcore.dir/src/offload_pool.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/random.cpp.o"
+  "CMakeFiles/meshcore.dir/src/random.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/scan_filter.cpp.o"
+  "CMakeFiles/meshcore.dir/src/scan_filter.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/session_cache.cpp.o"
+  "CMakeFiles/meshcore.dir/src/session_cache.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/sha512.cpp.o"
+  "CMakeFiles/meshcore.dir/src/sha512.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/signature_verifier.cpp.o"
+  "CMakeFiles/meshcore.dir/src/signature_verifier.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/snapshot.cpp.o"
+  "CMakeFiles/meshcore.dir/src/snapshot.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/task_scheduler.cpp.o"
+  "CMakeFiles/meshcore.dir/src/task_scheduler.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/tracer.cpp.o"
+  "CMakeFiles/meshcore.dir/src/tracer.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/watchdog.cpp.o"
+  "CMakeFiles/meshcore.dir/src/watchdog.cpp.o.d"
+  "CMakeFiles/meshcore.dir/src/x25519.cpp.o"
+  "CMakeFiles/meshcore.dir/src/x25519.cpp.o.d"
+  "libmeshcore.a"
+  "libmeshcore.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/meshcore.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
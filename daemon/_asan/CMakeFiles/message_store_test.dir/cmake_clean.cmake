@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/message_store_test.dir/test/message_store_test.cpp.o"
+  "CMakeFiles/message_store_test.dir/test/message_store_test.cpp.o.d"
+  "message_store_test"
+  "message_store_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/message_store_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/offload_pool_test.dir/test/offload_pool_test.cpp.o"
+  "CMakeFiles/offload_pool_test.dir/test/offload_pool_test.cpp.o.d"
+  "offload_pool_test"
+  "offload_pool_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/offload_pool_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
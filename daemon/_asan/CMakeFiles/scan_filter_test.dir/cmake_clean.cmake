@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scan_filter_test.dir/test/scan_filter_test.cpp.o"
+  "CMakeFiles/scan_filter_test.dir/test/scan_filter_test.cpp.o.d"
+  "scan_filter_test"
+  "scan_filter_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scan_filter_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/congestion_test.dir/test/congestion_test.cpp.o"
+  "CMakeFiles/congestion_test.dir/test/congestion_test.cpp.o.d"
+  "congestion_test"
+  "congestion_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/congestion_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
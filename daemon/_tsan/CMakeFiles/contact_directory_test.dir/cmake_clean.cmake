@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/contact_directory_test.dir/test/contact_directory_test.cpp.o"
+  "CMakeFiles/contact_directory_test.dir/test/contact_directory_test.cpp.o.d"
+  "contact_directory_test"
+  "contact_directory_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/contact_directory_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/conversation_table_test.dir/test/conversation_table_test.cpp.o"
+  "CMakeFiles/conversation_table_test.dir/test/conversation_table_test.cpp.o.d"
+  "conversation_table_test"
+  "conversation_table_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/conversation_table_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/daemon_policies_bench.dir/bench/daemon_policies_bench.cpp.o"
+  "CMakeFiles/daemon_policies_bench.dir/bench/daemon_policies_bench.cpp.o.d"
+  "daemon_policies_bench"
+  "daemon_policies_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/daemon_policies_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/daemon_policies_test.dir/test/daemon_policies_test.cpp.o"
+  "CMakeFiles/daemon_policies_test.dir/test/daemon_policies_test.cpp.o.d"
+  "daemon_policies_test"
+  "daemon_policies_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/daemon_policies_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/daemon_task_test.dir/test/daemon_task_test.cpp.o"
+  "CMakeFiles/daemon_task_test.dir/test/daemon_task_test.cpp.o.d"
+  "daemon_task_test"
+  "daemon_task_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/daemon_task_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/handshake_bench.dir/bench/handshake_bench.cpp.o"
+  "CMakeFiles/handshake_bench.dir/bench/handshake_bench.cpp.o.d"
+  "handshake_bench"
+  "handshake_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/handshake_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
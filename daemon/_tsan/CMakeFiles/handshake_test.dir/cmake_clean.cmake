@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/handshake_test.dir/test/handshake_test.cpp.o"
+  "CMakeFiles/handshake_test.dir/test/handshake_test.cpp.o.d"
+  "handshake_test"
+  "handshake_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/handshake_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
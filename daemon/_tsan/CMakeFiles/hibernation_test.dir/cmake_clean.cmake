@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hibernation_test.dir/test/hibernation_test.cpp.o"
+  "CMakeFiles/hibernation_test.dir/test/hibernation_test.cpp.o.d"
+  "hibernation_test"
+  "hibernation_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hibernation_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
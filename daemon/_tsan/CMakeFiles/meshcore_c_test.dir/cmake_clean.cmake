@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/meshcore_c_test.dir/test/meshcore_c_test.c.o"
+  "CMakeFiles/meshcore_c_test.dir/test/meshcore_c_test.c.o.d"
+  "meshcore_c_test"
+  "meshcore_c_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/meshcore_c_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/snapshot_test.dir/test/snapshot_test.cpp.o"
+  "CMakeFiles/snapshot_test.dir/test/snapshot_test.cpp.o.d"
+  "snapshot_test"
+  "snapshot_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/snapshot_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/task_bench.dir/bench/task_bench.cpp.o"
+  "CMakeFiles/task_bench.dir/bench/task_bench.cpp.o.d"
+  "task_bench"
+  "task_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/task_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
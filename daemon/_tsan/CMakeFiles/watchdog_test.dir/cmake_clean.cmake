@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/watchdog_test.dir/test/watchdog_test.cpp.o"
+  "CMakeFiles/watchdog_test.dir/test/watchdog_test.cpp.o.d"
+  "watchdog_test"
+  "watchdog_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/watchdog_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,81 @@
+/**
+ * Daemon Policies Benchmark
+ *
+ * Inbound message throughput (enqueue to on_message) for the default
+ * configuration and for builds that swap in stdout logging, the ring
+ * queue, the spin lock and the compiled-out logger.
+ */
+
+#include "daemon.h"
+#include "basic_daemon_impl.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int kMessages = 50000;
+static constexpr int kWindow   = 512;   // stays under the ingress backlog
+
+template <typename D>
+static double run(const char* label) {
+    // Keep StdoutLogger's output out of the measurement's terminal
+    std::ostringstream sink;
+    std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+
+    D daemon;
+    AdmissionConfig unlimited;
+    unlimited.frames_per_sec = 0;
+    unlimited.bytes_per_sec = 0;
+    daemon.set_admission_config(unlimited);
+    std::atomic<int> received(0);
+    DaemonCallbacks callbacks;
+    callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) { received++; };
+    daemon.set_callbacks(callbacks);
+    daemon.start();
+
+    typename D::Event connect;
+    connect.type = D::EventType::PeerConnected;
+    connect.peer_id = 1;
+    connect.peer_uid = "bench-peer";
+    daemon.enqueue_event(std::move(connect));
+
+    const auto start = Clock::now();
+    for (int i = 0; i < kMessages; ++i) {
+        while (i - received.load() >= kWindow) {
+            std::this_thread::yield();
+        }
+        typename D::Event event;
+        event.type = D::EventType::DataReceived;
+        event.peer_id = 1;
+        event.data = "benchmark payload";
+        daemon.enqueue_event(std::move(event));
+    }
+    while (received < kMessages) {
+        std::this_thread::yield();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    daemon.stop();
+
+    std::cout.rdbuf(saved);
+    const double rate = kMessages / seconds;
+    std::printf("  %-34s %10.0f msg/s\n", label, rate);
+    return rate;
+}
+
+int main() {
+    std::printf("=== Daemon Policies Benchmark (%d messages) ===\n\n", kMessages);
+
+    const double base = run<Daemon>("StdQueue + StdSync + async log");
+    run<BasicDaemon<StdoutLogger>>("StdQueue + StdSync + stdout");
+    run<BasicDaemon<NullLogger>>("StdQueue + StdSync + NullLogger");
+    run<BasicDaemon<RingQueue, NullLogger>>("RingQueue + StdSync + NullLogger");
+    const double best = run<BasicDaemon<RingQueue, SpinSync, NullLogger>>("RingQueue + SpinSync + NullLogger");
+
+    std::printf("\n  speedup over default: %.2fx\n", best / base);
+    return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * Handshake Benchmark
+ *
+ * Reconnect-to-first-message latency with a full handshake versus a
+ * 0-RTT resumption, over links with different one-way delays.
+ */
+
+#include "daemon.h"
+#include "transport.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Delivers frames to the other daemon after a fixed one-way delay
+ */
+class DelayedTransport : public Transport {
+public:
+    DelayedTransport(uint64_t as_peer, std::chrono::microseconds delay)
+        : remote_(nullptr), as_peer_(as_peer), delay_(delay), running_(true),
+          thread_([this] { run(); }) {}
+
+    ~DelayedTransport() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+
+    void connect_to(Daemon* remote) { remote_ = remote; }
+
+    void send(uint64_t, const std::string& data) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.emplace_back(Clock::now() + delay_, data);
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_) {
+            if (queue_.empty()) {
+                cv_.wait(lock);
+                continue;
+            }
+            if (Clock::now() < queue_.front().first) {
+                cv_.wait_until(lock, queue_.front().first);
+                continue;
+            }
+            Daemon::Event event;
+            event.type = Daemon::EventType::DataReceived;
+            event.peer_id = as_peer_;
+            event.data = std::move(queue_.front().second);
+            queue_.pop_front();
+            lock.unlock();
+            remote_->enqueue_event(std::move(event));
+            lock.lock();
+        }
+    }
+
+    Daemon* remote_;
+    uint64_t as_peer_;
+    std::chrono::microseconds delay_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::pair<Clock::time_point, std::string>> queue_;
+    bool running_;
+    std::thread thread_;
+};
+
+static void peer_event(Daemon& d, Daemon::EventType type, uint64_t peer_id, const std::string& uid) {
+    Daemon::Event event;
+    event.type = type;
+    event.peer_id = peer_id;
+    event.peer_uid = uid;
+    d.enqueue_event(std::move(event));
+}
+
+int main() {
+    std::printf("=== Handshake Benchmark ===\n\n");
+    std::printf("%-10s %14s %14s\n", "one-way", "full ms", "resumed ms");
+
+    const int kRounds = 20;
+    for (int delay_ms : { 0, 10, 50 }) {
+        const auto delay = std::chrono::milliseconds(delay_ms);
+        Daemon alice;
+        Daemon bob;
+        DelayedTransport to_bob(1, delay);      // Destroyed first: no delivery to a dead daemon
+        DelayedTransport to_alice(2, delay);
+        alice.set_transport(&to_bob);
+        bob.set_transport(&to_alice);
+        to_bob.connect_to(&bob);
+        to_alice.connect_to(&alice);
+
+        std::atomic<bool> received(false);
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) {
+            received = true;
+        };
+        bob.set_callbacks(callbacks);
+        alice.start();
+        bob.start();
+
+        // Time from connect to bob seeing the first message; waits out the
+        // rest of the exchange so the next round starts from a clean state
+        auto reconnect = [&](const std::string& uid) {
+            peer_event(bob, Daemon::EventType::PeerConnected, 1, "alice");
+            peer_event(alice, Daemon::EventType::PeerConnected, 2, uid);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            received = false;
+            const auto t0 = Clock::now();
+            alice.start_handshake(2);
+            Daemon::Event send;
+            send.type = Daemon::EventType::SendMessage;
+            send.peer_id = 2;
+            send.data = "hello";
+            alice.enqueue_event(std::move(send));
+            while (!received) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            std::this_thread::sleep_for(delay * 3 + std::chrono::milliseconds(5));
+            peer_event(alice, Daemon::EventType::PeerDisconnected, 2, uid);
+            peer_event(bob, Daemon::EventType::PeerDisconnected, 1, "alice");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            return ms;
+        };
+
+        double full = 0;
+        double resumed = 0;
+        for (int i = 0; i < kRounds; ++i) {
+            full += reconnect("fresh-" + std::to_string(delay_ms) + "-" + std::to_string(i));
+        }
+        reconnect("bob");   // Obtain the first ticket
+        for (int i = 0; i < kRounds; ++i) {
+            resumed += reconnect("bob");
+        }
+
+        const HandshakeStats stats = alice.handshake_stats();
+        std::printf("%-10s %14.2f %14.2f   (full %llu, resumed %llu)\n",
+                    (std::to_string(delay_ms) + " ms").c_str(), full / kRounds, resumed / kRounds,
+                    static_cast<unsigned long long>(stats.full),
+                    static_cast<unsigned long long>(stats.resumed));
+
+        alice.stop();
+        bob.stop();
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * Verification Benchmark
+ *
+ * Per-signature cost of one-at-a-time versus batched Ed25519
+ * verification, and end-to-end latency through the verifier pool.
+ */
+
+#include "ed25519.h"
+#include "signature_verifier.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main() {
+    std::printf("=== Verification Benchmark ===\n\n");
+
+    const size_t kSignatures = 256;
+    std::vector<std::string> frames;
+    for (size_t i = 0; i < kSignatures; ++i) {
+        uint8_t seed[32] = { static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8), 0x5A };
+        frames.push_back(SignatureVerifier::sign_frame(SigningKey::from_seed(seed),
+                                                       std::string(140, 'a' + i % 26)));
+    }
+
+    auto item_of = [](const std::string& f) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(f.data());
+        return Ed25519BatchItem{ p + 4, p + kSignedOverhead, f.size() - kSignedOverhead, p + 36 };
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (const auto& f : frames) {
+        Ed25519BatchItem it = item_of(f);
+        ed25519_verify(it.public_key, it.message, it.length, it.signature);
+    }
+    const double single_us =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / kSignatures;
+    std::printf("%-10s %10s\n", "batch", "us/sig");
+    std::printf("%-10d %10.1f\n", 1, single_us);
+
+    for (size_t batch : { 4, 16, 64, 128 }) {
+        std::vector<Ed25519BatchItem> items;
+        std::vector<uint8_t> valid(batch);
+        auto b0 = std::chrono::steady_clock::now();
+        for (size_t start = 0; start + batch <= kSignatures; start += batch) {
+            items.clear();
+            for (size_t i = start; i < start + batch; ++i) {
+                items.push_back(item_of(frames[i]));
+            }
+            ed25519_verify_batch(items.data(), items.size(), reinterpret_cast<bool*>(valid.data()));
+        }
+        const size_t done = (kSignatures / batch) * batch;
+        const double us =
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - b0).count() / done;
+        std::printf("%-10zu %10.1f  (%.1fx)\n", batch, us, single_us / us);
+    }
+
+    std::printf("\n%-12s %-10s %10s %10s %12s\n", "budget", "rate/s", "batches", "over", "max lat us");
+    for (int budget_ms : { 2, 5, 20 }) {
+        for (int rate : { 500, 2000 }) {
+            VerifierConfig config;
+            config.latency_budget = std::chrono::milliseconds(budget_ms);
+            config.threads = 2;
+            std::atomic<int> done(0);
+            VerifierStats stats;
+            {
+                SignatureVerifier verifier(config, [&](uint64_t, uint64_t, std::string&&, const SignerKey&, bool) { done++; });
+                const auto gap = std::chrono::microseconds(1000000 / rate);
+                auto next = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < kSignatures; ++i) {
+                    verifier.submit(1, i, std::string(frames[i]));
+                    next += gap;
+                    std::this_thread::sleep_until(next);
+                }
+                while (done < static_cast<int>(kSignatures)) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                stats = verifier.stats();
+            }
+            std::printf("%-12d %-10d %10llu %10llu %12llu\n", budget_ms, rate,
+                        static_cast<unsigned long long>(stats.batches),
+                        static_cast<unsigned long long>(stats.over_budget),
+                        static_cast<unsigned long long>(stats.max_latency_us));
+        }
+    }
+    return 0;
+}
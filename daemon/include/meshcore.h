@@ -108,6 +108,9 @@ typedef enum {
     MESHCORE_ERROR_MESSAGE_TOO_LONG = -3,
     MESHCORE_ERROR_PEER_NOT_FOUND = -4,
     MESHCORE_ERROR_QUEUE_FULL = -5,
+    MESHCORE_ERROR_STORAGE = -6,
+    MESHCORE_ERROR_CANCELLED = -7,
+    MESHCORE_ERROR_CORRUPT = -8,
     MESHCORE_ERROR_UNKNOWN = -99
 } meshcore_error;
 
@@ -131,6 +134,30 @@ typedef enum {
  */
 meshcore* meshcore_create(void);
 
+/**
+ * Create a mesh core instance with warm-restart snapshots
+ *
+ * If a valid snapshot exists at snapshot_path, known peers and their
+ * sequence numbers are restored before the daemon starts. A corrupt or
+ * missing snapshot is ignored (the core starts empty). While running,
+ * state is snapshotted every interval_ms on a background thread, and
+ * once more on destroy.
+ *
+ * @param snapshot_path File to restore from and write to
+ * @param interval_ms   Snapshot period (0 = only on destroy/explicit save)
+ * @return Handle to the core, or NULL on failure
+ */
+meshcore* meshcore_create_with_snapshot(const char* snapshot_path, uint32_t interval_ms);
+
+/**
+ * Write a snapshot now (e.g. when the app moves to the background)
+ *
+ * @param core Handle to the core
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_STORAGE on write failure
+ *         or if the core was created without a snapshot path
+ */
+meshcore_error meshcore_save_snapshot(meshcore* core);
+
 /**
  * Destroy a mesh core instance and free resources
  *
@@ -160,8 +187,8 @@ const char* meshcore_get_version(void);
 /**
  * Set callbacks for receiving events
  *
- * Call with NULL callbacks to unregister.
- * Must be called before start or after stop (not while running).
+ * Call with NULL callbacks to unregister. May be called while running:
+ * callbacks already in progress finish, later ones use the new set.
  *
  * @param core      Handle to the core
  * @param callbacks Pointer to callbacks struct (copied internally)
@@ -206,6 +233,1527 @@ meshcore_error meshcore_send_message_to_uid(
     size_t message_len
 );
 
+// =============================================================================
+// MARK: - Message Store
+// =============================================================================
+
+/**
+ * Retention rules for a conversation (0 = unlimited)
+ */
+typedef struct {
+    int64_t  max_age_ms;    // Drop messages older than this
+    uint32_t max_count;     // Keep at most this many messages
+    bool     drop_expired;  // Drop messages past their expiry time
+} meshcore_retention_policy;
+
+/**
+ * Background compaction counters
+ */
+typedef struct {
+    uint64_t bytes_reclaimed;     // Total bytes freed on disk
+    uint64_t records_dropped;     // Messages removed by retention/deletion
+    uint64_t segments_rewritten;  // Log segments compacted or deleted
+    uint64_t disk_bytes;          // Current on-disk size of the store
+} meshcore_compaction_stats;
+
+/**
+ * Open (or create) the persistent message store
+ *
+ * Sent and received messages are appended from then on. Retention and
+ * compaction run in small slices on the worker while it is idle.
+ *
+ * @param core      Handle to the core
+ * @param directory Directory holding the log segments
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_STORAGE if it cannot be opened
+ */
+meshcore_error meshcore_open_store(meshcore* core, const char* directory);
+
+/**
+ * Set the retention policy for a conversation
+ *
+ * @param core   Handle to the core
+ * @param uid    Conversation (peer UID), or NULL to set the default policy
+ * @param policy Policy to apply (copied)
+ * @return MESHCORE_OK on success, error code on failure
+ */
+meshcore_error meshcore_set_retention_policy(
+    meshcore* core,
+    const char* uid,
+    const meshcore_retention_policy* policy
+);
+
+/**
+ * Delete every stored message of a conversation
+ *
+ * @param core Handle to the core
+ * @param uid  Conversation (peer UID)
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_PEER_NOT_FOUND if unknown
+ */
+meshcore_error meshcore_delete_conversation(meshcore* core, const char* uid);
+
+/**
+ * Get compaction counters
+ *
+ * @param core  Handle to the core
+ * @param stats Receives the counters
+ * @return MESHCORE_OK on success, error code on failure
+ */
+meshcore_error meshcore_get_compaction_stats(const meshcore* core, meshcore_compaction_stats* stats);
+
+// =============================================================================
+// MARK: - History Archive
+// =============================================================================
+
+/**
+ * Progress callback for archive export/import
+ *
+ * Invoked on the calling thread about once per 256 KiB block.
+ *
+ * @param user_data   User-provided context pointer
+ * @param messages    Messages processed so far
+ * @param bytes_done  Bytes processed so far
+ * @param bytes_total Estimated total (0 if unknown)
+ * @return false to cancel
+ */
+typedef bool (*meshcore_progress_callback)(
+    void* user_data,
+    uint64_t messages,
+    uint64_t bytes_done,
+    uint64_t bytes_total
+);
+
+/**
+ * Export the whole message store to a single archive file
+ *
+ * Streams sequentially with bounded memory. The file appears atomically
+ * once complete; a cancelled or failed export leaves nothing behind.
+ *
+ * @param core      Handle to the core
+ * @param path      Destination file
+ * @param compress  Compress blocks (incompressible blocks are stored as-is)
+ * @param progress  Optional progress callback
+ * @param user_data Context pointer passed to the callback
+ * @return MESHCORE_OK, MESHCORE_ERROR_STORAGE or MESHCORE_ERROR_CANCELLED
+ */
+meshcore_error meshcore_export_archive(
+    meshcore* core,
+    const char* path,
+    bool compress,
+    meshcore_progress_callback progress,
+    void* user_data
+);
+
+/**
+ * Import an archive into the message store in bulk
+ *
+ * Messages are written directly to the store (not through the event
+ * queue) and conversation summaries are updated. Every block is
+ * checksummed; import stops at the first damaged block.
+ *
+ * @param core         Handle to the core
+ * @param path         Archive file
+ * @param progress     Optional progress callback
+ * @param user_data    Context pointer passed to the callback
+ * @param imported_out Optional; receives the number of messages imported
+ * @return MESHCORE_OK, MESHCORE_ERROR_STORAGE, MESHCORE_ERROR_CORRUPT or
+ *         MESHCORE_ERROR_CANCELLED
+ */
+meshcore_error meshcore_import_archive(
+    meshcore* core,
+    const char* path,
+    meshcore_progress_callback progress,
+    void* user_data,
+    uint64_t* imported_out
+);
+
+// =============================================================================
+// MARK: - Conversation Summaries
+// =============================================================================
+
+/**
+ * Home screen summary of one conversation
+ *
+ * Strings are valid only during the callback that delivers them.
+ */
+typedef struct {
+    const char* uid;               // Conversation (peer UID)
+    const char* last_message;      // Preview of the newest message (UTF-8)
+    size_t      last_message_len;
+    int64_t     last_timestamp;    // Unix ms of the newest message
+    bool        last_outbound;     // Newest message was sent by us
+    uint32_t    unread_count;
+    uint64_t    message_count;     // 0 = conversation was deleted
+} meshcore_conversation;
+
+/**
+ * Callback receiving an array of conversation summaries
+ *
+ * @param user_data Context pointer
+ * @param conversations Array of summaries (valid during callback only)
+ * @param count     Number of entries
+ */
+typedef void (*meshcore_conversations_callback)(
+    void* user_data,
+    const meshcore_conversation* conversations,
+    size_t count
+);
+
+/**
+ * Register for summary changes
+ *
+ * Only conversations that changed are reported, batched once the event
+ * queue drains. Pass NULL to unregister.
+ *
+ * @param core      Handle to the core
+ * @param callback  Change callback
+ * @param user_data Context pointer passed to the callback
+ */
+void meshcore_set_conversations_callback(
+    meshcore* core,
+    meshcore_conversations_callback callback,
+    void* user_data
+);
+
+/**
+ * Get every conversation summary in one call
+ *
+ * The callback is invoked once, synchronously, with the full table.
+ *
+ * @param core      Handle to the core
+ * @param callback  Receives the summaries
+ * @param user_data Context pointer passed to the callback
+ * @return Number of conversations
+ */
+size_t meshcore_get_conversations(
+    const meshcore* core,
+    meshcore_conversations_callback callback,
+    void* user_data
+);
+
+/**
+ * Mark every message of a conversation as read (resets unread count)
+ *
+ * @param core Handle to the core
+ * @param uid  Conversation (peer UID)
+ * @return MESHCORE_OK on success, error code on failure
+ */
+meshcore_error meshcore_mark_read(meshcore* core, const char* uid);
+
+// =============================================================================
+// MARK: - Attachments
+// =============================================================================
+
+/** Attachment identifier (BLAKE2s-256 of the chunk manifest) */
+#define MESHCORE_ATTACHMENT_ID_SIZE 32
+
+/**
+ * Callback when an inbound attachment has fully arrived
+ *
+ * @param user_data User-provided context pointer
+ * @param peer_id   Peer that sent it
+ * @param id        Attachment ID (MESHCORE_ATTACHMENT_ID_SIZE bytes)
+ * @param size      Attachment size in bytes
+ */
+typedef void (*meshcore_attachment_callback)(
+    void* user_data,
+    uint64_t peer_id,
+    const uint8_t* id,
+    uint64_t size
+);
+
+/**
+ * Open (or create) the content-addressed attachment store
+ *
+ * Attachments are split into content-defined chunks stored once by hash;
+ * identical or overlapping files share storage and are never re-sent
+ * chunk-for-chunk to a peer that already holds them.
+ *
+ * @param core      Handle to the core
+ * @param directory Directory holding chunks and manifests
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_STORAGE if it cannot be opened
+ */
+meshcore_error meshcore_open_chunk_store(meshcore* core, const char* directory);
+
+/**
+ * Store an attachment
+ *
+ * @param core   Handle to the core
+ * @param data   Attachment bytes
+ * @param len    Length in bytes
+ * @param id_out Receives the attachment ID (MESHCORE_ATTACHMENT_ID_SIZE bytes)
+ * @return MESHCORE_OK on success, error code on failure
+ */
+meshcore_error meshcore_attachment_put(meshcore* core, const void* data, size_t len, uint8_t* id_out);
+
+/**
+ * Send a stored attachment to a peer (only missing chunks cross the link)
+ *
+ * @param core    Handle to the core
+ * @param peer_id Target peer
+ * @param id      Attachment ID
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_PEER_NOT_FOUND if the ID is unknown
+ */
+meshcore_error meshcore_attachment_send(meshcore* core, uint64_t peer_id, const uint8_t* id);
+
+/**
+ * Read a stored attachment
+ *
+ * @param core     Handle to the core
+ * @param id       Attachment ID
+ * @param buffer   Destination, or NULL to query the size only
+ * @param capacity Size of buffer
+ * @param size_out Receives the attachment size
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_MESSAGE_TOO_LONG if buffer is too small
+ */
+meshcore_error meshcore_attachment_read(
+    const meshcore* core,
+    const uint8_t* id,
+    void* buffer,
+    size_t capacity,
+    uint64_t* size_out
+);
+
+/**
+ * Release an attachment; chunks no other attachment uses are deleted
+ *
+ * @param core Handle to the core
+ * @param id   Attachment ID
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_PEER_NOT_FOUND if unknown
+ */
+meshcore_error meshcore_attachment_release(meshcore* core, const uint8_t* id);
+
+/**
+ * Register for completed inbound attachments (NULL to unregister)
+ *
+ * @param core      Handle to the core
+ * @param callback  Completion callback
+ * @param user_data Context pointer passed to the callback
+ */
+void meshcore_set_attachment_callback(
+    meshcore* core,
+    meshcore_attachment_callback callback,
+    void* user_data
+);
+
+// =============================================================================
+// MARK: - Encryption
+// =============================================================================
+
+/** Session key size (ChaCha20-Poly1305) */
+#define MESHCORE_SESSION_KEY_SIZE 32
+
+/**
+ * Install session keys for a peer
+ *
+ * From then on every frame to the peer is sealed with ChaCha20-Poly1305
+ * and unsealed inbound frames from it are dropped. Sessions live in an
+ * LRU cache of the most recently active peers.
+ *
+ * @param core    Handle to the core
+ * @param peer_id Peer the session belongs to
+ * @param tx_key  Key for frames we send (MESHCORE_SESSION_KEY_SIZE bytes)
+ * @param rx_key  Key for frames we receive (MESHCORE_SESSION_KEY_SIZE bytes)
+ * @return MESHCORE_OK on success, error code on failure
+ */
+meshcore_error meshcore_set_session_keys(
+    meshcore* core,
+    uint64_t peer_id,
+    const uint8_t* tx_key,
+    const uint8_t* rx_key
+);
+
+/**
+ * Drop a peer's session (frames revert to plaintext)
+ *
+ * @param core    Handle to the core
+ * @param peer_id Peer
+ */
+void meshcore_clear_session(meshcore* core, uint64_t peer_id);
+
+/**
+ * Handshake counters
+ */
+typedef struct {
+    uint64_t full;        // Full handshakes completed (either role)
+    uint64_t resumed;     // Ticket resumptions completed (either role)
+    uint64_t rejected;    // Tickets refused (expired, forged or replayed)
+    uint64_t fallbacks;   // Our resumptions that fell back to a full handshake
+} meshcore_handshake_stats;
+
+/**
+ * Set up session keys with a connected peer (X25519 key exchange)
+ *
+ * Call on one side of a link (e.g. the BLE central) after the peer
+ * connects; the other side responds automatically. If a resumption
+ * ticket from an earlier connection to the same UID is still valid, the
+ * session resumes with no round trip and messages sent right away travel
+ * in the first flight (0-RTT). Otherwise messages sent before the
+ * handshake completes are held and sent once it does.
+ *
+ * The resulting session is dropped when the peer disconnects.
+ *
+ * @param core    Handle to the core
+ * @param peer_id Connected peer
+ * @return MESHCORE_OK, or MESHCORE_ERROR_PEER_NOT_FOUND if not connected
+ */
+meshcore_error meshcore_start_handshake(meshcore* core, uint64_t peer_id);
+
+/**
+ * Get handshake counters
+ *
+ * @param core  Handle to the core
+ * @param stats Receives the counters
+ * @return MESHCORE_OK on success, error code on failure
+ */
+meshcore_error meshcore_get_handshake_stats(const meshcore* core, meshcore_handshake_stats* stats);
+
+// =============================================================================
+// MARK: - Signatures
+// =============================================================================
+
+/** Ed25519 seed and public key sizes */
+#define MESHCORE_SIGNING_SEED_SIZE 32
+#define MESHCORE_PUBLIC_KEY_SIZE   32
+
+/**
+ * Signature verification counters (batch verification pool)
+ */
+typedef struct {
+    uint64_t verified;        // Valid signatures delivered
+    uint64_t rejected;        // Invalid or malformed signed frames
+    uint64_t batches;         // Batches verified
+    uint64_t over_budget;     // Frames verified later than the latency budget
+    uint64_t max_latency_us;  // Worst arrival-to-delivery latency
+    uint64_t dropped;         // Refused because the verification queue was full
+} meshcore_verification_stats;
+
+/**
+ * Callback for a signed message, with the key that verified it
+ *
+ * A signed frame is only accepted with the key bound to the sender's
+ * UID: the signing_key of its directory record, or else the first key
+ * that verified for the UID (pinned while the core runs).
+ *
+ * @param user_data   Context pointer passed during registration
+ * @param peer_id     Sending peer
+ * @param peer_uid    Its UID
+ * @param message     The message content (valid during callback only)
+ * @param message_len Length of message in bytes
+ * @param timestamp   Unix timestamp in milliseconds
+ * @param public_key  Signer (MESHCORE_PUBLIC_KEY_SIZE bytes)
+ */
+typedef void (*meshcore_signed_message_callback)(
+    void* user_data,
+    uint64_t peer_id,
+    const char* peer_uid,
+    const char* message,
+    size_t message_len,
+    int64_t timestamp,
+    const uint8_t* public_key
+);
+
+/**
+ * Register for signed messages (NULL to unregister)
+ *
+ * While registered, signed messages are delivered here instead of to
+ * on_message; unsigned ones still go to on_message.
+ *
+ * @param core      Handle to the core
+ * @param callback  Signed message callback
+ * @param user_data Context pointer passed to the callback
+ */
+void meshcore_set_signed_message_callback(
+    meshcore* core,
+    meshcore_signed_message_callback callback,
+    void* user_data
+);
+
+/**
+ * Sign outgoing chat messages with an Ed25519 key
+ *
+ * @param core           Handle to the core
+ * @param seed           Secret seed (MESHCORE_SIGNING_SEED_SIZE bytes)
+ * @param public_key_out Optional; receives the public key (MESHCORE_PUBLIC_KEY_SIZE bytes)
+ * @return MESHCORE_OK on success, error code on failure
+ */
+meshcore_error meshcore_set_signing_key(meshcore* core, const uint8_t* seed, uint8_t* public_key_out);
+
+/**
+ * Verify inbound signed frames in batches on a worker pool
+ *
+ * Without this, signed frames are verified one at a time on the core's
+ * worker. Batches are cut early enough that a frame is normally
+ * delivered within latency_budget_us of its arrival, and each peer's
+ * messages still arrive in order. Frames beyond a bounded queue are
+ * refused (dropped in meshcore_verification_stats). Can be enabled
+ * once per core.
+ *
+ * @param core              Handle to the core
+ * @param max_batch         Largest batch (e.g. 64)
+ * @param latency_budget_us Arrival-to-delivery budget in microseconds
+ * @param threads           Pool size
+ * @return MESHCORE_OK, or MESHCORE_ERROR_INVALID_PARAM if already enabled
+ */
+meshcore_error meshcore_enable_batch_verification(
+    meshcore* core,
+    uint32_t max_batch,
+    uint32_t latency_budget_us,
+    uint32_t threads
+);
+
+/**
+ * Get verification counters
+ *
+ * @param core  Handle to the core
+ * @param stats Receives the counters
+ * @return MESHCORE_OK on success, error code on failure
+ */
+meshcore_error meshcore_get_verification_stats(const meshcore* core, meshcore_verification_stats* stats);
+
+// =============================================================================
+// MARK: - Offload Pool
+// =============================================================================
+
+/**
+ * Offload pool counters
+ *
+ * Heavy or blocking work (chunk store I/O, inline signature checks)
+ * runs on a small pool off the core's worker thread.
+ */
+typedef struct {
+    uint64_t submitted;       // Jobs accepted
+    uint64_t completed;       // Jobs finished
+    uint64_t stolen;          // Jobs run by a worker that did not receive them
+    uint64_t blocked;         // Submissions that waited because the pool was full
+    uint64_t rejected;        // Jobs refused because the pool was full (e.g. attachment frames)
+    uint64_t max_in_flight;   // Most jobs queued or running at once
+} meshcore_offload_stats;
+
+/**
+ * Get offload pool counters
+ *
+ * @param core  Handle to the core
+ * @param stats Receives the counters
+ * @return MESHCORE_OK on success, error code on failure
+ */
+meshcore_error meshcore_get_offload_stats(const meshcore* core, meshcore_offload_stats* stats);
+
+/**
+ * Ingress counters
+ *
+ * Inbound frames are admitted, decrypted and signature-checked on the
+ * offload pool before they reach the core's worker.
+ */
+typedef struct {
+    uint64_t decoded;         // Handed to the worker ready to deliver
+    uint64_t dropped;         // Refused while decoding
+    uint64_t barriers;        // Handed to the worker undecoded (handshake frames)
+    uint64_t overflow;        // Dropped because a peer's backlog was full
+} meshcore_ingress_stats;
+
+/**
+ * Get ingress counters
+ *
+ * @param core  Handle to the core
+ * @param stats Receives the counters
+ * @return MESHCORE_OK on success, error code on failure
+ */
+meshcore_error meshcore_get_ingress_stats(const meshcore* core, meshcore_ingress_stats* stats);
+
+// =============================================================================
+// MARK: - Pipelines
+// =============================================================================
+
+/**
+ * Processing direction
+ *
+ * Inbound stages:  control, decode, frames, peers, store, conversations, ui
+ * Outbound stages: send, store, conversations
+ */
+typedef enum {
+    MESHCORE_INBOUND = 0,
+    MESHCORE_OUTBOUND = 1
+} meshcore_direction;
+
+/** Longest stage name, including the terminator */
+#define MESHCORE_STAGE_NAME_SIZE 32
+
+/**
+ * Timing for one pipeline stage
+ */
+typedef struct {
+    char     name[MESHCORE_STAGE_NAME_SIZE];
+    uint64_t batches;         // Batches that reached the stage
+    uint64_t events;          // Events that reached the stage
+    uint64_t total_ns;        // Time spent in the stage
+    uint64_t max_ns;          // Slowest batch
+} meshcore_stage_stats;
+
+/**
+ * Get per-stage timing, in pipeline order
+ *
+ * @param core      Handle to the core
+ * @param direction Pipeline
+ * @param stats     Destination array (may be NULL to query the count)
+ * @param capacity  Entries available in stats
+ * @return Number of stages (entries beyond capacity are not written)
+ */
+size_t meshcore_get_stage_stats(
+    const meshcore* core,
+    meshcore_direction direction,
+    meshcore_stage_stats* stats,
+    size_t capacity
+);
+
+/**
+ * Remove a stage, e.g. "store", "conversations" and "ui" on a relay
+ *
+ * @param core      Handle to the core
+ * @param direction Pipeline
+ * @param name      Stage name
+ * @return MESHCORE_OK, or MESHCORE_ERROR_INVALID_PARAM if there is no such stage
+ */
+meshcore_error meshcore_remove_stage(meshcore* core, meshcore_direction direction, const char* name);
+
+// =============================================================================
+// MARK: - Admission Control
+// =============================================================================
+
+/**
+ * Per-peer limits on inbound traffic, applied before anything is queued
+ *
+ * A frame over the peer's frame or byte budget is dropped and adds to
+ * its misbehaviour score, as does a frame refused while decoding. At
+ * quarantine_score the peer is quarantined (all traffic dropped) for
+ * quarantine_ms, doubling per repeat up to max_quarantine_ms.
+ * A zero rate disables that limit; a zero quarantine_score disables
+ * quarantine.
+ */
+typedef struct {
+    uint32_t frames_per_sec;        // Default 200
+    uint32_t burst_frames;          // Default 400
+    uint32_t bytes_per_sec;         // Default 256 KiB
+    uint32_t burst_bytes;           // Default 512 KiB
+    uint32_t quarantine_score;      // Default 500
+    uint32_t score_decay_per_sec;   // Default 50
+    uint32_t quarantine_ms;         // Default 30000
+    uint32_t max_quarantine_ms;     // Default 600000
+} meshcore_admission_policy;
+
+/**
+ * Admission counters
+ */
+typedef struct {
+    uint64_t admitted;
+    uint64_t rate_limited;          // Dropped: over the peer's budget
+    uint64_t quarantine_dropped;    // Dropped: peer in quarantine
+    uint64_t penalties;             // Frames refused after admission
+    uint64_t quarantines;           // Times a peer was quarantined
+    uint64_t quarantined_peers;     // Currently in quarantine
+} meshcore_admission_stats;
+
+/**
+ * Replace the admission policy (peers keep their current budgets)
+ *
+ * @param core   Handle to the core
+ * @param policy New limits
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_set_admission_policy(meshcore* core, const meshcore_admission_policy* policy);
+
+/**
+ * Get admission counters
+ *
+ * @param core  Handle to the core
+ * @param stats Output counters
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_admission_stats(const meshcore* core, meshcore_admission_stats* stats);
+
+// =============================================================================
+// MARK: - Congestion Control
+// =============================================================================
+
+/**
+ * Hop-by-hop backpressure between neighbours
+ *
+ * Every frame sent carries the depth of the local queue (1 = idle,
+ * 255 = at queue_capacity); past high_water, neighbours sending to us
+ * are also sent a Congestion frame every signal_interval_ms. Inbound
+ * data arriving at capacity is shed. Hints from a neighbour cut the
+ * rate we send to it by decrease_percent (once per decrease_interval_ms)
+ * and raise it by increase_per_sec per second while it has room, until
+ * max_rate lifts pacing. Up to max_pending frames wait per neighbour.
+ * A zero queue_capacity stops local hints; a zero max_rate never paces.
+ */
+typedef struct {
+    uint32_t queue_capacity;        // Default 1024
+    uint8_t  high_water;            // Default 128
+    uint8_t  low_water;             // Default 64
+    uint32_t signal_interval_ms;    // Default 50
+    uint32_t max_rate;              // Frames/s, default 2000
+    uint32_t min_rate;              // Default 10
+    uint32_t increase_per_sec;      // Default 100
+    uint32_t decrease_percent;      // Default 50
+    uint32_t decrease_interval_ms;  // Default 100
+    uint32_t hint_timeout_ms;       // Default 1000
+    uint32_t max_pending;           // Default 256
+} meshcore_congestion_policy;
+
+/**
+ * Congestion counters
+ */
+typedef struct {
+    uint8_t  local_hint;            // Hint currently sent
+    uint64_t peak_depth;            // Deepest the local queue has been
+    uint64_t shed;                  // Inbound frames dropped at capacity
+    uint64_t signals;               // Congestion frames sent
+    uint64_t decreases;             // Rate cuts on neighbours' hints
+    uint64_t held;                  // Outbound frames that waited
+    uint64_t dropped;               // Outbound frames dropped: queue full
+    uint64_t paced_peers;           // Neighbours currently paced
+} meshcore_congestion_stats;
+
+/**
+ * Replace the congestion policy (paced neighbours keep their rate)
+ *
+ * @param core   Handle to the core
+ * @param policy New settings
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_set_congestion_policy(meshcore* core, const meshcore_congestion_policy* policy);
+
+/**
+ * Get congestion counters
+ *
+ * @param core  Handle to the core
+ * @param stats Output counters
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_congestion_stats(const meshcore* core, meshcore_congestion_stats* stats);
+
+// =============================================================================
+// MARK: - Scan Ingest
+// =============================================================================
+
+/** Device identifier size: a UUID, or a MAC address zero-padded */
+#define MESHCORE_DEVICE_ID_SIZE 16
+
+/**
+ * One advertisement heard by the platform scanner
+ */
+typedef struct {
+    uint8_t identifier[MESHCORE_DEVICE_ID_SIZE];
+    int32_t rssi;                   // dBm
+    int64_t timestamp;              // Milliseconds since epoch (0 = now)
+} meshcore_scan_report;
+
+typedef enum {
+    MESHCORE_DISCOVERY_FOUND   = 0,   // Smoothed RSSI reached min_rssi
+    MESHCORE_DISCOVERY_UPDATED = 1,   // Moved by rssi_change_db since last reported
+    MESHCORE_DISCOVERY_LOST    = 2    // Under min_rssi, or silent for lost_after_ms
+} meshcore_discovery_kind;
+
+/**
+ * One discovery change
+ */
+typedef struct {
+    uint8_t                 identifier[MESHCORE_DEVICE_ID_SIZE];
+    meshcore_discovery_kind kind;
+    int32_t                 rssi;         // Smoothed
+    int64_t                 last_seen;    // Timestamp of the latest report
+} meshcore_discovery;
+
+/**
+ * Called with the changes produced by scan batches, on the worker thread
+ *
+ * @param user_data User-provided context pointer
+ * @param changes   Changes (valid during the call only)
+ * @param count     Number of changes
+ */
+typedef void (*meshcore_discovery_callback)(
+    void* user_data,
+    const meshcore_discovery* changes,
+    size_t count
+);
+
+typedef enum {
+    MESHCORE_RSSI_EWMA   = 0,
+    MESHCORE_RSSI_KALMAN = 1
+} meshcore_rssi_filter;
+
+/**
+ * Scan filtering
+ *
+ * Exact repeats and out-of-order reports are dropped; each device's RSSI
+ * is smoothed (EWMA with ewma_alpha, or a scalar Kalman filter with the
+ * given process and measurement noise) and a device yields at most one
+ * change per batch. At most max_devices are tracked; the longest silent
+ * is forgotten first.
+ */
+typedef struct {
+    meshcore_rssi_filter filter;            // Default Kalman
+    float                ewma_alpha;        // Default 0.3
+    float                process_noise;     // dB² per second, default 2
+    float                measurement_noise; // dB², default 16
+    int32_t              rssi_change_db;    // Default 5
+    int32_t              min_rssi;          // Default -95
+    uint32_t             lost_after_ms;     // Default 10000
+    uint32_t             max_devices;       // Default 1024
+} meshcore_scan_policy;
+
+/**
+ * Scan counters
+ */
+typedef struct {
+    uint64_t reports;               // Reports ingested
+    uint64_t duplicates;            // Repeats and out-of-order reports dropped
+    uint64_t changes;               // Changes emitted
+    uint64_t found;
+    uint64_t updated;
+    uint64_t lost;
+    uint64_t evicted;               // Forgotten because the table was full
+    uint64_t devices;               // Currently tracked
+    uint64_t present;               // Currently reported present
+} meshcore_scan_stats;
+
+/**
+ * Hand over a batch of scan reports
+ *
+ * Filtering runs on the calling thread; the resulting changes are
+ * delivered to the discovery callback on the worker thread.
+ *
+ * @param core        Handle to the core
+ * @param reports     Reports, in the order heard
+ * @param count       Number of reports
+ * @param changes_out Receives how many changes the batch produced (may be NULL)
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_ingest_scan_batch(
+    meshcore* core,
+    const meshcore_scan_report* reports,
+    size_t count,
+    size_t* changes_out
+);
+
+/**
+ * Register for discovery changes (NULL to unregister)
+ *
+ * @param core      Handle to the core
+ * @param callback  Change callback
+ * @param user_data Context pointer passed to the callback
+ */
+void meshcore_set_discovery_callback(
+    meshcore* core,
+    meshcore_discovery_callback callback,
+    void* user_data
+);
+
+/**
+ * Replace the scan policy (smoothing state is kept)
+ *
+ * @param core   Handle to the core
+ * @param policy New settings
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_INVALID_PARAM if ewma_alpha is outside (0, 1]
+ */
+meshcore_error meshcore_set_scan_policy(meshcore* core, const meshcore_scan_policy* policy);
+
+/**
+ * Get scan counters
+ *
+ * @param core  Handle to the core
+ * @param stats Output counters
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_scan_stats(const meshcore* core, meshcore_scan_stats* stats);
+
+// =============================================================================
+// MARK: - Neighbour Selection
+// =============================================================================
+
+typedef enum {
+    MESHCORE_LINK_CONNECT    = 0,
+    MESHCORE_LINK_DISCONNECT = 1
+} meshcore_link_action;
+
+/**
+ * One link recommendation
+ */
+typedef struct {
+    uint8_t              identifier[MESHCORE_DEVICE_ID_SIZE];
+    meshcore_link_action action;
+    uint64_t             peer_id;    // Disconnect: the connection to drop; 0 for connect
+    float                score;
+} meshcore_link_recommendation;
+
+/**
+ * Called when the neighbour set should change, on the worker thread
+ *
+ * @param user_data       User-provided context pointer
+ * @param recommendations Recommendations (valid during the call only)
+ * @param count           Number of recommendations
+ */
+typedef void (*meshcore_link_callback)(
+    void* user_data,
+    const meshcore_link_recommendation* recommendations,
+    size_t count
+);
+
+/**
+ * Link budget and ranking
+ *
+ * Discovered devices are ranked by quality_weight * smoothed RSSI
+ * (rssi_floor..rssi_ceiling mapped onto 0..1), activity_weight * recent
+ * traffic (decayed with activity_half_life_ms; activity_scale frames
+ * score 0.5) and diversity_weight * the share of their neighbours not
+ * reachable through other links. Free slots are filled with the best;
+ * when full, a candidate replaces the worst link at least min_link_ms
+ * old if it scores switch_margin more. A connect not bound within
+ * connect_timeout_ms is abandoned for retry_backoff_ms.
+ */
+typedef struct {
+    uint32_t max_links;             // Default 4
+    float    quality_weight;        // Default 0.5
+    float    activity_weight;       // Default 0.3
+    float    diversity_weight;      // Default 0.2
+    int32_t  rssi_floor;            // Default -95
+    int32_t  rssi_ceiling;          // Default -45
+    float    activity_scale;        // Default 8
+    uint32_t activity_half_life_ms; // Default 60000
+    float    switch_margin;         // Default 0.15
+    uint32_t min_link_ms;           // Default 10000
+    uint32_t connect_timeout_ms;    // Default 5000
+    uint32_t retry_backoff_ms;      // Default 30000
+} meshcore_link_policy;
+
+/**
+ * Link counters
+ */
+typedef struct {
+    uint64_t candidates;            // Present devices not linked
+    uint64_t links;                 // Bound to a peer
+    uint64_t pending;               // Connect recommended, not yet bound
+    uint64_t connects;              // Connect recommendations
+    uint64_t disconnects;           // Disconnect recommendations
+    uint64_t swaps;                 // Links replaced by a better candidate
+    uint64_t timeouts;              // Connects abandoned
+} meshcore_link_stats;
+
+/**
+ * Register for link recommendations (NULL to unregister)
+ *
+ * @param core      Handle to the core
+ * @param callback  Recommendation callback
+ * @param user_data Context pointer passed to the callback
+ */
+void meshcore_set_link_callback(
+    meshcore* core,
+    meshcore_link_callback callback,
+    void* user_data
+);
+
+/**
+ * Report which device a connection is to (call once it is up)
+ *
+ * @param core       Handle to the core
+ * @param identifier Device identifier (MESHCORE_DEVICE_ID_SIZE bytes)
+ * @param peer_id    Peer ID the connection was registered under
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_link_bind(meshcore* core, const uint8_t* identifier, uint64_t peer_id);
+
+/**
+ * Report the devices a neighbour is itself linked to
+ *
+ * @param core       Handle to the core
+ * @param identifier Device identifier
+ * @param neighbours count identifiers, back to back
+ * @param count      Number of neighbours (0 to forget them)
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_link_set_neighbours(
+    meshcore* core,
+    const uint8_t* identifier,
+    const uint8_t* neighbours,
+    size_t count
+);
+
+/**
+ * Replace the link policy (current links are kept)
+ *
+ * @param core   Handle to the core
+ * @param policy New settings
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_INVALID_PARAM if rssi_ceiling is not above rssi_floor
+ */
+meshcore_error meshcore_set_link_policy(meshcore* core, const meshcore_link_policy* policy);
+
+/**
+ * Get link counters
+ *
+ * @param core  Handle to the core
+ * @param stats Output counters
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_link_stats(const meshcore* core, meshcore_link_stats* stats);
+
+// =============================================================================
+// MARK: - Duty Cycle
+// =============================================================================
+
+/**
+ * Scan and advertise schedule for the platform
+ *
+ * Scan for scan_window_ms every scan_interval_ms (equal values mean scan
+ * continuously) and advertise every advertise_interval_ms.
+ */
+typedef struct {
+    uint32_t scan_window_ms;
+    uint32_t scan_interval_ms;
+    uint32_t advertise_interval_ms;
+    uint32_t level;                 // 0 = busy, +1 per backoff step
+} meshcore_duty_schedule;
+
+/**
+ * Called when the recommended schedule changes, on the worker thread
+ *
+ * @param user_data User-provided context pointer
+ * @param schedule  New schedule (valid during the call only)
+ */
+typedef void (*meshcore_duty_cycle_callback)(
+    void* user_data,
+    const meshcore_duty_schedule* schedule
+);
+
+/**
+ * Duty cycle limits
+ *
+ * Traffic or neighbour churn within quiet_after_ms keeps the radio busy:
+ * continuous scanning at min_scan_interval_ms, advertising every
+ * min_advertise_interval_ms. After that, each quiet interval doubles
+ * both intervals up to their maxima, scanning scan_window_ms at a time.
+ * While the outbox is not empty the scan interval stays at or under
+ * outbox_max_interval_ms.
+ */
+typedef struct {
+    uint32_t scan_window_ms;            // Default 2000
+    uint32_t min_scan_interval_ms;      // Default 2000
+    uint32_t max_scan_interval_ms;      // Default 120000
+    uint32_t min_advertise_interval_ms; // Default 100
+    uint32_t max_advertise_interval_ms; // Default 2000
+    uint32_t quiet_after_ms;            // Default 15000
+    uint32_t outbox_max_interval_ms;    // Default 10000
+} meshcore_duty_cycle_policy;
+
+/**
+ * Duty cycle counters
+ */
+typedef struct {
+    uint64_t traffic;               // Frames noted
+    uint64_t churn;                 // Neighbour changes noted
+    uint64_t outbox;                // Messages waiting, as last reported
+    uint64_t changes;               // Schedules reported
+    uint64_t backoffs;              // Backoff steps taken
+    uint64_t wakeups;               // Returns to busy from a backoff
+} meshcore_duty_cycle_stats;
+
+/**
+ * Register for schedule changes (NULL to unregister)
+ *
+ * @param core      Handle to the core
+ * @param callback  Schedule callback
+ * @param user_data Context pointer passed to the callback
+ */
+void meshcore_set_duty_cycle_callback(
+    meshcore* core,
+    meshcore_duty_cycle_callback callback,
+    void* user_data
+);
+
+/**
+ * Report how many outgoing messages are waiting for a route
+ *
+ * @param core    Handle to the core
+ * @param pending Messages waiting (0 when the outbox is empty)
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_set_outbox_pending(meshcore* core, size_t pending);
+
+/**
+ * Replace the duty cycle policy (applies from the next evaluation)
+ *
+ * @param core   Handle to the core
+ * @param policy New settings
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_INVALID_PARAM if an interval is zero or a minimum exceeds its maximum
+ */
+meshcore_error meshcore_set_duty_cycle_policy(meshcore* core, const meshcore_duty_cycle_policy* policy);
+
+/**
+ * Get the current schedule
+ *
+ * @param core     Handle to the core
+ * @param schedule Output schedule (all zero before the first evaluation)
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_duty_schedule(const meshcore* core, meshcore_duty_schedule* schedule);
+
+/**
+ * Get duty cycle counters
+ *
+ * @param core  Handle to the core
+ * @param stats Output counters
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_duty_cycle_stats(const meshcore* core, meshcore_duty_cycle_stats* stats);
+
+// =============================================================================
+// MARK: - Hibernation
+// =============================================================================
+
+/**
+ * Low-power mode limits
+ *
+ * While hibernating, task timers and maintenance are rounded up onto a
+ * grid of slack_ms so they share one wakeup, and optional work (store
+ * compaction, periodic snapshots) runs at most every optional_every_ms.
+ * Inbound traffic and paced frames are never delayed.
+ */
+typedef struct {
+    uint32_t slack_ms;              // Default 30000
+    uint32_t optional_every_ms;     // Default 600000
+} meshcore_hibernation_policy;
+
+/**
+ * Wakeup counters
+ */
+typedef struct {
+    bool     hibernating;
+    uint64_t wakeups;               // Worker wakeups
+    uint64_t traffic_wakeups;       // ... caused by queued events
+    uint64_t wakeups_per_minute;    // Over the last 60 seconds
+    uint64_t coalesced;             // Deadlines moved onto the slack grid
+    uint64_t deferred;              // Optional work put off
+    uint64_t hibernations;          // Times entered
+} meshcore_hibernation_stats;
+
+/**
+ * Enter or leave hibernation (e.g. when the app goes to the background)
+ *
+ * @param core    Handle to the core
+ * @param enabled true to hibernate
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_set_hibernation(meshcore* core, bool enabled);
+
+/**
+ * Replace the hibernation policy
+ *
+ * @param core   Handle to the core
+ * @param policy New settings
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_INVALID_PARAM if slack_ms is zero
+ */
+meshcore_error meshcore_set_hibernation_policy(meshcore* core, const meshcore_hibernation_policy* policy);
+
+/**
+ * Get wakeup counters
+ *
+ * @param core  Handle to the core
+ * @param stats Output counters
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_hibernation_stats(const meshcore* core, meshcore_hibernation_stats* stats);
+
+// =============================================================================
+// MARK: - Metrics
+// =============================================================================
+
+/**
+ * One latency histogram, summarised (nanoseconds)
+ *
+ * Percentiles are the upper bounds of log-spaced buckets, within 6.25%.
+ */
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t p50_ns;
+    uint64_t p90_ns;
+    uint64_t p99_ns;
+    uint64_t max_ns;
+} meshcore_latency;
+
+/**
+ * Core counters, gauges and latencies
+ */
+typedef struct {
+    uint64_t events_queued;         // Events posted to the worker
+    uint64_t events_dispatched;     // ... taken off the queue
+    uint64_t batches;               // Pipeline runs
+    uint64_t messages_delivered;    // Chat messages passed to the message callback
+    uint64_t frames_sent;           // Transport sends
+    uint64_t bytes_sent;
+    uint64_t queue_depth;           // Events waiting now
+    uint64_t queue_depth_max;       // High-water mark
+    meshcore_latency queue_wait;    // Enqueue to dispatch
+    meshcore_latency handler;       // One batch through the pipeline
+    meshcore_latency callback;      // Inside app callbacks
+    meshcore_latency transport_send;
+    meshcore_latency slow_handler;  // Work past the watchdog's slow_handler_ms
+} meshcore_stats;
+
+/**
+ * Get a snapshot of the core's metrics
+ *
+ * @param core  Handle to the core
+ * @param stats Output snapshot
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_stats(const meshcore* core, meshcore_stats* stats);
+
+// =============================================================================
+// MARK: - Tracing
+// =============================================================================
+
+/**
+ * Trace buffer state
+ */
+typedef struct {
+    bool     enabled;
+    uint64_t recorded;              // Records written, overwritten ones included
+    uint64_t retained;              // Still in the per-thread rings
+    uint64_t threads;               // Threads that have recorded
+    uint64_t dropped;               // Records from threads past the ring limit
+} meshcore_trace_stats;
+
+/**
+ * Turn event-level tracing on or off (off by default)
+ *
+ * While on, enqueue/dequeue, every pipeline stage, callbacks and
+ * transport sends are recorded into per-thread rings that keep the most
+ * recent records.
+ *
+ * @param core    Handle to the core
+ * @param enabled true to record
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_set_tracing(meshcore* core, bool enabled);
+
+/**
+ * Write what the rings hold as Chrome trace JSON
+ *
+ * Open the file in ui.perfetto.dev or chrome://tracing.
+ *
+ * @param core Handle to the core
+ * @param path Destination file
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_STORAGE on write failure
+ */
+meshcore_error meshcore_export_trace(const meshcore* core, const char* path);
+
+/**
+ * Forget everything recorded so far
+ *
+ * @param core Handle to the core
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_clear_trace(meshcore* core);
+
+/**
+ * Get trace buffer state
+ *
+ * @param core  Handle to the core
+ * @param stats Output state
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_trace_stats(const meshcore* core, meshcore_trace_stats* stats);
+
+// =============================================================================
+// MARK: - Logging
+// =============================================================================
+
+/**
+ * Log levels; a level shows its own lines and those above it
+ */
+typedef enum {
+    MESHCORE_LOG_DEBUG = 0,         // Per-message lines
+    MESHCORE_LOG_INFO  = 1,         // Peer connects and disconnects (default)
+    MESHCORE_LOG_WARN  = 2,
+    MESHCORE_LOG_ERROR = 3,
+    MESHCORE_LOG_OFF   = 4
+} meshcore_log_level;
+
+/**
+ * Called with each formatted line, on the logging thread
+ *
+ * @param user_data User-provided context pointer
+ * @param level     Level of the line
+ * @param line      Line without a newline (valid during the call only)
+ */
+typedef void (*meshcore_log_callback)(
+    void* user_data,
+    meshcore_log_level level,
+    const char* line
+);
+
+/**
+ * Logging counters
+ */
+typedef struct {
+    uint64_t written;               // Lines written
+    uint64_t dropped;               // Lines lost to a full log ring
+    uint64_t truncated;             // Lines cut to fit a record
+} meshcore_log_stats;
+
+/**
+ * Set the process-wide log level
+ *
+ * Log calls only encode their arguments into a ring; a background thread
+ * formats and writes them, so the level mostly bounds that thread's work.
+ *
+ * @param level Lowest level written
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_set_log_level(meshcore_log_level level);
+
+/**
+ * Redact message bodies in log lines (on by default)
+ *
+ * While on, a body is logged as its size only.
+ *
+ * @param redact false to log bodies (debugging only)
+ */
+void meshcore_set_log_redaction(bool redact);
+
+/**
+ * Send log lines to a callback instead of stderr (NULL restores stderr)
+ *
+ * @param callback  Function to call per line
+ * @param user_data Context pointer passed to callback
+ */
+void meshcore_set_log_callback(meshcore_log_callback callback, void* user_data);
+
+/**
+ * Block until every line logged so far has been written
+ */
+void meshcore_flush_log(void);
+
+/**
+ * Get logging counters
+ *
+ * @param stats Output counters
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_log_stats(meshcore_log_stats* stats);
+
+// =============================================================================
+// MARK: - Flight Recorder
+// =============================================================================
+
+/**
+ * Flight recorder state
+ */
+typedef struct {
+    uint64_t capacity;              // Records kept
+    uint64_t recorded;              // Records written, overwritten ones included
+    uint64_t dumps;                 // Dumps written
+    bool     armed;                 // A crash dump path is set
+} meshcore_flight_stats;
+
+/**
+ * Write the last events to a file
+ *
+ * The recorder always keeps the most recent events (type, peer, size,
+ * queued/started times, handler time, outcome) in fixed memory. The
+ * file is a compact binary dump; decode it with the flight_decode tool.
+ *
+ * @param core Handle to the core
+ * @param path Destination file
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_STORAGE on write failure
+ */
+meshcore_error meshcore_dump_flight_recorder(meshcore* core, const char* path);
+
+/**
+ * Dump automatically to a file when the process crashes
+ *
+ * Fatal signals (SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT) and
+ * std::terminate write the dump before the process dies. One core per
+ * process can be armed; the last one set wins.
+ *
+ * @param core Handle to the core
+ * @param path Dump file, or NULL to disarm
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_INVALID_PARAM if the
+ *         path is too long
+ */
+meshcore_error meshcore_set_flight_dump_path(meshcore* core, const char* path);
+
+/**
+ * Get flight recorder state
+ *
+ * @param core  Handle to the core
+ * @param stats Output state
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_flight_stats(const meshcore* core, meshcore_flight_stats* stats);
+
+// =============================================================================
+// MARK: - Watchdog
+// =============================================================================
+
+/**
+ * Stall thresholds
+ *
+ * A watchdog thread checks every check_interval_ms whether the work the
+ * worker is running (usually an app callback) has run longer than
+ * handler_stall_ms, and whether the oldest queued event has waited
+ * longer than queue_stall_ms. Either threshold can be 0 to not watch
+ * it. Work that takes slow_handler_ms or more is counted in the
+ * slow_handler latency of meshcore_get_stats.
+ */
+typedef struct {
+    uint32_t handler_stall_ms;      // Default 2000
+    uint32_t queue_stall_ms;        // Default 5000
+    uint32_t check_interval_ms;     // Default 250
+    uint32_t slow_handler_ms;       // Default 50
+} meshcore_watchdog_policy;
+
+typedef enum {
+    MESHCORE_STALL_HANDLER = 0,     // The worker has been in one piece of work too long
+    MESHCORE_STALL_QUEUE = 1        // The oldest queued event has waited too long
+} meshcore_stall_kind;
+
+/**
+ * What the worker was doing when a stall was seen
+ */
+typedef struct {
+    meshcore_stall_kind kind;
+    const char* phase;              // "inbound", "outbound", "task", "timers", "pacing", "maintenance" or "idle"
+    char     stage[MESHCORE_STAGE_NAME_SIZE]; // Pipeline stage running ("" outside one)
+    uint64_t peer_id;               // Peer of the first event in the work (0 if none)
+    uint64_t running_ms;            // How long the work has run
+    uint64_t queue_depth;           // Events waiting
+    uint64_t oldest_queued_ms;      // Age of the oldest one
+} meshcore_stall_report;
+
+/**
+ * Callback for a stall
+ *
+ * Called once per stall on the watchdog thread, while the worker is
+ * still stuck: do not call back into the core and wait for it. An armed
+ * flight recorder has already been dumped (meshcore_set_flight_dump_path).
+ *
+ * @param user_data User-provided context pointer
+ * @param report    The stall (valid during the call only)
+ */
+typedef void (*meshcore_stall_callback)(
+    void* user_data,
+    const meshcore_stall_report* report
+);
+
+/**
+ * Watchdog counters
+ */
+typedef struct {
+    uint64_t checks;                // Checks made (none while idle)
+    uint64_t handler_stalls;        // Work reported as stalled
+    uint64_t queue_stalls;          // Queues reported as stale
+    uint64_t slow_handlers;         // Work past slow_handler_ms
+} meshcore_watchdog_stats;
+
+/**
+ * Replace the watchdog thresholds
+ *
+ * @param core   Handle to the core
+ * @param policy New thresholds
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_INVALID_PARAM if
+ *         check_interval_ms is zero
+ */
+meshcore_error meshcore_set_watchdog_policy(meshcore* core, const meshcore_watchdog_policy* policy);
+
+/**
+ * Set the stall callback (NULL to clear)
+ *
+ * Stalls are also logged at warn level and recorded in the flight
+ * recorder whether or not a callback is set.
+ *
+ * @param core      Handle to the core
+ * @param callback  Function to call per stall
+ * @param user_data Context pointer passed to callback
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_set_stall_callback(meshcore* core, meshcore_stall_callback callback, void* user_data);
+
+/**
+ * Get watchdog counters
+ *
+ * @param core  Handle to the core
+ * @param stats Output counters
+ * @return MESHCORE_OK on success
+ */
+meshcore_error meshcore_get_watchdog_stats(const meshcore* core, meshcore_watchdog_stats* stats);
+
+// =============================================================================
+// MARK: - Contact Directory
+// =============================================================================
+
+/** Contact record flags */
+#define MESHCORE_CONTACT_CONTACT (1u << 0)
+#define MESHCORE_CONTACT_MEMBER  (1u << 1)
+#define MESHCORE_CONTACT_BLOCKED (1u << 2)
+
+/**
+ * One directory entry
+ */
+typedef struct {
+    const char* uid;
+    uint32_t    flags;    /* MESHCORE_CONTACT_* */
+    const char* label;    /* Display name, may be NULL */
+    const uint8_t* signing_key;   /* Ed25519 public key the UID signs with
+                                     (MESHCORE_PUBLIC_KEY_SIZE bytes), may be NULL */
+} meshcore_contact;
+
+/**
+ * Map a prebuilt directory file and use it for inbound admission
+ *
+ * Inbound data from UIDs flagged MESHCORE_CONTACT_BLOCKED is dropped.
+ * In allowlist mode, data from UIDs not in the directory is dropped too.
+ *
+ * @param core      Handle to the core
+ * @param path      Directory file (written by meshcore_rebuild_contacts)
+ * @param allowlist Refuse UIDs that are not listed
+ * @return MESHCORE_OK, or MESHCORE_ERROR_STORAGE if the file is missing or damaged
+ */
+meshcore_error meshcore_load_contacts(meshcore* core, const char* path, bool allowlist);
+
+/**
+ * Rebuild the directory in the background and swap it in atomically
+ *
+ * Returns immediately; lookups keep using the previous directory until
+ * the new one is ready. The records are copied.
+ *
+ * @param core      Handle to the core
+ * @param contacts  Records (duplicate UIDs: the last one wins; UIDs are at
+ *                  most 65535 bytes)
+ * @param count     Number of records
+ * @param path      Optional file to write (and map) the directory to
+ * @param allowlist Refuse UIDs that are not listed
+ * @return MESHCORE_OK on success, MESHCORE_ERROR_INVALID_PARAM for a
+ *         missing or over-long UID, or another error code on failure
+ */
+meshcore_error meshcore_rebuild_contacts(
+    meshcore* core,
+    const meshcore_contact* contacts,
+    size_t count,
+    const char* path,
+    bool allowlist
+);
+
+/**
+ * Look up a UID in the directory
+ *
+ * @param core      Handle to the core
+ * @param uid       UID to look up
+ * @param flags_out Optional; receives the record flags
+ * @return MESHCORE_OK if listed, MESHCORE_ERROR_PEER_NOT_FOUND otherwise
+ */
+meshcore_error meshcore_lookup_contact(const meshcore* core, const char* uid, uint32_t* flags_out);
+
 // =============================================================================
 // MARK: - Peer Management (Future)
 // =============================================================================
@@ -0,0 +1,196 @@
+/**
+ * AdmissionControl Implementation
+ */
+
+#include "admission.h"
+
+#include <algorithm>
+#include <iterator>
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+AdmissionControl::AdmissionControl()
+    : AdmissionControl(AdmissionConfig())
+{
+}
+
+AdmissionControl::AdmissionControl(const AdmissionConfig& config)
+    : config_(config)
+    , admitted_(0)
+    , rate_limited_(0)
+    , quarantine_dropped_(0)
+    , penalties_(0)
+    , quarantines_(0)
+{
+}
+
+void AdmissionControl::set_config(const AdmissionConfig& config) {
+    for (Shard& shard : shards_) {
+        shard.mutex.lock();
+    }
+    config_ = config;
+    for (Shard& shard : shards_) {
+        shard.mutex.unlock();
+    }
+}
+
+AdmissionConfig AdmissionControl::config() const {
+    std::lock_guard<std::mutex> lock(shards_[0].mutex);
+    return config_;
+}
+
+// =============================================================================
+// MARK: - Policing
+// =============================================================================
+
+bool AdmissionControl::admit(uint64_t peer_id, size_t bytes, int64_t now_ms) {
+    Shard& shard = shard_for(peer_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.peers.find(peer_id);
+    if (it == shard.peers.end()) {
+        it = shard.peers.emplace(peer_id, fresh(now_ms)).first;
+    }
+    PeerState& peer = it->second;
+    advance(peer, now_ms);
+
+    if (now_ms < peer.quarantined_until) {
+        quarantine_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const bool frames_ok = config_.frames_per_sec == 0 || peer.frame_tokens >= 1.0;
+    const double cost = std::min(double(bytes), double(config_.burst_bytes));
+    const bool bytes_ok = config_.bytes_per_sec == 0 || peer.byte_tokens >= cost;
+    if (!frames_ok || !bytes_ok) {
+        rate_limited_.fetch_add(1, std::memory_order_relaxed);
+        add_score(peer, kRatePenalty, now_ms);
+        return false;
+    }
+
+    if (config_.frames_per_sec != 0) {
+        peer.frame_tokens -= 1.0;
+    }
+    if (config_.bytes_per_sec != 0) {
+        peer.byte_tokens -= cost;
+    }
+    admitted_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void AdmissionControl::penalize(uint64_t peer_id, uint32_t points, int64_t now_ms) {
+    Shard& shard = shard_for(peer_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.peers.find(peer_id);
+    if (it == shard.peers.end()) {
+        it = shard.peers.emplace(peer_id, fresh(now_ms)).first;
+    }
+    advance(it->second, now_ms);
+    penalties_.fetch_add(1, std::memory_order_relaxed);
+    add_score(it->second, points, now_ms);
+}
+
+bool AdmissionControl::is_quarantined(uint64_t peer_id, int64_t now_ms) const {
+    const Shard& shard = shard_for(peer_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.peers.find(peer_id);
+    return it != shard.peers.end() && now_ms < it->second.quarantined_until;
+}
+
+void AdmissionControl::sweep(int64_t now_ms) {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.peers.begin(); it != shard.peers.end();) {
+            PeerState& peer = it->second;
+            advance(peer, now_ms);
+            // Offenders are kept until they have behaved for as long as
+            // the longest quarantine, so a repeat still escalates
+            const bool forgiven = peer.offences == 0 ||
+                                  now_ms - peer.quarantined_until > int64_t(config_.max_quarantine_ms);
+            const bool idle = peer.score == 0 && forgiven &&
+                              (config_.frames_per_sec == 0 || peer.frame_tokens >= config_.burst_frames) &&
+                              (config_.bytes_per_sec == 0 || peer.byte_tokens >= config_.burst_bytes);
+            it = idle ? shard.peers.erase(it) : std::next(it);
+        }
+    }
+}
+
+AdmissionStats AdmissionControl::stats(int64_t now_ms) const {
+    uint64_t quarantined = 0;
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& entry : shard.peers) {
+            if (now_ms < entry.second.quarantined_until) {
+                quarantined++;
+            }
+        }
+    }
+
+    return AdmissionStats{
+        admitted_.load(std::memory_order_relaxed),
+        rate_limited_.load(std::memory_order_relaxed),
+        quarantine_dropped_.load(std::memory_order_relaxed),
+        penalties_.load(std::memory_order_relaxed),
+        quarantines_.load(std::memory_order_relaxed),
+        quarantined
+    };
+}
+
+// =============================================================================
+// MARK: - Internals
+// =============================================================================
+
+AdmissionControl::Shard& AdmissionControl::shard_for(uint64_t peer_id) {
+    return shards_[(peer_id * 0x9E3779B97F4A7C15ull) >> 60];
+}
+
+const AdmissionControl::Shard& AdmissionControl::shard_for(uint64_t peer_id) const {
+    return shards_[(peer_id * 0x9E3779B97F4A7C15ull) >> 60];
+}
+
+AdmissionControl::PeerState AdmissionControl::fresh(int64_t now_ms) const {
+    return PeerState{double(config_.burst_frames), double(config_.burst_bytes), 0.0, now_ms, 0, 0};
+}
+
+void AdmissionControl::advance(PeerState& peer, int64_t now_ms) const {
+    if (now_ms <= peer.updated_ms) {
+        return;
+    }
+    const double seconds = double(now_ms - peer.updated_ms) / 1000.0;
+
+    // Buckets stay empty for the length of a quarantine
+    const int64_t refill_from = std::max(peer.updated_ms, std::min(peer.quarantined_until, now_ms));
+    const double refill = double(now_ms - refill_from) / 1000.0;
+    peer.updated_ms = now_ms;
+
+    peer.frame_tokens = std::min(double(config_.burst_frames),
+                                 peer.frame_tokens + refill * config_.frames_per_sec);
+    peer.byte_tokens = std::min(double(config_.burst_bytes),
+                                peer.byte_tokens + refill * config_.bytes_per_sec);
+    peer.score = std::max(0.0, peer.score - seconds * config_.score_decay_per_sec);
+}
+
+void AdmissionControl::add_score(PeerState& peer, double points, int64_t now_ms) {
+    if (now_ms < peer.quarantined_until) {
+        return;
+    }
+    peer.score += points;
+    if (config_.quarantine_score == 0 || peer.score < config_.quarantine_score) {
+        return;
+    }
+
+    // Escalates per offence; the peer comes back with empty buckets, so
+    // it cannot burst straight back in
+    const uint64_t duration = std::min<uint64_t>(uint64_t(config_.quarantine_ms) << std::min<uint32_t>(peer.offences, 16),
+                                                 config_.max_quarantine_ms);
+    peer.quarantined_until = now_ms + int64_t(duration);
+    peer.offences++;
+    peer.score = 0;
+    peer.frame_tokens = 0;
+    peer.byte_tokens = 0;
+    quarantines_.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,123 @@
+/**
+ * AdmissionControl - Per-Peer Policing at the Ingest Boundary
+ *
+ * Every inbound payload is checked here before anything is allocated
+ * for it. Each peer has two token buckets (frames and bytes); a frame
+ * that does not fit is dropped. Drops, and frames refused later while
+ * decoding (bad MAC, bad signature, blocked sender), add to the peer's
+ * misbehaviour score, which decays over time. A peer whose score
+ * reaches the threshold is quarantined: all of its traffic is dropped
+ * for a while, twice as long on each repeat offence.
+ *
+ * Times are milliseconds from the caller's clock; a clock that steps
+ * backwards refills nothing rather than going negative.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. Peers are spread over independently
+ *   locked shards, so transports delivering for different peers do not
+ *   contend.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * Policing limits (a zero rate disables that bucket)
+ */
+struct AdmissionConfig {
+    uint32_t frames_per_sec      = 200;
+    uint32_t burst_frames        = 400;
+    uint32_t bytes_per_sec       = 256 * 1024;
+    uint32_t burst_bytes         = 512 * 1024;
+
+    uint32_t quarantine_score    = 500;      // Score that triggers quarantine (0 = never)
+    uint32_t score_decay_per_sec = 50;
+    uint32_t quarantine_ms       = 30000;    // First offence; doubles per repeat
+    uint32_t max_quarantine_ms   = 600000;
+};
+
+/**
+ * Admission counters
+ */
+struct AdmissionStats {
+    uint64_t admitted;
+    uint64_t rate_limited;         // Dropped: over the peer's budget
+    uint64_t quarantine_dropped;   // Dropped: peer in quarantine
+    uint64_t penalties;            // Frames refused after admission
+    uint64_t quarantines;          // Times a peer was quarantined
+    uint64_t quarantined_peers;    // Currently in quarantine
+};
+
+class AdmissionControl {
+public:
+    // Score added per frame over budget, and per frame refused later
+    static constexpr uint32_t kRatePenalty = 1;
+    static constexpr uint32_t kBadFramePenalty = 20;
+
+    AdmissionControl();
+    explicit AdmissionControl(const AdmissionConfig& config);
+
+    // Non-copyable
+    AdmissionControl(const AdmissionControl&) = delete;
+    AdmissionControl& operator=(const AdmissionControl&) = delete;
+
+    // Replace the limits (buckets keep their current level)
+    void set_config(const AdmissionConfig& config);
+    AdmissionConfig config() const;
+
+    // Charge one frame of `bytes`; false if it must be dropped
+    bool admit(uint64_t peer_id, size_t bytes, int64_t now_ms);
+
+    // A frame that was admitted turned out bad
+    void penalize(uint64_t peer_id, uint32_t points, int64_t now_ms);
+
+    bool is_quarantined(uint64_t peer_id, int64_t now_ms) const;
+
+    // Forget peers with full buckets, no score and no quarantine
+    void sweep(int64_t now_ms);
+
+    AdmissionStats stats(int64_t now_ms) const;
+
+private:
+    struct PeerState {
+        double   frame_tokens;
+        double   byte_tokens;
+        double   score;
+        int64_t  updated_ms;
+        int64_t  quarantined_until;
+        uint32_t offences;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<uint64_t, PeerState> peers;
+    };
+
+    static constexpr size_t kShards = 16;
+
+    Shard& shard_for(uint64_t peer_id);
+    const Shard& shard_for(uint64_t peer_id) const;
+
+    // Refill and decay up to now (shard lock held)
+    void advance(PeerState& peer, int64_t now_ms) const;
+
+    // Adds points; quarantines at the threshold (shard lock held)
+    void add_score(PeerState& peer, double points, int64_t now_ms);
+
+    PeerState fresh(int64_t now_ms) const;
+
+    // Written with every shard locked, read with one
+    AdmissionConfig config_;
+    Shard shards_[kShards];
+
+    std::atomic<uint64_t> admitted_;
+    std::atomic<uint64_t> rate_limited_;
+    std::atomic<uint64_t> quarantine_dropped_;
+    std::atomic<uint64_t> penalties_;
+    std::atomic<uint64_t> quarantines_;
+};
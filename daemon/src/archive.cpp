@@ -0,0 +1,433 @@
+/**
+ * Archive Implementation
+ */
+
+#include "archive.h"
+#include "byte_io.h"
+#include "crc32.h"
+#include "lz_codec.h"
+
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t   kHeaderBytes      = 16;
+constexpr size_t   kBlockHeaderBytes = 13;
+constexpr size_t   kEntryFixedBytes  = 23;
+constexpr uint32_t kMaxBlockBytes    = 16u << 20;
+constexpr uint16_t kFlagCompressed   = 1;
+constexpr size_t   kStdioBuffer      = 256 * 1024;
+
+enum : uint8_t {
+    kCodecStored = 0,
+    kCodecLz     = 1
+};
+
+} // namespace
+
+// =============================================================================
+// MARK: - ArchiveWriter
+// =============================================================================
+
+ArchiveWriter::ArchiveWriter()
+    : file_(nullptr)
+    , compress_(false)
+    , stats_{0, 0, 0}
+{
+}
+
+ArchiveWriter::~ArchiveWriter() {
+    abort();
+}
+
+bool ArchiveWriter::open(const std::string& path, bool compress, int64_t created_at) {
+    abort();
+
+    path_ = path;
+    compress_ = compress;
+    stats_ = ArchiveStats{0, 0, 0};
+    block_.clear();
+    block_.reserve(kBlockBytes + 64 * 1024);
+
+    file_ = std::fopen((path + ".tmp").c_str(), "wb");
+    if (!file_) {
+        return false;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, kStdioBuffer);
+
+    std::string header;
+    put_u32(header, kArchiveMagic);
+    put_u16(header, kArchiveVersion);
+    put_u16(header, compress ? kFlagCompressed : 0);
+    put_u64(header, static_cast<uint64_t>(created_at));
+
+    if (std::fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+        abort();
+        return false;
+    }
+    stats_.file_bytes = header.size();
+    return true;
+}
+
+bool ArchiveWriter::add(const StoredMessage& message) {
+    if (!file_ || message.conversation.size() > 0xFFFF) {
+        return false;
+    }
+
+    put_u16(block_, static_cast<uint16_t>(message.conversation.size()));
+    put_u8(block_, static_cast<uint8_t>(message.direction));
+    put_u64(block_, static_cast<uint64_t>(message.timestamp));
+    put_u64(block_, static_cast<uint64_t>(message.expires_at));
+    put_u32(block_, static_cast<uint32_t>(message.body.size()));
+    block_.append(message.conversation);
+    block_.append(message.body);
+    stats_.messages++;
+
+    return block_.size() < kBlockBytes || flush_block();
+}
+
+bool ArchiveWriter::finish() {
+    if (!file_ || !flush_block()) {
+        abort();
+        return false;
+    }
+
+    std::string trailer;
+    put_u64(trailer, stats_.messages);
+
+    std::string header;
+    put_u32(header, 0);
+    put_u32(header, static_cast<uint32_t>(trailer.size()));
+    put_u32(header, crc32(trailer.data(), trailer.size()));
+    put_u8(header, kCodecStored);
+
+    bool ok = std::fwrite(header.data(), 1, header.size(), file_) == header.size() &&
+              std::fwrite(trailer.data(), 1, trailer.size(), file_) == trailer.size() &&
+              std::fflush(file_) == 0 &&
+              ::fsync(::fileno(file_)) == 0;
+    ok = std::fclose(file_) == 0 && ok;
+    file_ = nullptr;
+    stats_.file_bytes += header.size() + trailer.size();
+
+    const std::string tmp = path_ + ".tmp";
+    if (!ok || std::rename(tmp.c_str(), path_.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+void ArchiveWriter::abort() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+        std::remove((path_ + ".tmp").c_str());
+    }
+}
+
+ArchiveStats ArchiveWriter::stats() const {
+    return stats_;
+}
+
+bool ArchiveWriter::flush_block() {
+    if (block_.empty()) {
+        return true;
+    }
+    bool ok = write_block(block_, compress_);
+    block_.clear();
+    return ok;
+}
+
+bool ArchiveWriter::write_block(const std::string& raw, bool allow_compress) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(raw.data());
+    size_t stored_len = raw.size();
+    uint8_t codec = kCodecStored;
+
+    if (allow_compress) {
+        scratch_.resize(lz_compress_bound(raw.size()));
+        size_t n = lz_compress(data, raw.size(), scratch_.data(), raw.size() - 1);
+        if (n > 0) {
+            data = scratch_.data();
+            stored_len = n;
+            codec = kCodecLz;
+        }
+    }
+
+    std::string header;
+    put_u32(header, static_cast<uint32_t>(raw.size()));
+    put_u32(header, static_cast<uint32_t>(stored_len));
+    put_u32(header, crc32(raw.data(), raw.size()));
+    put_u8(header, codec);
+
+    if (std::fwrite(header.data(), 1, header.size(), file_) != header.size() ||
+        std::fwrite(data, 1, stored_len, file_) != stored_len) {
+        return false;
+    }
+
+    stats_.raw_bytes += raw.size();
+    stats_.file_bytes += header.size() + stored_len;
+    return true;
+}
+
+// =============================================================================
+// MARK: - ArchiveReader
+// =============================================================================
+
+ArchiveReader::ArchiveReader()
+    : file_(nullptr)
+    , created_at_(0)
+    , bytes_read_(0)
+    , file_size_(0)
+    , messages_(0)
+    , done_(false)
+{
+}
+
+ArchiveReader::~ArchiveReader() {
+    close();
+}
+
+ArchiveResult ArchiveReader::open(const std::string& path) {
+    close();
+
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) {
+        return ArchiveResult::IoError;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, kStdioBuffer);
+
+    if (std::fseek(file_, 0, SEEK_END) == 0) {
+        long size = std::ftell(file_);
+        file_size_ = size > 0 ? static_cast<uint64_t>(size) : 0;
+    }
+    std::fseek(file_, 0, SEEK_SET);
+
+    char header[kHeaderBytes];
+    if (std::fread(header, 1, kHeaderBytes, file_) != kHeaderBytes ||
+        get_u32(header) != kArchiveMagic || get_u16(header + 4) != kArchiveVersion) {
+        close();
+        return ArchiveResult::Corrupt;
+    }
+
+    created_at_ = static_cast<int64_t>(get_u64(header + 8));
+    bytes_read_ = kHeaderBytes;
+    messages_ = 0;
+    done_ = false;
+    return ArchiveResult::Ok;
+}
+
+void ArchiveReader::close() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+ArchiveResult ArchiveReader::next_block(std::vector<StoredMessage>& out) {
+    out.clear();
+
+    if (done_) {
+        return ArchiveResult::Ok;
+    }
+    if (!file_) {
+        return ArchiveResult::IoError;
+    }
+
+    char header[kBlockHeaderBytes];
+    if (std::fread(header, 1, kBlockHeaderBytes, file_) != kBlockHeaderBytes) {
+        return ArchiveResult::Corrupt; // Truncated before the trailer
+    }
+
+    const uint32_t raw_len = get_u32(header);
+    const uint32_t stored_len = get_u32(header + 4);
+    const uint32_t crc = get_u32(header + 8);
+    const uint8_t codec = static_cast<uint8_t>(header[12]);
+
+    if (raw_len > kMaxBlockBytes || stored_len > lz_compress_bound(kMaxBlockBytes) ||
+        (codec == kCodecStored && stored_len != (raw_len == 0 ? 8u : raw_len)) ||
+        codec > kCodecLz) {
+        return ArchiveResult::Corrupt;
+    }
+
+    stored_.resize(stored_len);
+    if (std::fread(&stored_[0], 1, stored_len, file_) != stored_len) {
+        return ArchiveResult::Corrupt;
+    }
+    bytes_read_ += kBlockHeaderBytes + stored_len;
+
+    // Trailer
+    if (raw_len == 0) {
+        if (crc32(stored_.data(), stored_len) != crc || get_u64(stored_.data()) != messages_) {
+            return ArchiveResult::Corrupt;
+        }
+        done_ = true;
+        return ArchiveResult::Ok;
+    }
+
+    const std::string* raw = &stored_;
+    if (codec == kCodecLz) {
+        raw_.resize(raw_len);
+        if (!lz_decompress(reinterpret_cast<const uint8_t*>(stored_.data()), stored_len,
+                           reinterpret_cast<uint8_t*>(&raw_[0]), raw_len)) {
+            return ArchiveResult::Corrupt;
+        }
+        raw = &raw_;
+    }
+
+    if (crc32(raw->data(), raw_len) != crc) {
+        return ArchiveResult::Corrupt;
+    }
+
+    const char* p = raw->data();
+    const char* end = p + raw_len;
+    while (p < end) {
+        if (static_cast<size_t>(end - p) < kEntryFixedBytes) {
+            return ArchiveResult::Corrupt;
+        }
+        const uint16_t conv_len = get_u16(p);
+        const uint32_t body_len = get_u32(p + 19);
+        if (static_cast<size_t>(end - p) - kEntryFixedBytes < size_t(conv_len) + body_len) {
+            return ArchiveResult::Corrupt;
+        }
+
+        StoredMessage msg;
+        msg.seq = 0;
+        msg.direction = static_cast<uint8_t>(p[2]) ? MessageDirection::Outbound : MessageDirection::Inbound;
+        msg.timestamp = static_cast<int64_t>(get_u64(p + 3));
+        msg.expires_at = static_cast<int64_t>(get_u64(p + 11));
+        msg.conversation.assign(p + kEntryFixedBytes, conv_len);
+        msg.body.assign(p + kEntryFixedBytes + conv_len, body_len);
+        out.push_back(std::move(msg));
+
+        p += kEntryFixedBytes + conv_len + body_len;
+    }
+
+    messages_ += out.size();
+    return ArchiveResult::Ok;
+}
+
+int64_t ArchiveReader::created_at() const {
+    return created_at_;
+}
+
+uint64_t ArchiveReader::bytes_read() const {
+    return bytes_read_;
+}
+
+uint64_t ArchiveReader::file_size() const {
+    return file_size_;
+}
+
+// =============================================================================
+// MARK: - Store Export/Import
+// =============================================================================
+
+ArchiveResult export_archive(
+    const MessageStore& store,
+    const std::string& path,
+    bool compress,
+    const ArchiveProgress& progress,
+    ArchiveStats* stats
+) {
+    ArchiveWriter writer;
+    const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    if (!store.is_open() || !writer.open(path, compress, now)) {
+        return ArchiveResult::IoError;
+    }
+
+    const uint64_t total = store.compaction_stats().disk_bytes;
+    uint64_t reported = 0;
+    bool io_ok = true;
+    bool cancelled = false;
+
+    bool complete = store.for_each_message([&](const StoredMessage& msg) {
+        if (!writer.add(msg)) {
+            io_ok = false;
+            return false;
+        }
+
+        // Report once per block written
+        const ArchiveStats s = writer.stats();
+        if (progress && s.raw_bytes != reported) {
+            reported = s.raw_bytes;
+            if (!progress(s.messages, s.raw_bytes, total)) {
+                cancelled = true;
+                return false;
+            }
+        }
+        return true;
+    });
+
+    if (!complete) {
+        writer.abort();
+        return cancelled ? ArchiveResult::Cancelled : ArchiveResult::IoError;
+    }
+    if (!io_ok || !writer.finish()) {
+        return ArchiveResult::IoError;
+    }
+
+    const ArchiveStats s = writer.stats();
+    if (progress) {
+        progress(s.messages, s.raw_bytes, s.raw_bytes);
+    }
+    if (stats) {
+        *stats = s;
+    }
+    return ArchiveResult::Ok;
+}
+
+ArchiveResult import_archive(
+    MessageStore& store,
+    const std::string& path,
+    const ArchiveProgress& progress,
+    const std::function<void(const std::vector<StoredMessage>&)>& on_batch,
+    ArchiveStats* stats
+) {
+    if (!store.is_open()) {
+        return ArchiveResult::IoError;
+    }
+
+    ArchiveReader reader;
+    ArchiveResult result = reader.open(path);
+    if (result != ArchiveResult::Ok) {
+        return result;
+    }
+
+    ArchiveStats s{0, 0, 0};
+    std::vector<StoredMessage> batch;
+
+    for (;;) {
+        result = reader.next_block(batch);
+        if (result != ArchiveResult::Ok || batch.empty()) {
+            break;
+        }
+
+        if (store.import_messages(batch) != batch.size()) {
+            result = ArchiveResult::IoError;
+            break;
+        }
+        if (on_batch) {
+            on_batch(batch);
+        }
+
+        s.messages += batch.size();
+        for (const auto& msg : batch) {
+            s.raw_bytes += kEntryFixedBytes + msg.conversation.size() + msg.body.size();
+        }
+
+        if (progress && !progress(s.messages, reader.bytes_read(), reader.file_size())) {
+            result = ArchiveResult::Cancelled;
+            break;
+        }
+    }
+
+    s.file_bytes = reader.bytes_read();
+    if (stats) {
+        *stats = s;
+    }
+    return result;
+}
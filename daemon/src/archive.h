@@ -0,0 +1,175 @@
+/**
+ * Archive - Streaming Chat History Export/Import
+ *
+ * A single sequential file for backups and phone-to-phone migration.
+ * Export and import both stream: memory is bounded by one block (plus one
+ * store segment on export) regardless of history size.
+ *
+ * File Layout (little-endian):
+ *   Header (16 bytes):
+ *     u32 magic       kArchiveMagic ("MCAR")
+ *     u16 version     kArchiveVersion
+ *     u16 flags       bit 0 = blocks may be compressed
+ *     i64 created_at  Unix ms
+ *   Blocks:
+ *     u32 raw_len     uncompressed payload size
+ *     u32 stored_len  bytes that follow
+ *     u32 crc32       over the uncompressed payload
+ *     u8  codec       0 = stored, 1 = LZ (lz_codec.h)
+ *     stored_len bytes
+ *   Trailer:
+ *     a block with raw_len 0 whose payload is u64 message count
+ *
+ * Block Payload (sequence of messages):
+ *   u16 conv_len, u8 direction, i64 timestamp, i64 expires_at,
+ *   u32 body_len, conversation, body
+ *
+ * A block that does not shrink is written stored, so incompressible
+ * (e.g. already encrypted) history costs only the block header.
+ * A missing trailer means the file was truncated.
+ */
+
+#pragma once
+
+#include "message_store.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+constexpr uint32_t kArchiveMagic   = 0x5241434D; // "MCAR"
+constexpr uint16_t kArchiveVersion = 1;
+
+// =============================================================================
+// MARK: - Types
+// =============================================================================
+
+enum class ArchiveResult {
+    Ok,
+    IoError,       // Cannot read/write the file or store
+    Corrupt,       // Bad magic/version, checksum mismatch or truncation
+    Cancelled      // Progress callback asked to stop
+};
+
+struct ArchiveStats {
+    uint64_t messages;
+    uint64_t raw_bytes;      // Uncompressed payload bytes
+    uint64_t file_bytes;     // Archive size on disk
+};
+
+/**
+ * Progress report; return false to cancel
+ *
+ * @param bytes_total Best estimate of the total (0 if unknown)
+ */
+using ArchiveProgress = std::function<bool(
+    uint64_t messages,
+    uint64_t bytes_done,
+    uint64_t bytes_total
+)>;
+
+// =============================================================================
+// MARK: - ArchiveWriter Class
+// =============================================================================
+
+class ArchiveWriter {
+public:
+    static constexpr size_t kBlockBytes = 256 * 1024;
+
+    ArchiveWriter();
+    ~ArchiveWriter();
+
+    // Non-copyable
+    ArchiveWriter(const ArchiveWriter&) = delete;
+    ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+    // Writes to <path>.tmp; finish() makes it visible atomically
+    bool open(const std::string& path, bool compress, int64_t created_at);
+    bool add(const StoredMessage& message);
+    bool finish();
+    void abort();
+
+    ArchiveStats stats() const;
+
+private:
+    bool flush_block();
+    bool write_block(const std::string& raw, bool allow_compress);
+
+    std::FILE*   file_;
+    std::string  path_;
+    bool         compress_;
+    std::string  block_;
+    std::vector<uint8_t> scratch_;
+    ArchiveStats stats_;
+};
+
+// =============================================================================
+// MARK: - ArchiveReader Class
+// =============================================================================
+
+class ArchiveReader {
+public:
+    ArchiveReader();
+    ~ArchiveReader();
+
+    // Non-copyable
+    ArchiveReader(const ArchiveReader&) = delete;
+    ArchiveReader& operator=(const ArchiveReader&) = delete;
+
+    ArchiveResult open(const std::string& path);
+    void close();
+
+    /**
+     * Decode the next block into out (replacing its contents)
+     *
+     * @return Ok with an empty vector once the trailer has been verified
+     */
+    ArchiveResult next_block(std::vector<StoredMessage>& out);
+
+    int64_t  created_at() const;
+    uint64_t bytes_read() const;
+    uint64_t file_size() const;
+
+private:
+    std::FILE* file_;
+    int64_t    created_at_;
+    uint64_t   bytes_read_;
+    uint64_t   file_size_;
+    uint64_t   messages_;
+    bool       done_;
+    std::string raw_;
+    std::string stored_;
+};
+
+// =============================================================================
+// MARK: - Store Export/Import
+// =============================================================================
+
+/**
+ * Export every live message of the store
+ */
+ArchiveResult export_archive(
+    const MessageStore& store,
+    const std::string& path,
+    bool compress,
+    const ArchiveProgress& progress,
+    ArchiveStats* stats
+);
+
+/**
+ * Import an archive into the store in bulk (one write per block)
+ *
+ * Messages are appended with fresh sequence numbers. Import stops at the
+ * first damaged block; blocks before it remain imported.
+ *
+ * @param on_batch Optional observer for each imported block
+ */
+ArchiveResult import_archive(
+    MessageStore& store,
+    const std::string& path,
+    const ArchiveProgress& progress,
+    const std::function<void(const std::vector<StoredMessage>&)>& on_batch,
+    ArchiveStats* stats
+);
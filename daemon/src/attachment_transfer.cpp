@@ -0,0 +1,201 @@
+/**
+ * AttachmentTransfer Implementation
+ */
+
+#include "attachment_transfer.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr size_t kHashBytes = 32;
+
+ChunkHash read_hash(const char* p) {
+    ChunkHash hash;
+    std::copy(p, p + kHashBytes, hash.begin());
+    return hash;
+}
+
+void append_hash(std::string& out, const ChunkHash& hash) {
+    out.append(reinterpret_cast<const char*>(hash.data()), hash.size());
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Constructor
+// =============================================================================
+
+AttachmentTransfer::AttachmentTransfer(ChunkStore& store, SendFn send, CompleteFn complete)
+    : store_(store)
+    , send_(std::move(send))
+    , complete_(std::move(complete))
+    , next_order_(0)
+{
+}
+
+// =============================================================================
+// MARK: - Sending
+// =============================================================================
+
+bool AttachmentTransfer::offer(uint64_t peer_id, const ChunkHash& id) {
+    Manifest manifest;
+    if (!store_.get_manifest(id, manifest)) {
+        return false;
+    }
+
+    send_(peer_id, make_frame(FrameType::ChunkOffer, ChunkStore::encode_manifest(manifest)));
+    return true;
+}
+
+// =============================================================================
+// MARK: - Frame Dispatch
+// =============================================================================
+
+bool AttachmentTransfer::on_frame(uint64_t peer_id, const FrameHeader& header,
+                                  const char* payload, size_t len) {
+    switch (header.type) {
+        case FrameType::ChunkOffer:
+            return handle_offer(peer_id, payload, len);
+        case FrameType::ChunkRequest:
+            return handle_request(peer_id, payload, len);
+        case FrameType::ChunkData:
+            return handle_data(peer_id, payload, len);
+        default:
+            break; // Not an attachment frame
+    }
+    return false;
+}
+
+size_t AttachmentTransfer::pending_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+// =============================================================================
+// MARK: - Handlers
+// =============================================================================
+
+bool AttachmentTransfer::handle_offer(uint64_t peer_id, const char* payload, size_t len) {
+    Manifest manifest;
+    if (!ChunkStore::decode_manifest(payload, len, manifest)) {
+        return false;
+    }
+
+    std::vector<ChunkHash> missing = store_.missing_chunks(manifest);
+
+    // Everything is already here: nothing crosses the link
+    if (missing.empty()) {
+        if (!store_.add_manifest(manifest)) {
+            return false;
+        }
+        if (complete_) {
+            complete_(peer_id, manifest.id, manifest.total_size);
+        }
+        return true;
+    }
+
+    std::string request;
+    request.reserve(kHashBytes * (missing.size() + 1));
+    append_hash(request, manifest.id);
+    for (const auto& hash : missing) {
+        append_hash(request, hash);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (pending_.find(manifest.id) == pending_.end() && pending_.size() >= kMaxPending) {
+            auto oldest = std::min_element(pending_.begin(), pending_.end(),
+                [](const auto& a, const auto& b) { return a.second.order < b.second.order; });
+            pending_.erase(oldest);
+        }
+
+        Pending& p = pending_[manifest.id];
+        p.peer_id = peer_id;
+        p.remaining = std::set<ChunkHash>(missing.begin(), missing.end());
+        p.manifest = std::move(manifest);
+        p.order = next_order_++;
+    }
+
+    send_(peer_id, make_frame(FrameType::ChunkRequest, request));
+    return true;
+}
+
+bool AttachmentTransfer::handle_request(uint64_t peer_id, const char* payload, size_t len) {
+    if (len < kHashBytes || len % kHashBytes != 0) {
+        return false;
+    }
+
+    // Only serve chunks of an attachment we actually hold and offered
+    Manifest manifest;
+    if (!store_.get_manifest(read_hash(payload), manifest)) {
+        return false;
+    }
+    std::set<ChunkHash> allowed;
+    for (const auto& ref : manifest.chunks) {
+        allowed.insert(ref.hash);
+    }
+
+    std::string chunk;
+    for (size_t off = kHashBytes; off < len; off += kHashBytes) {
+        const ChunkHash hash = read_hash(payload + off);
+        if (allowed.count(hash) == 0 || !store_.read_chunk(hash, chunk)) {
+            continue;
+        }
+
+        std::string data;
+        data.reserve(kHashBytes + chunk.size());
+        append_hash(data, hash);
+        data.append(chunk);
+        send_(peer_id, make_frame(FrameType::ChunkData, data));
+    }
+    return true;
+}
+
+bool AttachmentTransfer::handle_data(uint64_t peer_id, const char* payload, size_t len) {
+    if (len < kHashBytes) {
+        return false;
+    }
+
+    const ChunkHash hash = read_hash(payload);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool requested = false;
+        for (const auto& pair : pending_) {
+            if (pair.second.peer_id == peer_id && pair.second.remaining.count(hash)) {
+                requested = true;
+                break;
+            }
+        }
+        if (!requested) {
+            return false;
+        }
+    }
+
+    if (!store_.put_chunk(hash, payload + kHashBytes, len - kHashBytes)) {
+        return false; // Corrupt or tampered chunk
+    }
+
+    std::vector<Pending> finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = pending_.begin(); it != pending_.end();) {
+            it->second.remaining.erase(hash);
+            if (it->second.remaining.empty()) {
+                finished.push_back(std::move(it->second));
+                it = pending_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for (const auto& done : finished) {
+        if (store_.add_manifest(done.manifest) && complete_) {
+            complete_(done.peer_id, done.manifest.id, done.manifest.total_size);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,73 @@
+/**
+ * AttachmentTransfer - Chunk-Level Attachment Exchange
+ *
+ * Sends attachments from a ChunkStore to a peer and only moves the chunks
+ * the receiver does not already hold.
+ *
+ * Protocol (see frame.h):
+ *   ChunkOffer    sender -> receiver   encoded Manifest
+ *   ChunkRequest  receiver -> sender   32-byte attachment id + missing hashes
+ *   ChunkData     sender -> receiver   32-byte chunk hash + chunk bytes
+ *
+ * The receiver completes an attachment once every requested chunk has
+ * arrived and verified against its hash. Chunks nobody asked for are
+ * dropped, so a peer cannot fill the store with unsolicited data.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. Callbacks are invoked without the
+ *   internal lock held.
+ */
+
+#pragma once
+
+#include "chunk_store.h"
+#include "frame.h"
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+class AttachmentTransfer {
+public:
+    using SendFn = std::function<void(uint64_t peer_id, const std::string& frame)>;
+    using CompleteFn = std::function<void(uint64_t peer_id, const ChunkHash& id, uint64_t size)>;
+
+    // Incomplete inbound transfers kept at once; oldest are dropped
+    static constexpr size_t kMaxPending = 64;
+
+    AttachmentTransfer(ChunkStore& store, SendFn send, CompleteFn complete);
+
+    // Non-copyable
+    AttachmentTransfer(const AttachmentTransfer&) = delete;
+    AttachmentTransfer& operator=(const AttachmentTransfer&) = delete;
+
+    // Offer a stored attachment to a peer
+    bool offer(uint64_t peer_id, const ChunkHash& id);
+
+    // Handle an inbound attachment frame; returns false if malformed
+    bool on_frame(uint64_t peer_id, const FrameHeader& header, const char* payload, size_t len);
+
+    size_t pending_count() const;
+
+private:
+    struct Pending {
+        uint64_t            peer_id;
+        Manifest            manifest;
+        std::set<ChunkHash> remaining;
+        uint64_t            order;
+    };
+
+    bool handle_offer(uint64_t peer_id, const char* payload, size_t len);
+    bool handle_request(uint64_t peer_id, const char* payload, size_t len);
+    bool handle_data(uint64_t peer_id, const char* payload, size_t len);
+
+    ChunkStore& store_;
+    SendFn      send_;
+    CompleteFn  complete_;
+
+    mutable std::mutex mutex_;
+    std::map<ChunkHash, Pending> pending_;   // By attachment id
+    uint64_t next_order_;
+};
@@ -0,0 +1,642 @@
+/**
+ * BasicDaemon - Core Event Processing Engine
+ *
+ * This class manages the main event loop for mesh networking.
+ * It processes events from a queue in a background thread.
+ *
+ * The queue, locking, clock and logger are policies chosen at compile
+ * time (see daemon_policies.h); Daemon (daemon.h) is the default
+ * instantiation. Member definitions live in basic_daemon_impl.h, which
+ * only the translation unit that instantiates a configuration includes.
+ *
+ * Thread Model:
+ *   - Single worker thread processes events in batches, through the
+ *     inbound or outbound pipeline of named stages (see pipeline.h)
+ *   - Inbound data is decoded (admission, decryption, signatures) on the
+ *     offload pool first; the worker only delivers ready messages
+ *   - Heavy or blocking work is offloaded to a pool; its continuation
+ *     comes back to the worker as an event, in order per peer
+ *   - Thread-safe event submission from any thread
+ *   - Callbacks invoked on the worker thread (caller must dispatch)
+ *   - Coroutine tasks (daemon_task.h, C++20) run on the worker thread
+ *   - Queue depth rides in outbound frame headers; neighbours' hints pace
+ *     what is sent to them, released by the worker (congestion.h)
+ *   - BLE scan batches are filtered on the caller's thread; only the
+ *     resulting discovery changes reach the worker (scan_filter.h)
+ *   - The worker keeps the target neighbour set under the link budget and
+ *     recommends connects and disconnects (link_manager.h)
+ *   - Traffic, neighbour churn and the app's outbox set the scan and
+ *     advertise duty cycle recommended to the platform (duty_cycle.h)
+ *   - Hibernating, timers and maintenance share one wakeup per slack
+ *     interval and optional work is put off; events still wake the
+ *     worker at once (hibernation.h)
+ *   - Counters, queue depth and latency histograms (queue wait, handler,
+ *     callback, transport send) are updated lock-free (metrics.h)
+ *   - Tracing, when on, records enqueue/dequeue, batches, stages,
+ *     callbacks and sends into per-thread rings (tracer.h)
+ *   - Log calls encode binary records into a lock-free ring; a logging
+ *     thread formats and writes them, payloads redacted (logger.h)
+ *   - Every handled or refused event leaves a fixed-size record in the
+ *     flight recorder, dumped on demand or on a crash (flight_recorder.h)
+ *   - A watchdog thread reports work that hangs the worker and events
+ *     left too long in the queue, and trips the flight recorder; slow
+ *     work is kept in a histogram (watchdog.h)
+ *
+ * Event Types:
+ *   - Peer connection/disconnection
+ *   - Data received from peers
+ *   - Internal commands (send, etc.)
+ */
+
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <queue>
+#include <cstdint>
+#include <string>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <atomic>
+#include <ostream>
+#include "transport.h"
+#include "conversation_table.h"
+#include "chunk_store.h"
+#include "frame.h"
+#include "frame_pool.h"
+#include "session_cache.h"
+#include "signature_verifier.h"
+#include "handshake.h"
+#include "offload_pool.h"
+#include "ingress.h"
+#include "pipeline.h"
+#include "task_scheduler.h"
+#include "admission.h"
+#include "congestion.h"
+#include "scan_filter.h"
+#include "link_manager.h"
+#include "duty_cycle.h"
+#include "hibernation.h"
+#include "metrics.h"
+#include "tracer.h"
+#include "logger.h"
+#include "flight_recorder.h"
+#include "watchdog.h"
+#include "daemon_policies.h"
+
+class Transport;
+class MessageStore;
+class AttachmentTransfer;
+class ContactDirectory;
+
+// =============================================================================
+// MARK: - Callback Types
+// =============================================================================
+
+/**
+ * Callback signatures for Daemon events
+ */
+struct DaemonCallbacks {
+    using MessageCallback = std::function<void(
+        uint64_t peer_id,
+        const std::string& peer_uid,
+        const std::string& message,
+        int64_t timestamp
+    )>;
+    
+    using StatusCallback = std::function<void(int status, const std::string& message)>;
+    
+    using PeerCallback = std::function<void(
+        uint64_t peer_id,
+        const std::string& peer_uid,
+        bool connected
+    )>;
+    
+    // Only conversations that changed since the last call; delivered
+    // once the queue drains, so bursts are coalesced
+    using ConversationsCallback = std::function<void(
+        const std::vector<ConversationSummary>& changed
+    )>;
+    
+    // An inbound attachment is complete and readable from the chunk store
+    using AttachmentCallback = std::function<void(
+        uint64_t peer_id,
+        const ChunkHash& id,
+        uint64_t size
+    )>;
+    
+    // Scanned devices found, moved or lost (see scan_filter.h)
+    using DiscoveryCallback = std::function<void(
+        const std::vector<DiscoveryChange>& changes
+    )>;
+    
+    // Connect to or drop these neighbours (see link_manager.h)
+    using LinkCallback = std::function<void(
+        const std::vector<LinkRecommendation>& recommendations
+    )>;
+    
+    // Scan and advertise at this duty cycle from now on (see duty_cycle.h)
+    using DutyCycleCallback = std::function<void(
+        const DutySchedule& schedule
+    )>;
+    
+    // A signed message and the key bound to its sender that verified it;
+    // when set, signed messages come here instead of on_message
+    using SignedMessageCallback = std::function<void(
+        uint64_t peer_id,
+        const std::string& peer_uid,
+        const std::string& message,
+        int64_t timestamp,
+        const SignerKey& signer
+    )>;
+    
+    MessageCallback       on_message;
+    StatusCallback        on_status;
+    PeerCallback          on_peer;
+    ConversationsCallback on_conversations;
+    AttachmentCallback    on_attachment;
+    DiscoveryCallback     on_discovery;
+    LinkCallback          on_link;
+    DutyCycleCallback     on_duty_cycle;
+    SignedMessageCallback on_signed_message;
+};
+
+// =============================================================================
+// MARK: - Peer Info
+// =============================================================================
+
+struct PeerInfo {
+    uint64_t    peer_id;
+    std::string uid;
+    bool        connected;
+    int64_t     connected_at;
+};
+
+/**
+ * Long-lived record of a peer identity, kept across disconnects and
+ * restored from snapshots on warm restart
+ */
+struct KnownPeer {
+    std::string uid;
+    uint64_t    last_peer_id;
+    int64_t     last_seen;
+    uint64_t    tx_seq;        // Messages sent to this peer
+    uint64_t    rx_seq;        // Messages received from this peer
+};
+
+// =============================================================================
+// MARK: - Events
+// =============================================================================
+
+// Event types for the work queue
+enum class DaemonEventType {
+    PeerConnected,
+    PeerDisconnected,
+    DataReceived,
+    DataDecoded,
+    SendMessage,
+    StartHandshake,
+    OffloadComplete,
+    ConversationRead,
+    TaskWakeup,
+    Shutdown
+};
+
+// Event structure (shared by every BasicDaemon configuration)
+struct DaemonEvent {
+    DaemonEventType type;
+    uint64_t        peer_id;
+    std::string     peer_uid;
+    std::string     data;
+    int64_t         timestamp;
+    
+    // Signed data: the key that verified it (SignerKey bytes), else empty
+    std::string     signer;
+    
+    // OffloadComplete: runs on the worker thread (also run after a
+    // DataReceived barrier frame to resume its peer's ingress)
+    OffloadPool::Continuation completion;
+    
+    // TaskWakeup: the suspended task to resume (see task_scheduler.h)
+    TaskWait* task;
+    
+    // When it was queued (Metrics::now_ns), for the queue wait
+    uint64_t queued_ns;
+    
+    DaemonEvent() : type(DaemonEventType::DataReceived), peer_id(0), timestamp(0), task(nullptr), queued_ns(0) {}
+};
+
+// Processing pipelines
+enum class DaemonDirection { Inbound, Outbound };
+
+// =============================================================================
+// MARK: - Daemon Class
+// =============================================================================
+
+template <typename... Policies>
+class BasicDaemon {
+public:
+    using EventType = DaemonEventType;
+    using Event     = DaemonEvent;
+    using Direction = DaemonDirection;
+    using Stage     = PipelineStage<Event>;
+    
+    // Compile-time policies (defaults fill the slots not given)
+    using Queue  = SelectPolicyT<QueuePolicyTag, StdQueue, Policies...>;
+    using Sync   = SelectPolicyT<SyncPolicyTag, StdSync, Policies...>;
+    using Clock  = SelectPolicyT<ClockPolicyTag, SystemClock, Policies...>;
+    using Logger = SelectPolicyT<LoggerPolicyTag, AsyncLogger, Policies...>;
+    
+    // Constructor/Destructor
+    BasicDaemon();
+    ~BasicDaemon();
+    
+    // Non-copyable
+    BasicDaemon(const BasicDaemon&) = delete;
+    BasicDaemon& operator=(const BasicDaemon&) = delete;
+    
+    // Lifecycle
+    void start();
+    void stop();
+    bool is_running() const;
+    bool is_busy() const;
+    
+    // Event submission (thread-safe); DataReceived goes through
+    // admission control, then ingress
+    void enqueue_event(Event event);
+    
+    // Inbound transport payload (thread-safe); policed before anything
+    // is allocated for it. False if dropped.
+    bool submit_inbound(uint64_t peer_id, const char* data, size_t len);
+    
+    // Transport
+    void set_transport(Transport* t);
+    
+    // Persistence (optional; compacted in the background while idle)
+    void set_message_store(MessageStore* store);
+    
+    // Attachments (optional; nullptr disables chunk frames)
+    void set_chunk_store(ChunkStore* store);
+    bool send_attachment(uint64_t peer_id, const ChunkHash& id);
+    
+    // Encryption: peers with a session are sealed/opened in place
+    SessionCache& sessions();
+    FramePool& frame_pool();
+    
+    // Key exchange: run (or resume) a handshake with a connected peer as
+    // initiator; false if the peer is unknown. Responding is automatic.
+    bool start_handshake(uint64_t peer_id);
+    HandshakeStats handshake_stats() const;
+    
+    // Signatures: chat messages are signed once a key is set; inbound
+    // signed frames are verified inline, or in batches on a worker pool
+    // once enabled (the pool cannot be replaced afterwards). The key a
+    // frame carries must be the one bound to the sender's UID: the
+    // signing key of its contact record, or else the first key that
+    // verified for that UID (pinned for the daemon's lifetime). Frames
+    // from peers without a UID, or with another key, are refused.
+    // Batched frames are delivered in each peer's arrival order; when the
+    // pool's queue is full (max_pending) they are refused and counted.
+    void set_signing_key(const SigningKey& key);
+    bool enable_batch_verification(const VerifierConfig& config);
+    VerifierStats verification_stats() const;
+    
+    // Offload: run a job on the pool and its continuation on the worker
+    // thread; jobs with the same key (e.g. peer id) complete in order.
+    // Blocks while the pool is full, so not for the worker thread (its
+    // own attachment frames are refused instead); false if stopped.
+    bool offload(uint64_t key, OffloadPool::Job job);
+    OffloadStats offload_stats() const;
+    IngressStats ingress_stats() const;
+    
+    // Pipelines: queued events run through named stages in batches.
+    //   Inbound:  control, decode, frames, peers, store, conversations, ui
+    //   Outbound: send, store, conversations
+    // Relay deployments can remove "store", "conversations" and "ui".
+    bool add_stage(Direction direction, std::unique_ptr<Stage> stage,
+                   const std::string& before = std::string());
+    bool remove_stage(Direction direction, const std::string& name);
+    std::vector<std::string> stage_names(Direction direction) const;
+    std::vector<StageStats> stage_stats(Direction direction) const;
+    
+    // Coroutine tasks (daemon_task.h): timers, acked sends and receives
+    // on per-peer channels; tasks run on the worker thread
+    TaskScheduler& tasks();
+    TaskStats task_stats() const;
+    
+    // Per-peer rate limits, misbehaviour score and quarantine
+    void set_admission_config(const AdmissionConfig& config);
+    AdmissionConfig admission_config() const;
+    AdmissionStats admission_stats() const;
+    
+    // Hop-by-hop backpressure: queue depth hints out, AIMD pacing in
+    void set_congestion_config(const CongestionConfig& config);
+    CongestionConfig congestion_config() const;
+    CongestionStats congestion_stats() const;
+    
+    // BLE scan batches: deduplicated and smoothed on the calling thread;
+    // changes reach on_discovery on the worker. Returns how many.
+    size_t ingest_scans(const ScanReport* reports, size_t count);
+    void set_scan_config(const ScanConfig& config);
+    ScanConfig scan_config() const;
+    ScanStats scan_stats() const;
+    
+    // Neighbour selection: the platform reports which device each
+    // connection is to, and what it learns of their neighbours
+    void bind_link(const DeviceId& id, uint64_t peer_id);
+    void set_link_neighbours(const DeviceId& id, std::vector<DeviceId> neighbours);
+    void set_link_config(const LinkConfig& config);
+    LinkConfig link_config() const;
+    LinkStats link_stats() const;
+    
+    // Radio duty cycle: the app reports how many messages wait for a
+    // route; the schedule itself goes to on_duty_cycle
+    void set_outbox_pending(size_t pending);
+    void set_duty_cycle_config(const DutyCycleConfig& config);
+    DutyCycleConfig duty_cycle_config() const;
+    DutySchedule duty_schedule() const;
+    DutyCycleStats duty_cycle_stats() const;
+    
+    // Low-power mode for an idle host (any thread)
+    void set_hibernation(bool enabled);
+    bool hibernating() const;
+    void set_hibernation_config(const HibernationConfig& config);
+    HibernationConfig hibernation_config() const;
+    HibernationStats hibernation_stats() const;
+    
+    // Counters, gauges and latency percentiles, read in one pass
+    MetricsSnapshot metrics() const;
+    
+    // Event-level tracing, exported as Chrome trace JSON (Perfetto)
+    void set_tracing(bool enabled);
+    bool tracing() const;
+    void export_trace(std::ostream& out) const;
+    void clear_trace();
+    TraceStats trace_stats() const;
+    
+    // Last events for post-mortems; an armed path is dumped to on a
+    // fatal signal or terminate
+    bool dump_flight_recorder(const std::string& path);
+    bool set_flight_dump_path(const std::string& path);
+    FlightStats flight_stats() const;
+    
+    // Stalled-worker and stale-queue detection; the callback runs on the
+    // watchdog thread
+    void set_watchdog_config(const WatchdogConfig& config);
+    WatchdogConfig watchdog_config() const;
+    void set_stall_callback(std::function<void(const StallReport&)> callback);
+    WatchdogStats watchdog_stats() const;
+    
+    // Inbound admission by UID (optional; nullptr admits everyone)
+    void set_contact_directory(ContactDirectory* directory);
+    uint64_t refused_count() const;
+    
+    // Callbacks (any time, from any thread; the worker picks up the new
+    // set on its next callback)
+    void set_callbacks(const DaemonCallbacks& callbacks);
+    
+    // Peer management
+    uint32_t get_peer_count() const;
+    void add_peer(uint64_t peer_id, const std::string& uid);
+    void remove_peer(uint64_t peer_id);
+    bool has_peer(uint64_t peer_id) const;
+    
+    // Conversation summaries (home screen)
+    ConversationTable& conversations();
+    
+    // Known peer directory (snapshot/restore)
+    std::vector<KnownPeer> known_peers() const;
+    void restore_known_peers(const std::vector<KnownPeer>& peers);
+    
+    // Direct send (bypasses queue for low latency)
+    void send_to_peer(uint64_t peer_id, const std::string& data);
+    
+    // Queued send (SendMessage) to the peer connected as `uid`
+    void send_to_uid(const std::string& uid, const std::string& data);
+    
+private:
+    // Worker thread function
+    void worker_loop();
+    
+    // Queue an event for the worker as-is
+    void post_event(Event event);
+    
+    // Queue a task wakeup; false once stopped
+    bool post_wakeup(TaskWait* wait);
+    
+    // Ingress hand-off for an admitted payload
+    bool submit_admitted(InboundFrame&& frame);
+    
+    // Ingress decode step (pool thread)
+    Ingress::Verdict decode_inbound(uint64_t peer_id, std::string& data, uint64_t ticket);
+    
+    // Admission, decryption and signature check (either thread); signed
+    // frames go to the batch verifier only with an ingress ticket
+    Ingress::Verdict open_inbound(uint64_t peer_id, const std::string& uid, std::string& data, uint64_t ticket);
+    
+    // Count and record a refused inbound frame; a bad one also costs the
+    // peer admission credit
+    void refuse_inbound(uint64_t peer_id, size_t size, bool bad);
+    
+    // Whether `key` may sign for `uid`; pins it once verified if the
+    // directory has no key for the UID (any thread)
+    bool signer_bound(const std::string& uid, const SignerKey& key, bool verified);
+    
+    // Built-in stages (constructor)
+    void install_default_stages();
+    Pipeline<Event>& pipeline(Direction direction);
+    const Pipeline<Event>& pipeline(Direction direction) const;
+    
+    // Control event handlers (control stage)
+    void handle_peer_connected(const Event& event);
+    void handle_peer_disconnected(const Event& event);
+    void handle_conversation_read(const Event& event);
+    void handle_start_handshake(const Event& event);
+    
+    // Protocol frames (frames stage)
+    void handle_frame(Event& event);
+    
+    // Chat messages in a batch, with a single flush (store stage)
+    void persist_messages(const std::vector<Event>& batch, bool outbound);
+    
+    // Chat payloads are signed when a signing key is set
+    void send_chat(uint64_t peer_id, const std::string& data);
+    
+    // Handshake frames bypass sealing and the handshake's hold queue
+    void send_unsealed(uint64_t peer_id, const std::string& frame);
+    
+    // Seals for session peers; `paced` frames wait their turn when the
+    // peer has asked us to slow down
+    void transmit(uint64_t peer_id, const std::string& data, bool paced);
+    
+    // Stamps our hint on the outermost header and hands over to the transport
+    void emit(Transport* t, uint64_t peer_id, const std::string& frame);
+    
+    // Transport::send, timed and counted
+    void send_frame(Transport* t, uint64_t peer_id, const std::string& frame);
+    
+    // Flight records for an inbound frame dropped before the worker, and
+    // for a batch the worker has run
+    void record_refused(uint64_t peer_id, size_t size);
+    void record_batch(const std::vector<Event>& survivors, uint64_t handler_ns);
+    
+    // The callback set in force (any thread)
+    std::shared_ptr<const DaemonCallbacks> current_callbacks() const;
+    
+    // A stall seen by the watchdog: flight record, dump, log, app callback
+    // (watchdog thread)
+    void on_stall(const StallReport& report);
+    
+    // Queue depth and oldest event for the watchdog (queue lock held)
+    void publish_queue();
+    
+    // Held frames now due and hints owed to neighbours (worker thread);
+    // true if anything was sent
+    bool flush_congestion();
+    
+    // Reconsider the neighbour set and report recommendations (worker thread)
+    void plan_links();
+    
+    // Re-evaluate the duty cycle and report a changed schedule (worker thread)
+    void plan_duty_cycle();
+    
+    // UID of a connected peer (empty if unknown)
+    std::string uid_for(uint64_t peer_id) const;
+    
+    // Report changed summaries (called when the queue drains)
+    void flush_conversation_changes();
+    
+    // Known peer bookkeeping
+    enum class PeerActivity { Connected, Received, Sent };
+    void note_peer_activity(uint64_t peer_id, const std::string& uid, PeerActivity activity);
+    
+    // Current store (nullptr if persistence is off)
+    MessageStore* message_store() const;
+    
+    // Idle-time work (retention/compaction); returns true if more is pending
+    bool run_maintenance();
+    
+    // Conversation key used for persistence
+    std::string conversation_for(uint64_t peer_id, const std::string& uid) const;
+    
+    // Get current timestamp (Clock policy)
+    static int64_t current_timestamp_ms();
+    
+    // One log line (Logger policy); compiled out when disabled, skipped
+    // below the process's level
+    template <typename... Args>
+    static void log(LogLevel level, const Args&... args) {
+        if constexpr (Logger::enabled) {
+            if (LogControl::enabled(level)) {
+                Logger::write(level, args...);
+            }
+        }
+    }
+    
+    using LockGuard  = std::lock_guard<typename Sync::Mutex>;
+    using UniqueLock = std::unique_lock<typename Sync::Mutex>;
+    
+    // State
+    bool running_;
+    bool busy_;
+    
+    // Threading
+    mutable typename Sync::Mutex mutex_;
+    typename Sync::Condition cv_;
+    std::thread worker_thread_;
+    
+    // Event queue
+    typename Queue::template type<Event> event_queue_;
+    
+    // Transport layer
+    Transport* transport_;
+    
+    // Conversation summaries
+    ConversationTable conversations_;
+    
+    // Message persistence
+    MessageStore* store_;
+    std::chrono::steady_clock::time_point last_maintenance_;
+    
+    // Attachment transfer (bound to the chunk store; shared with
+    // offloaded jobs so replacing the store cannot free it under them)
+    std::shared_ptr<AttachmentTransfer> attachments_;
+    
+    // Contact directory (admission) and frames it refused
+    ContactDirectory* contacts_;
+    std::atomic<uint64_t> refused_;
+    
+    // Per-peer policing ahead of ingress
+    AdmissionControl admission_;
+    
+    // Backpressure signalling and pacing towards neighbours
+    CongestionControl congestion_;
+    
+    // Scanned devices and their smoothed RSSI
+    ScanFilter scans_;
+    
+    // Target neighbour set under the link budget
+    LinkManager links_;
+    
+    // Scan/advertise schedule from recent activity
+    DutyCycleScheduler duty_;
+    
+    // Timer coalescing and wakeup accounting
+    Hibernation hibernation_;
+    
+    // Counters and latency histograms
+    Metrics metrics_;
+    
+    // Spans per thread (off by default)
+    Tracer tracer_;
+    
+    // Last events, and the batch being run (worker thread)
+    FlightRecorder            flight_;
+    std::vector<FlightRecord> flight_batch_;
+    
+    // Stall detection, and the app's stall callback
+    Watchdog                                watchdog_;
+    mutable std::mutex                      stall_mutex_;
+    std::function<void(const StallReport&)> stall_callback_;
+    
+    // Per-peer AEAD sessions and recycled frame buffers
+    SessionCache sessions_;
+    FramePool    frame_pool_;
+    
+    // Signing identity (nullptr = unsigned) and batch verification pool
+    std::shared_ptr<const SigningKey>  signing_key_;
+    std::unique_ptr<SignatureVerifier> verifier_;
+    
+    // Keys pinned to UIDs the directory has no key for (guarded by mutex_)
+    std::unordered_map<std::string, SignerKey> signer_pins_;
+    
+    // Session key exchange (installs keys into sessions_)
+    Handshake handshake_;
+    
+    // Processing stages
+    Pipeline<Event> inbound_;
+    Pipeline<Event> outbound_;
+    
+    // Heavy/blocking work; destroyed before the members its jobs use
+    std::unique_ptr<OffloadPool> offload_;
+    
+    // Inbound decode stage (runs on offload_)
+    std::unique_ptr<Ingress> ingress_;
+    
+    // Suspended coroutine tasks (worker thread)
+    TaskScheduler tasks_;
+    
+    // Callbacks, replaced whole under std::atomic_store so the worker
+    // never reads a set while it is being written
+    std::shared_ptr<const DaemonCallbacks> callbacks_;
+    
+    // Connected peers
+    std::unordered_map<uint64_t, PeerInfo> peers_;
+    std::unordered_map<std::string, KnownPeer> known_peers_;
+    mutable typename Sync::Mutex peers_mutex_;
+};
+
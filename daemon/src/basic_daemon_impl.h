@@ -0,0 +1,1898 @@
+/**
+ * BasicDaemon Implementation
+ *
+ * Core event processing engine for mesh networking.
+ * All heavy lifting happens here in a background thread.
+ *
+ * Included only by translation units that instantiate a configuration
+ * (daemon.cpp instantiates the default Daemon).
+ */
+
+#pragma once
+
+#include "basic_daemon.h"
+#include "message_store.h"
+#include "attachment_transfer.h"
+#include "contact_directory.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace daemon_detail {
+
+// Maintenance (retention + compaction) runs in short slices so a queued
+// event never waits behind more than one slice
+constexpr auto kMaintenanceSlice   = std::chrono::milliseconds(2);
+constexpr auto kMaintenanceIdle    = std::chrono::milliseconds(1000);
+constexpr auto kMaintenancePending = std::chrono::milliseconds(5);
+
+// Events taken from the queue per pipeline run
+constexpr size_t kMaxBatch = 32;
+
+// UIDs whose first verified signing key is pinned; beyond this, signed
+// frames from UIDs without a key are refused
+constexpr size_t kMaxSignerPins = 4096;
+
+// Which pipeline an event runs through; control events change state the
+// events behind them depend on, so each one is a batch of its own
+enum class Lane { Control, Inbound, Outbound };
+
+inline Lane lane_of(DaemonEventType type) {
+    switch (type) {
+        case DaemonEventType::DataReceived:
+        case DaemonEventType::DataDecoded:
+            return Lane::Inbound;
+        case DaemonEventType::SendMessage:
+            return Lane::Outbound;
+        default:
+            return Lane::Control;
+    }
+}
+
+// Trace name of an event type
+inline const char* event_name(DaemonEventType type) {
+    switch (type) {
+        case DaemonEventType::PeerConnected:     return "PeerConnected";
+        case DaemonEventType::PeerDisconnected:  return "PeerDisconnected";
+        case DaemonEventType::DataReceived:      return "DataReceived";
+        case DaemonEventType::DataDecoded:       return "DataDecoded";
+        case DaemonEventType::SendMessage:       return "SendMessage";
+        case DaemonEventType::StartHandshake:    return "StartHandshake";
+        case DaemonEventType::OffloadComplete:   return "OffloadComplete";
+        case DaemonEventType::ConversationRead:  return "ConversationRead";
+        case DaemonEventType::TaskWakeup:        return "TaskWakeup";
+        case DaemonEventType::Shutdown:          return "Shutdown";
+    }
+    return "Event";
+}
+
+// Devices that appeared or went; RSSI updates are not churn
+inline size_t churn_in(const std::vector<DiscoveryChange>& changes) {
+    size_t churn = 0;
+    for (const DiscoveryChange& change : changes) {
+        churn += change.kind == DiscoveryKind::Updated ? 0 : 1;
+    }
+    return churn;
+}
+
+} // namespace daemon_detail
+
+// =============================================================================
+// MARK: - Constructor/Destructor
+// =============================================================================
+
+template <typename... Policies>
+BasicDaemon<Policies...>::BasicDaemon()
+    : running_(false)
+    , busy_(false)
+    , transport_(nullptr)
+    , store_(nullptr)
+    , last_maintenance_(std::chrono::steady_clock::now())
+    , contacts_(nullptr)
+    , refused_(0)
+    , watchdog_(metrics_)
+    , handshake_(sessions_,
+                 [this](uint64_t peer_id, const std::string& frame) {
+                     send_unsealed(peer_id, frame);
+                 },
+                 [this](uint64_t peer_id, std::vector<std::string>&& held) {
+                     for (const auto& data : held) {
+                         send_to_peer(peer_id, data);
+                     }
+                 })
+    , offload_(new OffloadPool(OffloadConfig(),
+                               [this](uint64_t key, OffloadPool::Continuation&& continuation) {
+                                   Event event;
+                                   event.type = EventType::OffloadComplete;
+                                   event.peer_id = key;
+                                   event.completion = std::move(continuation);
+                                   post_event(std::move(event));
+                               }))
+    , tasks_([this](uint64_t peer_id, const std::string& frame) {
+                 send_to_peer(peer_id, frame);
+             },
+             [this](TaskWait* wait) {
+                 return post_wakeup(wait);
+             })
+    , callbacks_(std::make_shared<const DaemonCallbacks>())
+{
+    ingress_.reset(new Ingress(*offload_,
+        [this](uint64_t peer_id, std::string& data, uint64_t ticket) {
+            return decode_inbound(peer_id, data, ticket);
+        },
+        [this](InboundFrame&& frame, bool barrier) {
+            Event event;
+            event.type = barrier ? EventType::DataReceived : EventType::DataDecoded;
+            event.peer_id = frame.peer_id;
+            event.data = std::move(frame.data);
+            event.timestamp = frame.timestamp;
+            if (barrier) {
+                const uint64_t peer_id = frame.peer_id;
+                event.completion = [this, peer_id] { ingress_->resume(peer_id); };
+            }
+            post_event(std::move(event));
+        }));
+    
+    install_default_stages();
+    
+    watchdog_.set_callback([this](const StallReport& report) {
+        on_stall(report);
+    });
+}
+
+template <typename... Policies>
+BasicDaemon<Policies...>::~BasicDaemon() {
+    stop();
+    
+    // Pool threads post completions; they are dropped once stopped. The
+    // verifier finishes frames through the ingress, so it goes first
+    offload_.reset();
+    verifier_.reset();
+    ingress_.reset();
+}
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::start() {
+    LockGuard lock(mutex_);
+    
+    if (running_) {
+        return; // Already running
+    }
+    
+    running_ = true;
+    
+    // Barriers posted while stopped were dropped and will never resume
+    ingress_->reset();
+    
+    worker_thread_ = std::thread(&BasicDaemon::worker_loop, this);
+    watchdog_.start();
+    
+    // Notify status change
+    const auto callbacks = current_callbacks();
+    if (callbacks->on_status) {
+        callbacks->on_status(1, "Daemon started");
+    }
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::stop() {
+    {
+        LockGuard lock(mutex_);
+        
+        if (!running_) {
+            return; // Already stopped
+        }
+        
+        running_ = false;
+    }
+    
+    // Wake up the worker
+    cv_.notify_one();
+    
+    // Wait for worker to finish
+    if (worker_thread_.joinable()) {
+        worker_thread_.join();
+    }
+    watchdog_.stop();
+    
+    // Suspended tasks can no longer resume; free them, including the
+    // wakeups still queued (other events stay for a restart)
+    std::vector<TaskWait*> woken;
+    {
+        LockGuard lock(mutex_);
+        typename Queue::template type<Event> kept;
+        while (!event_queue_.empty()) {
+            if (event_queue_.front().type == EventType::TaskWakeup) {
+                woken.push_back(event_queue_.front().task);
+            } else {
+                kept.push(std::move(event_queue_.front()));
+            }
+            event_queue_.pop();
+        }
+        event_queue_ = std::move(kept);
+        publish_queue();
+    }
+    tasks_.abandon(woken);
+    
+    // Notify status change
+    const auto callbacks = current_callbacks();
+    if (callbacks->on_status) {
+        callbacks->on_status(0, "Daemon stopped");
+    }
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::is_running() const {
+    LockGuard lock(mutex_);
+    return running_;
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::is_busy() const {
+    LockGuard lock(mutex_);
+    return busy_;
+}
+
+// =============================================================================
+// MARK: - Event Submission
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::enqueue_event(Event event) {
+    // Inbound data is policed, then decoded off the worker
+    if (event.type == EventType::DataReceived) {
+        const int64_t now = current_timestamp_ms();
+        if (!is_running()) {
+            return;
+        }
+        if (!admission_.admit(event.peer_id, event.data.size(), now) ||
+            !congestion_.on_inbound(event.peer_id, frame_hint(event.data.data(), event.data.size()), now,
+                                    !is_control_frame(event.data.data(), event.data.size()))) {
+            record_refused(event.peer_id, event.data.size());
+            return;
+        }
+        if (event.timestamp == 0) {
+            event.timestamp = now;
+        }
+        submit_admitted(InboundFrame{event.peer_id, std::move(event.data), event.timestamp});
+        return;
+    }
+    
+    post_event(std::move(event));
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::submit_inbound(uint64_t peer_id, const char* data, size_t len) {
+    const int64_t now = current_timestamp_ms();
+    if (!is_running()) {
+        return false;
+    }
+    if (!admission_.admit(peer_id, len, now) ||
+        !congestion_.on_inbound(peer_id, frame_hint(data, len), now, !is_control_frame(data, len))) {
+        record_refused(peer_id, len);
+        return false;
+    }
+    return submit_admitted(InboundFrame{peer_id, std::string(data, len), now});
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::submit_admitted(InboundFrame&& frame) {
+    const uint64_t peer_id = frame.peer_id;
+    const size_t size = frame.data.size();
+    if (!ingress_->submit(std::move(frame))) {
+        refuse_inbound(peer_id, size, false);
+        return false;
+    }
+    return true;
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::post_event(Event event) {
+    {
+        LockGuard lock(mutex_);
+        
+        if (!running_) {
+            return; // Don't accept events when stopped
+        }
+        
+        if (event.timestamp == 0) {
+            event.timestamp = current_timestamp_ms();
+        }
+        
+        event.queued_ns = Metrics::now_ns();
+        if (tracer_.enabled()) {
+            tracer_.instant(TraceCategory::Enqueue, daemon_detail::event_name(event.type), event.queued_ns,
+                            event.peer_id, event.data.size());
+        }
+        event_queue_.push(std::move(event));
+        congestion_.set_depth(event_queue_.size());
+        metrics_.set_queue_depth(event_queue_.size());
+        publish_queue();
+    }
+    
+    metrics_.add(Counter::EventsQueued);
+    cv_.notify_one();
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::post_wakeup(TaskWait* wait) {
+    {
+        LockGuard lock(mutex_);
+        
+        if (!running_) {
+            return false;
+        }
+        
+        Event event;
+        event.type = EventType::TaskWakeup;
+        event.task = wait;
+        event.queued_ns = Metrics::now_ns();
+        if (tracer_.enabled()) {
+            tracer_.instant(TraceCategory::Enqueue, "TaskWakeup", event.queued_ns);
+        }
+        event_queue_.push(std::move(event));
+        metrics_.set_queue_depth(event_queue_.size());
+        publish_queue();
+    }
+    
+    metrics_.add(Counter::EventsQueued);
+    cv_.notify_one();
+    return true;
+}
+
+// =============================================================================
+// MARK: - Transport
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_transport(Transport* t) {
+    LockGuard lock(mutex_);
+    transport_ = t;
+}
+
+// =============================================================================
+// MARK: - Persistence
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_message_store(MessageStore* store) {
+    LockGuard lock(mutex_);
+    store_ = store;
+}
+
+template <typename... Policies>
+MessageStore* BasicDaemon<Policies...>::message_store() const {
+    LockGuard lock(mutex_);
+    return store_;
+}
+
+// =============================================================================
+// MARK: - Attachments
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_chunk_store(ChunkStore* store) {
+    std::shared_ptr<AttachmentTransfer> transfer;
+    
+    if (store) {
+        // Frames are handled on the offload pool; completion is reported
+        // back on the worker thread like every other callback
+        transfer = std::make_shared<AttachmentTransfer>(
+            *store,
+            [this](uint64_t peer_id, const std::string& frame) {
+                send_to_peer(peer_id, frame);
+            },
+            [this](uint64_t peer_id, const ChunkHash& id, uint64_t size) {
+                Event event;
+                event.type = EventType::OffloadComplete;
+                event.peer_id = peer_id;
+                event.completion = [this, peer_id, id, size] {
+                    const auto callbacks = current_callbacks();
+                    if (callbacks->on_attachment) {
+                        ScopedSpan span(metrics_, Timing::Callback, tracer_, TraceCategory::Callback, "on_attachment", peer_id);
+                        callbacks->on_attachment(peer_id, id, size);
+                    }
+                };
+                post_event(std::move(event));
+            });
+    }
+    
+    LockGuard lock(mutex_);
+    attachments_ = std::move(transfer);
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::send_attachment(uint64_t peer_id, const ChunkHash& id) {
+    std::shared_ptr<AttachmentTransfer> transfer;
+    
+    {
+        LockGuard lock(mutex_);
+        transfer = attachments_;
+    }
+    
+    return transfer && transfer->offer(peer_id, id);
+}
+
+// =============================================================================
+// MARK: - Encryption
+// =============================================================================
+
+template <typename... Policies>
+SessionCache& BasicDaemon<Policies...>::sessions() {
+    return sessions_;
+}
+
+template <typename... Policies>
+FramePool& BasicDaemon<Policies...>::frame_pool() {
+    return frame_pool_;
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::start_handshake(uint64_t peer_id) {
+    if (!has_peer(peer_id)) {
+        return false;
+    }
+    
+    // Runs on the worker so early data cannot overtake the Resume frame
+    Event event;
+    event.type = EventType::StartHandshake;
+    event.peer_id = peer_id;
+    enqueue_event(std::move(event));
+    return true;
+}
+
+template <typename... Policies>
+HandshakeStats BasicDaemon<Policies...>::handshake_stats() const {
+    return handshake_.stats();
+}
+
+// =============================================================================
+// MARK: - Signatures
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_signing_key(const SigningKey& key) {
+    auto shared = std::make_shared<const SigningKey>(key);
+    
+    LockGuard lock(mutex_);
+    signing_key_ = std::move(shared);
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::enable_batch_verification(const VerifierConfig& config) {
+    LockGuard lock(mutex_);
+    
+    if (verifier_) {
+        return false;
+    }
+    
+    verifier_.reset(new SignatureVerifier(config,
+        [this](uint64_t peer_id, uint64_t ticket, std::string&& payload, const SignerKey& signer, bool valid) {
+            // The ingress kept the signed frame and posts it in the peer's
+            // order; the decode stage unwraps it again
+            const bool deliver = valid && signer_bound(uid_for(peer_id), signer, true);
+            if (!deliver) {
+                refuse_inbound(peer_id, payload.size(), true);
+            }
+            ingress_->finish(peer_id, ticket, deliver);
+        }));
+    return true;
+}
+
+template <typename... Policies>
+VerifierStats BasicDaemon<Policies...>::verification_stats() const {
+    LockGuard lock(mutex_);
+    return verifier_ ? verifier_->stats() : VerifierStats{0, 0, 0, 0, 0, 0};
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::send_chat(uint64_t peer_id, const std::string& data) {
+    std::shared_ptr<const SigningKey> key;
+    {
+        LockGuard lock(mutex_);
+        key = signing_key_;
+    }
+    
+    if (key) {
+        send_to_peer(peer_id, SignatureVerifier::sign_frame(*key, data));
+    } else {
+        send_to_peer(peer_id, data);
+    }
+}
+
+// =============================================================================
+// MARK: - Offload
+// =============================================================================
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::offload(uint64_t key, OffloadPool::Job job) {
+    if (!is_running()) {
+        return false;
+    }
+    
+    offload_->submit(key, std::move(job));
+    return true;
+}
+
+template <typename... Policies>
+OffloadStats BasicDaemon<Policies...>::offload_stats() const {
+    return offload_->stats();
+}
+
+template <typename... Policies>
+IngressStats BasicDaemon<Policies...>::ingress_stats() const {
+    return ingress_->stats();
+}
+
+// =============================================================================
+// MARK: - Policing
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_admission_config(const AdmissionConfig& config) {
+    admission_.set_config(config);
+}
+
+template <typename... Policies>
+AdmissionConfig BasicDaemon<Policies...>::admission_config() const {
+    return admission_.config();
+}
+
+template <typename... Policies>
+AdmissionStats BasicDaemon<Policies...>::admission_stats() const {
+    return admission_.stats(current_timestamp_ms());
+}
+
+// =============================================================================
+// MARK: - Backpressure
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_congestion_config(const CongestionConfig& config) {
+    congestion_.set_config(config);
+}
+
+template <typename... Policies>
+CongestionConfig BasicDaemon<Policies...>::congestion_config() const {
+    return congestion_.config();
+}
+
+template <typename... Policies>
+CongestionStats BasicDaemon<Policies...>::congestion_stats() const {
+    return congestion_.stats();
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::flush_congestion() {
+    if (congestion_.idle()) {
+        return false;
+    }
+    
+    const int64_t now = current_timestamp_ms();
+    
+    CongestionControl::Release due;
+    bool sent = congestion_.release(now, due);
+    for (const auto& frame : due) {
+        transmit(frame.first, frame.second, false);
+    }
+    
+    // Header only: the hint stamped on it is the whole message
+    for (uint64_t peer_id : congestion_.take_signals(now)) {
+        transmit(peer_id, make_frame(FrameType::Congestion, std::string()), false);
+        sent = true;
+    }
+    return sent;
+}
+
+// =============================================================================
+// MARK: - Scan Ingest
+// =============================================================================
+
+template <typename... Policies>
+size_t BasicDaemon<Policies...>::ingest_scans(const ScanReport* reports, size_t count) {
+    std::vector<DiscoveryChange> changes;
+    const size_t found = scans_.ingest(reports, count, changes);
+    if (found == 0) {
+        return 0;
+    }
+    
+    Event event;
+    event.type = EventType::OffloadComplete;
+    event.completion = [this, changes = std::move(changes)] {
+        links_.on_discovery(changes);
+        const auto callbacks = current_callbacks();
+        if (callbacks->on_discovery) {
+            ScopedSpan span(metrics_, Timing::Callback, tracer_, TraceCategory::Callback, "on_discovery");
+            callbacks->on_discovery(changes);
+        }
+        plan_links();
+        if (duty_.note_churn(daemon_detail::churn_in(changes), current_timestamp_ms())) {
+            plan_duty_cycle();
+        }
+    };
+    post_event(std::move(event));
+    return found;
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_scan_config(const ScanConfig& config) {
+    scans_.set_config(config);
+}
+
+template <typename... Policies>
+ScanConfig BasicDaemon<Policies...>::scan_config() const {
+    return scans_.config();
+}
+
+template <typename... Policies>
+ScanStats BasicDaemon<Policies...>::scan_stats() const {
+    return scans_.stats();
+}
+
+// =============================================================================
+// MARK: - Neighbour Selection
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::bind_link(const DeviceId& id, uint64_t peer_id) {
+    links_.bind(id, peer_id, current_timestamp_ms());
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_link_neighbours(const DeviceId& id, std::vector<DeviceId> neighbours) {
+    links_.set_neighbours(id, std::move(neighbours));
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_link_config(const LinkConfig& config) {
+    links_.set_config(config);
+}
+
+template <typename... Policies>
+LinkConfig BasicDaemon<Policies...>::link_config() const {
+    return links_.config();
+}
+
+template <typename... Policies>
+LinkStats BasicDaemon<Policies...>::link_stats() const {
+    return links_.stats();
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::plan_links() {
+    const std::vector<LinkRecommendation> recommendations = links_.plan(current_timestamp_ms());
+    const auto callbacks = current_callbacks();
+    if (!recommendations.empty() && callbacks->on_link) {
+        ScopedSpan span(metrics_, Timing::Callback, tracer_, TraceCategory::Callback, "on_link");
+        callbacks->on_link(recommendations);
+    }
+}
+
+// =============================================================================
+// MARK: - Duty Cycle
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_outbox_pending(size_t pending) {
+    if (!duty_.set_outbox(pending)) {
+        return;
+    }
+    
+    Event event;
+    event.type = EventType::OffloadComplete;
+    event.completion = [this] {
+        plan_duty_cycle();
+    };
+    post_event(std::move(event));
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_duty_cycle_config(const DutyCycleConfig& config) {
+    duty_.set_config(config);
+}
+
+template <typename... Policies>
+DutyCycleConfig BasicDaemon<Policies...>::duty_cycle_config() const {
+    return duty_.config();
+}
+
+template <typename... Policies>
+DutySchedule BasicDaemon<Policies...>::duty_schedule() const {
+    return duty_.schedule();
+}
+
+template <typename... Policies>
+DutyCycleStats BasicDaemon<Policies...>::duty_cycle_stats() const {
+    return duty_.stats();
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::plan_duty_cycle() {
+    DutySchedule schedule;
+    const auto callbacks = current_callbacks();
+    if (duty_.update(current_timestamp_ms(), schedule) && callbacks->on_duty_cycle) {
+        ScopedSpan span(metrics_, Timing::Callback, tracer_, TraceCategory::Callback, "on_duty_cycle");
+        callbacks->on_duty_cycle(schedule);
+    }
+}
+
+// =============================================================================
+// MARK: - Hibernation
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_hibernation(bool enabled) {
+    if (!hibernation_.set_active(enabled, std::chrono::steady_clock::now())) {
+        return;
+    }
+    
+    // The worker may be asleep until a far grid point; let it recompute
+    Event event;
+    event.type = EventType::OffloadComplete;
+    post_event(std::move(event));
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::hibernating() const {
+    return hibernation_.active();
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_hibernation_config(const HibernationConfig& config) {
+    hibernation_.set_config(config);
+}
+
+template <typename... Policies>
+HibernationConfig BasicDaemon<Policies...>::hibernation_config() const {
+    return hibernation_.config();
+}
+
+template <typename... Policies>
+HibernationStats BasicDaemon<Policies...>::hibernation_stats() const {
+    return hibernation_.stats(std::chrono::steady_clock::now());
+}
+
+// =============================================================================
+// MARK: - Metrics
+// =============================================================================
+
+template <typename... Policies>
+MetricsSnapshot BasicDaemon<Policies...>::metrics() const {
+    return metrics_.snapshot();
+}
+
+// =============================================================================
+// MARK: - Tracing
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_tracing(bool enabled) {
+    tracer_.set_enabled(enabled);
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::tracing() const {
+    return tracer_.enabled();
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::export_trace(std::ostream& out) const {
+    tracer_.export_json(out);
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::clear_trace() {
+    tracer_.clear();
+}
+
+template <typename... Policies>
+TraceStats BasicDaemon<Policies...>::trace_stats() const {
+    return tracer_.stats();
+}
+
+// =============================================================================
+// MARK: - Flight Recorder
+// =============================================================================
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::dump_flight_recorder(const std::string& path) {
+    return flight_.dump(path);
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::set_flight_dump_path(const std::string& path) {
+    return flight_.set_dump_path(path);
+}
+
+template <typename... Policies>
+FlightStats BasicDaemon<Policies...>::flight_stats() const {
+    return flight_.stats();
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::record_refused(uint64_t peer_id, size_t size) {
+    FlightRecord record{};
+    record.started_ns = Metrics::now_ns();
+    record.peer_id = peer_id;
+    record.size = uint32_t(size);
+    record.type = uint8_t(EventType::DataReceived);
+    record.outcome = FlightOutcome::Refused;
+    flight_.record(record);
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::record_batch(const std::vector<Event>& survivors, uint64_t handler_ns) {
+    // Stages only erase, so the events left are a subsequence of the batch
+    size_t next = 0;
+    for (FlightRecord& record : flight_batch_) {
+        if (next < survivors.size() && survivors[next].queued_ns == record.queued_ns &&
+            survivors[next].peer_id == record.peer_id) {
+            record.outcome = FlightOutcome::Completed;
+            next++;
+        }
+        record.duration_ns = handler_ns;
+        flight_.record(record);
+    }
+    flight_batch_.clear();
+}
+
+// =============================================================================
+// MARK: - Watchdog
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_watchdog_config(const WatchdogConfig& config) {
+    watchdog_.set_config(config);
+}
+
+template <typename... Policies>
+WatchdogConfig BasicDaemon<Policies...>::watchdog_config() const {
+    return watchdog_.config();
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_stall_callback(std::function<void(const StallReport&)> callback) {
+    std::lock_guard<std::mutex> lock(stall_mutex_);
+    stall_callback_ = std::move(callback);
+}
+
+template <typename... Policies>
+WatchdogStats BasicDaemon<Policies...>::watchdog_stats() const {
+    return watchdog_.stats();
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::on_stall(const StallReport& report) {
+    // The stalled work's record (size holds the queue depth), then the
+    // whole recorder to the armed path while the worker is still stuck
+    FlightRecord record{};
+    record.started_ns = report.started_ns;
+    record.duration_ns = report.running_ns;
+    record.peer_id = report.peer_id;
+    record.size = uint32_t(std::min<uint64_t>(report.queue_depth, std::numeric_limits<uint32_t>::max()));
+    record.type = report.event_type;
+    record.outcome = FlightOutcome::Stalled;
+    flight_.record(record);
+    flight_.trip(FlightDumpReason::Watchdog);
+    
+    log(LogLevel::Warn, literal("[Daemon] Worker stalled ("),
+        report.kind == StallKind::Handler ? "handler" : "queue", literal("): "), report.phase,
+        literal(" stage '"), report.stage, literal("' running "), report.running_ns / 1000000, literal(" ms, "),
+        report.queue_depth, literal(" queued, oldest "), report.oldest_queued_ns / 1000000, literal(" ms"));
+    
+    std::function<void(const StallReport&)> callback;
+    {
+        std::lock_guard<std::mutex> lock(stall_mutex_);
+        callback = stall_callback_;
+    }
+    if (callback) {
+        callback(report);
+    }
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::publish_queue() {
+    watchdog_.set_queue(event_queue_.size(), event_queue_.empty() ? 0 : event_queue_.front().queued_ns);
+}
+
+// =============================================================================
+// MARK: - Tasks
+// =============================================================================
+
+template <typename... Policies>
+TaskScheduler& BasicDaemon<Policies...>::tasks() {
+    return tasks_;
+}
+
+template <typename... Policies>
+TaskStats BasicDaemon<Policies...>::task_stats() const {
+    return tasks_.stats();
+}
+
+// =============================================================================
+// MARK: - Admission
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_contact_directory(ContactDirectory* directory) {
+    LockGuard lock(mutex_);
+    contacts_ = directory;
+}
+
+template <typename... Policies>
+uint64_t BasicDaemon<Policies...>::refused_count() const {
+    return refused_.load(std::memory_order_relaxed);
+}
+
+// =============================================================================
+// MARK: - Callbacks
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::set_callbacks(const DaemonCallbacks& callbacks) {
+    std::atomic_store(&callbacks_, std::make_shared<const DaemonCallbacks>(callbacks));
+}
+
+template <typename... Policies>
+std::shared_ptr<const DaemonCallbacks> BasicDaemon<Policies...>::current_callbacks() const {
+    return std::atomic_load(&callbacks_);
+}
+
+// =============================================================================
+// MARK: - Peer Management
+// =============================================================================
+
+template <typename... Policies>
+uint32_t BasicDaemon<Policies...>::get_peer_count() const {
+    LockGuard lock(peers_mutex_);
+    return static_cast<uint32_t>(peers_.size());
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::add_peer(uint64_t peer_id, const std::string& uid) {
+    LockGuard lock(peers_mutex_);
+    
+    PeerInfo info;
+    info.peer_id = peer_id;
+    info.uid = uid;
+    info.connected = true;
+    info.connected_at = current_timestamp_ms();
+    
+    peers_[peer_id] = info;
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::remove_peer(uint64_t peer_id) {
+    LockGuard lock(peers_mutex_);
+    peers_.erase(peer_id);
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::has_peer(uint64_t peer_id) const {
+    LockGuard lock(peers_mutex_);
+    return peers_.find(peer_id) != peers_.end();
+}
+
+template <typename... Policies>
+ConversationTable& BasicDaemon<Policies...>::conversations() {
+    return conversations_;
+}
+
+template <typename... Policies>
+std::vector<KnownPeer> BasicDaemon<Policies...>::known_peers() const {
+    LockGuard lock(peers_mutex_);
+    
+    std::vector<KnownPeer> out;
+    out.reserve(known_peers_.size());
+    for (const auto& pair : known_peers_) {
+        out.push_back(pair.second);
+    }
+    return out;
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::restore_known_peers(const std::vector<KnownPeer>& peers) {
+    LockGuard lock(peers_mutex_);
+    
+    for (const auto& peer : peers) {
+        KnownPeer& known = known_peers_[peer.uid];
+        
+        // Never move sequence numbers backwards
+        if (peer.last_seen >= known.last_seen) {
+            known.last_peer_id = peer.last_peer_id;
+            known.last_seen = peer.last_seen;
+        }
+        known.uid = peer.uid;
+        known.tx_seq = std::max(known.tx_seq, peer.tx_seq);
+        known.rx_seq = std::max(known.rx_seq, peer.rx_seq);
+    }
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::note_peer_activity(uint64_t peer_id, const std::string& uid, PeerActivity activity) {
+    const int64_t now = current_timestamp_ms();
+    if (activity != PeerActivity::Connected) {
+        links_.note_activity(peer_id, now);
+    }
+    
+    // Traffic and new neighbours wake a backed-off radio
+    const bool replan = activity == PeerActivity::Connected ? duty_.note_churn(1, now) : duty_.note_traffic(now);
+    if (replan) {
+        plan_duty_cycle();
+    }
+    
+    LockGuard lock(peers_mutex_);
+    
+    std::string key = uid;
+    if (key.empty()) {
+        auto it = peers_.find(peer_id);
+        if (it == peers_.end() || it->second.uid.empty()) {
+            return; // Anonymous peers are not remembered
+        }
+        key = it->second.uid;
+    }
+    
+    KnownPeer& known = known_peers_[key];
+    known.uid = key;
+    known.last_peer_id = peer_id;
+    known.last_seen = current_timestamp_ms();
+    
+    if (activity == PeerActivity::Received) {
+        known.rx_seq++;
+    } else if (activity == PeerActivity::Sent) {
+        known.tx_seq++;
+    }
+}
+
+// =============================================================================
+// MARK: - Direct Send
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::send_to_peer(uint64_t peer_id, const std::string& data) {
+    transmit(peer_id, data, true);
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::transmit(uint64_t peer_id, const std::string& data, bool paced) {
+    Transport* t = nullptr;
+    
+    {
+        LockGuard lock(mutex_);
+        t = transport_;
+    }
+    
+    if (!t) {
+        return;
+    }
+    
+    // Held as plaintext and sealed on release, so session counters go
+    // out in order however long the frame waits
+    if (paced && !congestion_.pace(peer_id, current_timestamp_ms())) {
+        if (congestion_.hold(peer_id, std::string(data), current_timestamp_ms()) ==
+            CongestionControl::Pacing::Wake) {
+            // The worker may be asleep until its next maintenance slice
+            Event event;
+            event.type = EventType::OffloadComplete;
+            event.peer_id = peer_id;
+            post_event(std::move(event));
+        }
+        return;
+    }
+    
+    // Held while a handshake is in flight; flushed once keys are installed
+    if (handshake_.intercept(peer_id, data)) {
+        return;
+    }
+    
+    // A peer whose session was evicted still has its end of it and would
+    // refuse plaintext: re-key instead, holding the data meanwhile
+    if (!sessions_.has(peer_id) && sessions_.expects(peer_id)) {
+        log(LogLevel::Info, literal("[Daemon] Session lost, re-keying: "), peer_id);
+        handshake_.connect(peer_id, uid_for(peer_id));
+        if (handshake_.intercept(peer_id, data)) {
+            return;
+        }
+    }
+    
+    // Sealed into a pooled buffer: the plaintext is copied exactly once.
+    // If the session is gone by now the data is dropped, never sent plain
+    if (sessions_.has(peer_id) || sessions_.expects(peer_id)) {
+        std::string frame = frame_pool_.acquire(data.size() + kSealedOverhead);
+        if (sessions_.seal(peer_id, data.data(), data.size(), frame)) {
+            set_frame_hint(frame, congestion_.local_hint());
+            send_frame(t, peer_id, frame);
+        }
+        frame_pool_.release(std::move(frame));
+        return;
+    }
+    
+    emit(t, peer_id, data);
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::emit(Transport* t, uint64_t peer_id, const std::string& data) {
+    // Plain-text chat has no header to carry the hint
+    const uint8_t hint = congestion_.local_hint();
+    if (hint == 0 || !is_frame(data)) {
+        send_frame(t, peer_id, data);
+        return;
+    }
+    
+    std::string frame = frame_pool_.acquire(data.size());
+    frame.assign(data);
+    set_frame_hint(frame, hint);
+    send_frame(t, peer_id, frame);
+    frame_pool_.release(std::move(frame));
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::send_frame(Transport* t, uint64_t peer_id, const std::string& frame) {
+    {
+        ScopedSpan span(metrics_, Timing::TransportSend, tracer_, TraceCategory::Send, "send", peer_id, frame.size());
+        t->send(peer_id, frame);
+    }
+    metrics_.add(Counter::FramesSent);
+    metrics_.add(Counter::BytesSent, frame.size());
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::send_unsealed(uint64_t peer_id, const std::string& frame) {
+    Transport* t = nullptr;
+    
+    {
+        LockGuard lock(mutex_);
+        t = transport_;
+    }
+    
+    if (t) {
+        emit(t, peer_id, frame);
+    }
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::send_to_uid(const std::string& uid, const std::string& data) {
+    uint64_t peer_id = 0;
+    
+    {
+        LockGuard lock(peers_mutex_);
+        
+        for (const auto& pair : peers_) {
+            if (pair.second.uid == uid) {
+                peer_id = pair.first;
+                break;
+            }
+        }
+    }
+    
+    if (peer_id != 0) {
+        // Queued like any send, so it keeps its place behind earlier ones
+        // and its stages (and callbacks) run on the worker
+        Event event;
+        event.type = EventType::SendMessage;
+        event.peer_id = peer_id;
+        event.peer_uid = uid;
+        event.data = data;
+        event.timestamp = current_timestamp_ms();
+        post_event(std::move(event));
+    }
+}
+
+// =============================================================================
+// MARK: - Worker Thread
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::worker_loop() {
+    tracer_.name_thread("worker");
+    
+    UniqueLock lock(mutex_);
+    auto maintenance_interval = daemon_detail::kMaintenanceIdle;
+    
+    while (running_) {
+        // Wait for work, shutdown, the next task timer, the next paced
+        // frame, or the next maintenance slice (timers are only added on
+        // this thread; frames held elsewhere post an event)
+        const auto steady_now = std::chrono::steady_clock::now();
+        auto wake_at = std::min(steady_now + maintenance_interval, tasks_.next_deadline());
+        
+        // Hibernating: timers and maintenance share one wakeup per slack
+        // interval; paced frames below keep their exact times
+        if (hibernation_.active()) {
+            wake_at = hibernation_.coalesce(wake_at, steady_now);
+        }
+        if (congestion_.has_held()) {
+            const int64_t now_ms = current_timestamp_ms();
+            const int64_t release_at = congestion_.next_release_ms(now_ms);
+            if (release_at != std::numeric_limits<int64_t>::max()) {
+                wake_at = std::min(wake_at, steady_now + std::chrono::milliseconds(release_at - now_ms));
+            }
+        }
+        const bool sleeping = event_queue_.empty();
+        bool has_work = cv_.wait_until(lock, wake_at, [this] {
+            return !event_queue_.empty() || !running_;
+        });
+        
+        if (!running_) {
+            break;
+        }
+        if (sleeping) {
+            hibernation_.note_wakeup(std::chrono::steady_clock::now(), has_work);
+        }
+        
+        // Task timers that came due; a timer wakeup is not idle time
+        bool timed_work = false;
+        if (tasks_.has_timers() && tasks_.next_deadline() <= std::chrono::steady_clock::now()) {
+            busy_ = true;
+            lock.unlock();
+            
+            watchdog_.begin("timers", FlightRecorder::kNoEvent, 0, Metrics::now_ns());
+            tasks_.fire_timers(std::chrono::steady_clock::now());
+            tasks_.run_ready();
+            watchdog_.end(Metrics::now_ns());
+            
+            lock.lock();
+            busy_ = false;
+            timed_work = true;
+        }
+        
+        // Paced frames that came due count as work too
+        if (congestion_.has_held() && congestion_.next_release_ms(current_timestamp_ms()) <= current_timestamp_ms()) {
+            busy_ = true;
+            lock.unlock();
+            
+            watchdog_.begin("pacing", FlightRecorder::kNoEvent, 0, Metrics::now_ns());
+            timed_work = flush_congestion() || timed_work;
+            watchdog_.end(Metrics::now_ns());
+            
+            lock.lock();
+            busy_ = false;
+        }
+        
+        // Maintenance runs when idle, and at least once per idle interval
+        // under sustained load so storage cannot grow without bound
+        if ((!has_work && !timed_work) ||
+            std::chrono::steady_clock::now() - last_maintenance_ >= daemon_detail::kMaintenanceIdle) {
+            busy_ = true;
+            lock.unlock();
+            
+            watchdog_.begin("maintenance", FlightRecorder::kNoEvent, 0, Metrics::now_ns());
+            bool pending = run_maintenance();
+            if (conversations_.has_changes()) {
+                flush_conversation_changes();
+            }
+            watchdog_.end(Metrics::now_ns());
+            
+            lock.lock();
+            busy_ = false;
+            last_maintenance_ = std::chrono::steady_clock::now();
+            maintenance_interval = pending ? daemon_detail::kMaintenancePending : daemon_detail::kMaintenanceIdle;
+            continue;
+        }
+        
+        if (event_queue_.empty()) {
+            continue;
+        }
+        
+        if (event_queue_.front().type == EventType::Shutdown) {
+            event_queue_.pop();
+            running_ = false;
+            continue;
+        }
+        
+        // Task wakeups resume their coroutine directly, outside the pipelines
+        if (event_queue_.front().type == EventType::TaskWakeup) {
+            TaskWait* wait = event_queue_.front().task;
+            const uint64_t queued_ns = event_queue_.front().queued_ns;
+            event_queue_.pop();
+            metrics_.set_queue_depth(event_queue_.size());
+            publish_queue();
+            busy_ = true;
+            lock.unlock();
+            
+            const uint64_t start_ns = Metrics::now_ns();
+            const bool traced = tracer_.enabled();
+            watchdog_.begin("task", uint8_t(EventType::TaskWakeup), 0, start_ns);
+            metrics_.add(Counter::EventsDispatched);
+            metrics_.record(Timing::QueueWait, start_ns - queued_ns);
+            if (traced) {
+                tracer_.instant(TraceCategory::Dequeue, "TaskWakeup", start_ns, 0, start_ns - queued_ns);
+            }
+            
+            wait->resume();
+            tasks_.run_ready();
+            const uint64_t handler_ns = Metrics::now_ns() - start_ns;
+            watchdog_.end(start_ns + handler_ns);
+            metrics_.record(Timing::Handler, handler_ns);
+            flight_.record(FlightRecord{queued_ns, start_ns, handler_ns, 0, 0, uint8_t(EventType::TaskWakeup),
+                                        FlightOutcome::Resumed});
+            if (traced) {
+                tracer_.span(TraceCategory::Batch, "task", start_ns, handler_ns, 0, 1);
+            }
+            
+            lock.lock();
+            busy_ = false;
+            continue;
+        }
+        
+        // Take a batch: consecutive events of one lane
+        std::vector<Event> batch;
+        const daemon_detail::Lane lane = daemon_detail::lane_of(event_queue_.front().type);
+        do {
+            batch.push_back(std::move(event_queue_.front()));
+            event_queue_.pop();
+        } while (lane != daemon_detail::Lane::Control && batch.size() < daemon_detail::kMaxBatch && !event_queue_.empty() &&
+                 daemon_detail::lane_of(event_queue_.front().type) == lane);
+        congestion_.set_depth(event_queue_.size());
+        metrics_.set_queue_depth(event_queue_.size());
+        publish_queue();
+        
+        busy_ = true;
+        lock.unlock();
+        
+        const uint64_t start_ns = Metrics::now_ns();
+        const bool traced = tracer_.enabled();
+        const char* phase = lane == daemon_detail::Lane::Outbound ? "outbound" : "inbound";
+        watchdog_.begin(phase, uint8_t(batch.front().type), batch.front().peer_id, start_ns);
+        metrics_.add(Counter::EventsDispatched, batch.size());
+        metrics_.add(Counter::Batches);
+        for (const auto& event : batch) {
+            metrics_.record(Timing::QueueWait, start_ns - event.queued_ns);
+            flight_batch_.push_back(FlightRecord{event.queued_ns, start_ns, 0, event.peer_id,
+                                                 uint32_t(event.data.size()), uint8_t(event.type),
+                                                 FlightOutcome::Stopped});
+            if (traced) {
+                tracer_.instant(TraceCategory::Dequeue, daemon_detail::event_name(event.type), start_ns,
+                                event.peer_id, start_ns - event.queued_ns);
+            }
+        }
+        const size_t batch_size = batch.size();
+        
+        // Barrier frames resume their peer's ingress only after the whole
+        // batch, once any keys they install are in place
+        std::vector<OffloadPool::Continuation> resumes;
+        for (auto& event : batch) {
+            if (event.type == EventType::DataReceived && event.completion) {
+                resumes.push_back(std::move(event.completion));
+            }
+        }
+        
+        // Process the batch (outside the lock)
+        (lane == daemon_detail::Lane::Outbound ? outbound_ : inbound_).run(batch, traced ? &tracer_ : nullptr,
+                                                                          &watchdog_);
+        watchdog_.enter_stage(std::string());
+        const uint64_t handler_ns = Metrics::now_ns() - start_ns;
+        metrics_.record(Timing::Handler, handler_ns);
+        record_batch(batch, handler_ns);
+        if (traced) {
+            tracer_.span(TraceCategory::Batch, phase, start_ns, handler_ns, 0, batch_size);
+        }
+        
+        for (auto& event : batch) {
+            frame_pool_.release(std::move(event.data));
+        }
+        for (auto& resume : resumes) {
+            resume();
+        }
+        
+        // Tasks whose frames (acks, channel data) arrived in this batch
+        tasks_.run_ready();
+        
+        // Frames this batch released, and hints the queue depth now calls for
+        flush_congestion();
+        
+        // Coalesce summary updates for everything processed in this burst
+        if (conversations_.has_changes()) {
+            lock.lock();
+            bool drained = event_queue_.empty();
+            lock.unlock();
+            if (drained) {
+                flush_conversation_changes();
+            }
+        }
+        watchdog_.end(Metrics::now_ns());
+        
+        lock.lock();
+        busy_ = false;
+    }
+}
+
+// =============================================================================
+// MARK: - Pipelines
+// =============================================================================
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::add_stage(Direction direction, std::unique_ptr<Stage> stage, const std::string& before) {
+    return pipeline(direction).add(std::move(stage), before);
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::remove_stage(Direction direction, const std::string& name) {
+    return pipeline(direction).remove(name);
+}
+
+template <typename... Policies>
+std::vector<std::string> BasicDaemon<Policies...>::stage_names(Direction direction) const {
+    return pipeline(direction).stage_names();
+}
+
+template <typename... Policies>
+std::vector<StageStats> BasicDaemon<Policies...>::stage_stats(Direction direction) const {
+    return pipeline(direction).stats();
+}
+
+template <typename... Policies>
+Pipeline<DaemonEvent>& BasicDaemon<Policies...>::pipeline(Direction direction) {
+    return direction == Direction::Inbound ? inbound_ : outbound_;
+}
+
+template <typename... Policies>
+const Pipeline<DaemonEvent>& BasicDaemon<Policies...>::pipeline(Direction direction) const {
+    return direction == Direction::Inbound ? inbound_ : outbound_;
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::install_default_stages() {
+    // Inbound: lifecycle events, then chat messages from decode to the UI
+    inbound_.add(make_stage<Event>("control", [this](Event& event) {
+        switch (event.type) {
+            case EventType::PeerConnected:
+                handle_peer_connected(event);
+                return false;
+            case EventType::PeerDisconnected:
+                handle_peer_disconnected(event);
+                return false;
+            case EventType::StartHandshake:
+                handle_start_handshake(event);
+                return false;
+            case EventType::ConversationRead:
+                handle_conversation_read(event);
+                return false;
+            case EventType::OffloadComplete:
+                if (event.completion) {
+                    event.completion();
+                }
+                return false;
+            default:
+                return true;
+        }
+    }));
+    
+    inbound_.add(make_stage<Event>("decode", [this](Event& event) {
+        // Barrier frames arrive undecoded (see decode_inbound)
+        if (event.type == EventType::DataReceived &&
+            open_inbound(event.peer_id, uid_for(event.peer_id), event.data, 0) != Ingress::Verdict::Deliver) {
+            return false;
+        }
+        
+        // Signed frames keep their envelope until here, whether verified
+        // inline or by the pool
+        if (is_frame(event.data) && frame_header(event.data).type == FrameType::Signed) {
+            SignerKey signer;
+            SignatureVerifier::unwrap(event.data, signer);
+            event.signer.assign(signer.begin(), signer.end());
+        }
+        event.type = EventType::DataDecoded;
+        if (event.peer_uid.empty()) {
+            event.peer_uid = uid_for(event.peer_id);
+        }
+        return true;
+    }));
+    
+    // Protocol frames never reach the chat history
+    inbound_.add(make_stage<Event>("frames", [this](Event& event) {
+        if (!is_frame(event.data)) {
+            return true;
+        }
+        handle_frame(event);
+        return false;
+    }));
+    
+    inbound_.add(make_stage<Event>("peers", [this](Event& event) {
+        log(LogLevel::Debug, literal("[Daemon] Data received from peer "), event.peer_id, literal(": "), sensitive(event.data));
+        note_peer_activity(event.peer_id, event.peer_uid, PeerActivity::Received);
+        return true;
+    }));
+    
+    // Persist before notifying so history is never behind the UI
+    inbound_.add(std::unique_ptr<Stage>(new FunctionStage<Event>("store", [this](std::vector<Event>& batch) {
+        persist_messages(batch, false);
+    })));
+    
+    inbound_.add(make_stage<Event>("conversations", [this](Event& event) {
+        conversations_.on_message(conversation_for(event.peer_id, event.peer_uid), false,
+                                  event.timestamp, event.data);
+        return true;
+    }));
+    
+    inbound_.add(make_stage<Event>("ui", [this](Event& event) {
+        const auto callbacks = current_callbacks();
+        if (!event.signer.empty() && callbacks->on_signed_message) {
+            ScopedSpan span(metrics_, Timing::Callback, tracer_, TraceCategory::Callback, "on_message", event.peer_id);
+            SignerKey signer;
+            std::copy(event.signer.begin(), event.signer.end(), signer.begin());
+            callbacks->on_signed_message(event.peer_id, event.peer_uid, event.data, event.timestamp, signer);
+        } else if (callbacks->on_message) {
+            ScopedSpan span(metrics_, Timing::Callback, tracer_, TraceCategory::Callback, "on_message", event.peer_id);
+            callbacks->on_message(event.peer_id, event.peer_uid, event.data, event.timestamp);
+        }
+        metrics_.add(Counter::MessagesDelivered);
+        return true;
+    }));
+    
+    // Outbound: chat messages sent, then recorded
+    outbound_.add(make_stage<Event>("send", [this](Event& event) {
+        log(LogLevel::Debug, literal("[Daemon] Sending message to peer "), event.peer_id, literal(": "), sensitive(event.data));
+        send_chat(event.peer_id, event.data);
+        note_peer_activity(event.peer_id, event.peer_uid, PeerActivity::Sent);
+        return true;
+    }));
+    
+    outbound_.add(std::unique_ptr<Stage>(new FunctionStage<Event>("store", [this](std::vector<Event>& batch) {
+        persist_messages(batch, true);
+    })));
+    
+    outbound_.add(make_stage<Event>("conversations", [this](Event& event) {
+        conversations_.on_message(conversation_for(event.peer_id, event.peer_uid), true,
+                                  event.timestamp, event.data);
+        return true;
+    }));
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::persist_messages(const std::vector<Event>& batch, bool outbound) {
+    MessageStore* store = message_store();
+    if (!store) {
+        return;
+    }
+    
+    const MessageDirection direction = outbound ? MessageDirection::Outbound : MessageDirection::Inbound;
+    if (batch.size() == 1) {
+        const Event& event = batch[0];
+        store->append(conversation_for(event.peer_id, event.peer_uid), direction, event.timestamp, event.data);
+        return;
+    }
+    
+    std::vector<StoredMessage> messages(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        messages[i].conversation = conversation_for(batch[i].peer_id, batch[i].peer_uid);
+        messages[i].direction = direction;
+        messages[i].timestamp = batch[i].timestamp;
+        messages[i].expires_at = 0;
+        messages[i].body = batch[i].data;
+    }
+    store->import_messages(messages);
+}
+
+// =============================================================================
+// MARK: - Event Handlers
+// =============================================================================
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::handle_peer_connected(const Event& event) {
+    log(LogLevel::Info, literal("[Daemon] Peer connected: "), event.peer_id, literal(" (uid: "), event.peer_uid, literal(")"));
+    
+    // Add to peer list; its session is kept while it stays connected
+    add_peer(event.peer_id, event.peer_uid);
+    sessions_.set_connected(event.peer_id, true);
+    note_peer_activity(event.peer_id, event.peer_uid, PeerActivity::Connected);
+    
+    // Notify via callback
+    const auto callbacks = current_callbacks();
+    if (callbacks->on_peer) {
+        ScopedSpan span(metrics_, Timing::Callback, tracer_, TraceCategory::Callback, "on_peer", event.peer_id);
+        callbacks->on_peer(event.peer_id, event.peer_uid, true);
+    }
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::handle_peer_disconnected(const Event& event) {
+    log(LogLevel::Info, literal("[Daemon] Peer disconnected: "), event.peer_id);
+    
+    // Get UID before removing
+    std::string uid;
+    {
+        LockGuard lock(peers_mutex_);
+        auto it = peers_.find(event.peer_id);
+        if (it != peers_.end()) {
+            uid = it->second.uid;
+        }
+    }
+    
+    // Remove from peer list; a session set up by the handshake ends here
+    remove_peer(event.peer_id);
+    sessions_.set_connected(event.peer_id, false);
+    handshake_.on_disconnect(event.peer_id);
+    tasks_.on_peer_disconnected(event.peer_id);
+    congestion_.forget(event.peer_id);
+    links_.unbind(event.peer_id);
+    if (duty_.note_churn(1, current_timestamp_ms())) {
+        plan_duty_cycle();
+    }
+    
+    // Notify via callback
+    const auto callbacks = current_callbacks();
+    if (callbacks->on_peer) {
+        ScopedSpan span(metrics_, Timing::Callback, tracer_, TraceCategory::Callback, "on_peer", event.peer_id);
+        callbacks->on_peer(event.peer_id, uid, false);
+    }
+    
+    // A slot has come free
+    plan_links();
+}
+
+template <typename... Policies>
+Ingress::Verdict BasicDaemon<Policies...>::decode_inbound(uint64_t peer_id, std::string& data, uint64_t ticket) {
+    ContactDirectory* contacts = nullptr;
+    {
+        LockGuard lock(mutex_);
+        contacts = contacts_;
+    }
+    
+    // Handshake frames install the keys the next frame is opened with,
+    // and admission needs the UID a queued PeerConnected has yet to add
+    const std::string uid = uid_for(peer_id);
+    if (Handshake::is_handshake_frame(data) || (contacts && uid.empty())) {
+        return Ingress::Verdict::Barrier;
+    }
+    
+    return open_inbound(peer_id, uid, data, ticket);
+}
+
+template <typename... Policies>
+Ingress::Verdict BasicDaemon<Policies...>::open_inbound(uint64_t peer_id, const std::string& uid, std::string& data,
+                                                       uint64_t ticket) {
+    // Blocked (or, in allowlist mode, unknown) senders are dropped first
+    ContactDirectory* contacts = nullptr;
+    {
+        LockGuard lock(mutex_);
+        contacts = contacts_;
+    }
+    if (contacts && !contacts->admits(uid)) {
+        refuse_inbound(peer_id, data.size(), true);
+        return Ingress::Verdict::Drop;
+    }
+    
+    // Decrypt in place; once a peer has a session, plaintext other than
+    // handshake frames (which set up or replace the session) is refused
+    const bool sealed = is_frame(data) && frame_header(data).type == FrameType::Sealed;
+    if (sealed ? !sessions_.open(peer_id, data)
+               : sessions_.has(peer_id) && !Handshake::is_handshake_frame(data)) {
+        refuse_inbound(peer_id, data.size(), true);
+        return Ingress::Verdict::Drop;
+    }
+    
+    // Signed frames must carry the key bound to the sender. The batch
+    // verifier gets a copy and the ingress holds the frame in the peer's
+    // order until it is finished; frames decoded on the worker (and all
+    // of them without a pool) are verified here. Either way the decode
+    // stage unwraps them
+    if (is_frame(data) && frame_header(data).type == FrameType::Signed) {
+        SignerKey signer;
+        if (!SignatureVerifier::signer_of(data, signer) || !signer_bound(uid, signer, false)) {
+            refuse_inbound(peer_id, data.size(), true);
+            return Ingress::Verdict::Drop;
+        }
+        
+        SignatureVerifier* verifier = nullptr;
+        if (ticket != 0) {
+            LockGuard lock(mutex_);
+            verifier = verifier_.get();
+        }
+        if (verifier) {
+            if (!verifier->submit(peer_id, ticket, std::string(data))) {
+                refuse_inbound(peer_id, data.size(), false);
+                return Ingress::Verdict::Drop;
+            }
+            return Ingress::Verdict::Consumed;
+        }
+        if (!SignatureVerifier::verify_frame(data) || !signer_bound(uid, signer, true)) {
+            refuse_inbound(peer_id, data.size(), true);
+            return Ingress::Verdict::Drop;
+        }
+    }
+    
+    return Ingress::Verdict::Deliver;
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::refuse_inbound(uint64_t peer_id, size_t size, bool bad) {
+    refused_.fetch_add(1, std::memory_order_relaxed);
+    record_refused(peer_id, size);
+    if (bad) {
+        admission_.penalize(peer_id, AdmissionControl::kBadFramePenalty, current_timestamp_ms());
+    }
+}
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::signer_bound(const std::string& uid, const SignerKey& key, bool verified) {
+    // Nothing to bind a key to
+    if (uid.empty()) {
+        return false;
+    }
+    
+    ContactDirectory* contacts = nullptr;
+    {
+        LockGuard lock(mutex_);
+        contacts = contacts_;
+    }
+    ContactKey listed;
+    if (contacts && contacts->signing_key(uid, listed)) {
+        return listed == key;
+    }
+    
+    // Trust on first use: only a key that verified is pinned
+    LockGuard lock(mutex_);
+    auto it = signer_pins_.find(uid);
+    if (it != signer_pins_.end()) {
+        return it->second == key;
+    }
+    if (!verified) {
+        return true;
+    }
+    if (signer_pins_.size() >= daemon_detail::kMaxSignerPins) {
+        return false;
+    }
+    signer_pins_.emplace(uid, key);
+    return true;
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::handle_conversation_read(const Event& event) {
+    conversations_.mark_read(event.peer_uid);
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::handle_start_handshake(const Event& event) {
+    handshake_.connect(event.peer_id, uid_for(event.peer_id));
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::handle_frame(Event& event) {
+    const FrameHeader header = frame_header(event.data);
+    
+    switch (header.type) {
+        case FrameType::ChunkOffer:
+        case FrameType::ChunkRequest:
+        case FrameType::ChunkData: {
+            std::shared_ptr<AttachmentTransfer> transfer;
+            {
+                LockGuard lock(mutex_);
+                transfer = attachments_;
+            }
+            if (!transfer) {
+                break;
+            }
+            
+            // Chunk store reads/writes and hashing block; ordered per
+            // peer so a request never overtakes the offer it answers.
+            // Never waits for room: a full pool refuses the frame rather
+            // than stall the worker, and a re-offer moves what is missing
+            auto frame = std::make_shared<std::string>(std::move(event.data));
+            const uint64_t peer_id = event.peer_id;
+            const bool accepted = offload_->try_submit(peer_id,
+                [transfer, frame, peer_id, header]() -> OffloadPool::Continuation {
+                    transfer->on_frame(peer_id, header,
+                                       frame->data() + kFrameHeaderBytes,
+                                       frame->size() - kFrameHeaderBytes);
+                    return nullptr;
+                });
+            if (!accepted) {
+                refuse_inbound(peer_id, frame->size(), false);
+            }
+            break;
+        }
+            
+        case FrameType::Hello:
+        case FrameType::HelloReply:
+        case FrameType::Resume:
+        case FrameType::ResumeAck:
+        case FrameType::ResumeReject:
+            handshake_.on_frame(event.peer_id, uid_for(event.peer_id), header,
+                                event.data.data() + kFrameHeaderBytes,
+                                event.data.size() - kFrameHeaderBytes);
+            break;
+            
+        case FrameType::TaskData:
+        case FrameType::TaskAck:
+            tasks_.on_frame(event.peer_id, header,
+                            event.data.data() + kFrameHeaderBytes,
+                            event.data.size() - kFrameHeaderBytes);
+            break;
+            
+        case FrameType::Congestion:
+            break; // Its hint was read at ingest
+            
+        default:
+            break; // Unknown frame types are ignored for forward compatibility
+    }
+}
+
+template <typename... Policies>
+void BasicDaemon<Policies...>::flush_conversation_changes() {
+    std::vector<ConversationSummary> changed = conversations_.take_changes();
+    
+    const auto callbacks = current_callbacks();
+    if (!changed.empty() && callbacks->on_conversations) {
+        ScopedSpan span(metrics_, Timing::Callback, tracer_, TraceCategory::Callback, "on_conversations");
+        callbacks->on_conversations(changed);
+    }
+}
+
+// =============================================================================
+// MARK: - Maintenance
+// =============================================================================
+
+template <typename... Policies>
+bool BasicDaemon<Policies...>::run_maintenance() {
+    admission_.sweep(current_timestamp_ms());
+    congestion_.sweep(current_timestamp_ms());
+    
+    // Already on the worker thread
+    std::vector<DiscoveryChange> lost;
+    if (scans_.expire(current_timestamp_ms(), lost) != 0) {
+        links_.on_discovery(lost);
+        const auto callbacks = current_callbacks();
+        if (callbacks->on_discovery) {
+            ScopedSpan span(metrics_, Timing::Callback, tracer_, TraceCategory::Callback, "on_discovery");
+            callbacks->on_discovery(lost);
+        }
+        duty_.note_churn(lost.size(), current_timestamp_ms());
+    }
+    plan_links();
+    plan_duty_cycle();
+    
+    MessageStore* store = message_store();
+    
+    if (!store) {
+        return false;
+    }
+    
+    // Compaction is optional work: put off while hibernating
+    if (!hibernation_.optional_due(std::chrono::steady_clock::now())) {
+        return false;
+    }
+    
+    const bool pending = store->compact_step(daemon_detail::kMaintenanceSlice, current_timestamp_ms());
+    if (!pending) {
+        hibernation_.optional_done(std::chrono::steady_clock::now());
+    }
+    return pending;
+}
+
+// =============================================================================
+// MARK: - Utilities
+// =============================================================================
+
+template <typename... Policies>
+std::string BasicDaemon<Policies...>::conversation_for(uint64_t peer_id, const std::string& uid) const {
+    if (!uid.empty()) {
+        return uid;
+    }
+    
+    {
+        LockGuard lock(peers_mutex_);
+        auto it = peers_.find(peer_id);
+        if (it != peers_.end() && !it->second.uid.empty()) {
+            return it->second.uid;
+        }
+    }
+    
+    return "peer:" + std::to_string(peer_id);
+}
+
+template <typename... Policies>
+std::string BasicDaemon<Policies...>::uid_for(uint64_t peer_id) const {
+    LockGuard lock(peers_mutex_);
+    auto it = peers_.find(peer_id);
+    return it != peers_.end() ? it->second.uid : std::string();
+}
+
+template <typename... Policies>
+int64_t BasicDaemon<Policies...>::current_timestamp_ms() {
+    return Clock::now_ms();
+}
@@ -0,0 +1,154 @@
+/**
+ * BLAKE2s Implementation (RFC 7693)
+ */
+
+#include "blake2s.h"
+#include "byte_io.h"
+
+#include <cstring>
+
+namespace {
+
+const uint32_t kIV[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+const uint8_t kSigma[10][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+};
+
+inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+} // namespace
+
+Blake2s::Blake2s(size_t digest_len, const void* key, size_t key_len)
+    : t_{0, 0}
+    , buf_len_(0)
+    , digest_len_(digest_len == 0 || digest_len > kMaxDigestBytes ? kMaxDigestBytes : digest_len)
+{
+    if (key_len > kMaxKeyBytes) {
+        key_len = kMaxKeyBytes;
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        h_[i] = kIV[i];
+    }
+    h_[0] ^= 0x01010000u ^ (static_cast<uint32_t>(key_len) << 8) ^ static_cast<uint32_t>(digest_len_);
+
+    std::memset(buf_, 0, sizeof(buf_));
+    if (key && key_len > 0) {
+        std::memcpy(buf_, key, key_len);
+        buf_len_ = kBlockBytes;
+    }
+}
+
+void Blake2s::update(const void* data, size_t len) {
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+
+    while (len > 0) {
+        // Keep the last block buffered: it must be compressed with the
+        // final flag set
+        if (buf_len_ == kBlockBytes) {
+            t_[0] += kBlockBytes;
+            if (t_[0] < kBlockBytes) {
+                t_[1]++;
+            }
+            compress(false);
+            buf_len_ = 0;
+        }
+
+        size_t n = kBlockBytes - buf_len_;
+        if (n > len) {
+            n = len;
+        }
+        std::memcpy(buf_ + buf_len_, in, n);
+        buf_len_ += n;
+        in += n;
+        len -= n;
+    }
+}
+
+void Blake2s::final(uint8_t* out) {
+    t_[0] += static_cast<uint32_t>(buf_len_);
+    if (t_[0] < buf_len_) {
+        t_[1]++;
+    }
+    std::memset(buf_ + buf_len_, 0, kBlockBytes - buf_len_);
+    compress(true);
+
+    uint8_t full[32];
+    for (int i = 0; i < 8; ++i) {
+        store_u32(full + 4 * i, h_[i]);
+    }
+    std::memcpy(out, full, digest_len_);
+}
+
+void Blake2s::compress(bool last) {
+    uint32_t m[16];
+    uint32_t v[16];
+
+    for (int i = 0; i < 16; ++i) {
+        m[i] = get_u32(buf_ + 4 * i);
+    }
+    for (int i = 0; i < 8; ++i) {
+        v[i] = h_[i];
+        v[i + 8] = kIV[i];
+    }
+    v[12] ^= t_[0];
+    v[13] ^= t_[1];
+    if (last) {
+        v[14] = ~v[14];
+    }
+
+#define B2S_G(a, b, c, d, x, y)                 \
+    v[a] = v[a] + v[b] + (x); v[d] = rotr(v[d] ^ v[a], 16); \
+    v[c] = v[c] + v[d];       v[b] = rotr(v[b] ^ v[c], 12); \
+    v[a] = v[a] + v[b] + (y); v[d] = rotr(v[d] ^ v[a], 8);  \
+    v[c] = v[c] + v[d];       v[b] = rotr(v[b] ^ v[c], 7);
+
+    for (int r = 0; r < 10; ++r) {
+        const uint8_t* s = kSigma[r];
+        B2S_G(0, 4,  8, 12, m[s[0]],  m[s[1]])
+        B2S_G(1, 5,  9, 13, m[s[2]],  m[s[3]])
+        B2S_G(2, 6, 10, 14, m[s[4]],  m[s[5]])
+        B2S_G(3, 7, 11, 15, m[s[6]],  m[s[7]])
+        B2S_G(0, 5, 10, 15, m[s[8]],  m[s[9]])
+        B2S_G(1, 6, 11, 12, m[s[10]], m[s[11]])
+        B2S_G(2, 7,  8, 13, m[s[12]], m[s[13]])
+        B2S_G(3, 4,  9, 14, m[s[14]], m[s[15]])
+    }
+
+#undef B2S_G
+
+    for (int i = 0; i < 8; ++i) {
+        h_[i] ^= v[i] ^ v[i + 8];
+    }
+}
+
+Blake2sDigest Blake2s::hash(const void* data, size_t len) {
+    Blake2sDigest out;
+    Blake2s h;
+    h.update(data, len);
+    h.final(out.data());
+    return out;
+}
+
+Blake2sDigest Blake2s::mac(const void* key, size_t key_len, const void* data, size_t len) {
+    Blake2sDigest out;
+    Blake2s h(32, key, key_len);
+    h.update(data, len);
+    h.final(out.data());
+    return out;
+}
@@ -0,0 +1,39 @@
+/**
+ * BLAKE2s - Cryptographic Hash (RFC 7693)
+ *
+ * 32-bit BLAKE2 variant: fast on both 32- and 64-bit phone CPUs with no
+ * tables or SIMD requirements. Supports keyed mode (MAC) and streaming.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+using Blake2sDigest = std::array<uint8_t, 32>;
+
+class Blake2s {
+public:
+    static constexpr size_t kBlockBytes = 64;
+    static constexpr size_t kMaxDigestBytes = 32;
+    static constexpr size_t kMaxKeyBytes = 32;
+
+    explicit Blake2s(size_t digest_len = 32, const void* key = nullptr, size_t key_len = 0);
+
+    void update(const void* data, size_t len);
+    void final(uint8_t* out);
+
+    // One-shot helpers
+    static Blake2sDigest hash(const void* data, size_t len);
+    static Blake2sDigest mac(const void* key, size_t key_len, const void* data, size_t len);
+
+private:
+    void compress(bool last);
+
+    uint32_t h_[8];
+    uint32_t t_[2];
+    uint8_t  buf_[kBlockBytes];
+    size_t   buf_len_;
+    size_t   digest_len_;
+};
@@ -0,0 +1,65 @@
+/**
+ * Byte I/O - Little-Endian Encoding Helpers
+ *
+ * All on-disk and on-wire integers in the core are little-endian.
+ * These helpers append to / read from raw buffers without alignment
+ * assumptions.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+inline void put_u8(std::string& out, uint8_t v) {
+    out.push_back(static_cast<char>(v));
+}
+
+inline void put_u16(std::string& out, uint16_t v) {
+    char b[2] = { char(v), char(v >> 8) };
+    out.append(b, 2);
+}
+
+inline void put_u32(std::string& out, uint32_t v) {
+    char b[4] = { char(v), char(v >> 8), char(v >> 16), char(v >> 24) };
+    out.append(b, 4);
+}
+
+inline void put_u64(std::string& out, uint64_t v) {
+    put_u32(out, static_cast<uint32_t>(v));
+    put_u32(out, static_cast<uint32_t>(v >> 32));
+}
+
+inline uint16_t get_u16(const void* p) {
+    const uint8_t* b = static_cast<const uint8_t*>(p);
+    return static_cast<uint16_t>(b[0] | (b[1] << 8));
+}
+
+inline uint32_t get_u32(const void* p) {
+    const uint8_t* b = static_cast<const uint8_t*>(p);
+    return uint32_t(b[0]) | uint32_t(b[1]) << 8 |
+           uint32_t(b[2]) << 16 | uint32_t(b[3]) << 24;
+}
+
+inline uint64_t get_u64(const void* p) {
+    const uint8_t* b = static_cast<const uint8_t*>(p);
+    return uint64_t(get_u32(b)) | uint64_t(get_u32(b + 4)) << 32;
+}
+
+inline void store_u32(void* p, uint32_t v) {
+    uint8_t* b = static_cast<uint8_t*>(p);
+    b[0] = uint8_t(v); b[1] = uint8_t(v >> 8);
+    b[2] = uint8_t(v >> 16); b[3] = uint8_t(v >> 24);
+}
+
+inline void store_u16(void* p, uint16_t v) {
+    uint8_t* b = static_cast<uint8_t*>(p);
+    b[0] = uint8_t(v); b[1] = uint8_t(v >> 8);
+}
+
+inline void store_u64(void* p, uint64_t v) {
+    uint8_t* b = static_cast<uint8_t*>(p);
+    store_u32(b, static_cast<uint32_t>(v));
+    store_u32(b + 4, static_cast<uint32_t>(v >> 32));
+}
@@ -0,0 +1,324 @@
+/**
+ * ChaCha20-Poly1305 Implementation
+ */
+
+#include "chacha20_poly1305.h"
+#include "byte_io.h"
+
+#include <cstring>
+
+namespace {
+
+inline uint32_t rotl(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+inline uint32_t load32(const uint8_t* p) {
+    return get_u32(p);
+}
+
+void chacha_init(uint32_t s[16], const uint8_t key[32], const uint8_t nonce[12], uint32_t counter) {
+    s[0] = 0x61707865;
+    s[1] = 0x3320646E;
+    s[2] = 0x79622D32;
+    s[3] = 0x6B206574;
+    for (int i = 0; i < 8; ++i) {
+        s[4 + i] = load32(key + 4 * i);
+    }
+    s[12] = counter;
+    s[13] = load32(nonce);
+    s[14] = load32(nonce + 4);
+    s[15] = load32(nonce + 8);
+}
+
+#define QR(a, b, c, d)                                   \
+    a += b; d ^= a; d = ROTL(d, 16);                     \
+    c += d; b ^= c; b = ROTL(b, 12);                     \
+    a += b; d ^= a; d = ROTL(d, 8);                      \
+    c += d; b ^= c; b = ROTL(b, 7);
+
+#define DOUBLE_ROUND(x)                                  \
+    QR(x[0], x[4], x[8],  x[12])                         \
+    QR(x[1], x[5], x[9],  x[13])                         \
+    QR(x[2], x[6], x[10], x[14])                         \
+    QR(x[3], x[7], x[11], x[15])                         \
+    QR(x[0], x[5], x[10], x[15])                         \
+    QR(x[1], x[6], x[11], x[12])                         \
+    QR(x[2], x[7], x[8],  x[13])                         \
+    QR(x[3], x[4], x[9],  x[14])
+
+void chacha_block(const uint32_t s[16], uint8_t out[64]) {
+    uint32_t x[16];
+    std::memcpy(x, s, sizeof(x));
+
+#define ROTL(v, n) rotl(v, n)
+    for (int i = 0; i < 10; ++i) {
+        DOUBLE_ROUND(x)
+    }
+#undef ROTL
+
+    for (int i = 0; i < 16; ++i) {
+        store_u32(out + 4 * i, x[i] + s[i]);
+    }
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+
+typedef uint32_t u32x4 __attribute__((vector_size(16)));
+
+// Four consecutive blocks: lane j of x[i] is word i of block j
+void chacha_xor4(uint32_t s[16], uint8_t* data) {
+    u32x4 in[16];
+    u32x4 x[16];
+
+    for (int i = 0; i < 16; ++i) {
+        in[i] = u32x4{ s[i], s[i], s[i], s[i] };
+    }
+    in[12] += u32x4{ 0, 1, 2, 3 };
+    std::memcpy(x, in, sizeof(x));
+
+#define ROTL(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+    for (int i = 0; i < 10; ++i) {
+        DOUBLE_ROUND(x)
+    }
+#undef ROTL
+
+    for (int i = 0; i < 16; ++i) {
+        x[i] += in[i];
+    }
+
+    for (int j = 0; j < 4; ++j) {
+        uint8_t* block = data + 64 * j;
+        for (int i = 0; i < 16; ++i) {
+            store_u32(block + 4 * i, load32(block + 4 * i) ^ x[i][j]);
+        }
+    }
+
+    s[12] += 4;
+}
+
+#endif
+
+#undef DOUBLE_ROUND
+#undef QR
+
+// =============================================================================
+// MARK: - Poly1305 (26-bit limbs)
+// =============================================================================
+
+struct Poly1305 {
+    uint32_t r[5];
+    uint32_t h[5];
+    uint32_t pad[4];
+
+    explicit Poly1305(const uint8_t key[32]) {
+        const uint32_t t0 = load32(key);
+        const uint32_t t1 = load32(key + 4);
+        const uint32_t t2 = load32(key + 8);
+        const uint32_t t3 = load32(key + 12);
+
+        // Clamp
+        r[0] = t0 & 0x3FFFFFF;
+        r[1] = ((t0 >> 26) | (t1 << 6)) & 0x3FFFF03;
+        r[2] = ((t1 >> 20) | (t2 << 12)) & 0x3FFC0FF;
+        r[3] = ((t2 >> 14) | (t3 << 18)) & 0x3F03FFF;
+        r[4] = (t3 >> 8) & 0x00FFFFF;
+
+        for (int i = 0; i < 5; ++i) {
+            h[i] = 0;
+        }
+        for (int i = 0; i < 4; ++i) {
+            pad[i] = load32(key + 16 + 4 * i);
+        }
+    }
+
+    void blocks(const uint8_t* m, size_t len, uint32_t hibit) {
+        const uint32_t r0 = r[0], r1 = r[1], r2 = r[2], r3 = r[3], r4 = r[4];
+        const uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+        uint32_t h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4];
+
+        for (; len >= 16; len -= 16, m += 16) {
+            h0 += load32(m) & 0x3FFFFFF;
+            h1 += (load32(m + 3) >> 2) & 0x3FFFFFF;
+            h2 += (load32(m + 6) >> 4) & 0x3FFFFFF;
+            h3 += (load32(m + 9) >> 6) & 0x3FFFFFF;
+            h4 += (load32(m + 12) >> 8) | hibit;
+
+            const uint64_t d0 = uint64_t(h0) * r0 + uint64_t(h1) * s4 + uint64_t(h2) * s3 +
+                                uint64_t(h3) * s2 + uint64_t(h4) * s1;
+            uint64_t d1 = uint64_t(h0) * r1 + uint64_t(h1) * r0 + uint64_t(h2) * s4 +
+                          uint64_t(h3) * s3 + uint64_t(h4) * s2;
+            uint64_t d2 = uint64_t(h0) * r2 + uint64_t(h1) * r1 + uint64_t(h2) * r0 +
+                          uint64_t(h3) * s4 + uint64_t(h4) * s3;
+            uint64_t d3 = uint64_t(h0) * r3 + uint64_t(h1) * r2 + uint64_t(h2) * r1 +
+                          uint64_t(h3) * r0 + uint64_t(h4) * s4;
+            uint64_t d4 = uint64_t(h0) * r4 + uint64_t(h1) * r3 + uint64_t(h2) * r2 +
+                          uint64_t(h3) * r1 + uint64_t(h4) * r0;
+
+            uint32_t c = uint32_t(d0 >> 26); h0 = uint32_t(d0) & 0x3FFFFFF;
+            d1 += c; c = uint32_t(d1 >> 26); h1 = uint32_t(d1) & 0x3FFFFFF;
+            d2 += c; c = uint32_t(d2 >> 26); h2 = uint32_t(d2) & 0x3FFFFFF;
+            d3 += c; c = uint32_t(d3 >> 26); h3 = uint32_t(d3) & 0x3FFFFFF;
+            d4 += c; c = uint32_t(d4 >> 26); h4 = uint32_t(d4) & 0x3FFFFFF;
+            h0 += c * 5; c = h0 >> 26; h0 &= 0x3FFFFFF;
+            h1 += c;
+        }
+
+        h[0] = h0; h[1] = h1; h[2] = h2; h[3] = h3; h[4] = h4;
+    }
+
+    // Zero-padded blocks, as the AEAD construction requires
+    void padded(const uint8_t* m, size_t len) {
+        const size_t full = len & ~size_t(15);
+        blocks(m, full, 1u << 24);
+        if (len > full) {
+            uint8_t last[16] = {};
+            std::memcpy(last, m + full, len - full);
+            blocks(last, 16, 1u << 24);
+        }
+    }
+
+    // Generic tail: 0x01 terminator, no high bit
+    void tail(const uint8_t* m, size_t len) {
+        const size_t full = len & ~size_t(15);
+        blocks(m, full, 1u << 24);
+        if (len > full) {
+            uint8_t last[16] = {};
+            std::memcpy(last, m + full, len - full);
+            last[len - full] = 1;
+            blocks(last, 16, 0);
+        }
+    }
+
+    void finish(uint8_t tag[16]) {
+        uint32_t h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4];
+        uint32_t c;
+
+        c = h1 >> 26; h1 &= 0x3FFFFFF;
+        h2 += c; c = h2 >> 26; h2 &= 0x3FFFFFF;
+        h3 += c; c = h3 >> 26; h3 &= 0x3FFFFFF;
+        h4 += c; c = h4 >> 26; h4 &= 0x3FFFFFF;
+        h0 += c * 5; c = h0 >> 26; h0 &= 0x3FFFFFF;
+        h1 += c;
+
+        // h - p, selected in constant time if h >= p
+        uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3FFFFFF;
+        uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= 0x3FFFFFF;
+        uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= 0x3FFFFFF;
+        uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= 0x3FFFFFF;
+        uint32_t g4 = h4 + c - (1u << 26);
+
+        uint32_t mask = (g4 >> 31) - 1;
+        g0 &= mask; g1 &= mask; g2 &= mask; g3 &= mask; g4 &= mask;
+        mask = ~mask;
+        h0 = (h0 & mask) | g0;
+        h1 = (h1 & mask) | g1;
+        h2 = (h2 & mask) | g2;
+        h3 = (h3 & mask) | g3;
+        h4 = (h4 & mask) | g4;
+
+        h0 = h0 | (h1 << 26);
+        h1 = (h1 >> 6) | (h2 << 20);
+        h2 = (h2 >> 12) | (h3 << 14);
+        h3 = (h3 >> 18) | (h4 << 8);
+
+        uint64_t f = uint64_t(h0) + pad[0];             store_u32(tag, uint32_t(f));
+        f = uint64_t(h1) + pad[1] + (f >> 32);          store_u32(tag + 4, uint32_t(f));
+        f = uint64_t(h2) + pad[2] + (f >> 32);          store_u32(tag + 8, uint32_t(f));
+        f = uint64_t(h3) + pad[3] + (f >> 32);          store_u32(tag + 12, uint32_t(f));
+    }
+};
+
+void aead_tag(const uint8_t key[32], const uint8_t nonce[12],
+              const uint8_t* aad, size_t aad_len,
+              const uint8_t* ct, size_t len, uint8_t tag[16]) {
+    uint8_t block0[64];
+    uint32_t s[16];
+    chacha_init(s, key, nonce, 0);
+    chacha_block(s, block0);
+
+    Poly1305 mac(block0);
+    mac.padded(aad, aad_len);
+    mac.padded(ct, len);
+
+    uint8_t lengths[16];
+    store_u32(lengths, static_cast<uint32_t>(aad_len));
+    store_u32(lengths + 4, static_cast<uint32_t>(uint64_t(aad_len) >> 32));
+    store_u32(lengths + 8, static_cast<uint32_t>(len));
+    store_u32(lengths + 12, static_cast<uint32_t>(uint64_t(len) >> 32));
+    mac.blocks(lengths, 16, 1u << 24);
+    mac.finish(tag);
+
+    std::memset(block0, 0, sizeof(block0));
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - ChaCha20
+// =============================================================================
+
+void chacha20_xor(const uint8_t key[32], const uint8_t nonce[12], uint32_t counter,
+                  uint8_t* data, size_t len) {
+    uint32_t s[16];
+    chacha_init(s, key, nonce, counter);
+
+#if defined(__GNUC__) || defined(__clang__)
+    for (; len >= 256; len -= 256, data += 256) {
+        chacha_xor4(s, data);
+    }
+#endif
+
+    uint8_t block[64];
+    while (len > 0) {
+        chacha_block(s, block);
+        s[12]++;
+
+        const size_t n = len < 64 ? len : 64;
+        for (size_t i = 0; i < n; ++i) {
+            data[i] ^= block[i];
+        }
+        data += n;
+        len -= n;
+    }
+}
+
+// =============================================================================
+// MARK: - Poly1305
+// =============================================================================
+
+void poly1305(const uint8_t key[32], const uint8_t* data, size_t len, uint8_t tag[16]) {
+    Poly1305 mac(key);
+    mac.tail(data, len);
+    mac.finish(tag);
+}
+
+// =============================================================================
+// MARK: - AEAD
+// =============================================================================
+
+void aead_seal(const uint8_t key[32], const uint8_t nonce[12],
+               const uint8_t* aad, size_t aad_len,
+               uint8_t* data, size_t len, uint8_t tag[16]) {
+    chacha20_xor(key, nonce, 1, data, len);
+    aead_tag(key, nonce, aad, aad_len, data, len, tag);
+}
+
+bool aead_open(const uint8_t key[32], const uint8_t nonce[12],
+               const uint8_t* aad, size_t aad_len,
+               uint8_t* data, size_t len, const uint8_t tag[16]) {
+    uint8_t expected[16];
+    aead_tag(key, nonce, aad, aad_len, data, len, expected);
+
+    // Constant-time compare
+    uint8_t diff = 0;
+    for (int i = 0; i < 16; ++i) {
+        diff |= expected[i] ^ tag[i];
+    }
+    if (diff != 0) {
+        return false;
+    }
+
+    chacha20_xor(key, nonce, 1, data, len);
+    return true;
+}
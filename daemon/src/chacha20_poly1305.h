@@ -0,0 +1,45 @@
+/**
+ * ChaCha20-Poly1305 - AEAD (RFC 8439)
+ *
+ * In-place authenticated encryption for message frames. ChaCha20 runs
+ * four blocks at a time on 128-bit vectors (GCC/Clang vector extensions,
+ * lowered to SSE2 on x86 and NEON on ARM) with a scalar path for the
+ * tail; Poly1305 uses 26-bit limbs so it needs no 128-bit integers on
+ * 32-bit ARM.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr size_t kAeadKeyBytes   = 32;
+constexpr size_t kAeadNonceBytes = 12;
+constexpr size_t kAeadTagBytes   = 16;
+
+/**
+ * XOR data with the ChaCha20 keystream starting at block `counter`
+ */
+void chacha20_xor(const uint8_t key[32], const uint8_t nonce[12], uint32_t counter,
+                  uint8_t* data, size_t len);
+
+/**
+ * One-shot Poly1305 MAC
+ */
+void poly1305(const uint8_t key[32], const uint8_t* data, size_t len, uint8_t tag[16]);
+
+/**
+ * Encrypt data in place and write the tag
+ */
+void aead_seal(const uint8_t key[32], const uint8_t nonce[12],
+               const uint8_t* aad, size_t aad_len,
+               uint8_t* data, size_t len, uint8_t tag[16]);
+
+/**
+ * Verify the tag and decrypt data in place
+ *
+ * @return false (data untouched) if authentication fails
+ */
+bool aead_open(const uint8_t key[32], const uint8_t nonce[12],
+               const uint8_t* aad, size_t aad_len,
+               uint8_t* data, size_t len, const uint8_t tag[16]);
@@ -0,0 +1,535 @@
+/**
+ * ChunkStore Implementation
+ *
+ * Manifest encoding (little-endian):
+ *   32 bytes  attachment id
+ *   u64       total size
+ *   u32       chunk count
+ *   per chunk: 32-byte hash, u32 size
+ */
+
+#include "chunk_store.h"
+#include "byte_io.h"
+
+#include <cstdio>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t kManifestHeaderBytes = 44;
+constexpr size_t kManifestEntryBytes  = 36;
+constexpr uint32_t kMaxChunksPerManifest = 1u << 20;
+
+// Normalized chunking: a stricter mask before the average size and a
+// looser one after it pulls chunk sizes towards kAvgChunk
+constexpr uint64_t kMaskSmall = ((1ull << 14) - 1) << (64 - 14);
+constexpr uint64_t kMaskLarge = ((1ull << 10) - 1) << (64 - 10);
+
+struct GearTable {
+    uint64_t g[256];
+
+    GearTable() {
+        // splitmix64: fixed seed so boundaries match on every device
+        uint64_t x = 0x6D657368636F7265ull;
+        for (int i = 0; i < 256; ++i) {
+            x += 0x9E3779B97F4A7C15ull;
+            uint64_t z = x;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            g[i] = z ^ (z >> 31);
+        }
+    }
+};
+
+const GearTable& gear() {
+    static const GearTable table;
+    return table;
+}
+
+bool from_hex(const std::string& hex, ChunkHash& out) {
+    if (hex.size() != 64) {
+        return false;
+    }
+    for (size_t i = 0; i < 32; ++i) {
+        int v = 0;
+        for (int k = 0; k < 2; ++k) {
+            char c = hex[2 * i + k];
+            int d = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : -1;
+            if (d < 0) {
+                return false;
+            }
+            v = v * 16 + d;
+        }
+        out[i] = static_cast<uint8_t>(v);
+    }
+    return true;
+}
+
+bool read_file(const std::string& path, std::string& out) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+    out.clear();
+    char buf[16 * 1024];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) {
+        out.append(buf, n);
+    }
+    std::fclose(f);
+    return true;
+}
+
+bool write_file(const std::string& path, const void* data, size_t len) {
+    const std::string tmp = path + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+    bool ok = std::fwrite(data, 1, len, f) == len;
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Chunking
+// =============================================================================
+
+std::vector<size_t> chunk_boundaries(const uint8_t* data, size_t len) {
+    const uint64_t* g = gear().g;
+    std::vector<size_t> ends;
+    ends.reserve(len / ChunkStore::kAvgChunk + 1);
+
+    size_t start = 0;
+    while (start < len) {
+        const size_t remaining = len - start;
+        if (remaining <= ChunkStore::kMinChunk) {
+            ends.push_back(len);
+            break;
+        }
+
+        const size_t limit = remaining < ChunkStore::kMaxChunk ? remaining : ChunkStore::kMaxChunk;
+        const size_t normal = remaining < ChunkStore::kAvgChunk ? remaining : ChunkStore::kAvgChunk;
+
+        uint64_t h = 0;
+        size_t i = ChunkStore::kMinChunk;
+        size_t cut = limit;
+
+        for (; i < normal; ++i) {
+            h = (h << 1) + g[data[start + i]];
+            if (!(h & kMaskSmall)) {
+                cut = i + 1;
+                goto found;
+            }
+        }
+        for (; i < limit; ++i) {
+            h = (h << 1) + g[data[start + i]];
+            if (!(h & kMaskLarge)) {
+                cut = i + 1;
+                goto found;
+            }
+        }
+
+    found:
+        start += cut;
+        ends.push_back(start);
+    }
+
+    return ends;
+}
+
+// =============================================================================
+// MARK: - Constructor/Destructor
+// =============================================================================
+
+ChunkStore::ChunkStore()
+    : open_(false)
+{
+}
+
+ChunkStore::~ChunkStore() {
+    close();
+}
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+bool ChunkStore::open(const std::string& directory) {
+    close();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::error_code ec;
+    fs::create_directories(fs::path(directory) / "chunks", ec);
+    fs::create_directories(fs::path(directory) / "manifests", ec);
+    if (!fs::is_directory(fs::path(directory) / "manifests", ec)) {
+        return false;
+    }
+    directory_ = directory;
+
+    // Chunks on disk
+    std::map<ChunkHash, uint32_t> on_disk;
+    for (const auto& entry : fs::recursive_directory_iterator(fs::path(directory) / "chunks", ec)) {
+        if (!entry.is_regular_file(ec)) {
+            continue;
+        }
+        ChunkHash hash;
+        if (from_hex(entry.path().filename().string(), hash)) {
+            on_disk[hash] = static_cast<uint32_t>(entry.file_size(ec));
+        } else {
+            fs::remove(entry.path(), ec); // Leftover .tmp from a crash
+        }
+    }
+
+    // Manifests whose chunks are all present take references
+    for (const auto& entry : fs::directory_iterator(fs::path(directory) / "manifests", ec)) {
+        std::string bytes;
+        Manifest m;
+        if (!read_file(entry.path().string(), bytes) ||
+            !decode_manifest(bytes.data(), bytes.size(), m)) {
+            fs::remove(entry.path(), ec);
+            continue;
+        }
+
+        bool complete = true;
+        for (const auto& ref : m.chunks) {
+            auto it = on_disk.find(ref.hash);
+            complete = complete && it != on_disk.end() && it->second == ref.size;
+        }
+        if (!complete) {
+            fs::remove(entry.path(), ec);
+            continue;
+        }
+
+        attachments_[m.id] = m.total_size;
+        for (const auto& ref : m.chunks) {
+            ChunkInfo& info = chunks_[ref.hash];
+            info.size = ref.size;
+            info.refs++;
+        }
+    }
+
+    // Unreferenced chunks (abandoned transfers, released attachments)
+    for (const auto& pair : on_disk) {
+        if (chunks_.find(pair.first) == chunks_.end()) {
+            fs::remove(chunk_path(pair.first), ec);
+        }
+    }
+
+    open_ = true;
+    return true;
+}
+
+void ChunkStore::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    chunks_.clear();
+    attachments_.clear();
+    open_ = false;
+}
+
+bool ChunkStore::is_open() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+// =============================================================================
+// MARK: - Local Attachments
+// =============================================================================
+
+bool ChunkStore::put_attachment(const void* data, size_t len, Manifest& out) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    // Chunk and hash outside the lock; this is the expensive part
+    std::vector<size_t> ends = chunk_boundaries(bytes, len);
+    std::vector<ChunkRef> refs;
+    refs.reserve(ends.size());
+
+    size_t start = 0;
+    for (size_t end : ends) {
+        refs.push_back(ChunkRef{ Blake2s::hash(bytes + start, end - start),
+                                 static_cast<uint32_t>(end - start) });
+        start = end;
+    }
+
+    Manifest m;
+    m.id = manifest_id(len, refs);
+    m.total_size = len;
+    m.chunks = std::move(refs);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!open_) {
+        return false;
+    }
+
+    if (attachments_.find(m.id) == attachments_.end()) {
+        start = 0;
+        for (size_t i = 0; i < m.chunks.size(); ++i) {
+            const ChunkRef& ref = m.chunks[i];
+            if (chunks_.find(ref.hash) == chunks_.end()) {
+                if (!write_chunk(ref.hash, bytes + start, ref.size)) {
+                    return false;
+                }
+                chunks_[ref.hash] = ChunkInfo{ ref.size, 0 };
+            }
+            start += ref.size;
+        }
+
+        if (!store_manifest(m)) {
+            return false;
+        }
+    }
+
+    out = std::move(m);
+    return true;
+}
+
+bool ChunkStore::read_attachment(const ChunkHash& id, std::string& out) const {
+    Manifest m;
+    if (!get_manifest(id, m)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    out.clear();
+    out.reserve(m.total_size);
+
+    std::string chunk;
+    for (const auto& ref : m.chunks) {
+        if (!read_file(chunk_path(ref.hash), chunk) || chunk.size() != ref.size) {
+            return false;
+        }
+        out.append(chunk);
+    }
+    return true;
+}
+
+bool ChunkStore::get_manifest(const ChunkHash& id, Manifest& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!open_ || attachments_.find(id) == attachments_.end()) {
+        return false;
+    }
+
+    std::string bytes;
+    return read_file(manifest_path(id), bytes) && decode_manifest(bytes.data(), bytes.size(), out);
+}
+
+bool ChunkStore::release_attachment(const ChunkHash& id) {
+    Manifest m;
+    if (!get_manifest(id, m)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::error_code ec;
+    fs::remove(manifest_path(id), ec);
+    attachments_.erase(id);
+
+    for (const auto& ref : m.chunks) {
+        auto it = chunks_.find(ref.hash);
+        if (it != chunks_.end() && --it->second.refs == 0) {
+            fs::remove(chunk_path(ref.hash), ec);
+            chunks_.erase(it);
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// MARK: - Transfer Support
+// =============================================================================
+
+bool ChunkStore::has_chunk(const ChunkHash& hash) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_.find(hash) != chunks_.end();
+}
+
+std::vector<ChunkHash> ChunkStore::missing_chunks(const Manifest& manifest) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<ChunkHash> missing;
+    for (const auto& ref : manifest.chunks) {
+        if (chunks_.find(ref.hash) == chunks_.end()) {
+            missing.push_back(ref.hash);
+        }
+    }
+    return missing;
+}
+
+bool ChunkStore::put_chunk(const ChunkHash& hash, const void* data, size_t len) {
+    // Never trust the sender: the bytes must hash to the name
+    if (len > kMaxChunk || Blake2s::hash(data, len) != hash) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!open_) {
+        return false;
+    }
+    if (chunks_.find(hash) != chunks_.end()) {
+        return true;
+    }
+    if (!write_chunk(hash, data, len)) {
+        return false;
+    }
+    chunks_[hash] = ChunkInfo{ static_cast<uint32_t>(len), 0 };
+    return true;
+}
+
+bool ChunkStore::read_chunk(const ChunkHash& hash, std::string& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!open_ || chunks_.find(hash) == chunks_.end()) {
+        return false;
+    }
+    return read_file(chunk_path(hash), out);
+}
+
+bool ChunkStore::add_manifest(const Manifest& manifest) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!open_) {
+        return false;
+    }
+    if (attachments_.find(manifest.id) != attachments_.end()) {
+        return true;
+    }
+    for (const auto& ref : manifest.chunks) {
+        if (chunks_.find(ref.hash) == chunks_.end()) {
+            return false;
+        }
+    }
+    return store_manifest(manifest);
+}
+
+ChunkStoreStats ChunkStore::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ChunkStoreStats s{ chunks_.size(), 0, 0, attachments_.size() };
+    for (const auto& pair : chunks_) {
+        s.stored_bytes += pair.second.size;
+    }
+    for (const auto& pair : attachments_) {
+        s.logical_bytes += pair.second;
+    }
+    return s;
+}
+
+// =============================================================================
+// MARK: - Encoding
+// =============================================================================
+
+ChunkHash ChunkStore::manifest_id(uint64_t total_size, const std::vector<ChunkRef>& chunks) {
+    std::string buf;
+    buf.reserve(8 + chunks.size() * kManifestEntryBytes);
+    put_u64(buf, total_size);
+    for (const auto& ref : chunks) {
+        buf.append(reinterpret_cast<const char*>(ref.hash.data()), ref.hash.size());
+        put_u32(buf, ref.size);
+    }
+    return Blake2s::hash(buf.data(), buf.size());
+}
+
+std::string ChunkStore::encode_manifest(const Manifest& manifest) {
+    std::string out;
+    out.reserve(kManifestHeaderBytes + manifest.chunks.size() * kManifestEntryBytes);
+    out.append(reinterpret_cast<const char*>(manifest.id.data()), manifest.id.size());
+    put_u64(out, manifest.total_size);
+    put_u32(out, static_cast<uint32_t>(manifest.chunks.size()));
+    for (const auto& ref : manifest.chunks) {
+        out.append(reinterpret_cast<const char*>(ref.hash.data()), ref.hash.size());
+        put_u32(out, ref.size);
+    }
+    return out;
+}
+
+bool ChunkStore::decode_manifest(const char* data, size_t len, Manifest& out) {
+    if (len < kManifestHeaderBytes) {
+        return false;
+    }
+
+    const uint32_t count = get_u32(data + 40);
+    if (count > kMaxChunksPerManifest || len != kManifestHeaderBytes + size_t(count) * kManifestEntryBytes) {
+        return false;
+    }
+
+    Manifest m;
+    std::copy(data, data + 32, m.id.begin());
+    m.total_size = get_u64(data + 32);
+    m.chunks.resize(count);
+
+    uint64_t sum = 0;
+    const char* p = data + kManifestHeaderBytes;
+    for (uint32_t i = 0; i < count; ++i, p += kManifestEntryBytes) {
+        std::copy(p, p + 32, m.chunks[i].hash.begin());
+        m.chunks[i].size = get_u32(p + 32);
+        if (m.chunks[i].size > kMaxChunk) {
+            return false;
+        }
+        sum += m.chunks[i].size;
+    }
+
+    // The id commits to the chunk list; reject anything inconsistent
+    if (sum != m.total_size || manifest_id(m.total_size, m.chunks) != m.id) {
+        return false;
+    }
+
+    out = std::move(m);
+    return true;
+}
+
+std::string ChunkStore::to_hex(const ChunkHash& hash) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(64, '0');
+    for (size_t i = 0; i < 32; ++i) {
+        hex[2 * i] = digits[hash[i] >> 4];
+        hex[2 * i + 1] = digits[hash[i] & 0xF];
+    }
+    return hex;
+}
+
+// =============================================================================
+// MARK: - Files
+// =============================================================================
+
+std::string ChunkStore::chunk_path(const ChunkHash& hash) const {
+    const std::string hex = to_hex(hash);
+    return (fs::path(directory_) / "chunks" / hex.substr(0, 2) / hex).string();
+}
+
+std::string ChunkStore::manifest_path(const ChunkHash& id) const {
+    return (fs::path(directory_) / "manifests" / to_hex(id)).string();
+}
+
+bool ChunkStore::write_chunk(const ChunkHash& hash, const void* data, size_t len) {
+    const std::string path = chunk_path(hash);
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+    return write_file(path, data, len);
+}
+
+bool ChunkStore::store_manifest(const Manifest& manifest) {
+    const std::string bytes = encode_manifest(manifest);
+    if (!write_file(manifest_path(manifest.id), bytes.data(), bytes.size())) {
+        return false;
+    }
+
+    attachments_[manifest.id] = manifest.total_size;
+    for (const auto& ref : manifest.chunks) {
+        chunks_[ref.hash].refs++;
+    }
+    return true;
+}
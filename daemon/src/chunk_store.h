@@ -0,0 +1,128 @@
+/**
+ * ChunkStore - Content-Addressed Attachment Storage
+ *
+ * Attachments are split with content-defined chunking (FastCDC gear
+ * hash) and each chunk is stored once, keyed by its BLAKE2s-256 hash.
+ * The same image forwarded to ten chats, or re-sent after an edit that
+ * only touched its tail, shares every unchanged chunk.
+ *
+ * Layout:
+ *   <directory>/chunks/<2 hex>/<64 hex>     chunk bytes
+ *   <directory>/manifests/<64 hex>          encoded Manifest
+ *
+ * Attachment ID:
+ *   BLAKE2s over the manifest (total size + chunk hashes/sizes), so the
+ *   same content always yields the same ID on every device.
+ *
+ * Reference Counting:
+ *   Chunk references are rebuilt from the manifests on open(); chunks no
+ *   manifest refers to (e.g. from an abandoned transfer) are deleted.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe.
+ */
+
+#pragma once
+
+#include "blake2s.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using ChunkHash = Blake2sDigest;
+
+// =============================================================================
+// MARK: - Types
+// =============================================================================
+
+struct ChunkRef {
+    ChunkHash hash;
+    uint32_t  size;
+};
+
+struct Manifest {
+    ChunkHash             id;
+    uint64_t              total_size;
+    std::vector<ChunkRef> chunks;
+};
+
+struct ChunkStoreStats {
+    uint64_t unique_chunks;
+    uint64_t stored_bytes;     // Bytes actually on disk
+    uint64_t logical_bytes;    // Bytes of all attachments as seen by users
+    uint64_t attachments;
+};
+
+/**
+ * FastCDC chunk boundaries (normalized chunking)
+ *
+ * @return End offsets of each chunk; the last one equals len
+ */
+std::vector<size_t> chunk_boundaries(const uint8_t* data, size_t len);
+
+// =============================================================================
+// MARK: - ChunkStore Class
+// =============================================================================
+
+class ChunkStore {
+public:
+    static constexpr size_t kMinChunk = 1024;
+    static constexpr size_t kAvgChunk = 4096;
+    static constexpr size_t kMaxChunk = 16384;
+
+    ChunkStore();
+    ~ChunkStore();
+
+    // Non-copyable
+    ChunkStore(const ChunkStore&) = delete;
+    ChunkStore& operator=(const ChunkStore&) = delete;
+
+    // Lifecycle
+    bool open(const std::string& directory);
+    void close();
+    bool is_open() const;
+
+    // Local attachments
+    bool put_attachment(const void* data, size_t len, Manifest& out);
+    bool read_attachment(const ChunkHash& id, std::string& out) const;
+    bool get_manifest(const ChunkHash& id, Manifest& out) const;
+    bool release_attachment(const ChunkHash& id);
+
+    // Transfer support
+    bool has_chunk(const ChunkHash& hash) const;
+    std::vector<ChunkHash> missing_chunks(const Manifest& manifest) const;
+    bool put_chunk(const ChunkHash& hash, const void* data, size_t len);
+    bool read_chunk(const ChunkHash& hash, std::string& out) const;
+    bool add_manifest(const Manifest& manifest);
+
+    ChunkStoreStats stats() const;
+
+    // Manifest identity and encoding (also the ChunkOffer payload)
+    static ChunkHash manifest_id(uint64_t total_size, const std::vector<ChunkRef>& chunks);
+    static std::string encode_manifest(const Manifest& manifest);
+    static bool decode_manifest(const char* data, size_t len, Manifest& out);
+
+    static std::string to_hex(const ChunkHash& hash);
+
+private:
+    struct ChunkInfo {
+        uint32_t size;
+        uint32_t refs;
+    };
+
+    std::string chunk_path(const ChunkHash& hash) const;
+    std::string manifest_path(const ChunkHash& id) const;
+    bool write_chunk(const ChunkHash& hash, const void* data, size_t len);
+    bool store_manifest(const Manifest& manifest);
+
+    mutable std::mutex mutex_;
+
+    std::string directory_;
+    bool        open_;
+
+    std::map<ChunkHash, ChunkInfo> chunks_;
+    std::map<ChunkHash, uint64_t>  attachments_;   // id -> total size
+};
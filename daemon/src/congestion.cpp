@@ -0,0 +1,374 @@
+/**
+ * CongestionControl Implementation
+ */
+
+#include "congestion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+// Window over which an unpaced neighbour's send rate is measured; the
+// first cut starts from it
+constexpr int64_t kRateWindowMs = 100;
+
+// Shortest partial window worth extrapolating from
+constexpr int64_t kMinWindowMs = 10;
+
+} // namespace
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+CongestionControl::CongestionControl()
+    : CongestionControl(CongestionConfig())
+{
+}
+
+CongestionControl::CongestionControl(const CongestionConfig& config)
+    : config_(config)
+    , held_peers_(0)
+    , signalled_peers_(0)
+    , high_water_(config.high_water)
+    , depth_(0)
+    , capacity_(config.queue_capacity)
+    , peak_depth_(0)
+    , shed_(0)
+    , signals_(0)
+    , decreases_(0)
+    , held_(0)
+    , dropped_(0)
+{
+}
+
+void CongestionControl::set_config(const CongestionConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    capacity_.store(config.queue_capacity, std::memory_order_relaxed);
+    high_water_.store(config.high_water, std::memory_order_relaxed);
+}
+
+CongestionConfig CongestionControl::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+// =============================================================================
+// MARK: - Local Side
+// =============================================================================
+
+void CongestionControl::set_depth(size_t depth) {
+    const uint32_t clamped = uint32_t(std::min<size_t>(depth, std::numeric_limits<uint32_t>::max()));
+    depth_.store(clamped, std::memory_order_relaxed);
+
+    uint64_t peak = peak_depth_.load(std::memory_order_relaxed);
+    while (clamped > peak && !peak_depth_.compare_exchange_weak(peak, clamped, std::memory_order_relaxed)) {
+    }
+}
+
+uint8_t CongestionControl::local_hint() const {
+    const uint32_t capacity = capacity_.load(std::memory_order_relaxed);
+    const uint32_t depth = depth_.load(std::memory_order_relaxed);
+    if (capacity == 0) {
+        return 0;
+    }
+    if (depth >= capacity) {
+        return 255;
+    }
+    return uint8_t(1 + uint64_t(depth) * 254 / capacity);
+}
+
+bool CongestionControl::on_inbound(uint64_t peer_id, uint8_t hint, int64_t now_ms, bool data) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PeerState& peer = peer_for(peer_id, now_ms);
+        advance(peer, now_ms);
+        peer.inbound_ms = now_ms;
+
+        if (hint != 0) {
+            peer.last_hint = hint;
+            peer.hint_ms = now_ms;
+            if (hint >= config_.high_water) {
+                cut(peer, now_ms);
+            }
+        }
+    }
+
+    // The hint still counts: it is what tells the neighbour to slow down
+    const uint32_t capacity = capacity_.load(std::memory_order_relaxed);
+    if (data && capacity != 0 && depth_.load(std::memory_order_relaxed) >= capacity) {
+        shed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint64_t> CongestionControl::take_signals(int64_t now_ms) {
+    std::vector<uint64_t> out;
+    const uint8_t hint = local_hint();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool congested = hint != 0 && hint >= config_.high_water;
+    const bool clear = hint < config_.low_water;
+    if (!congested && !clear) {
+        return out;
+    }
+
+    for (auto& entry : peers_) {
+        PeerState& peer = entry.second;
+        if (congested) {
+            // Only neighbours that are actually sending to us
+            const bool sending = peer.inbound_ms >= 0 && now_ms - peer.inbound_ms <= int64_t(config_.hint_timeout_ms);
+            if (sending && (!peer.signalled || now_ms - peer.signalled_ms >= int64_t(config_.signal_interval_ms))) {
+                signalled_peers_ += peer.signalled ? 0 : 1;
+                peer.signalled = true;
+                peer.signalled_ms = now_ms;
+                out.push_back(entry.first);
+            }
+        } else if (peer.signalled) {
+            peer.signalled = false;
+            signalled_peers_--;
+            out.push_back(entry.first);
+        }
+    }
+
+    signals_ += out.size();
+    return out;
+}
+
+bool CongestionControl::idle() const {
+    const uint8_t hint = local_hint();
+    return !has_held() && signalled_peers_.load(std::memory_order_relaxed) == 0 &&
+           (hint == 0 || hint < high_water_.load(std::memory_order_relaxed));
+}
+
+// =============================================================================
+// MARK: - Sending Side
+// =============================================================================
+
+bool CongestionControl::pace(uint64_t peer_id, int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PeerState& peer = peer_for(peer_id, now_ms);
+    advance(peer, now_ms);
+
+    // Never overtake frames already waiting
+    if (!peer.pending.empty()) {
+        return false;
+    }
+    if (peer.paced) {
+        if (peer.tokens < 1.0) {
+            return false;
+        }
+        peer.tokens -= 1.0;
+        return true;
+    }
+
+    if (now_ms - peer.window_ms >= kRateWindowMs) {
+        peer.measured = peer.window_frames * 1000.0 / double(now_ms - peer.window_ms);
+        peer.window_ms = now_ms;
+        peer.window_frames = 0;
+    }
+    peer.window_frames++;
+    return true;
+}
+
+CongestionControl::Pacing CongestionControl::hold(uint64_t peer_id, std::string&& frame, int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PeerState& peer = peer_for(peer_id, now_ms);
+
+    if (peer.pending.size() >= config_.max_pending) {
+        dropped_++;
+        return Pacing::Dropped;
+    }
+
+    peer.pending.push_back(std::move(frame));
+    held_++;
+    if (peer.pending.size() == 1) {
+        held_peers_++;
+        return Pacing::Wake;
+    }
+    return Pacing::Held;
+}
+
+bool CongestionControl::release(int64_t now_ms, Release& out) {
+    if (!has_held()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const size_t before = out.size();
+    for (auto& entry : peers_) {
+        PeerState& peer = entry.second;
+        if (peer.pending.empty()) {
+            continue;
+        }
+        advance(peer, now_ms);
+        while (!peer.pending.empty() && (!peer.paced || peer.tokens >= 1.0)) {
+            if (peer.paced) {
+                peer.tokens -= 1.0;
+            }
+            out.emplace_back(entry.first, std::move(peer.pending.front()));
+            peer.pending.pop_front();
+        }
+        if (peer.pending.empty()) {
+            held_peers_--;
+        }
+    }
+    return out.size() != before;
+}
+
+bool CongestionControl::has_held() const {
+    return held_peers_.load(std::memory_order_relaxed) != 0;
+}
+
+int64_t CongestionControl::next_release_ms(int64_t now_ms) const {
+    int64_t next = std::numeric_limits<int64_t>::max();
+    if (!has_held()) {
+        return next;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto& entry : peers_) {
+        const PeerState& peer = entry.second;
+        if (peer.pending.empty()) {
+            continue;
+        }
+        if (!peer.paced || peer.rate <= 0) {
+            return now_ms;
+        }
+        const double elapsed = double(std::max<int64_t>(0, now_ms - peer.updated_ms)) / 1000.0;
+        const double missing = 1.0 - (peer.tokens + elapsed * peer.rate);
+        const int64_t due = missing <= 0 ? now_ms : now_ms + int64_t(std::ceil(missing * 1000.0 / peer.rate));
+        next = std::min(next, due);
+    }
+    return next;
+}
+
+// =============================================================================
+// MARK: - Bookkeeping
+// =============================================================================
+
+void CongestionControl::forget(uint64_t peer_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = peers_.find(peer_id);
+    if (it == peers_.end()) {
+        return;
+    }
+    dropped_ += it->second.pending.size();
+    held_peers_ -= it->second.pending.empty() ? 0 : 1;
+    signalled_peers_ -= it->second.signalled ? 1 : 0;
+    peers_.erase(it);
+}
+
+void CongestionControl::sweep(int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int64_t idle_ms = config_.hint_timeout_ms;
+    for (auto it = peers_.begin(); it != peers_.end();) {
+        PeerState& peer = it->second;
+        advance(peer, now_ms);
+        const bool idle = !peer.paced && !peer.signalled && peer.pending.empty() &&
+                          now_ms - std::max(peer.inbound_ms, peer.updated_ms) > idle_ms;
+        it = idle ? peers_.erase(it) : std::next(it);
+    }
+}
+
+CongestionStats CongestionControl::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t paced = 0;
+    for (const auto& entry : peers_) {
+        paced += entry.second.paced ? 1 : 0;
+    }
+
+    return CongestionStats{
+        local_hint(),
+        peak_depth_.load(std::memory_order_relaxed),
+        shed_.load(std::memory_order_relaxed),
+        signals_,
+        decreases_,
+        held_,
+        dropped_,
+        paced
+    };
+}
+
+// =============================================================================
+// MARK: - Internals
+// =============================================================================
+
+CongestionControl::PeerState& CongestionControl::peer_for(uint64_t peer_id, int64_t now_ms) {
+    auto it = peers_.find(peer_id);
+    if (it == peers_.end()) {
+        it = peers_.emplace(peer_id, PeerState()).first;
+        it->second.updated_ms = now_ms;
+        it->second.window_ms = now_ms;
+    }
+    return it->second;
+}
+
+double CongestionControl::burst(const PeerState& peer) const {
+    // 50 ms worth of frames, so a paced neighbour still sends in clumps
+    // small enough for the receiver's queue
+    return std::max(1.0, peer.rate / 20.0);
+}
+
+void CongestionControl::advance(PeerState& peer, int64_t now_ms) {
+    if (now_ms <= peer.updated_ms) {
+        return;
+    }
+    const double seconds = double(now_ms - peer.updated_ms) / 1000.0;
+    peer.updated_ms = now_ms;
+    if (!peer.paced) {
+        return;
+    }
+
+    // Additive increase while the neighbour reports headroom or has gone
+    // quiet; held steady between the marks
+    const bool stale = now_ms - peer.hint_ms > int64_t(config_.hint_timeout_ms);
+    if (peer.last_hint < config_.low_water || stale) {
+        peer.rate += seconds * config_.increase_per_sec;
+    }
+    peer.tokens = std::min(burst(peer), peer.tokens + seconds * peer.rate);
+
+    if (peer.rate >= config_.max_rate) {
+        peer.paced = false;
+        peer.window_ms = now_ms;
+        peer.window_frames = 0;
+        peer.measured = 0;
+    }
+}
+
+void CongestionControl::cut(PeerState& peer, int64_t now_ms) {
+    if (config_.max_rate == 0) {
+        return;
+    }
+
+    const double keep = std::min(config_.decrease_percent, 100u) / 100.0;
+    if (!peer.paced) {
+        // Start from what we were actually sending at
+        double sending = peer.measured;
+        const int64_t window = now_ms - peer.window_ms;
+        if (window >= kMinWindowMs) {
+            sending = std::max(sending, peer.window_frames * 1000.0 / double(window));
+        }
+        if (sending <= 0) {
+            sending = config_.max_rate;
+        }
+        peer.paced = true;
+        peer.rate = std::max(double(config_.min_rate), std::min(sending, double(config_.max_rate)) * keep);
+        peer.tokens = 0;
+    } else if (now_ms - peer.decreased_ms >= int64_t(config_.decrease_interval_ms)) {
+        peer.rate = std::max(double(config_.min_rate), peer.rate * keep);
+        peer.tokens = std::min(peer.tokens, burst(peer));
+    } else {
+        return;
+    }
+
+    peer.decreased_ms = now_ms;
+    decreases_++;
+}
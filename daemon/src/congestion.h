@@ -0,0 +1,175 @@
+/**
+ * CongestionControl - Hop-by-Hop Backpressure Between Neighbours
+ *
+ * Local side: the depth of our event queue is mapped onto the hint byte
+ * of every frame header we send (1 = idle, 255 = full; 0 = no hint).
+ * Once the hint reaches the high-water mark, neighbours that have been
+ * sending to us also get a header-only Congestion frame every signal
+ * interval, and one more once we are back under the low-water mark.
+ * Inbound data arriving while the queue is at capacity is shed, so the
+ * queue stays bounded even against neighbours that ignore the hint;
+ * control frames (Congestion, handshakes, acks) are never shed, their
+ * hint being what the sender needs to back off.
+ *
+ * Sending side: each neighbour's hints drive an AIMD rate. A hint at the
+ * high-water mark cuts the rate (at most once per decrease interval);
+ * while hints stay under the low-water mark, or stop arriving, the rate
+ * grows linearly until it reaches max_rate and pacing lifts. Frames over
+ * the rate wait in a bounded per-neighbour queue, released in order by
+ * whoever calls release().
+ *
+ * Times are milliseconds from the caller's clock.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Backpressure limits
+ */
+struct CongestionConfig {
+    // Local side
+    uint32_t queue_capacity       = 1024;    // Depth reported as 255, beyond which inbound data is shed (0 = off)
+    uint8_t  high_water           = 128;     // Hint at which neighbours back off
+    uint8_t  low_water            = 64;      // Hint under which they may speed up
+    uint32_t signal_interval_ms   = 50;      // Between Congestion frames to one neighbour
+
+    // Sending side (frames/s towards one neighbour)
+    uint32_t max_rate             = 2000;    // Pacing lifts once the rate is back here (0 = never pace)
+    uint32_t min_rate             = 10;
+    uint32_t increase_per_sec     = 100;     // Additive increase, frames/s per second
+    uint32_t decrease_percent     = 50;      // Share of the rate kept on a cut
+    uint32_t decrease_interval_ms = 100;     // At most one cut per interval
+    uint32_t hint_timeout_ms      = 1000;    // A silent neighbour is assumed uncongested
+    uint32_t max_pending          = 256;     // Frames held per paced neighbour
+};
+
+/**
+ * Congestion counters
+ */
+struct CongestionStats {
+    uint8_t  local_hint;       // Hint we currently send
+    uint64_t peak_depth;       // Deepest the local queue has been
+    uint64_t shed;             // Inbound frames dropped at capacity
+    uint64_t signals;          // Congestion frames sent
+    uint64_t decreases;        // Rate cuts on neighbours' hints
+    uint64_t held;             // Outbound frames that waited for pacing
+    uint64_t dropped;          // Outbound frames dropped: pacing queue full
+    uint64_t paced_peers;      // Neighbours currently paced
+};
+
+class CongestionControl {
+public:
+    // Outcome of holding an outbound frame
+    enum class Pacing {
+        Held,        // Queued behind earlier frames
+        Wake,        // Queued, and the neighbour's queue was empty: call release() later
+        Dropped      // Pacing queue full
+    };
+
+    using Release = std::vector<std::pair<uint64_t, std::string>>;
+
+    CongestionControl();
+    explicit CongestionControl(const CongestionConfig& config);
+
+    // Non-copyable
+    CongestionControl(const CongestionControl&) = delete;
+    CongestionControl& operator=(const CongestionControl&) = delete;
+
+    void set_config(const CongestionConfig& config);
+    CongestionConfig config() const;
+
+    // Local side: current queue depth, and the hint it maps to
+    void set_depth(size_t depth);
+    uint8_t local_hint() const;
+
+    // Inbound payload from a neighbour with its header hint (0 = none);
+    // false if it must be shed (data only; control frames always pass)
+    bool on_inbound(uint64_t peer_id, uint8_t hint, int64_t now_ms, bool data = true);
+
+    // Neighbours owed a Congestion frame now
+    std::vector<uint64_t> take_signals(int64_t now_ms);
+
+    // Nothing held and no signal owed (lock-free)
+    bool idle() const;
+
+    // Outbound frame: true to send it now, false to hold() it
+    bool pace(uint64_t peer_id, int64_t now_ms);
+    Pacing hold(uint64_t peer_id, std::string&& frame, int64_t now_ms);
+
+    // Appends held frames whose turn has come; true if any
+    bool release(int64_t now_ms, Release& out);
+
+    // Any frames held (lock-free), and when the next one is due
+    // (INT64_MAX if none)
+    bool has_held() const;
+    int64_t next_release_ms(int64_t now_ms) const;
+
+    // Neighbour gone: its held frames are dropped
+    void forget(uint64_t peer_id);
+
+    // Forget neighbours with nothing held and no recent traffic
+    void sweep(int64_t now_ms);
+
+    CongestionStats stats() const;
+
+private:
+    struct PeerState {
+        // Sending side
+        bool     paced          = false;
+        double   rate           = 0;
+        double   tokens         = 0;
+        uint8_t  last_hint      = 0;
+        int64_t  hint_ms        = 0;
+        int64_t  decreased_ms   = 0;
+        int64_t  updated_ms     = 0;
+        int64_t  window_ms      = 0;       // Measures the unpaced send rate
+        uint32_t window_frames  = 0;
+        double   measured       = 0;
+        std::deque<std::string> pending;
+
+        // Receiving side
+        int64_t  inbound_ms     = -1;
+        int64_t  signalled_ms   = 0;
+        bool     signalled      = false;
+    };
+
+    PeerState& peer_for(uint64_t peer_id, int64_t now_ms);
+
+    // Refill, additive increase, lift pacing (lock held)
+    void advance(PeerState& peer, int64_t now_ms);
+
+    // Multiplicative decrease (lock held)
+    void cut(PeerState& peer, int64_t now_ms);
+
+    double burst(const PeerState& peer) const;
+
+    mutable std::mutex mutex_;
+    CongestionConfig config_;
+    std::unordered_map<uint64_t, PeerState> peers_;
+    // Written under the lock; read without it on the worker's fast path
+    std::atomic<size_t>  held_peers_;         // Peers with frames pending
+    std::atomic<size_t>  signalled_peers_;    // Peers told to back off, not yet cleared
+    std::atomic<uint8_t> high_water_;
+
+    std::atomic<uint32_t> depth_;
+    std::atomic<uint32_t> capacity_;
+    std::atomic<uint64_t> peak_depth_;
+    std::atomic<uint64_t> shed_;
+    uint64_t signals_;
+    uint64_t decreases_;
+    uint64_t held_;
+    uint64_t dropped_;
+};
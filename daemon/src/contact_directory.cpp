@@ -0,0 +1,603 @@
+/**
+ * ContactDirectory Implementation
+ */
+
+#include "contact_directory.h"
+#include "byte_io.h"
+#include "crc32.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t   kHeaderBytes   = 64;
+constexpr size_t   kEntryBytes    = 24;
+constexpr uint32_t kKeysPerBucket = 4;
+constexpr uint32_t kMaxPilot      = 1u << 20;
+constexpr uint32_t kDirectSlot    = 1u << 31;   // Pilot high bit: slot stored directly
+constexpr int      kMaxSeeds      = 16;
+
+// MurmurHash64A
+uint64_t hash64(const char* data, size_t len, uint64_t seed) {
+    const uint64_t m = 0xC6A4A7935BD1E995ull;
+    const int r = 47;
+
+    uint64_t h = seed ^ (len * m);
+    const char* end = data + (len & ~size_t(7));
+
+    for (const char* p = data; p != end; p += 8) {
+        uint64_t k = get_u64(p);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    switch (len & 7) {
+        case 7: h ^= uint64_t(uint8_t(end[6])) << 48; // fallthrough
+        case 6: h ^= uint64_t(uint8_t(end[5])) << 40; // fallthrough
+        case 5: h ^= uint64_t(uint8_t(end[4])) << 32; // fallthrough
+        case 4: h ^= uint64_t(uint8_t(end[3])) << 24; // fallthrough
+        case 3: h ^= uint64_t(uint8_t(end[2])) << 16; // fallthrough
+        case 2: h ^= uint64_t(uint8_t(end[1])) << 8;  // fallthrough
+        case 1: h ^= uint64_t(uint8_t(end[0]));
+                h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Map a 32-bit value onto [0, n) without a division
+inline uint32_t fastrange(uint32_t x, uint32_t n) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(x) * n) >> 32);
+}
+
+inline uint32_t bucket_for(uint64_t hash, uint32_t buckets) {
+    return fastrange(static_cast<uint32_t>(hash >> 32), buckets);
+}
+
+inline uint32_t slot_for(uint64_t hash, uint32_t pilot, uint32_t count) {
+    return fastrange(static_cast<uint32_t>(mix64(hash ^ ((pilot + 1ull) * 0x9E3779B97F4A7C15ull))), count);
+}
+
+inline size_t align8(size_t n) {
+    return (n + 7) & ~size_t(7);
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - ContactTable
+// =============================================================================
+
+ContactTable::ContactTable()
+    : mapping_(nullptr)
+    , mapping_len_(0)
+    , image_(nullptr)
+    , pilots_(nullptr)
+    , entries_(nullptr)
+    , strings_(nullptr)
+    , strings_len_(0)
+    , count_(0)
+    , buckets_(0)
+    , seed_(0)
+{
+}
+
+ContactTable::~ContactTable() {
+    if (mapping_) {
+        ::munmap(mapping_, mapping_len_);
+    }
+}
+
+std::shared_ptr<const ContactTable> ContactTable::build(const std::vector<ContactRecord>& records) {
+    // Last record wins for duplicate UIDs
+    std::unordered_map<std::string, size_t> latest;
+    latest.reserve(records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        latest[records[i].uid] = i;
+    }
+
+    std::vector<const ContactRecord*> keys;
+    keys.reserve(latest.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (!records[i].signing_key.empty() && records[i].signing_key.size() != kContactKeyBytes) {
+            return nullptr;
+        }
+        if (records[i].uid.size() > kContactMaxUidBytes) {
+            return nullptr;
+        }
+        if (latest[records[i].uid] == i) {
+            keys.push_back(&records[i]);
+        }
+    }
+
+    const uint32_t n = static_cast<uint32_t>(keys.size());
+    const uint32_t buckets = std::max<uint32_t>(1, (n + kKeysPerBucket - 1) / kKeysPerBucket);
+
+    std::vector<uint64_t> hashes(n);
+    std::vector<uint32_t> slots(n);
+    std::vector<uint32_t> pilots(buckets);
+    uint64_t seed = 0;
+    bool placed = false;
+
+    for (int attempt = 0; attempt < kMaxSeeds && !placed; ++attempt) {
+        seed = mix64(0x636F6E7461637473ull + attempt);
+
+        // Group keys by bucket (counting sort)
+        std::vector<uint32_t> start(buckets + 1, 0);
+        for (uint32_t i = 0; i < n; ++i) {
+            hashes[i] = hash64(keys[i]->uid.data(), keys[i]->uid.size(), seed);
+            start[bucket_for(hashes[i], buckets) + 1]++;
+        }
+        for (uint32_t b = 0; b < buckets; ++b) {
+            start[b + 1] += start[b];
+        }
+        std::vector<uint32_t> members(n);
+        std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+        for (uint32_t i = 0; i < n; ++i) {
+            members[fill[bucket_for(hashes[i], buckets)]++] = i;
+        }
+
+        // Largest buckets first, while the table is still empty
+        std::vector<uint32_t> order(buckets);
+        for (uint32_t b = 0; b < buckets; ++b) {
+            order[b] = b;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return start[a + 1] - start[a] > start[b + 1] - start[b];
+        });
+
+        std::vector<uint8_t> taken(n, 0);
+        std::fill(pilots.begin(), pilots.end(), 0);
+        placed = true;
+
+        size_t next_free = 0;
+        uint32_t candidate[64];
+
+        for (uint32_t b : order) {
+            const uint32_t size = start[b + 1] - start[b];
+            const uint32_t* group = members.data() + start[b];
+
+            if (size == 0) {
+                break;
+            }
+
+            if (size == 1) {
+                while (taken[next_free]) {
+                    ++next_free;
+                }
+                taken[next_free] = 1;
+                slots[group[0]] = static_cast<uint32_t>(next_free);
+                pilots[b] = kDirectSlot | static_cast<uint32_t>(next_free);
+                continue;
+            }
+
+            if (size > 64) {
+                placed = false;
+                break;
+            }
+
+            bool found = false;
+            for (uint32_t pilot = 0; pilot < kMaxPilot && !found; ++pilot) {
+                found = true;
+                for (uint32_t k = 0; k < size && found; ++k) {
+                    candidate[k] = slot_for(hashes[group[k]], pilot, n);
+                    found = !taken[candidate[k]];
+                    for (uint32_t j = 0; j < k && found; ++j) {
+                        found = candidate[j] != candidate[k];
+                    }
+                }
+                if (found) {
+                    pilots[b] = pilot;
+                    for (uint32_t k = 0; k < size; ++k) {
+                        taken[candidate[k]] = 1;
+                        slots[group[k]] = candidate[k];
+                    }
+                }
+            }
+
+            if (!found) {
+                placed = false; // Identical hashes; try another seed
+                break;
+            }
+        }
+    }
+
+    if (!placed) {
+        return nullptr;
+    }
+
+    // Lay out the image
+    const size_t pilots_off = kHeaderBytes;
+    const size_t entries_off = align8(pilots_off + size_t(buckets) * 4);
+    const size_t strings_off = entries_off + size_t(n) * kEntryBytes;
+
+    std::string strings;
+    std::vector<uint8_t> entries(size_t(n) * kEntryBytes);
+    for (uint32_t i = 0; i < n; ++i) {
+        const ContactRecord& rec = *keys[i];
+        uint8_t* e = &entries[size_t(slots[i]) * kEntryBytes];
+
+        const uint32_t uid_off = static_cast<uint32_t>(strings.size());
+        strings.append(rec.uid);
+        const uint32_t label_off = static_cast<uint32_t>(strings.size());
+        const size_t label_len = std::min<size_t>(rec.label.size(), 0xFFFF);
+        strings.append(rec.label, 0, label_len);
+        const bool signer = !rec.signing_key.empty();
+        strings.append(rec.signing_key);
+
+        std::string packed;
+        put_u64(packed, hashes[i]);
+        put_u32(packed, uid_off);
+        put_u16(packed, static_cast<uint16_t>(rec.uid.size()));
+        put_u16(packed, static_cast<uint16_t>(label_len));
+        put_u32(packed, label_off);
+        put_u32(packed, (rec.flags & ~kContactFlagSigner) | (signer ? kContactFlagSigner : 0));
+        std::memcpy(e, packed.data(), kEntryBytes);
+    }
+
+    const size_t image_len = align8(strings_off + strings.size());
+
+    std::shared_ptr<ContactTable> table(new ContactTable);
+    std::vector<uint8_t>& image = table->owned_;
+    image.assign(image_len, 0);
+
+    for (uint32_t b = 0; b < buckets; ++b) {
+        store_u32(&image[pilots_off + size_t(b) * 4], pilots[b]);
+    }
+    if (n > 0) {
+        std::memcpy(&image[entries_off], entries.data(), entries.size());
+    }
+    if (!strings.empty()) {
+        std::memcpy(&image[strings_off], strings.data(), strings.size());
+    }
+
+    std::string header;
+    put_u32(header, kContactMagic);
+    put_u16(header, kContactVersion);
+    put_u16(header, 0);
+    put_u32(header, n);
+    put_u32(header, buckets);
+    put_u64(header, seed);
+    put_u64(header, pilots_off);
+    put_u64(header, entries_off);
+    put_u64(header, strings_off);
+    put_u64(header, image_len);
+    put_u32(header, crc32(image.data() + kHeaderBytes, image_len - kHeaderBytes));
+    put_u32(header, 0);
+    std::memcpy(image.data(), header.data(), header.size());
+
+    if (!table->attach(image.data(), image.size())) {
+        return nullptr;
+    }
+    return table;
+}
+
+std::shared_ptr<const ContactTable> ContactTable::map_file(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(kHeaderBytes)) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const size_t len = static_cast<size_t>(st.st_size);
+    void* addr = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+
+    std::shared_ptr<ContactTable> table(new ContactTable);
+    table->mapping_ = addr;
+    table->mapping_len_ = len;
+
+    const uint8_t* data = static_cast<const uint8_t*>(addr);
+    if (crc32(data + kHeaderBytes, len - kHeaderBytes) != get_u32(data + 56) ||
+        !table->attach(data, len)) {
+        return nullptr;
+    }
+
+    // Lookups are random access; readahead only wastes memory
+    ::madvise(addr, len, MADV_RANDOM);
+    return table;
+}
+
+bool ContactTable::write_file(const std::string& path) const {
+    const uint64_t len = get_u64(image_ + 48);
+    const std::string tmp = path + ".tmp";
+
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+
+    bool ok = std::fwrite(image_, 1, len, f) == len;
+    ok = std::fflush(f) == 0 && ok;
+    ok = ::fsync(::fileno(f)) == 0 && ok;
+    std::fclose(f);
+
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ContactTable::attach(const uint8_t* data, size_t len) {
+    if (len < kHeaderBytes || get_u32(data) != kContactMagic || get_u16(data + 4) != kContactVersion) {
+        return false;
+    }
+
+    const uint32_t count = get_u32(data + 8);
+    const uint32_t buckets = get_u32(data + 12);
+    const uint64_t pilots_off = get_u64(data + 24);
+    const uint64_t entries_off = get_u64(data + 32);
+    const uint64_t strings_off = get_u64(data + 40);
+    const uint64_t image_len = get_u64(data + 48);
+
+    if (image_len != len || buckets == 0 || pilots_off != kHeaderBytes ||
+        entries_off < pilots_off + uint64_t(buckets) * 4 || entries_off % 8 != 0 ||
+        strings_off != entries_off + uint64_t(count) * kEntryBytes || strings_off > len) {
+        return false;
+    }
+
+    const uint64_t strings_len = len - strings_off;
+
+    // Every pilot and string reference must stay inside the image
+    for (uint32_t b = 0; b < buckets; ++b) {
+        const uint32_t pilot = get_u32(data + pilots_off + size_t(b) * 4);
+        if ((pilot & kDirectSlot) && (pilot & ~kDirectSlot) >= count) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint8_t* e = data + entries_off + size_t(i) * kEntryBytes;
+        const uint64_t key_len = (get_u32(e + 20) & kContactFlagSigner) ? kContactKeyBytes : 0;
+        if (uint64_t(get_u32(e + 8)) + get_u16(e + 12) > strings_len ||
+            uint64_t(get_u32(e + 16)) + get_u16(e + 14) + key_len > strings_len) {
+            return false;
+        }
+    }
+
+    image_ = data;
+    pilots_ = reinterpret_cast<const uint32_t*>(data + pilots_off);
+    entries_ = data + entries_off;
+    strings_ = reinterpret_cast<const char*>(data + strings_off);
+    strings_len_ = strings_len;
+    count_ = count;
+    buckets_ = buckets;
+    seed_ = get_u64(data + 16);
+    return true;
+}
+
+int64_t ContactTable::slot_of(const char* uid, size_t len, uint64_t* hash_out) const {
+    if (count_ == 0) {
+        return -1;
+    }
+
+    const uint64_t hash = hash64(uid, len, seed_);
+    const uint32_t pilot = get_u32(pilots_ + bucket_for(hash, buckets_));
+    const uint32_t slot = (pilot & kDirectSlot) ? (pilot & ~kDirectSlot) : slot_for(hash, pilot, count_);
+
+    *hash_out = hash;
+    return slot;
+}
+
+bool ContactTable::find(const char* uid, size_t len, uint32_t* flags_out) const {
+    uint64_t hash = 0;
+    const int64_t slot = slot_of(uid, len, &hash);
+    if (slot < 0) {
+        return false;
+    }
+
+    // A perfect hash maps every key somewhere; confirm it is this one
+    const uint8_t* e = entries_ + size_t(slot) * kEntryBytes;
+    if (get_u64(e) != hash || get_u16(e + 12) != len ||
+        std::memcmp(strings_ + get_u32(e + 8), uid, len) != 0) {
+        return false;
+    }
+
+    if (flags_out) {
+        *flags_out = get_u32(e + 20) & ~kContactFlagSigner;
+    }
+    return true;
+}
+
+bool ContactTable::lookup(const std::string& uid, ContactRecord& out) const {
+    uint64_t hash = 0;
+    const int64_t slot = slot_of(uid.data(), uid.size(), &hash);
+    if (slot < 0 || !find(uid.data(), uid.size(), nullptr)) {
+        return false;
+    }
+
+    const uint8_t* e = entries_ + size_t(slot) * kEntryBytes;
+    out.uid = uid;
+    out.flags = get_u32(e + 20) & ~kContactFlagSigner;
+    out.label.assign(strings_ + get_u32(e + 16), get_u16(e + 14));
+    out.signing_key.clear();
+    if (get_u32(e + 20) & kContactFlagSigner) {
+        out.signing_key.assign(strings_ + get_u32(e + 16) + get_u16(e + 14), kContactKeyBytes);
+    }
+    return true;
+}
+
+bool ContactTable::signing_key(const std::string& uid, ContactKey& out) const {
+    uint64_t hash = 0;
+    const int64_t slot = slot_of(uid.data(), uid.size(), &hash);
+    if (slot < 0 || !find(uid.data(), uid.size(), nullptr)) {
+        return false;
+    }
+
+    const uint8_t* e = entries_ + size_t(slot) * kEntryBytes;
+    if (!(get_u32(e + 20) & kContactFlagSigner)) {
+        return false;
+    }
+    std::memcpy(out.data(), strings_ + get_u32(e + 16) + get_u16(e + 14), kContactKeyBytes);
+    return true;
+}
+
+size_t ContactTable::size() const {
+    return count_;
+}
+
+// =============================================================================
+// MARK: - ContactDirectory
+// =============================================================================
+
+ContactDirectory::ContactDirectory()
+    : allowlist_(false)
+    , building_(false)
+{
+}
+
+ContactDirectory::~ContactDirectory() {
+    wait_idle();
+}
+
+bool ContactDirectory::load(const std::string& path) {
+    std::shared_ptr<const ContactTable> table = ContactTable::map_file(path);
+    if (!table) {
+        return false;
+    }
+    swap_in(std::move(table));
+    return true;
+}
+
+void ContactDirectory::rebuild(std::vector<ContactRecord> records, const std::string& path, DoneCallback done) {
+    std::unique_ptr<BuildRequest> request(new BuildRequest);
+    request->records = std::move(records);
+    request->path = path;
+    request->done = std::move(done);
+
+    std::lock_guard<std::mutex> lock(build_mutex_);
+
+    // One build at a time; a newer list supersedes one still queued
+    if (pending_) {
+        request->superseded = std::move(pending_->superseded);
+        if (pending_->done) {
+            request->superseded.push_back(std::move(pending_->done));
+        }
+    }
+    pending_ = std::move(request);
+
+    if (building_) {
+        return; // The running builder takes it next
+    }
+    if (builder_.joinable()) {
+        builder_.join(); // Already past its loop; nothing left to wait for
+    }
+    building_ = true;
+    builder_ = std::thread(&ContactDirectory::builder_loop, this);
+}
+
+void ContactDirectory::wait_idle() {
+    std::unique_lock<std::mutex> lock(build_mutex_);
+    idle_cv_.wait(lock, [this] { return !building_; });
+    if (builder_.joinable()) {
+        builder_.join();
+    }
+}
+
+void ContactDirectory::builder_loop() {
+    for (;;) {
+        std::unique_ptr<BuildRequest> request;
+        {
+            std::lock_guard<std::mutex> lock(build_mutex_);
+            if (!pending_) {
+                building_ = false;
+                idle_cv_.notify_all();
+                return;
+            }
+            request = std::move(pending_);
+        }
+        build(*request);
+    }
+}
+
+void ContactDirectory::build(BuildRequest& request) {
+    for (const auto& done : request.superseded) {
+        done(false);
+    }
+
+    std::shared_ptr<const ContactTable> table = ContactTable::build(request.records);
+
+    // Prefer the mapped file: its pages are shared and evictable
+    if (table && !request.path.empty()) {
+        std::shared_ptr<const ContactTable> mapped;
+        if (table->write_file(request.path)) {
+            mapped = ContactTable::map_file(request.path);
+        }
+        table = mapped;
+    }
+
+    if (table) {
+        swap_in(table);
+    }
+    if (request.done) {
+        request.done(table != nullptr);
+    }
+}
+
+void ContactDirectory::set_allowlist(bool allowlist) {
+    allowlist_.store(allowlist, std::memory_order_relaxed);
+}
+
+bool ContactDirectory::allowlist() const {
+    return allowlist_.load(std::memory_order_relaxed);
+}
+
+bool ContactDirectory::lookup(const std::string& uid, ContactRecord& out) const {
+    std::shared_ptr<const ContactTable> t = table();
+    return t && t->lookup(uid, out);
+}
+
+bool ContactDirectory::admits(const std::string& uid) const {
+    std::shared_ptr<const ContactTable> t = table();
+    uint32_t flags = 0;
+
+    if (t && t->find(uid.data(), uid.size(), &flags)) {
+        return (flags & kContactFlagBlocked) == 0;
+    }
+    return !allowlist();
+}
+
+bool ContactDirectory::signing_key(const std::string& uid, ContactKey& out) const {
+    std::shared_ptr<const ContactTable> t = table();
+    return t && t->signing_key(uid, out);
+}
+
+size_t ContactDirectory::size() const {
+    std::shared_ptr<const ContactTable> t = table();
+    return t ? t->size() : 0;
+}
+
+std::shared_ptr<const ContactTable> ContactDirectory::table() const {
+    return std::atomic_load(&table_);
+}
+
+void ContactDirectory::swap_in(std::shared_ptr<const ContactTable> table) {
+    std::atomic_store(&table_, std::move(table));
+}
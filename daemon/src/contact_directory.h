@@ -0,0 +1,191 @@
+/**
+ * ContactDirectory - Static Perfect-Hash UID Directory
+ *
+ * Read-only map from UID to contact record for large, mostly static lists
+ * (contacts, allowed members, block lists) that relays and kiosk nodes
+ * consult for every inbound frame.
+ *
+ * Structure:
+ *   Minimal perfect hash (hash-and-displace): a key's 64-bit hash picks a
+ *   bucket; the bucket's 32-bit pilot picks the key's slot in the entry
+ *   array. Buckets of one key store their slot directly. A lookup touches
+ *   the pilot, the entry (which carries the full hash) and, on a hash
+ *   match, the UID bytes to confirm membership.
+ *
+ * Image Layout (little-endian, 8-byte aligned, identical in memory and
+ * on disk so files are used in place via mmap):
+ *   Header (64 bytes):
+ *     u32 magic "MCDR", u16 version, u16 reserved
+ *     u32 count, u32 buckets, u64 seed
+ *     u64 pilots_off, u64 entries_off, u64 strings_off, u64 image_len
+ *     u32 crc32(bytes after header), u32 reserved
+ *   u32 pilots[buckets]
+ *   entries[count]: u64 hash, u32 uid_off, u16 uid_len, u16 label_len,
+ *                   u32 label_off, u32 flags
+ *   string pool (UIDs, labels, and a 32-byte signing key right after
+ *                the label of entries flagged kContactFlagSigner)
+ *
+ * Rebuilds:
+ *   rebuild() builds a new table on a background thread (optionally
+ *   writing and mapping it from disk) and swaps it in atomically;
+ *   lookups in flight keep the table they started with. It never waits
+ *   for a running build: the newest list is queued behind it, and any
+ *   list still queued is superseded.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr uint32_t kContactMagic   = 0x5244434D; // "MCDR"
+constexpr uint16_t kContactVersion = 1;
+
+// Record flags
+constexpr uint32_t kContactFlagContact = 1u << 0;
+constexpr uint32_t kContactFlagMember  = 1u << 1;
+constexpr uint32_t kContactFlagBlocked = 1u << 2;
+constexpr uint32_t kContactFlagSigner  = 1u << 31;   // Internal: a signing key follows the label
+
+constexpr size_t kContactKeyBytes = 32;
+constexpr size_t kContactMaxUidBytes = 0xFFFF;   // Entries store a u16 length
+using ContactKey = std::array<uint8_t, kContactKeyBytes>;
+
+// =============================================================================
+// MARK: - Types
+// =============================================================================
+
+struct ContactRecord {
+    std::string uid;
+    uint32_t    flags;
+    std::string label;    // Display name (may be empty)
+    std::string signing_key;   // Ed25519 public key (kContactKeyBytes), or empty
+};
+
+// =============================================================================
+// MARK: - ContactTable Class
+// =============================================================================
+
+/**
+ * One immutable directory image (built in memory or mapped from a file)
+ */
+class ContactTable {
+public:
+    ~ContactTable();
+
+    // Non-copyable
+    ContactTable(const ContactTable&) = delete;
+    ContactTable& operator=(const ContactTable&) = delete;
+
+    // Duplicate UIDs keep the last record; fails on a signing key that
+    // is neither empty nor kContactKeyBytes long, or on a UID longer
+    // than kContactMaxUidBytes (it would be stored as another key)
+    static std::shared_ptr<const ContactTable> build(const std::vector<ContactRecord>& records);
+    static std::shared_ptr<const ContactTable> map_file(const std::string& path);
+
+    bool write_file(const std::string& path) const;
+
+    // Hot path: no allocation
+    bool find(const char* uid, size_t len, uint32_t* flags_out) const;
+
+    bool lookup(const std::string& uid, ContactRecord& out) const;
+    bool signing_key(const std::string& uid, ContactKey& out) const;
+    size_t size() const;
+
+private:
+    ContactTable();
+
+    bool attach(const uint8_t* data, size_t len);
+    int64_t slot_of(const char* uid, size_t len, uint64_t* hash_out) const;
+
+    std::vector<uint8_t> owned_;
+    void*    mapping_;
+    size_t   mapping_len_;
+
+    const uint8_t*  image_;
+    const uint32_t* pilots_;
+    const uint8_t*  entries_;
+    const char*     strings_;
+    uint64_t        strings_len_;
+    uint32_t        count_;
+    uint32_t        buckets_;
+    uint64_t        seed_;
+};
+
+// =============================================================================
+// MARK: - ContactDirectory Class
+// =============================================================================
+
+class ContactDirectory {
+public:
+    using DoneCallback = std::function<void(bool ok)>;
+
+    ContactDirectory();
+    ~ContactDirectory();
+
+    // Non-copyable
+    ContactDirectory(const ContactDirectory&) = delete;
+    ContactDirectory& operator=(const ContactDirectory&) = delete;
+
+    // Map a directory file and swap it in
+    bool load(const std::string& path);
+
+    /**
+     * Build a new table in the background and swap it in when done
+     *
+     * @param path If not empty, the table is written there and mapped
+     * @param done Optional; called on the builder thread (must not
+     *             call rebuild() or wait_idle()), with false if the
+     *             build failed or a newer list superseded this one
+     */
+    void rebuild(std::vector<ContactRecord> records, const std::string& path, DoneCallback done = nullptr);
+
+    // Block until any background rebuild has finished
+    void wait_idle();
+
+    /**
+     * Allowlist mode: UIDs not in the directory are refused
+     * (otherwise only records flagged Blocked are refused)
+     */
+    void set_allowlist(bool allowlist);
+    bool allowlist() const;
+
+    bool lookup(const std::string& uid, ContactRecord& out) const;
+    bool admits(const std::string& uid) const;
+
+    // The key the UID signs with, if its record has one
+    bool signing_key(const std::string& uid, ContactKey& out) const;
+    size_t size() const;
+
+    std::shared_ptr<const ContactTable> table() const;
+
+private:
+    struct BuildRequest {
+        std::vector<ContactRecord> records;
+        std::string                path;
+        DoneCallback               done;
+        std::vector<DoneCallback>  superseded;   // Told false when this one is taken
+    };
+
+    void builder_loop();
+    void build(BuildRequest& request);
+    void swap_in(std::shared_ptr<const ContactTable> table);
+
+    std::shared_ptr<const ContactTable> table_;   // std::atomic_load/store only
+    std::atomic<bool> allowlist_;
+
+    std::mutex              build_mutex_;
+    std::condition_variable idle_cv_;
+    std::unique_ptr<BuildRequest> pending_;       // Next list for the builder
+    bool                    building_;            // builder_ is running its loop
+    std::thread             builder_;
+};
@@ -0,0 +1,153 @@
+/**
+ * ConversationTable Implementation
+ */
+
+#include "conversation_table.h"
+
+namespace {
+
+// Cut at a UTF-8 character boundary so previews are always valid text
+std::string make_preview(const std::string& body) {
+    if (body.size() <= ConversationTable::kPreviewBytes) {
+        return body;
+    }
+
+    size_t len = ConversationTable::kPreviewBytes;
+    while (len > 0 && (static_cast<unsigned char>(body[len]) & 0xC0) == 0x80) {
+        --len;
+    }
+    return body.substr(0, len);
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Updates
+// =============================================================================
+
+void ConversationTable::on_message(
+    const std::string& conversation,
+    bool outbound,
+    int64_t timestamp,
+    const std::string& body
+) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto result = entries_.try_emplace(conversation);
+    Entry& entry = result.first->second;
+    if (result.second) {
+        entry.summary = ConversationSummary{ conversation, std::string(), 0, false, 0, 0, 0 };
+        entry.dirty = false;
+    }
+
+    ConversationSummary& s = entry.summary;
+    s.message_count++;
+    if (!outbound) {
+        s.inbound_count++;
+    }
+
+    // Late arrivals still count, but never replace a newer preview
+    if (timestamp >= s.last_timestamp) {
+        s.last_message = make_preview(body);
+        s.last_timestamp = timestamp;
+        s.last_outbound = outbound;
+    }
+
+    mark_dirty(entry);
+}
+
+void ConversationTable::mark_read(const std::string& conversation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(conversation);
+    if (it == entries_.end() || it->second.summary.read_count == it->second.summary.inbound_count) {
+        return;
+    }
+
+    it->second.summary.read_count = it->second.summary.inbound_count;
+    mark_dirty(it->second);
+}
+
+void ConversationTable::remove(const std::string& conversation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(conversation);
+    if (it == entries_.end()) {
+        return;
+    }
+
+    // Reported once with message_count == 0, then dropped in take_changes()
+    ConversationSummary& s = it->second.summary;
+    s.last_message.clear();
+    s.message_count = 0;
+    s.inbound_count = 0;
+    s.read_count = 0;
+    mark_dirty(it->second);
+}
+
+void ConversationTable::mark_dirty(Entry& entry) {
+    if (!entry.dirty) {
+        entry.dirty = true;
+        dirty_.push_back(entry.summary.conversation);
+    }
+}
+
+// =============================================================================
+// MARK: - Queries
+// =============================================================================
+
+std::vector<ConversationSummary> ConversationTable::all() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<ConversationSummary> out;
+    out.reserve(entries_.size());
+    for (const auto& pair : entries_) {
+        if (pair.second.summary.message_count > 0) {
+            out.push_back(pair.second.summary);
+        }
+    }
+    return out;
+}
+
+std::vector<ConversationSummary> ConversationTable::take_changes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<ConversationSummary> out;
+    out.reserve(dirty_.size());
+
+    for (const auto& name : dirty_) {
+        auto it = entries_.find(name);
+        if (it == entries_.end()) {
+            continue;
+        }
+
+        it->second.dirty = false;
+        out.push_back(it->second.summary);
+
+        if (it->second.summary.message_count == 0) {
+            entries_.erase(it);
+        }
+    }
+
+    dirty_.clear();
+    return out;
+}
+
+bool ConversationTable::has_changes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !dirty_.empty();
+}
+
+// =============================================================================
+// MARK: - Warm Restart
+// =============================================================================
+
+void ConversationTable::restore(const std::vector<ConversationSummary>& summaries) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const auto& summary : summaries) {
+        Entry& entry = entries_[summary.conversation];
+        entry.summary = summary;
+        entry.dirty = false;
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * ConversationTable - Home Screen Summaries
+ *
+ * Keeps, per conversation, the last message preview, its timestamp and
+ * the unread count, so the UI never has to scan history.
+ *
+ * Cost:
+ *   - on_message() / mark_read() / remove(): O(1)
+ *   - take_changes(): O(changed conversations)
+ *
+ * Unread Counting:
+ *   Each conversation counts inbound messages. A read receipt records
+ *   the inbound count the user has seen; unread = inbound - seen.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// =============================================================================
+// MARK: - Types
+// =============================================================================
+
+struct ConversationSummary {
+    std::string conversation;
+    std::string last_message;      // Preview, at most kPreviewBytes
+    int64_t     last_timestamp;
+    bool        last_outbound;
+    uint64_t    message_count;     // 0 = conversation was deleted
+    uint64_t    inbound_count;
+    uint64_t    read_count;        // Inbound messages the user has seen
+
+    uint32_t unread() const {
+        return static_cast<uint32_t>(inbound_count - read_count);
+    }
+};
+
+// =============================================================================
+// MARK: - ConversationTable Class
+// =============================================================================
+
+class ConversationTable {
+public:
+    static constexpr size_t kPreviewBytes = 120;
+
+    ConversationTable() = default;
+
+    // Non-copyable
+    ConversationTable(const ConversationTable&) = delete;
+    ConversationTable& operator=(const ConversationTable&) = delete;
+
+    // Updates
+    void on_message(const std::string& conversation, bool outbound,
+                    int64_t timestamp, const std::string& body);
+    void mark_read(const std::string& conversation);
+    void remove(const std::string& conversation);
+
+    // Queries
+    std::vector<ConversationSummary> all() const;
+    std::vector<ConversationSummary> take_changes();
+    bool has_changes() const;
+
+    // Warm restart
+    void restore(const std::vector<ConversationSummary>& summaries);
+
+private:
+    struct Entry {
+        ConversationSummary summary;
+        bool                dirty;
+    };
+
+    void mark_dirty(Entry& entry);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::vector<std::string> dirty_;
+};
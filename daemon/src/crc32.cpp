@@ -0,0 +1,60 @@
+/**
+ * CRC-32 Implementation
+ *
+ * Slicing-by-8: eight 256-entry tables, 8 bytes consumed per iteration.
+ */
+
+#include "crc32.h"
+
+namespace {
+
+struct Crc32Tables {
+    uint32_t t[8][256];
+
+    Crc32Tables() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            t[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int s = 1; s < 8; ++s) {
+                t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+const Crc32Tables& tables() {
+    static const Crc32Tables instance;
+    return instance;
+}
+
+} // namespace
+
+uint32_t crc32(const void* data, size_t len, uint32_t crc) {
+    const auto& t = tables().t;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+
+    while (len >= 8) {
+        uint32_t lo = crc ^ (uint32_t(p[0]) | uint32_t(p[1]) << 8 |
+                             uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24);
+        uint32_t hi = uint32_t(p[4]) | uint32_t(p[5]) << 8 |
+                      uint32_t(p[6]) << 16 | uint32_t(p[7]) << 24;
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^
+              t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^
+              t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+        p += 8;
+        len -= 8;
+    }
+
+    while (len--) {
+        crc = t[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
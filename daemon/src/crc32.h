@@ -0,0 +1,22 @@
+/**
+ * CRC-32 - Record Checksums
+ *
+ * Standard CRC-32 (IEEE 802.3, reflected 0xEDB88320) used to detect torn
+ * or corrupted records in on-disk files. Slicing-by-8 keeps it well above
+ * flash read speed so checksumming never dominates I/O.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Compute or continue a CRC-32
+ *
+ * @param data Bytes to checksum
+ * @param len  Number of bytes
+ * @param crc  Previous result when checksumming in pieces (0 to start)
+ * @return Updated CRC-32
+ */
+uint32_t crc32(const void* data, size_t len, uint32_t crc = 0);
@@ -0,0 +1,261 @@
+/**
+ * Daemon Policies - Compile-Time Configuration for BasicDaemon
+ *
+ * BasicDaemon<Policies...> takes any number of policies, in any order;
+ * each one fills a slot (queue, sync, clock, logger) and slots left
+ * out keep their default. Everything is resolved at compile time, so
+ * there is no virtual dispatch on the hot path, and a disabled feature
+ * (NullLogger) compiles to nothing, arguments included.
+ *
+ *   Queue   StdQueue (default), RingQueue
+ *   Sync    StdSync (default), SpinSync
+ *   Clock   SystemClock (default), ManualClock
+ *   Logger  AsyncLogger (default), StdoutLogger, NullLogger
+ *
+ * Example: using RelayDaemon = BasicDaemon<RingQueue, NullLogger>;
+ */
+
+#pragma once
+
+#include "logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =============================================================================
+// MARK: - Policy Selection
+// =============================================================================
+
+struct QueuePolicyTag {};
+struct SyncPolicyTag {};
+struct ClockPolicyTag {};
+struct LoggerPolicyTag {};
+
+/**
+ * First policy in the pack whose category is Tag, else Default
+ */
+template <typename Tag, typename Default, typename... Policies>
+struct SelectPolicy {
+    using type = Default;
+};
+
+template <typename Tag, typename Default, typename First, typename... Rest>
+struct SelectPolicy<Tag, Default, First, Rest...> {
+    using type = typename std::conditional<
+        std::is_same<typename First::category, Tag>::value,
+        First,
+        typename SelectPolicy<Tag, Default, Rest...>::type
+    >::type;
+};
+
+template <typename Tag, typename Default, typename... Policies>
+using SelectPolicyT = typename SelectPolicy<Tag, Default, Policies...>::type;
+
+// =============================================================================
+// MARK: - Queue
+// =============================================================================
+
+/**
+ * std::queue over std::deque
+ */
+struct StdQueue {
+    using category = QueuePolicyTag;
+
+    template <typename T>
+    using type = std::queue<T>;
+};
+
+/**
+ * Growable power-of-two ring: one contiguous allocation that is reused
+ * once warmed up, instead of deque blocks allocated and freed as the
+ * queue moves
+ */
+struct RingQueue {
+    using category = QueuePolicyTag;
+
+    template <typename T>
+    class type {
+    public:
+        type() : slots_(16), head_(0), size_(0) {}
+
+        bool empty() const { return size_ == 0; }
+        size_t size() const { return size_; }
+
+        T& front() { return slots_[head_]; }
+
+        void push(T&& value) {
+            if (size_ == slots_.size()) {
+                grow();
+            }
+            slots_[(head_ + size_) & (slots_.size() - 1)] = std::move(value);
+            size_++;
+        }
+
+        void pop() {
+            slots_[head_] = T();
+            head_ = (head_ + 1) & (slots_.size() - 1);
+            size_--;
+        }
+
+    private:
+        void grow() {
+            std::vector<T> bigger(slots_.size() * 2);
+            for (size_t i = 0; i < size_; ++i) {
+                bigger[i] = std::move(slots_[(head_ + i) & (slots_.size() - 1)]);
+            }
+            slots_.swap(bigger);
+            head_ = 0;
+        }
+
+        std::vector<T> slots_;
+        size_t         head_;
+        size_t         size_;
+    };
+};
+
+// =============================================================================
+// MARK: - Synchronization
+// =============================================================================
+
+/**
+ * std::mutex + std::condition_variable
+ */
+struct StdSync {
+    using category  = SyncPolicyTag;
+    using Mutex     = std::mutex;
+    using Condition = std::condition_variable;
+};
+
+/**
+ * Test-and-test-and-set spin lock; suits the daemon's short critical
+ * sections on cores where parking a thread costs more than the wait
+ */
+class SpinMutex {
+public:
+    void lock() {
+        while (flag_.exchange(true, std::memory_order_acquire)) {
+            while (flag_.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool try_lock() { return !flag_.exchange(true, std::memory_order_acquire); }
+    void unlock() { flag_.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> flag_{false};
+};
+
+struct SpinSync {
+    using category  = SyncPolicyTag;
+    using Mutex     = SpinMutex;
+    using Condition = std::condition_variable_any;
+};
+
+// =============================================================================
+// MARK: - Clock
+// =============================================================================
+
+// The Clock policy supplies current_timestamp_ms(): message and
+// conversation timestamps, and the now_ms that admission, congestion
+// pacing, link and duty-cycle decisions are made against. The worker's
+// own schedule does not go through it: maintenance, task timers and
+// hibernation run on std::chrono::steady_clock, because the worker sleeps
+// on a real condition variable until those deadlines. ManualClock makes
+// timestamps and rate decisions deterministic, not when the worker wakes.
+
+/**
+ * Wall-clock milliseconds since the epoch (message timestamps)
+ */
+struct SystemClock {
+    using category = ClockPolicyTag;
+
+    static int64_t now_ms() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+};
+
+/**
+ * Settable clock for deterministic tests (shared by all instances);
+ * see above for what it does not cover
+ */
+struct ManualClock {
+    using category = ClockPolicyTag;
+
+    static int64_t now_ms() { return time().load(std::memory_order_relaxed); }
+    static void set_ms(int64_t ms) { time().store(ms, std::memory_order_relaxed); }
+
+private:
+    static std::atomic<int64_t>& time() {
+        static std::atomic<int64_t> ms(0);
+        return ms;
+    }
+};
+
+// =============================================================================
+// MARK: - Logger
+// =============================================================================
+
+/**
+ * Binary records handed to the process's AsyncLog; formatting and I/O
+ * happen on its thread
+ */
+struct AsyncLogger {
+    using category = LoggerPolicyTag;
+    static constexpr bool enabled = true;
+
+    template <typename... Args>
+    static void write(LogLevel level, const Args&... args) {
+        AsyncLog::instance().write(level, args...);
+    }
+};
+
+/**
+ * One line per call on std::cout, formatted on the calling thread
+ */
+struct StdoutLogger {
+    using category = LoggerPolicyTag;
+    static constexpr bool enabled = true;
+
+    template <typename... Args>
+    static void write(LogLevel, const Args&... args) {
+        (std::cout << ... << printable(args)) << "\n";
+    }
+
+private:
+    template <typename T>
+    static const T& printable(const T& value) { return value; }
+
+    static const char* printable(const LogLiteral& value) { return value.text; }
+
+    static std::string printable(const Sensitive& value) {
+        if (!LogControl::redacting()) {
+            return value.value;
+        }
+        return "<" + std::to_string(value.value.size()) + " bytes>";
+    }
+};
+
+/**
+ * Logging compiled out
+ */
+struct NullLogger {
+    using category = LoggerPolicyTag;
+    static constexpr bool enabled = false;
+
+    template <typename... Args>
+    static void write(LogLevel, const Args&...) {}
+};
@@ -0,0 +1,434 @@
+/**
+ * DaemonTask - C++20 Coroutines on the Daemon Worker
+ *
+ * Sequential protocols (handshakes, transfers, sync sessions) written
+ * as straight-line code instead of callback state machines:
+ *
+ *   DaemonTask<> sync_session(TaskScheduler& tasks, uint64_t peer) {
+ *       if (!co_await task_send(tasks, peer, kSyncChannel, request, 2s)) {
+ *           co_return;                              // no ack in time
+ *       }
+ *       auto reply = co_await task_receive(tasks, peer, kSyncChannel, 5s);
+ *       ...
+ *   }
+ *   spawn(daemon.tasks(), sync_session(daemon.tasks(), peer));
+ *
+ * Tasks run on the daemon's worker thread only, between event batches,
+ * so they may use worker-side state without locks. A task can await:
+ *   task_sleep      a delay
+ *   task_yield      the events queued ahead of it
+ *   task_send       a TaskData frame, until the peer acknowledges it
+ *   task_receive    the next TaskData frame on a channel
+ *   DaemonTask<T>   another task, for its result
+ *
+ * Coroutine frames come from a per-thread pool of size classes, and a
+ * resume is a virtual call on a wait that lives inside the frame, so a
+ * suspension allocates nothing and costs less than posting a
+ * std::function continuation. Tasks still suspended when the daemon
+ * stops are destroyed, not resumed.
+ *
+ * Optional: needs C++20 coroutines; the header is empty otherwise and
+ * the rest of the core stays C++17.
+ */
+
+#pragma once
+
+#include "task_scheduler.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#define MESHCORE_HAS_COROUTINES 1
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+
+template <typename T = void>
+class DaemonTask;
+
+// =============================================================================
+// MARK: - Frame Pool
+// =============================================================================
+
+/**
+ * Coroutine frames in 64-byte size classes, cached per thread; frames
+ * are created and freed on the worker, so its cache serves nearly all
+ * of them. Larger frames go to the heap.
+ */
+class TaskFramePool {
+public:
+    static void* allocate(size_t size) {
+        const size_t index = class_of(size);
+        if (index >= kClasses) {
+            return ::operator new(size);
+        }
+        Cache& cache = local();
+        if (Block* block = cache.free[index]) {
+            cache.free[index] = block->next;
+            cache.count[index]--;
+            return block;
+        }
+        return ::operator new((index + 1) * kGranule);
+    }
+
+    static void release(void* p, size_t size) {
+        const size_t index = class_of(size);
+        Cache& cache = local();
+        if (index >= kClasses || cache.count[index] >= kMaxCached) {
+            ::operator delete(p);
+            return;
+        }
+        Block* block = static_cast<Block*>(p);
+        block->next = cache.free[index];
+        cache.free[index] = block;
+        cache.count[index]++;
+    }
+
+private:
+    static constexpr size_t kGranule   = 64;
+    static constexpr size_t kClasses   = 16;    // Up to 1 KiB
+    static constexpr size_t kMaxCached = 64;    // Per class and thread
+
+    struct Block {
+        Block* next;
+    };
+
+    struct Cache {
+        Block* free[kClasses]  = {};
+        size_t count[kClasses] = {};
+
+        ~Cache() {
+            for (Block* head : free) {
+                while (head) {
+                    Block* next = head->next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        }
+    };
+
+    static size_t class_of(size_t size) { return (size - 1) / kGranule; }
+
+    static Cache& local() {
+        thread_local Cache cache;
+        return cache;
+    }
+};
+
+// =============================================================================
+// MARK: - Promise
+// =============================================================================
+
+namespace task_detail {
+
+/**
+ * Resumes a suspended coroutine; abandoning destroys the spawned task at
+ * the top of its chain (which destroys the awaited tasks below it)
+ */
+class CoroutineWait final : public TaskWait {
+public:
+    void bind(std::coroutine_handle<> handle, std::coroutine_handle<> root) {
+        handle_ = handle;
+        root_ = root;
+    }
+
+    void resume() override { handle_.resume(); }
+    void abandon() override { root_.destroy(); }
+
+private:
+    std::coroutine_handle<> handle_;
+    std::coroutine_handle<> root_;
+};
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;    // Awaiting task; none if spawned
+    std::coroutine_handle<> root;            // Spawned task at the top
+    CoroutineWait           start;           // First resume, when spawned
+
+    static void* operator new(size_t size) { return TaskFramePool::allocate(size); }
+    static void operator delete(void* p, size_t size) { TaskFramePool::release(p, size); }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    // Back to the awaiting task, or free the frame of a spawned one
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+            std::coroutine_handle<> next = self.promise().continuation;
+            if (next) {
+                return next;
+            }
+            self.destroy();
+            return std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    // Nothing in the core throws; an escaping exception is a bug
+    void unhandled_exception() { std::terminate(); }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    DaemonTask<T> get_return_object();
+    void return_value(T v) { value.emplace(std::move(v)); }
+    T result() { return std::move(*value); }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    DaemonTask<void> get_return_object();
+    void return_void() {}
+    void result() {}
+};
+
+/**
+ * Shared shape of the scheduler awaitables: suspend on a wait bound to
+ * this coroutine and its root
+ */
+class WaitAwaiter {
+public:
+    explicit WaitAwaiter(TaskScheduler& tasks) : tasks_(tasks) {}
+
+    bool await_ready() const noexcept { return false; }
+
+protected:
+    template <typename Promise>
+    void bind(std::coroutine_handle<Promise> self) {
+        wait_.bind(self, self.promise().root);
+    }
+
+    TaskScheduler& tasks_;
+    CoroutineWait  wait_;
+};
+
+} // namespace task_detail
+
+// =============================================================================
+// MARK: - Task
+// =============================================================================
+
+/**
+ * A lazily started coroutine: spawn() it on a scheduler, or co_await it
+ * from another task for its result
+ */
+template <typename T>
+class DaemonTask {
+public:
+    using promise_type = task_detail::Promise<T>;
+    using Handle       = std::coroutine_handle<promise_type>;
+
+    DaemonTask(DaemonTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    DaemonTask& operator=(DaemonTask&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ~DaemonTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    // Awaited from another task: runs now, resumes the caller when done
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> caller) noexcept {
+        handle_.promise().continuation = caller;
+        handle_.promise().root = caller.promise().root;
+        return handle_;
+    }
+
+    T await_resume() { return handle_.promise().result(); }
+
+private:
+    friend promise_type;
+
+    template <typename U>
+    friend bool spawn(TaskScheduler& tasks, DaemonTask<U> task);
+
+    explicit DaemonTask(Handle handle) : handle_(handle) {}
+
+    Handle handle_;
+};
+
+namespace task_detail {
+
+template <typename T>
+DaemonTask<T> Promise<T>::get_return_object() {
+    return DaemonTask<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline DaemonTask<void> Promise<void>::get_return_object() {
+    return DaemonTask<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+} // namespace task_detail
+
+/**
+ * Start a task on the worker (from any thread); it owns itself from
+ * here on and any result is discarded. False if the daemon is not
+ * running, in which case the task is destroyed unstarted.
+ */
+template <typename T>
+bool spawn(TaskScheduler& tasks, DaemonTask<T> task) {
+    auto handle = std::exchange(task.handle_, nullptr);
+    auto& promise = handle.promise();
+    promise.root = handle;
+    promise.start.bind(handle, handle);
+    if (!tasks.wake(&promise.start)) {
+        handle.destroy();
+        return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// MARK: - Awaitables
+// =============================================================================
+
+namespace task_detail {
+
+class SleepAwaiter : public WaitAwaiter {
+public:
+    SleepAwaiter(TaskScheduler& tasks, TaskScheduler::Clock::duration delay)
+        : WaitAwaiter(tasks), delay_(delay) {}
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> self) {
+        bind(self);
+        tasks_.sleep(&wait_, delay_);
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    TaskScheduler::Clock::duration delay_;
+};
+
+class YieldAwaiter : public WaitAwaiter {
+public:
+    explicit YieldAwaiter(TaskScheduler& tasks) : WaitAwaiter(tasks) {}
+
+    // Stopping: nothing will resume it, so carry on instead
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> self) {
+        bind(self);
+        return tasks_.wake(&wait_);
+    }
+
+    void await_resume() const noexcept {}
+};
+
+class SendAwaiter : public WaitAwaiter {
+public:
+    SendAwaiter(TaskScheduler& tasks, uint64_t peer_id, uint32_t channel, std::string data,
+                TaskScheduler::Clock::duration timeout)
+        : WaitAwaiter(tasks), peer_id_(peer_id), channel_(channel), data_(std::move(data)), timeout_(timeout) {}
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> self) {
+        bind(self);
+        tasks_.send(&wait_, peer_id_, channel_, data_, timeout_);
+    }
+
+    bool await_resume() const noexcept { return wait_.ok; }
+
+private:
+    uint64_t                       peer_id_;
+    uint32_t                       channel_;
+    std::string                    data_;
+    TaskScheduler::Clock::duration timeout_;
+};
+
+class ReceiveAwaiter : public WaitAwaiter {
+public:
+    ReceiveAwaiter(TaskScheduler& tasks, uint64_t peer_id, uint32_t channel,
+                   TaskScheduler::Clock::duration timeout)
+        : WaitAwaiter(tasks), peer_id_(peer_id), channel_(channel), timeout_(timeout) {}
+
+    // A buffered frame completes without suspending
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> self) {
+        bind(self);
+        return !tasks_.receive(&wait_, peer_id_, channel_, timeout_);
+    }
+
+    std::optional<std::string> await_resume() {
+        if (!wait_.ok) {
+            return std::nullopt;
+        }
+        return std::move(wait_.data);
+    }
+
+private:
+    uint64_t                       peer_id_;
+    uint32_t                       channel_;
+    TaskScheduler::Clock::duration timeout_;
+};
+
+template <typename Rep, typename Period>
+TaskScheduler::Clock::duration to_clock(std::chrono::duration<Rep, Period> d) {
+    return std::chrono::duration_cast<TaskScheduler::Clock::duration>(d);
+}
+
+} // namespace task_detail
+
+/**
+ * Resume after a delay
+ */
+template <typename Rep, typename Period>
+task_detail::SleepAwaiter task_sleep(TaskScheduler& tasks, std::chrono::duration<Rep, Period> delay) {
+    return task_detail::SleepAwaiter(tasks, task_detail::to_clock(delay));
+}
+
+/**
+ * Let the events queued so far run first
+ */
+inline task_detail::YieldAwaiter task_yield(TaskScheduler& tasks) {
+    return task_detail::YieldAwaiter(tasks);
+}
+
+/**
+ * Send data on a channel; true once the peer acknowledged it, false on
+ * timeout or disconnect (zero timeout: wait until disconnect)
+ */
+template <typename Rep, typename Period>
+task_detail::SendAwaiter task_send(TaskScheduler& tasks, uint64_t peer_id, uint32_t channel,
+                                   std::string data, std::chrono::duration<Rep, Period> timeout) {
+    return task_detail::SendAwaiter(tasks, peer_id, channel, std::move(data), task_detail::to_clock(timeout));
+}
+
+/**
+ * Next frame on a channel; nothing on timeout, disconnect, or if
+ * another task is already receiving on it (zero timeout: no limit)
+ */
+template <typename Rep = int64_t, typename Period = std::milli>
+task_detail::ReceiveAwaiter task_receive(TaskScheduler& tasks, uint64_t peer_id, uint32_t channel,
+                                         std::chrono::duration<Rep, Period> timeout = {}) {
+    return task_detail::ReceiveAwaiter(tasks, peer_id, channel, task_detail::to_clock(timeout));
+}
+
+#endif // __cpp_impl_coroutine
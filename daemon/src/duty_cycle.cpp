@@ -0,0 +1,180 @@
+/**
+ * DutyCycleScheduler Implementation
+ */
+
+#include "duty_cycle.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Never noted: the first update counts as activity, so a fresh core
+// starts out scanning
+constexpr int64_t kNever = std::numeric_limits<int64_t>::min();
+
+// Doubling past this is past any sane maximum
+constexpr uint32_t kMaxLevel = 24;
+
+uint32_t doubled(uint32_t base, uint32_t level, uint32_t limit) {
+    const uint64_t value = uint64_t(base) << std::min(level, kMaxLevel);
+    return uint32_t(std::min<uint64_t>(value, limit));
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+DutyCycleScheduler::DutyCycleScheduler()
+    : DutyCycleScheduler(DutyCycleConfig())
+{
+}
+
+DutyCycleScheduler::DutyCycleScheduler(const DutyCycleConfig& config)
+    : config_(config)
+    , current_{0, 0, 0, 0}
+    , level_(0)
+    , level_since_ms_(0)
+    , last_activity_ms_(kNever)
+    , backed_off_(0)
+    , outbox_(0)
+    , traffic_(0)
+    , churn_(0)
+    , changes_(0)
+    , backoffs_(0)
+    , wakeups_(0)
+{
+}
+
+void DutyCycleScheduler::set_config(const DutyCycleConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+DutyCycleConfig DutyCycleScheduler::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+// =============================================================================
+// MARK: - Inputs
+// =============================================================================
+
+bool DutyCycleScheduler::note_traffic(int64_t now_ms) {
+    traffic_.fetch_add(1, std::memory_order_relaxed);
+    return note(now_ms);
+}
+
+bool DutyCycleScheduler::note_churn(size_t changes, int64_t now_ms) {
+    if (changes == 0) {
+        return false;
+    }
+    churn_.fetch_add(changes, std::memory_order_relaxed);
+    return note(now_ms);
+}
+
+bool DutyCycleScheduler::set_outbox(size_t pending) {
+    const uint64_t previous = outbox_.exchange(pending, std::memory_order_relaxed);
+    return (previous == 0) != (pending == 0);
+}
+
+bool DutyCycleScheduler::note(int64_t now_ms) {
+    last_activity_ms_.store(now_ms, std::memory_order_relaxed);
+    return backed_off_.load(std::memory_order_relaxed) != 0;
+}
+
+// =============================================================================
+// MARK: - Scheduling
+// =============================================================================
+
+bool DutyCycleScheduler::update(int64_t now_ms, DutySchedule& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int64_t last = last_activity_ms_.load(std::memory_order_relaxed);
+    if (last == kNever) {
+        last = now_ms;
+        last_activity_ms_.store(now_ms, std::memory_order_relaxed);
+    }
+
+    // Waiting messages hold the interval at the cap
+    const bool capped = outbox_.load(std::memory_order_relaxed) != 0;
+    auto allowed = [&](const DutySchedule& schedule) {
+        return !capped || schedule.scan_interval_ms <= config_.outbox_max_interval_ms;
+    };
+
+    if (now_ms - last < int64_t(config_.quiet_after_ms)) {
+        if (level_ != 0) {
+            wakeups_++;
+        }
+        level_ = 0;
+        level_since_ms_ = now_ms;
+    } else {
+        // One more step each time a whole interval passes quietly
+        const DutySchedule now_at = at_level(level_);
+        const DutySchedule next = at_level(level_ + 1);
+        if (now_ms - level_since_ms_ >= int64_t(now_at.scan_interval_ms) && next != now_at && allowed(next)) {
+            level_++;
+            level_since_ms_ = now_ms;
+            backoffs_++;
+        }
+    }
+
+    while (level_ > 0 && !allowed(at_level(level_))) {
+        level_--;
+    }
+    backed_off_.store(level_, std::memory_order_relaxed);
+
+    const DutySchedule schedule = at_level(level_);
+    if (schedule == current_) {
+        return false;
+    }
+    current_ = schedule;
+    changes_++;
+    out = schedule;
+    return true;
+}
+
+DutySchedule DutyCycleScheduler::schedule() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_;
+}
+
+DutyCycleStats DutyCycleScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return DutyCycleStats{
+        traffic_.load(std::memory_order_relaxed),
+        churn_.load(std::memory_order_relaxed),
+        outbox_.load(std::memory_order_relaxed),
+        changes_,
+        backoffs_,
+        wakeups_
+    };
+}
+
+// =============================================================================
+// MARK: - Internals
+// =============================================================================
+
+DutySchedule DutyCycleScheduler::at_level(uint32_t level) const {
+    const uint32_t max_scan = std::max(config_.min_scan_interval_ms, config_.max_scan_interval_ms);
+    const uint32_t max_advertise = std::max(config_.min_advertise_interval_ms, config_.max_advertise_interval_ms);
+
+    // Clamp to the first level that reaches both maxima, so a level
+    // always names a distinct schedule
+    uint32_t top = 0;
+    while (top < kMaxLevel && (doubled(config_.min_scan_interval_ms, top, max_scan) < max_scan ||
+                               doubled(config_.min_advertise_interval_ms, top, max_advertise) < max_advertise)) {
+        top++;
+    }
+    level = std::min(level, top);
+
+    DutySchedule schedule;
+    schedule.level = level;
+    schedule.scan_interval_ms = doubled(config_.min_scan_interval_ms, level, max_scan);
+    schedule.scan_window_ms = level == 0 ? schedule.scan_interval_ms
+                                         : std::min(config_.scan_window_ms, schedule.scan_interval_ms);
+    schedule.advertise_interval_ms = doubled(config_.min_advertise_interval_ms, level, max_advertise);
+    return schedule;
+}
@@ -0,0 +1,120 @@
+/**
+ * DutyCycleScheduler - Adaptive Scan/Advertise Duty Cycle
+ *
+ * Scanning and advertising are the radio's biggest steady drain. The
+ * scheduler turns what the core sees into a schedule for the platform:
+ *
+ *   Busy     traffic or neighbour churn within quiet_after_ms: scan
+ *            continuously, advertise at min_advertise_interval_ms
+ *   Backoff  each quiet scan interval doubles the interval (and the
+ *            advertising interval) up to the maxima; each scan lasts
+ *            scan_window_ms
+ *
+ * Messages waiting in the outbox cap the backoff at
+ * outbox_max_interval_ms, so a route for them is still looked for.
+ * Any activity drops straight back to Busy.
+ *
+ * Activity is noted lock-free on the hot path; update() is called
+ * periodically (and when a note asks for it) and reports a new
+ * schedule only when it differs from the last one.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+struct DutyCycleConfig {
+    uint32_t scan_window_ms            = 2000;     // One scan once backed off
+    uint32_t min_scan_interval_ms      = 2000;     // Busy: window == interval, scanning never stops
+    uint32_t max_scan_interval_ms      = 120000;
+    uint32_t min_advertise_interval_ms = 100;
+    uint32_t max_advertise_interval_ms = 2000;
+    uint32_t quiet_after_ms            = 15000;    // Without activity before backing off
+    uint32_t outbox_max_interval_ms    = 10000;    // Backoff cap while messages wait
+};
+
+/**
+ * What the platform should run
+ */
+struct DutySchedule {
+    uint32_t scan_window_ms;
+    uint32_t scan_interval_ms;
+    uint32_t advertise_interval_ms;
+    uint32_t level;                 // 0 = busy, +1 per backoff step
+
+    bool operator==(const DutySchedule& other) const {
+        return scan_window_ms == other.scan_window_ms && scan_interval_ms == other.scan_interval_ms &&
+               advertise_interval_ms == other.advertise_interval_ms && level == other.level;
+    }
+    bool operator!=(const DutySchedule& other) const { return !(*this == other); }
+};
+
+/**
+ * Duty cycle counters
+ */
+struct DutyCycleStats {
+    uint64_t traffic;          // Frames noted
+    uint64_t churn;            // Neighbour changes noted
+    uint64_t outbox;           // Messages waiting, as last reported
+    uint64_t changes;          // Schedules reported
+    uint64_t backoffs;         // Backoff steps taken
+    uint64_t wakeups;          // Returns to Busy from a backoff
+};
+
+class DutyCycleScheduler {
+public:
+    DutyCycleScheduler();
+    explicit DutyCycleScheduler(const DutyCycleConfig& config);
+
+    // Non-copyable
+    DutyCycleScheduler(const DutyCycleScheduler&) = delete;
+    DutyCycleScheduler& operator=(const DutyCycleScheduler&) = delete;
+
+    // Takes effect at the next update()
+    void set_config(const DutyCycleConfig& config);
+    DutyCycleConfig config() const;
+
+    // Activity (lock-free); true if backed off, so update() should run now
+    bool note_traffic(int64_t now_ms);
+    bool note_churn(size_t changes, int64_t now_ms);
+
+    // Messages waiting for a route; true if that lifts or sets the cap
+    bool set_outbox(size_t pending);
+
+    // Re-evaluate; true (and `out`) when the schedule changed
+    bool update(int64_t now_ms, DutySchedule& out);
+
+    // Last schedule reported (all zero before the first update)
+    DutySchedule schedule() const;
+
+    DutyCycleStats stats() const;
+
+private:
+    // Schedule at `level` (lock held)
+    DutySchedule at_level(uint32_t level) const;
+
+    bool note(int64_t now_ms);
+
+    mutable std::mutex mutex_;
+    DutyCycleConfig config_;
+    DutySchedule current_;
+    uint32_t level_;
+    int64_t  level_since_ms_;
+
+    // Written on the hot path without the lock
+    std::atomic<int64_t>  last_activity_ms_;
+    std::atomic<uint32_t> backed_off_;
+    std::atomic<uint64_t> outbox_;
+    std::atomic<uint64_t> traffic_;
+    std::atomic<uint64_t> churn_;
+
+    uint64_t changes_;
+    uint64_t backoffs_;
+    uint64_t wakeups_;
+};
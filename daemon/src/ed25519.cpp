@@ -0,0 +1,583 @@
+/**
+ * Ed25519 Implementation (RFC 8032)
+ *
+ * Points use extended twisted Edwards coordinates (X:Y:Z:T); table
+ * entries are kept in "cached" form (Y+X, Y-X, Z, 2dT) so each addition
+ * costs eight multiplications. Scalars modulo L are reduced a byte at a
+ * time, which is plenty fast next to the curve arithmetic.
+ */
+
+#include "ed25519.h"
+#include "field25519.h"
+#include "sha512.h"
+#include "random.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using u128 = unsigned __int128;
+
+// =============================================================================
+// MARK: - Scalars (mod L)
+// =============================================================================
+
+// L = 2^252 + 27742317777372353535851937790883648493
+const uint64_t kL[4] = {
+    0x5812631a5cf5d3edULL, 0x14def9dea2f79cd6ULL, 0x0000000000000000ULL, 0x1000000000000000ULL
+};
+
+struct Scalar {
+    uint64_t v[4];
+};
+
+// Reduce a little-endian integer of up to 64 bytes (constant time)
+Scalar sc_reduce(const uint8_t* in, size_t len) {
+    uint64_t r[5] = { 0, 0, 0, 0, 0 };
+
+    for (size_t i = len; i-- > 0;) {
+        r[4] = (r[4] << 8) | (r[3] >> 56);
+        r[3] = (r[3] << 8) | (r[2] >> 56);
+        r[2] = (r[2] << 8) | (r[1] >> 56);
+        r[1] = (r[1] << 8) | (r[0] >> 56);
+        r[0] = (r[0] << 8) | in[i];
+
+        // r < 2^261; q = r >> 252 is floor(r / L) or one more
+        const uint64_t q = (r[3] >> 60) | (r[4] << 4);
+
+        uint64_t ql[5];
+        u128 c = 0;
+        for (int j = 0; j < 4; ++j) {
+            c += static_cast<u128>(q) * kL[j];
+            ql[j] = static_cast<uint64_t>(c);
+            c >>= 64;
+        }
+        ql[4] = static_cast<uint64_t>(c);
+
+        uint64_t borrow = 0;
+        for (int j = 0; j < 5; ++j) {
+            const u128 d = static_cast<u128>(r[j]) - ql[j] - borrow;
+            r[j] = static_cast<uint64_t>(d);
+            borrow = static_cast<uint64_t>(d >> 64) & 1;
+        }
+
+        // Went negative: add L back (masked, no branch)
+        const uint64_t mask = 0 - borrow;
+        c = 0;
+        for (int j = 0; j < 4; ++j) {
+            c += static_cast<u128>(r[j]) + (kL[j] & mask);
+            r[j] = static_cast<uint64_t>(c);
+            c >>= 64;
+        }
+        r[4] += static_cast<uint64_t>(c);
+    }
+
+    return Scalar{{ r[0], r[1], r[2], r[3] }};
+}
+
+Scalar sc_from_bytes(const uint8_t s[32]) {
+    Scalar out;
+    for (int i = 0; i < 4; ++i) {
+        out.v[i] = field25519::load_le64(s + 8 * i);
+    }
+    return out;
+}
+
+void sc_to_bytes(uint8_t s[32], const Scalar& a) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            s[8 * i + j] = static_cast<uint8_t>(a.v[i] >> (8 * j));
+        }
+    }
+}
+
+// a * b + c mod L (any a, b below 2^256; c below L)
+Scalar sc_mul_add(const Scalar& a, const Scalar& b, const Scalar& c) {
+    uint64_t w[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    for (int i = 0; i < 4; ++i) {
+        u128 carry = 0;
+        for (int j = 0; j < 4; ++j) {
+            carry += static_cast<u128>(a.v[i]) * b.v[j] + w[i + j];
+            w[i + j] = static_cast<uint64_t>(carry);
+            carry >>= 64;
+        }
+        w[i + 4] = static_cast<uint64_t>(carry);
+    }
+
+    u128 carry = 0;
+    for (int i = 0; i < 8; ++i) {
+        carry += static_cast<u128>(w[i]) + (i < 4 ? c.v[i] : 0);
+        w[i] = static_cast<uint64_t>(carry);
+        carry >>= 64;
+    }
+
+    uint8_t bytes[64];
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            bytes[8 * i + j] = static_cast<uint8_t>(w[i] >> (8 * j));
+        }
+    }
+    return sc_reduce(bytes, sizeof(bytes));
+}
+
+bool sc_is_canonical(const uint8_t s[32]) {
+    const Scalar a = sc_from_bytes(s);
+    for (int i = 3; i >= 0; --i) {
+        if (a.v[i] != kL[i]) {
+            return a.v[i] < kL[i];
+        }
+    }
+    return false;
+}
+
+Scalar sc_hash(const uint8_t* a, size_t a_len, const uint8_t* b, size_t b_len,
+               const uint8_t* m, size_t m_len) {
+    Sha512 h;
+    h.update(a, a_len);
+    h.update(b, b_len);
+    h.update(m, m_len);
+    uint8_t digest[64];
+    h.final(digest);
+    return sc_reduce(digest, sizeof(digest));
+}
+
+/**
+ * Width-5 NAF: odd digits in [-15, 15], at most one non-zero in any
+ * five consecutive positions (scalar must be below 2^255)
+ */
+void sc_slide(int8_t r[256], const uint8_t a[32]) {
+    for (int i = 0; i < 256; ++i) {
+        r[i] = static_cast<int8_t>(1 & (a[i >> 3] >> (i & 7)));
+    }
+
+    for (int i = 0; i < 256; ++i) {
+        if (!r[i]) {
+            continue;
+        }
+        for (int b = 1; b <= 6 && i + b < 256; ++b) {
+            if (!r[i + b]) {
+                continue;
+            }
+            if (r[i] + (r[i + b] << b) <= 15) {
+                r[i] = static_cast<int8_t>(r[i] + (r[i + b] << b));
+                r[i + b] = 0;
+            } else if (r[i] - (r[i + b] << b) >= -15) {
+                r[i] = static_cast<int8_t>(r[i] - (r[i + b] << b));
+                for (int k = i + b; k < 256; ++k) {
+                    if (!r[k]) {
+                        r[k] = 1;
+                        break;
+                    }
+                    r[k] = 0;
+                }
+            } else {
+                break;
+            }
+        }
+    }
+}
+
+// =============================================================================
+// MARK: - Points
+// =============================================================================
+
+struct Ge {
+    Fe X, Y, Z, T;
+};
+
+struct GeCached {
+    Fe YplusX, YminusX, Z, T2d;
+};
+
+using GeTable = GeCached[8];    // P, 3P, 5P, ..., 15P
+
+Fe fe_small(uint32_t k) {
+    return Fe{{ k, 0, 0, 0, 0 }};
+}
+
+// base^e for a little-endian 255-bit exponent (constants only)
+Fe fe_pow(const Fe& base, const uint8_t e[32]) {
+    Fe r = fe_one();
+    for (int i = 254; i >= 0; --i) {
+        r = fe_sq(r);
+        if ((e[i >> 3] >> (i & 7)) & 1) {
+            r = fe_mul(r, base);
+        }
+    }
+    return r;
+}
+
+Fe compute_d() {
+    return fe_mul(fe_neg(fe_small(121665)), fe_invert(fe_small(121666)));
+}
+
+Fe compute_sqrtm1() {
+    // 2^((p - 1) / 4), with (p - 1) / 4 = 2^253 - 5
+    uint8_t e[32];
+    std::memset(e, 0xFF, sizeof(e));
+    e[0] = 0xFB;
+    e[31] = 0x1F;
+    return fe_pow(fe_small(2), e);
+}
+
+// Curve constants, derived once at start-up rather than transcribed
+const Fe kD      = compute_d();
+const Fe kD2     = fe_add(kD, kD);
+const Fe kSqrtM1 = compute_sqrtm1();
+
+Ge ge_identity() {
+    return Ge{ fe_zero(), fe_one(), fe_one(), fe_zero() };
+}
+
+Ge ge_neg(const Ge& p) {
+    return Ge{ fe_neg(p.X), p.Y, p.Z, fe_neg(p.T) };
+}
+
+GeCached ge_cache(const Ge& p) {
+    return GeCached{ fe_add(p.Y, p.X), fe_sub(p.Y, p.X), p.Z, fe_mul(p.T, kD2) };
+}
+
+Ge ge_add(const Ge& p, const GeCached& q) {
+    const Fe a = fe_mul(fe_sub(p.Y, p.X), q.YminusX);
+    const Fe b = fe_mul(fe_add(p.Y, p.X), q.YplusX);
+    const Fe c = fe_mul(p.T, q.T2d);
+    const Fe zz = fe_mul(p.Z, q.Z);
+    const Fe d = fe_add(zz, zz);
+    const Fe e = fe_sub(b, a);
+    const Fe f = fe_sub(d, c);
+    const Fe g = fe_add(d, c);
+    const Fe h = fe_add(b, a);
+    return Ge{ fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h) };
+}
+
+Ge ge_sub(const Ge& p, const GeCached& q) {
+    const Fe a = fe_mul(fe_sub(p.Y, p.X), q.YplusX);
+    const Fe b = fe_mul(fe_add(p.Y, p.X), q.YminusX);
+    const Fe c = fe_mul(p.T, q.T2d);
+    const Fe zz = fe_mul(p.Z, q.Z);
+    const Fe d = fe_add(zz, zz);
+    const Fe e = fe_sub(b, a);
+    const Fe f = fe_add(d, c);
+    const Fe g = fe_sub(d, c);
+    const Fe h = fe_add(b, a);
+    return Ge{ fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h) };
+}
+
+Ge ge_dbl(const Ge& p) {
+    const Fe a = fe_sq(p.X);
+    const Fe b = fe_sq(p.Y);
+    const Fe zz = fe_sq(p.Z);
+    const Fe c = fe_add(zz, zz);
+    const Fe h = fe_add(a, b);
+    const Fe e = fe_sub(h, fe_sq(fe_add(p.X, p.Y)));
+    const Fe g = fe_sub(a, b);
+    const Fe f = fe_add(c, g);
+    return Ge{ fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h) };
+}
+
+bool ge_decode(Ge& p, const uint8_t s[32]) {
+    const Fe y = fe_from_bytes(s);
+
+    // Reject non-canonical y (y >= p)
+    uint8_t check[32];
+    fe_to_bytes(check, y);
+    if (std::memcmp(check, s, 31) != 0 || check[31] != (s[31] & 0x7F)) {
+        return false;
+    }
+
+    // x^2 = (y^2 - 1) / (d y^2 + 1)
+    const Fe y2 = fe_sq(y);
+    const Fe u = fe_sub(y2, fe_one());
+    const Fe v = fe_add(fe_mul(kD, y2), fe_one());
+    const Fe v3 = fe_mul(fe_sq(v), v);
+    const Fe uv7 = fe_mul(fe_mul(u, fe_sq(v3)), v);
+    Fe x = fe_mul(fe_mul(u, v3), fe_pow22523(uv7));
+
+    const Fe vx2 = fe_mul(v, fe_sq(x));
+    if (!fe_equal(vx2, u)) {
+        if (!fe_equal(vx2, fe_neg(u))) {
+            return false;
+        }
+        x = fe_mul(x, kSqrtM1);
+    }
+
+    const bool sign = (s[31] >> 7) != 0;
+    if (fe_is_zero(x) && sign) {
+        return false;
+    }
+    if (fe_is_negative(x) != sign) {
+        x = fe_neg(x);
+    }
+
+    p = Ge{ x, y, fe_one(), fe_mul(x, y) };
+    return true;
+}
+
+void ge_encode(uint8_t s[32], const Ge& p) {
+    const Fe z_inv = fe_invert(p.Z);
+    const Fe x = fe_mul(p.X, z_inv);
+    const Fe y = fe_mul(p.Y, z_inv);
+    fe_to_bytes(s, y);
+    s[31] ^= static_cast<uint8_t>(fe_is_negative(x) << 7);
+}
+
+void ge_build_table(GeCached* table, const Ge& p) {
+    const GeCached p2 = ge_cache(ge_dbl(p));
+    Ge odd = p;
+    table[0] = ge_cache(p);
+    for (int i = 1; i < 8; ++i) {
+        odd = ge_add(odd, p2);
+        table[i] = ge_cache(odd);
+    }
+}
+
+// 8P == identity (the cofactored verification equation)
+bool ge_is_small_order(Ge p) {
+    p = ge_dbl(ge_dbl(ge_dbl(p)));
+    return fe_is_zero(p.X) && fe_equal(p.Y, p.Z);
+}
+
+Ge compute_base() {
+    // y = 4/5, x even
+    uint8_t s[32];
+    fe_to_bytes(s, fe_mul(fe_small(4), fe_invert(fe_small(5))));
+    Ge base;
+    ge_decode(base, s);
+    return base;
+}
+
+struct BaseTable {
+    GeTable table;
+};
+
+BaseTable compute_base_table(const Ge& base) {
+    BaseTable t;
+    ge_build_table(t.table, base);
+    return t;
+}
+
+const Ge        kBase      = compute_base();
+const BaseTable kBaseTable = compute_base_table(kBase);
+
+// Constant time: one doubling and one (conditionally kept) addition per bit
+Ge ge_scalarmult_base(const uint8_t k[32]) {
+    const GeCached base = ge_cache(kBase);
+    Ge r = ge_identity();
+
+    for (int i = 255; i >= 0; --i) {
+        r = ge_dbl(r);
+        Ge sum = ge_add(r, base);
+        const uint64_t bit = (k[i >> 3] >> (i & 7)) & 1;
+        fe_cswap(r.X, sum.X, bit);
+        fe_cswap(r.Y, sum.Y, bit);
+        fe_cswap(r.Z, sum.Z, bit);
+        fe_cswap(r.T, sum.T, bit);
+    }
+    return r;
+}
+
+/**
+ * Straus: sum of naf[j] * P_j sharing one doubling chain (variable time)
+ */
+Ge ge_multiscalar(const int8_t* const* nafs, const GeCached* const* tables, size_t n) {
+    int top = 255;
+    for (; top >= 0; --top) {
+        bool any = false;
+        for (size_t j = 0; j < n && !any; ++j) {
+            any = nafs[j][top] != 0;
+        }
+        if (any) {
+            break;
+        }
+    }
+
+    Ge r = ge_identity();
+    for (int i = top; i >= 0; --i) {
+        r = ge_dbl(r);
+        for (size_t j = 0; j < n; ++j) {
+            const int8_t digit = nafs[j][i];
+            if (digit > 0) {
+                r = ge_add(r, tables[j][digit / 2]);
+            } else if (digit < 0) {
+                r = ge_sub(r, tables[j][-digit / 2]);
+            }
+        }
+    }
+    return r;
+}
+
+// =============================================================================
+// MARK: - Verification
+// =============================================================================
+
+struct Prepared {
+    Ge     A;
+    Ge     R;
+    Scalar s;
+    Scalar k;
+};
+
+bool prepare(Prepared& p, const Ed25519BatchItem& item) {
+    if (!sc_is_canonical(item.signature + 32)) {
+        return false;
+    }
+    if (!ge_decode(p.A, item.public_key) || !ge_decode(p.R, item.signature)) {
+        return false;
+    }
+    p.s = sc_from_bytes(item.signature + 32);
+    p.k = sc_hash(item.signature, 32, item.public_key, 32, item.message, item.length);
+    return true;
+}
+
+// 8(sB - kA - R) == O
+bool verify_one(const Prepared& p) {
+    uint8_t bytes[32];
+    int8_t naf_s[256];
+    int8_t naf_k[256];
+    sc_to_bytes(bytes, p.s);
+    sc_slide(naf_s, bytes);
+    sc_to_bytes(bytes, p.k);
+    sc_slide(naf_k, bytes);
+
+    GeTable neg_a;
+    ge_build_table(neg_a, ge_neg(p.A));
+
+    const int8_t* nafs[2] = { naf_s, naf_k };
+    const GeCached* tables[2] = { kBaseTable.table, neg_a };
+    return ge_is_small_order(ge_sub(ge_multiscalar(nafs, tables, 2), ge_cache(p.R)));
+}
+
+// 8((sum z_i s_i) B - sum z_i R_i - sum (z_i k_i) A_i) == O
+bool verify_combined(const std::vector<Prepared>& prep, const size_t* idx, size_t n) {
+    // 128-bit coefficients; they only need to be unpredictable to
+    // whoever crafted the signatures
+    std::vector<uint8_t> z_bytes(16 * n);
+    random_bytes(z_bytes.data(), z_bytes.size());
+
+    std::vector<int8_t> nafs(256 * (2 * n + 1));
+    std::vector<GeCached> tables(8 * 2 * n);
+    std::vector<const int8_t*> naf_ptrs(2 * n + 1);
+    std::vector<const GeCached*> table_ptrs(2 * n + 1);
+
+    Scalar sum = {{ 0, 0, 0, 0 }};
+    const Scalar zero = {{ 0, 0, 0, 0 }};
+    uint8_t bytes[32];
+
+    for (size_t i = 0; i < n; ++i) {
+        const Prepared& p = prep[idx[i]];
+
+        std::memset(bytes, 0, sizeof(bytes));
+        std::memcpy(bytes, &z_bytes[16 * i], 16);
+        const Scalar z = sc_from_bytes(bytes);
+
+        sum = sc_mul_add(z, p.s, sum);
+
+        int8_t* naf_r = &nafs[256 * (2 * i)];
+        int8_t* naf_a = &nafs[256 * (2 * i + 1)];
+        sc_slide(naf_r, bytes);
+        sc_to_bytes(bytes, sc_mul_add(z, p.k, zero));
+        sc_slide(naf_a, bytes);
+
+        GeCached* table_r = &tables[8 * (2 * i)];
+        GeCached* table_a = &tables[8 * (2 * i + 1)];
+        ge_build_table(table_r, ge_neg(p.R));
+        ge_build_table(table_a, ge_neg(p.A));
+
+        naf_ptrs[2 * i] = naf_r;
+        naf_ptrs[2 * i + 1] = naf_a;
+        table_ptrs[2 * i] = table_r;
+        table_ptrs[2 * i + 1] = table_a;
+    }
+
+    int8_t* naf_base = &nafs[256 * (2 * n)];
+    sc_to_bytes(bytes, sum);
+    sc_slide(naf_base, bytes);
+    naf_ptrs[2 * n] = naf_base;
+    table_ptrs[2 * n] = kBaseTable.table;
+
+    return ge_is_small_order(ge_multiscalar(naf_ptrs.data(), table_ptrs.data(), 2 * n + 1));
+}
+
+// Check a group at once; on failure, bisect to isolate the bad ones
+void verify_group(const std::vector<Prepared>& prep, const size_t* idx, size_t n, bool* valid) {
+    if (n == 1) {
+        valid[idx[0]] = verify_one(prep[idx[0]]);
+        return;
+    }
+
+    if (verify_combined(prep, idx, n)) {
+        for (size_t i = 0; i < n; ++i) {
+            valid[idx[i]] = true;
+        }
+        return;
+    }
+
+    verify_group(prep, idx, n / 2, valid);
+    verify_group(prep, idx + n / 2, n - n / 2, valid);
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Public API
+// =============================================================================
+
+void ed25519_public_key(const uint8_t seed[32], uint8_t public_key[32]) {
+    Sha512Digest h = Sha512::hash(seed, 32);
+    h[0] &= 248;
+    h[31] &= 127;
+    h[31] |= 64;
+
+    ge_encode(public_key, ge_scalarmult_base(h.data()));
+}
+
+void ed25519_sign(const uint8_t seed[32], const uint8_t public_key[32],
+                  const uint8_t* message, size_t len, uint8_t signature[64]) {
+    Sha512Digest h = Sha512::hash(seed, 32);
+    h[0] &= 248;
+    h[31] &= 127;
+    h[31] |= 64;
+    const Scalar a = sc_from_bytes(h.data());
+
+    // Deterministic nonce r = H(prefix || M)
+    const Scalar r = sc_hash(h.data() + 32, 32, nullptr, 0, message, len);
+    uint8_t r_bytes[32];
+    sc_to_bytes(r_bytes, r);
+    ge_encode(signature, ge_scalarmult_base(r_bytes));
+
+    // S = r + H(R || A || M) a
+    const Scalar k = sc_hash(signature, 32, public_key, 32, message, len);
+    sc_to_bytes(signature + 32, sc_mul_add(k, a, r));
+}
+
+bool ed25519_verify(const uint8_t public_key[32], const uint8_t* message, size_t len,
+                    const uint8_t signature[64]) {
+    Prepared p;
+    const Ed25519BatchItem item = { public_key, message, len, signature };
+    return prepare(p, item) && verify_one(p);
+}
+
+bool ed25519_verify_batch(const Ed25519BatchItem* items, size_t count, bool* valid) {
+    std::vector<Prepared> prep(count);
+    std::vector<size_t> idx;
+    idx.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        valid[i] = false;
+        if (prepare(prep[i], items[i])) {
+            idx.push_back(i);
+        }
+    }
+
+    if (!idx.empty()) {
+        verify_group(prep, idx.data(), idx.size(), valid);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!valid[i]) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,233 @@
+/**
+ * Field25519 - Arithmetic modulo 2^255 - 19
+ *
+ * Shared by Ed25519 (signatures) and X25519 (key agreement). Elements
+ * are five 51-bit limbs multiplied through 128-bit intermediates.
+ * Every operation returns limbs below 2^52 and none of them branch on
+ * secret data, so they are safe to use for signing and key agreement.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+struct Fe {
+    uint64_t v[5];
+};
+
+namespace field25519 {
+
+constexpr uint64_t kMask51 = (uint64_t(1) << 51) - 1;
+
+using u128 = unsigned __int128;
+
+inline uint64_t load_le64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+inline void carry(Fe& h) {
+    uint64_t c;
+    c = h.v[0] >> 51; h.v[0] &= kMask51; h.v[1] += c;
+    c = h.v[1] >> 51; h.v[1] &= kMask51; h.v[2] += c;
+    c = h.v[2] >> 51; h.v[2] &= kMask51; h.v[3] += c;
+    c = h.v[3] >> 51; h.v[3] &= kMask51; h.v[4] += c;
+    c = h.v[4] >> 51; h.v[4] &= kMask51; h.v[0] += 19 * c;
+}
+
+inline Fe carry_wide(const u128 r[5]) {
+    Fe h;
+    u128 c;
+    u128 t0 = r[0], t1 = r[1], t2 = r[2], t3 = r[3], t4 = r[4];
+    c = t0 >> 51; t1 += c; h.v[0] = static_cast<uint64_t>(t0) & kMask51;
+    c = t1 >> 51; t2 += c; h.v[1] = static_cast<uint64_t>(t1) & kMask51;
+    c = t2 >> 51; t3 += c; h.v[2] = static_cast<uint64_t>(t2) & kMask51;
+    c = t3 >> 51; t4 += c; h.v[3] = static_cast<uint64_t>(t3) & kMask51;
+    c = t4 >> 51;          h.v[4] = static_cast<uint64_t>(t4) & kMask51;
+    const u128 t5 = h.v[0] + c * 19;
+    h.v[0] = static_cast<uint64_t>(t5) & kMask51;
+    h.v[1] += static_cast<uint64_t>(t5 >> 51);
+    return h;
+}
+
+} // namespace field25519
+
+inline Fe fe_zero() {
+    return Fe{{0, 0, 0, 0, 0}};
+}
+
+inline Fe fe_one() {
+    return Fe{{1, 0, 0, 0, 0}};
+}
+
+inline Fe fe_add(const Fe& a, const Fe& b) {
+    Fe h;
+    for (int i = 0; i < 5; ++i) {
+        h.v[i] = a.v[i] + b.v[i];
+    }
+    field25519::carry(h);
+    return h;
+}
+
+inline Fe fe_sub(const Fe& a, const Fe& b) {
+    // a + 4p - b stays positive for any inputs below 2^53
+    Fe h;
+    h.v[0] = a.v[0] + 0x1FFFFFFFFFFFB4ULL - b.v[0];
+    for (int i = 1; i < 5; ++i) {
+        h.v[i] = a.v[i] + 0x1FFFFFFFFFFFFCULL - b.v[i];
+    }
+    field25519::carry(h);
+    return h;
+}
+
+inline Fe fe_neg(const Fe& a) {
+    return fe_sub(fe_zero(), a);
+}
+
+inline Fe fe_mul(const Fe& a, const Fe& b) {
+    using field25519::u128;
+    const uint64_t b1 = b.v[1] * 19, b2 = b.v[2] * 19, b3 = b.v[3] * 19, b4 = b.v[4] * 19;
+    u128 r[5];
+    r[0] = (u128)a.v[0] * b.v[0] + (u128)a.v[1] * b4 + (u128)a.v[2] * b3 + (u128)a.v[3] * b2 + (u128)a.v[4] * b1;
+    r[1] = (u128)a.v[0] * b.v[1] + (u128)a.v[1] * b.v[0] + (u128)a.v[2] * b4 + (u128)a.v[3] * b3 + (u128)a.v[4] * b2;
+    r[2] = (u128)a.v[0] * b.v[2] + (u128)a.v[1] * b.v[1] + (u128)a.v[2] * b.v[0] + (u128)a.v[3] * b4 + (u128)a.v[4] * b3;
+    r[3] = (u128)a.v[0] * b.v[3] + (u128)a.v[1] * b.v[2] + (u128)a.v[2] * b.v[1] + (u128)a.v[3] * b.v[0] + (u128)a.v[4] * b4;
+    r[4] = (u128)a.v[0] * b.v[4] + (u128)a.v[1] * b.v[3] + (u128)a.v[2] * b.v[2] + (u128)a.v[3] * b.v[1] + (u128)a.v[4] * b.v[0];
+    return field25519::carry_wide(r);
+}
+
+inline Fe fe_sq(const Fe& a) {
+    using field25519::u128;
+    const uint64_t d0 = a.v[0] * 2, d1 = a.v[1] * 2;
+    const uint64_t a3_19 = a.v[3] * 19, a4_19 = a.v[4] * 19;
+    u128 r[5];
+    r[0] = (u128)a.v[0] * a.v[0] + (u128)(2 * a.v[1]) * a4_19 + (u128)(2 * a.v[2]) * a3_19;
+    r[1] = (u128)d0 * a.v[1] + (u128)(2 * a.v[2]) * a4_19 + (u128)a.v[3] * a3_19;
+    r[2] = (u128)d0 * a.v[2] + (u128)a.v[1] * a.v[1] + (u128)(2 * a.v[3]) * a4_19;
+    r[3] = (u128)d0 * a.v[3] + (u128)d1 * a.v[2] + (u128)a.v[4] * a4_19;
+    r[4] = (u128)d0 * a.v[4] + (u128)d1 * a.v[3] + (u128)a.v[2] * a.v[2];
+    return field25519::carry_wide(r);
+}
+
+inline Fe fe_sq_n(Fe a, int n) {
+    for (int i = 0; i < n; ++i) {
+        a = fe_sq(a);
+    }
+    return a;
+}
+
+inline Fe fe_mul_small(const Fe& a, uint32_t k) {
+    using field25519::u128;
+    u128 r[5];
+    for (int i = 0; i < 5; ++i) {
+        r[i] = (u128)a.v[i] * k;
+    }
+    return field25519::carry_wide(r);
+}
+
+/**
+ * z^(2^250 - 1), plus z^11 as a by-product (shared exponent ladder)
+ */
+inline Fe fe_pow2_250_1(const Fe& z, Fe& z11) {
+    const Fe z2 = fe_sq(z);
+    const Fe z9 = fe_mul(fe_sq_n(z2, 2), z);
+    z11 = fe_mul(z9, z2);
+    const Fe z_5_0 = fe_mul(fe_sq(z11), z9);
+    const Fe z_10_0 = fe_mul(fe_sq_n(z_5_0, 5), z_5_0);
+    const Fe z_20_0 = fe_mul(fe_sq_n(z_10_0, 10), z_10_0);
+    const Fe z_40_0 = fe_mul(fe_sq_n(z_20_0, 20), z_20_0);
+    const Fe z_50_0 = fe_mul(fe_sq_n(z_40_0, 10), z_10_0);
+    const Fe z_100_0 = fe_mul(fe_sq_n(z_50_0, 50), z_50_0);
+    const Fe z_200_0 = fe_mul(fe_sq_n(z_100_0, 100), z_100_0);
+    return fe_mul(fe_sq_n(z_200_0, 50), z_50_0);
+}
+
+// z^(p - 2)
+inline Fe fe_invert(const Fe& z) {
+    Fe z11;
+    const Fe t = fe_pow2_250_1(z, z11);
+    return fe_mul(fe_sq_n(t, 5), z11);
+}
+
+// z^((p - 5) / 8), the square-root helper
+inline Fe fe_pow22523(const Fe& z) {
+    Fe z11;
+    const Fe t = fe_pow2_250_1(z, z11);
+    return fe_mul(fe_sq_n(t, 2), z);
+}
+
+inline Fe fe_from_bytes(const uint8_t s[32]) {
+    using field25519::kMask51;
+    using field25519::load_le64;
+    Fe h;
+    h.v[0] = load_le64(s) & kMask51;
+    h.v[1] = (load_le64(s + 6) >> 3) & kMask51;
+    h.v[2] = (load_le64(s + 12) >> 6) & kMask51;
+    h.v[3] = (load_le64(s + 19) >> 1) & kMask51;
+    h.v[4] = (load_le64(s + 24) >> 12) & kMask51;
+    return h;
+}
+
+inline void fe_to_bytes(uint8_t s[32], Fe h) {
+    using field25519::kMask51;
+
+    // Fully reduce: subtract p once if h >= p
+    field25519::carry(h);
+    uint64_t q = (h.v[0] + 19) >> 51;
+    q = (h.v[1] + q) >> 51;
+    q = (h.v[2] + q) >> 51;
+    q = (h.v[3] + q) >> 51;
+    q = (h.v[4] + q) >> 51;
+    h.v[0] += 19 * q;
+    h.v[1] += h.v[0] >> 51; h.v[0] &= kMask51;
+    h.v[2] += h.v[1] >> 51; h.v[1] &= kMask51;
+    h.v[3] += h.v[2] >> 51; h.v[2] &= kMask51;
+    h.v[4] += h.v[3] >> 51; h.v[3] &= kMask51;
+    h.v[4] &= kMask51;
+
+    const uint64_t w[4] = {
+        h.v[0] | (h.v[1] << 51),
+        (h.v[1] >> 13) | (h.v[2] << 38),
+        (h.v[2] >> 26) | (h.v[3] << 25),
+        (h.v[3] >> 39) | (h.v[4] << 12)
+    };
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            s[8 * i + j] = static_cast<uint8_t>(w[i] >> (8 * j));
+        }
+    }
+}
+
+inline bool fe_is_zero(const Fe& a) {
+    uint8_t s[32];
+    fe_to_bytes(s, a);
+    uint8_t acc = 0;
+    for (int i = 0; i < 32; ++i) {
+        acc |= s[i];
+    }
+    return acc == 0;
+}
+
+inline bool fe_is_negative(const Fe& a) {
+    uint8_t s[32];
+    fe_to_bytes(s, a);
+    return (s[0] & 1) != 0;
+}
+
+inline bool fe_equal(const Fe& a, const Fe& b) {
+    return fe_is_zero(fe_sub(a, b));
+}
+
+// Constant-time: swap a and b iff bit is 1
+inline void fe_cswap(Fe& a, Fe& b, uint64_t bit) {
+    const uint64_t mask = 0 - bit;
+    for (int i = 0; i < 5; ++i) {
+        const uint64_t x = (a.v[i] ^ b.v[i]) & mask;
+        a.v[i] ^= x;
+        b.v[i] ^= x;
+    }
+}
@@ -0,0 +1,342 @@
+/**
+ * FlightRecorder Implementation
+ */
+
+#include "flight_recorder.h"
+#include "byte_io.h"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const uint8_t kMagic[4] = {'M', 'C', 'F', 'R'};
+constexpr uint16_t kVersion = 1;
+
+// Records encoded per write() while dumping (stack buffer)
+constexpr size_t kChunkRecords = 64;
+
+// The recorder fatal signals dump, and whether a dump already ran
+std::atomic<FlightRecorder*> armed_recorder{nullptr};
+std::atomic<bool>            crash_dumped{false};
+std::terminate_handler       previous_terminate = nullptr;
+
+const int kFatalSignals[] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};
+constexpr size_t kFatalSignalCount = sizeof(kFatalSignals) / sizeof(kFatalSignals[0]);
+
+// What was installed before us (a host crash reporter, or the default)
+struct sigaction previous_actions[kFatalSignalCount];
+
+size_t round_up_pow2(size_t n) {
+    size_t size = 16;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+bool write_all(int fd, const uint8_t* bytes, size_t size) {
+    while (size > 0) {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= size_t(written);
+    }
+    return true;
+}
+
+void encode_header(uint8_t* out, uint32_t count, FlightDumpReason reason, uint64_t dumped_ns,
+                   int64_t dumped_unix_ms, uint64_t recorded) {
+    std::memset(out, 0, FlightRecorder::kHeaderSize);
+    std::memcpy(out, kMagic, 4);
+    store_u16(out + 4, kVersion);
+    store_u16(out + 6, uint16_t(FlightRecorder::kRecordSize));
+    store_u32(out + 8, count);
+    out[12] = uint8_t(reason);
+    store_u64(out + 16, dumped_ns);
+    store_u64(out + 24, uint64_t(dumped_unix_ms));
+    store_u64(out + 32, recorded);
+}
+
+void encode_record(uint8_t* out, const FlightRecord& record) {
+    store_u64(out, record.queued_ns);
+    store_u64(out + 8, record.started_ns);
+    store_u64(out + 16, record.duration_ns);
+    store_u64(out + 24, record.peer_id);
+    store_u32(out + 32, record.size);
+    out[36] = record.type;
+    out[37] = uint8_t(record.outcome);
+    out[38] = 0;
+    out[39] = 0;
+}
+
+void on_fatal_signal(int signal) {
+    // The previous action goes back first, so a fault while dumping
+    // reaches it too
+    for (size_t i = 0; i < kFatalSignalCount; ++i) {
+        if (kFatalSignals[i] == signal) {
+            sigaction(signal, &previous_actions[i], nullptr);
+        }
+    }
+    FlightRecorder::dump_armed(FlightDumpReason::Fatal);
+    // Blocked until we return, then delivered to the previous action
+    std::raise(signal);
+}
+
+void on_terminate() {
+    FlightRecorder::dump_armed(FlightDumpReason::Fatal);
+    if (previous_terminate) {
+        previous_terminate();
+    }
+    std::abort();
+}
+
+void install_crash_handlers() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_handler = on_fatal_signal;
+        sigemptyset(&action.sa_mask);
+        for (size_t i = 0; i < kFatalSignalCount; ++i) {
+            sigaction(kFatalSignals[i], &action, &previous_actions[i]);
+        }
+        previous_terminate = std::set_terminate(on_terminate);
+    });
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+FlightRecorder::FlightRecorder(size_t capacity)
+    : capacity_(round_up_pow2(capacity))
+    , slots_(new Slot[capacity_])
+    , head_(0)
+    , dumps_(0)
+    , armed_(false)
+{
+    for (size_t i = 0; i < capacity_; ++i) {
+        slots_[i].seq.store(0, std::memory_order_relaxed);
+        for (auto& word : slots_[i].words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+    path_[0] = '\0';
+}
+
+FlightRecorder::~FlightRecorder() {
+    set_dump_path(std::string());
+}
+
+// =============================================================================
+// MARK: - Recording
+// =============================================================================
+
+void FlightRecorder::record(const FlightRecord& record) {
+    const uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[index & (capacity_ - 1)];
+
+    // Claim the slot; a writer a lap ahead of us owns it already
+    uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+    for (;;) {
+        if (seq == kWriting) {
+            std::this_thread::yield();
+            seq = slot.seq.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (seq > index + 1) {
+            return;
+        }
+        if (slot.seq.compare_exchange_weak(seq, kWriting, std::memory_order_acquire, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.words[0].store(record.queued_ns, std::memory_order_relaxed);
+    slot.words[1].store(record.started_ns, std::memory_order_relaxed);
+    slot.words[2].store(record.duration_ns, std::memory_order_relaxed);
+    slot.words[3].store(record.peer_id, std::memory_order_relaxed);
+    slot.words[4].store(uint64_t(record.size) | uint64_t(record.type) << 32 | uint64_t(record.outcome) << 40,
+                        std::memory_order_relaxed);
+    slot.seq.store(index + 1, std::memory_order_release);
+}
+
+FlightStats FlightRecorder::stats() const {
+    return FlightStats{
+        uint64_t(capacity_),
+        head_.load(std::memory_order_relaxed),
+        dumps_.load(std::memory_order_relaxed),
+        armed_.load(std::memory_order_acquire)
+    };
+}
+
+// =============================================================================
+// MARK: - Dumps
+// =============================================================================
+
+bool FlightRecorder::dump(const std::string& path, FlightDumpReason reason) {
+    return dump_to(path.c_str(), reason);
+}
+
+bool FlightRecorder::set_dump_path(const std::string& path) {
+    if (path.size() >= kMaxPath) {
+        return false;
+    }
+
+    armed_.store(false, std::memory_order_release);
+    if (path.empty()) {
+        FlightRecorder* self = this;
+        armed_recorder.compare_exchange_strong(self, nullptr);
+        return true;
+    }
+
+    std::memcpy(path_, path.c_str(), path.size() + 1);
+    armed_.store(true, std::memory_order_release);
+    install_crash_handlers();
+    armed_recorder.store(this, std::memory_order_release);
+    return true;
+}
+
+bool FlightRecorder::trip(FlightDumpReason reason) {
+    if (!armed_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    return dump_to(path_, reason);
+}
+
+void FlightRecorder::dump_armed(FlightDumpReason reason) {
+    // A terminate that aborts must not dump a second time from SIGABRT
+    if (crash_dumped.exchange(true)) {
+        return;
+    }
+    FlightRecorder* recorder = armed_recorder.load(std::memory_order_acquire);
+    if (recorder && recorder->armed_.load(std::memory_order_acquire)) {
+        recorder->dump_to(recorder->path_, reason);
+    }
+}
+
+bool FlightRecorder::dump_to(const char* path, FlightDumpReason reason) {
+    const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    const bool ok = write_fd(fd, reason);
+    ::close(fd);
+    if (ok) {
+        dumps_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ok;
+}
+
+bool FlightRecorder::write_fd(int fd, FlightDumpReason reason) const {
+    // Stack buffers only: this runs from signal handlers
+    uint8_t header[kHeaderSize];
+    uint8_t chunk[kChunkRecords * kRecordSize];
+
+    const uint64_t dumped_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    const int64_t dumped_unix_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    // The count is known once the records are written; patch it in after
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    encode_header(header, 0, reason, dumped_ns, dumped_unix_ms, head);
+    if (!write_all(fd, header, sizeof(header))) {
+        return false;
+    }
+
+    uint32_t count = 0;
+    size_t in_chunk = 0;
+    for (uint64_t index = head > capacity_ ? head - capacity_ : 0; index < head; ++index) {
+        const Slot& slot = slots_[index & (capacity_ - 1)];
+        if (slot.seq.load(std::memory_order_acquire) != index + 1) {
+            continue;
+        }
+        FlightRecord record;
+        record.queued_ns = slot.words[0].load(std::memory_order_relaxed);
+        record.started_ns = slot.words[1].load(std::memory_order_relaxed);
+        record.duration_ns = slot.words[2].load(std::memory_order_relaxed);
+        record.peer_id = slot.words[3].load(std::memory_order_relaxed);
+        const uint64_t packed = slot.words[4].load(std::memory_order_relaxed);
+        record.size = uint32_t(packed);
+        record.type = uint8_t(packed >> 32);
+        record.outcome = FlightOutcome(uint8_t(packed >> 40));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != index + 1) {
+            continue;
+        }
+        encode_record(chunk + in_chunk * kRecordSize, record);
+        count++;
+        if (++in_chunk == kChunkRecords) {
+            if (!write_all(fd, chunk, in_chunk * kRecordSize)) {
+                return false;
+            }
+            in_chunk = 0;
+        }
+    }
+    if (in_chunk > 0 && !write_all(fd, chunk, in_chunk * kRecordSize)) {
+        return false;
+    }
+
+    encode_header(header, count, reason, dumped_ns, dumped_unix_ms, head);
+    return ::lseek(fd, 0, SEEK_SET) == 0 && write_all(fd, header, sizeof(header));
+}
+
+// =============================================================================
+// MARK: - Decoding
+// =============================================================================
+
+bool decode_flight_dump(const std::string& bytes, FlightDump& dump) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    if (bytes.size() < FlightRecorder::kHeaderSize || std::memcmp(data, kMagic, 4) != 0 ||
+        get_u16(data + 4) != kVersion) {
+        return false;
+    }
+
+    // Newer writers may append fields to a record; skip what we do not know
+    const size_t record_size = size_t(get_u16(data + 6));
+    const size_t count = size_t(get_u32(data + 8));
+    if (record_size < FlightRecorder::kRecordSize ||
+        bytes.size() < FlightRecorder::kHeaderSize + count * record_size) {
+        return false;
+    }
+
+    dump.reason = FlightDumpReason(data[12]);
+    dump.dumped_ns = get_u64(data + 16);
+    dump.dumped_unix_ms = int64_t(get_u64(data + 24));
+    dump.recorded = get_u64(data + 32);
+    dump.records.clear();
+    dump.records.reserve(count);
+
+    const uint8_t* at = data + FlightRecorder::kHeaderSize;
+    for (size_t i = 0; i < count; ++i, at += record_size) {
+        FlightRecord record;
+        record.queued_ns = get_u64(at);
+        record.started_ns = get_u64(at + 8);
+        record.duration_ns = get_u64(at + 16);
+        record.peer_id = get_u64(at + 24);
+        record.size = get_u32(at + 32);
+        record.type = at[36];
+        record.outcome = FlightOutcome(at[37]);
+        dump.records.push_back(record);
+    }
+    return true;
+}
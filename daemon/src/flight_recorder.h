@@ -0,0 +1,144 @@
+/**
+ * FlightRecorder - Last Events Kept for Post-Mortems
+ *
+ * Always on: every event the daemon handles (and every inbound frame it
+ * refuses) leaves one fixed-size record in a circular buffer sized at
+ * construction, so memory never grows and the oldest records are
+ * overwritten. A record is a handful of integers written with relaxed
+ * stores; there is no lock, allocation or formatting.
+ *
+ * dump() writes the buffer in a compact binary format:
+ *
+ *   header   magic "MCFR", version, record size, record count, reason,
+ *            steady and wall clock at the dump, records ever written
+ *   records  oldest first; little-endian fixed-width fields
+ *
+ * decode_flight_dump() reads it back; tools/flight_decode.cpp prints it.
+ *
+ * With a dump path armed, the process's fatal signals (SIGSEGV, SIGBUS,
+ * SIGILL, SIGFPE, SIGABRT) and std::terminate dump the armed recorder,
+ * then go on to whatever handler was installed before (a host's crash
+ * reporter, or the default action); the crash path only uses
+ * async-signal-safe calls. trip() dumps to the same path for other automatic triggers.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. Records are sequence-stamped: one being
+ *   overwritten while it is dumped is skipped, never torn. Writers (the
+ *   worker and the watchdog) claim a slot before filling it, so two that
+ *   land on the same slot never interleave; the older record yields.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class FlightOutcome : uint8_t {
+    Completed,     // Ran through every stage (delivered, sent)
+    Stopped,       // Finished by a stage (control events, protocol frames)
+    Refused,       // Dropped before the worker (policing, contacts, decrypt)
+    Resumed,       // Task wakeup
+    Stalled        // Still running when the watchdog fired (watchdog.h)
+};
+
+enum class FlightDumpReason : uint8_t {
+    OnDemand,
+    Fatal,
+    Watchdog
+};
+
+/**
+ * One handled event
+ */
+struct FlightRecord {
+    uint64_t queued_ns;       // Enqueued (steady clock; 0 if never queued)
+    uint64_t started_ns;      // Handling started
+    uint64_t duration_ns;     // Handler time of its batch
+    uint64_t peer_id;
+    uint32_t size;            // Payload bytes (queue depth when Stalled)
+    uint8_t  type;            // DaemonEventType, or kNoEvent
+    FlightOutcome outcome;
+};
+
+/**
+ * A decoded dump
+ */
+struct FlightDump {
+    FlightDumpReason reason;
+    uint64_t dumped_ns;       // Steady clock at the dump
+    int64_t  dumped_unix_ms;  // Wall clock at the dump
+    uint64_t recorded;        // Records ever written
+    std::vector<FlightRecord> records;   // Oldest first
+};
+
+/**
+ * Recorder counters
+ */
+struct FlightStats {
+    uint64_t capacity;
+    uint64_t recorded;        // Including overwritten ones
+    uint64_t dumps;
+    bool     armed;           // Automatic dumps have a path
+};
+
+class FlightRecorder {
+public:
+    static constexpr size_t kRecordSize = 40;   // Encoded bytes per record
+    static constexpr size_t kHeaderSize = 40;
+    static constexpr size_t kMaxPath    = 512;
+    static constexpr uint8_t kNoEvent   = 0xFF;  // Record type for work with no event (timers, maintenance)
+
+    // capacity is rounded up to a power of two
+    explicit FlightRecorder(size_t capacity = 1024);
+    ~FlightRecorder();
+
+    // Non-copyable
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    void record(const FlightRecord& record);
+
+    // Write the buffer to `path`; false on I/O failure
+    bool dump(const std::string& path, FlightDumpReason reason = FlightDumpReason::OnDemand);
+
+    // Where automatic dumps go; empty disarms. The last recorder armed
+    // is the one fatal signals dump.
+    bool set_dump_path(const std::string& path);
+
+    // Dump to the armed path (no-op when disarmed)
+    bool trip(FlightDumpReason reason);
+
+    FlightStats stats() const;
+
+    // Fatal signal / terminate path (async-signal-safe)
+    static void dump_armed(FlightDumpReason reason);
+
+private:
+    static constexpr uint64_t kWriting = ~uint64_t(0);   // Slot seq while claimed
+    static constexpr size_t kSlotWords = 5;
+
+    // The record is packed into relaxed atomic words so dumps may read a
+    // slot while it is rewritten; seq tells them whether the copy holds
+    struct Slot {
+        std::atomic<uint64_t> seq;     // Index + 1 once written, kWriting while claimed
+        std::atomic<uint64_t> words[kSlotWords];
+    };
+
+    bool write_fd(int fd, FlightDumpReason reason) const;
+    bool dump_to(const char* path, FlightDumpReason reason);
+
+    const size_t            capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t>   head_;
+    std::atomic<uint64_t>   dumps_;
+
+    char              path_[kMaxPath];    // Guarded by armed_ for the crash path
+    std::atomic<bool> armed_;
+};
+
+// Parse a dump; false if it is truncated or not a dump
+bool decode_flight_dump(const std::string& bytes, FlightDump& dump);
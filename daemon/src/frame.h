@@ -0,0 +1,114 @@
+/**
+ * Frame - Core Wire Format
+ *
+ * Control and protocol frames travel inside the transport payload, next
+ * to plain-text chat messages which the core still accepts unchanged.
+ *
+ * Header (4 bytes):
+ *   u8 marker   kFrameMarker (0xA7)
+ *   u8 type     FrameType
+ *   u8 flags    type-specific
+ *   u8 hint     sender's queue occupancy, 1 (idle) to 255 (full); 0 = none
+ *               (see congestion.h). Outside the AAD and signatures, so
+ *               it is stamped last, on the outermost frame.
+ *
+ * 0xA7 is a UTF-8 continuation byte, so no valid text message can start
+ * with it and the two formats never collide.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+constexpr uint8_t kFrameMarker      = 0xA7;
+constexpr size_t  kFrameHeaderBytes = 4;
+
+enum class FrameType : uint8_t {
+    // Attachment transfer (chunk_store / attachment_transfer)
+    ChunkOffer   = 0x10,
+    ChunkRequest = 0x11,
+    ChunkData    = 0x12,
+
+    // Encrypted envelope around any payload (session_cache)
+    Sealed       = 0x20,
+
+    // Ed25519-signed envelope around any payload (signature_verifier)
+    Signed       = 0x30,
+
+    // Session setup and resumption (handshake); never sealed
+    Hello        = 0x40,
+    HelloReply   = 0x41,
+    Resume       = 0x42,
+    ResumeAck    = 0x43,
+    ResumeReject = 0x44,
+
+    // Coroutine task channels (task_scheduler); acknowledged on receipt
+    TaskData     = 0x50,
+    TaskAck      = 0x51,
+
+    // Backpressure (congestion); header only, the hint is the signal
+    Congestion   = 0x60
+};
+
+struct FrameHeader {
+    FrameType type;
+    uint8_t   flags;
+    uint8_t   hint;
+};
+
+inline bool is_frame(const std::string& data) {
+    return data.size() >= kFrameHeaderBytes && static_cast<uint8_t>(data[0]) == kFrameMarker;
+}
+
+inline FrameHeader frame_header(const std::string& data) {
+    return FrameHeader{
+        static_cast<FrameType>(static_cast<uint8_t>(data[1])),
+        static_cast<uint8_t>(data[2]),
+        static_cast<uint8_t>(data[3])
+    };
+}
+
+inline uint8_t frame_hint(const char* data, size_t len) {
+    return len >= kFrameHeaderBytes && static_cast<uint8_t>(data[0]) == kFrameMarker
+        ? static_cast<uint8_t>(data[3]) : 0;
+}
+
+// Session setup, task acks and Congestion frames: losing one stalls a
+// protocol rather than a message, so they are never shed. Plain text and
+// every other frame carry data.
+inline bool is_control_frame(const char* data, size_t len) {
+    if (len < kFrameHeaderBytes || static_cast<uint8_t>(data[0]) != kFrameMarker) {
+        return false;
+    }
+    switch (static_cast<FrameType>(static_cast<uint8_t>(data[1]))) {
+        case FrameType::Hello:
+        case FrameType::HelloReply:
+        case FrameType::Resume:
+        case FrameType::ResumeAck:
+        case FrameType::ResumeReject:
+        case FrameType::TaskAck:
+        case FrameType::Congestion:
+            return true;
+        default:
+            return false;
+    }
+}
+
+inline void set_frame_hint(std::string& frame, uint8_t hint) {
+    if (is_frame(frame)) {
+        frame[3] = static_cast<char>(hint);
+    }
+}
+
+inline std::string make_frame(FrameType type, const std::string& payload, uint8_t flags = 0) {
+    std::string frame;
+    frame.reserve(kFrameHeaderBytes + payload.size());
+    frame.push_back(static_cast<char>(kFrameMarker));
+    frame.push_back(static_cast<char>(type));
+    frame.push_back(static_cast<char>(flags));
+    frame.push_back(0);
+    frame.append(payload);
+    return frame;
+}
@@ -0,0 +1,48 @@
+/**
+ * FramePool Implementation
+ */
+
+#include "frame_pool.h"
+
+FramePool::FramePool()
+    : reused_(0)
+{
+}
+
+std::string FramePool::acquire(size_t capacity) {
+    std::string buffer;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            buffer = std::move(free_.back());
+            free_.pop_back();
+            reused_++;
+        }
+    }
+
+    buffer.clear();
+    buffer.reserve(capacity < kMinCapacity ? kMinCapacity : capacity);
+    return buffer;
+}
+
+void FramePool::release(std::string&& buffer) {
+    if (buffer.capacity() < kMinCapacity || buffer.capacity() > kMaxCapacity) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.size() < kMaxPooled) {
+        free_.push_back(std::move(buffer));
+    }
+}
+
+size_t FramePool::pooled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_.size();
+}
+
+uint64_t FramePool::reused() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reused_;
+}
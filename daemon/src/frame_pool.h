@@ -0,0 +1,43 @@
+/**
+ * FramePool - Reusable Frame Buffers
+ *
+ * Recycles std::string buffers (with their capacity) so the hot send and
+ * receive paths stop allocating once warmed up. Inbound buffers are
+ * returned by the worker after an event is handled and reused for
+ * outbound frames.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class FramePool {
+public:
+    static constexpr size_t kMaxPooled   = 64;
+    static constexpr size_t kMaxCapacity = 64 * 1024;   // Larger buffers are freed
+    static constexpr size_t kMinCapacity = 512;
+
+    FramePool();
+
+    // Non-copyable
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    // Empty buffer with at least `capacity` reserved
+    std::string acquire(size_t capacity);
+    void release(std::string&& buffer);
+
+    size_t pooled() const;
+    uint64_t reused() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::string> free_;
+    uint64_t reused_;
+};
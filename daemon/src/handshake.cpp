@@ -0,0 +1,465 @@
+/**
+ * Handshake Implementation
+ */
+
+#include "handshake.h"
+#include "blake2s.h"
+#include "byte_io.h"
+#include "chacha20_poly1305.h"
+#include "random.h"
+#include "x25519.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr size_t kKeyBytes       = 32;
+constexpr size_t kTicketIdBytes  = kAeadNonceBytes;
+constexpr size_t kTicketBody     = 32 + 8;          // Secret + issue time
+constexpr size_t kTicketBytes    = kTicketIdBytes + kTicketBody + kAeadTagBytes;
+constexpr size_t kClientRandom   = 16;
+
+// Initiators stop offering a ticket slightly before the responder would
+// refuse it, so clock skew between the two checks cannot cost a round trip
+constexpr auto kTicketMargin = std::chrono::seconds(5);
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+const uint8_t* as_bytes(const char* p) {
+    return reinterpret_cast<const uint8_t*>(p);
+}
+
+std::string as_string(const uint8_t* p, size_t len) {
+    return std::string(reinterpret_cast<const char*>(p), len);
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Constructor
+// =============================================================================
+
+Handshake::Handshake(SessionCache& sessions, SendFn send, FlushFn flush)
+    : Handshake(sessions, std::move(send), std::move(flush), Config())
+{
+}
+
+Handshake::Handshake(SessionCache& sessions, SendFn send, FlushFn flush, const Config& config)
+    : sessions_(sessions)
+    , send_(std::move(send))
+    , flush_(std::move(flush))
+    , config_(config)
+    , replay_floor_(0)
+    , stats_{0, 0, 0, 0}
+{
+    random_bytes(ticket_key_, sizeof(ticket_key_));
+}
+
+// =============================================================================
+// MARK: - Initiator
+// =============================================================================
+
+void Handshake::connect(uint64_t peer_id, const std::string& uid) {
+    std::string frame;
+    Keys keys;
+    bool resuming = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        PeerState& peer = peers_[peer_id];
+        peer.uid = uid;
+
+        auto ticket = tickets_.find(uid);
+        const bool fresh = ticket != tickets_.end() &&
+                           Clock::now() - ticket->second.received < config_.ticket_lifetime - kTicketMargin;
+
+        if (fresh) {
+            // Single use: the ticket is spent whether or not it is accepted
+            uint8_t client_random[kClientRandom];
+            random_bytes(client_random, sizeof(client_random));
+
+            std::string context = "resume";
+            context.append(ticket->second.blob, 0, kTicketIdBytes);
+            context.append(as_string(client_random, sizeof(client_random)));
+            keys = derive(ticket->second.secret.data(), context);
+
+            frame = make_frame(FrameType::Resume, ticket->second.blob + as_string(client_random, sizeof(client_random)));
+            peer.state = State::Resuming;
+            peer.next_secret = keys.resumption;
+            resuming = true;
+        } else {
+            frame = begin_full(peer);
+        }
+
+        if (ticket != tickets_.end()) {
+            tickets_.erase(ticket);
+        }
+    }
+
+    // Resume goes out first; early data after it is sealed under the new keys
+    send_(peer_id, frame);
+    if (resuming) {
+        sessions_.install(peer_id, keys.initiator_to_responder, keys.responder_to_initiator);
+    }
+}
+
+std::string Handshake::begin_full(PeerState& peer) {
+    random_bytes(peer.ephemeral_secret.data(), kKeyBytes);
+    x25519_public_key(peer.ephemeral_public.data(), peer.ephemeral_secret.data());
+    peer.state = State::AwaitReply;
+    return make_frame(FrameType::Hello, as_string(peer.ephemeral_public.data(), kKeyBytes));
+}
+
+bool Handshake::intercept(uint64_t peer_id, const std::string& data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = peers_.find(peer_id);
+    if (it == peers_.end() || it->second.state == State::Established) {
+        return false;
+    }
+
+    PeerState& peer = it->second;
+    if (peer.held.size() < config_.max_held) {
+        peer.held.push_back(data);
+    }
+
+    // Early data goes out now; a copy stays until the resumption is acked
+    return peer.state == State::AwaitReply;
+}
+
+// =============================================================================
+// MARK: - Frame Dispatch
+// =============================================================================
+
+bool Handshake::is_handshake_frame(const std::string& data) {
+    if (!is_frame(data)) {
+        return false;
+    }
+    switch (frame_header(data).type) {
+        case FrameType::Hello:
+        case FrameType::HelloReply:
+        case FrameType::Resume:
+        case FrameType::ResumeAck:
+        case FrameType::ResumeReject:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool Handshake::on_frame(uint64_t peer_id, const std::string& uid, const FrameHeader& header,
+                         const char* payload, size_t len) {
+    switch (header.type) {
+        case FrameType::Hello:
+            return handle_hello(peer_id, uid, payload, len);
+        case FrameType::HelloReply:
+            return handle_reply(peer_id, payload, len);
+        case FrameType::Resume:
+            return handle_resume(peer_id, uid, payload, len);
+        case FrameType::ResumeAck:
+            return handle_ack(peer_id, payload, len);
+        case FrameType::ResumeReject:
+            return handle_reject(peer_id);
+        default:
+            return false;
+    }
+}
+
+void Handshake::on_disconnect(uint64_t peer_id) {
+    bool had_state = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        had_state = peers_.erase(peer_id) > 0;
+    }
+
+    if (had_state) {
+        sessions_.remove(peer_id);
+    }
+}
+
+bool Handshake::has_ticket(const std::string& uid) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tickets_.count(uid) > 0;
+}
+
+HandshakeStats Handshake::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+// =============================================================================
+// MARK: - Handlers
+// =============================================================================
+
+bool Handshake::handle_hello(uint64_t peer_id, const std::string& uid, const char* payload, size_t len) {
+    if (len != kKeyBytes) {
+        return false;
+    }
+
+    Secret secret;
+    Secret ephemeral;
+    uint8_t shared[kKeyBytes];
+    random_bytes(secret.data(), kKeyBytes);
+    x25519_public_key(ephemeral.data(), secret.data());
+    if (!x25519(shared, secret.data(), as_bytes(payload))) {
+        return false;
+    }
+
+    std::vector<std::string> held;
+    std::string reply;
+    Keys keys;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Both sides said Hello at once: the lower ephemeral key stays initiator
+        auto it = peers_.find(peer_id);
+        if (it != peers_.end() && it->second.state == State::AwaitReply &&
+            std::memcmp(it->second.ephemeral_public.data(), payload, kKeyBytes) < 0) {
+            return true;
+        }
+
+        PeerState& peer = peers_[peer_id];
+
+        std::string context = "full";
+        context.append(payload, kKeyBytes);
+        context.append(as_string(ephemeral.data(), kKeyBytes));
+        keys = derive(shared, context);
+
+        reply = make_frame(FrameType::HelloReply,
+                           as_string(ephemeral.data(), kKeyBytes) + issue_ticket(keys.resumption));
+
+        peer.uid = uid;
+        peer.state = State::Established;
+        held.swap(peer.held);
+        stats_.full++;
+    }
+
+    send_(peer_id, reply);
+    sessions_.install(peer_id, keys.responder_to_initiator, keys.initiator_to_responder);
+
+    if (!held.empty()) {
+        flush_(peer_id, std::move(held));
+    }
+    return true;
+}
+
+bool Handshake::handle_reply(uint64_t peer_id, const char* payload, size_t len) {
+    if (len != kKeyBytes + kTicketBytes) {
+        return false;
+    }
+
+    std::vector<std::string> held;
+    Keys keys;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = peers_.find(peer_id);
+        if (it == peers_.end() || it->second.state != State::AwaitReply) {
+            return false;
+        }
+        PeerState& peer = it->second;
+
+        uint8_t shared[kKeyBytes];
+        if (!x25519(shared, peer.ephemeral_secret.data(), as_bytes(payload))) {
+            return false;
+        }
+
+        std::string context = "full";
+        context.append(as_string(peer.ephemeral_public.data(), kKeyBytes));
+        context.append(payload, kKeyBytes);
+        keys = derive(shared, context);
+
+        if (!peer.uid.empty()) {
+            store_ticket(peer.uid, payload + kKeyBytes, keys.resumption);
+        }
+
+        peer.state = State::Established;
+        held.swap(peer.held);
+        stats_.full++;
+    }
+
+    sessions_.install(peer_id, keys.initiator_to_responder, keys.responder_to_initiator);
+
+    if (!held.empty()) {
+        flush_(peer_id, std::move(held));
+    }
+    return true;
+}
+
+bool Handshake::handle_resume(uint64_t peer_id, const std::string& uid, const char* payload, size_t len) {
+    if (len != kTicketBytes + kClientRandom) {
+        return false;
+    }
+
+    std::string reply;
+    Keys keys;
+    bool accepted = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        Secret secret;
+        if (redeem_ticket(payload, secret)) {
+            std::string context = "resume";
+            context.append(payload, kTicketIdBytes);
+            context.append(payload + kTicketBytes, kClientRandom);
+            keys = derive(secret.data(), context);
+
+            PeerState& peer = peers_[peer_id];
+            peer.uid = uid;
+            peer.state = State::Established;
+            peer.held.clear();
+
+            reply = make_frame(FrameType::ResumeAck, issue_ticket(keys.resumption));
+            stats_.resumed++;
+            accepted = true;
+        } else {
+            reply = make_frame(FrameType::ResumeReject, std::string());
+            stats_.rejected++;
+        }
+    }
+
+    // Keys go in before the early data behind the Resume is processed
+    if (accepted) {
+        sessions_.install(peer_id, keys.responder_to_initiator, keys.initiator_to_responder);
+    }
+    send_(peer_id, reply);
+    return true;
+}
+
+bool Handshake::handle_ack(uint64_t peer_id, const char* payload, size_t len) {
+    if (len != kTicketBytes) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = peers_.find(peer_id);
+    if (it == peers_.end() || it->second.state != State::Resuming) {
+        return false;
+    }
+    PeerState& peer = it->second;
+
+    if (!peer.uid.empty()) {
+        store_ticket(peer.uid, payload, peer.next_secret);
+    }
+
+    // Early data was accepted; the copies are no longer needed
+    peer.state = State::Established;
+    peer.held.clear();
+    stats_.resumed++;
+    return true;
+}
+
+bool Handshake::handle_reject(uint64_t peer_id) {
+    std::string hello;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = peers_.find(peer_id);
+        if (it == peers_.end() || it->second.state != State::Resuming) {
+            return false;
+        }
+
+        // Held early data is re-sent once the full handshake completes
+        hello = begin_full(it->second);
+        stats_.fallbacks++;
+    }
+
+    sessions_.remove(peer_id);
+    send_(peer_id, hello);
+    return true;
+}
+
+// =============================================================================
+// MARK: - Tickets
+// =============================================================================
+
+std::string Handshake::issue_ticket(const Secret& secret) {
+    uint8_t ticket[kTicketBytes];
+    random_bytes(ticket, kTicketIdBytes);
+
+    uint8_t* body = ticket + kTicketIdBytes;
+    std::memcpy(body, secret.data(), 32);
+    std::string issued;
+    put_u64(issued, now_ns());
+    std::memcpy(body + 32, issued.data(), 8);
+
+    aead_seal(ticket_key_, ticket, nullptr, 0, body, kTicketBody, body + kTicketBody);
+    return as_string(ticket, sizeof(ticket));
+}
+
+bool Handshake::redeem_ticket(const char* blob, Secret& secret) {
+    uint8_t ticket[kTicketBytes];
+    std::memcpy(ticket, blob, sizeof(ticket));
+
+    uint8_t* body = ticket + kTicketIdBytes;
+    if (!aead_open(ticket_key_, ticket, nullptr, 0, body, kTicketBody, body + kTicketBody)) {
+        return false;
+    }
+
+    const uint64_t issued = get_u64(body + 32);
+    const uint64_t lifetime = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(config_.ticket_lifetime).count());
+    if (issued <= replay_floor_ || now_ns() - issued > lifetime) {
+        return false;
+    }
+
+    std::string id(blob, kTicketIdBytes);
+    if (!used_ids_.insert(id).second) {
+        return false;   // Replayed
+    }
+    used_order_.emplace_back(std::move(id), issued);
+
+    // Forgetting an id would re-open it to replay, so everything issued
+    // up to the forgotten ticket is refused from then on
+    while (used_order_.size() > kMaxUsedTickets) {
+        replay_floor_ = std::max(replay_floor_, used_order_.front().second);
+        used_ids_.erase(used_order_.front().first);
+        used_order_.pop_front();
+    }
+
+    std::memcpy(secret.data(), body, 32);
+    return true;
+}
+
+void Handshake::store_ticket(const std::string& uid, const char* blob, const Secret& secret) {
+    if (tickets_.size() >= config_.max_tickets && tickets_.count(uid) == 0) {
+        auto oldest = std::min_element(tickets_.begin(), tickets_.end(),
+            [](const std::pair<const std::string, Ticket>& a, const std::pair<const std::string, Ticket>& b) {
+                return a.second.received < b.second.received;
+            });
+        tickets_.erase(oldest);
+    }
+
+    Ticket& ticket = tickets_[uid];
+    ticket.blob.assign(blob, kTicketBytes);
+    ticket.secret = secret;
+    ticket.received = Clock::now();
+}
+
+// =============================================================================
+// MARK: - Key Derivation
+// =============================================================================
+
+Handshake::Keys Handshake::derive(const uint8_t* ikm, const std::string& context) {
+    // Extract with the shared secret as key, then expand one label per key
+    const Blake2sDigest prk = Blake2s::mac(ikm, kKeyBytes, context.data(), context.size());
+
+    Keys keys;
+    const Blake2sDigest i2r = Blake2s::mac(prk.data(), prk.size(), "meshcore i2r", 12);
+    const Blake2sDigest r2i = Blake2s::mac(prk.data(), prk.size(), "meshcore r2i", 12);
+    const Blake2sDigest resume = Blake2s::mac(prk.data(), prk.size(), "meshcore resume", 15);
+    std::copy(i2r.begin(), i2r.end(), keys.initiator_to_responder.begin());
+    std::copy(r2i.begin(), r2i.end(), keys.responder_to_initiator.begin());
+    std::copy(resume.begin(), resume.end(), keys.resumption.begin());
+    return keys;
+}
@@ -0,0 +1,164 @@
+/**
+ * Handshake - Session Setup with Resumption Tickets
+ *
+ * Establishes the per-peer SessionCache keys so reconnects do not need
+ * the host to re-run an identity exchange.
+ *
+ * Full handshake (1 round trip before data):
+ *   Hello         initiator -> responder   ephemeral X25519 key
+ *   HelloReply    responder -> initiator   ephemeral X25519 key + ticket
+ *
+ * Resumption (0-RTT):
+ *   Resume        initiator -> responder   ticket + 16-byte client random
+ *   ...           sealed data follows immediately under the resumed keys
+ *   ResumeAck     responder -> initiator   fresh ticket
+ *   ResumeReject  responder -> initiator   ticket refused; fall back to Hello
+ *
+ * A ticket is the resumption secret sealed under a key only the issuing
+ * responder knows, so the responder keeps no per-client state. Tickets
+ * are single use: the initiator drops a ticket once it is sent, and the
+ * responder remembers the ids it has accepted and refuses repeats, so a
+ * replayed Resume (and the early data behind it) is rejected.
+ *
+ * Data sent while a full handshake is in flight is held and flushed once
+ * keys are installed. Early data sent after a Resume is kept until the
+ * ResumeAck arrives; if the ticket is rejected it is re-sent after the
+ * fallback handshake, so nothing is lost.
+ *
+ * The exchange is unauthenticated, like the session keys the host sets
+ * directly; binding it to Ed25519 identities is separate work.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. connect() and on_frame() should run on
+ *   the thread that sends data, so early data cannot overtake a Resume.
+ *   Callbacks are invoked without the internal lock held.
+ */
+
+#pragma once
+
+#include "frame.h"
+#include "session_cache.h"
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Handshake counters
+ */
+struct HandshakeStats {
+    uint64_t full;         // Full handshakes completed (either role)
+    uint64_t resumed;      // Resumptions completed (either role)
+    uint64_t rejected;     // Tickets refused (expired, forged or replayed)
+    uint64_t fallbacks;    // Our resumptions that fell back to a full handshake
+};
+
+class Handshake {
+public:
+    // Sends a handshake frame as-is (never sealed)
+    using SendFn = std::function<void(uint64_t peer_id, const std::string& frame)>;
+
+    // Re-sends data that was held until keys were installed
+    using FlushFn = std::function<void(uint64_t peer_id, std::vector<std::string>&& held)>;
+
+    struct Config {
+        std::chrono::milliseconds ticket_lifetime = std::chrono::hours(24);
+        size_t                    max_tickets     = 256;     // Cached tickets (initiator)
+        size_t                    max_held        = 64;      // Held frames per peer
+    };
+
+    // Ticket ids remembered for replay protection
+    static constexpr size_t kMaxUsedTickets = 4096;
+
+    Handshake(SessionCache& sessions, SendFn send, FlushFn flush);
+    Handshake(SessionCache& sessions, SendFn send, FlushFn flush, const Config& config);
+
+    // Non-copyable
+    Handshake(const Handshake&) = delete;
+    Handshake& operator=(const Handshake&) = delete;
+
+    // Start as initiator: resume if we hold a ticket for uid, else full
+    void connect(uint64_t peer_id, const std::string& uid);
+
+    // Outbound data; returns true if it was held and must not be sent now
+    bool intercept(uint64_t peer_id, const std::string& data);
+
+    // Handle an inbound handshake frame; returns false if malformed
+    bool on_frame(uint64_t peer_id, const std::string& uid, const FrameHeader& header,
+                  const char* payload, size_t len);
+
+    // Forget the peer's handshake state and any session it installed
+    void on_disconnect(uint64_t peer_id);
+
+    bool has_ticket(const std::string& uid) const;
+    HandshakeStats stats() const;
+
+    static bool is_handshake_frame(const std::string& data);
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Secret = std::array<uint8_t, 32>;
+
+    enum class State {
+        AwaitReply,    // Hello sent; data is held
+        Resuming,      // Resume sent, keys installed; data is kept until acked
+        Established
+    };
+
+    struct PeerState {
+        State                    state = State::Established;
+        std::string              uid;
+        Secret                   ephemeral_secret;
+        Secret                   ephemeral_public;
+        Secret                   next_secret;      // Secret of the ticket the ack carries
+        std::vector<std::string> held;
+    };
+
+    struct Ticket {
+        std::string       blob;
+        Secret            secret;
+        Clock::time_point received;
+    };
+
+    struct Keys {
+        SessionKey initiator_to_responder;
+        SessionKey responder_to_initiator;
+        Secret     resumption;
+    };
+
+    bool handle_hello(uint64_t peer_id, const std::string& uid, const char* payload, size_t len);
+    bool handle_reply(uint64_t peer_id, const char* payload, size_t len);
+    bool handle_resume(uint64_t peer_id, const std::string& uid, const char* payload, size_t len);
+    bool handle_ack(uint64_t peer_id, const char* payload, size_t len);
+    bool handle_reject(uint64_t peer_id);
+
+    // Fresh ephemeral key and a Hello frame (caller holds the lock)
+    std::string begin_full(PeerState& peer);
+
+    std::string issue_ticket(const Secret& secret);
+    bool redeem_ticket(const char* blob, Secret& secret);
+    void store_ticket(const std::string& uid, const char* blob, const Secret& secret);
+
+    static Keys derive(const uint8_t* ikm, const std::string& context);
+
+    SessionCache& sessions_;
+    SendFn        send_;
+    FlushFn       flush_;
+    const Config  config_;
+
+    uint8_t ticket_key_[32];
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, PeerState>   peers_;
+    std::unordered_map<std::string, Ticket>   tickets_;     // By responder UID
+    std::unordered_set<std::string>           used_ids_;
+    std::deque<std::pair<std::string, uint64_t>> used_order_;
+    uint64_t                                  replay_floor_;   // Older tickets are refused
+    HandshakeStats                            stats_;
+};
@@ -0,0 +1,144 @@
+/**
+ * Hibernation Implementation
+ */
+
+#include "hibernation.h"
+
+#include <algorithm>
+
+namespace {
+
+int64_t seconds_of(Hibernation::Clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count();
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+Hibernation::Hibernation()
+    : Hibernation(HibernationConfig())
+{
+}
+
+Hibernation::Hibernation(const HibernationConfig& config)
+    : config_(config)
+    , active_(false)
+    , optional_ran_(false)
+    , wakeups_(0)
+    , traffic_wakeups_(0)
+    , coalesced_(0)
+    , deferred_(0)
+    , hibernations_(0)
+{
+    std::fill(seconds_, seconds_ + kWindowSeconds, -1);
+    std::fill(counts_, counts_ + kWindowSeconds, 0);
+}
+
+void Hibernation::set_config(const HibernationConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+HibernationConfig Hibernation::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+bool Hibernation::set_active(bool active, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (active_.load(std::memory_order_relaxed) == active) {
+        return false;
+    }
+    if (active) {
+        anchor_ = now;
+        hibernations_++;
+    }
+    active_.store(active, std::memory_order_relaxed);
+    return true;
+}
+
+bool Hibernation::active() const {
+    return active_.load(std::memory_order_relaxed);
+}
+
+// =============================================================================
+// MARK: - Coalescing
+// =============================================================================
+
+Hibernation::Clock::time_point Hibernation::coalesce(Clock::time_point deadline, Clock::time_point now) {
+    if (!active() || deadline <= now) {
+        return deadline;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto slack = std::chrono::milliseconds(std::max<uint32_t>(1, config_.slack_ms));
+    const auto offset = deadline - anchor_;
+    const auto steps = (offset + slack - Clock::duration(1)) / slack;
+    const Clock::time_point aligned = anchor_ + steps * slack;
+    if (aligned != deadline) {
+        coalesced_++;
+    }
+    return aligned;
+}
+
+bool Hibernation::optional_due(Clock::time_point now) {
+    if (!active()) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto every = std::chrono::milliseconds(config_.optional_every_ms);
+    if (optional_ran_ && now - optional_at_ < every) {
+        deferred_++;
+        return false;
+    }
+    return true;
+}
+
+void Hibernation::optional_done(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    optional_at_ = now;
+    optional_ran_ = true;
+}
+
+// =============================================================================
+// MARK: - Accounting
+// =============================================================================
+
+void Hibernation::note_wakeup(Clock::time_point now, bool traffic) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wakeups_++;
+    traffic_wakeups_ += traffic ? 1 : 0;
+
+    const int64_t second = seconds_of(now);
+    const int slot = int(second % kWindowSeconds);
+    if (seconds_[slot] != second) {
+        seconds_[slot] = second;
+        counts_[slot] = 0;
+    }
+    counts_[slot]++;
+}
+
+HibernationStats Hibernation::stats(Clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int64_t second = seconds_of(now);
+    uint64_t recent = 0;
+    for (int i = 0; i < kWindowSeconds; ++i) {
+        if (seconds_[i] > second - kWindowSeconds && seconds_[i] <= second) {
+            recent += counts_[i];
+        }
+    }
+
+    return HibernationStats{
+        active(),
+        wakeups_,
+        traffic_wakeups_,
+        recent,
+        coalesced_,
+        deferred_,
+        hibernations_
+    };
+}
@@ -0,0 +1,95 @@
+/**
+ * Hibernation - Low-Power Mode for an Idle Daemon
+ *
+ * While hibernating, every non-urgent deadline of the worker (task
+ * timers, maintenance) is moved onto a grid of slack_ms, anchored when
+ * hibernation began, so they all fire in one wakeup instead of each
+ * waking the CPU on its own. Optional work (store compaction, snapshot
+ * writes) runs at most once per optional_every_ms. Paced frames keep
+ * their exact release times, and queued events still wake the worker
+ * at once, so real traffic is never delayed.
+ *
+ * The worker reports each wakeup here, giving wakeups per minute over
+ * the last 60 seconds whether hibernating or not.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe; active() is lock-free.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+struct HibernationConfig {
+    uint32_t slack_ms          = 30000;     // Grid non-urgent deadlines are rounded up to
+    uint32_t optional_every_ms = 600000;    // Compaction and snapshots while hibernating
+};
+
+/**
+ * Wakeup counters
+ */
+struct HibernationStats {
+    bool     hibernating;
+    uint64_t wakeups;              // Worker wakeups from an empty queue
+    uint64_t traffic_wakeups;      // ... woken by a queued event
+    uint64_t wakeups_per_minute;   // Over the last 60 seconds
+    uint64_t coalesced;            // Deadlines moved onto the slack grid
+    uint64_t deferred;             // Optional work put off
+    uint64_t hibernations;         // Times entered
+};
+
+class Hibernation {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Hibernation();
+    explicit Hibernation(const HibernationConfig& config);
+
+    // Non-copyable
+    Hibernation(const Hibernation&) = delete;
+    Hibernation& operator=(const Hibernation&) = delete;
+
+    // The grid follows the new slack from the next deadline on
+    void set_config(const HibernationConfig& config);
+    HibernationConfig config() const;
+
+    // Enter or leave; true if the state changed
+    bool set_active(bool active, Clock::time_point now);
+    bool active() const;
+
+    // A non-urgent deadline, rounded up onto the slack grid (unchanged
+    // when not hibernating or already due)
+    Clock::time_point coalesce(Clock::time_point deadline, Clock::time_point now);
+
+    // Whether optional work may run now; done() once it has finished
+    bool optional_due(Clock::time_point now);
+    void optional_done(Clock::time_point now);
+
+    // The worker woke up with an empty queue behind it
+    void note_wakeup(Clock::time_point now, bool traffic);
+
+    HibernationStats stats(Clock::time_point now) const;
+
+private:
+    static constexpr int kWindowSeconds = 60;
+
+    mutable std::mutex mutex_;
+    HibernationConfig config_;
+    std::atomic<bool> active_;
+    Clock::time_point anchor_;            // Grid origin: when hibernation began
+    Clock::time_point optional_at_;       // Optional work last finished
+    bool              optional_ran_;
+
+    // Wakeups per second over the last minute, by second
+    int64_t  seconds_[kWindowSeconds];
+    uint32_t counts_[kWindowSeconds];
+
+    uint64_t wakeups_;
+    uint64_t traffic_wakeups_;
+    uint64_t coalesced_;
+    uint64_t deferred_;
+    uint64_t hibernations_;
+};
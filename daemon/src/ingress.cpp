@@ -0,0 +1,270 @@
+/**
+ * Ingress Implementation
+ */
+
+#include "ingress.h"
+
+#include <algorithm>
+#include <memory>
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+Ingress::Ingress(OffloadPool& pool, DecodeFn decode, PostFn post)
+    : Ingress(pool, std::move(decode), std::move(post), Config())
+{
+}
+
+Ingress::Ingress(OffloadPool& pool, DecodeFn decode, PostFn post, const Config& config)
+    : pool_(pool)
+    , decode_(std::move(decode))
+    , post_(std::move(post))
+    , config_(config)
+    , stats_{0, 0, 0, 0}
+    , generation_(0)
+    , next_ticket_(0)
+    , jobs_(0)
+{
+}
+
+Ingress::~Ingress() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    generation_++;
+    for (auto& entry : peers_) {
+        entry.second.frames.clear();
+        entry.second.held.clear();
+    }
+    jobs_cv_.wait(lock, [this] { return jobs_ == 0; });
+}
+
+Ingress::JobToken::JobToken(Ingress& ingress)
+    : ingress_(ingress)
+{
+    std::lock_guard<std::mutex> lock(ingress_.mutex_);
+    ingress_.jobs_++;
+}
+
+Ingress::JobToken::~JobToken() {
+    std::lock_guard<std::mutex> lock(ingress_.mutex_);
+    if (--ingress_.jobs_ == 0) {
+        ingress_.jobs_cv_.notify_all();
+    }
+}
+
+// =============================================================================
+// MARK: - Submission
+// =============================================================================
+
+bool Ingress::submit(InboundFrame&& frame) {
+    const uint64_t peer_id = frame.peer_id;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PeerQueue& peer = peers_[peer_id];
+
+        if (peer.frames.size() >= config_.max_backlog) {
+            stats_.overflow++;
+            return false;
+        }
+        peer.frames.push_back(std::move(frame));
+
+        if (peer.draining || peer.blocked) {
+            return true;
+        }
+        peer.draining = true;
+    }
+
+    schedule(peer_id);
+    return true;
+}
+
+void Ingress::resume(uint64_t peer_id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = peers_.find(peer_id);
+        if (it == peers_.end()) {
+            return;
+        }
+
+        PeerQueue& peer = it->second;
+        peer.blocked = false;
+        if (peer.draining) {
+            return;
+        }
+        if (peer.frames.empty()) {
+            release(it);
+            return;
+        }
+        peer.draining = true;
+    }
+
+    schedule(peer_id);
+}
+
+void Ingress::finish(uint64_t peer_id, uint64_t ticket, bool deliver) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = peers_.find(peer_id);
+        if (it == peers_.end()) {
+            return;
+        }
+
+        auto held = std::find_if(it->second.held.begin(), it->second.held.end(),
+                                 [ticket](const Held& h) { return h.ticket == ticket; });
+        if (held == it->second.held.end() || held->finished || (held->decoded && !held->consumed)) {
+            return;
+        }
+        held->finished = true;
+        held->deliver = deliver;
+        (deliver ? stats_.decoded : stats_.dropped)++;
+    }
+
+    flush(peer_id);
+}
+
+void Ingress::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+    for (auto it = peers_.begin(); it != peers_.end();) {
+        // A running drain keeps its peer, so a later submit() cannot start
+        // a second one next to it; likewise a running flush
+        if (it->second.draining || it->second.posting) {
+            it->second.frames.clear();
+            it->second.held.clear();
+            it->second.blocked = false;
+            ++it;
+        } else {
+            it = peers_.erase(it);
+        }
+    }
+}
+
+IngressStats Ingress::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+// =============================================================================
+// MARK: - Decoding
+// =============================================================================
+
+void Ingress::schedule(uint64_t peer_id) {
+    // The peer's own flags serialise its frames, so the job itself needs
+    // no strand
+    auto token = std::make_shared<JobToken>(*this);
+    pool_.submit(0, [this, peer_id, token]() -> OffloadPool::Continuation {
+        drain(peer_id);
+        return nullptr;
+    });
+}
+
+void Ingress::drain(uint64_t peer_id) {
+    for (size_t n = 0; n < config_.drain_batch; ++n) {
+        InboundFrame frame;
+        uint64_t generation;
+        uint64_t ticket;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = peers_.find(peer_id);
+            if (it == peers_.end()) {
+                return;
+            }
+            if (it->second.frames.empty()) {
+                it->second.draining = false;
+                release(it);
+                return;
+            }
+            frame = std::move(it->second.frames.front());
+            it->second.frames.pop_front();
+            generation = generation_;
+            ticket = ++next_ticket_;
+
+            // In place before decoding, for a consumer that finishes first
+            Held held;
+            held.ticket = ticket;
+            it->second.held.push_back(std::move(held));
+        }
+
+        const Verdict verdict = decode_(peer_id, frame.data, ticket);
+
+        bool barrier = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = peers_.find(peer_id);
+            if (generation != generation_ || it == peers_.end()) {
+                continue; // Queued before a reset(): forgotten with the rest
+            }
+            PeerQueue& peer = it->second;
+            Held& held = peer.held.back();   // Only this drain appends
+            held.decoded = true;
+            held.frame = std::move(frame);
+            switch (verdict) {
+                case Verdict::Deliver:
+                    stats_.decoded++;
+                    held.deliver = true;
+                    break;
+
+                case Verdict::Drop:
+                    stats_.dropped++;
+                    break;
+
+                case Verdict::Consumed:
+                    held.consumed = true;
+                    break;
+
+                case Verdict::Barrier:
+                    // Blocked before posting, so an early resume() finds it set
+                    stats_.barriers++;
+                    peer.blocked = true;
+                    peer.draining = false;
+                    held.deliver = true;
+                    held.barrier = true;
+                    barrier = true;
+                    break;
+            }
+        }
+
+        flush(peer_id);
+        if (barrier) {
+            return;
+        }
+    }
+
+    // Yield so one busy peer cannot monopolise a pool thread
+    schedule(peer_id);
+}
+
+void Ingress::flush(uint64_t peer_id) {
+    // Whoever holds the peer's posting flag posts everything ready at the
+    // front, including frames finished by other threads meanwhile
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = peers_.find(peer_id);
+    if (it == peers_.end() || it->second.posting) {
+        return;
+    }
+    it->second.posting = true;
+
+    while (!it->second.held.empty() && it->second.held.front().ready()) {
+        Held held = std::move(it->second.held.front());
+        it->second.held.pop_front();
+        if (!held.deliver) {
+            continue;
+        }
+
+        lock.unlock();
+        post_(std::move(held.frame), held.barrier);
+        lock.lock();
+        it = peers_.find(peer_id); // Kept while posting, but may have moved
+    }
+
+    it->second.posting = false;
+    release(it);
+}
+
+void Ingress::release(std::unordered_map<uint64_t, PeerQueue>::iterator it) {
+    const PeerQueue& peer = it->second;
+    if (peer.frames.empty() && peer.held.empty() && !peer.draining && !peer.blocked && !peer.posting) {
+        peers_.erase(it);
+    }
+}
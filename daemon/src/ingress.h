@@ -0,0 +1,156 @@
+/**
+ * Ingress - Parallel Decode Stage for Inbound Frames
+ *
+ * Inbound data is admitted, decrypted and signature-checked on the
+ * offload pool before it reaches the daemon queue, so the worker only
+ * sees ready-to-deliver messages and its cost per message stays flat as
+ * decoding grows more expensive.
+ *
+ * Frames from one peer are decoded one at a time, in arrival order, by
+ * a drain job on the pool; different peers decode in parallel. A frame
+ * that depends on state only the worker may change (a handshake frame
+ * installs keys the next frame is opened with) is a barrier: it is
+ * posted to the worker undecoded, and that peer's queue waits until the
+ * worker calls resume().
+ *
+ * A frame the decoder hands to another stage (Consumed, e.g. the batch
+ * verifier) keeps its place: the consumer calls finish() with the ticket
+ * it was given, and the peer's later frames are held until it has, so
+ * each peer's frames reach the worker in arrival order whichever thread
+ * finishes them.
+ *
+ * A peer has at most one drain job at a time, across reset() as well:
+ * reset() forgets queued frames but leaves a running drain in charge of
+ * its peer, and a frame it was decoding is dropped. The destructor waits
+ * for drain jobs still queued or running on the pool.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. The decode and post callbacks run on
+ *   pool threads.
+ */
+
+#pragma once
+
+#include "offload_pool.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * One inbound transport payload
+ */
+struct InboundFrame {
+    uint64_t    peer_id;
+    std::string data;
+    int64_t     timestamp;
+};
+
+/**
+ * Ingress counters
+ */
+struct IngressStats {
+    uint64_t decoded;      // Handed to the worker ready to deliver
+    uint64_t dropped;      // Refused while decoding (admission, auth, signature)
+    uint64_t barriers;     // Handed to the worker undecoded
+    uint64_t overflow;     // Dropped because the peer's backlog was full
+};
+
+class Ingress {
+public:
+    enum class Verdict {
+        Deliver,     // Decoded in place; post to the worker
+        Drop,        // Refused
+        Consumed,    // Handed on (e.g. to a batch verifier); posted as is once finish()ed
+        Barrier      // Needs the worker; hold the peer until resume()
+    };
+
+    // A consumed frame's ticket is passed back to finish(); never 0
+    using DecodeFn = std::function<Verdict(uint64_t peer_id, std::string& data, uint64_t ticket)>;
+    using PostFn   = std::function<void(InboundFrame&& frame, bool barrier)>;
+
+    struct Config {
+        size_t max_backlog = 1024;    // Queued frames per peer
+        size_t drain_batch = 32;      // Frames per drain job before yielding
+    };
+
+    Ingress(OffloadPool& pool, DecodeFn decode, PostFn post);
+    Ingress(OffloadPool& pool, DecodeFn decode, PostFn post, const Config& config);
+
+    // Non-copyable
+    Ingress(const Ingress&) = delete;
+    Ingress& operator=(const Ingress&) = delete;
+
+    ~Ingress();
+
+    // Queue a frame; false if the peer's backlog is full
+    bool submit(InboundFrame&& frame);
+
+    // The worker finished the peer's barrier frame
+    void resume(uint64_t peer_id);
+
+    // A consumed frame is done: posted as decoded in its turn if
+    // deliver, else dropped. Tickets from before a reset() are ignored
+    void finish(uint64_t peer_id, uint64_t ticket, bool deliver);
+
+    // Forget all queued frames (barriers posted to a stopped worker never resume)
+    void reset();
+
+    IngressStats stats() const;
+
+private:
+    // A frame in its peer's order, from before it is decoded until it
+    // is posted; a consumer may finish() it before its drain is done
+    struct Held {
+        uint64_t     ticket;
+        bool         decoded  = false;
+        bool         consumed = false;
+        bool         finished = false;
+        bool         deliver  = false;
+        bool         barrier  = false;
+        InboundFrame frame;
+
+        bool ready() const { return decoded && (!consumed || finished); }
+    };
+
+    struct PeerQueue {
+        std::deque<InboundFrame> frames;
+        std::deque<Held>         held;
+        bool                     draining = false;
+        bool                     blocked  = false;
+        bool                     posting  = false;   // One thread posts held frames at a time
+    };
+
+    // Held by each drain job, run or dropped by the pool; the last one
+    // released lets the destructor finish
+    class JobToken {
+    public:
+        explicit JobToken(Ingress& ingress);
+        ~JobToken();
+
+    private:
+        Ingress& ingress_;
+    };
+
+    void schedule(uint64_t peer_id);
+    void drain(uint64_t peer_id);
+    void flush(uint64_t peer_id);
+    void release(std::unordered_map<uint64_t, PeerQueue>::iterator it);
+
+    OffloadPool& pool_;
+    DecodeFn     decode_;
+    PostFn       post_;
+    const Config config_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, PeerQueue> peers_;
+    IngressStats stats_;
+    uint64_t     generation_;    // Bumped by reset(); frames decoded across it are dropped
+    uint64_t     next_ticket_;
+    size_t       jobs_;          // Drain jobs queued or running
+    std::condition_variable jobs_cv_;
+};
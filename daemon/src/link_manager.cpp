@@ -0,0 +1,322 @@
+/**
+ * LinkManager Implementation
+ */
+
+#include "link_manager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace {
+
+// Below this a forgotten device's activity no longer matters
+constexpr double kNegligibleActivity = 0.01;
+
+} // namespace
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+LinkManager::LinkManager()
+    : LinkManager(LinkConfig())
+{
+}
+
+LinkManager::LinkManager(const LinkConfig& config)
+    : config_(config)
+    , connects_(0)
+    , disconnects_(0)
+    , swaps_(0)
+    , timeouts_(0)
+{
+}
+
+void LinkManager::set_config(const LinkConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+LinkConfig LinkManager::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+// =============================================================================
+// MARK: - Inputs
+// =============================================================================
+
+void LinkManager::on_discovery(const std::vector<DiscoveryChange>& changes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const DiscoveryChange& change : changes) {
+        Device& device = devices_[change.id];
+        device.present = change.kind != DiscoveryKind::Lost;
+        device.rssi = change.rssi;
+    }
+}
+
+void LinkManager::bind(const DeviceId& id, uint64_t peer_id, int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // The same connection re-bound to another device
+    auto previous = peers_.find(peer_id);
+    if (previous != peers_.end() && previous->second != id) {
+        auto it = devices_.find(previous->second);
+        if (it != devices_.end()) {
+            it->second.state = State::Idle;
+            it->second.peer_id = 0;
+        }
+    }
+
+    auto inserted = devices_.emplace(id, Device());
+    Device& device = inserted.first->second;
+    if (inserted.second) {
+        // Connected without being scanned: nothing known of its signal
+        device.rssi = config_.rssi_floor;
+    }
+    if (device.state != State::Linked) {
+        device.since_ms = now_ms;
+    }
+    device.state = State::Linked;
+    device.peer_id = peer_id;
+    peers_[peer_id] = id;
+}
+
+void LinkManager::unbind(uint64_t peer_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = peers_.find(peer_id);
+    if (it == peers_.end()) {
+        return;
+    }
+    auto device = devices_.find(it->second);
+    if (device != devices_.end()) {
+        device->second.state = State::Idle;
+        device->second.peer_id = 0;
+    }
+    peers_.erase(it);
+}
+
+void LinkManager::note_activity(uint64_t peer_id, int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = peers_.find(peer_id);
+    if (it == peers_.end()) {
+        return;
+    }
+    Device& device = devices_[it->second];
+    device.activity = decayed_activity(device, now_ms) + 1.0;
+    device.activity_ms = now_ms;
+}
+
+void LinkManager::set_neighbours(const DeviceId& id, std::vector<DeviceId> neighbours) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    devices_[id].neighbours = std::move(neighbours);
+}
+
+// =============================================================================
+// MARK: - Planning
+// =============================================================================
+
+std::vector<LinkRecommendation> LinkManager::plan(int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<LinkRecommendation> out;
+    const int64_t timeout = config_.connect_timeout_ms;
+
+    // Unanswered recommendations lapse; forgotten devices are dropped
+    size_t occupied = 0;
+    for (auto it = devices_.begin(); it != devices_.end();) {
+        Device& device = it->second;
+        if (device.state == State::Pending && now_ms - device.since_ms > timeout) {
+            device.state = State::Idle;
+            device.retry_ms = now_ms + int64_t(config_.retry_backoff_ms);
+            timeouts_++;
+        } else if (device.state == State::Leaving && now_ms - device.since_ms > timeout) {
+            device.state = State::Linked;     // The platform kept it
+        }
+        occupied += device.state == State::Pending || device.state == State::Linked ? 1 : 0;
+
+        const bool forgotten = device.state == State::Idle && !device.present && device.neighbours.empty() &&
+                               now_ms >= device.retry_ms &&
+                               decayed_activity(device, now_ms) < kNegligibleActivity;
+        it = forgotten ? devices_.erase(it) : std::next(it);
+    }
+
+    // Over budget (the budget shrank, or the platform linked on its own)
+    while (occupied > config_.max_links) {
+        DeviceMap::iterator worst = devices_.end();
+        float worst_score = 0;
+        for (auto it = devices_.begin(); it != devices_.end(); ++it) {
+            if (it->second.state != State::Linked) {
+                continue;
+            }
+            const float s = score_locked(it->first, it->second, covered(&it->first), now_ms);
+            if (worst == devices_.end() || s < worst_score) {
+                worst = it;
+                worst_score = s;
+            }
+        }
+        if (worst == devices_.end()) {
+            break; // Only pending connects left; they lapse on their own
+        }
+        recommend(worst->first, worst->second, LinkAction::Disconnect, worst_score, now_ms, out);
+        occupied--;
+    }
+
+    auto eligible = [&](const Device& device) {
+        return device.state == State::Idle && device.present && now_ms >= device.retry_ms;
+    };
+
+    // Fill free slots, best first; each pick changes what the rest add
+    Coverage coverage = covered(nullptr);
+    while (occupied < config_.max_links) {
+        DeviceMap::iterator best = devices_.end();
+        float best_score = 0;
+        for (auto it = devices_.begin(); it != devices_.end(); ++it) {
+            if (!eligible(it->second)) {
+                continue;
+            }
+            const float s = score_locked(it->first, it->second, coverage, now_ms);
+            if (best == devices_.end() || s > best_score) {
+                best = it;
+                best_score = s;
+            }
+        }
+        if (best == devices_.end()) {
+            return out;
+        }
+        recommend(best->first, best->second, LinkAction::Connect, best_score, now_ms, out);
+        coverage.insert(best->first);
+        coverage.insert(best->second.neighbours.begin(), best->second.neighbours.end());
+        occupied++;
+    }
+
+    // Full: one swap at most, and only for a clear gain
+    DeviceMap::iterator worst = devices_.end();
+    float worst_score = 0;
+    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
+        if (it->second.state != State::Linked || now_ms - it->second.since_ms < int64_t(config_.min_link_ms)) {
+            continue;
+        }
+        const float s = score_locked(it->first, it->second, covered(&it->first), now_ms);
+        if (worst == devices_.end() || s < worst_score) {
+            worst = it;
+            worst_score = s;
+        }
+    }
+    if (worst == devices_.end()) {
+        return out;
+    }
+
+    // Candidates are measured against the set without the link they would replace
+    const Coverage without = covered(&worst->first);
+    DeviceMap::iterator best = devices_.end();
+    float best_score = 0;
+    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
+        if (!eligible(it->second)) {
+            continue;
+        }
+        const float s = score_locked(it->first, it->second, without, now_ms);
+        if (best == devices_.end() || s > best_score) {
+            best = it;
+            best_score = s;
+        }
+    }
+    if (best != devices_.end() && best_score > worst_score + config_.switch_margin) {
+        recommend(worst->first, worst->second, LinkAction::Disconnect, worst_score, now_ms, out);
+        recommend(best->first, best->second, LinkAction::Connect, best_score, now_ms, out);
+        swaps_++;
+    }
+    return out;
+}
+
+bool LinkManager::score(const DeviceId& id, int64_t now_ms, float& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = devices_.find(id);
+    if (it == devices_.end()) {
+        return false;
+    }
+    out = score_locked(id, it->second, covered(&id), now_ms);
+    return true;
+}
+
+LinkStats LinkManager::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LinkStats stats{0, 0, 0, connects_, disconnects_, swaps_, timeouts_};
+    for (const auto& entry : devices_) {
+        const Device& device = entry.second;
+        switch (device.state) {
+            case State::Idle:
+                stats.candidates += device.present ? 1 : 0;
+                break;
+            case State::Pending:
+                stats.pending++;
+                break;
+            case State::Linked:
+            case State::Leaving:
+                stats.links++;
+                break;
+        }
+    }
+    return stats;
+}
+
+// =============================================================================
+// MARK: - Internals
+// =============================================================================
+
+LinkManager::Coverage LinkManager::covered(const DeviceId* except) const {
+    Coverage coverage;
+    for (const auto& entry : devices_) {
+        const Device& device = entry.second;
+        if (device.state != State::Linked && device.state != State::Pending) {
+            continue;
+        }
+        if (except && entry.first == *except) {
+            continue;
+        }
+        coverage.insert(entry.first);
+        coverage.insert(device.neighbours.begin(), device.neighbours.end());
+    }
+    return coverage;
+}
+
+float LinkManager::score_locked(const DeviceId& id, const Device& device, const Coverage& coverage, int64_t now_ms) const {
+    const float span = float(std::max(1, config_.rssi_ceiling - config_.rssi_floor));
+    const float quality = std::min(1.0f, std::max(0.0f, float(device.rssi - config_.rssi_floor) / span));
+
+    const double recent = decayed_activity(device, now_ms);
+    const float activity = float(recent / (recent + std::max(0.001f, config_.activity_scale)));
+
+    float diversity = 0.5f;
+    if (!device.neighbours.empty()) {
+        size_t fresh = 0;
+        for (const DeviceId& neighbour : device.neighbours) {
+            fresh += neighbour != id && coverage.count(neighbour) == 0 ? 1 : 0;
+        }
+        diversity = float(fresh) / float(device.neighbours.size());
+    }
+
+    return config_.quality_weight * quality + config_.activity_weight * activity + config_.diversity_weight * diversity;
+}
+
+double LinkManager::decayed_activity(const Device& device, int64_t now_ms) const {
+    if (device.activity <= 0 || config_.activity_half_life_ms == 0) {
+        return device.activity;
+    }
+    const double elapsed = double(std::max<int64_t>(0, now_ms - device.activity_ms));
+    return device.activity * std::exp2(-elapsed / double(config_.activity_half_life_ms));
+}
+
+void LinkManager::recommend(const DeviceId& id, Device& device, LinkAction action, float score, int64_t now_ms,
+                            std::vector<LinkRecommendation>& out) {
+    if (action == LinkAction::Connect) {
+        device.state = State::Pending;
+        connects_++;
+        out.push_back(LinkRecommendation{id, action, 0, score});
+    } else {
+        device.state = State::Leaving;
+        disconnects_++;
+        out.push_back(LinkRecommendation{id, action, device.peer_id, score});
+    }
+    device.since_ms = now_ms;
+}
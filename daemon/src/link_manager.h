@@ -0,0 +1,151 @@
+/**
+ * LinkManager - Neighbour Selection Under a Link Budget
+ *
+ * A phone holds only a handful of BLE connections. The link manager
+ * keeps the target neighbour set: it tracks every discovered device
+ * (fed by ScanFilter changes), ranks them and tells the platform whom
+ * to connect to and whom to drop. The score of a device is
+ *
+ *   quality_weight   * quality     smoothed RSSI mapped onto [0, 1]
+ * + activity_weight  * activity    recent frames to and from it, decayed
+ * + diversity_weight * diversity   share of its neighbours we cannot
+ *                                  already reach through other links
+ *
+ * Neighbour sets are whatever the caller has learned (set_neighbours);
+ * a device with none known scores a neutral 0.5 for diversity.
+ *
+ * Free slots are filled with the best candidates. When the budget is
+ * full, the best candidate replaces the worst link only if it scores
+ * switch_margin higher and that link is at least min_link_ms old; at
+ * most one swap per plan() keeps the set from churning. A recommended
+ * connect that is not bound to a peer within connect_timeout_ms is
+ * abandoned and the device rested for retry_backoff_ms.
+ *
+ * Times are milliseconds from the caller's clock.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe.
+ */
+
+#pragma once
+
+#include "scan_filter.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct LinkConfig {
+    uint32_t max_links             = 4;
+    float    quality_weight        = 0.5f;
+    float    activity_weight       = 0.3f;
+    float    diversity_weight      = 0.2f;
+    int32_t  rssi_floor            = -95;      // Quality 0
+    int32_t  rssi_ceiling          = -45;      // Quality 1
+    float    activity_scale        = 8.0f;     // Recent frames scoring 0.5
+    uint32_t activity_half_life_ms = 60000;
+    float    switch_margin         = 0.15f;    // Score a candidate must gain to evict
+    uint32_t min_link_ms           = 10000;    // Youngest link that may be evicted
+    uint32_t connect_timeout_ms    = 5000;
+    uint32_t retry_backoff_ms      = 30000;
+};
+
+enum class LinkAction { Connect, Disconnect };
+
+/**
+ * What the platform should do next
+ */
+struct LinkRecommendation {
+    DeviceId   id;
+    LinkAction action;
+    uint64_t   peer_id;      // Disconnect: the connection to drop; 0 for Connect
+    float      score;
+};
+
+/**
+ * Link counters
+ */
+struct LinkStats {
+    uint64_t candidates;     // Present devices not linked
+    uint64_t links;          // Bound to a peer
+    uint64_t pending;        // Connect recommended, not yet bound
+    uint64_t connects;       // Connect recommendations
+    uint64_t disconnects;    // Disconnect recommendations
+    uint64_t swaps;          // Links replaced by a better candidate
+    uint64_t timeouts;       // Connects abandoned
+};
+
+class LinkManager {
+public:
+    LinkManager();
+    explicit LinkManager(const LinkConfig& config);
+
+    // Non-copyable
+    LinkManager(const LinkManager&) = delete;
+    LinkManager& operator=(const LinkManager&) = delete;
+
+    void set_config(const LinkConfig& config);
+    LinkConfig config() const;
+
+    // Scan changes: Found/Updated refresh a device's quality, Lost makes
+    // it ineligible (an existing link stays until it disconnects)
+    void on_discovery(const std::vector<DiscoveryChange>& changes);
+
+    // The connection to a device is up as `peer_id`, or has gone
+    void bind(const DeviceId& id, uint64_t peer_id, int64_t now_ms);
+    void unbind(uint64_t peer_id);
+
+    // A frame to or from a peer
+    void note_activity(uint64_t peer_id, int64_t now_ms);
+
+    // Devices a neighbour is itself linked to
+    void set_neighbours(const DeviceId& id, std::vector<DeviceId> neighbours);
+
+    // Recommendations to bring the links towards the target set
+    std::vector<LinkRecommendation> plan(int64_t now_ms);
+
+    // Current score of a known device; false if unknown
+    bool score(const DeviceId& id, int64_t now_ms, float& out) const;
+
+    LinkStats stats() const;
+
+private:
+    enum class State { Idle, Pending, Linked, Leaving };
+
+    struct Device {
+        State    state        = State::Idle;
+        bool     present      = false;
+        int32_t  rssi         = 0;
+        uint64_t peer_id      = 0;
+        int64_t  since_ms     = 0;      // Pending or Linked since
+        int64_t  retry_ms     = 0;      // Not before (after a timeout)
+        double   activity     = 0;      // Decayed frame count
+        int64_t  activity_ms  = 0;
+        std::vector<DeviceId> neighbours;
+    };
+
+    using DeviceMap = std::unordered_map<DeviceId, Device, DeviceIdHash>;
+    using Coverage = std::unordered_set<DeviceId, DeviceIdHash>;
+
+    // Devices reachable through links other than `except` (lock held)
+    Coverage covered(const DeviceId* except) const;
+
+    // Score against what `coverage` already reaches (lock held)
+    float score_locked(const DeviceId& id, const Device& device, const Coverage& coverage, int64_t now_ms) const;
+
+    double decayed_activity(const Device& device, int64_t now_ms) const;
+
+    void recommend(const DeviceId& id, Device& device, LinkAction action, float score, int64_t now_ms,
+                   std::vector<LinkRecommendation>& out);
+
+    mutable std::mutex mutex_;
+    LinkConfig config_;
+    DeviceMap devices_;
+    std::unordered_map<uint64_t, DeviceId> peers_;
+    uint64_t connects_;
+    uint64_t disconnects_;
+    uint64_t swaps_;
+    uint64_t timeouts_;
+};
@@ -0,0 +1,263 @@
+/**
+ * AsyncLog Implementation
+ */
+
+#include "logger.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+void append_int(std::string& line, long long value) {
+    char text[24];
+    std::snprintf(text, sizeof(text), "%lld", value);
+    line.append(text);
+}
+
+void append_uint(std::string& line, unsigned long long value) {
+    char text[24];
+    std::snprintf(text, sizeof(text), "%llu", value);
+    line.append(text);
+}
+
+void append_double(std::string& line, double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%g", value);
+    line.append(text);
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+AsyncLog& AsyncLog::instance() {
+    static AsyncLog log;
+    return log;
+}
+
+AsyncLog::AsyncLog()
+    : ring_(new Record[kCapacity])
+    , enqueue_pos_(0)
+    , dequeue_pos_(0)
+    , sleeping_(false)
+    , written_(0)
+    , dropped_(0)
+    , truncated_(0)
+    , running_(true)
+{
+    for (size_t i = 0; i < kCapacity; ++i) {
+        ring_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+AsyncLog::~AsyncLog() {
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void AsyncLog::set_sink(Sink sink) {
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    sink_ = std::move(sink);
+}
+
+LogStats AsyncLog::stats() const {
+    return LogStats{
+        written_.load(std::memory_order_relaxed),
+        dropped_.load(std::memory_order_relaxed),
+        truncated_.load(std::memory_order_relaxed)
+    };
+}
+
+// =============================================================================
+// MARK: - Producers
+// =============================================================================
+
+AsyncLog::Record* AsyncLog::claim() {
+    // Bounded MPMC ring (Vyukov): a slot is free for position p when its
+    // sequence equals p
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Record& record = ring_[pos & (kCapacity - 1)];
+        const uint64_t seq = record.seq.load(std::memory_order_acquire);
+        const int64_t diff = int64_t(seq) - int64_t(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &record;
+            }
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void AsyncLog::publish(Record* record) {
+    const uint64_t pos = record->seq.load(std::memory_order_relaxed);
+    record->seq.store(pos + 1, std::memory_order_release);
+
+    // Only a sleeping logger needs the lock and a notify
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_.notify_one();
+    }
+}
+
+bool AsyncLog::put(Record& record, Tag tag, const void* bytes, size_t size) {
+    if (record.used + 1 + size > kDataSize) {
+        record.truncated = true;
+        return false;
+    }
+    record.data[record.used] = uint8_t(tag);
+    std::memcpy(record.data + record.used + 1, bytes, size);
+    record.used = uint16_t(record.used + 1 + size);
+    return true;
+}
+
+void AsyncLog::encode_string(Record& record, const char* text, size_t size) {
+    // Length byte, then the bytes kept
+    uint8_t buffer[1 + kMaxString];
+    const size_t kept = std::min(size, kMaxString);
+    buffer[0] = uint8_t(kept);
+    std::memcpy(buffer + 1, text, kept);
+    if (!put(record, Tag::String, buffer, 1 + kept)) {
+        return;
+    }
+    if (kept < size) {
+        record.truncated = true;
+    }
+}
+
+void AsyncLog::encode_sensitive(Record& record, const std::string& value) {
+    if (!LogControl::redacting()) {
+        encode_string(record, value.data(), value.size());
+        return;
+    }
+    const uint64_t size = value.size();
+    put(record, Tag::Redacted, &size, sizeof(size));
+}
+
+// =============================================================================
+// MARK: - Logging Thread
+// =============================================================================
+
+void AsyncLog::run() {
+    std::string line;
+    for (;;) {
+        const uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Record& record = ring_[pos & (kCapacity - 1)];
+
+        if (record.seq.load(std::memory_order_acquire) == pos + 1) {
+            line.clear();
+            format(record, line);
+            if (record.truncated) {
+                truncated_.fetch_add(1, std::memory_order_relaxed);
+            }
+            const LogLevel level = record.level;
+            record.seq.store(pos + kCapacity, std::memory_order_release);
+            dequeue_pos_.store(pos + 1, std::memory_order_release);
+
+            {
+                std::lock_guard<std::mutex> lock(sink_mutex_);
+                if (sink_) {
+                    sink_(level, line.c_str(), line.size());
+                } else {
+                    line.push_back('\n');
+                    std::fwrite(line.data(), 1, line.size(), stderr);
+                }
+            }
+            written_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Nothing ready: report progress to flush(), then sleep until a
+        // producer sees sleeping_ and wakes us
+        std::unique_lock<std::mutex> lock(mutex_);
+        drained_.notify_all();
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (record.seq.load(std::memory_order_acquire) != pos + 1) {
+            if (!running_) {
+                sleeping_.store(false, std::memory_order_relaxed);
+                return;
+            }
+            wake_.wait(lock);
+        }
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+}
+
+void AsyncLog::flush() {
+    const uint64_t target = enqueue_pos_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_.notify_one();
+    drained_.wait(lock, [this, target] {
+        return dequeue_pos_.load(std::memory_order_acquire) >= target || !running_;
+    });
+}
+
+void AsyncLog::format(const Record& record, std::string& line) const {
+    size_t at = 0;
+    while (at < record.used) {
+        const Tag tag = Tag(record.data[at++]);
+        switch (tag) {
+            case Tag::Literal: {
+                const char* text;
+                std::memcpy(&text, record.data + at, sizeof(text));
+                line.append(text);
+                at += sizeof(text);
+                break;
+            }
+            case Tag::Int: {
+                int64_t value;
+                std::memcpy(&value, record.data + at, sizeof(value));
+                append_int(line, static_cast<long long>(value));
+                at += sizeof(value);
+                break;
+            }
+            case Tag::UInt: {
+                uint64_t value;
+                std::memcpy(&value, record.data + at, sizeof(value));
+                append_uint(line, static_cast<unsigned long long>(value));
+                at += sizeof(value);
+                break;
+            }
+            case Tag::Double: {
+                double value;
+                std::memcpy(&value, record.data + at, sizeof(value));
+                append_double(line, value);
+                at += sizeof(value);
+                break;
+            }
+            case Tag::String: {
+                const size_t size = record.data[at++];
+                line.append(reinterpret_cast<const char*>(record.data + at), size);
+                at += size;
+                break;
+            }
+            case Tag::Redacted: {
+                uint64_t size;
+                std::memcpy(&size, record.data + at, sizeof(size));
+                line.append("<");
+                append_uint(line, static_cast<unsigned long long>(size));
+                line.append(" bytes>");
+                at += sizeof(size);
+                break;
+            }
+        }
+    }
+    if (record.truncated) {
+        line.append("...");
+    }
+}
@@ -0,0 +1,220 @@
+/**
+ * AsyncLog - Binary Asynchronous Logging
+ *
+ * Logging on the worker used to format every line (payload included)
+ * through std::cout, taking the iostream lock and flushing per message.
+ * Here a log call only encodes its arguments into a fixed-size record:
+ *
+ *   literal("...")       the pointer (literals outlive the process)
+ *   integers, doubles    the raw value
+ *   strings, char arrays copied, cut at kMaxString bytes
+ *   Sensitive            only its length, unless redaction is off
+ *
+ * A bare char array may be a local buffer or a record field, so it is
+ * copied like any string; only literal() opts into the pointer.
+ *
+ * Records go into a bounded lock-free MPSC ring; one background thread
+ * formats them and hands each line to the sink (stderr by default).
+ * When the ring is full the record is dropped and counted; a log call
+ * never blocks. The thread sleeps on a condition variable while there
+ * is nothing to write, so an idle process has no logging wakeups.
+ *
+ * The level threshold and redaction are process-wide (LogControl) and
+ * are checked before anything is encoded.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. The sink runs on the logging thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+/**
+ * A value that may identify a person (message bodies): logged as its
+ * size while redaction is on
+ */
+struct Sensitive {
+    const std::string& value;
+};
+
+inline Sensitive sensitive(const std::string& value) {
+    return Sensitive{value};
+}
+
+/**
+ * A string literal, logged by pointer instead of copied
+ */
+struct LogLiteral {
+    const char* text;
+};
+
+template <size_t N>
+constexpr LogLiteral literal(const char (&text)[N]) {
+    return LogLiteral{text};
+}
+
+/**
+ * Process-wide level threshold and redaction switch
+ */
+struct LogControl {
+    static void set_level(LogLevel level) { level_ref().store(uint8_t(level), std::memory_order_relaxed); }
+    static LogLevel level() { return LogLevel(level_ref().load(std::memory_order_relaxed)); }
+    static bool enabled(LogLevel level) { return uint8_t(level) >= level_ref().load(std::memory_order_relaxed); }
+
+    static void set_redaction(bool redact) { redact_ref().store(redact, std::memory_order_relaxed); }
+    static bool redacting() { return redact_ref().load(std::memory_order_relaxed); }
+
+private:
+    static std::atomic<uint8_t>& level_ref() {
+        static std::atomic<uint8_t> level(uint8_t(LogLevel::Info));
+        return level;
+    }
+    static std::atomic<bool>& redact_ref() {
+        static std::atomic<bool> redact(true);
+        return redact;
+    }
+};
+
+/**
+ * Logging counters
+ */
+struct LogStats {
+    uint64_t written;      // Lines handed to the sink
+    uint64_t dropped;      // Records lost to a full ring
+    uint64_t truncated;    // Records whose arguments did not all fit
+};
+
+class AsyncLog {
+public:
+    using Sink = std::function<void(LogLevel level, const char* line, size_t length)>;
+
+    static constexpr size_t kCapacity  = 1024;   // Records in the ring
+    static constexpr size_t kDataSize  = 224;    // Encoded arguments per record
+    static constexpr size_t kMaxString = 64;     // Bytes kept of a copied string
+
+    // The process's log (created, with its thread, on first use)
+    static AsyncLog& instance();
+
+    ~AsyncLog();
+
+    // Non-copyable
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+
+    // Encode and queue one line; callers check LogControl::enabled first
+    template <typename... Args>
+    void write(LogLevel level, const Args&... args) {
+        Record* record = claim();
+        if (!record) {
+            return;
+        }
+        record->level = level;
+        record->used = 0;
+        record->truncated = false;
+        (encode(*record, args), ...);
+        publish(record);
+    }
+
+    // Where formatted lines go (nullptr = stderr)
+    void set_sink(Sink sink);
+
+    // Block until everything queued so far has reached the sink
+    void flush();
+
+    LogStats stats() const;
+
+private:
+    enum class Tag : uint8_t { Literal, Int, UInt, Double, String, Redacted };
+
+    struct Record {
+        std::atomic<uint64_t> seq;
+        LogLevel level;
+        bool     truncated;
+        uint16_t used;
+        uint8_t  data[kDataSize];
+    };
+
+    AsyncLog();
+
+    Record* claim();
+    void publish(Record* record);
+
+    // Append one tagged value; false (and truncated) if it does not fit
+    bool put(Record& record, Tag tag, const void* bytes, size_t size);
+
+    // Character arrays are copied up to their first NUL; only literal()
+    // is kept by pointer
+    template <typename T>
+    void encode(Record& record, const T& value) {
+        if constexpr (std::is_same<T, LogLiteral>::value) {
+            put(record, Tag::Literal, &value.text, sizeof(value.text));
+        } else if constexpr (std::is_array<T>::value) {
+            encode_string(record, value, strnlen(value, std::extent<T>::value));
+        } else if constexpr (std::is_same<T, std::string>::value) {
+            encode_string(record, value.data(), value.size());
+        } else if constexpr (std::is_same<T, Sensitive>::value) {
+            encode_sensitive(record, value.value);
+        } else if constexpr (std::is_same<T, bool>::value) {
+            encode_string(record, value ? "true" : "false", value ? 4 : 5);
+        } else if constexpr (std::is_same<T, char>::value) {
+            encode_string(record, &value, 1);
+        } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+            const int64_t wide = value;
+            put(record, Tag::Int, &wide, sizeof(wide));
+        } else if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+            const uint64_t wide = uint64_t(value);
+            put(record, Tag::UInt, &wide, sizeof(wide));
+        } else if constexpr (std::is_floating_point<T>::value) {
+            const double wide = value;
+            put(record, Tag::Double, &wide, sizeof(wide));
+        } else {
+            static_assert(std::is_convertible<T, const char*>::value, "unsupported log argument");
+            const char* text = value;
+            encode_string(record, text, std::strlen(text));
+        }
+    }
+
+    void encode_string(Record& record, const char* text, size_t size);
+    void encode_sensitive(Record& record, const std::string& value);
+
+    // Logging thread
+    void run();
+    void format(const Record& record, std::string& line) const;
+
+    std::unique_ptr<Record[]> ring_;
+    alignas(64) std::atomic<uint64_t> enqueue_pos_;
+    alignas(64) std::atomic<uint64_t> dequeue_pos_;
+    std::atomic<bool>     sleeping_;
+    std::atomic<uint64_t> written_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> truncated_;
+
+    std::mutex              mutex_;
+    std::condition_variable wake_;
+    std::condition_variable drained_;
+    bool                    running_;
+
+    std::mutex sink_mutex_;
+    Sink       sink_;
+
+    std::thread thread_;
+};
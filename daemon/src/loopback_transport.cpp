@@ -12,12 +12,7 @@ Loopback_transport::Loopback_transport(Daemon& d) : daemon_(d) {
 }
 
 void Loopback_transport::send(uint64_t peer_id, const std::string& data) {
-    // Create a "received" event that echoes the message back
-    Daemon::Event event;
-    event.type = Daemon::EventType::DataReceived;
-    event.peer_id = peer_id;
-    event.data = data;
-    
-    daemon_.enqueue_event(std::move(event));
+    // Echo the message back as received data
+    daemon_.submit_inbound(peer_id, data.data(), data.size());
 }
 
@@ -0,0 +1,230 @@
+/**
+ * LZ Codec Implementation
+ *
+ * Sequence format (LZ4 block):
+ *   token        high nibble literal length, low nibble match length - 4
+ *   [len bytes]  255-continued extension when a nibble is 15
+ *   literals
+ *   u16 offset   little-endian match distance (absent in the last sequence)
+ *   [len bytes]  match length extension
+ *
+ * The last 5 bytes are always literals and no match starts within the
+ * last 12 bytes, as the format requires.
+ */
+
+#include "lz_codec.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr size_t   kMinMatch     = 4;
+constexpr size_t   kLastLiterals = 5;
+constexpr size_t   kMatchLimit   = 12;
+constexpr int      kHashBits     = 12;
+constexpr uint32_t kMaxDistance  = 65535;
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t hash4(uint32_t v) {
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+inline bool put_length(uint8_t*& op, const uint8_t* end, size_t len) {
+    while (len >= 255) {
+        if (op >= end) {
+            return false;
+        }
+        *op++ = 255;
+        len -= 255;
+    }
+    if (op >= end) {
+        return false;
+    }
+    *op++ = static_cast<uint8_t>(len);
+    return true;
+}
+
+inline bool emit_literals(uint8_t*& op, const uint8_t* end, uint8_t*& token,
+                          const uint8_t* lit, size_t lit_len) {
+    if (op >= end) {
+        return false;
+    }
+    token = op++;
+    if (lit_len >= 15) {
+        *token = 15 << 4;
+        if (!put_length(op, end, lit_len - 15)) {
+            return false;
+        }
+    } else {
+        *token = static_cast<uint8_t>(lit_len << 4);
+    }
+    if (static_cast<size_t>(end - op) < lit_len) {
+        return false;
+    }
+    std::memcpy(op, lit, lit_len);
+    op += lit_len;
+    return true;
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Compression
+// =============================================================================
+
+size_t lz_compress(const uint8_t* in, size_t len, uint8_t* out, size_t capacity) {
+    uint8_t* op = out;
+    const uint8_t* const oend = out + capacity;
+    uint8_t* token = nullptr;
+
+    const uint8_t* anchor = in;
+
+    if (len > kMatchLimit) {
+        uint32_t table[1 << kHashBits] = {};   // Position + 1 (0 = empty)
+
+        const uint8_t* ip = in;
+        const uint8_t* const match_end = in + len - kMatchLimit;
+        const uint8_t* const copy_end = in + len - kLastLiterals;
+
+        while (ip < match_end) {
+            const uint32_t seq = read32(ip);
+            const uint32_t h = hash4(seq);
+            const uint32_t pos = static_cast<uint32_t>(ip - in);
+            const uint32_t candidate = table[h];
+            table[h] = pos + 1;
+
+            if (candidate == 0 || pos - (candidate - 1) > kMaxDistance ||
+                read32(in + candidate - 1) != seq) {
+                ++ip;
+                continue;
+            }
+
+            const uint8_t* ref = in + candidate - 1;
+
+            // Extend backwards over pending literals
+            while (ip > anchor && ref > in && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+            }
+
+            // Extend forwards
+            const uint8_t* mp = ip + kMinMatch;
+            const uint8_t* rp = ref + kMinMatch;
+            while (mp < copy_end && *mp == *rp) {
+                ++mp;
+                ++rp;
+            }
+
+            if (!emit_literals(op, oend, token, anchor, static_cast<size_t>(ip - anchor))) {
+                return 0;
+            }
+            if (oend - op < 2) {
+                return 0;
+            }
+            const uint16_t distance = static_cast<uint16_t>(ip - ref);
+            *op++ = static_cast<uint8_t>(distance);
+            *op++ = static_cast<uint8_t>(distance >> 8);
+
+            const size_t match_len = static_cast<size_t>(mp - ip) - kMinMatch;
+            if (match_len >= 15) {
+                *token |= 15;
+                if (!put_length(op, oend, match_len - 15)) {
+                    return 0;
+                }
+            } else {
+                *token |= static_cast<uint8_t>(match_len);
+            }
+
+            ip = mp;
+            anchor = ip;
+        }
+    }
+
+    // Final literals
+    if (!emit_literals(op, oend, token, anchor, static_cast<size_t>(in + len - anchor))) {
+        return 0;
+    }
+    return static_cast<size_t>(op - out);
+}
+
+// =============================================================================
+// MARK: - Decompression
+// =============================================================================
+
+bool lz_decompress(const uint8_t* in, size_t len, uint8_t* out, size_t out_len) {
+    const uint8_t* ip = in;
+    const uint8_t* const iend = in + len;
+    uint8_t* op = out;
+    uint8_t* const oend = out + out_len;
+
+    while (ip < iend) {
+        const uint8_t token = *ip++;
+
+        size_t lit_len = token >> 4;
+        if (lit_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) {
+                    return false;
+                }
+                b = *ip++;
+                lit_len += b;
+            } while (b == 255);
+        }
+
+        if (static_cast<size_t>(iend - ip) < lit_len || static_cast<size_t>(oend - op) < lit_len) {
+            return false;
+        }
+        std::memcpy(op, ip, lit_len);
+        op += lit_len;
+        ip += lit_len;
+
+        if (ip == iend) {
+            break; // Last sequence has no match
+        }
+
+        if (iend - ip < 2) {
+            return false;
+        }
+        const size_t distance = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (distance == 0 || distance > static_cast<size_t>(op - out)) {
+            return false;
+        }
+
+        size_t match_len = (token & 15);
+        if (match_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) {
+                    return false;
+                }
+                b = *ip++;
+                match_len += b;
+            } while (b == 255);
+        }
+        match_len += kMinMatch;
+
+        if (static_cast<size_t>(oend - op) < match_len) {
+            return false;
+        }
+
+        // Byte copy: overlapping matches (distance < length) repeat data
+        const uint8_t* ref = op - distance;
+        if (distance >= match_len) {
+            std::memcpy(op, ref, match_len);
+            op += match_len;
+        } else {
+            for (size_t i = 0; i < match_len; ++i) {
+                *op++ = ref[i];
+            }
+        }
+    }
+
+    return op == oend;
+}
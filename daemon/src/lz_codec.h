@@ -0,0 +1,36 @@
+/**
+ * LZ Codec - Fast Block Compression
+ *
+ * LZ4 block format compressor/decompressor. Single pass, greedy matching
+ * over a 4 KiB-entry hash table: compresses at hundreds of MB/s and
+ * decompresses faster still, so archive export/import stays disk-bound.
+ *
+ * The decoder is fully bounds-checked; corrupt input fails cleanly.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Worst-case compressed size for an input of n bytes
+ */
+inline size_t lz_compress_bound(size_t n) {
+    return n + n / 255 + 16;
+}
+
+/**
+ * Compress a block
+ *
+ * @param capacity Size of out; lz_compress_bound(len) always suffices
+ * @return Compressed size, or 0 if it does not fit in capacity
+ */
+size_t lz_compress(const uint8_t* in, size_t len, uint8_t* out, size_t capacity);
+
+/**
+ * Decompress a block whose original size is known
+ *
+ * @return true if the input decoded to exactly out_len bytes
+ */
+bool lz_decompress(const uint8_t* in, size_t len, uint8_t* out, size_t out_len);
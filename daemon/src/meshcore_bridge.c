@@ -21,6 +21,14 @@ meshcore* meshcore_create(void) {
     return meshcore_create_impl();
 }
 
+meshcore* meshcore_create_with_snapshot(const char* snapshot_path, uint32_t interval_ms) {
+    return meshcore_create_with_snapshot_impl(snapshot_path, interval_ms);
+}
+
+meshcore_error meshcore_save_snapshot(meshcore* core) {
+    return meshcore_save_snapshot_impl(core);
+}
+
 void meshcore_destroy(meshcore* core) {
     meshcore_destroy_impl(core);
 }
@@ -63,6 +71,435 @@ meshcore_error meshcore_send_message_to_uid(
     return meshcore_send_message_to_uid_impl(core, uid, message, message_len);
 }
 
+// =============================================================================
+// MARK: - Message Store
+// =============================================================================
+
+meshcore_error meshcore_open_store(meshcore* core, const char* directory) {
+    return meshcore_open_store_impl(core, directory);
+}
+
+meshcore_error meshcore_set_retention_policy(
+    meshcore* core,
+    const char* uid,
+    const meshcore_retention_policy* policy
+) {
+    return meshcore_set_retention_policy_impl(core, uid, policy);
+}
+
+meshcore_error meshcore_delete_conversation(meshcore* core, const char* uid) {
+    return meshcore_delete_conversation_impl(core, uid);
+}
+
+meshcore_error meshcore_get_compaction_stats(const meshcore* core, meshcore_compaction_stats* stats) {
+    return meshcore_get_compaction_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - History Archive
+// =============================================================================
+
+meshcore_error meshcore_export_archive(
+    meshcore* core,
+    const char* path,
+    bool compress,
+    meshcore_progress_callback progress,
+    void* user_data
+) {
+    return meshcore_export_archive_impl(core, path, compress, progress, user_data);
+}
+
+meshcore_error meshcore_import_archive(
+    meshcore* core,
+    const char* path,
+    meshcore_progress_callback progress,
+    void* user_data,
+    uint64_t* imported_out
+) {
+    return meshcore_import_archive_impl(core, path, progress, user_data, imported_out);
+}
+
+// =============================================================================
+// MARK: - Conversation Summaries
+// =============================================================================
+
+void meshcore_set_conversations_callback(
+    meshcore* core,
+    meshcore_conversations_callback callback,
+    void* user_data
+) {
+    meshcore_set_conversations_callback_impl(core, callback, user_data);
+}
+
+size_t meshcore_get_conversations(
+    const meshcore* core,
+    meshcore_conversations_callback callback,
+    void* user_data
+) {
+    return meshcore_get_conversations_impl(core, callback, user_data);
+}
+
+meshcore_error meshcore_mark_read(meshcore* core, const char* uid) {
+    return meshcore_mark_read_impl(core, uid);
+}
+
+// =============================================================================
+// MARK: - Attachments
+// =============================================================================
+
+meshcore_error meshcore_open_chunk_store(meshcore* core, const char* directory) {
+    return meshcore_open_chunk_store_impl(core, directory);
+}
+
+meshcore_error meshcore_attachment_put(meshcore* core, const void* data, size_t len, uint8_t* id_out) {
+    return meshcore_attachment_put_impl(core, data, len, id_out);
+}
+
+meshcore_error meshcore_attachment_send(meshcore* core, uint64_t peer_id, const uint8_t* id) {
+    return meshcore_attachment_send_impl(core, peer_id, id);
+}
+
+meshcore_error meshcore_attachment_read(
+    const meshcore* core,
+    const uint8_t* id,
+    void* buffer,
+    size_t capacity,
+    uint64_t* size_out
+) {
+    return meshcore_attachment_read_impl(core, id, buffer, capacity, size_out);
+}
+
+meshcore_error meshcore_attachment_release(meshcore* core, const uint8_t* id) {
+    return meshcore_attachment_release_impl(core, id);
+}
+
+void meshcore_set_attachment_callback(
+    meshcore* core,
+    meshcore_attachment_callback callback,
+    void* user_data
+) {
+    meshcore_set_attachment_callback_impl(core, callback, user_data);
+}
+
+// =============================================================================
+// MARK: - Encryption
+// =============================================================================
+
+meshcore_error meshcore_set_session_keys(
+    meshcore* core,
+    uint64_t peer_id,
+    const uint8_t* tx_key,
+    const uint8_t* rx_key
+) {
+    return meshcore_set_session_keys_impl(core, peer_id, tx_key, rx_key);
+}
+
+void meshcore_clear_session(meshcore* core, uint64_t peer_id) {
+    meshcore_clear_session_impl(core, peer_id);
+}
+
+meshcore_error meshcore_start_handshake(meshcore* core, uint64_t peer_id) {
+    return meshcore_start_handshake_impl(core, peer_id);
+}
+
+meshcore_error meshcore_get_handshake_stats(const meshcore* core, meshcore_handshake_stats* stats) {
+    return meshcore_get_handshake_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Signatures
+// =============================================================================
+
+void meshcore_set_signed_message_callback(
+    meshcore* core,
+    meshcore_signed_message_callback callback,
+    void* user_data
+) {
+    meshcore_set_signed_message_callback_impl(core, callback, user_data);
+}
+
+meshcore_error meshcore_set_signing_key(meshcore* core, const uint8_t* seed, uint8_t* public_key_out) {
+    return meshcore_set_signing_key_impl(core, seed, public_key_out);
+}
+
+meshcore_error meshcore_enable_batch_verification(
+    meshcore* core,
+    uint32_t max_batch,
+    uint32_t latency_budget_us,
+    uint32_t threads
+) {
+    return meshcore_enable_batch_verification_impl(core, max_batch, latency_budget_us, threads);
+}
+
+meshcore_error meshcore_get_verification_stats(const meshcore* core, meshcore_verification_stats* stats) {
+    return meshcore_get_verification_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Offload Pool
+// =============================================================================
+
+meshcore_error meshcore_get_offload_stats(const meshcore* core, meshcore_offload_stats* stats) {
+    return meshcore_get_offload_stats_impl(core, stats);
+}
+
+meshcore_error meshcore_get_ingress_stats(const meshcore* core, meshcore_ingress_stats* stats) {
+    return meshcore_get_ingress_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Pipelines
+// =============================================================================
+
+size_t meshcore_get_stage_stats(
+    const meshcore* core,
+    meshcore_direction direction,
+    meshcore_stage_stats* stats,
+    size_t capacity
+) {
+    return meshcore_get_stage_stats_impl(core, direction, stats, capacity);
+}
+
+meshcore_error meshcore_remove_stage(meshcore* core, meshcore_direction direction, const char* name) {
+    return meshcore_remove_stage_impl(core, direction, name);
+}
+
+// =============================================================================
+// MARK: - Admission Control
+// =============================================================================
+
+meshcore_error meshcore_set_admission_policy(meshcore* core, const meshcore_admission_policy* policy) {
+    return meshcore_set_admission_policy_impl(core, policy);
+}
+
+meshcore_error meshcore_get_admission_stats(const meshcore* core, meshcore_admission_stats* stats) {
+    return meshcore_get_admission_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Congestion Control
+// =============================================================================
+
+meshcore_error meshcore_set_congestion_policy(meshcore* core, const meshcore_congestion_policy* policy) {
+    return meshcore_set_congestion_policy_impl(core, policy);
+}
+
+meshcore_error meshcore_get_congestion_stats(const meshcore* core, meshcore_congestion_stats* stats) {
+    return meshcore_get_congestion_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Scan Ingest
+// =============================================================================
+
+meshcore_error meshcore_ingest_scan_batch(
+    meshcore* core,
+    const meshcore_scan_report* reports,
+    size_t count,
+    size_t* changes_out
+) {
+    return meshcore_ingest_scan_batch_impl(core, reports, count, changes_out);
+}
+
+void meshcore_set_discovery_callback(
+    meshcore* core,
+    meshcore_discovery_callback callback,
+    void* user_data
+) {
+    meshcore_set_discovery_callback_impl(core, callback, user_data);
+}
+
+meshcore_error meshcore_set_scan_policy(meshcore* core, const meshcore_scan_policy* policy) {
+    return meshcore_set_scan_policy_impl(core, policy);
+}
+
+meshcore_error meshcore_get_scan_stats(const meshcore* core, meshcore_scan_stats* stats) {
+    return meshcore_get_scan_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Neighbour Selection
+// =============================================================================
+
+void meshcore_set_link_callback(
+    meshcore* core,
+    meshcore_link_callback callback,
+    void* user_data
+) {
+    meshcore_set_link_callback_impl(core, callback, user_data);
+}
+
+meshcore_error meshcore_link_bind(meshcore* core, const uint8_t* identifier, uint64_t peer_id) {
+    return meshcore_link_bind_impl(core, identifier, peer_id);
+}
+
+meshcore_error meshcore_link_set_neighbours(
+    meshcore* core,
+    const uint8_t* identifier,
+    const uint8_t* neighbours,
+    size_t count
+) {
+    return meshcore_link_set_neighbours_impl(core, identifier, neighbours, count);
+}
+
+meshcore_error meshcore_set_link_policy(meshcore* core, const meshcore_link_policy* policy) {
+    return meshcore_set_link_policy_impl(core, policy);
+}
+
+meshcore_error meshcore_get_link_stats(const meshcore* core, meshcore_link_stats* stats) {
+    return meshcore_get_link_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Duty Cycle
+// =============================================================================
+
+void meshcore_set_duty_cycle_callback(
+    meshcore* core,
+    meshcore_duty_cycle_callback callback,
+    void* user_data
+) {
+    meshcore_set_duty_cycle_callback_impl(core, callback, user_data);
+}
+
+meshcore_error meshcore_set_outbox_pending(meshcore* core, size_t pending) {
+    return meshcore_set_outbox_pending_impl(core, pending);
+}
+
+meshcore_error meshcore_set_duty_cycle_policy(meshcore* core, const meshcore_duty_cycle_policy* policy) {
+    return meshcore_set_duty_cycle_policy_impl(core, policy);
+}
+
+meshcore_error meshcore_get_duty_schedule(const meshcore* core, meshcore_duty_schedule* schedule) {
+    return meshcore_get_duty_schedule_impl(core, schedule);
+}
+
+meshcore_error meshcore_get_duty_cycle_stats(const meshcore* core, meshcore_duty_cycle_stats* stats) {
+    return meshcore_get_duty_cycle_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Hibernation
+// =============================================================================
+
+meshcore_error meshcore_set_hibernation(meshcore* core, bool enabled) {
+    return meshcore_set_hibernation_impl(core, enabled);
+}
+
+meshcore_error meshcore_set_hibernation_policy(meshcore* core, const meshcore_hibernation_policy* policy) {
+    return meshcore_set_hibernation_policy_impl(core, policy);
+}
+
+meshcore_error meshcore_get_hibernation_stats(const meshcore* core, meshcore_hibernation_stats* stats) {
+    return meshcore_get_hibernation_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Metrics
+// =============================================================================
+
+meshcore_error meshcore_get_stats(const meshcore* core, meshcore_stats* stats) {
+    return meshcore_get_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Tracing
+// =============================================================================
+
+meshcore_error meshcore_set_tracing(meshcore* core, bool enabled) {
+    return meshcore_set_tracing_impl(core, enabled);
+}
+
+meshcore_error meshcore_export_trace(const meshcore* core, const char* path) {
+    return meshcore_export_trace_impl(core, path);
+}
+
+meshcore_error meshcore_clear_trace(meshcore* core) {
+    return meshcore_clear_trace_impl(core);
+}
+
+meshcore_error meshcore_get_trace_stats(const meshcore* core, meshcore_trace_stats* stats) {
+    return meshcore_get_trace_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Logging
+// =============================================================================
+
+meshcore_error meshcore_set_log_level(meshcore_log_level level) {
+    return meshcore_set_log_level_impl(level);
+}
+
+void meshcore_set_log_redaction(bool redact) {
+    meshcore_set_log_redaction_impl(redact);
+}
+
+void meshcore_set_log_callback(meshcore_log_callback callback, void* user_data) {
+    meshcore_set_log_callback_impl(callback, user_data);
+}
+
+void meshcore_flush_log(void) {
+    meshcore_flush_log_impl();
+}
+
+meshcore_error meshcore_get_log_stats(meshcore_log_stats* stats) {
+    return meshcore_get_log_stats_impl(stats);
+}
+
+// =============================================================================
+// MARK: - Flight Recorder
+// =============================================================================
+
+meshcore_error meshcore_dump_flight_recorder(meshcore* core, const char* path) {
+    return meshcore_dump_flight_recorder_impl(core, path);
+}
+
+meshcore_error meshcore_set_flight_dump_path(meshcore* core, const char* path) {
+    return meshcore_set_flight_dump_path_impl(core, path);
+}
+
+meshcore_error meshcore_get_flight_stats(const meshcore* core, meshcore_flight_stats* stats) {
+    return meshcore_get_flight_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Watchdog
+// =============================================================================
+
+meshcore_error meshcore_set_watchdog_policy(meshcore* core, const meshcore_watchdog_policy* policy) {
+    return meshcore_set_watchdog_policy_impl(core, policy);
+}
+
+meshcore_error meshcore_set_stall_callback(meshcore* core, meshcore_stall_callback callback, void* user_data) {
+    return meshcore_set_stall_callback_impl(core, callback, user_data);
+}
+
+meshcore_error meshcore_get_watchdog_stats(const meshcore* core, meshcore_watchdog_stats* stats) {
+    return meshcore_get_watchdog_stats_impl(core, stats);
+}
+
+// =============================================================================
+// MARK: - Contact Directory
+// =============================================================================
+
+meshcore_error meshcore_load_contacts(meshcore* core, const char* path, bool allowlist) {
+    return meshcore_load_contacts_impl(core, path, allowlist);
+}
+
+meshcore_error meshcore_rebuild_contacts(
+    meshcore* core,
+    const meshcore_contact* contacts,
+    size_t count,
+    const char* path,
+    bool allowlist
+) {
+    return meshcore_rebuild_contacts_impl(core, contacts, count, path, allowlist);
+}
+
+meshcore_error meshcore_lookup_contact(const meshcore* core, const char* uid, uint32_t* flags_out) {
+    return meshcore_lookup_contact_impl(core, uid, flags_out);
+}
+
 // =============================================================================
 // MARK: - Peer Management
 // =============================================================================
@@ -12,10 +12,19 @@
 #include "meshcore.h"
 #include "daemon.h"
 #include "loopback_transport.h"
+#include "message_store.h"
+#include "snapshot.h"
+#include "chunk_store.h"
+#include "archive.h"
+#include "contact_directory.h"
 
+#include <algorithm>
 #include <new>
 #include <cstring>
+#include <fstream>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 // =============================================================================
 // MARK: - Internal Structure
@@ -28,8 +37,33 @@
 struct MeshCore {
     Daemon*             daemon;
     Loopback_transport* loopback;     // Default loopback transport for testing
+    MessageStore*       store;         // Persistent history (nullptr until opened)
+    SnapshotWriter*     snapshots;     // Warm-restart snapshots (nullptr if disabled)
+    uint32_t            snapshot_interval_ms; // Period outside hibernation
+    std::mutex          callbacks_mutex; // Serialises the callback setters below
     meshcore_callbacks  callbacks;     // User callbacks
     bool                has_callbacks;
+    
+    meshcore_conversations_callback on_conversations;  // Summary change callback
+    void*                           conversations_user_data;
+    
+    ChunkStore*                  chunks;               // Attachments (nullptr until opened)
+    meshcore_attachment_callback on_attachment;
+    void*                        attachment_user_data;
+    
+    meshcore_discovery_callback  on_discovery;         // Scan changes (registered separately)
+    void*                        discovery_user_data;
+    
+    meshcore_link_callback       on_link;              // Link recommendations (registered separately)
+    void*                        link_user_data;
+    
+    meshcore_duty_cycle_callback on_duty_cycle;        // Schedule changes (registered separately)
+    void*                        duty_cycle_user_data;
+    
+    meshcore_signed_message_callback on_signed_message;   // Signed messages (registered separately)
+    void*                            signed_message_user_data;
+    
+    ContactDirectory*            contacts;             // Admission directory (nullptr until loaded)
 };
 
 // Version string
@@ -39,65 +73,179 @@ static const char* VERSION_STRING = "0.2.0";
 // MARK: - Callback Adapter
 // =============================================================================
 
+/**
+ * Presents summaries as C structs pointing into the C++ strings
+ */
+static void deliver_conversations(
+    const std::vector<ConversationSummary>& summaries,
+    meshcore_conversations_callback callback,
+    void* user_data
+) {
+    std::vector<meshcore_conversation> out;
+    out.reserve(summaries.size());
+    
+    for (const auto& s : summaries) {
+        meshcore_conversation c;
+        c.uid = s.conversation.c_str();
+        c.last_message = s.last_message.c_str();
+        c.last_message_len = s.last_message.size();
+        c.last_timestamp = s.last_timestamp;
+        c.last_outbound = s.last_outbound;
+        c.unread_count = s.unread();
+        c.message_count = s.message_count;
+        out.push_back(c);
+    }
+    
+    callback(user_data, out.data(), out.size());
+}
+
 /**
  * Sets up C++ callbacks that forward to C function pointers
+ *
+ * The worker is already running, so each adapter captures the function
+ * pointer and context it forwards to instead of reading them from the
+ * core; the daemon swaps the whole set in atomically. Called by each
+ * setter with callbacks_mutex held.
  */
 static void setup_daemon_callbacks(MeshCore* core) {
-    if (!core || !core->daemon || !core->has_callbacks) {
+    if (!core || !core->daemon) {
         return;
     }
     
     DaemonCallbacks cpp_callbacks;
     
+    // Conversation summary callback adapter (registered separately)
+    if (core->on_conversations) {
+        const meshcore_conversations_callback callback = core->on_conversations;
+        void* user_data = core->conversations_user_data;
+        cpp_callbacks.on_conversations = [callback, user_data](const std::vector<ConversationSummary>& changed) {
+            deliver_conversations(changed, callback, user_data);
+        };
+    }
+    
+    // Attachment completion adapter (registered separately)
+    if (core->on_attachment) {
+        const meshcore_attachment_callback callback = core->on_attachment;
+        void* user_data = core->attachment_user_data;
+        cpp_callbacks.on_attachment = [callback, user_data](uint64_t peer_id, const ChunkHash& id, uint64_t size) {
+            callback(user_data, peer_id, id.data(), size);
+        };
+    }
+    
+    // Discovery change adapter (registered separately)
+    if (core->on_discovery) {
+        const meshcore_discovery_callback callback = core->on_discovery;
+        void* user_data = core->discovery_user_data;
+        cpp_callbacks.on_discovery = [callback, user_data](const std::vector<DiscoveryChange>& changes) {
+            std::vector<meshcore_discovery> out(changes.size());
+            for (size_t i = 0; i < changes.size(); ++i) {
+                std::memcpy(out[i].identifier, changes[i].id.data(), MESHCORE_DEVICE_ID_SIZE);
+                out[i].kind = static_cast<meshcore_discovery_kind>(changes[i].kind);
+                out[i].rssi = changes[i].rssi;
+                out[i].last_seen = changes[i].last_seen;
+            }
+            callback(user_data, out.data(), out.size());
+        };
+    }
+    
+    // Link recommendation adapter (registered separately)
+    if (core->on_link) {
+        const meshcore_link_callback callback = core->on_link;
+        void* user_data = core->link_user_data;
+        cpp_callbacks.on_link = [callback, user_data](const std::vector<LinkRecommendation>& recommendations) {
+            std::vector<meshcore_link_recommendation> out(recommendations.size());
+            for (size_t i = 0; i < recommendations.size(); ++i) {
+                std::memcpy(out[i].identifier, recommendations[i].id.data(), MESHCORE_DEVICE_ID_SIZE);
+                out[i].action = recommendations[i].action == LinkAction::Connect ? MESHCORE_LINK_CONNECT
+                                                                                 : MESHCORE_LINK_DISCONNECT;
+                out[i].peer_id = recommendations[i].peer_id;
+                out[i].score = recommendations[i].score;
+            }
+            callback(user_data, out.data(), out.size());
+        };
+    }
+    
+    // Duty cycle adapter (registered separately)
+    if (core->on_duty_cycle) {
+        const meshcore_duty_cycle_callback callback = core->on_duty_cycle;
+        void* user_data = core->duty_cycle_user_data;
+        cpp_callbacks.on_duty_cycle = [callback, user_data](const DutySchedule& schedule) {
+            const meshcore_duty_schedule out = {
+                schedule.scan_window_ms,
+                schedule.scan_interval_ms,
+                schedule.advertise_interval_ms,
+                schedule.level
+            };
+            callback(user_data, &out);
+        };
+    }
+    
+    // Signed message adapter (registered separately)
+    if (core->on_signed_message) {
+        const meshcore_signed_message_callback callback = core->on_signed_message;
+        void* user_data = core->signed_message_user_data;
+        cpp_callbacks.on_signed_message = [callback, user_data](
+            uint64_t peer_id,
+            const std::string& peer_uid,
+            const std::string& message,
+            int64_t timestamp,
+            const SignerKey& signer
+        ) {
+            callback(user_data, peer_id, peer_uid.empty() ? nullptr : peer_uid.c_str(),
+                     message.c_str(), message.length(), timestamp, signer.data());
+        };
+    }
+    
+    if (!core->has_callbacks) {
+        core->daemon->set_callbacks(cpp_callbacks);
+        return;
+    }
+    
+    const meshcore_callbacks callbacks = core->callbacks;
+    
     // Message callback adapter
-    if (core->callbacks.on_message) {
-        cpp_callbacks.on_message = [core](
+    if (callbacks.on_message) {
+        cpp_callbacks.on_message = [callbacks](
             uint64_t peer_id,
             const std::string& peer_uid,
             const std::string& message,
             int64_t timestamp
         ) {
-            if (core->callbacks.on_message) {
-                core->callbacks.on_message(
-                    core->callbacks.user_data,
-                    peer_id,
-                    peer_uid.empty() ? nullptr : peer_uid.c_str(),
-                    message.c_str(),
-                    message.length(),
-                    timestamp
-                );
-            }
+            callbacks.on_message(
+                callbacks.user_data,
+                peer_id,
+                peer_uid.empty() ? nullptr : peer_uid.c_str(),
+                message.c_str(),
+                message.length(),
+                timestamp
+            );
         };
     }
     
     // Status callback adapter
-    if (core->callbacks.on_status) {
-        cpp_callbacks.on_status = [core](int status, const std::string& message) {
-            if (core->callbacks.on_status) {
-                core->callbacks.on_status(
-                    core->callbacks.user_data,
-                    status,
-                    message.c_str()
-                );
-            }
+    if (callbacks.on_status) {
+        cpp_callbacks.on_status = [callbacks](int status, const std::string& message) {
+            callbacks.on_status(
+                callbacks.user_data,
+                status,
+                message.c_str()
+            );
         };
     }
     
     // Peer callback adapter
-    if (core->callbacks.on_peer) {
-        cpp_callbacks.on_peer = [core](
+    if (callbacks.on_peer) {
+        cpp_callbacks.on_peer = [callbacks](
             uint64_t peer_id,
             const std::string& peer_uid,
             bool connected
         ) {
-            if (core->callbacks.on_peer) {
-                core->callbacks.on_peer(
-                    core->callbacks.user_data,
-                    peer_id,
-                    peer_uid.empty() ? nullptr : peer_uid.c_str(),
-                    connected
-                );
-            }
+            callbacks.on_peer(
+                callbacks.user_data,
+                peer_id,
+                peer_uid.empty() ? nullptr : peer_uid.c_str(),
+                connected
+            );
         };
     }
     
@@ -109,6 +257,10 @@ static void setup_daemon_callbacks(MeshCore* core) {
 // =============================================================================
 
 meshcore* meshcore_create_impl(void) {
+    return meshcore_create_with_snapshot_impl(nullptr, 0);
+}
+
+meshcore* meshcore_create_with_snapshot_impl(const char* snapshot_path, uint32_t interval_ms) {
     // Allocate MeshCore structure
     MeshCore* core = new (std::nothrow) MeshCore;
     if (!core) {
@@ -118,7 +270,24 @@ meshcore* meshcore_create_impl(void) {
     // Initialize all fields
     core->daemon = nullptr;
     core->loopback = nullptr;
+    core->store = nullptr;
+    core->snapshots = nullptr;
+    core->snapshot_interval_ms = interval_ms;
     core->has_callbacks = false;
+    core->on_conversations = nullptr;
+    core->conversations_user_data = nullptr;
+    core->chunks = nullptr;
+    core->on_attachment = nullptr;
+    core->attachment_user_data = nullptr;
+    core->on_discovery = nullptr;
+    core->discovery_user_data = nullptr;
+    core->on_link = nullptr;
+    core->link_user_data = nullptr;
+    core->on_duty_cycle = nullptr;
+    core->duty_cycle_user_data = nullptr;
+    core->on_signed_message = nullptr;
+    core->signed_message_user_data = nullptr;
+    core->contacts = nullptr;
     std::memset(&core->callbacks, 0, sizeof(core->callbacks));
     
     // Create daemon
@@ -134,17 +303,61 @@ meshcore* meshcore_create_impl(void) {
         core->daemon->set_transport(core->loopback);
     }
     
+    // Restore warm state before any event can run
+    if (snapshot_path && *snapshot_path) {
+        DaemonState state;
+        if (read_snapshot_file(snapshot_path, state)) {
+            core->daemon->restore_known_peers(state.peers);
+            core->daemon->conversations().restore(state.conversations);
+        }
+        
+        core->snapshots = new (std::nothrow) SnapshotWriter;
+        if (core->snapshots) {
+            Daemon* daemon = core->daemon;
+            core->snapshots->start(snapshot_path, interval_ms, [daemon] {
+                DaemonState s;
+                s.peers = daemon->known_peers();
+                s.conversations = daemon->conversations().all();
+                return s;
+            });
+        }
+    }
+    
     // Start the daemon
     core->daemon->start();
     
     return core;
 }
 
+meshcore_error meshcore_save_snapshot_impl(meshcore* core) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!core->snapshots || !core->snapshots->save_now()) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    return MESHCORE_OK;
+}
+
 void meshcore_destroy_impl(meshcore* core) {
     if (!core) {
         return;
     }
     
+    // Stop the writer thread, then take a final snapshot once the worker
+    // has drained so nothing processed is lost
+    if (core->snapshots) {
+        core->snapshots->stop();
+        if (core->daemon) {
+            core->daemon->stop();
+        }
+        core->snapshots->save_now();
+        delete core->snapshots;
+        core->snapshots = nullptr;
+    }
+    
     // Stop and delete daemon
     if (core->daemon) {
         core->daemon->stop();
@@ -158,6 +371,23 @@ void meshcore_destroy_impl(meshcore* core) {
         core->loopback = nullptr;
     }
     
+    // Close the store after the worker is gone
+    if (core->store) {
+        delete core->store;
+        core->store = nullptr;
+    }
+    
+    if (core->chunks) {
+        delete core->chunks;
+        core->chunks = nullptr;
+    }
+    
+    // Joins any background rebuild
+    if (core->contacts) {
+        delete core->contacts;
+        core->contacts = nullptr;
+    }
+    
     delete core;
 }
 
@@ -181,6 +411,7 @@ void meshcore_set_callbacks_impl(meshcore* core, const meshcore_callbacks* callb
         return;
     }
     
+    std::lock_guard<std::mutex> lock(core->callbacks_mutex);
     if (callbacks) {
         core->callbacks = *callbacks;
         core->has_callbacks = true;
@@ -252,49 +483,1502 @@ meshcore_error meshcore_send_message_to_uid_impl(
         return MESHCORE_ERROR_MESSAGE_TOO_LONG;
     }
     
-    // Direct send by UID (doesn't go through queue for lower latency)
+    // Queued behind earlier sends, like meshcore_send_message
     core->daemon->send_to_uid(uid, std::string(message, len));
     
     return MESHCORE_OK;
 }
 
 // =============================================================================
-// MARK: - Peer Management Implementation
+// MARK: - Message Store Implementation
 // =============================================================================
 
-uint32_t meshcore_get_peer_count_impl(const meshcore* core) {
+meshcore_error meshcore_open_store_impl(meshcore* core, const char* directory) {
     if (!core || !core->daemon) {
-        return 0;
+        return MESHCORE_ERROR_UNKNOWN;
     }
-    return core->daemon->get_peer_count();
+    
+    if (!directory || !*directory) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    if (!core->store) {
+        core->store = new (std::nothrow) MessageStore;
+        if (!core->store) {
+            return MESHCORE_ERROR_UNKNOWN;
+        }
+    }
+    
+    // Detach while reopening so the worker never sees a half-loaded index
+    core->daemon->set_message_store(nullptr);
+    if (!core->store->open(directory)) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    core->daemon->set_message_store(core->store);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_set_retention_policy_impl(
+    meshcore* core,
+    const char* uid,
+    const meshcore_retention_policy* policy
+) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!policy || policy->max_age_ms < 0) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    if (!core->store || !core->store->is_open()) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    RetentionPolicy rp;
+    rp.max_age_ms = policy->max_age_ms;
+    rp.max_count = policy->max_count;
+    rp.drop_expired = policy->drop_expired;
+    
+    if (uid) {
+        core->store->set_policy(uid, rp);
+    } else {
+        core->store->set_default_policy(rp);
+    }
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_delete_conversation_impl(meshcore* core, const char* uid) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!uid) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    bool known = false;
+    for (const auto& summary : core->daemon->conversations().all()) {
+        known = known || summary.conversation == uid;
+    }
+    core->daemon->conversations().remove(uid);
+    
+    if (core->store && core->store->is_open()) {
+        known = core->store->remove_conversation(uid) || known;
+    }
+    
+    return known ? MESHCORE_OK : MESHCORE_ERROR_PEER_NOT_FOUND;
 }
 
 // =============================================================================
-// MARK: - Test Helpers Implementation
+// MARK: - History Archive Implementation
 // =============================================================================
 
-void meshcore_simulate_peer_connect_impl(meshcore* core, uint64_t peer_id, const char* uid) {
+static meshcore_error archive_error(ArchiveResult result) {
+    switch (result) {
+        case ArchiveResult::Ok:        return MESHCORE_OK;
+        case ArchiveResult::IoError:   return MESHCORE_ERROR_STORAGE;
+        case ArchiveResult::Corrupt:   return MESHCORE_ERROR_CORRUPT;
+        case ArchiveResult::Cancelled: return MESHCORE_ERROR_CANCELLED;
+    }
+    return MESHCORE_ERROR_UNKNOWN;
+}
+
+static ArchiveProgress archive_progress(meshcore_progress_callback progress, void* user_data) {
+    if (!progress) {
+        return nullptr;
+    }
+    return [progress, user_data](uint64_t messages, uint64_t done, uint64_t total) {
+        return progress(user_data, messages, done, total);
+    };
+}
+
+meshcore_error meshcore_export_archive_impl(
+    meshcore* core,
+    const char* path,
+    bool compress,
+    meshcore_progress_callback progress,
+    void* user_data
+) {
     if (!core || !core->daemon) {
-        return;
+        return MESHCORE_ERROR_UNKNOWN;
     }
     
-    Daemon::Event event;
-    event.type = Daemon::EventType::PeerConnected;
-    event.peer_id = peer_id;
-    event.peer_uid = uid ? uid : "";
+    if (!path || !*path) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
     
-    core->daemon->enqueue_event(std::move(event));
+    if (!core->store || !core->store->is_open()) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    return archive_error(export_archive(*core->store, path, compress,
+                                        archive_progress(progress, user_data), nullptr));
 }
 
-void meshcore_simulate_message_impl(meshcore* core, uint64_t peer_id, const char* message, size_t len) {
-    if (!core || !core->daemon || !message) {
+meshcore_error meshcore_import_archive_impl(
+    meshcore* core,
+    const char* path,
+    meshcore_progress_callback progress,
+    void* user_data,
+    uint64_t* imported_out
+) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!path || !*path) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    if (!core->store || !core->store->is_open()) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    // Imported history is old news: conversations that had nothing unread
+    // before the import stay read afterwards
+    ConversationTable& table = core->daemon->conversations();
+    std::unordered_map<std::string, bool> had_unread;
+    for (const auto& summary : table.all()) {
+        had_unread[summary.conversation] = summary.unread() > 0;
+    }
+    
+    std::unordered_map<std::string, bool> touched;
+    ArchiveStats stats{0, 0, 0};
+    ArchiveResult result = import_archive(
+        *core->store, path, archive_progress(progress, user_data),
+        [&](const std::vector<StoredMessage>& batch) {
+            for (const auto& msg : batch) {
+                table.on_message(msg.conversation, msg.direction == MessageDirection::Outbound,
+                                 msg.timestamp, msg.body);
+                touched[msg.conversation] = true;
+            }
+        },
+        &stats);
+    
+    for (const auto& pair : touched) {
+        auto it = had_unread.find(pair.first);
+        if (it == had_unread.end() || !it->second) {
+            table.mark_read(pair.first);
+        }
+    }
+    
+    if (imported_out) {
+        *imported_out = stats.messages;
+    }
+    
+    return archive_error(result);
+}
+
+// =============================================================================
+// MARK: - Conversation Summary Implementation
+// =============================================================================
+
+void meshcore_set_conversations_callback_impl(
+    meshcore* core,
+    meshcore_conversations_callback callback,
+    void* user_data
+) {
+    if (!core) {
         return;
     }
     
-    Daemon::Event event;
-    event.type = Daemon::EventType::DataReceived;
-    event.peer_id = peer_id;
-    event.data = std::string(message, len);
+    std::lock_guard<std::mutex> lock(core->callbacks_mutex);
+    core->on_conversations = callback;
+    core->conversations_user_data = user_data;
+    setup_daemon_callbacks(core);
+}
+
+size_t meshcore_get_conversations_impl(
+    const meshcore* core,
+    meshcore_conversations_callback callback,
+    void* user_data
+) {
+    if (!core || !core->daemon || !callback) {
+        return 0;
+    }
+    
+    std::vector<ConversationSummary> all = core->daemon->conversations().all();
+    deliver_conversations(all, callback, user_data);
+    return all.size();
+}
+
+meshcore_error meshcore_mark_read_impl(meshcore* core, const char* uid) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!core->daemon->is_running()) {
+        return MESHCORE_ERROR_NOT_RUNNING;
+    }
+    
+    if (!uid) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
     
+    // Queued so the receipt is ordered after messages already in flight
+    Daemon::Event event;
+    event.type = Daemon::EventType::ConversationRead;
+    event.peer_uid = uid;
     core->daemon->enqueue_event(std::move(event));
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_compaction_stats_impl(const meshcore* core, meshcore_compaction_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    if (!core->store) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    CompactionStats cs = core->store->compaction_stats();
+    stats->bytes_reclaimed = cs.bytes_reclaimed;
+    stats->records_dropped = cs.records_dropped;
+    stats->segments_rewritten = cs.segments_rewritten;
+    stats->disk_bytes = cs.disk_bytes;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Attachment Implementation
+// =============================================================================
+
+meshcore_error meshcore_open_chunk_store_impl(meshcore* core, const char* directory) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!directory || !*directory) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    if (!core->chunks) {
+        core->chunks = new (std::nothrow) ChunkStore;
+        if (!core->chunks) {
+            return MESHCORE_ERROR_UNKNOWN;
+        }
+    }
+    
+    // Detach while reopening so no frame sees a half-loaded index
+    core->daemon->set_chunk_store(nullptr);
+    if (!core->chunks->open(directory)) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    core->daemon->set_chunk_store(core->chunks);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_attachment_put_impl(meshcore* core, const void* data, size_t len, uint8_t* id_out) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if ((!data && len > 0) || !id_out) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    if (!core->chunks || !core->chunks->is_open()) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    Manifest manifest;
+    if (!core->chunks->put_attachment(data, len, manifest)) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    std::memcpy(id_out, manifest.id.data(), manifest.id.size());
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_attachment_send_impl(meshcore* core, uint64_t peer_id, const uint8_t* id) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!core->daemon->is_running()) {
+        return MESHCORE_ERROR_NOT_RUNNING;
+    }
+    
+    if (!id) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    if (!core->chunks) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    ChunkHash hash;
+    std::memcpy(hash.data(), id, hash.size());
+    
+    return core->daemon->send_attachment(peer_id, hash) ? MESHCORE_OK : MESHCORE_ERROR_PEER_NOT_FOUND;
+}
+
+meshcore_error meshcore_attachment_read_impl(
+    const meshcore* core,
+    const uint8_t* id,
+    void* buffer,
+    size_t capacity,
+    uint64_t* size_out
+) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!id) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    if (!core->chunks) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    ChunkHash hash;
+    std::memcpy(hash.data(), id, hash.size());
+    
+    Manifest manifest;
+    if (!core->chunks->get_manifest(hash, manifest)) {
+        return MESHCORE_ERROR_PEER_NOT_FOUND;
+    }
+    
+    if (size_out) {
+        *size_out = manifest.total_size;
+    }
+    
+    if (!buffer) {
+        return MESHCORE_OK;
+    }
+    
+    if (capacity < manifest.total_size) {
+        return MESHCORE_ERROR_MESSAGE_TOO_LONG;
+    }
+    
+    std::string bytes;
+    if (!core->chunks->read_attachment(hash, bytes)) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    std::memcpy(buffer, bytes.data(), bytes.size());
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_attachment_release_impl(meshcore* core, const uint8_t* id) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!id) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    if (!core->chunks) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    ChunkHash hash;
+    std::memcpy(hash.data(), id, hash.size());
+    
+    return core->chunks->release_attachment(hash) ? MESHCORE_OK : MESHCORE_ERROR_PEER_NOT_FOUND;
+}
+
+void meshcore_set_attachment_callback_impl(
+    meshcore* core,
+    meshcore_attachment_callback callback,
+    void* user_data
+) {
+    if (!core) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(core->callbacks_mutex);
+    core->on_attachment = callback;
+    core->attachment_user_data = user_data;
+    setup_daemon_callbacks(core);
+}
+
+// =============================================================================
+// MARK: - Encryption Implementation
+// =============================================================================
+
+meshcore_error meshcore_set_session_keys_impl(
+    meshcore* core,
+    uint64_t peer_id,
+    const uint8_t* tx_key,
+    const uint8_t* rx_key
+) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!tx_key || !rx_key) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    SessionKey tx;
+    SessionKey rx;
+    std::memcpy(tx.data(), tx_key, tx.size());
+    std::memcpy(rx.data(), rx_key, rx.size());
+    core->daemon->sessions().install(peer_id, tx, rx);
+    
+    return MESHCORE_OK;
+}
+
+void meshcore_clear_session_impl(meshcore* core, uint64_t peer_id) {
+    if (!core || !core->daemon) {
+        return;
+    }
+    
+    core->daemon->sessions().remove(peer_id);
+}
+
+meshcore_error meshcore_start_handshake_impl(meshcore* core, uint64_t peer_id) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    return core->daemon->start_handshake(peer_id) ? MESHCORE_OK : MESHCORE_ERROR_PEER_NOT_FOUND;
+}
+
+meshcore_error meshcore_get_handshake_stats_impl(const meshcore* core, meshcore_handshake_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const HandshakeStats s = core->daemon->handshake_stats();
+    stats->full = s.full;
+    stats->resumed = s.resumed;
+    stats->rejected = s.rejected;
+    stats->fallbacks = s.fallbacks;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Signatures Implementation
+// =============================================================================
+
+void meshcore_set_signed_message_callback_impl(
+    meshcore* core,
+    meshcore_signed_message_callback callback,
+    void* user_data
+) {
+    if (!core) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(core->callbacks_mutex);
+    core->on_signed_message = callback;
+    core->signed_message_user_data = user_data;
+    setup_daemon_callbacks(core);
+}
+
+meshcore_error meshcore_set_signing_key_impl(meshcore* core, const uint8_t* seed, uint8_t* public_key_out) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!seed) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const SigningKey key = SigningKey::from_seed(seed);
+    core->daemon->set_signing_key(key);
+    
+    if (public_key_out) {
+        std::memcpy(public_key_out, key.public_key.data(), key.public_key.size());
+    }
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_enable_batch_verification_impl(
+    meshcore* core,
+    uint32_t max_batch,
+    uint32_t latency_budget_us,
+    uint32_t threads
+) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (max_batch == 0 || latency_budget_us == 0 || threads == 0) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    VerifierConfig config;
+    config.max_batch = max_batch;
+    config.latency_budget = std::chrono::microseconds(latency_budget_us);
+    config.threads = threads;
+    
+    return core->daemon->enable_batch_verification(config) ? MESHCORE_OK : MESHCORE_ERROR_INVALID_PARAM;
+}
+
+meshcore_error meshcore_get_verification_stats_impl(const meshcore* core, meshcore_verification_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const VerifierStats s = core->daemon->verification_stats();
+    stats->verified = s.verified;
+    stats->rejected = s.rejected;
+    stats->batches = s.batches;
+    stats->over_budget = s.over_budget;
+    stats->max_latency_us = s.max_latency_us;
+    stats->dropped = s.dropped;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Offload Pool Implementation
+// =============================================================================
+
+meshcore_error meshcore_get_offload_stats_impl(const meshcore* core, meshcore_offload_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const OffloadStats s = core->daemon->offload_stats();
+    stats->submitted = s.submitted;
+    stats->completed = s.completed;
+    stats->stolen = s.stolen;
+    stats->blocked = s.blocked;
+    stats->rejected = s.rejected;
+    stats->max_in_flight = s.max_in_flight;
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_ingress_stats_impl(const meshcore* core, meshcore_ingress_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const IngressStats s = core->daemon->ingress_stats();
+    stats->decoded = s.decoded;
+    stats->dropped = s.dropped;
+    stats->barriers = s.barriers;
+    stats->overflow = s.overflow;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Pipeline Implementation
+// =============================================================================
+
+static Daemon::Direction to_direction(meshcore_direction direction) {
+    return direction == MESHCORE_OUTBOUND ? Daemon::Direction::Outbound : Daemon::Direction::Inbound;
+}
+
+size_t meshcore_get_stage_stats_impl(
+    const meshcore* core,
+    meshcore_direction direction,
+    meshcore_stage_stats* stats,
+    size_t capacity
+) {
+    if (!core || !core->daemon) {
+        return 0;
+    }
+    
+    const std::vector<StageStats> all = core->daemon->stage_stats(to_direction(direction));
+    
+    for (size_t i = 0; stats && i < all.size() && i < capacity; ++i) {
+        meshcore_stage_stats& out = stats[i];
+        std::memset(out.name, 0, sizeof(out.name));
+        std::strncpy(out.name, all[i].name.c_str(), sizeof(out.name) - 1);
+        out.batches = all[i].batches;
+        out.events = all[i].events;
+        out.total_ns = all[i].total_ns;
+        out.max_ns = all[i].max_ns;
+    }
+    
+    return all.size();
+}
+
+meshcore_error meshcore_remove_stage_impl(meshcore* core, meshcore_direction direction, const char* name) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!name) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    return core->daemon->remove_stage(to_direction(direction), name) ? MESHCORE_OK : MESHCORE_ERROR_INVALID_PARAM;
+}
+
+// =============================================================================
+// MARK: - Admission Control Implementation
+// =============================================================================
+
+meshcore_error meshcore_set_admission_policy_impl(meshcore* core, const meshcore_admission_policy* policy) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!policy) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    AdmissionConfig config;
+    config.frames_per_sec = policy->frames_per_sec;
+    config.burst_frames = policy->burst_frames;
+    config.bytes_per_sec = policy->bytes_per_sec;
+    config.burst_bytes = policy->burst_bytes;
+    config.quarantine_score = policy->quarantine_score;
+    config.score_decay_per_sec = policy->score_decay_per_sec;
+    config.quarantine_ms = policy->quarantine_ms;
+    config.max_quarantine_ms = policy->max_quarantine_ms;
+    core->daemon->set_admission_config(config);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_admission_stats_impl(const meshcore* core, meshcore_admission_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const AdmissionStats s = core->daemon->admission_stats();
+    stats->admitted = s.admitted;
+    stats->rate_limited = s.rate_limited;
+    stats->quarantine_dropped = s.quarantine_dropped;
+    stats->penalties = s.penalties;
+    stats->quarantines = s.quarantines;
+    stats->quarantined_peers = s.quarantined_peers;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Congestion Control Implementation
+// =============================================================================
+
+meshcore_error meshcore_set_congestion_policy_impl(meshcore* core, const meshcore_congestion_policy* policy) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!policy || policy->low_water > policy->high_water) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    CongestionConfig config;
+    config.queue_capacity = policy->queue_capacity;
+    config.high_water = policy->high_water;
+    config.low_water = policy->low_water;
+    config.signal_interval_ms = policy->signal_interval_ms;
+    config.max_rate = policy->max_rate;
+    config.min_rate = policy->min_rate;
+    config.increase_per_sec = policy->increase_per_sec;
+    config.decrease_percent = policy->decrease_percent;
+    config.decrease_interval_ms = policy->decrease_interval_ms;
+    config.hint_timeout_ms = policy->hint_timeout_ms;
+    config.max_pending = policy->max_pending;
+    core->daemon->set_congestion_config(config);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_congestion_stats_impl(const meshcore* core, meshcore_congestion_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const CongestionStats s = core->daemon->congestion_stats();
+    stats->local_hint = s.local_hint;
+    stats->peak_depth = s.peak_depth;
+    stats->shed = s.shed;
+    stats->signals = s.signals;
+    stats->decreases = s.decreases;
+    stats->held = s.held;
+    stats->dropped = s.dropped;
+    stats->paced_peers = s.paced_peers;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Scan Ingest Implementation
+// =============================================================================
+
+meshcore_error meshcore_ingest_scan_batch_impl(
+    meshcore* core,
+    const meshcore_scan_report* reports,
+    size_t count,
+    size_t* changes_out
+) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!reports && count != 0) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const int64_t now = SystemClock::now_ms();
+    std::vector<ScanReport> batch(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(batch[i].id.data(), reports[i].identifier, MESHCORE_DEVICE_ID_SIZE);
+        batch[i].rssi = reports[i].rssi;
+        batch[i].timestamp_ms = reports[i].timestamp != 0 ? reports[i].timestamp : now;
+    }
+    
+    const size_t changes = core->daemon->ingest_scans(batch.data(), batch.size());
+    if (changes_out) {
+        *changes_out = changes;
+    }
+    
+    return MESHCORE_OK;
+}
+
+void meshcore_set_discovery_callback_impl(
+    meshcore* core,
+    meshcore_discovery_callback callback,
+    void* user_data
+) {
+    if (!core) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(core->callbacks_mutex);
+    core->on_discovery = callback;
+    core->discovery_user_data = user_data;
+    setup_daemon_callbacks(core);
+}
+
+meshcore_error meshcore_set_scan_policy_impl(meshcore* core, const meshcore_scan_policy* policy) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!policy || !(policy->ewma_alpha > 0.0f && policy->ewma_alpha <= 1.0f) ||
+        (policy->filter != MESHCORE_RSSI_EWMA && policy->filter != MESHCORE_RSSI_KALMAN)) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    ScanConfig config;
+    config.filter = policy->filter == MESHCORE_RSSI_EWMA ? RssiFilter::Ewma : RssiFilter::Kalman;
+    config.ewma_alpha = policy->ewma_alpha;
+    config.process_noise = policy->process_noise;
+    config.measurement_noise = policy->measurement_noise;
+    config.rssi_change_db = policy->rssi_change_db;
+    config.min_rssi = policy->min_rssi;
+    config.lost_after_ms = policy->lost_after_ms;
+    config.max_devices = policy->max_devices;
+    core->daemon->set_scan_config(config);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_scan_stats_impl(const meshcore* core, meshcore_scan_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const ScanStats s = core->daemon->scan_stats();
+    stats->reports = s.reports;
+    stats->duplicates = s.duplicates;
+    stats->changes = s.changes;
+    stats->found = s.found;
+    stats->updated = s.updated;
+    stats->lost = s.lost;
+    stats->evicted = s.evicted;
+    stats->devices = s.devices;
+    stats->present = s.present;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Neighbour Selection Implementation
+// =============================================================================
+
+void meshcore_set_link_callback_impl(
+    meshcore* core,
+    meshcore_link_callback callback,
+    void* user_data
+) {
+    if (!core) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(core->callbacks_mutex);
+    core->on_link = callback;
+    core->link_user_data = user_data;
+    setup_daemon_callbacks(core);
+}
+
+meshcore_error meshcore_link_bind_impl(meshcore* core, const uint8_t* identifier, uint64_t peer_id) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!identifier) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    DeviceId id;
+    std::memcpy(id.data(), identifier, id.size());
+    core->daemon->bind_link(id, peer_id);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_link_set_neighbours_impl(
+    meshcore* core,
+    const uint8_t* identifier,
+    const uint8_t* neighbours,
+    size_t count
+) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!identifier || (!neighbours && count != 0)) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    DeviceId id;
+    std::memcpy(id.data(), identifier, id.size());
+    std::vector<DeviceId> known(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(known[i].data(), neighbours + i * MESHCORE_DEVICE_ID_SIZE, MESHCORE_DEVICE_ID_SIZE);
+    }
+    core->daemon->set_link_neighbours(id, std::move(known));
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_set_link_policy_impl(meshcore* core, const meshcore_link_policy* policy) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!policy || policy->rssi_ceiling <= policy->rssi_floor) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    LinkConfig config;
+    config.max_links = policy->max_links;
+    config.quality_weight = policy->quality_weight;
+    config.activity_weight = policy->activity_weight;
+    config.diversity_weight = policy->diversity_weight;
+    config.rssi_floor = policy->rssi_floor;
+    config.rssi_ceiling = policy->rssi_ceiling;
+    config.activity_scale = policy->activity_scale;
+    config.activity_half_life_ms = policy->activity_half_life_ms;
+    config.switch_margin = policy->switch_margin;
+    config.min_link_ms = policy->min_link_ms;
+    config.connect_timeout_ms = policy->connect_timeout_ms;
+    config.retry_backoff_ms = policy->retry_backoff_ms;
+    core->daemon->set_link_config(config);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_link_stats_impl(const meshcore* core, meshcore_link_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const LinkStats s = core->daemon->link_stats();
+    stats->candidates = s.candidates;
+    stats->links = s.links;
+    stats->pending = s.pending;
+    stats->connects = s.connects;
+    stats->disconnects = s.disconnects;
+    stats->swaps = s.swaps;
+    stats->timeouts = s.timeouts;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Duty Cycle Implementation
+// =============================================================================
+
+void meshcore_set_duty_cycle_callback_impl(
+    meshcore* core,
+    meshcore_duty_cycle_callback callback,
+    void* user_data
+) {
+    if (!core) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(core->callbacks_mutex);
+    core->on_duty_cycle = callback;
+    core->duty_cycle_user_data = user_data;
+    setup_daemon_callbacks(core);
+}
+
+meshcore_error meshcore_set_outbox_pending_impl(meshcore* core, size_t pending) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    core->daemon->set_outbox_pending(pending);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_set_duty_cycle_policy_impl(meshcore* core, const meshcore_duty_cycle_policy* policy) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!policy || policy->scan_window_ms == 0 || policy->min_scan_interval_ms == 0 ||
+        policy->min_advertise_interval_ms == 0 ||
+        policy->min_scan_interval_ms > policy->max_scan_interval_ms ||
+        policy->min_advertise_interval_ms > policy->max_advertise_interval_ms) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    DutyCycleConfig config;
+    config.scan_window_ms = policy->scan_window_ms;
+    config.min_scan_interval_ms = policy->min_scan_interval_ms;
+    config.max_scan_interval_ms = policy->max_scan_interval_ms;
+    config.min_advertise_interval_ms = policy->min_advertise_interval_ms;
+    config.max_advertise_interval_ms = policy->max_advertise_interval_ms;
+    config.quiet_after_ms = policy->quiet_after_ms;
+    config.outbox_max_interval_ms = policy->outbox_max_interval_ms;
+    core->daemon->set_duty_cycle_config(config);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_duty_schedule_impl(const meshcore* core, meshcore_duty_schedule* schedule) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!schedule) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const DutySchedule s = core->daemon->duty_schedule();
+    schedule->scan_window_ms = s.scan_window_ms;
+    schedule->scan_interval_ms = s.scan_interval_ms;
+    schedule->advertise_interval_ms = s.advertise_interval_ms;
+    schedule->level = s.level;
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_duty_cycle_stats_impl(const meshcore* core, meshcore_duty_cycle_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const DutyCycleStats s = core->daemon->duty_cycle_stats();
+    stats->traffic = s.traffic;
+    stats->churn = s.churn;
+    stats->outbox = s.outbox;
+    stats->changes = s.changes;
+    stats->backoffs = s.backoffs;
+    stats->wakeups = s.wakeups;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Hibernation Implementation
+// =============================================================================
+
+meshcore_error meshcore_set_hibernation_impl(meshcore* core, bool enabled) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    core->daemon->set_hibernation(enabled);
+    
+    // Periodic snapshots are optional work too
+    if (core->snapshots) {
+        const uint32_t every = core->daemon->hibernation_config().optional_every_ms;
+        core->snapshots->set_interval(enabled ? std::max(core->snapshot_interval_ms, every)
+                                              : core->snapshot_interval_ms);
+    }
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_set_hibernation_policy_impl(meshcore* core, const meshcore_hibernation_policy* policy) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!policy || policy->slack_ms == 0) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    HibernationConfig config;
+    config.slack_ms = policy->slack_ms;
+    config.optional_every_ms = policy->optional_every_ms;
+    core->daemon->set_hibernation_config(config);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_hibernation_stats_impl(const meshcore* core, meshcore_hibernation_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const HibernationStats s = core->daemon->hibernation_stats();
+    stats->hibernating = s.hibernating;
+    stats->wakeups = s.wakeups;
+    stats->traffic_wakeups = s.traffic_wakeups;
+    stats->wakeups_per_minute = s.wakeups_per_minute;
+    stats->coalesced = s.coalesced;
+    stats->deferred = s.deferred;
+    stats->hibernations = s.hibernations;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Metrics Implementation
+// =============================================================================
+
+static void copy_latency(const LatencySummary& from, meshcore_latency& to) {
+    to.count = from.count;
+    to.total_ns = from.total_ns;
+    to.p50_ns = from.p50_ns;
+    to.p90_ns = from.p90_ns;
+    to.p99_ns = from.p99_ns;
+    to.max_ns = from.max_ns;
+}
+
+meshcore_error meshcore_get_stats_impl(const meshcore* core, meshcore_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const MetricsSnapshot s = core->daemon->metrics();
+    stats->events_queued = s.counter(Counter::EventsQueued);
+    stats->events_dispatched = s.counter(Counter::EventsDispatched);
+    stats->batches = s.counter(Counter::Batches);
+    stats->messages_delivered = s.counter(Counter::MessagesDelivered);
+    stats->frames_sent = s.counter(Counter::FramesSent);
+    stats->bytes_sent = s.counter(Counter::BytesSent);
+    stats->queue_depth = s.queue_depth;
+    stats->queue_depth_max = s.queue_depth_max;
+    copy_latency(s.timing(Timing::QueueWait), stats->queue_wait);
+    copy_latency(s.timing(Timing::Handler), stats->handler);
+    copy_latency(s.timing(Timing::Callback), stats->callback);
+    copy_latency(s.timing(Timing::TransportSend), stats->transport_send);
+    copy_latency(s.timing(Timing::SlowHandler), stats->slow_handler);
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Tracing Implementation
+// =============================================================================
+
+meshcore_error meshcore_set_tracing_impl(meshcore* core, bool enabled) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    core->daemon->set_tracing(enabled);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_export_trace_impl(const meshcore* core, const char* path) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!path) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    
+    core->daemon->export_trace(out);
+    out.flush();
+    
+    return out ? MESHCORE_OK : MESHCORE_ERROR_STORAGE;
+}
+
+meshcore_error meshcore_clear_trace_impl(meshcore* core) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    core->daemon->clear_trace();
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_trace_stats_impl(const meshcore* core, meshcore_trace_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const TraceStats s = core->daemon->trace_stats();
+    stats->enabled = s.enabled;
+    stats->recorded = s.recorded;
+    stats->retained = s.retained;
+    stats->threads = s.threads;
+    stats->dropped = s.dropped;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Logging Implementation
+// =============================================================================
+
+meshcore_error meshcore_set_log_level_impl(meshcore_log_level level) {
+    if (int(level) < MESHCORE_LOG_DEBUG || int(level) > MESHCORE_LOG_OFF) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    LogControl::set_level(LogLevel(level));
+    
+    return MESHCORE_OK;
+}
+
+void meshcore_set_log_redaction_impl(bool redact) {
+    LogControl::set_redaction(redact);
+}
+
+void meshcore_set_log_callback_impl(meshcore_log_callback callback, void* user_data) {
+    if (!callback) {
+        AsyncLog::instance().set_sink(nullptr);
+        return;
+    }
+    
+    AsyncLog::instance().set_sink([callback, user_data](LogLevel level, const char* line, size_t) {
+        callback(user_data, meshcore_log_level(level), line);
+    });
+}
+
+void meshcore_flush_log_impl(void) {
+    AsyncLog::instance().flush();
+}
+
+meshcore_error meshcore_get_log_stats_impl(meshcore_log_stats* stats) {
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const LogStats s = AsyncLog::instance().stats();
+    stats->written = s.written;
+    stats->dropped = s.dropped;
+    stats->truncated = s.truncated;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Flight Recorder Implementation
+// =============================================================================
+
+meshcore_error meshcore_dump_flight_recorder_impl(meshcore* core, const char* path) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!path) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    return core->daemon->dump_flight_recorder(path) ? MESHCORE_OK : MESHCORE_ERROR_STORAGE;
+}
+
+meshcore_error meshcore_set_flight_dump_path_impl(meshcore* core, const char* path) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    return core->daemon->set_flight_dump_path(path ? path : "") ? MESHCORE_OK : MESHCORE_ERROR_INVALID_PARAM;
+}
+
+meshcore_error meshcore_get_flight_stats_impl(const meshcore* core, meshcore_flight_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const FlightStats s = core->daemon->flight_stats();
+    stats->capacity = s.capacity;
+    stats->recorded = s.recorded;
+    stats->dumps = s.dumps;
+    stats->armed = s.armed;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Watchdog Implementation
+// =============================================================================
+
+meshcore_error meshcore_set_watchdog_policy_impl(meshcore* core, const meshcore_watchdog_policy* policy) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!policy || policy->check_interval_ms == 0) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    WatchdogConfig config;
+    config.handler_stall_ms = policy->handler_stall_ms;
+    config.queue_stall_ms = policy->queue_stall_ms;
+    config.check_interval_ms = policy->check_interval_ms;
+    config.slow_handler_ms = policy->slow_handler_ms;
+    core->daemon->set_watchdog_config(config);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_set_stall_callback_impl(meshcore* core, meshcore_stall_callback callback, void* user_data) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!callback) {
+        core->daemon->set_stall_callback(nullptr);
+        return MESHCORE_OK;
+    }
+    
+    core->daemon->set_stall_callback([callback, user_data](const StallReport& report) {
+        meshcore_stall_report out;
+        out.kind = report.kind == StallKind::Handler ? MESHCORE_STALL_HANDLER : MESHCORE_STALL_QUEUE;
+        out.phase = report.phase;
+        std::memcpy(out.stage, report.stage, sizeof(out.stage));
+        out.stage[sizeof(out.stage) - 1] = '\0';
+        out.peer_id = report.peer_id;
+        out.running_ms = report.running_ns / 1000000;
+        out.queue_depth = report.queue_depth;
+        out.oldest_queued_ms = report.oldest_queued_ns / 1000000;
+        callback(user_data, &out);
+    });
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_get_watchdog_stats_impl(const meshcore* core, meshcore_watchdog_stats* stats) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!stats) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    const WatchdogStats s = core->daemon->watchdog_stats();
+    stats->checks = s.checks;
+    stats->handler_stalls = s.handler_stalls;
+    stats->queue_stalls = s.queue_stalls;
+    stats->slow_handlers = s.slow_handlers;
+    
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Contact Directory Implementation
+// =============================================================================
+
+static ContactDirectory* ensure_contacts(MeshCore* core) {
+    if (!core->contacts) {
+        core->contacts = new (std::nothrow) ContactDirectory;
+        if (core->contacts) {
+            core->daemon->set_contact_directory(core->contacts);
+        }
+    }
+    return core->contacts;
+}
+
+meshcore_error meshcore_load_contacts_impl(meshcore* core, const char* path, bool allowlist) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!path || !*path) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    ContactDirectory* contacts = ensure_contacts(core);
+    if (!contacts) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!contacts->load(path)) {
+        return MESHCORE_ERROR_STORAGE;
+    }
+    contacts->set_allowlist(allowlist);
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_rebuild_contacts_impl(
+    meshcore* core,
+    const meshcore_contact* contacts,
+    size_t count,
+    const char* path,
+    bool allowlist
+) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!contacts && count > 0) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    std::vector<ContactRecord> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (!contacts[i].uid || std::strlen(contacts[i].uid) > kContactMaxUidBytes) {
+            return MESHCORE_ERROR_INVALID_PARAM;
+        }
+        const uint8_t* key = contacts[i].signing_key;
+        records.push_back(ContactRecord{
+            contacts[i].uid,
+            contacts[i].flags,
+            contacts[i].label ? contacts[i].label : "",
+            key ? std::string(reinterpret_cast<const char*>(key), MESHCORE_PUBLIC_KEY_SIZE) : std::string()
+        });
+    }
+    
+    ContactDirectory* directory = ensure_contacts(core);
+    if (!directory) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    // Applies with the new table; until then the old mode stays in force
+    directory->rebuild(std::move(records), path ? path : "", [directory, allowlist](bool ok) {
+        if (ok) {
+            directory->set_allowlist(allowlist);
+        }
+    });
+    
+    return MESHCORE_OK;
+}
+
+meshcore_error meshcore_lookup_contact_impl(const meshcore* core, const char* uid, uint32_t* flags_out) {
+    if (!core || !core->daemon) {
+        return MESHCORE_ERROR_UNKNOWN;
+    }
+    
+    if (!uid) {
+        return MESHCORE_ERROR_INVALID_PARAM;
+    }
+    
+    ContactRecord record;
+    if (!core->contacts || !core->contacts->lookup(uid, record)) {
+        return MESHCORE_ERROR_PEER_NOT_FOUND;
+    }
+    
+    if (flags_out) {
+        *flags_out = record.flags;
+    }
+    return MESHCORE_OK;
+}
+
+// =============================================================================
+// MARK: - Peer Management Implementation
+// =============================================================================
+
+uint32_t meshcore_get_peer_count_impl(const meshcore* core) {
+    if (!core || !core->daemon) {
+        return 0;
+    }
+    return core->daemon->get_peer_count();
+}
+
+// =============================================================================
+// MARK: - Test Helpers Implementation
+// =============================================================================
+
+void meshcore_simulate_peer_connect_impl(meshcore* core, uint64_t peer_id, const char* uid) {
+    if (!core || !core->daemon) {
+        return;
+    }
+    
+    Daemon::Event event;
+    event.type = Daemon::EventType::PeerConnected;
+    event.peer_id = peer_id;
+    event.peer_uid = uid ? uid : "";
+    
+    core->daemon->enqueue_event(std::move(event));
+}
+
+void meshcore_simulate_message_impl(meshcore* core, uint64_t peer_id, const char* message, size_t len) {
+    if (!core || !core->daemon || !message) {
+        return;
+    }
+    
+    core->daemon->submit_inbound(peer_id, message, len);
 }
@@ -15,6 +15,8 @@ extern "C" {
 
 // Lifecycle
 meshcore* meshcore_create_impl(void);
+meshcore* meshcore_create_with_snapshot_impl(const char* snapshot_path, uint32_t interval_ms);
+meshcore_error meshcore_save_snapshot_impl(meshcore* core);
 void meshcore_destroy_impl(meshcore* core);
 bool meshcore_is_running_impl(const meshcore* core);
 const char* meshcore_get_version_impl(void);
@@ -26,6 +28,113 @@ void meshcore_set_callbacks_impl(meshcore* core, const meshcore_callbacks* callb
 meshcore_error meshcore_send_message_impl(meshcore* core, uint64_t peer_id, const char* message, size_t len);
 meshcore_error meshcore_send_message_to_uid_impl(meshcore* core, const char* uid, const char* message, size_t len);
 
+// Message store
+meshcore_error meshcore_open_store_impl(meshcore* core, const char* directory);
+meshcore_error meshcore_set_retention_policy_impl(meshcore* core, const char* uid, const meshcore_retention_policy* policy);
+meshcore_error meshcore_delete_conversation_impl(meshcore* core, const char* uid);
+meshcore_error meshcore_get_compaction_stats_impl(const meshcore* core, meshcore_compaction_stats* stats);
+
+// History archive
+meshcore_error meshcore_export_archive_impl(meshcore* core, const char* path, bool compress, meshcore_progress_callback progress, void* user_data);
+meshcore_error meshcore_import_archive_impl(meshcore* core, const char* path, meshcore_progress_callback progress, void* user_data, uint64_t* imported_out);
+
+// Conversation summaries
+void meshcore_set_conversations_callback_impl(meshcore* core, meshcore_conversations_callback callback, void* user_data);
+size_t meshcore_get_conversations_impl(const meshcore* core, meshcore_conversations_callback callback, void* user_data);
+meshcore_error meshcore_mark_read_impl(meshcore* core, const char* uid);
+
+// Attachments
+meshcore_error meshcore_open_chunk_store_impl(meshcore* core, const char* directory);
+meshcore_error meshcore_attachment_put_impl(meshcore* core, const void* data, size_t len, uint8_t* id_out);
+meshcore_error meshcore_attachment_send_impl(meshcore* core, uint64_t peer_id, const uint8_t* id);
+meshcore_error meshcore_attachment_read_impl(const meshcore* core, const uint8_t* id, void* buffer, size_t capacity, uint64_t* size_out);
+meshcore_error meshcore_attachment_release_impl(meshcore* core, const uint8_t* id);
+void meshcore_set_attachment_callback_impl(meshcore* core, meshcore_attachment_callback callback, void* user_data);
+
+// Encryption
+meshcore_error meshcore_set_session_keys_impl(meshcore* core, uint64_t peer_id, const uint8_t* tx_key, const uint8_t* rx_key);
+void meshcore_clear_session_impl(meshcore* core, uint64_t peer_id);
+meshcore_error meshcore_start_handshake_impl(meshcore* core, uint64_t peer_id);
+meshcore_error meshcore_get_handshake_stats_impl(const meshcore* core, meshcore_handshake_stats* stats);
+
+// Signatures
+void meshcore_set_signed_message_callback_impl(meshcore* core, meshcore_signed_message_callback callback, void* user_data);
+meshcore_error meshcore_set_signing_key_impl(meshcore* core, const uint8_t* seed, uint8_t* public_key_out);
+meshcore_error meshcore_enable_batch_verification_impl(meshcore* core, uint32_t max_batch, uint32_t latency_budget_us, uint32_t threads);
+meshcore_error meshcore_get_verification_stats_impl(const meshcore* core, meshcore_verification_stats* stats);
+
+// Offload pool
+meshcore_error meshcore_get_offload_stats_impl(const meshcore* core, meshcore_offload_stats* stats);
+meshcore_error meshcore_get_ingress_stats_impl(const meshcore* core, meshcore_ingress_stats* stats);
+
+// Pipelines
+size_t meshcore_get_stage_stats_impl(const meshcore* core, meshcore_direction direction, meshcore_stage_stats* stats, size_t capacity);
+meshcore_error meshcore_remove_stage_impl(meshcore* core, meshcore_direction direction, const char* name);
+
+// Admission control
+meshcore_error meshcore_set_admission_policy_impl(meshcore* core, const meshcore_admission_policy* policy);
+meshcore_error meshcore_get_admission_stats_impl(const meshcore* core, meshcore_admission_stats* stats);
+
+// Congestion control
+meshcore_error meshcore_set_congestion_policy_impl(meshcore* core, const meshcore_congestion_policy* policy);
+meshcore_error meshcore_get_congestion_stats_impl(const meshcore* core, meshcore_congestion_stats* stats);
+
+// Scan ingest
+meshcore_error meshcore_ingest_scan_batch_impl(meshcore* core, const meshcore_scan_report* reports, size_t count, size_t* changes_out);
+void meshcore_set_discovery_callback_impl(meshcore* core, meshcore_discovery_callback callback, void* user_data);
+meshcore_error meshcore_set_scan_policy_impl(meshcore* core, const meshcore_scan_policy* policy);
+meshcore_error meshcore_get_scan_stats_impl(const meshcore* core, meshcore_scan_stats* stats);
+
+// Neighbour selection
+void meshcore_set_link_callback_impl(meshcore* core, meshcore_link_callback callback, void* user_data);
+meshcore_error meshcore_link_bind_impl(meshcore* core, const uint8_t* identifier, uint64_t peer_id);
+meshcore_error meshcore_link_set_neighbours_impl(meshcore* core, const uint8_t* identifier, const uint8_t* neighbours, size_t count);
+meshcore_error meshcore_set_link_policy_impl(meshcore* core, const meshcore_link_policy* policy);
+meshcore_error meshcore_get_link_stats_impl(const meshcore* core, meshcore_link_stats* stats);
+
+// Duty cycle
+void meshcore_set_duty_cycle_callback_impl(meshcore* core, meshcore_duty_cycle_callback callback, void* user_data);
+meshcore_error meshcore_set_outbox_pending_impl(meshcore* core, size_t pending);
+meshcore_error meshcore_set_duty_cycle_policy_impl(meshcore* core, const meshcore_duty_cycle_policy* policy);
+meshcore_error meshcore_get_duty_schedule_impl(const meshcore* core, meshcore_duty_schedule* schedule);
+meshcore_error meshcore_get_duty_cycle_stats_impl(const meshcore* core, meshcore_duty_cycle_stats* stats);
+
+// Hibernation
+meshcore_error meshcore_set_hibernation_impl(meshcore* core, bool enabled);
+meshcore_error meshcore_set_hibernation_policy_impl(meshcore* core, const meshcore_hibernation_policy* policy);
+meshcore_error meshcore_get_hibernation_stats_impl(const meshcore* core, meshcore_hibernation_stats* stats);
+
+// Metrics
+meshcore_error meshcore_get_stats_impl(const meshcore* core, meshcore_stats* stats);
+
+// Tracing
+meshcore_error meshcore_set_tracing_impl(meshcore* core, bool enabled);
+meshcore_error meshcore_export_trace_impl(const meshcore* core, const char* path);
+meshcore_error meshcore_clear_trace_impl(meshcore* core);
+meshcore_error meshcore_get_trace_stats_impl(const meshcore* core, meshcore_trace_stats* stats);
+
+// Logging
+meshcore_error meshcore_set_log_level_impl(meshcore_log_level level);
+void meshcore_set_log_redaction_impl(bool redact);
+void meshcore_set_log_callback_impl(meshcore_log_callback callback, void* user_data);
+void meshcore_flush_log_impl(void);
+meshcore_error meshcore_get_log_stats_impl(meshcore_log_stats* stats);
+
+// Flight recorder
+meshcore_error meshcore_dump_flight_recorder_impl(meshcore* core, const char* path);
+meshcore_error meshcore_set_flight_dump_path_impl(meshcore* core, const char* path);
+meshcore_error meshcore_get_flight_stats_impl(const meshcore* core, meshcore_flight_stats* stats);
+
+// Watchdog
+meshcore_error meshcore_set_watchdog_policy_impl(meshcore* core, const meshcore_watchdog_policy* policy);
+meshcore_error meshcore_set_stall_callback_impl(meshcore* core, meshcore_stall_callback callback, void* user_data);
+meshcore_error meshcore_get_watchdog_stats_impl(const meshcore* core, meshcore_watchdog_stats* stats);
+
+// Contact directory
+meshcore_error meshcore_load_contacts_impl(meshcore* core, const char* path, bool allowlist);
+meshcore_error meshcore_rebuild_contacts_impl(meshcore* core, const meshcore_contact* contacts, size_t count, const char* path, bool allowlist);
+meshcore_error meshcore_lookup_contact_impl(const meshcore* core, const char* uid, uint32_t* flags_out);
+
 // Peer management
 uint32_t meshcore_get_peer_count_impl(const meshcore* core);
 
@@ -0,0 +1,982 @@
+/**
+ * MessageStore Implementation
+ *
+ * Record format (little-endian):
+ *   u32 length        bytes following the 8-byte prefix
+ *   u32 crc32         over the bytes following the prefix
+ *   u8  kind          RecordKind
+ *   u8  direction     MessageDirection
+ *   u16 conv_len
+ *   u64 seq           message seq / tombstone target / truncate bound
+ *   i64 timestamp
+ *   i64 expires_at
+ *   conv_len bytes    conversation key
+ *   remaining bytes   message body
+ */
+
+#include "message_store.h"
+#include "byte_io.h"
+#include "crc32.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t   kPrefixBytes       = 8;
+constexpr size_t   kFixedBodyBytes    = 28;
+constexpr uint32_t kMaxRecordBytes    = 16u << 20;
+constexpr uint64_t kDeadPercent       = 30;
+constexpr int64_t  kRetentionInterval = 1000;
+constexpr int      kRecordsPerCheck   = 16;
+
+bool parse_segment_name(const fs::path& p, uint32_t& id) {
+    if (p.extension() != ".seg") {
+        return false;
+    }
+    const std::string stem = p.stem().string();
+    if (stem.empty() || stem.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    id = static_cast<uint32_t>(std::stoul(stem));
+    return true;
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Constructor/Destructor
+// =============================================================================
+
+MessageStore::MessageStore()
+    : open_(false)
+    , active_(nullptr)
+    , active_id_(0)
+    , next_seq_(1)
+    , retention_dirty_(false)
+    , last_retention_ms_(0)
+    , stats_{0, 0, 0, 0}
+{
+}
+
+MessageStore::~MessageStore() {
+    close();
+}
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+bool MessageStore::open(const std::string& directory) {
+    close();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (!fs::is_directory(directory, ec)) {
+        return false;
+    }
+
+    directory_ = directory;
+
+    // Collect segments, dropping leftovers from an interrupted compaction
+    std::vector<uint32_t> ids;
+    for (const auto& entry : fs::directory_iterator(directory, ec)) {
+        uint32_t id = 0;
+        if (entry.path().extension() == ".tmp") {
+            fs::remove(entry.path(), ec);
+        } else if (parse_segment_name(entry.path(), id)) {
+            ids.push_back(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        replay_segment(ids[i], i + 1 == ids.size());
+    }
+
+    uint32_t active = ids.empty() ? 1 : ids.back();
+    if (!ids.empty() && segments_[active].size >= kSegmentBytes) {
+        ++active;
+    }
+
+    if (!open_active(active)) {
+        segments_.clear();
+        conversations_.clear();
+        dead_records_.clear();
+        expiry_.clear();
+        return false;
+    }
+
+    retention_dirty_ = true;
+    open_ = true;
+    return true;
+}
+
+void MessageStore::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!open_) {
+        return;
+    }
+
+    abort_job();
+
+    if (active_) {
+        std::fflush(active_);
+        ::fsync(::fileno(active_));
+        std::fclose(active_);
+        active_ = nullptr;
+    }
+
+    segments_.clear();
+    conversations_.clear();
+    dead_records_.clear();
+    expiry_.clear();
+    next_seq_ = 1;
+    open_ = false;
+}
+
+bool MessageStore::is_open() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+// =============================================================================
+// MARK: - Messages
+// =============================================================================
+
+uint64_t MessageStore::append(
+    const std::string& conversation,
+    MessageDirection direction,
+    int64_t timestamp,
+    const std::string& body,
+    int64_t expires_at
+) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!open_) {
+        return 0;
+    }
+
+    Record record;
+    record.kind = RecordKind::Message;
+    record.direction = direction;
+    record.seq = next_seq_;
+    record.timestamp = timestamp;
+    record.expires_at = expires_at;
+    record.conversation = conversation;
+    record.body = body;
+
+    Location loc = write_record(record);
+    if (loc.length == 0) {
+        return 0;
+    }
+
+    apply_record(record, loc);
+    return record.seq;
+}
+
+bool MessageStore::remove(const std::string& conversation, uint64_t seq) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto conv = conversations_.find(conversation);
+    if (!open_ || conv == conversations_.end()) {
+        return false;
+    }
+
+    auto it = conv->second.messages.find(seq);
+    if (it == conv->second.messages.end()) {
+        return false;
+    }
+
+    drop_message(conv->second, it, conversation, true);
+    return true;
+}
+
+bool MessageStore::remove_conversation(const std::string& conversation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto conv = conversations_.find(conversation);
+    if (!open_ || conv == conversations_.end()) {
+        return false;
+    }
+
+    truncate_conversation(conversation, conv->second, next_seq_);
+    return true;
+}
+
+size_t MessageStore::message_count(const std::string& conversation) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto conv = conversations_.find(conversation);
+    return conv == conversations_.end() ? 0 : conv->second.messages.size();
+}
+
+size_t MessageStore::load_conversation(
+    const std::string& conversation,
+    std::vector<StoredMessage>& out
+) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto conv = conversations_.find(conversation);
+    if (!open_ || conv == conversations_.end()) {
+        return 0;
+    }
+
+    if (active_) {
+        std::fflush(active_);
+    }
+
+    std::map<uint32_t, std::FILE*> files;
+    std::string raw;
+    Record record;
+    size_t loaded = 0;
+
+    for (const auto& pair : conv->second.messages) {
+        const Location& loc = pair.second.loc;
+
+        std::FILE*& f = files[loc.segment];
+        if (!f) {
+            f = std::fopen(segment_path(loc.segment).c_str(), "rb");
+        }
+        if (!f || std::fseek(f, static_cast<long>(loc.offset), SEEK_SET) != 0 ||
+            !read_record(f, raw, record)) {
+            continue;
+        }
+
+        StoredMessage msg;
+        msg.seq = record.seq;
+        msg.conversation = std::move(record.conversation);
+        msg.direction = record.direction;
+        msg.timestamp = record.timestamp;
+        msg.expires_at = record.expires_at;
+        msg.body = std::move(record.body);
+        out.push_back(std::move(msg));
+        ++loaded;
+    }
+
+    for (auto& pair : files) {
+        if (pair.second) {
+            std::fclose(pair.second);
+        }
+    }
+
+    return loaded;
+}
+
+// =============================================================================
+// MARK: - Bulk Access
+// =============================================================================
+
+bool MessageStore::for_each_message(const MessageVisitor& visit) const {
+    std::vector<uint32_t> ids;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_) {
+            return false;
+        }
+        for (const auto& pair : segments_) {
+            ids.push_back(pair.first);
+        }
+    }
+
+    std::vector<StoredMessage> batch;
+    std::string raw;
+    Record record;
+
+    for (uint32_t id : ids) {
+        batch.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (!open_) {
+                return false;
+            }
+            if (id == active_id_ && active_) {
+                std::fflush(active_);
+            }
+
+            std::FILE* f = std::fopen(segment_path(id).c_str(), "rb");
+            if (!f) {
+                if (segments_.count(id)) {
+                    return false;
+                }
+                continue; // Emptied and removed by compaction meanwhile
+            }
+
+            // Only records the index still points at are live
+            uint64_t offset = 0;
+            while (read_record(f, raw, record)) {
+                if (record.kind == RecordKind::Message) {
+                    auto conv = conversations_.find(record.conversation);
+                    if (conv != conversations_.end()) {
+                        auto it = conv->second.messages.find(record.seq);
+                        if (it != conv->second.messages.end() &&
+                            it->second.loc.segment == id && it->second.loc.offset == offset) {
+                            StoredMessage msg;
+                            msg.seq = record.seq;
+                            msg.conversation = std::move(record.conversation);
+                            msg.direction = record.direction;
+                            msg.timestamp = record.timestamp;
+                            msg.expires_at = record.expires_at;
+                            msg.body = std::move(record.body);
+                            batch.push_back(std::move(msg));
+                        }
+                    }
+                }
+                offset += raw.size();
+            }
+            std::fclose(f);
+        }
+
+        for (const auto& msg : batch) {
+            if (!visit(msg)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+size_t MessageStore::import_messages(const std::vector<StoredMessage>& messages) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!open_) {
+        return 0;
+    }
+
+    size_t written = 0;
+    Record record;
+    record.kind = RecordKind::Message;
+
+    for (const auto& msg : messages) {
+        record.direction = msg.direction;
+        record.seq = next_seq_;
+        record.timestamp = msg.timestamp;
+        record.expires_at = msg.expires_at;
+        record.conversation = msg.conversation;
+        record.body = msg.body;
+
+        Location loc = write_record(record, false);
+        if (loc.length == 0) {
+            break;
+        }
+        apply_record(record, loc);
+        ++written;
+    }
+
+    if (active_) {
+        std::fflush(active_);
+    }
+    retention_dirty_ = true;
+    return written;
+}
+
+// =============================================================================
+// MARK: - Retention
+// =============================================================================
+
+void MessageStore::set_default_policy(const RetentionPolicy& policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    default_policy_ = policy;
+    retention_dirty_ = true;
+}
+
+void MessageStore::set_policy(const std::string& conversation, const RetentionPolicy& policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    policies_[conversation] = policy;
+    retention_dirty_ = true;
+}
+
+const RetentionPolicy& MessageStore::policy_for(const std::string& conversation) const {
+    auto it = policies_.find(conversation);
+    return it == policies_.end() ? default_policy_ : it->second;
+}
+
+// =============================================================================
+// MARK: - Compaction
+// =============================================================================
+
+bool MessageStore::compact_step(std::chrono::microseconds budget, int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!open_) {
+        return false;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+
+    if (retention_dirty_ || now_ms - last_retention_ms_ >= kRetentionInterval) {
+        if (apply_retention(now_ms, deadline)) {
+            return true;
+        }
+        retention_dirty_ = false;
+        last_retention_ms_ = now_ms;
+    }
+
+    while (true) {
+        if (!job_.active && !pick_victim()) {
+            return false;
+        }
+
+        continue_job(deadline);
+
+        if (job_.active || std::chrono::steady_clock::now() >= deadline) {
+            return true;
+        }
+    }
+}
+
+CompactionStats MessageStore::compaction_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    CompactionStats stats = stats_;
+    stats.disk_bytes = 0;
+    for (const auto& pair : segments_) {
+        stats.disk_bytes += pair.second.size;
+    }
+    return stats;
+}
+
+bool MessageStore::apply_retention(int64_t now_ms, std::chrono::steady_clock::time_point deadline) {
+    for (auto& pair : conversations_) {
+        const RetentionPolicy& policy = policy_for(pair.first);
+        Conversation& conv = pair.second;
+
+        size_t excess = 0;
+        if (policy.max_count > 0 && conv.messages.size() > policy.max_count) {
+            excess = conv.messages.size() - policy.max_count;
+        }
+
+        // Retention always drops a prefix in seq order, so one Truncate
+        // record covers every message it removes
+        uint64_t below = 0;
+        for (const auto& msg : conv.messages) {
+            bool too_old = policy.max_age_ms > 0 &&
+                           msg.second.timestamp < now_ms - policy.max_age_ms;
+            if (excess == 0 && !too_old) {
+                break;
+            }
+            below = msg.first + 1;
+            if (excess > 0) {
+                --excess;
+            }
+        }
+
+        if (below > conv.truncated_below) {
+            truncate_conversation(pair.first, conv, below);
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return true;
+            }
+        }
+
+        // The prefix stops at the first message still in date; expired
+        // ones behind it are stragglers and go one by one
+        if (policy.max_age_ms > 0) {
+            const int64_t cutoff = now_ms - policy.max_age_ms;
+            int dropped = 0;
+            while (!conv.stragglers.empty() && conv.stragglers.begin()->first < cutoff) {
+                drop_message(conv, conv.messages.find(conv.stragglers.begin()->second), pair.first, true);
+                if (++dropped % kRecordsPerCheck == 0 &&
+                    std::chrono::steady_clock::now() >= deadline) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    int processed = 0;
+    while (!expiry_.empty() && expiry_.begin()->first <= now_ms) {
+        auto [name, seq] = expiry_.begin()->second;
+        expiry_.erase(expiry_.begin());
+
+        auto conv = conversations_.find(name);
+        if (conv == conversations_.end() || !policy_for(name).drop_expired) {
+            continue;
+        }
+
+        auto it = conv->second.messages.find(seq);
+        if (it != conv->second.messages.end()) {
+            drop_message(conv->second, it, name, true);
+        }
+
+        if (++processed % kRecordsPerCheck == 0 &&
+            std::chrono::steady_clock::now() >= deadline) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool MessageStore::pick_victim() {
+    while (true) {
+        uint32_t victim = 0;
+        uint64_t most_dead = 0;
+
+        for (const auto& pair : segments_) {
+            const Segment& seg = pair.second;
+            if (pair.first == active_id_ || seg.dead_bytes == 0) {
+                continue;
+            }
+            if (seg.dead_bytes * 100 >= seg.size * kDeadPercent && seg.dead_bytes > most_dead) {
+                victim = pair.first;
+                most_dead = seg.dead_bytes;
+            }
+        }
+
+        if (victim == 0) {
+            return false;
+        }
+
+        const std::string path = segment_path(victim);
+        Segment& seg = segments_[victim];
+
+        // Nothing left worth copying: drop the file outright
+        if (seg.dead_bytes >= seg.size) {
+            std::error_code ec;
+            fs::remove(path, ec);
+
+            for (auto it = dead_records_.begin(); it != dead_records_.end();) {
+                if (it->second.segment == victim) {
+                    mark_dead(it->second.tombstone);
+                    it = dead_records_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            stats_.bytes_reclaimed += seg.size;
+            stats_.segments_rewritten++;
+            segments_.erase(victim);
+            continue;
+        }
+
+        job_.in = std::fopen(path.c_str(), "rb");
+        job_.out = std::fopen((path + ".tmp").c_str(), "wb");
+        if (!job_.in || !job_.out) {
+            abort_job();
+            return false;
+        }
+
+        job_.active = true;
+        job_.segment = victim;
+        job_.read_offset = 0;
+        job_.write_offset = 0;
+        job_.old_size = seg.size;
+        job_.relocations.clear();
+        return true;
+    }
+}
+
+bool MessageStore::continue_job(std::chrono::steady_clock::time_point deadline) {
+    std::string raw;
+    Record record;
+    int processed = 0;
+
+    while (true) {
+        if (++processed % kRecordsPerCheck == 0 &&
+            std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+
+        const uint64_t offset = job_.read_offset;
+        if (job_.read_offset >= job_.old_size || !read_record(job_.in, raw, record)) {
+            finish_job();
+            return true;
+        }
+        job_.read_offset += raw.size();
+
+        if (is_live(record, offset)) {
+            if (std::fwrite(raw.data(), 1, raw.size(), job_.out) != raw.size()) {
+                abort_job();
+                return true;
+            }
+
+            Relocation r;
+            r.kind = record.kind;
+            r.conversation = std::move(record.conversation);
+            r.seq = record.seq;
+            r.old_offset = offset;
+            r.new_offset = job_.write_offset;
+            r.length = static_cast<uint32_t>(raw.size());
+            job_.relocations.push_back(std::move(r));
+            job_.write_offset += raw.size();
+        } else if (record.kind == RecordKind::Message) {
+            // The deleted message is physically gone now; its tombstone
+            // no longer needs to survive
+            auto dead = dead_records_.find(record.seq);
+            if (dead != dead_records_.end() && dead->second.segment == job_.segment) {
+                mark_dead(dead->second.tombstone);
+                dead_records_.erase(dead);
+            }
+        }
+    }
+}
+
+bool MessageStore::is_live(const Record& record, uint64_t offset) const {
+    auto at = [&](const Location& loc) {
+        return loc.segment == job_.segment && loc.offset == offset;
+    };
+
+    switch (record.kind) {
+        case RecordKind::Message: {
+            auto conv = conversations_.find(record.conversation);
+            if (conv == conversations_.end()) {
+                return false;
+            }
+            auto it = conv->second.messages.find(record.seq);
+            return it != conv->second.messages.end() && at(it->second.loc);
+        }
+
+        case RecordKind::Tombstone: {
+            auto it = dead_records_.find(record.seq);
+            return it != dead_records_.end() && at(it->second.tombstone);
+        }
+
+        case RecordKind::Truncate: {
+            auto conv = conversations_.find(record.conversation);
+            return conv != conversations_.end() && conv->second.has_truncate &&
+                   at(conv->second.truncate_loc);
+        }
+    }
+
+    return false;
+}
+
+void MessageStore::finish_job() {
+    const std::string path = segment_path(job_.segment);
+    const std::string tmp = path + ".tmp";
+
+    std::fclose(job_.in);
+    job_.in = nullptr;
+
+    std::fflush(job_.out);
+    ::fsync(::fileno(job_.out));
+    std::fclose(job_.out);
+    job_.out = nullptr;
+
+    std::error_code ec;
+    if (job_.write_offset == 0) {
+        fs::remove(tmp, ec);
+        fs::remove(path, ec);
+    } else if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        abort_job();
+        return;
+    }
+
+    // Point the index at the new offsets; anything that died while the
+    // job was in flight is dead weight in the new file
+    uint64_t dead_now = 0;
+    for (const auto& r : job_.relocations) {
+        Location* loc = nullptr;
+
+        if (r.kind == RecordKind::Message) {
+            auto conv = conversations_.find(r.conversation);
+            if (conv != conversations_.end()) {
+                auto it = conv->second.messages.find(r.seq);
+                if (it != conv->second.messages.end()) {
+                    loc = &it->second.loc;
+                }
+            }
+        } else if (r.kind == RecordKind::Tombstone) {
+            auto it = dead_records_.find(r.seq);
+            if (it != dead_records_.end()) {
+                loc = &it->second.tombstone;
+            }
+        } else {
+            auto conv = conversations_.find(r.conversation);
+            if (conv != conversations_.end() && conv->second.has_truncate) {
+                loc = &conv->second.truncate_loc;
+            }
+        }
+
+        if (loc && loc->segment == job_.segment && loc->offset == r.old_offset) {
+            loc->offset = r.new_offset;
+        } else {
+            dead_now += r.length;
+        }
+    }
+
+    stats_.bytes_reclaimed += job_.old_size - job_.write_offset;
+    stats_.segments_rewritten++;
+
+    if (job_.write_offset == 0) {
+        segments_.erase(job_.segment);
+    } else {
+        Segment& seg = segments_[job_.segment];
+        seg.size = job_.write_offset;
+        seg.dead_bytes = dead_now;
+    }
+
+    job_ = CompactionJob();
+}
+
+void MessageStore::abort_job() {
+    if (job_.in) {
+        std::fclose(job_.in);
+    }
+    if (job_.out) {
+        std::fclose(job_.out);
+        std::error_code ec;
+        fs::remove(segment_path(job_.segment) + ".tmp", ec);
+    }
+    job_ = CompactionJob();
+}
+
+// =============================================================================
+// MARK: - Index Maintenance
+// =============================================================================
+
+void MessageStore::apply_record(const Record& record, const Location& loc) {
+    next_seq_ = std::max(next_seq_, record.seq + 1);
+    Conversation& conv = conversations_[record.conversation];
+
+    switch (record.kind) {
+        case RecordKind::Message: {
+            if (record.seq < conv.truncated_below) {
+                mark_dead(loc);
+                break;
+            }
+            conv.messages[record.seq] = IndexEntry{ loc, record.timestamp, record.expires_at };
+            if (record.timestamp < conv.newest) {
+                conv.stragglers.emplace(record.timestamp, record.seq);
+            }
+            conv.newest = std::max(conv.newest, record.timestamp);
+            if (record.expires_at != 0) {
+                expiry_.emplace(record.expires_at, std::make_pair(record.conversation, record.seq));
+            }
+            break;
+        }
+
+        case RecordKind::Tombstone: {
+            auto it = conv.messages.find(record.seq);
+            if (it == conv.messages.end()) {
+                mark_dead(loc);
+                break;
+            }
+            dead_records_[record.seq] = DeadRecord{ it->second.loc.segment, loc };
+            mark_dead(it->second.loc);
+            conv.stragglers.erase(std::make_pair(it->second.timestamp, it->first));
+            conv.messages.erase(it);
+            break;
+        }
+
+        case RecordKind::Truncate: {
+            if (conv.has_truncate) {
+                mark_dead(conv.truncate_loc);
+            }
+            conv.truncate_loc = loc;
+            conv.has_truncate = true;
+            conv.truncated_below = std::max(conv.truncated_below, record.seq);
+
+            auto end = conv.messages.lower_bound(conv.truncated_below);
+            for (auto it = conv.messages.begin(); it != end; ++it) {
+                mark_dead(it->second.loc);
+                conv.stragglers.erase(std::make_pair(it->second.timestamp, it->first));
+            }
+            conv.messages.erase(conv.messages.begin(), end);
+            break;
+        }
+    }
+}
+
+void MessageStore::mark_dead(const Location& loc) {
+    auto it = segments_.find(loc.segment);
+    if (it != segments_.end()) {
+        it->second.dead_bytes += loc.length;
+    }
+}
+
+void MessageStore::drop_message(
+    Conversation& conv,
+    std::map<uint64_t, IndexEntry>::iterator it,
+    const std::string& name,
+    bool tombstone
+) {
+    if (tombstone) {
+        Record record;
+        record.kind = RecordKind::Tombstone;
+        record.direction = MessageDirection::Inbound;
+        record.seq = it->first;
+        record.timestamp = 0;
+        record.expires_at = 0;
+        record.conversation = name;
+
+        Location loc = write_record(record);
+        dead_records_[it->first] = DeadRecord{ it->second.loc.segment, loc };
+    }
+
+    mark_dead(it->second.loc);
+    conv.stragglers.erase(std::make_pair(it->second.timestamp, it->first));
+    conv.messages.erase(it);
+    stats_.records_dropped++;
+}
+
+void MessageStore::truncate_conversation(const std::string& name, Conversation& conv, uint64_t below) {
+    Record record;
+    record.kind = RecordKind::Truncate;
+    record.direction = MessageDirection::Inbound;
+    record.seq = below;
+    record.timestamp = 0;
+    record.expires_at = 0;
+    record.conversation = name;
+
+    const size_t before = conv.messages.size();
+    Location loc = write_record(record);
+    apply_record(record, loc);
+    stats_.records_dropped += before - conv.messages.size();
+}
+
+// =============================================================================
+// MARK: - Segments
+// =============================================================================
+
+std::string MessageStore::segment_path(uint32_t id) const {
+    char name[16];
+    std::snprintf(name, sizeof(name), "%08u.seg", id);
+    return (fs::path(directory_) / name).string();
+}
+
+bool MessageStore::open_active(uint32_t id) {
+    active_ = std::fopen(segment_path(id).c_str(), "ab");
+    if (!active_) {
+        return false;
+    }
+    active_id_ = id;
+    segments_.emplace(id, Segment{ 0, 0 });
+    return true;
+}
+
+bool MessageStore::replay_segment(uint32_t id, bool is_last) {
+    const std::string path = segment_path(id);
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+
+    std::string raw;
+    Record record;
+    uint64_t offset = 0;
+
+    while (read_record(f, raw, record)) {
+        apply_record(record, Location{ id, offset, static_cast<uint32_t>(raw.size()) });
+        offset += raw.size();
+    }
+    std::fclose(f);
+
+    std::error_code ec;
+    const uint64_t file_size = fs::file_size(path, ec);
+    Segment& seg = segments_[id];
+    seg.size = offset;
+
+    // A torn tail on the active segment is a crash mid-append: cut it off.
+    // Garbage inside a sealed segment is left for compaction to drop.
+    if (!ec && file_size > offset) {
+        if (is_last) {
+            fs::resize_file(path, offset, ec);
+        } else {
+            seg.size = file_size;
+            seg.dead_bytes += file_size - offset;
+        }
+    }
+
+    return true;
+}
+
+MessageStore::Location MessageStore::write_record(const Record& record, bool flush) {
+    const std::string raw = encode(record);
+    Segment& seg = segments_[active_id_];
+
+    if (!active_ || std::fwrite(raw.data(), 1, raw.size(), active_) != raw.size()) {
+        return Location{ active_id_, seg.size, 0 };
+    }
+    if (flush) {
+        std::fflush(active_);
+    }
+
+    Location loc{ active_id_, seg.size, static_cast<uint32_t>(raw.size()) };
+    seg.size += raw.size();
+
+    if (seg.size >= kSegmentBytes) {
+        ::fsync(::fileno(active_));
+        std::fclose(active_);
+        active_ = nullptr;
+        open_active(active_id_ + 1);
+    }
+
+    return loc;
+}
+
+// =============================================================================
+// MARK: - Encoding
+// =============================================================================
+
+std::string MessageStore::encode(const Record& record) {
+    std::string raw;
+    raw.reserve(kPrefixBytes + kFixedBodyBytes + record.conversation.size() + record.body.size());
+
+    put_u32(raw, 0);
+    put_u32(raw, 0);
+    put_u8(raw, static_cast<uint8_t>(record.kind));
+    put_u8(raw, static_cast<uint8_t>(record.direction));
+    put_u16(raw, static_cast<uint16_t>(record.conversation.size()));
+    put_u64(raw, record.seq);
+    put_u64(raw, static_cast<uint64_t>(record.timestamp));
+    put_u64(raw, static_cast<uint64_t>(record.expires_at));
+    raw.append(record.conversation);
+    raw.append(record.body);
+
+    const size_t body_len = raw.size() - kPrefixBytes;
+    store_u32(&raw[0], static_cast<uint32_t>(body_len));
+    store_u32(&raw[4], crc32(raw.data() + kPrefixBytes, body_len));
+    return raw;
+}
+
+bool MessageStore::read_record(std::FILE* f, std::string& raw, Record& record) {
+    char prefix[kPrefixBytes];
+    if (std::fread(prefix, 1, kPrefixBytes, f) != kPrefixBytes) {
+        return false;
+    }
+
+    const uint32_t length = get_u32(prefix);
+    if (length < kFixedBodyBytes || length > kMaxRecordBytes) {
+        return false;
+    }
+
+    raw.assign(prefix, kPrefixBytes);
+    raw.resize(kPrefixBytes + length);
+    if (std::fread(&raw[kPrefixBytes], 1, length, f) != length) {
+        return false;
+    }
+
+    const char* body = raw.data() + kPrefixBytes;
+    if (crc32(body, length) != get_u32(prefix + 4)) {
+        return false;
+    }
+
+    const uint16_t conv_len = get_u16(body + 2);
+    if (kFixedBodyBytes + conv_len > length) {
+        return false;
+    }
+
+    record.kind = static_cast<RecordKind>(static_cast<uint8_t>(body[0]));
+    record.direction = static_cast<MessageDirection>(static_cast<uint8_t>(body[1]));
+    record.seq = get_u64(body + 4);
+    record.timestamp = static_cast<int64_t>(get_u64(body + 12));
+    record.expires_at = static_cast<int64_t>(get_u64(body + 20));
+    record.conversation.assign(body + kFixedBodyBytes, conv_len);
+    record.body.assign(body + kFixedBodyBytes + conv_len, length - kFixedBodyBytes - conv_len);
+
+    if (record.kind < RecordKind::Message || record.kind > RecordKind::Truncate) {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,277 @@
+/**
+ * MessageStore - Persistent Message Log
+ *
+ * Append-only, segmented log of sent and received messages.
+ *
+ * Layout:
+ *   <directory>/00000001.seg, 00000002.seg, ...
+ *   Only the highest-numbered segment is appended to; it is sealed and a
+ *   new one started once it exceeds kSegmentBytes.
+ *
+ * Record Kinds:
+ *   - Message:   one stored message
+ *   - Tombstone: deletes a single message (explicit delete or expiry)
+ *   - Truncate:  drops every message of a conversation below a sequence
+ *                number (retention by age/count, conversation delete)
+ *
+ * Timestamps need not grow with sequence numbers (archive imports, clock
+ * steps). Retention truncates the expired prefix in seq order; messages
+ * older than one before them are indexed as stragglers and expire on
+ * their own with a Tombstone.
+ *
+ * Retention & Compaction:
+ *   Retention policies (per conversation, with a default) are applied
+ *   logically first: dropped messages leave the index at once and their
+ *   bytes are counted as dead in their segment. compact_step() then
+ *   rewrites the sealed segment with the most dead bytes, a few records
+ *   at a time, never running longer than the budget it is given. A
+ *   rewritten segment replaces the old file with an atomic rename, so a
+ *   crash mid-compaction leaves the previous file intact.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. compact_step() only holds the internal
+ *   lock for the duration of its budget.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// =============================================================================
+// MARK: - Types
+// =============================================================================
+
+enum class MessageDirection : uint8_t {
+    Inbound  = 0,
+    Outbound = 1
+};
+
+struct StoredMessage {
+    uint64_t         seq;
+    std::string      conversation;
+    MessageDirection direction;
+    int64_t          timestamp;
+    int64_t          expires_at;   // 0 = never expires
+    std::string      body;
+};
+
+/**
+ * Retention rules for one conversation (0 = unlimited)
+ */
+struct RetentionPolicy {
+    int64_t  max_age_ms;
+    uint32_t max_count;
+    bool     drop_expired;
+
+    RetentionPolicy() : max_age_ms(0), max_count(0), drop_expired(true) {}
+};
+
+struct CompactionStats {
+    uint64_t bytes_reclaimed;
+    uint64_t records_dropped;
+    uint64_t segments_rewritten;
+    uint64_t disk_bytes;
+};
+
+// =============================================================================
+// MARK: - MessageStore Class
+// =============================================================================
+
+class MessageStore {
+public:
+    static constexpr uint64_t kSegmentBytes = 1u << 20;
+
+    MessageStore();
+    ~MessageStore();
+
+    // Non-copyable
+    MessageStore(const MessageStore&) = delete;
+    MessageStore& operator=(const MessageStore&) = delete;
+
+    // Lifecycle
+    bool open(const std::string& directory);
+    void close();
+    bool is_open() const;
+
+    // Messages
+    uint64_t append(const std::string& conversation,
+                    MessageDirection direction,
+                    int64_t timestamp,
+                    const std::string& body,
+                    int64_t expires_at = 0);
+    bool remove(const std::string& conversation, uint64_t seq);
+    bool remove_conversation(const std::string& conversation);
+    size_t message_count(const std::string& conversation) const;
+    size_t load_conversation(const std::string& conversation,
+                             std::vector<StoredMessage>& out) const;
+
+    // Bulk access (archive export/import)
+    using MessageVisitor = std::function<bool(const StoredMessage& message)>;
+
+    /**
+     * Visit every live message in log order
+     *
+     * Segments are read sequentially, one at a time, and the lock is
+     * released before the visitor runs, so memory stays bounded by one
+     * segment and appends are never blocked for long.
+     *
+     * @return false if the visitor stopped early or a segment was unreadable
+     */
+    bool for_each_message(const MessageVisitor& visit) const;
+
+    /**
+     * Append a batch of messages with a single flush
+     *
+     * Sequence numbers are assigned here (the stored seq is ignored), in
+     * batch order.
+     *
+     * @return Number of messages written
+     */
+    size_t import_messages(const std::vector<StoredMessage>& messages);
+
+    // Retention
+    void set_default_policy(const RetentionPolicy& policy);
+    void set_policy(const std::string& conversation, const RetentionPolicy& policy);
+
+    /**
+     * Run one slice of retention + compaction work
+     *
+     * @param budget Maximum wall time to spend
+     * @param now_ms Current time (Unix ms) used for age/expiry checks
+     * @return true if more work is pending
+     */
+    bool compact_step(std::chrono::microseconds budget, int64_t now_ms);
+
+    CompactionStats compaction_stats() const;
+
+private:
+    enum class RecordKind : uint8_t {
+        Message   = 1,
+        Tombstone = 2,
+        Truncate  = 3
+    };
+
+    struct Location {
+        uint32_t segment;
+        uint64_t offset;
+        uint32_t length;
+    };
+
+    struct IndexEntry {
+        Location loc;
+        int64_t  timestamp;
+        int64_t  expires_at;
+    };
+
+    struct Conversation {
+        std::map<uint64_t, IndexEntry> messages;   // ordered by seq
+        std::set<std::pair<int64_t, uint64_t>> stragglers;   // (timestamp, seq), older than a lower seq
+        int64_t  newest;                           // Latest timestamp indexed
+        uint64_t truncated_below;
+        Location truncate_loc;                     // latest Truncate record
+        bool     has_truncate;
+
+        Conversation() : newest(INT64_MIN), truncated_below(0), truncate_loc{0, 0, 0}, has_truncate(false) {}
+    };
+
+    // A deleted message whose bytes still exist on disk, and the tombstone
+    // that must survive until they are gone
+    struct DeadRecord {
+        uint32_t segment;
+        Location tombstone;
+    };
+
+    struct Segment {
+        uint64_t size;
+        uint64_t dead_bytes;
+    };
+
+    struct Relocation {
+        RecordKind  kind;
+        std::string conversation;
+        uint64_t    seq;
+        uint64_t    old_offset;
+        uint64_t    new_offset;
+        uint32_t    length;
+    };
+
+    struct CompactionJob {
+        bool        active;
+        uint32_t    segment;
+        std::FILE*  in;
+        std::FILE*  out;
+        uint64_t    read_offset;
+        uint64_t    write_offset;
+        uint64_t    old_size;
+        std::vector<Relocation> relocations;
+
+        CompactionJob() : active(false), segment(0), in(nullptr), out(nullptr),
+                          read_offset(0), write_offset(0), old_size(0) {}
+    };
+
+    struct Record {
+        RecordKind       kind;
+        MessageDirection direction;
+        uint64_t         seq;
+        int64_t          timestamp;
+        int64_t          expires_at;
+        std::string      conversation;
+        std::string      body;
+    };
+
+    // Encoding
+    static std::string encode(const Record& record);
+    static bool read_record(std::FILE* f, std::string& raw, Record& record);
+
+    // Segments
+    std::string segment_path(uint32_t id) const;
+    bool open_active(uint32_t id);
+    bool replay_segment(uint32_t id, bool is_last);
+    Location write_record(const Record& record, bool flush = true);
+
+    // Index maintenance (mutex_ held)
+    void apply_record(const Record& record, const Location& loc);
+    void mark_dead(const Location& loc);
+    void drop_message(Conversation& conv, std::map<uint64_t, IndexEntry>::iterator it,
+                      const std::string& name, bool tombstone);
+    void truncate_conversation(const std::string& name, Conversation& conv, uint64_t below);
+    const RetentionPolicy& policy_for(const std::string& conversation) const;
+
+    // Compaction (mutex_ held)
+    bool apply_retention(int64_t now_ms, std::chrono::steady_clock::time_point deadline);
+    bool pick_victim();
+    bool continue_job(std::chrono::steady_clock::time_point deadline);
+    void finish_job();
+    void abort_job();
+    bool is_live(const Record& record, uint64_t offset) const;
+
+    mutable std::mutex mutex_;
+
+    std::string directory_;
+    bool        open_;
+    std::FILE*  active_;
+    uint32_t    active_id_;
+    uint64_t    next_seq_;
+
+    std::map<uint32_t, Segment> segments_;
+    std::unordered_map<std::string, Conversation> conversations_;
+    std::unordered_map<uint64_t, DeadRecord> dead_records_;
+    std::multimap<int64_t, std::pair<std::string, uint64_t>> expiry_;
+
+    RetentionPolicy default_policy_;
+    std::unordered_map<std::string, RetentionPolicy> policies_;
+    bool            retention_dirty_;
+    int64_t         last_retention_ms_;
+
+    CompactionJob   job_;
+    CompactionStats stats_;
+};
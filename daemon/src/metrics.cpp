@@ -0,0 +1,96 @@
+/**
+ * Metrics Implementation
+ */
+
+#include "metrics.h"
+
+namespace {
+
+// Smallest count at or above `percent` of `total`
+uint64_t rank_of(uint64_t total, uint64_t percent) {
+    return (total * percent + 99) / 100;
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+Metrics::Metrics() {
+    for (Shard& shard : shards_) {
+        for (auto& value : shard.values) {
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (Histogram& h : timings_) {
+        for (auto& bucket : h.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        h.total_ns.store(0, std::memory_order_relaxed);
+        h.max_ns.store(0, std::memory_order_relaxed);
+    }
+    depth_.store(0, std::memory_order_relaxed);
+    depth_max_.store(0, std::memory_order_relaxed);
+}
+
+// =============================================================================
+// MARK: - Snapshot
+// =============================================================================
+
+uint64_t Metrics::bucket_max(size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const unsigned shift = unsigned(bucket / kSubBuckets) - 1;
+    const uint64_t lower = uint64_t(kSubBuckets + bucket % kSubBuckets) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+MetricsSnapshot Metrics::snapshot() const {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    MetricsSnapshot out;
+
+    for (size_t c = 0; c < size_t(Counter::Count); ++c) {
+        uint64_t sum = 0;
+        for (const Shard& shard : shards_) {
+            sum += shard.values[c].load(std::memory_order_relaxed);
+        }
+        out.counters[c] = sum;
+    }
+
+    for (size_t t = 0; t < size_t(Timing::Count); ++t) {
+        const Histogram& h = timings_[t];
+
+        // One read of the buckets feeds both the count and the percentiles
+        uint64_t* const counts = scratch_;
+        uint64_t total = 0;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            counts[b] = h.buckets[b].load(std::memory_order_relaxed);
+            total += counts[b];
+        }
+
+        LatencySummary& summary = out.timings[t];
+        summary.count = total;
+        summary.total_ns = h.total_ns.load(std::memory_order_relaxed);
+        summary.max_ns = h.max_ns.load(std::memory_order_relaxed);
+
+        const uint64_t ranks[3] = {rank_of(total, 50), rank_of(total, 90), rank_of(total, 99)};
+        uint64_t* const targets[3] = {&summary.p50_ns, &summary.p90_ns, &summary.p99_ns};
+        size_t next = 0;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < kBuckets && next < 3; ++b) {
+            seen += counts[b];
+            while (next < 3 && total != 0 && seen >= ranks[next]) {
+                *targets[next++] = bucket_max(b);
+            }
+        }
+        while (next < 3) {
+            *targets[next++] = 0;
+        }
+    }
+
+    out.queue_depth = depth_.load(std::memory_order_relaxed);
+    out.queue_depth_max = depth_max_.load(std::memory_order_relaxed);
+    return out;
+}
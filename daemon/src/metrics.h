@@ -0,0 +1,155 @@
+/**
+ * Metrics - Lock-Free Counters, Latency Histograms and Gauges
+ *
+ * A fixed registry of what the daemon measures, addressed by enum so an
+ * update is an index, not a lookup:
+ *
+ *   Counters    sharded per thread (one cache line per shard), so threads
+ *               never contend; a relaxed add on the caller's own shard
+ *   Timings     log-bucketed histograms in nanoseconds: values under 16
+ *               are exact, above that each power of two is split into 16
+ *               sub-buckets (relative error under 6.25%), so one record
+ *               is a relaxed add on its bucket and on the total
+ *   Gauges      queue depth, with its high-water mark
+ *
+ * Updates only touch atomics. snapshot() reads everything in one pass
+ * under a reader-side lock; each histogram's count and percentiles come
+ * from the same read of its buckets, so they always agree.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe; updates are lock-free.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+enum class Counter : uint8_t {
+    EventsQueued,          // Events posted to the worker
+    EventsDispatched,      // Events the worker took off the queue
+    Batches,               // Pipeline runs
+    MessagesDelivered,     // Chat messages handed to on_message
+    FramesSent,            // Transport sends
+    BytesSent,
+    Count
+};
+
+enum class Timing : uint8_t {
+    QueueWait,             // Enqueue to dispatch
+    Handler,               // One batch through its pipeline (or a task resume)
+    Callback,              // Time spent in app callbacks
+    TransportSend,         // Transport::send
+    SlowHandler,           // Work past the watchdog's slow_handler_ms
+    Count
+};
+
+/**
+ * One histogram, summarised
+ */
+struct LatencySummary {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t p50_ns;       // Percentiles are bucket upper bounds
+    uint64_t p90_ns;
+    uint64_t p99_ns;
+    uint64_t max_ns;       // Exact
+};
+
+/**
+ * Everything at one point in time
+ */
+struct MetricsSnapshot {
+    uint64_t       counters[size_t(Counter::Count)];
+    LatencySummary timings[size_t(Timing::Count)];
+    uint64_t       queue_depth;
+    uint64_t       queue_depth_max;
+
+    uint64_t counter(Counter c) const { return counters[size_t(c)]; }
+    const LatencySummary& timing(Timing t) const { return timings[size_t(t)]; }
+};
+
+class Metrics {
+public:
+    // Sub-buckets per power of two (4 bits)
+    static constexpr unsigned kSubBits = 4;
+    static constexpr size_t   kSubBuckets = size_t(1) << kSubBits;
+    static constexpr size_t   kBuckets = (64 - kSubBits + 1) * kSubBuckets;
+
+    Metrics();
+
+    // Non-copyable
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    // Monotonic nanoseconds for timings
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void add(Counter counter, uint64_t n = 1) {
+        shards_[shard()].values[size_t(counter)].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void record(Timing timing, uint64_t ns) {
+        Histogram& h = timings_[size_t(timing)];
+        h.buckets[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+        h.total_ns.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t max = h.max_ns.load(std::memory_order_relaxed);
+        while (ns > max && !h.max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    void set_queue_depth(size_t depth) {
+        depth_.store(depth, std::memory_order_relaxed);
+        uint64_t max = depth_max_.load(std::memory_order_relaxed);
+        while (depth > max && !depth_max_.compare_exchange_weak(max, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    MetricsSnapshot snapshot() const;
+
+    // Bucket for a value, and the largest value it holds
+    static size_t bucket_of(uint64_t value) {
+        if (value < kSubBuckets) {
+            return size_t(value);
+        }
+        const unsigned msb = 63u - unsigned(__builtin_clzll(value));
+        const unsigned shift = msb - kSubBits;
+        return size_t(shift + 1) * kSubBuckets + size_t((value >> shift) & (kSubBuckets - 1));
+    }
+    static uint64_t bucket_max(size_t bucket);
+
+private:
+    static constexpr size_t kShards = 8;
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> values[size_t(Counter::Count)];
+    };
+
+    struct Histogram {
+        std::atomic<uint64_t> buckets[kBuckets];
+        std::atomic<uint64_t> total_ns;
+        std::atomic<uint64_t> max_ns;
+    };
+
+    // This thread's shard, assigned round-robin on first use
+    static size_t shard() {
+        static std::atomic<size_t> next{0};
+        thread_local const size_t slot = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+        return slot;
+    }
+
+    Shard     shards_[kShards];
+    Histogram timings_[size_t(Timing::Count)];
+    alignas(64) std::atomic<uint64_t> depth_;
+    std::atomic<uint64_t> depth_max_;
+
+    // Serialises readers only; scratch_ holds one histogram's buckets
+    mutable std::mutex snapshot_mutex_;
+    mutable uint64_t   scratch_[kBuckets];
+};
@@ -0,0 +1,225 @@
+/**
+ * OffloadPool Implementation
+ */
+
+#include "offload_pool.h"
+
+#include <algorithm>
+
+namespace {
+
+// Index of the pool worker running on this thread (npos elsewhere)
+constexpr size_t kNotAWorker = static_cast<size_t>(-1);
+thread_local const OffloadPool* tls_pool = nullptr;
+thread_local size_t tls_worker = kNotAWorker;
+
+} // namespace
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+OffloadPool::OffloadPool(const OffloadConfig& config, PostFn post)
+    : config_(config)
+    , post_(std::move(post))
+    , next_worker_(0)
+    , queued_(0)
+    , in_flight_(0)
+    , stopping_(false)
+    , stats_{0, 0, 0, 0, 0, 0}
+{
+    const unsigned threads = std::max(1u, config_.threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers_.emplace_back(new Worker());
+    }
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->thread = std::thread(&OffloadPool::worker_loop, this, i);
+    }
+}
+
+OffloadPool::~OffloadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    space_cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+// =============================================================================
+// MARK: - Submission
+// =============================================================================
+
+void OffloadPool::submit(uint64_t key, Job job) {
+    if (admit(true)) {
+        accept(key, std::move(job));
+    }
+}
+
+bool OffloadPool::try_submit(uint64_t key, Job job) {
+    if (!admit(false)) {
+        return false;
+    }
+    accept(key, std::move(job));
+    return true;
+}
+
+bool OffloadPool::admit(bool wait) {
+    const bool from_pool = tls_pool == this;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (!from_pool && in_flight_ >= std::max<size_t>(1, config_.capacity)) {
+        if (!wait || stopping_) {
+            if (!wait) {
+                stats_.rejected++;
+            }
+            return false;
+        }
+        stats_.blocked++;
+        space_cv_.wait(lock, [this] {
+            return stopping_ || in_flight_ < std::max<size_t>(1, config_.capacity);
+        });
+        if (stopping_) {
+            return false;
+        }
+    }
+
+    in_flight_++;
+    stats_.submitted++;
+    stats_.max_in_flight = std::max<uint64_t>(stats_.max_in_flight, in_flight_);
+    return true;
+}
+
+void OffloadPool::accept(uint64_t key, Job&& job) {
+    // A busy strand keeps the job until its predecessor finishes
+    if (key != 0) {
+        std::lock_guard<std::mutex> lock(strand_mutex_);
+        auto it = strands_.find(key);
+        if (it != strands_.end()) {
+            it->second.push_back(std::move(job));
+            return;
+        }
+        strands_.emplace(key, std::deque<Job>());
+    }
+
+    schedule(Task{key, std::move(job)});
+}
+
+void OffloadPool::schedule(Task&& task) {
+    // Follow-up work stays on the worker that produced it; the rest is
+    // spread round-robin
+    const size_t target = tls_pool == this
+        ? tls_worker
+        : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+    {
+        Worker& worker = *workers_[target];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this with a worker about to sleep
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    work_cv_.notify_one();
+}
+
+// =============================================================================
+// MARK: - Workers
+// =============================================================================
+
+bool OffloadPool::take(size_t self, Task& task) {
+    {
+        Worker& own = *workers_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < workers_.size(); ++i) {
+        Worker& victim = *workers_[(self + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> stats_lock(mutex_);
+            stats_.stolen++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void OffloadPool::finish(const Task& task) {
+    // The next job of the strand becomes runnable only after this one's
+    // continuation was posted, which keeps completions in order
+    if (task.key != 0) {
+        Job next;
+        {
+            std::lock_guard<std::mutex> lock(strand_mutex_);
+            auto it = strands_.find(task.key);
+            if (it->second.empty()) {
+                strands_.erase(it);
+            } else {
+                next = std::move(it->second.front());
+                it->second.pop_front();
+            }
+        }
+        if (next) {
+            schedule(Task{task.key, std::move(next)});
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_--;
+        stats_.completed++;
+    }
+    space_cv_.notify_one();
+}
+
+void OffloadPool::worker_loop(size_t self) {
+    tls_pool = this;
+    tls_worker = self;
+
+    for (;;) {
+        Task task;
+        if (take(self, task)) {
+            Continuation continuation = task.job();
+            if (continuation && post_) {
+                post_(task.key, std::move(continuation));
+            }
+            finish(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_cv_.wait(lock, [this] {
+            return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping_) {
+            break;
+        }
+    }
+}
+
+// =============================================================================
+// MARK: - Stats
+// =============================================================================
+
+OffloadStats OffloadPool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
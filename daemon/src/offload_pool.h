@@ -0,0 +1,129 @@
+/**
+ * OffloadPool - Worker Pool for Heavy or Blocking Work
+ *
+ * The daemon runs every handler on one thread, so anything CPU-heavy
+ * (signature checks, hashing chunk data) or blocking (chunk store disk
+ * I/O) would stall all other traffic. Handlers hand such work to this
+ * pool instead. A job returns a continuation, which is posted back and
+ * run on the daemon thread like any other event.
+ *
+ * Scheduling:
+ *   Each worker owns a deque. New jobs are spread across the deques;
+ *   a worker takes from the front of its own deque and, when that is
+ *   empty, steals from the back of another worker's.
+ *
+ * Ordering:
+ *   Jobs submitted with the same non-zero key (normally a peer id) form
+ *   a strand: they run one at a time, in submission order, and their
+ *   continuations are posted in that order. Jobs with key 0 are
+ *   unordered. Different keys still run in parallel.
+ *
+ * Bounding:
+ *   At most `capacity` jobs are in flight (queued, waiting on their
+ *   strand, or running). submit() blocks while the pool is full, which
+ *   pushes back on the producer instead of growing without limit. Jobs
+ *   submitted from a pool thread are never blocked, so a job that
+ *   submits follow-up work cannot deadlock the pool.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. Jobs still queued when the pool is
+ *   destroyed are dropped without running.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Pool configuration
+ */
+struct OffloadConfig {
+    unsigned threads  = 2;
+    size_t   capacity = 256;     // Jobs in flight before submit() blocks
+};
+
+/**
+ * Pool counters
+ */
+struct OffloadStats {
+    uint64_t submitted;
+    uint64_t completed;
+    uint64_t stolen;          // Jobs run by a worker that did not receive them
+    uint64_t blocked;         // Submissions that waited for capacity
+    uint64_t rejected;        // try_submit() calls refused because the pool was full
+    uint64_t max_in_flight;
+};
+
+class OffloadPool {
+public:
+    // Runs on the daemon thread once the job is done (may be empty)
+    using Continuation = std::function<void()>;
+
+    // Runs on a pool thread
+    using Job = std::function<Continuation()>;
+
+    // Hands a continuation back to the owner; called on a pool thread,
+    // in submission order within a key
+    using PostFn = std::function<void(uint64_t key, Continuation&& continuation)>;
+
+    OffloadPool(const OffloadConfig& config, PostFn post);
+    ~OffloadPool();
+
+    OffloadPool(const OffloadPool&) = delete;
+    OffloadPool& operator=(const OffloadPool&) = delete;
+
+    // Queue a job; key 0 = unordered. Blocks while the pool is full.
+    void submit(uint64_t key, Job job);
+
+    // As submit(), but returns false instead of blocking when full
+    bool try_submit(uint64_t key, Job job);
+
+    OffloadStats stats() const;
+
+private:
+    struct Task {
+        uint64_t key;
+        Job      job;
+    };
+
+    struct Worker {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+        std::thread      thread;
+    };
+
+    bool admit(bool wait);
+    void accept(uint64_t key, Job&& job);
+    void schedule(Task&& task);
+    bool take(size_t self, Task& task);
+    void finish(const Task& task);
+    void worker_loop(size_t self);
+
+    const OffloadConfig config_;
+    PostFn              post_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<size_t>                  next_worker_;
+    std::atomic<size_t>                  queued_;       // Tasks sitting in deques
+
+    // Sleeping workers and blocked submitters
+    mutable std::mutex      mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable space_cv_;
+    size_t                  in_flight_;
+    bool                    stopping_;
+    OffloadStats            stats_;
+
+    // Keys with a job queued or running, and the jobs waiting behind it
+    std::mutex                                     strand_mutex_;
+    std::unordered_map<uint64_t, std::deque<Job>>  strands_;
+};
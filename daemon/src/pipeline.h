@@ -0,0 +1,231 @@
+/**
+ * Pipeline - Staged Event Processing
+ *
+ * An ordered list of named stages. A batch of events flows through each
+ * stage in turn; a stage handles the events it cares about and erases
+ * the ones that should go no further (consumed, refused or finished).
+ * Features plug in as stages instead of being edited into one handler,
+ * and deployments pick their stages: a relay build can drop the storage
+ * and UI stages and keep the rest.
+ *
+ * Every stage is timed per batch (count, total and worst case), so the
+ * cost of each feature on the worker is visible; given an enabled
+ * tracer, each stage run is also recorded as a span, and given a
+ * watchdog, each stage entered is named so a stall report can say
+ * which one hung.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. The lock only guards the stage list:
+ *   run() takes a snapshot of it and runs the stages unlocked, so a
+ *   stage (or a callback it fires) may add, remove or inspect stages,
+ *   and such a change applies from the next run. run() is called by one
+ *   thread (the daemon's worker), so stages of one pipeline never run
+ *   concurrently. A stage must not run its own pipeline.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tracer.h"
+#include "watchdog.h"
+
+/**
+ * Timing for one stage
+ */
+struct StageStats {
+    std::string name;
+    uint64_t    batches;     // Batches that reached the stage
+    uint64_t    events;      // Events that reached the stage
+    uint64_t    total_ns;
+    uint64_t    max_ns;      // Slowest batch
+};
+
+template <typename Event>
+class PipelineStage {
+public:
+    virtual ~PipelineStage() = default;
+
+    virtual std::string name() const = 0;
+
+    // Handle the batch in order; erase events that should go no further
+    virtual void process(std::vector<Event>& batch) = 0;
+};
+
+/**
+ * Stage built from a function over the whole batch
+ */
+template <typename Event>
+class FunctionStage : public PipelineStage<Event> {
+public:
+    using BatchFn = std::function<void(std::vector<Event>& batch)>;
+
+    FunctionStage(std::string name, BatchFn fn) : name_(std::move(name)), fn_(std::move(fn)) {}
+
+    std::string name() const override { return name_; }
+    void process(std::vector<Event>& batch) override { fn_(batch); }
+
+private:
+    std::string name_;
+    BatchFn     fn_;
+};
+
+/**
+ * Stage that handles one event at a time; `fn` returns false to drop it
+ */
+template <typename Event>
+std::unique_ptr<PipelineStage<Event>> make_stage(std::string name, std::function<bool(Event&)> fn) {
+    return std::unique_ptr<PipelineStage<Event>>(new FunctionStage<Event>(
+        std::move(name),
+        [fn](std::vector<Event>& batch) {
+            batch.erase(std::remove_if(batch.begin(), batch.end(),
+                                       [&fn](Event& event) { return !fn(event); }),
+                        batch.end());
+        }));
+}
+
+template <typename Event>
+class Pipeline {
+public:
+    using Stage = PipelineStage<Event>;
+
+    Pipeline() : slots_(std::make_shared<const Slots>()) {}
+
+    // Non-copyable
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * Append a stage, or insert it before the stage named `before`
+     *
+     * @return false if the name is taken or `before` does not exist
+     */
+    bool add(std::unique_ptr<Stage> stage, const std::string& before = std::string()) {
+        if (!stage) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::string name = stage->name();
+        if (find(*slots_, name) != slots_->end()) {
+            return false;
+        }
+
+        Slots slots = *slots_;
+        auto at = slots.cend();
+        if (!before.empty()) {
+            at = find(slots, before);
+            if (at == slots.end()) {
+                return false;
+            }
+        }
+        slots.insert(at, std::make_shared<Slot>(std::move(stage), name));
+        slots_ = std::make_shared<const Slots>(std::move(slots));
+        return true;
+    }
+
+    bool remove(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slots slots = *slots_;
+        auto it = find(slots, name);
+        if (it == slots.end()) {
+            return false;
+        }
+        slots.erase(it);
+        slots_ = std::make_shared<const Slots>(std::move(slots));
+        return true;
+    }
+
+    std::vector<std::string> stage_names() const {
+        std::vector<std::string> names;
+        for (const auto& slot : *snapshot()) {
+            names.push_back(slot->name);
+        }
+        return names;
+    }
+
+    // Run the batch through every stage, stopping once it is empty
+    void run(std::vector<Event>& batch, Tracer* tracer = nullptr, Watchdog* watchdog = nullptr) {
+        // The list as it was on entry; a stage removed meanwhile lives on
+        // until this run is done with it
+        const std::shared_ptr<const Slots> slots = snapshot();
+
+        for (const auto& slot : *slots) {
+            if (batch.empty()) {
+                break;
+            }
+
+            if (watchdog) {
+                watchdog->enter_stage(slot->name);
+            }
+            const size_t events = batch.size();
+            const auto start = std::chrono::steady_clock::now();
+            slot->stage->process(batch);
+            const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count());
+
+            slot->batches.fetch_add(1, std::memory_order_relaxed);
+            slot->events.fetch_add(events, std::memory_order_relaxed);
+            slot->total_ns.fetch_add(ns, std::memory_order_relaxed);
+            uint64_t max = slot->max_ns.load(std::memory_order_relaxed);
+            while (ns > max && !slot->max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+            }
+
+            if (tracer && tracer->enabled()) {
+                const uint64_t start_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    start.time_since_epoch()).count());
+                tracer->span(TraceCategory::Stage, slot->name.c_str(), start_ns, ns, 0, events);
+            }
+        }
+    }
+
+    std::vector<StageStats> stats() const {
+        std::vector<StageStats> out;
+        for (const auto& slot : *snapshot()) {
+            out.push_back(StageStats{
+                slot->name,
+                slot->batches.load(std::memory_order_relaxed),
+                slot->events.load(std::memory_order_relaxed),
+                slot->total_ns.load(std::memory_order_relaxed),
+                slot->max_ns.load(std::memory_order_relaxed)
+            });
+        }
+        return out;
+    }
+
+private:
+    struct Slot {
+        Slot(std::unique_ptr<Stage> s, std::string n) : stage(std::move(s)), name(std::move(n)) {}
+
+        const std::unique_ptr<Stage> stage;
+        const std::string            name;
+        std::atomic<uint64_t>        batches{0};
+        std::atomic<uint64_t>        events{0};
+        std::atomic<uint64_t>        total_ns{0};
+        std::atomic<uint64_t>        max_ns{0};
+    };
+
+    // Replaced whole on every change, never modified in place
+    using Slots = std::vector<std::shared_ptr<Slot>>;
+
+    static typename Slots::const_iterator find(const Slots& slots, const std::string& name) {
+        return std::find_if(slots.begin(), slots.end(),
+                            [&name](const std::shared_ptr<Slot>& slot) { return slot->name == name; });
+    }
+
+    std::shared_ptr<const Slots> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slots_;
+    }
+
+    mutable std::mutex           mutex_;
+    std::shared_ptr<const Slots> slots_;
+};
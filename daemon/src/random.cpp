@@ -0,0 +1,42 @@
+/**
+ * Random Implementation
+ */
+
+#include "random.h"
+#include "chacha20_poly1305.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+namespace {
+
+class Generator {
+public:
+    Generator() : counter_(0) {
+        std::random_device rd;
+        for (size_t i = 0; i < sizeof(key_); i += 4) {
+            const uint32_t w = rd();
+            std::memcpy(key_ + i, &w, 4);
+        }
+    }
+
+    void fill(uint8_t* out, size_t len) {
+        uint8_t nonce[12] = {};
+        std::memcpy(nonce, &counter_, sizeof(counter_));
+        counter_++;
+        std::memset(out, 0, len);
+        chacha20_xor(key_, nonce, 0, out, len);
+    }
+
+private:
+    uint8_t  key_[32];
+    uint64_t counter_;
+};
+
+} // namespace
+
+void random_bytes(void* out, size_t len) {
+    thread_local Generator generator;
+    generator.fill(static_cast<uint8_t*>(out), len);
+}
@@ -0,0 +1,13 @@
+/**
+ * Random - Cryptographic Random Bytes
+ *
+ * A per-thread ChaCha20 generator keyed once from std::random_device
+ * (the OS entropy source on every platform we ship), so hot paths such
+ * as batch coefficients and handshake keys never make a syscall.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+void random_bytes(void* out, size_t len);
@@ -0,0 +1,219 @@
+/**
+ * ScanFilter Implementation
+ */
+
+#include "scan_filter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+ScanFilter::ScanFilter()
+    : ScanFilter(ScanConfig())
+{
+}
+
+ScanFilter::ScanFilter(const ScanConfig& config)
+    : config_(config)
+    , batch_(0)
+    , present_(0)
+    , stats_{0, 0, 0, 0, 0, 0, 0, 0, 0}
+{
+}
+
+void ScanFilter::set_config(const ScanConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+ScanConfig ScanFilter::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+// =============================================================================
+// MARK: - Ingest
+// =============================================================================
+
+size_t ScanFilter::ingest(const ScanReport* reports, size_t count, std::vector<DiscoveryChange>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t before = out.size();
+    const uint64_t batch = ++batch_;
+    stats_.reports += count;
+
+    // Filter every sample first; decide once per device at the end, so a
+    // burst of reports from one device yields at most one change
+    std::vector<DeviceId> touched;
+    for (size_t i = 0; i < count; ++i) {
+        const ScanReport& report = reports[i];
+
+        auto it = devices_.find(report.id);
+        if (it == devices_.end()) {
+            if (config_.max_devices == 0) {
+                continue;
+            }
+            if (devices_.size() >= config_.max_devices) {
+                evict(out);
+            }
+            Device fresh;
+            fresh.estimate = report.rssi;
+            fresh.variance = config_.measurement_noise;
+            fresh.last_raw = report.rssi;
+            fresh.reported = report.rssi;
+            fresh.last_seen = report.timestamp_ms;
+            fresh.batch = batch;
+            fresh.present = false;
+            devices_.emplace(report.id, fresh);
+            touched.push_back(report.id);
+            continue;
+        }
+
+        Device& device = it->second;
+        if (report.timestamp_ms < device.last_seen ||
+            (report.timestamp_ms == device.last_seen && report.rssi == device.last_raw)) {
+            stats_.duplicates++;
+            continue;
+        }
+
+        // Back after going silent: start over rather than drag the old
+        // estimate along
+        if (!device.present && report.timestamp_ms - device.last_seen > int64_t(config_.lost_after_ms)) {
+            device.estimate = report.rssi;
+            device.variance = config_.measurement_noise;
+        } else {
+            smooth(device, report.rssi, report.timestamp_ms);
+        }
+        device.last_raw = report.rssi;
+        device.last_seen = report.timestamp_ms;
+        if (device.batch != batch) {
+            device.batch = batch;
+            touched.push_back(report.id);
+        }
+    }
+
+    for (const DeviceId& id : touched) {
+        auto it = devices_.find(id);
+        if (it == devices_.end()) {
+            continue; // Evicted later in the same batch
+        }
+        Device& device = it->second;
+        const bool strong = device.estimate >= config_.min_rssi;
+        if (!device.present && strong) {
+            emit(id, device, DiscoveryKind::Found, out);
+        } else if (device.present && !strong) {
+            emit(id, device, DiscoveryKind::Lost, out);
+        } else if (device.present &&
+                   std::abs(int32_t(std::lround(device.estimate)) - device.reported) >= config_.rssi_change_db) {
+            emit(id, device, DiscoveryKind::Updated, out);
+        }
+    }
+
+    return out.size() - before;
+}
+
+size_t ScanFilter::expire(int64_t now_ms, std::vector<DiscoveryChange>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t before = out.size();
+    const int64_t lost_after = config_.lost_after_ms;
+
+    for (auto it = devices_.begin(); it != devices_.end();) {
+        Device& device = it->second;
+        const int64_t silent = now_ms - device.last_seen;
+        if (device.present && silent > lost_after) {
+            emit(it->first, device, DiscoveryKind::Lost, out);
+        }
+        // Absent devices are kept a while longer so a quick return still
+        // counts as a return rather than a first sighting
+        it = !device.present && silent > 2 * lost_after ? devices_.erase(it) : std::next(it);
+    }
+
+    return out.size() - before;
+}
+
+bool ScanFilter::rssi(const DeviceId& id, int32_t& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = devices_.find(id);
+    if (it == devices_.end() || !it->second.present) {
+        return false;
+    }
+    out = int32_t(std::lround(it->second.estimate));
+    return true;
+}
+
+ScanStats ScanFilter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ScanStats stats = stats_;
+    stats.devices = devices_.size();
+    stats.present = present_;
+    return stats;
+}
+
+// =============================================================================
+// MARK: - Internals
+// =============================================================================
+
+size_t DeviceIdHash::operator()(const DeviceId& id) const {
+    uint64_t a;
+    uint64_t b;
+    std::memcpy(&a, id.data(), 8);
+    std::memcpy(&b, id.data() + 8, 8);
+    return size_t((a ^ (b * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull >> 7);
+}
+
+void ScanFilter::smooth(Device& device, int32_t rssi, int64_t timestamp_ms) const {
+    if (config_.filter == RssiFilter::Ewma) {
+        device.estimate += config_.ewma_alpha * (rssi - device.estimate);
+        return;
+    }
+
+    // Scalar Kalman: the true RSSI drifts as a random walk between samples
+    const double seconds = double(timestamp_ms - device.last_seen) / 1000.0;
+    device.variance += config_.process_noise * seconds;
+    const double gain = device.variance / (device.variance + config_.measurement_noise);
+    device.estimate += gain * (rssi - device.estimate);
+    device.variance *= 1.0 - gain;
+}
+
+void ScanFilter::evict(std::vector<DiscoveryChange>& out) {
+    auto oldest = devices_.begin();
+    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
+        if (it->second.last_seen < oldest->second.last_seen) {
+            oldest = it;
+        }
+    }
+    if (oldest == devices_.end()) {
+        return;
+    }
+    if (oldest->second.present) {
+        emit(oldest->first, oldest->second, DiscoveryKind::Lost, out);
+    }
+    devices_.erase(oldest);
+    stats_.evicted++;
+}
+
+void ScanFilter::emit(const DeviceId& id, Device& device, DiscoveryKind kind, std::vector<DiscoveryChange>& out) {
+    const int32_t rounded = int32_t(std::lround(device.estimate));
+    switch (kind) {
+        case DiscoveryKind::Found:
+            device.present = true;
+            present_++;
+            stats_.found++;
+            break;
+        case DiscoveryKind::Updated:
+            stats_.updated++;
+            break;
+        case DiscoveryKind::Lost:
+            device.present = false;
+            present_--;
+            stats_.lost++;
+            break;
+    }
+    device.reported = rounded;
+    stats_.changes++;
+    out.push_back(DiscoveryChange{id, kind, rounded, device.last_seen});
+}
@@ -0,0 +1,137 @@
+/**
+ * ScanFilter - Batched BLE Scan Ingest
+ *
+ * The platform scanner reports every advertisement it hears; in a busy
+ * area that is hundreds per second, most of them repeats of devices
+ * already known. The filter takes them in batches, drops exact repeats
+ * and stale reports, smooths each device's RSSI (EWMA or a scalar
+ * Kalman filter) and turns what is left into a short list of changes:
+ *
+ *   Found    smoothed RSSI rose to min_rssi (first sighting, or back)
+ *   Updated  smoothed RSSI moved rssi_change_db since last reported
+ *   Lost     smoothed RSSI fell under min_rssi, or silent lost_after_ms
+ *
+ * A device produces at most one change per batch. The table is bounded:
+ * when full, the longest-silent device is forgotten (a Lost change if
+ * it was present).
+ *
+ * Thread Safety:
+ *   All methods are thread-safe.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Platform device identifier: a UUID (iOS), or a MAC address left-aligned
+// and zero-padded (Android)
+using DeviceId = std::array<uint8_t, 16>;
+
+struct DeviceIdHash {
+    size_t operator()(const DeviceId& id) const;
+};
+
+/**
+ * One advertisement heard by the scanner
+ */
+struct ScanReport {
+    DeviceId id;
+    int32_t  rssi;           // dBm
+    int64_t  timestamp_ms;
+};
+
+enum class DiscoveryKind { Found, Updated, Lost };
+
+/**
+ * A change worth telling the app about
+ */
+struct DiscoveryChange {
+    DeviceId      id;
+    DiscoveryKind kind;
+    int32_t       rssi;          // Smoothed, rounded
+    int64_t       last_seen;
+};
+
+enum class RssiFilter { Ewma, Kalman };
+
+struct ScanConfig {
+    RssiFilter filter            = RssiFilter::Kalman;
+    float      ewma_alpha        = 0.3f;     // Weight of each new sample
+    float      process_noise     = 2.0f;     // Kalman: dB² of drift per second
+    float      measurement_noise = 16.0f;    // Kalman: dB² of per-sample noise
+    int32_t    rssi_change_db    = 5;        // Smallest move reported as Updated
+    int32_t    min_rssi          = -95;      // Weaker devices are not present
+    uint32_t   lost_after_ms     = 10000;
+    uint32_t   max_devices       = 1024;
+};
+
+/**
+ * Scan counters
+ */
+struct ScanStats {
+    uint64_t reports;        // Reports ingested
+    uint64_t duplicates;     // Exact repeats and out-of-order reports dropped
+    uint64_t changes;        // Changes emitted
+    uint64_t found;
+    uint64_t updated;
+    uint64_t lost;
+    uint64_t evicted;        // Forgotten because the table was full
+    uint64_t devices;        // Currently tracked
+    uint64_t present;        // Currently reported present
+};
+
+class ScanFilter {
+public:
+    ScanFilter();
+    explicit ScanFilter(const ScanConfig& config);
+
+    // Non-copyable
+    ScanFilter(const ScanFilter&) = delete;
+    ScanFilter& operator=(const ScanFilter&) = delete;
+
+    // Smoothing state is kept; thresholds apply from the next batch
+    void set_config(const ScanConfig& config);
+    ScanConfig config() const;
+
+    // Appends the batch's changes to `out`; returns how many
+    size_t ingest(const ScanReport* reports, size_t count, std::vector<DiscoveryChange>& out);
+
+    // Lost changes for devices silent for lost_after_ms; returns how many
+    size_t expire(int64_t now_ms, std::vector<DiscoveryChange>& out);
+
+    // Smoothed RSSI of a present device; false if not present
+    bool rssi(const DeviceId& id, int32_t& out) const;
+
+    ScanStats stats() const;
+
+private:
+    struct Device {
+        double   estimate;       // Smoothed RSSI
+        double   variance;       // Kalman error variance
+        int32_t  last_raw;
+        int32_t  reported;       // RSSI in the last change
+        int64_t  last_seen;
+        uint64_t batch;          // Last batch that changed it
+        bool     present;
+    };
+
+    // Feed one sample into the device's filter (lock held)
+    void smooth(Device& device, int32_t rssi, int64_t timestamp_ms) const;
+
+    // Make room for one more device (lock held)
+    void evict(std::vector<DiscoveryChange>& out);
+
+    void emit(const DeviceId& id, Device& device, DiscoveryKind kind, std::vector<DiscoveryChange>& out);
+
+    mutable std::mutex mutex_;
+    ScanConfig config_;
+    std::unordered_map<DeviceId, Device, DeviceIdHash> devices_;
+    uint64_t batch_;
+    uint64_t present_;
+    ScanStats stats_;
+};
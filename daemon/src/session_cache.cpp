@@ -0,0 +1,223 @@
+/**
+ * SessionCache Implementation
+ */
+
+#include "session_cache.h"
+#include "byte_io.h"
+#include "frame.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr size_t kAadBytes = 3;
+constexpr size_t kCounterOffset = kFrameHeaderBytes;
+constexpr size_t kCipherOffset = kFrameHeaderBytes + 8;
+
+void make_nonce(uint64_t counter, uint8_t nonce[kAeadNonceBytes]) {
+    std::memset(nonce, 0, 4);
+    store_u32(nonce + 4, static_cast<uint32_t>(counter));
+    store_u32(nonce + 8, static_cast<uint32_t>(counter >> 32));
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Constructor
+// =============================================================================
+
+SessionCache::SessionCache(size_t capacity)
+    : capacity_(capacity == 0 ? 1 : capacity)
+    , stats_{0, 0, 0, 0, 0}
+{
+}
+
+// =============================================================================
+// MARK: - Sessions
+// =============================================================================
+
+void SessionCache::install(uint64_t peer_id, const SessionKey& tx_key, const SessionKey& rx_key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = sessions_.find(peer_id);
+    if (it != sessions_.end()) {
+        lru_.erase(it->second.lru);
+        sessions_.erase(it);
+    }
+
+    // Evict the least recently used session of a peer that is not
+    // connected; with none left the cache grows past its capacity
+    auto victim = lru_.end();
+    while (sessions_.size() >= capacity_ && victim != lru_.begin()) {
+        --victim;
+        if (connected_.count(*victim) == 0) {
+            sessions_.erase(*victim);
+            victim = lru_.erase(victim);
+            stats_.evictions++;
+        }
+    }
+
+    lru_.push_front(peer_id);
+    keyed_.insert(peer_id);
+    Session& s = sessions_[peer_id];
+    s.tx_key = tx_key;
+    s.rx_key = rx_key;
+    s.tx_counter = 0;
+    s.rx_highest = 0;
+    s.rx_window = 0;
+    s.rx_any = false;
+    s.lru = lru_.begin();
+}
+
+void SessionCache::remove(uint64_t peer_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = sessions_.find(peer_id);
+    if (it != sessions_.end()) {
+        lru_.erase(it->second.lru);
+        sessions_.erase(it);
+    }
+    keyed_.erase(peer_id);
+}
+
+bool SessionCache::has(uint64_t peer_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sessions_.find(peer_id) != sessions_.end();
+}
+
+size_t SessionCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sessions_.size();
+}
+
+void SessionCache::set_connected(uint64_t peer_id, bool connected) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (connected) {
+        connected_.insert(peer_id);
+    } else {
+        connected_.erase(peer_id);
+    }
+}
+
+bool SessionCache::expects(uint64_t peer_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return keyed_.count(peer_id) > 0;
+}
+
+SessionStats SessionCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+SessionCache::Session* SessionCache::touch(uint64_t peer_id) {
+    auto it = sessions_.find(peer_id);
+    if (it == sessions_.end()) {
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return &it->second;
+}
+
+// =============================================================================
+// MARK: - Seal/Open
+// =============================================================================
+
+bool SessionCache::seal(uint64_t peer_id, const char* plaintext, size_t len, std::string& out) {
+    SessionKey key;
+    uint64_t counter;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Session* s = touch(peer_id);
+        if (!s) {
+            return false;
+        }
+        key = s->tx_key;
+        counter = s->tx_counter++;
+        stats_.sealed++;
+    }
+
+    out.clear();
+    out.reserve(len + kSealedOverhead);
+    out.push_back(static_cast<char>(kFrameMarker));
+    out.push_back(static_cast<char>(FrameType::Sealed));
+    out.push_back(0);
+    out.push_back(0);
+    put_u64(out, counter);
+    out.append(plaintext, len);
+    out.append(kAeadTagBytes, '\0');
+
+    uint8_t nonce[kAeadNonceBytes];
+    make_nonce(counter, nonce);
+
+    uint8_t* buf = reinterpret_cast<uint8_t*>(&out[0]);
+    aead_seal(key.data(), nonce, buf, kAadBytes, buf + kCipherOffset, len, buf + kCipherOffset + len);
+    return true;
+}
+
+bool SessionCache::open(uint64_t peer_id, std::string& data) {
+    if (data.size() < kSealedOverhead) {
+        return false;
+    }
+
+    const uint64_t counter = get_u64(data.data() + kCounterOffset);
+    SessionKey key;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Session* s = touch(peer_id);
+        if (!s) {
+            return false;
+        }
+        if (replayed(*s, counter)) {
+            stats_.replays++;
+            return false;
+        }
+        key = s->rx_key;
+    }
+
+    uint8_t nonce[kAeadNonceBytes];
+    make_nonce(counter, nonce);
+
+    uint8_t* buf = reinterpret_cast<uint8_t*>(&data[0]);
+    const size_t len = data.size() - kSealedOverhead;
+
+    if (!aead_open(key.data(), nonce, buf, kAadBytes, buf + kCipherOffset, len, buf + kCipherOffset + len)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.auth_failures++;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Session* s = touch(peer_id);
+        if (!s || replayed(*s, counter)) {
+            stats_.replays++;
+            return false; // Raced with a duplicate or the session was replaced
+        }
+
+        if (!s->rx_any || counter > s->rx_highest) {
+            const uint64_t shift = s->rx_any ? counter - s->rx_highest : 64;
+            s->rx_window = shift >= 64 ? 0 : s->rx_window << shift;
+            s->rx_window |= 1;
+            s->rx_highest = counter;
+            s->rx_any = true;
+        } else {
+            s->rx_window |= 1ull << (s->rx_highest - counter);
+        }
+        stats_.opened++;
+    }
+
+    // Plaintext moves to the front of the same buffer
+    data.erase(0, kCipherOffset);
+    data.resize(len);
+    return true;
+}
+
+bool SessionCache::replayed(const Session& s, uint64_t counter) {
+    if (!s.rx_any || counter > s.rx_highest) {
+        return false;
+    }
+    const uint64_t age = s.rx_highest - counter;
+    return age >= 64 || (s.rx_window & (1ull << age)) != 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * SessionCache - Per-Peer AEAD Sessions
+ *
+ * Holds the symmetric keys of active peers in a bounded LRU cache and
+ * seals/opens frames with ChaCha20-Poly1305 in place.
+ *
+ * Sealed Frame:
+ *   4 bytes   frame header (FrameType::Sealed)
+ *   u64       counter (nonce = 4 zero bytes || counter)
+ *   N bytes   ciphertext
+ *   16 bytes  tag
+ *
+ *   The AAD is the first three header bytes; the hint byte is excluded
+ *   so links may rewrite it without breaking authentication.
+ *
+ * Keys are directional (tx/rx) so both sides can count from zero without
+ * nonce reuse. A 64-entry sliding window rejects replays.
+ *
+ * Sessions of connected peers are never evicted, so the capacity only
+ * bounds the rest. A peer whose session was evicted is still expected
+ * to have one until remove(): its sender must re-key rather than fall
+ * back to plaintext the receiver would refuse.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. Encryption runs outside the lock.
+ */
+
+#pragma once
+
+#include "chacha20_poly1305.h"
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+constexpr size_t kSealedOverhead = 4 + 8 + kAeadTagBytes;
+
+using SessionKey = std::array<uint8_t, kAeadKeyBytes>;
+
+struct SessionStats {
+    uint64_t sealed;
+    uint64_t opened;
+    uint64_t auth_failures;
+    uint64_t replays;
+    uint64_t evictions;
+};
+
+class SessionCache {
+public:
+    static constexpr size_t kDefaultCapacity = 256;
+
+    explicit SessionCache(size_t capacity = kDefaultCapacity);
+
+    // Non-copyable
+    SessionCache(const SessionCache&) = delete;
+    SessionCache& operator=(const SessionCache&) = delete;
+
+    void install(uint64_t peer_id, const SessionKey& tx_key, const SessionKey& rx_key);
+    void remove(uint64_t peer_id);
+    bool has(uint64_t peer_id) const;
+    size_t size() const;
+
+    // Connected peers' sessions are exempt from eviction
+    void set_connected(uint64_t peer_id, bool connected);
+
+    // Had a session since the last remove(), whether or not it is still held
+    bool expects(uint64_t peer_id) const;
+
+    /**
+     * Build a sealed frame for plaintext into out (cleared first)
+     *
+     * @return false if the peer has no session
+     */
+    bool seal(uint64_t peer_id, const char* plaintext, size_t len, std::string& out);
+
+    /**
+     * Authenticate and decrypt a sealed frame in place; on success data
+     * holds the plaintext
+     */
+    bool open(uint64_t peer_id, std::string& data);
+
+    SessionStats stats() const;
+
+private:
+    struct Session {
+        SessionKey tx_key;
+        SessionKey rx_key;
+        uint64_t   tx_counter;
+        uint64_t   rx_highest;
+        uint64_t   rx_window;      // Bit i = rx_highest - i seen
+        bool       rx_any;
+        std::list<uint64_t>::iterator lru;
+    };
+
+    Session* touch(uint64_t peer_id);               // mutex_ held
+    static bool replayed(const Session& s, uint64_t counter);
+
+    mutable std::mutex mutex_;
+    size_t capacity_;
+    std::list<uint64_t> lru_;                        // Front = most recent
+    std::unordered_map<uint64_t, Session> sessions_;
+    std::unordered_set<uint64_t> connected_;
+    std::unordered_set<uint64_t> keyed_;             // Installed and not removed
+    SessionStats stats_;
+};
@@ -0,0 +1,35 @@
+/**
+ * SHA-512 - Hash (FIPS 180-4)
+ *
+ * Needed only because Ed25519 (RFC 8032) is defined over SHA-512; the
+ * rest of the core hashes with BLAKE2s.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+using Sha512Digest = std::array<uint8_t, 64>;
+
+class Sha512 {
+public:
+    static constexpr size_t kBlockBytes = 128;
+
+    Sha512();
+
+    void update(const void* data, size_t len);
+    void final(uint8_t out[64]);
+
+    // One-shot helper
+    static Sha512Digest hash(const void* data, size_t len);
+
+private:
+    void compress(const uint8_t* block);
+
+    uint64_t h_[8];
+    uint64_t total_;
+    uint8_t  buf_[kBlockBytes];
+    size_t   buf_len_;
+};
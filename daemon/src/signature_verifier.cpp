@@ -0,0 +1,238 @@
+/**
+ * SignatureVerifier Implementation
+ */
+
+#include "signature_verifier.h"
+#include "ed25519.h"
+#include "frame.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+constexpr size_t kKeyOffset       = kFrameHeaderBytes;
+constexpr size_t kSignatureOffset = kKeyOffset + kEd25519PublicKeyBytes;
+constexpr size_t kPayloadOffset   = kSignatureOffset + kEd25519SignatureBytes;
+
+// Starting guess for one signature in a batch; replaced by measurements
+constexpr auto kInitialCost = std::chrono::microseconds(150);
+
+// Fixed cost of a batch (shared doubling chain, base point), counted in
+// signature-equivalents
+constexpr int64_t kBatchSetup = 4;
+
+// Share of the budget held back for wake-up and scheduling delays
+constexpr int64_t kSlackDivisor = 8;
+
+bool well_formed(const std::string& frame) {
+    return frame.size() >= kPayloadOffset && is_frame(frame) &&
+           frame_header(frame).type == FrameType::Signed;
+}
+
+const uint8_t* bytes_at(const std::string& frame, size_t offset) {
+    return reinterpret_cast<const uint8_t*>(frame.data()) + offset;
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Keys and Frames
+// =============================================================================
+
+SigningKey SigningKey::from_seed(const uint8_t seed[32]) {
+    SigningKey key;
+    std::copy(seed, seed + 32, key.seed.begin());
+    ed25519_public_key(key.seed.data(), key.public_key.data());
+    return key;
+}
+
+std::string SignatureVerifier::sign_frame(const SigningKey& key, const std::string& payload) {
+    std::string frame = make_frame(FrameType::Signed, std::string(kEd25519PublicKeyBytes + kEd25519SignatureBytes, '\0'));
+    frame.append(payload);
+
+    uint8_t* out = reinterpret_cast<uint8_t*>(&frame[0]);
+    std::copy(key.public_key.begin(), key.public_key.end(), out + kKeyOffset);
+    ed25519_sign(key.seed.data(), key.public_key.data(),
+                 bytes_at(frame, kPayloadOffset), payload.size(), out + kSignatureOffset);
+    return frame;
+}
+
+bool SignatureVerifier::signer_of(const std::string& frame, SignerKey& out) {
+    if (!well_formed(frame)) {
+        return false;
+    }
+    std::copy(bytes_at(frame, kKeyOffset), bytes_at(frame, kSignatureOffset), out.begin());
+    return true;
+}
+
+bool SignatureVerifier::verify_frame(const std::string& frame) {
+    return well_formed(frame) &&
+           ed25519_verify(bytes_at(frame, kKeyOffset), bytes_at(frame, kPayloadOffset),
+                          frame.size() - kPayloadOffset, bytes_at(frame, kSignatureOffset));
+}
+
+void SignatureVerifier::unwrap(std::string& frame, SignerKey& signer) {
+    signer_of(frame, signer);
+    frame.erase(0, kPayloadOffset);
+}
+
+bool SignatureVerifier::open_frame(std::string& frame, SignerKey& signer) {
+    if (!verify_frame(frame)) {
+        return false;
+    }
+    unwrap(frame, signer);
+    return true;
+}
+
+// =============================================================================
+// MARK: - Pool
+// =============================================================================
+
+SignatureVerifier::SignatureVerifier(const VerifierConfig& config, Completion completion)
+    : config_(config)
+    , completion_(std::move(completion))
+    , stopping_(false)
+    , per_signature_(kInitialCost)
+    , stats_{0, 0, 0, 0, 0, 0}
+{
+    const unsigned threads = std::max(1u, config_.threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers_.emplace_back(&SignatureVerifier::worker_loop, this);
+    }
+}
+
+SignatureVerifier::~SignatureVerifier() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+bool SignatureVerifier::submit(uint64_t peer_id, uint64_t tag, std::string&& frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.size() >= config_.max_pending) {
+            stats_.dropped++;
+            return false;
+        }
+        pending_.push_back(Pending{ peer_id, tag, std::move(frame), Clock::now() });
+    }
+    cv_.notify_one();
+    return true;
+}
+
+VerifierStats SignatureVerifier::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void SignatureVerifier::worker_loop() {
+    const size_t max_batch = std::max<size_t>(1, config_.max_batch);
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        cv_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        if (stopping_) {
+            return;
+        }
+
+        // Hold out for a fuller batch only while the oldest frame can
+        // still be verified within its budget
+        if (pending_.size() < max_batch) {
+            const auto cut_at = pending_.front().arrived + config_.latency_budget -
+                                config_.latency_budget / kSlackDivisor -
+                                per_signature_ * (static_cast<int64_t>(pending_.size()) + 1 + kBatchSetup);
+            if (Clock::now() < cut_at) {
+                cv_.wait_until(lock, cut_at);
+                continue;
+            }
+        }
+
+        const size_t take = std::min(max_batch, pending_.size());
+        std::vector<Pending> batch;
+        batch.reserve(take);
+        for (size_t i = 0; i < take; ++i) {
+            batch.push_back(std::move(pending_.front()));
+            pending_.pop_front();
+        }
+
+        // Another worker can start on what is left
+        if (!pending_.empty()) {
+            cv_.notify_one();
+        }
+
+        lock.unlock();
+        verify_batch(batch);
+        lock.lock();
+    }
+}
+
+void SignatureVerifier::verify_batch(std::vector<Pending>& batch) {
+    std::vector<Ed25519BatchItem> items;
+    std::vector<size_t> slots;
+    items.reserve(batch.size());
+    slots.reserve(batch.size());
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const std::string& frame = batch[i].frame;
+        if (well_formed(frame)) {
+            items.push_back(Ed25519BatchItem{
+                bytes_at(frame, kKeyOffset),
+                bytes_at(frame, kPayloadOffset),
+                frame.size() - kPayloadOffset,
+                bytes_at(frame, kSignatureOffset)
+            });
+            slots.push_back(i);
+        }
+    }
+
+    const auto started = Clock::now();
+    std::unique_ptr<bool[]> item_valid(new bool[items.size() + 1]);
+    ed25519_verify_batch(items.data(), items.size(), item_valid.get());
+    const auto elapsed = Clock::now() - started;
+
+    std::vector<bool> valid(batch.size(), false);
+    for (size_t i = 0; i < slots.size(); ++i) {
+        valid[slots[i]] = item_valid[i];
+    }
+
+    uint64_t verified = 0;
+    uint64_t over_budget = 0;
+    uint64_t max_latency_us = 0;
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Pending& p = batch[i];
+        SignerKey signer{};
+        if (valid[i]) {
+            unwrap(p.frame, signer);
+            verified++;
+        }
+        completion_(p.peer_id, p.tag, std::move(p.frame), signer, valid[i]);
+
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - p.arrived);
+        if (latency > config_.latency_budget) {
+            over_budget++;
+        }
+        max_latency_us = std::max<uint64_t>(max_latency_us, static_cast<uint64_t>(latency.count()));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.verified += verified;
+    stats_.rejected += batch.size() - verified;
+    stats_.batches++;
+    stats_.over_budget += over_budget;
+    stats_.max_latency_us = std::max(stats_.max_latency_us, max_latency_us);
+
+    // Running average (1/4 weight to the newest batch)
+    if (!items.empty()) {
+        const auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed) /
+                          (static_cast<int64_t>(items.size()) + kBatchSetup);
+        per_signature_ = (per_signature_ * 3 + cost) / 4;
+    }
+}
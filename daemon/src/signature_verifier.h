@@ -0,0 +1,133 @@
+/**
+ * SignatureVerifier - Batched Ed25519 Verification Stage
+ *
+ * Signed frames are handed over by the daemon thread and verified on a
+ * small worker pool, so a burst of relayed or broadcast traffic never
+ * stalls the event loop. Workers verify in batches (ed25519_verify_batch)
+ * because the per-signature cost drops as batches grow. Waiting for a
+ * fuller batch is only allowed while the oldest frame can still make its
+ * latency budget: a batch is cut when it is full, or when
+ *
+ *     oldest arrival + budget - estimated batch cost <= now
+ *
+ * where the per-signature cost is a running average of measured batches.
+ *
+ * Signed frame (FrameType::Signed):
+ *   [4] frame header
+ *   [32] signer public key
+ *   [64] signature over the payload
+ *   [..] payload
+ *
+ * A valid signature only proves the frame matches the key it carries;
+ * the daemon binds that key to the sender's UID (basic_daemon.h).
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr size_t kSignedOverhead = 4 + 32 + 64;
+
+// Ed25519 public key
+using SignerKey = std::array<uint8_t, 32>;
+
+/**
+ * Pool configuration
+ */
+struct VerifierConfig {
+    size_t                    max_batch      = 64;
+    std::chrono::microseconds latency_budget = std::chrono::microseconds(5000);
+    unsigned                  threads        = 2;
+    size_t                    max_pending    = 4096;   // Queued frames before submit() refuses
+};
+
+/**
+ * Verification counters
+ */
+struct VerifierStats {
+    uint64_t verified;        // Valid signatures delivered
+    uint64_t rejected;        // Invalid or malformed frames
+    uint64_t batches;         // Batches verified
+    uint64_t over_budget;     // Frames that finished later than the budget
+    uint64_t max_latency_us;  // Worst arrival-to-completion latency
+    uint64_t dropped;         // Refused because the queue was full
+};
+
+/**
+ * Signing identity (seed + derived public key)
+ */
+struct SigningKey {
+    std::array<uint8_t, 32> seed;
+    SignerKey               public_key;
+
+    static SigningKey from_seed(const uint8_t seed[32]);
+};
+
+class SignatureVerifier {
+public:
+    // Invoked on a pool thread, in arrival order within a batch (batches
+    // on different threads finish in any order); the payload has the
+    // signature envelope stripped when valid, and tag is submit()'s
+    using Completion = std::function<void(uint64_t peer_id, uint64_t tag, std::string&& payload,
+                                          const SignerKey& signer, bool valid)>;
+
+    SignatureVerifier(const VerifierConfig& config, Completion completion);
+    ~SignatureVerifier();
+
+    SignatureVerifier(const SignatureVerifier&) = delete;
+    SignatureVerifier& operator=(const SignatureVerifier&) = delete;
+
+    // Queue a signed frame (thread-safe); false if max_pending are queued
+    bool submit(uint64_t peer_id, uint64_t tag, std::string&& frame);
+
+    VerifierStats stats() const;
+
+    // Wrap a payload in a signed frame
+    static std::string sign_frame(const SigningKey& key, const std::string& payload);
+
+    // The key a signed frame claims; false if it is not a signed frame
+    static bool signer_of(const std::string& frame, SignerKey& out);
+
+    // Verify one frame (no batching), leaving it intact
+    static bool verify_frame(const std::string& frame);
+
+    // Strip the envelope of a verified frame in place
+    static void unwrap(std::string& frame, SignerKey& signer);
+
+    // verify_frame() and unwrap()
+    static bool open_frame(std::string& frame, SignerKey& signer);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Pending {
+        uint64_t          peer_id;
+        uint64_t          tag;
+        std::string       frame;
+        Clock::time_point arrived;
+    };
+
+    void worker_loop();
+    void verify_batch(std::vector<Pending>& batch);
+
+    const VerifierConfig config_;
+    const Completion     completion_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+    std::deque<Pending>     pending_;
+    bool                    stopping_;
+    std::chrono::nanoseconds per_signature_;   // Running average cost
+    VerifierStats           stats_;
+
+    std::vector<std::thread> workers_;
+};
@@ -0,0 +1,425 @@
+/**
+ * Snapshot Implementation
+ */
+
+#include "snapshot.h"
+#include "byte_io.h"
+#include "crc32.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t kMagic         = 0x5353434D; // "MCSS"
+constexpr uint16_t kVersion       = 1;
+constexpr size_t   kHeaderBytes   = 24;
+constexpr uint32_t kMaxBodyBytes  = 64u << 20;
+constexpr size_t   kMaxStringLen  = 0xFFFF;   // Strings carry a u16 length
+
+enum SectionType : uint16_t {
+    kSectionPeers         = 1,
+    kSectionConversations = 2
+};
+
+int64_t now_ms() {
+    auto epoch = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(epoch).count();
+}
+
+// A UID too long for its length field cannot be cut without becoming
+// another peer's, so the peer is left out and counted
+void encode_peers(std::string& body, const std::vector<KnownPeer>& peers, uint64_t& skipped) {
+    std::string section;
+    put_u32(section, 0);
+    uint32_t count = 0;
+    for (const auto& peer : peers) {
+        if (peer.uid.size() > kMaxStringLen) {
+            skipped++;
+            continue;
+        }
+        put_u16(section, static_cast<uint16_t>(peer.uid.size()));
+        section.append(peer.uid);
+        put_u64(section, peer.last_peer_id);
+        put_u64(section, static_cast<uint64_t>(peer.last_seen));
+        put_u64(section, peer.tx_seq);
+        put_u64(section, peer.rx_seq);
+        count++;
+    }
+    store_u32(&section[0], count);
+
+    put_u16(body, kSectionPeers);
+    put_u32(body, static_cast<uint32_t>(section.size()));
+    body.append(section);
+}
+
+bool decode_peers(const char* p, size_t len, std::vector<KnownPeer>& peers) {
+    if (len < 4) {
+        return false;
+    }
+    const uint32_t count = get_u32(p);
+    size_t pos = 4;
+
+    peers.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (pos + 2 > len) {
+            return false;
+        }
+        const uint16_t uid_len = get_u16(p + pos);
+        pos += 2;
+        if (pos + uid_len + 32 > len) {
+            return false;
+        }
+
+        KnownPeer peer;
+        peer.uid.assign(p + pos, uid_len);
+        pos += uid_len;
+        peer.last_peer_id = get_u64(p + pos);
+        peer.last_seen = static_cast<int64_t>(get_u64(p + pos + 8));
+        peer.tx_seq = get_u64(p + pos + 16);
+        peer.rx_seq = get_u64(p + pos + 24);
+        pos += 32;
+        peers.push_back(std::move(peer));
+    }
+
+    return pos == len;
+}
+
+bool write_file_atomic(const std::string& path, const std::string& bytes) {
+    const std::string tmp = path + ".tmp";
+
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    ok = std::fflush(f) == 0 && ok;
+    ok = ::fsync(::fileno(f)) == 0 && ok;
+    std::fclose(f);
+
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Over-long conversation keys are skipped like peer UIDs; an over-long
+// preview is only a preview, so it is cut to fit
+void encode_conversations(std::string& body, const std::vector<ConversationSummary>& convs, uint64_t& skipped) {
+    std::string section;
+    put_u32(section, 0);
+    uint32_t count = 0;
+    for (const auto& c : convs) {
+        if (c.conversation.size() > kMaxStringLen) {
+            skipped++;
+            continue;
+        }
+        put_u16(section, static_cast<uint16_t>(c.conversation.size()));
+        section.append(c.conversation);
+        const size_t preview_len = std::min(c.last_message.size(), kMaxStringLen);
+        put_u16(section, static_cast<uint16_t>(preview_len));
+        section.append(c.last_message, 0, preview_len);
+        put_u64(section, static_cast<uint64_t>(c.last_timestamp));
+        put_u8(section, c.last_outbound ? 1 : 0);
+        put_u64(section, c.message_count);
+        put_u64(section, c.inbound_count);
+        put_u64(section, c.read_count);
+        count++;
+    }
+    store_u32(&section[0], count);
+
+    put_u16(body, kSectionConversations);
+    put_u32(body, static_cast<uint32_t>(section.size()));
+    body.append(section);
+}
+
+bool decode_conversations(const char* p, size_t len, std::vector<ConversationSummary>& convs) {
+    if (len < 4) {
+        return false;
+    }
+    const uint32_t count = get_u32(p);
+    size_t pos = 4;
+
+    convs.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        ConversationSummary c;
+
+        if (pos + 2 > len) {
+            return false;
+        }
+        const uint16_t name_len = get_u16(p + pos);
+        pos += 2;
+        if (pos + name_len + 2 > len) {
+            return false;
+        }
+        c.conversation.assign(p + pos, name_len);
+        pos += name_len;
+
+        const uint16_t preview_len = get_u16(p + pos);
+        pos += 2;
+        if (pos + preview_len + 33 > len) {
+            return false;
+        }
+        c.last_message.assign(p + pos, preview_len);
+        pos += preview_len;
+
+        c.last_timestamp = static_cast<int64_t>(get_u64(p + pos));
+        c.last_outbound = p[pos + 8] != 0;
+        c.message_count = get_u64(p + pos + 9);
+        c.inbound_count = get_u64(p + pos + 17);
+        c.read_count = get_u64(p + pos + 25);
+        pos += 33;
+        convs.push_back(std::move(c));
+    }
+
+    return pos == len;
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Encoding
+// =============================================================================
+
+std::string encode_snapshot(const DaemonState& state, uint64_t* skipped) {
+    uint64_t left_out = 0;
+    std::string body;
+    encode_peers(body, state.peers, left_out);
+    encode_conversations(body, state.conversations, left_out);
+    if (skipped) {
+        *skipped = left_out;
+    }
+
+    std::string out;
+    out.reserve(kHeaderBytes + body.size());
+    put_u32(out, kMagic);
+    put_u16(out, kVersion);
+    put_u16(out, 0);
+    put_u64(out, static_cast<uint64_t>(state.saved_at));
+    put_u32(out, static_cast<uint32_t>(body.size()));
+    put_u32(out, crc32(body.data(), body.size()));
+    out.append(body);
+    return out;
+}
+
+bool decode_snapshot(const std::string& bytes, DaemonState& state) {
+    if (bytes.size() < kHeaderBytes) {
+        return false;
+    }
+
+    const char* p = bytes.data();
+    if (get_u32(p) != kMagic || get_u16(p + 4) != kVersion) {
+        return false;
+    }
+
+    const uint32_t body_len = get_u32(p + 16);
+    if (body_len > kMaxBodyBytes || bytes.size() != kHeaderBytes + body_len) {
+        return false;
+    }
+
+    const char* body = p + kHeaderBytes;
+    if (crc32(body, body_len) != get_u32(p + 20)) {
+        return false;
+    }
+
+    DaemonState decoded;
+    decoded.saved_at = static_cast<int64_t>(get_u64(p + 8));
+
+    size_t pos = 0;
+    while (pos < body_len) {
+        if (pos + 6 > body_len) {
+            return false;
+        }
+        const uint16_t type = get_u16(body + pos);
+        const uint32_t len = get_u32(body + pos + 2);
+        pos += 6;
+        if (len > body_len - pos) {
+            return false;
+        }
+
+        if (type == kSectionPeers && !decode_peers(body + pos, len, decoded.peers)) {
+            return false;
+        }
+        if (type == kSectionConversations &&
+            !decode_conversations(body + pos, len, decoded.conversations)) {
+            return false;
+        }
+        pos += len;
+    }
+
+    state = std::move(decoded);
+    return true;
+}
+
+bool write_snapshot_file(const std::string& path, const DaemonState& state) {
+    return write_file_atomic(path, encode_snapshot(state));
+}
+
+bool read_snapshot_file(const std::string& path, DaemonState& state) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+
+    std::string bytes;
+    char buf[64 * 1024];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) {
+        bytes.append(buf, n);
+        if (bytes.size() > kHeaderBytes + kMaxBodyBytes) {
+            break;
+        }
+    }
+    std::fclose(f);
+
+    return decode_snapshot(bytes, state);
+}
+
+// =============================================================================
+// MARK: - SnapshotWriter
+// =============================================================================
+
+SnapshotWriter::SnapshotWriter()
+    : interval_ms_(0)
+    , running_(false)
+    , rescheduled_(false)
+    , last_crc_(0)
+    , written_(0)
+    , skipped_(0)
+{
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    stop();
+}
+
+void SnapshotWriter::start(const std::string& path, uint32_t interval_ms, StateProvider provider) {
+    stop();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    path_ = path;
+    interval_ms_ = interval_ms;
+    provider_ = std::move(provider);
+    running_ = true;
+
+    if (interval_ms_ > 0) {
+        thread_ = std::thread(&SnapshotWriter::writer_loop, this);
+    }
+}
+
+void SnapshotWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+
+    cv_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool SnapshotWriter::save_now() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!provider_) {
+            return false;
+        }
+    }
+    return save_locked();
+}
+
+void SnapshotWriter::set_interval(uint32_t interval_ms) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || interval_ms_ == 0 || interval_ms == 0 || interval_ms == interval_ms_) {
+            return;
+        }
+        interval_ms_ = interval_ms;
+        rescheduled_ = true;
+    }
+    cv_.notify_one();
+}
+
+uint32_t SnapshotWriter::interval() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return interval_ms_;
+}
+
+uint64_t SnapshotWriter::snapshots_written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+uint64_t SnapshotWriter::entries_skipped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return skipped_;
+}
+
+void SnapshotWriter::writer_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (running_) {
+        rescheduled_ = false;
+        cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_), [this] {
+            return !running_ || rescheduled_;
+        });
+
+        if (!running_) {
+            break;
+        }
+        if (rescheduled_) {
+            continue; // Wait out the new period instead
+        }
+
+        lock.unlock();
+        save_locked();
+        lock.lock();
+    }
+}
+
+bool SnapshotWriter::save_locked() {
+    std::lock_guard<std::mutex> write_lock(write_mutex_);
+
+    StateProvider provider;
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        provider = provider_;
+        path = path_;
+    }
+
+    DaemonState state = provider();
+    state.saved_at = now_ms();
+    uint64_t skipped = 0;
+    const std::string bytes = encode_snapshot(state, &skipped);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        skipped_ = skipped;
+    }
+
+    // Skip the write (and the flash wear) when the body is unchanged
+    const uint32_t crc = get_u32(bytes.data() + 20);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (written_ > 0 && crc == last_crc_) {
+            return true;
+        }
+    }
+
+    if (!write_file_atomic(path, bytes)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_crc_ = crc;
+    written_++;
+    return true;
+}
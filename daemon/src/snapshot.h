@@ -0,0 +1,115 @@
+/**
+ * Snapshot - Warm-Restart State
+ *
+ * Compact binary snapshot of daemon state so a relaunched core does not
+ * rediscover everything from scratch.
+ *
+ * File Format (little-endian):
+ *   u32 magic "MCSS"
+ *   u16 version
+ *   u16 reserved
+ *   i64 saved_at (Unix ms)
+ *   u32 body_len
+ *   u32 crc32(body)
+ *   body: sections of [u16 type][u32 len][len bytes]
+ *
+ * Unknown section types are skipped, so newer subsystems can add their
+ * own sections without breaking older readers.
+ *
+ * Crash Consistency:
+ *   Snapshots are written to "<path>.tmp", fsync'd and renamed over
+ *   <path>; readers only ever see a complete, checksummed file.
+ */
+
+#pragma once
+
+#include "daemon.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// =============================================================================
+// MARK: - State
+// =============================================================================
+
+struct DaemonState {
+    int64_t                          saved_at;
+    std::vector<KnownPeer>           peers;
+    std::vector<ConversationSummary> conversations;
+
+    DaemonState() : saved_at(0) {}
+};
+
+// =============================================================================
+// MARK: - Encoding
+// =============================================================================
+
+// Peers and conversations whose UID or key does not fit the u16 length
+// are left out; skipped receives how many (previews are cut instead)
+std::string encode_snapshot(const DaemonState& state, uint64_t* skipped = nullptr);
+bool decode_snapshot(const std::string& bytes, DaemonState& state);
+
+bool write_snapshot_file(const std::string& path, const DaemonState& state);
+bool read_snapshot_file(const std::string& path, DaemonState& state);
+
+// =============================================================================
+// MARK: - SnapshotWriter Class
+// =============================================================================
+
+/**
+ * Periodically captures state and writes it on its own thread
+ *
+ * The provider is called on the writer thread and must be cheap and
+ * thread-safe (the daemon copies its tables under their locks).
+ * Unchanged state is not rewritten.
+ */
+class SnapshotWriter {
+public:
+    using StateProvider = std::function<DaemonState()>;
+
+    SnapshotWriter();
+    ~SnapshotWriter();
+
+    // Non-copyable
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    void start(const std::string& path, uint32_t interval_ms, StateProvider provider);
+    void stop();
+
+    // Capture and write immediately (any thread)
+    bool save_now();
+
+    // Change the period of a running writer (no effect if started with 0)
+    void set_interval(uint32_t interval_ms);
+    uint32_t interval() const;
+
+    uint64_t snapshots_written() const;
+
+    // Entries left out of the latest snapshot (see encode_snapshot)
+    uint64_t entries_skipped() const;
+
+private:
+    void writer_loop();
+    bool save_locked();
+
+    std::string   path_;
+    uint32_t      interval_ms_;
+    StateProvider provider_;
+
+    bool     running_;
+    bool     rescheduled_;
+    uint32_t last_crc_;
+    uint64_t written_;
+    uint64_t skipped_;
+
+    mutable std::mutex      mutex_;
+    std::mutex              write_mutex_;
+    std::condition_variable cv_;
+    std::thread             thread_;
+};
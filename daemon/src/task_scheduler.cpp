@@ -0,0 +1,278 @@
+/**
+ * TaskScheduler Implementation
+ *
+ * Wire format (inside a frame, sealed like any other payload):
+ *   TaskData: u32 channel, u32 seq, payload
+ *   TaskAck:  u32 channel, u32 seq
+ */
+
+#include "task_scheduler.h"
+#include "byte_io.h"
+
+#include <unordered_set>
+
+namespace {
+
+constexpr size_t kTaskHeaderBytes = 8;
+
+std::string task_frame(FrameType type, uint32_t channel, uint32_t seq, const std::string& data) {
+    std::string payload;
+    payload.reserve(kTaskHeaderBytes + data.size());
+    put_u32(payload, channel);
+    put_u32(payload, seq);
+    payload.append(data);
+    return make_frame(type, payload);
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+TaskScheduler::TaskScheduler(SendFn send, PostFn post)
+    : send_(std::move(send))
+    , post_(std::move(post))
+    , next_seq_(0)
+    , wakeups_(0)
+    , timers_fired_(0)
+    , sent_(0)
+    , acked_(0)
+    , received_(0)
+    , dropped_(0)
+    , timed_out_(0)
+{
+}
+
+bool TaskScheduler::wake(TaskWait* wait) {
+    wait->kind = TaskWait::Kind::Wakeup;
+    if (!post_(wait)) {
+        return false;
+    }
+    wakeups_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// =============================================================================
+// MARK: - Suspensions
+// =============================================================================
+
+void TaskScheduler::sleep(TaskWait* wait, Clock::duration delay) {
+    wait->kind = TaskWait::Kind::Timer;
+    wait->ok = false;
+    wait->deadline = Clock::now() + delay;
+    timers_.emplace(wait->deadline, wait);
+}
+
+void TaskScheduler::send(TaskWait* wait, uint64_t peer_id, uint32_t channel,
+                         const std::string& data, Clock::duration timeout) {
+    wait->kind = TaskWait::Kind::Ack;
+    wait->ok = false;
+    wait->peer_id = peer_id;
+    wait->channel = channel;
+    wait->seq = ++next_seq_;
+    acks_[wait->seq] = wait;
+    arm(wait, timeout);
+
+    sent_.fetch_add(1, std::memory_order_relaxed);
+    send_(peer_id, task_frame(FrameType::TaskData, channel, wait->seq, data));
+}
+
+bool TaskScheduler::receive(TaskWait* wait, uint64_t peer_id, uint32_t channel, Clock::duration timeout) {
+    Channel& ch = channels_[ChannelKey(peer_id, channel)];
+
+    if (!ch.inbox.empty()) {
+        wait->data = std::move(ch.inbox.front());
+        wait->ok = true;
+        ch.inbox.pop_front();
+        return true;
+    }
+    if (ch.receiver) {
+        wait->ok = false;
+        return true;
+    }
+
+    wait->kind = TaskWait::Kind::Receive;
+    wait->ok = false;
+    wait->peer_id = peer_id;
+    wait->channel = channel;
+    ch.receiver = wait;
+    arm(wait, timeout);
+    return false;
+}
+
+// =============================================================================
+// MARK: - Daemon Hooks
+// =============================================================================
+
+void TaskScheduler::on_frame(uint64_t peer_id, const FrameHeader& header, const char* payload, size_t len) {
+    if (len < kTaskHeaderBytes) {
+        return;
+    }
+    const uint32_t channel = get_u32(payload);
+    const uint32_t seq = get_u32(payload + 4);
+
+    if (header.type == FrameType::TaskAck) {
+        auto it = acks_.find(seq);
+        if (it == acks_.end() || it->second->peer_id != peer_id || it->second->channel != channel) {
+            return; // Late (already timed out) or not ours
+        }
+        TaskWait* wait = it->second;
+        acks_.erase(it);
+        acked_.fetch_add(1, std::memory_order_relaxed);
+        complete(wait, true);
+        return;
+    }
+
+    Channel& ch = channels_[ChannelKey(peer_id, channel)];
+    if (!ch.receiver && ch.inbox.size() >= kMaxInbox) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    received_.fetch_add(1, std::memory_order_relaxed);
+    send_(peer_id, task_frame(FrameType::TaskAck, channel, seq, std::string()));
+
+    std::string data(payload + kTaskHeaderBytes, len - kTaskHeaderBytes);
+    if (ch.receiver) {
+        TaskWait* wait = ch.receiver;
+        ch.receiver = nullptr;
+        wait->data = std::move(data);
+        complete(wait, true);
+    } else {
+        ch.inbox.push_back(std::move(data));
+    }
+}
+
+void TaskScheduler::on_peer_disconnected(uint64_t peer_id) {
+    for (auto it = acks_.begin(); it != acks_.end();) {
+        if (it->second->peer_id == peer_id) {
+            TaskWait* wait = it->second;
+            it = acks_.erase(it);
+            complete(wait, false);
+        } else {
+            ++it;
+        }
+    }
+
+    // Buffered frames go with the peer
+    for (auto it = channels_.begin(); it != channels_.end();) {
+        if (it->first.first == peer_id) {
+            if (it->second.receiver) {
+                complete(it->second.receiver, false);
+            }
+            it = channels_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// =============================================================================
+// MARK: - Timers
+// =============================================================================
+
+bool TaskScheduler::has_timers() const {
+    return !timers_.empty();
+}
+
+TaskScheduler::Clock::time_point TaskScheduler::next_deadline() const {
+    return timers_.empty() ? Clock::time_point::max() : timers_.begin()->first;
+}
+
+void TaskScheduler::fire_timers(Clock::time_point now) {
+    while (!timers_.empty() && timers_.begin()->first <= now) {
+        TaskWait* wait = timers_.begin()->second;
+        timers_.erase(timers_.begin());
+        timers_fired_.fetch_add(1, std::memory_order_relaxed);
+
+        switch (wait->kind) {
+            case TaskWait::Kind::Ack:
+                acks_.erase(wait->seq);
+                timed_out_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            case TaskWait::Kind::Receive: {
+                auto it = channels_.find(ChannelKey(wait->peer_id, wait->channel));
+                if (it != channels_.end()) {
+                    it->second.receiver = nullptr;
+                }
+                timed_out_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            default:
+                break;
+        }
+
+        wait->ok = wait->kind == TaskWait::Kind::Timer;
+        ready_.push_back(wait);
+    }
+}
+
+void TaskScheduler::arm(TaskWait* wait, Clock::duration timeout) {
+    if (timeout > Clock::duration::zero()) {
+        wait->deadline = Clock::now() + timeout;
+        timers_.emplace(wait->deadline, wait);
+    }
+}
+
+void TaskScheduler::disarm(TaskWait* wait) {
+    timers_.erase(std::make_pair(wait->deadline, wait));
+}
+
+// =============================================================================
+// MARK: - Resumption
+// =============================================================================
+
+void TaskScheduler::complete(TaskWait* wait, bool ok) {
+    disarm(wait);
+    wait->ok = ok;
+    ready_.push_back(wait);
+}
+
+void TaskScheduler::run_ready() {
+    // A resumed task may complete others (or finish and free its wait)
+    while (!ready_.empty()) {
+        std::vector<TaskWait*> ready;
+        ready.swap(ready_);
+        for (TaskWait* wait : ready) {
+            wait->resume();
+        }
+    }
+}
+
+void TaskScheduler::abandon(const std::vector<TaskWait*>& queued) {
+    std::unordered_set<TaskWait*> waits(queued.begin(), queued.end());
+    for (const auto& timer : timers_) {
+        waits.insert(timer.second);
+    }
+    for (const auto& ack : acks_) {
+        waits.insert(ack.second);
+    }
+    for (const auto& channel : channels_) {
+        if (channel.second.receiver) {
+            waits.insert(channel.second.receiver);
+        }
+    }
+    waits.insert(ready_.begin(), ready_.end());
+
+    timers_.clear();
+    acks_.clear();
+    channels_.clear();
+    ready_.clear();
+
+    for (TaskWait* wait : waits) {
+        wait->abandon();
+    }
+}
+
+TaskStats TaskScheduler::stats() const {
+    return TaskStats{
+        wakeups_.load(std::memory_order_relaxed),
+        timers_fired_.load(std::memory_order_relaxed),
+        sent_.load(std::memory_order_relaxed),
+        acked_.load(std::memory_order_relaxed),
+        received_.load(std::memory_order_relaxed),
+        dropped_.load(std::memory_order_relaxed),
+        timed_out_.load(std::memory_order_relaxed)
+    };
+}
@@ -0,0 +1,165 @@
+/**
+ * TaskScheduler - Suspension Points for Daemon Tasks
+ *
+ * The worker-side half of the coroutine layer (daemon_task.h). A task
+ * suspends on a TaskWait and the scheduler resumes it on the worker
+ * thread once the wait completes:
+ *
+ *   - Wakeup:  queued behind the events already waiting (spawn, yield)
+ *   - Timer:   a deadline passed
+ *   - Ack:     the peer acknowledged a TaskData frame (or the timeout hit)
+ *   - Receive: a TaskData frame arrived on the channel (or the timeout hit)
+ *
+ * Channels are numbered per peer. Frames that arrive with no task
+ * waiting are buffered, up to kMaxInbox per channel; past that they are
+ * dropped unacknowledged, so the sender sees the overload as a timeout.
+ *
+ * This part is plain C++17, so the core builds without coroutine
+ * support; resuming a wait is one virtual call, with no allocation.
+ *
+ * Thread Safety:
+ *   wake() and stats() are thread-safe. Everything else runs on the
+ *   worker thread, which is where tasks run.
+ */
+
+#pragma once
+
+#include "frame.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * A suspended task, and the result it resumes with
+ */
+class TaskWait {
+public:
+    enum class Kind : uint8_t { Wakeup, Timer, Ack, Receive };
+
+    // Continue the task (worker thread)
+    virtual void resume() = 0;
+
+    // Free the task without resuming it (the daemon stopped)
+    virtual void abandon() = 0;
+
+    bool        ok = false;    // Acked / received / slept the full delay
+    std::string data;          // Received payload
+
+    // Scheduler bookkeeping
+    Kind     kind    = Kind::Wakeup;
+    uint64_t peer_id = 0;
+    uint32_t channel = 0;
+    uint32_t seq     = 0;
+    std::chrono::steady_clock::time_point deadline;
+
+protected:
+    ~TaskWait() = default;
+};
+
+/**
+ * Task counters
+ */
+struct TaskStats {
+    uint64_t wakeups;      // Tasks queued to resume behind pending events
+    uint64_t timers;       // Timers that fired
+    uint64_t sent;         // TaskData frames sent
+    uint64_t acked;        // ... and acknowledged in time
+    uint64_t received;     // TaskData frames accepted
+    uint64_t dropped;      // ... refused because the channel's inbox was full
+    uint64_t timed_out;    // Acks and receives that gave up
+};
+
+class TaskScheduler {
+public:
+    using Clock    = std::chrono::steady_clock;
+    using SendFn   = std::function<void(uint64_t peer_id, const std::string& frame)>;
+    using PostFn   = std::function<bool(TaskWait* wait)>;
+
+    static constexpr size_t kMaxInbox = 64;
+
+    // send: transmits task frames; post: queues a wakeup for the worker
+    // (false once the daemon is stopped)
+    TaskScheduler(SendFn send, PostFn post);
+
+    // Non-copyable
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    // Resume the task on the worker behind the queued events; false if
+    // the daemon is not running (the wait is left untouched)
+    bool wake(TaskWait* wait);
+
+    // Suspensions (worker thread). A zero timeout waits until the peer
+    // disconnects or the daemon stops.
+    void sleep(TaskWait* wait, Clock::duration delay);
+    void send(TaskWait* wait, uint64_t peer_id, uint32_t channel,
+              const std::string& data, Clock::duration timeout);
+
+    // True if it completed at once (a buffered frame, or the channel
+    // already has a receiver: ok == false); otherwise the task waits
+    bool receive(TaskWait* wait, uint64_t peer_id, uint32_t channel, Clock::duration timeout);
+
+    // Daemon hooks (worker thread)
+    void on_frame(uint64_t peer_id, const FrameHeader& header, const char* payload, size_t len);
+    void on_peer_disconnected(uint64_t peer_id);
+
+    // Timers: the worker sleeps no later than next_deadline()
+    bool has_timers() const;
+    Clock::time_point next_deadline() const;
+    void fire_timers(Clock::time_point now);
+
+    // Resume every completed wait
+    void run_ready();
+
+    // The daemon stopped: free every suspended task, including wakeups
+    // taken back from its queue
+    void abandon(const std::vector<TaskWait*>& queued);
+
+    TaskStats stats() const;
+
+private:
+    struct Channel {
+        std::deque<std::string> inbox;
+        TaskWait*               receiver = nullptr;
+    };
+
+    struct ChannelKeyHash {
+        size_t operator()(const std::pair<uint64_t, uint32_t>& key) const {
+            return std::hash<uint64_t>()(key.first * 0x9E3779B97F4A7C15ull ^ key.second);
+        }
+    };
+
+    using ChannelKey = std::pair<uint64_t, uint32_t>;
+
+    // Completed: clear its timer and queue it to resume
+    void complete(TaskWait* wait, bool ok);
+
+    void arm(TaskWait* wait, Clock::duration timeout);
+    void disarm(TaskWait* wait);
+
+    SendFn send_;
+    PostFn post_;
+
+    uint32_t next_seq_;
+    std::set<std::pair<Clock::time_point, TaskWait*>> timers_;
+    std::unordered_map<uint32_t, TaskWait*> acks_;
+    std::unordered_map<ChannelKey, Channel, ChannelKeyHash> channels_;
+    std::vector<TaskWait*> ready_;
+
+    std::atomic<uint64_t> wakeups_;
+    std::atomic<uint64_t> timers_fired_;
+    std::atomic<uint64_t> sent_;
+    std::atomic<uint64_t> acked_;
+    std::atomic<uint64_t> received_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> timed_out_;
+};
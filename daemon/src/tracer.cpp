@@ -0,0 +1,305 @@
+/**
+ * Tracer Implementation
+ */
+
+#include "tracer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+std::atomic<uint64_t> next_tracer_id{1};
+
+// Last tracer this thread wrote to, and its ring there
+struct RingCache {
+    uint64_t tracer_id = 0;
+    void*    ring = nullptr;
+};
+thread_local RingCache ring_cache;
+
+const char* category_name(uint8_t category) {
+    switch (TraceCategory(category)) {
+        case TraceCategory::Enqueue:  return "enqueue";
+        case TraceCategory::Dequeue:  return "dequeue";
+        case TraceCategory::Batch:    return "batch";
+        case TraceCategory::Stage:    return "stage";
+        case TraceCategory::Callback: return "callback";
+        case TraceCategory::Send:     return "send";
+    }
+    return "other";
+}
+
+size_t round_up_pow2(size_t n) {
+    size_t size = 16;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+void write_escaped(std::ostream& out, const char* text, size_t max) {
+    for (size_t i = 0; i < max && text[i] != '\0'; ++i) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '"' || c == '\\') {
+            out << '\\' << char(c);
+        } else if (c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << char(c);
+        }
+    }
+}
+
+// Microseconds with nanosecond precision, as the format expects
+void write_us(std::ostream& out, uint64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000), static_cast<unsigned long long>(ns % 1000));
+    out << text;
+}
+
+} // namespace
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+Tracer::Ring::Ring(size_t capacity, uint32_t tid_)
+    : slots(new Slot[capacity])
+    , mask(capacity - 1)
+    , tid(tid_)
+    , head(0)
+    , floor(0)
+{
+    for (size_t i = 0; i < capacity; ++i) {
+        slots[i].seq.store(0, std::memory_order_relaxed);
+    }
+}
+
+Tracer::Tracer(size_t ring_events, size_t max_threads)
+    : id_(next_tracer_id.fetch_add(1, std::memory_order_relaxed))
+    , ring_events_(round_up_pow2(ring_events))
+    , max_threads_(max_threads)
+    , enabled_(false)
+    , dropped_(0)
+{
+}
+
+Tracer::~Tracer() = default;
+
+void Tracer::name_thread(const std::string& name) {
+    const std::thread::id self = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < owners_.size(); ++i) {
+        if (owners_[i] == self) {
+            rings_[i]->name = name;
+        }
+    }
+    for (auto& entry : names_) {
+        if (entry.first == self) {
+            entry.second = name;
+            return;
+        }
+    }
+    names_.emplace_back(self, name);
+}
+
+// =============================================================================
+// MARK: - Recording
+// =============================================================================
+
+void Tracer::span(TraceCategory category, const char* name, uint64_t start_ns, uint64_t duration_ns,
+                  uint64_t peer_id, uint64_t arg) {
+    write('X', category, name, start_ns, duration_ns, peer_id, arg);
+}
+
+void Tracer::instant(TraceCategory category, const char* name, uint64_t at_ns, uint64_t peer_id, uint64_t arg) {
+    write('i', category, name, at_ns, 0, peer_id, arg);
+}
+
+void Tracer::write(char phase, TraceCategory category, const char* name, uint64_t start_ns, uint64_t duration_ns,
+                   uint64_t peer_id, uint64_t arg) {
+    Ring* r = ring();
+    if (!r) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Only this thread writes the ring
+    const uint64_t index = r->head.load(std::memory_order_relaxed);
+    Slot& slot = r->slots[index & r->mask];
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    char text[kTextWords * sizeof(uint64_t)];
+    std::strncpy(text, name, kNameSize);
+    text[kNameSize] = char(category);
+    text[kNameSize + 1] = phase;
+    uint64_t text_words[kTextWords];
+    std::memcpy(text_words, text, sizeof(text));
+
+    slot.words[0].store(start_ns, std::memory_order_relaxed);
+    slot.words[1].store(duration_ns, std::memory_order_relaxed);
+    slot.words[2].store(peer_id, std::memory_order_relaxed);
+    slot.words[3].store(arg, std::memory_order_relaxed);
+    for (size_t i = 0; i < kTextWords; ++i) {
+        slot.words[4 + i].store(text_words[i], std::memory_order_relaxed);
+    }
+
+    slot.seq.store(index + 1, std::memory_order_release);
+    r->head.store(index + 1, std::memory_order_release);
+}
+
+Tracer::Ring* Tracer::ring() {
+    if (ring_cache.tracer_id == id_) {
+        return static_cast<Ring*>(ring_cache.ring);
+    }
+    return register_thread();
+}
+
+Tracer::Ring* Tracer::register_thread() {
+    const std::thread::id self = std::this_thread::get_id();
+    Ring* found = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < owners_.size(); ++i) {
+            if (owners_[i] == self) {
+                found = rings_[i].get();
+                break;
+            }
+        }
+        if (!found) {
+            if (rings_.size() >= max_threads_) {
+                return nullptr;
+            }
+            rings_.emplace_back(new Ring(ring_events_, uint32_t(rings_.size() + 1)));
+            owners_.push_back(self);
+            found = rings_.back().get();
+            for (const auto& entry : names_) {
+                if (entry.first == self) {
+                    found->name = entry.second;
+                }
+            }
+        }
+    }
+
+    ring_cache.tracer_id = id_;
+    ring_cache.ring = found;
+    return found;
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& r : rings_) {
+        r->floor.store(r->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+// =============================================================================
+// MARK: - Export
+// =============================================================================
+
+void Tracer::export_json(std::ostream& out) const {
+    struct Entry {
+        uint32_t tid;
+        Record   record;
+    };
+    std::vector<Entry> entries;
+    std::vector<std::pair<uint32_t, std::string>> names;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& r : rings_) {
+            names.emplace_back(r->tid, r->name);
+
+            const uint64_t head = r->head.load(std::memory_order_acquire);
+            const uint64_t capacity = r->mask + 1;
+            uint64_t from = std::max(r->floor.load(std::memory_order_relaxed), head > capacity ? head - capacity : 0);
+            for (uint64_t index = from; index < head; ++index) {
+                const Slot& slot = r->slots[index & r->mask];
+                if (slot.seq.load(std::memory_order_acquire) != index + 1) {
+                    continue;
+                }
+                uint64_t words[kSlotWords];
+                for (size_t i = 0; i < kSlotWords; ++i) {
+                    words[i] = slot.words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.seq.load(std::memory_order_relaxed) != index + 1) {
+                    continue;
+                }
+
+                Entry entry;
+                entry.tid = r->tid;
+                entry.record.start_ns = words[0];
+                entry.record.duration_ns = words[1];
+                entry.record.peer_id = words[2];
+                entry.record.arg = words[3];
+                char text[kTextWords * sizeof(uint64_t)];
+                std::memcpy(text, words + 4, sizeof(text));
+                std::memcpy(entry.record.name, text, kNameSize);
+                entry.record.category = uint8_t(text[kNameSize]);
+                entry.record.phase = text[kNameSize + 1];
+                entries.push_back(entry);
+            }
+        }
+    }
+
+    uint64_t origin = UINT64_MAX;
+    for (const Entry& entry : entries) {
+        origin = std::min(origin, entry.record.start_ns);
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.record.start_ns < b.record.start_ns;
+    });
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& name : names) {
+        out << (first ? "" : ",\n");
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << name.first << ",\"args\":{\"name\":\"";
+        if (name.second.empty()) {
+            out << "thread " << name.first;
+        } else {
+            write_escaped(out, name.second.c_str(), name.second.size());
+        }
+        out << "\"}}";
+    }
+
+    for (const Entry& entry : entries) {
+        const Record& record = entry.record;
+        out << (first ? "" : ",\n");
+        first = false;
+        out << "{\"name\":\"";
+        write_escaped(out, record.name, kNameSize);
+        out << "\",\"cat\":\"" << category_name(record.category) << "\",\"ph\":\"" << record.phase << "\",\"ts\":";
+        write_us(out, record.start_ns - origin);
+        if (record.phase == 'X') {
+            out << ",\"dur\":";
+            write_us(out, record.duration_ns);
+        } else {
+            out << ",\"s\":\"t\"";
+        }
+        out << ",\"pid\":1,\"tid\":" << entry.tid
+            << ",\"args\":{\"peer\":" << record.peer_id << ",\"arg\":" << record.arg << "}}";
+    }
+    out << "\n]}\n";
+}
+
+TraceStats Tracer::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TraceStats stats{enabled(), 0, 0, uint64_t(rings_.size()), dropped_.load(std::memory_order_relaxed)};
+    for (const auto& r : rings_) {
+        const uint64_t head = r->head.load(std::memory_order_acquire);
+        const uint64_t capacity = r->mask + 1;
+        const uint64_t from = std::max(r->floor.load(std::memory_order_relaxed), head > capacity ? head - capacity : 0);
+        stats.recorded += head;
+        stats.retained += head - from;
+    }
+    return stats;
+}
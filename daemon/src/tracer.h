@@ -0,0 +1,182 @@
+/**
+ * Tracer - Event-Level Spans in Per-Thread Rings
+ *
+ * When a latency spike shows up in the histograms, the trace says which
+ * stage caused it. Each event leaves:
+ *
+ *   enqueue    instant on the posting thread
+ *   dequeue    instant on the worker, with the queue wait
+ *   batch      span per pipeline run (inbound/outbound) or task resume
+ *   stage      span per pipeline stage, with the events it saw
+ *   callback   span per app callback
+ *   send       span per Transport::send, with the bytes sent
+ *
+ * Every thread writes only its own ring of ring_events records, so
+ * recording takes no lock; the oldest records are overwritten. Rings
+ * are created on a thread's first record and live as long as the
+ * tracer, so an export still shows threads that have exited.
+ * export_json() writes the Chrome trace event format, which Perfetto
+ * (ui.perfetto.dev) and chrome://tracing both open.
+ *
+ * Disabled, a call site costs one relaxed load and a predictable branch.
+ *
+ * Thread Safety:
+ *   All methods are thread-safe. A record being overwritten while it
+ *   is exported is skipped, never torn; slots are atomic words, so the
+ *   overlap is not a data race either.
+ */
+
+#pragma once
+
+#include "metrics.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class TraceCategory : uint8_t {
+    Enqueue,
+    Dequeue,
+    Batch,
+    Stage,
+    Callback,
+    Send
+};
+
+/**
+ * Tracer counters
+ */
+struct TraceStats {
+    bool     enabled;
+    uint64_t recorded;     // Records written, including overwritten ones
+    uint64_t retained;     // Still in the rings
+    uint64_t threads;      // Rings
+    uint64_t dropped;      // Records from threads past max_threads
+};
+
+class Tracer {
+public:
+    static constexpr size_t kNameSize = 22;
+
+    // ring_events is rounded up to a power of two
+    explicit Tracer(size_t ring_events = 4096, size_t max_threads = 64);
+    ~Tracer();
+
+    // Non-copyable
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // Label the calling thread in exports (e.g. "worker"); allocates
+    // nothing until the thread records
+    void name_thread(const std::string& name);
+
+    // Record on the calling thread's ring; check enabled() first.
+    // Names longer than kNameSize are cut.
+    void span(TraceCategory category, const char* name, uint64_t start_ns, uint64_t duration_ns,
+              uint64_t peer_id = 0, uint64_t arg = 0);
+    void instant(TraceCategory category, const char* name, uint64_t at_ns,
+                 uint64_t peer_id = 0, uint64_t arg = 0);
+
+    // Forget what has been recorded (rings and thread names stay)
+    void clear();
+
+    // Chrome trace event JSON; timestamps relative to the oldest record
+    void export_json(std::ostream& out) const;
+
+    TraceStats stats() const;
+
+private:
+    struct Record {
+        uint64_t start_ns;
+        uint64_t duration_ns;
+        uint64_t peer_id;
+        uint64_t arg;
+        char     name[kNameSize];
+        uint8_t  category;
+        char     phase;          // 'X' span, 'i' instant
+    };
+
+    // Four numeric words, then name, category and phase packed into three
+    static constexpr size_t kTextWords = 3;
+    static constexpr size_t kSlotWords = 4 + kTextWords;
+    static_assert(kNameSize + 2 == kTextWords * sizeof(uint64_t), "name, category and phase fill the text words");
+
+    // The record is packed into relaxed atomic words so an export may
+    // read a slot while it is rewritten; seq tells it whether the copy holds
+    struct Slot {
+        std::atomic<uint64_t> seq;    // Index + 1 once written, 0 while writing
+        std::atomic<uint64_t> words[kSlotWords];
+    };
+
+    struct Ring {
+        Ring(size_t capacity, uint32_t tid);
+
+        std::unique_ptr<Slot[]> slots;
+        size_t                  mask;
+        uint32_t                tid;
+        std::string             name;      // Guarded by the tracer's mutex
+        std::atomic<uint64_t>   head;      // Next index to write
+        std::atomic<uint64_t>   floor;     // Indices below were cleared
+    };
+
+    // The calling thread's ring (nullptr past max_threads)
+    Ring* ring();
+    Ring* register_thread();
+
+    void write(char phase, TraceCategory category, const char* name, uint64_t start_ns, uint64_t duration_ns,
+               uint64_t peer_id, uint64_t arg);
+
+    const uint64_t id_;            // Tells tracers apart in the thread-local cache
+    const size_t   ring_events_;
+    const size_t   max_threads_;
+    std::atomic<bool> enabled_;
+    std::atomic<uint64_t> dropped_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+    std::vector<std::thread::id>       owners_;    // Thread of each ring
+    std::vector<std::pair<std::thread::id, std::string>> names_;
+};
+
+/**
+ * Times a scope into a Metrics histogram and, while tracing, a span
+ */
+class ScopedSpan {
+public:
+    ScopedSpan(Metrics& metrics, Timing timing, Tracer& tracer, TraceCategory category,
+               const char* name, uint64_t peer_id = 0, uint64_t arg = 0)
+        : metrics_(metrics), tracer_(tracer), name_(name), peer_id_(peer_id), arg_(arg),
+          start_(Metrics::now_ns()), timing_(timing), category_(category), traced_(tracer.enabled()) {}
+
+    ~ScopedSpan() {
+        const uint64_t ns = Metrics::now_ns() - start_;
+        metrics_.record(timing_, ns);
+        if (traced_) {
+            tracer_.span(category_, name_, start_, ns, peer_id_, arg_);
+        }
+    }
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+    Metrics&      metrics_;
+    Tracer&       tracer_;
+    const char*   name_;
+    uint64_t      peer_id_;
+    uint64_t      arg_;
+    uint64_t      start_;
+    Timing        timing_;
+    TraceCategory category_;
+    bool          traced_;
+};
@@ -0,0 +1,232 @@
+/**
+ * Watchdog Implementation
+ */
+
+#include "watchdog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// =============================================================================
+// MARK: - Lifecycle
+// =============================================================================
+
+Watchdog::Watchdog(Metrics& metrics)
+    : metrics_(metrics)
+    , phase_("idle")
+    , event_type_(FlightRecorder::kNoEvent)
+    , peer_id_(0)
+    , started_ns_(0)
+    , stage_seq_(0)
+    , depth_(0)
+    , oldest_ns_(0)
+    , slow_ns_(uint64_t(WatchdogConfig().slow_handler_ms) * 1000000)
+    , checks_(0)
+    , handler_stalls_(0)
+    , queue_stalls_(0)
+    , slow_handlers_(0)
+    , running_(false)
+    , sleeping_(false)
+    , reported_handler_(0)
+    , reported_queue_(0)
+{
+    for (auto& word : stage_) {
+        word.store(0, std::memory_order_relaxed);
+    }
+}
+
+Watchdog::~Watchdog() {
+    stop();
+}
+
+void Watchdog::set_config(const WatchdogConfig& config) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+        config_.check_interval_ms = std::max<uint32_t>(config_.check_interval_ms, 1);
+        slow_ns_.store(uint64_t(config.slow_handler_ms) * 1000000, std::memory_order_relaxed);
+    }
+    cv_.notify_one();
+}
+
+WatchdogConfig Watchdog::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+void Watchdog::set_callback(StallFn fn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback_ = std::move(fn);
+}
+
+void Watchdog::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    thread_ = std::thread([this] { run(); });
+}
+
+void Watchdog::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    cv_.notify_one();
+    thread_.join();
+}
+
+WatchdogStats Watchdog::stats() const {
+    return WatchdogStats{
+        checks_.load(std::memory_order_relaxed),
+        handler_stalls_.load(std::memory_order_relaxed),
+        queue_stalls_.load(std::memory_order_relaxed),
+        slow_handlers_.load(std::memory_order_relaxed)
+    };
+}
+
+// =============================================================================
+// MARK: - Worker Marks
+// =============================================================================
+
+void Watchdog::begin(const char* phase, uint8_t event_type, uint64_t peer_id, uint64_t start_ns) {
+    phase_.store(phase, std::memory_order_relaxed);
+    event_type_.store(event_type, std::memory_order_relaxed);
+    peer_id_.store(peer_id, std::memory_order_relaxed);
+    started_ns_.store(start_ns, std::memory_order_release);
+    wake();
+}
+
+void Watchdog::enter_stage(const std::string& name) {
+    const uint32_t seq = stage_seq_.load(std::memory_order_relaxed);
+    stage_seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    char bytes[StallReport::kStageSize] = {};
+    std::memcpy(bytes, name.data(), std::min(name.size(), StallReport::kStageSize - 1));
+    for (size_t i = 0; i < kStageWords; ++i) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i * sizeof(word), sizeof(word));
+        stage_[i].store(word, std::memory_order_relaxed);
+    }
+    stage_seq_.store(seq + 2, std::memory_order_release);
+}
+
+void Watchdog::end(uint64_t end_ns) {
+    const uint64_t started = started_ns_.load(std::memory_order_relaxed);
+    started_ns_.store(0, std::memory_order_release);
+    phase_.store("idle", std::memory_order_relaxed);
+    event_type_.store(FlightRecorder::kNoEvent, std::memory_order_relaxed);
+    peer_id_.store(0, std::memory_order_relaxed);
+    enter_stage(std::string());
+
+    const uint64_t ns = end_ns - started;
+    if (started != 0 && ns >= slow_ns_.load(std::memory_order_relaxed)) {
+        metrics_.record(Timing::SlowHandler, ns);
+        slow_handlers_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Watchdog::read_stage(char* out) const {
+    for (;;) {
+        const uint32_t seq = stage_seq_.load(std::memory_order_acquire);
+        if (seq & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < kStageWords; ++i) {
+            const uint64_t word = stage_[i].load(std::memory_order_relaxed);
+            std::memcpy(out + i * sizeof(word), &word, sizeof(word));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (stage_seq_.load(std::memory_order_relaxed) == seq) {
+            out[StallReport::kStageSize - 1] = '\0';
+            return;
+        }
+    }
+}
+
+// =============================================================================
+// MARK: - Checks
+// =============================================================================
+
+bool Watchdog::idle() const {
+    return started_ns_.load(std::memory_order_acquire) == 0 && depth_.load(std::memory_order_relaxed) == 0;
+}
+
+void Watchdog::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        // Nothing running or queued: sleep until begin() or set_queue()
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (idle()) {
+            cv_.wait(lock);
+            sleeping_.store(false, std::memory_order_relaxed);
+            continue;
+        }
+        sleeping_.store(false, std::memory_order_relaxed);
+
+        cv_.wait_for(lock, std::chrono::milliseconds(config_.check_interval_ms));
+        if (!running_) {
+            break;
+        }
+        lock.unlock();
+        check(Metrics::now_ns());
+        lock.lock();
+    }
+}
+
+void Watchdog::check(uint64_t now_ns) {
+    uint64_t handler_ns;
+    uint64_t queue_ns;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handler_ns = uint64_t(config_.handler_stall_ms) * 1000000;
+        queue_ns = uint64_t(config_.queue_stall_ms) * 1000000;
+    }
+    checks_.fetch_add(1, std::memory_order_relaxed);
+
+    const uint64_t started = started_ns_.load(std::memory_order_acquire);
+    const uint64_t oldest = oldest_ns_.load(std::memory_order_relaxed);
+
+    // Once per piece of work, and once per oldest event
+    if (handler_ns != 0 && started != 0 && now_ns > started && now_ns - started >= handler_ns &&
+        started != reported_handler_) {
+        reported_handler_ = started;
+        handler_stalls_.fetch_add(1, std::memory_order_relaxed);
+        report(StallKind::Handler, now_ns, started, oldest);
+    }
+    if (queue_ns != 0 && oldest != 0 && now_ns > oldest && now_ns - oldest >= queue_ns &&
+        oldest != reported_queue_) {
+        reported_queue_ = oldest;
+        queue_stalls_.fetch_add(1, std::memory_order_relaxed);
+        report(StallKind::Queue, now_ns, started, oldest);
+    }
+}
+
+void Watchdog::report(StallKind kind, uint64_t now_ns, uint64_t started_ns, uint64_t oldest_ns) {
+    StallReport report;
+    report.kind = kind;
+    report.phase = started_ns != 0 ? phase_.load(std::memory_order_relaxed) : "idle";
+    read_stage(report.stage);
+    report.event_type = event_type_.load(std::memory_order_relaxed);
+    report.peer_id = peer_id_.load(std::memory_order_relaxed);
+    report.started_ns = started_ns;
+    report.running_ns = started_ns != 0 && now_ns > started_ns ? now_ns - started_ns : 0;
+    report.queue_depth = depth_.load(std::memory_order_relaxed);
+    report.oldest_queued_ns = oldest_ns != 0 && now_ns > oldest_ns ? now_ns - oldest_ns : 0;
+
+    StallFn callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callback = callback_;
+    }
+    if (callback) {
+        callback(report);
+    }
+}
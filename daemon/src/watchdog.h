@@ -0,0 +1,172 @@
+/**
+ * Watchdog - Worker Stalls and Slow Handlers
+ *
+ * A callback that blocks the worker (a host dispatching synchronously
+ * back onto itself, say) used to hang the daemon silently while the
+ * queue grew. The worker now marks each piece of work it starts and
+ * finishes (a pipeline batch, a task resume, timers, maintenance) and
+ * every pipeline stage it enters; posters publish the queue depth and
+ * the enqueue time of the oldest event. A watchdog thread compares both
+ * against their thresholds every check_interval_ms:
+ *
+ *   handler stall   the current work has run longer than handler_stall_ms
+ *   queue stall     the oldest queued event is older than queue_stall_ms
+ *
+ * Each stall is reported once, on the watchdog thread, with the phase
+ * and stage that was running and the queue state. Work that takes
+ * slow_handler_ms or more goes into the SlowHandler histogram.
+ *
+ * Marking work is a few relaxed stores. While the worker is idle and
+ * the queue empty the watchdog thread sleeps until work starts, so an
+ * idle process has no watchdog wakeups.
+ *
+ * Thread Safety:
+ *   begin(), enter_stage() and end() are called by the worker only;
+ *   everything else is thread-safe.
+ */
+
+#pragma once
+
+#include "flight_recorder.h"
+#include "metrics.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct WatchdogConfig {
+    uint32_t handler_stall_ms  = 2000;   // 0 = not watched
+    uint32_t queue_stall_ms    = 5000;   // 0 = not watched
+    uint32_t check_interval_ms = 250;
+    uint32_t slow_handler_ms   = 50;     // Into the SlowHandler histogram
+};
+
+enum class StallKind : uint8_t {
+    Handler,
+    Queue
+};
+
+/**
+ * What the worker was doing when a stall was seen
+ */
+struct StallReport {
+    static constexpr size_t kStageSize = 32;
+
+    StallKind   kind;
+    const char* phase;             // "inbound", "outbound", "task", "timers", "pacing",
+                                   // "maintenance", or "idle"
+    char        stage[kStageSize]; // Pipeline stage running ("" outside one)
+    uint8_t     event_type;        // First event of the work (FlightRecorder::kNoEvent if none)
+    uint64_t    peer_id;
+    uint64_t    started_ns;        // When the work started (0 if idle)
+    uint64_t    running_ns;        // How long it has run
+    uint64_t    queue_depth;
+    uint64_t    oldest_queued_ns;  // Age of the oldest queued event (0 if empty)
+};
+
+/**
+ * Watchdog counters
+ */
+struct WatchdogStats {
+    uint64_t checks;
+    uint64_t handler_stalls;
+    uint64_t queue_stalls;
+    uint64_t slow_handlers;
+};
+
+class Watchdog {
+public:
+    using StallFn = std::function<void(const StallReport& report)>;
+
+    explicit Watchdog(Metrics& metrics);
+    ~Watchdog();
+
+    // Non-copyable
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+
+    void set_config(const WatchdogConfig& config);
+    WatchdogConfig config() const;
+
+    // Called on the watchdog thread for each stall
+    void set_callback(StallFn fn);
+
+    void start();
+    void stop();
+
+    // Worker thread: work started (phase is a string literal), a stage
+    // entered, work finished
+    void begin(const char* phase, uint8_t event_type, uint64_t peer_id, uint64_t start_ns);
+    void enter_stage(const std::string& name);
+    void end(uint64_t end_ns);
+
+    // Under the daemon's queue lock, whenever the queue changes
+    void set_queue(size_t depth, uint64_t oldest_queued_ns) {
+        depth_.store(depth, std::memory_order_relaxed);
+        oldest_ns_.store(oldest_queued_ns, std::memory_order_relaxed);
+        if (depth > 0) {
+            wake();
+        }
+    }
+
+    // One check at `now_ns` (the thread calls this; so can tests)
+    void check(uint64_t now_ns);
+
+    WatchdogStats stats() const;
+
+private:
+    // Wake the thread if it is sleeping through an idle spell
+    void wake() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_one();
+        }
+    }
+
+    void run();
+    bool idle() const;
+    void read_stage(char* out) const;
+    void report(StallKind kind, uint64_t now_ns, uint64_t started_ns, uint64_t oldest_ns);
+
+    Metrics& metrics_;
+
+    // Current work (written by the worker)
+    std::atomic<const char*> phase_;
+    std::atomic<uint8_t>     event_type_;
+    std::atomic<uint64_t>    peer_id_;
+    std::atomic<uint64_t>    started_ns_;     // 0 while idle
+
+    // Stage name as relaxed atomic words under a sequence lock (odd while
+    // being written), so a read racing a write is retried, never torn
+    static constexpr size_t kStageWords = StallReport::kStageSize / sizeof(uint64_t);
+    std::atomic<uint32_t> stage_seq_;
+    std::atomic<uint64_t> stage_[kStageWords];
+
+    // Queue state (written by posters and the worker)
+    std::atomic<uint64_t> depth_;
+    std::atomic<uint64_t> oldest_ns_;
+
+    std::atomic<uint64_t> slow_ns_;           // slow_handler_ms in ns, for the worker
+    std::atomic<uint64_t> checks_;
+    std::atomic<uint64_t> handler_stalls_;
+    std::atomic<uint64_t> queue_stalls_;
+    std::atomic<uint64_t> slow_handlers_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+    WatchdogConfig          config_;
+    StallFn                 callback_;
+    bool                    running_;
+    std::atomic<bool>       sleeping_;
+    std::thread             thread_;
+
+    // Last stall of each kind reported (watchdog thread)
+    uint64_t reported_handler_;
+    uint64_t reported_queue_;
+};
@@ -0,0 +1,60 @@
+/**
+ * X25519 Implementation (RFC 7748)
+ */
+
+#include "x25519.h"
+#include "field25519.h"
+
+bool x25519(uint8_t out[32], const uint8_t scalar[32], const uint8_t point[32]) {
+    uint8_t e[32];
+    std::memcpy(e, scalar, 32);
+    e[0] &= 248;
+    e[31] &= 127;
+    e[31] |= 64;
+
+    const Fe x1 = fe_from_bytes(point);
+    Fe x2 = fe_one();
+    Fe z2 = fe_zero();
+    Fe x3 = x1;
+    Fe z3 = fe_one();
+    uint64_t swap = 0;
+
+    for (int t = 254; t >= 0; --t) {
+        const uint64_t bit = (e[t >> 3] >> (t & 7)) & 1;
+        swap ^= bit;
+        fe_cswap(x2, x3, swap);
+        fe_cswap(z2, z3, swap);
+        swap = bit;
+
+        const Fe a = fe_add(x2, z2);
+        const Fe aa = fe_sq(a);
+        const Fe b = fe_sub(x2, z2);
+        const Fe bb = fe_sq(b);
+        const Fe diff = fe_sub(aa, bb);
+        const Fe c = fe_add(x3, z3);
+        const Fe d = fe_sub(x3, z3);
+        const Fe da = fe_mul(d, a);
+        const Fe cb = fe_mul(c, b);
+
+        x3 = fe_sq(fe_add(da, cb));
+        z3 = fe_mul(x1, fe_sq(fe_sub(da, cb)));
+        x2 = fe_mul(aa, bb);
+        z2 = fe_mul(diff, fe_add(aa, fe_mul_small(diff, 121665)));
+    }
+
+    fe_cswap(x2, x3, swap);
+    fe_cswap(z2, z3, swap);
+
+    fe_to_bytes(out, fe_mul(x2, fe_invert(z2)));
+
+    uint8_t acc = 0;
+    for (int i = 0; i < 32; ++i) {
+        acc |= out[i];
+    }
+    return acc != 0;
+}
+
+void x25519_public_key(uint8_t public_key[32], const uint8_t secret[32]) {
+    uint8_t base[32] = { 9 };
+    x25519(public_key, secret, base);
+}
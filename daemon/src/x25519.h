@@ -0,0 +1,24 @@
+/**
+ * X25519 - Key Agreement (RFC 7748)
+ *
+ * Constant-time Montgomery ladder over the shared field25519 arithmetic.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr size_t kX25519Bytes = 32;
+
+/**
+ * out = scalar * point (u-coordinate)
+ *
+ * @return false if the result is all zero (low-order peer point)
+ */
+bool x25519(uint8_t out[32], const uint8_t scalar[32], const uint8_t point[32]);
+
+/**
+ * Public key for a 32-byte secret
+ */
+void x25519_public_key(uint8_t public_key[32], const uint8_t secret[32]);
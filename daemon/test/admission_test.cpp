@@ -0,0 +1,223 @@
+/**
+ * Admission Test
+ *
+ * Tests per-peer token buckets, the misbehaviour score, escalating
+ * quarantine and sweeping, then a flooding peer against a well-behaved
+ * one on a running daemon, penalties for frames refused while decoding,
+ * and the C API.
+ */
+
+#include "admission.h"
+#include "daemon.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <functional>
+#include <string>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static int admit_many(AdmissionControl& control, uint64_t peer_id, int count, size_t bytes, int64_t now) {
+    int admitted = 0;
+    for (int i = 0; i < count; ++i) {
+        admitted += control.admit(peer_id, bytes, now) ? 1 : 0;
+    }
+    return admitted;
+}
+
+static std::atomic<int> c_received(0);
+
+static void on_c_message(void*, uint64_t, const char*, const char*, size_t, int64_t) {
+    c_received++;
+}
+
+int main() {
+    std::cout << "=== Admission Test ===\n\n";
+
+    std::cout << "[1] Token buckets...\n";
+    {
+        AdmissionConfig config;
+        config.frames_per_sec = 10;
+        config.burst_frames = 20;
+        config.bytes_per_sec = 0;
+        config.quarantine_score = 0;
+        AdmissionControl control(config);
+
+        check(admit_many(control, 1, 30, 10, 1000) == 20, "burst admitted, excess dropped");
+        check(admit_many(control, 2, 5, 10, 1000) == 5, "other peers unaffected");
+        check(admit_many(control, 1, 30, 10, 1500) == 5, "refill at the configured rate");
+        check(admit_many(control, 1, 30, 10, 100000) == 20, "refill capped at the burst");
+        check(admit_many(control, 1, 1, 10, 500) == 0, "clock stepping back refills nothing");
+
+        config.frames_per_sec = 0;
+        config.bytes_per_sec = 1000;
+        config.burst_bytes = 1000;
+        control.set_config(config);
+        check(admit_many(control, 3, 10, 300, 200000) == 3, "byte budget");
+        check(control.admit(4, 5000, 200000), "oversized frame charged one full burst");
+        check(!control.admit(4, 1, 200000), "... which empties the bucket");
+
+        const AdmissionStats stats = control.stats(200000);
+        check(stats.admitted == 20 + 5 + 5 + 20 + 3 + 1 && stats.rate_limited == 10 + 25 + 10 + 1 + 7 + 1,
+              "counters");
+    }
+
+    std::cout << "\n[2] Misbehaviour and quarantine...\n";
+    {
+        AdmissionConfig config;
+        config.frames_per_sec = 10;
+        config.burst_frames = 10;
+        config.bytes_per_sec = 0;
+        config.quarantine_score = 50;
+        config.score_decay_per_sec = 10;
+        config.quarantine_ms = 1000;
+        config.max_quarantine_ms = 3000;
+        AdmissionControl control(config);
+
+        // 10 admitted, then 49 drops: one short of the threshold
+        admit_many(control, 1, 59, 1, 0);
+        check(!control.is_quarantined(1, 0), "below the threshold");
+        // The score decays: a second later it is back under 40
+        check(admit_many(control, 1, 10, 1, 1000) == 10, "recovered after a pause");
+        admit_many(control, 1, 100, 1, 1000);
+        check(control.is_quarantined(1, 1000), "flood quarantined");
+        check(admit_many(control, 1, 5, 1, 1500) == 0, "everything dropped in quarantine");
+        check(control.stats(1500).quarantined_peers == 1, "quarantined peer counted");
+
+        // Buckets stay empty through the quarantine; refill starts after it
+        check(admit_many(control, 1, 10, 1, 2000) == 0, "no burst straight after quarantine");
+        check(admit_many(control, 1, 10, 1, 2500) == 5, "refills once released");
+
+        // A second offence lasts twice as long
+        admit_many(control, 1, 200, 1, 2500);
+        check(control.is_quarantined(1, 4000) && !control.is_quarantined(1, 4600), "repeat quarantine doubled");
+        admit_many(control, 1, 200, 1, 5000);
+        admit_many(control, 1, 200, 1, 9000);
+        check(control.is_quarantined(1, 11900) && !control.is_quarantined(1, 12100), "capped at the maximum");
+        check(control.stats(12100).quarantines == 4, "quarantines counted");
+
+        // Frames refused after admission count more than rate drops
+        for (int i = 0; i < 2; ++i) {
+            control.penalize(2, 20, 0);
+        }
+        check(!control.is_quarantined(2, 0), "two bad frames tolerated");
+        control.penalize(2, 20, 0);
+        check(control.is_quarantined(2, 0), "third bad frame quarantines");
+        check(control.stats(0).penalties == 3, "penalties counted");
+
+        // Idle peers are forgotten; offenders only once forgiven
+        control.admit(3, 1, 0);
+        control.sweep(2000);
+        check(control.is_quarantined(2, 500), "offender kept across a sweep");
+        control.sweep(100000);
+        check(!control.is_quarantined(2, 500), "forgiven offender forgotten");
+    }
+
+    std::cout << "\n[3] Flood on a running daemon...\n";
+    {
+        Daemon daemon;
+        AdmissionConfig config;
+        config.frames_per_sec = 100;
+        config.burst_frames = 50;
+        config.quarantine_score = 100;
+        config.quarantine_ms = 60000;
+        daemon.set_admission_config(config);
+
+        std::atomic<int> from_flooder(0);
+        std::atomic<int> from_friend(0);
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t peer_id, const std::string&, const std::string&, int64_t) {
+            (peer_id == 1 ? from_flooder : from_friend)++;
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        int accepted = 0;
+        for (int i = 0; i < 2000; ++i) {
+            accepted += daemon.submit_inbound(1, "spam", 4) ? 1 : 0;
+        }
+        for (int i = 0; i < 10; ++i) {
+            const std::string text = "hello " + std::to_string(i);
+            accepted += daemon.submit_inbound(2, text.data(), text.size()) ? 1 : 0;
+        }
+        check(wait_until([&] { return from_friend == 10 && from_flooder + from_friend == accepted; }),
+              "admitted frames delivered");
+        check(from_flooder <= 60, "flood cut to the budget");
+
+        AdmissionStats stats = daemon.admission_stats();
+        check(stats.quarantines == 1 && stats.quarantined_peers == 1, "flooder quarantined");
+        check(stats.rate_limited + stats.quarantine_dropped == 2010u - uint64_t(accepted), "drops counted");
+        check(!daemon.submit_inbound(1, "later", 5), "quarantine holds");
+
+        // Plaintext from a peer with a session is refused while decoding;
+        // decoding overlaps submission, so once the peer is quarantined
+        // the rest never get past admission
+        SessionKey key{};
+        daemon.sessions().install(3, key, key);
+        const uint64_t dropped_before = daemon.admission_stats().quarantine_dropped;
+        for (int i = 0; i < 30; ++i) {
+            daemon.submit_inbound(3, "forged", 6);
+        }
+        check(wait_until([&] {
+            const AdmissionStats s = daemon.admission_stats();
+            return s.penalties + (s.quarantine_dropped - dropped_before) == 30;
+        }), "every forged frame refused or dropped");
+        stats = daemon.admission_stats();
+        check(stats.quarantines == 2 && stats.penalties >= 5, "refused frames lead to quarantine");
+        check(daemon.ingress_stats().dropped >= 5, "refused while decoding");
+
+        daemon.stop();
+    }
+
+    std::cout << "\n[4] C API...\n";
+    {
+        meshcore* core = meshcore_create();
+        meshcore_callbacks callbacks = {};
+        callbacks.on_message = on_c_message;
+        meshcore_set_callbacks(core, &callbacks);
+        meshcore_simulate_peer_connect(core, 9, "c-peer");
+
+        meshcore_admission_policy policy = {};
+        policy.frames_per_sec = 1;
+        policy.burst_frames = 3;
+        check(meshcore_set_admission_policy(core, &policy) == MESHCORE_OK, "policy set");
+        check(meshcore_set_admission_policy(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null policy rejected");
+
+        for (int i = 0; i < 10; ++i) {
+            meshcore_simulate_message(core, 9, "hi", 2);
+        }
+        wait_until([&] { return c_received >= 3; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        meshcore_admission_stats stats;
+        check(meshcore_get_admission_stats(core, &stats) == MESHCORE_OK, "stats read");
+        check(c_received == 3 && stats.admitted == 3 && stats.rate_limited == 7, "policed through the C API");
+        check(stats.quarantines == 0, "quarantine disabled by a zero score");
+        check(meshcore_get_admission_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+
+        meshcore_destroy(core);
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+/**
+ * Archive Test
+ *
+ * Tests the LZ codec, streaming export/import, corruption detection,
+ * cancellation and the C API.
+ */
+
+#include "archive.h"
+#include "lz_codec.h"
+#include "meshcore.h"
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool lz_round_trip(const std::string& in) {
+    std::vector<uint8_t> packed(lz_compress_bound(in.size()));
+    size_t n = lz_compress(reinterpret_cast<const uint8_t*>(in.data()), in.size(),
+                           packed.data(), packed.size());
+    std::string out(in.size(), '\0');
+    return n > 0 && lz_decompress(packed.data(), n, reinterpret_cast<uint8_t*>(&out[0]), out.size()) &&
+           out == in;
+}
+
+static std::string chat_text(std::mt19937& rng) {
+    static const char* words[] = { "hey", "are", "you", "coming", "tonight", "the", "mesh",
+                                   "is", "working", "great", "see", "you", "soon", "ok", "lol" };
+    std::string s;
+    int n = 3 + rng() % 12;
+    for (int i = 0; i < n; ++i) {
+        s += words[rng() % 15];
+        s += ' ';
+    }
+    return s;
+}
+
+static bool cancel_after_first(void*, uint64_t, uint64_t, uint64_t) {
+    return false;
+}
+
+static uint64_t progress_calls = 0;
+
+static bool count_progress(void*, uint64_t, uint64_t, uint64_t) {
+    progress_calls++;
+    return true;
+}
+
+int main() {
+    std::cout << "=== Archive Test ===\n\n";
+
+    const std::filesystem::path root =
+        std::filesystem::temp_directory_path() / "meshcore_archive_test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+
+    std::cout << "[1] LZ codec...\n";
+    std::mt19937 rng(7);
+    bool small_ok = true;
+    for (size_t n = 0; n < 40; ++n) {
+        small_ok = small_ok && lz_round_trip(std::string(n, 'a')) &&
+                   lz_round_trip(std::string("abcdefghijklmnopqrstuvwxyz0123456789abcdef").substr(0, n));
+    }
+    check(small_ok, "tiny inputs round trip");
+
+    std::string random(100000, '\0');
+    for (auto& c : random) {
+        c = static_cast<char>(rng());
+    }
+    check(lz_round_trip(random), "random data round trips");
+
+    std::string text;
+    while (text.size() < 200000) {
+        text += chat_text(rng);
+    }
+    check(lz_round_trip(text), "text round trips");
+
+    std::vector<uint8_t> packed(lz_compress_bound(text.size()));
+    size_t n = lz_compress(reinterpret_cast<const uint8_t*>(text.data()), text.size(), packed.data(), packed.size());
+    check(n > 0 && n < text.size() * 2 / 3, "text compresses");
+    packed[n / 2] ^= 0x55;
+    std::string out(text.size(), '\0');
+    bool decoded = lz_decompress(packed.data(), n, reinterpret_cast<uint8_t*>(&out[0]), out.size());
+    check(!decoded || out != text, "corrupt stream never decodes to the original");
+    check(!lz_decompress(packed.data(), n / 2, reinterpret_cast<uint8_t*>(&out[0]), out.size()),
+          "truncated stream fails");
+
+    std::cout << "\n[2] Export/import...\n";
+    const int kMessages = 60000;
+    MessageStore src;
+    check(src.open((root / "src").string()), "source store opens");
+    for (int i = 0; i < kMessages; ++i) {
+        std::string conv = "peer" + std::to_string(i % 10);
+        src.append(conv, i % 3 ? MessageDirection::Inbound : MessageDirection::Outbound, 1000 + i, chat_text(rng));
+    }
+    src.remove_conversation("peer9");
+
+    const std::string archive = (root / "history.mca").string();
+    ArchiveStats es{0, 0, 0};
+    auto t0 = std::chrono::steady_clock::now();
+    check(export_archive(src, archive, true, nullptr, &es) == ArchiveResult::Ok, "export succeeds");
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    check(es.messages == kMessages - kMessages / 10, "deleted conversation not exported");
+    std::cout << "    " << es.messages << " messages, " << es.raw_bytes << " -> " << es.file_bytes
+              << " bytes in " << ms << " ms (" << es.raw_bytes / 1000.0 / ms << " MB/s)\n";
+    check(es.file_bytes < es.raw_bytes / 2, "archive compressed");
+
+    ArchiveStats plain{0, 0, 0};
+    check(export_archive(src, (root / "plain.mca").string(), false, nullptr, &plain) == ArchiveResult::Ok &&
+          plain.file_bytes > plain.raw_bytes, "uncompressed export");
+
+    MessageStore dst;
+    check(dst.open((root / "dst").string()), "destination store opens");
+    ArchiveStats is{0, 0, 0};
+    t0 = std::chrono::steady_clock::now();
+    check(import_archive(dst, archive, nullptr, nullptr, &is) == ArchiveResult::Ok, "import succeeds");
+    ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "    imported " << is.messages << " messages in " << ms << " ms\n";
+    check(is.messages == es.messages && is.raw_bytes == es.raw_bytes, "all messages imported");
+
+    std::vector<StoredMessage> a, b;
+    src.load_conversation("peer3", a);
+    dst.load_conversation("peer3", b);
+    bool same = a.size() == b.size();
+    for (size_t i = 0; same && i < a.size(); ++i) {
+        same = a[i].body == b[i].body && a[i].timestamp == b[i].timestamp && a[i].direction == b[i].direction;
+    }
+    check(same, "conversation identical after import");
+    check(dst.message_count("peer9") == 0, "deleted conversation absent");
+
+    dst.close();
+    check(dst.open((root / "dst").string()) && dst.message_count("peer3") == a.size(), "imported data is durable");
+
+    std::cout << "\n[3] Damage and cancellation...\n";
+    std::string bytes;
+    {
+        std::ifstream in(archive, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::string damaged = bytes;
+    damaged[damaged.size() / 2] ^= 0x01;
+    std::ofstream((root / "damaged.mca").string(), std::ios::binary) << damaged;
+    std::ofstream((root / "truncated.mca").string(), std::ios::binary) << bytes.substr(0, bytes.size() - 4);
+
+    MessageStore scratch;
+    scratch.open((root / "scratch").string());
+    check(import_archive(scratch, (root / "damaged.mca").string(), nullptr, nullptr, nullptr) ==
+          ArchiveResult::Corrupt, "flipped bit detected");
+    check(import_archive(scratch, (root / "truncated.mca").string(), nullptr, nullptr, nullptr) ==
+          ArchiveResult::Corrupt, "truncation detected");
+
+    const std::string cancelled = (root / "cancelled.mca").string();
+    check(export_archive(src, cancelled, true, [](uint64_t, uint64_t, uint64_t) { return false; }, nullptr) ==
+          ArchiveResult::Cancelled, "export cancelled");
+    check(!std::filesystem::exists(cancelled) && !std::filesystem::exists(cancelled + ".tmp"),
+          "cancelled export leaves no file");
+
+    std::cout << "\n[4] C API...\n";
+    meshcore* core = meshcore_create();
+    meshcore_open_store(core, (root / "core").string().c_str());
+    uint64_t imported = 0;
+    check(meshcore_import_archive(core, archive.c_str(), count_progress, nullptr, &imported) == MESHCORE_OK &&
+          imported == es.messages, "import via C API");
+    check(progress_calls > 1, "progress reported");
+    check(meshcore_export_archive(core, (root / "again.mca").string().c_str(), true,
+                                  cancel_after_first, nullptr) == MESHCORE_ERROR_CANCELLED, "cancel via C API");
+    check(meshcore_import_archive(core, (root / "damaged.mca").string().c_str(), nullptr, nullptr, nullptr) ==
+          MESHCORE_ERROR_CORRUPT, "corruption reported");
+    meshcore_destroy(core);
+
+    std::filesystem::remove_all(root);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+/**
+ * Chunk Store Test
+ *
+ * Tests BLAKE2s, content-defined chunking, deduplication, reference
+ * counting and missing-chunk attachment transfer.
+ */
+
+#include "chunk_store.h"
+#include "attachment_transfer.h"
+#include "meshcore.h"
+#include <iostream>
+#include <filesystem>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <random>
+#include <string>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static std::string random_bytes(size_t len, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::string out(len, '\0');
+    for (auto& c : out) {
+        c = static_cast<char>(rng() & 0xFF);
+    }
+    return out;
+}
+
+// Two peers wired back to back; counts chunk bytes crossing the "link"
+struct Link {
+    AttachmentTransfer* a = nullptr;
+    AttachmentTransfer* b = nullptr;
+    size_t chunk_bytes = 0;
+    int completed = 0;
+
+    void deliver(AttachmentTransfer* to, uint64_t from, const std::string& frame) {
+        FrameHeader header = frame_header(frame);
+        if (header.type == FrameType::ChunkData) {
+            chunk_bytes += frame.size() - kFrameHeaderBytes - 32;
+        }
+        to->on_frame(from, header, frame.data() + kFrameHeaderBytes, frame.size() - kFrameHeaderBytes);
+    }
+};
+
+static std::atomic<int> c_completed(0);
+static std::atomic<uint64_t> c_size(0);
+
+static void on_attachment(void*, uint64_t, const uint8_t*, uint64_t size) {
+    c_size = size;
+    c_completed++;
+}
+
+int main() {
+    std::cout << "=== Chunk Store Test ===\n\n";
+
+    const std::filesystem::path root =
+        std::filesystem::temp_directory_path() / "meshcore_chunk_store_test";
+    std::filesystem::remove_all(root);
+
+    std::cout << "[1] BLAKE2s...\n";
+    check(ChunkStore::to_hex(Blake2s::hash("abc", 3)) ==
+          "508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982",
+          "RFC 7693 test vector");
+    check(ChunkStore::to_hex(Blake2s::hash("", 0)) ==
+          "69217a3079908094e11121d042354a7c1f55b6482ca1a51e1b250dfd1ed0eef9",
+          "empty input");
+
+    std::cout << "\n[2] Chunking...\n";
+    const std::string base = random_bytes(256 * 1024, 1);
+    auto ends = chunk_boundaries(reinterpret_cast<const uint8_t*>(base.data()), base.size());
+    bool sizes_ok = !ends.empty() && ends.back() == base.size();
+    for (size_t i = 0, start = 0; i < ends.size(); start = ends[i++]) {
+        size_t n = ends[i] - start;
+        sizes_ok = sizes_ok && n <= ChunkStore::kMaxChunk &&
+                   (n >= ChunkStore::kMinChunk || i + 1 == ends.size());
+    }
+    check(sizes_ok, "chunk sizes within bounds");
+    std::cout << "    " << ends.size() << " chunks, avg " << base.size() / ends.size() << " bytes\n";
+
+    // An insertion near the front only disturbs the chunks around it
+    std::string edited = base;
+    edited.insert(100, "inserted");
+    auto ends2 = chunk_boundaries(reinterpret_cast<const uint8_t*>(edited.data()), edited.size());
+    size_t shared = 0;
+    for (size_t e : ends) {
+        for (size_t e2 : ends2) {
+            shared += (e2 == e + 8);
+        }
+    }
+    check(shared + 3 >= ends.size(), "boundaries resynchronize after an insert");
+
+    std::cout << "\n[3] Deduplication...\n";
+    ChunkStore a;
+    check(a.open((root / "a").string()), "store opens");
+
+    Manifest m1, m2, m3;
+    check(a.put_attachment(base.data(), base.size(), m1), "attachment stored");
+    ChunkStoreStats s1 = a.stats();
+    check(a.put_attachment(base.data(), base.size(), m2) && m1.id == m2.id, "same content, same id");
+    check(a.stats().stored_bytes == s1.stored_bytes, "duplicate costs no storage");
+
+    check(a.put_attachment(edited.data(), edited.size(), m3) && m3.id != m1.id, "edited copy stored");
+    ChunkStoreStats s3 = a.stats();
+    check(s3.stored_bytes < s1.stored_bytes + edited.size() / 4, "edited copy shares chunks");
+    std::cout << "    logical " << s3.logical_bytes << " bytes, stored " << s3.stored_bytes << " bytes\n";
+
+    std::string back;
+    check(a.read_attachment(m3.id, back) && back == edited, "attachment reads back");
+
+    std::cout << "\n[4] Reopen and release...\n";
+    a.close();
+    check(a.open((root / "a").string()) && a.stats().attachments == 2, "manifests survive reopen");
+    check(a.stats().stored_bytes == s3.stored_bytes, "reference counts rebuilt");
+    check(a.release_attachment(m1.id), "release succeeds");
+    check(a.read_attachment(m3.id, back) && back == edited, "shared chunks kept");
+    check(a.stats().stored_bytes < s3.stored_bytes, "unshared chunks deleted");
+
+    Manifest bad = m3;
+    bad.total_size++;
+    std::string enc = ChunkStore::encode_manifest(bad);
+    check(!ChunkStore::decode_manifest(enc.data(), enc.size(), bad), "inconsistent manifest rejected");
+
+    std::cout << "\n[5] Transfer sends only missing chunks...\n";
+    ChunkStore b;
+    check(b.open((root / "b").string()), "peer store opens");
+
+    Link link;
+    AttachmentTransfer ta(a, [&](uint64_t, const std::string& f) { link.deliver(link.b, 1, f); }, nullptr);
+    AttachmentTransfer tb(b, [&](uint64_t, const std::string& f) { link.deliver(link.a, 2, f); },
+                          [&](uint64_t, const ChunkHash&, uint64_t) { link.completed++; });
+    link.a = &ta;
+    link.b = &tb;
+
+    // Peer already has the original; sending the edit moves only its delta
+    check(b.put_attachment(base.data(), base.size(), m1), "peer holds original");
+    check(ta.offer(2, m3.id), "offer sent");
+    check(link.completed == 1 && tb.pending_count() == 0, "transfer completed");
+    check(link.chunk_bytes < edited.size() / 4, "only changed chunks crossed the link");
+    std::cout << "    " << link.chunk_bytes << " of " << edited.size() << " bytes sent\n";
+    check(b.read_attachment(m3.id, back) && back == edited, "peer reads the attachment");
+
+    size_t before = link.chunk_bytes;
+    check(ta.offer(2, m3.id) && link.completed == 2 && link.chunk_bytes == before,
+          "re-offer moves no data");
+
+    ChunkHash bogus = Blake2s::hash("x", 1);
+    std::string data(reinterpret_cast<const char*>(bogus.data()), 32);
+    data += "x";
+    check(!tb.on_frame(1, FrameHeader{ FrameType::ChunkData, 0, 0 }, data.data(), data.size()),
+          "unsolicited chunk rejected");
+
+    std::cout << "\n[6] C API...\n";
+    meshcore* core = meshcore_create();
+    check(meshcore_open_chunk_store(core, (root / "c").string().c_str()) == MESHCORE_OK, "chunk store opens");
+    meshcore_set_attachment_callback(core, on_attachment, nullptr);
+
+    uint8_t id[MESHCORE_ATTACHMENT_ID_SIZE];
+    check(meshcore_attachment_put(core, base.data(), base.size(), id) == MESHCORE_OK, "put");
+    check(meshcore_attachment_send(core, 5, id) == MESHCORE_OK, "send over loopback");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    check(c_completed == 1 && c_size == base.size(), "completion callback");
+
+    uint64_t size = 0;
+    check(meshcore_attachment_read(core, id, nullptr, 0, &size) == MESHCORE_OK && size == base.size(),
+          "size query");
+    std::string buf(size, '\0');
+    check(meshcore_attachment_read(core, id, &buf[0], buf.size(), &size) == MESHCORE_OK && buf == base,
+          "read back");
+    check(meshcore_attachment_release(core, id) == MESHCORE_OK, "release");
+    check(meshcore_attachment_release(core, id) == MESHCORE_ERROR_PEER_NOT_FOUND, "double release");
+
+    meshcore_destroy(core);
+    std::filesystem::remove_all(root);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
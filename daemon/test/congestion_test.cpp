@@ -0,0 +1,392 @@
+/**
+ * Congestion Test
+ *
+ * Tests the queue-depth hint, shedding at capacity, AIMD pacing driven
+ * by a neighbour's hints, the bounded hold queue, Congestion frames to
+ * neighbours, then an overloaded daemon fed by a faster one with and
+ * without backpressure, and the C API.
+ */
+
+#include "congestion.h"
+#include "daemon.h"
+#include "ed25519.h"
+#include "frame.h"
+#include "meshcore.h"
+#include "transport.h"
+#include <iostream>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static bool near(int value, int expected) {
+    return value >= expected - 2 && value <= expected + 1;
+}
+
+// Frames allowed out by pace() over [from, to), one attempt per ms
+static int paced_over(CongestionControl& control, uint64_t peer_id, int64_t from, int64_t to) {
+    int sent = 0;
+    for (int64_t t = from; t < to; ++t) {
+        sent += control.pace(peer_id, t) ? 1 : 0;
+    }
+    return sent;
+}
+
+/**
+ * Delivers everything sent to the other daemon through its ingest entry
+ * point, as coming from `as_peer`
+ */
+class PairTransport : public Transport {
+public:
+    explicit PairTransport(uint64_t as_peer) : remote_(nullptr), as_peer_(as_peer) {}
+
+    void connect_to(Daemon* remote) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        remote_ = remote;
+    }
+
+    void send(uint64_t, const std::string& data) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (remote_) {
+            remote_->submit_inbound(as_peer_, data.data(), data.size());
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    Daemon* remote_;
+    uint64_t as_peer_;
+};
+
+struct RelayRun {
+    int      delivered;
+    uint64_t shed;
+    uint64_t refused;
+    uint64_t peak_depth;
+    uint64_t signals;
+    uint64_t decreases;
+    uint64_t held;
+    uint64_t dropped;
+    double   seconds;
+};
+
+// Time one message takes the relay: at least 1 ms, and well over what
+// signing costs the sender in this build, so a slow (debug, sanitizer)
+// build still overloads the relay instead of the sender
+static std::chrono::microseconds relay_cost() {
+    static const std::chrono::microseconds cost = [] {
+        uint8_t seed[32] = {7};
+        uint8_t public_key[32];
+        uint8_t signature[64];
+        ed25519_public_key(seed, public_key);
+        const std::string message = "relay me 1000";
+        const int kSigns = 50;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kSigns; ++i) {
+            ed25519_sign(seed, public_key, reinterpret_cast<const uint8_t*>(message.data()), message.size(), signature);
+        }
+        const auto sign = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start) / kSigns;
+        return std::max(std::chrono::microseconds(1000), 4 * sign);
+    }();
+    return cost;
+}
+
+// `sender` offers 3x what `relay` can take (relay_cost() per message) for a while
+static RelayRun overload(bool backpressure) {
+    static constexpr int kMessages = 1500;
+
+    // Daemon log lines are not part of the test output
+    std::ostringstream sink;
+    std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+
+    Daemon sender;
+    Daemon relay;
+    PairTransport to_relay(1);     // relay sees the sender as peer 1
+    PairTransport to_sender(2);    // and the sender sees it as peer 2
+    sender.set_transport(&to_relay);
+    relay.set_transport(&to_sender);
+    to_relay.connect_to(&relay);
+    to_sender.connect_to(&sender);
+
+    AdmissionConfig unlimited;
+    unlimited.frames_per_sec = 0;
+    unlimited.bytes_per_sec = 0;
+    relay.set_admission_config(unlimited);
+    sender.set_admission_config(unlimited);
+
+    CongestionConfig relay_config;
+    relay_config.queue_capacity = 64;
+    relay.set_congestion_config(relay_config);
+
+    CongestionConfig sender_config;
+    sender_config.max_pending = 4096;
+    sender_config.max_rate = backpressure ? 2000 : 0;
+    sender.set_congestion_config(sender_config);
+
+    std::atomic<int> delivered(0);
+    DaemonCallbacks callbacks;
+    callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) {
+        delivered++;
+    };
+    relay.set_callbacks(callbacks);
+    const std::chrono::microseconds cost = relay_cost();
+    relay.add_stage(Daemon::Direction::Inbound, make_stage<Daemon::Event>("link", [cost](Daemon::Event&) {
+        std::this_thread::sleep_for(cost);
+        return true;
+    }), "ui");
+
+    relay.start();
+    sender.start();
+
+    // Signed, so every message carries a header and a hint; the relay
+    // binds the sender's key to its UID
+    Daemon::Event connect;
+    connect.type = Daemon::EventType::PeerConnected;
+    connect.peer_id = 1;
+    connect.peer_uid = "sender@mesh";
+    relay.enqueue_event(std::move(connect));
+    uint8_t seed[32] = {7};
+    sender.set_signing_key(SigningKey::from_seed(seed));
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kMessages; ++i) {
+        Daemon::Event event;
+        event.type = Daemon::EventType::SendMessage;
+        event.peer_id = 2;
+        event.data = "relay me " + std::to_string(i);
+        sender.enqueue_event(std::move(event));
+        if (i % 3 == 2) {
+            std::this_thread::sleep_for(cost);
+        }
+    }
+
+    // Every message ends delivered, shed by the relay, refused by its
+    // ingress or dropped by the sender; wait for all of them however
+    // slow the build
+    const auto accounted = [&] {
+        const IngressStats ingress = relay.ingress_stats();
+        return delivered + relay.congestion_stats().shed + ingress.overflow + ingress.dropped +
+               sender.congestion_stats().dropped;
+    };
+    wait_until([&] { return accounted() >= uint64_t(kMessages); }, 300000);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const uint64_t refused = relay.ingress_stats().overflow + relay.ingress_stats().dropped;
+    const CongestionStats relay_stats = relay.congestion_stats();
+    const CongestionStats sender_stats = sender.congestion_stats();
+    sender.stop();
+    relay.stop();
+    std::cout.rdbuf(saved);
+
+    return RelayRun{delivered.load(), relay_stats.shed, refused, relay_stats.peak_depth, relay_stats.signals,
+                    sender_stats.decreases, sender_stats.held, sender_stats.dropped, seconds};
+}
+
+int main() {
+    std::cout << "=== Congestion Test ===\n\n";
+
+    std::cout << "[1] Queue depth hint and shedding...\n";
+    {
+        CongestionConfig config;
+        config.queue_capacity = 100;
+        CongestionControl control(config);
+
+        check(control.local_hint() == 1, "idle queue hints 1");
+        control.set_depth(50);
+        check(control.local_hint() == 128, "half full hints 128");
+        control.set_depth(100);
+        check(control.local_hint() == 255, "full queue hints 255");
+        check(!control.on_inbound(1, 0, 0), "shed at capacity");
+        control.set_depth(99);
+        check(control.on_inbound(1, 0, 0), "accepted below capacity");
+        control.set_depth(100);
+        check(control.on_inbound(1, 0, 0, false), "control frames never shed");
+        const std::string signal = make_frame(FrameType::Congestion, std::string());
+        const std::string chunk = make_frame(FrameType::ChunkData, "bytes");
+        check(is_control_frame(signal.data(), signal.size()) && !is_control_frame(chunk.data(), chunk.size()) &&
+              !is_control_frame("hello", 5), "Congestion frames are control, chat and chunks data");
+        control.set_depth(3);
+        const CongestionStats stats = control.stats();
+        check(stats.shed == 1 && stats.peak_depth == 100, "shed and peak depth counted");
+
+        config.queue_capacity = 0;
+        control.set_config(config);
+        control.set_depth(100000);
+        check(control.local_hint() == 0 && control.on_inbound(1, 0, 0), "zero capacity turns the local side off");
+    }
+
+    std::cout << "\n[2] AIMD pacing...\n";
+    {
+        CongestionConfig config;
+        config.max_rate = 2000;
+        config.min_rate = 10;
+        config.increase_per_sec = 1000;
+        config.decrease_percent = 50;
+        config.decrease_interval_ms = 100;
+        config.hint_timeout_ms = 1000;
+        CongestionControl control(config);
+
+        // Unpaced: everything goes, at one frame per ms (1000/s)
+        check(paced_over(control, 1, 0, 300) == 300, "unpaced until told otherwise");
+
+        control.on_inbound(1, 200, 300);
+        check(control.stats().paced_peers == 1, "a high hint starts pacing");
+        check(near(paced_over(control, 1, 300, 400), 50), "... at half the measured rate");
+
+        control.on_inbound(1, 200, 400);
+        paced_over(control, 1, 400, 450);
+        control.on_inbound(1, 200, 450);
+        check(control.stats().decreases == 2, "at most one cut per interval");
+        check(near(paced_over(control, 1, 450, 650), 50), "cut again");
+
+        // Between the marks the rate holds; under the low mark it grows
+        control.on_inbound(1, 100, 650);
+        check(near(paced_over(control, 1, 650, 850), 50), "held between the marks");
+        control.on_inbound(1, 10, 850);
+        const int grown = paced_over(control, 1, 850, 1050);
+        check(near(grown, 70), "additive increase with headroom");
+        control.on_inbound(1, 10, 3000);
+        check(control.stats().paced_peers == 0, "pacing lifts at max_rate");
+
+        // A neighbour that goes quiet is assumed to have recovered
+        control.on_inbound(2, 255, 0);
+        paced_over(control, 2, 0, 500);
+        check(control.stats().paced_peers == 1, "paced after a hint");
+        paced_over(control, 2, 500, 4000);
+        check(control.stats().paced_peers == 0, "recovers when hints stop");
+
+        config.max_rate = 0;
+        control.set_config(config);
+        control.on_inbound(3, 255, 5000);
+        check(paced_over(control, 3, 5000, 5100) == 100, "zero max_rate never paces");
+    }
+
+    std::cout << "\n[3] Held frames...\n";
+    {
+        CongestionConfig config;
+        config.max_rate = 200;
+        config.max_pending = 4;
+        CongestionControl control(config);
+
+        control.on_inbound(1, 255, 0);    // Paced at 100/s: one frame per 10 ms
+        check(!control.pace(1, 0), "no tokens straight after the cut");
+        check(control.hold(1, "a", 0) == CongestionControl::Pacing::Wake, "first held frame wakes the releaser");
+        check(control.hold(1, "b", 0) == CongestionControl::Pacing::Held, "later ones queue");
+        control.hold(1, "c", 0);
+        control.hold(1, "d", 0);
+        check(control.hold(1, "e", 0) == CongestionControl::Pacing::Dropped, "bounded");
+
+        check(control.next_release_ms(0) == 10, "next release at the paced interval");
+        CongestionControl::Release out;
+        check(!control.release(5, out), "nothing released early");
+        control.release(10, out);
+        check(out.size() == 1, "one frame per interval");
+        check(!control.pace(1, 20), "never overtakes held frames");
+        control.release(60, out);
+        check(out.size() == 4 && out[0].second == "a" && out[3].second == "d", "released in order");
+        check(control.next_release_ms(60) == std::numeric_limits<int64_t>::max(), "nothing left");
+
+        control.hold(1, "f", 60);
+        control.forget(1);
+        const CongestionStats stats = control.stats();
+        check(stats.held == 5 && stats.dropped == 2, "held and dropped counted");
+        check(!control.release(1000, out), "forgotten neighbour's frames dropped");
+    }
+
+    std::cout << "\n[4] Congestion frames...\n";
+    {
+        CongestionConfig config;
+        config.queue_capacity = 100;
+        config.signal_interval_ms = 50;
+        CongestionControl control(config);
+
+        control.on_inbound(1, 0, 0);      // Sending to us
+        control.on_inbound(2, 0, 0);
+        control.pace(3, 0);               // Only ever sent to
+
+        check(control.take_signals(0).empty(), "nothing while the queue is short");
+        control.set_depth(60);
+        const std::vector<uint64_t> first = control.take_signals(10);
+        check(first.size() == 2, "congested: every neighbour sending to us");
+        check(control.take_signals(30).empty(), "rate limited per neighbour");
+        check(control.take_signals(60).size() == 2, "repeated each interval");
+        control.set_depth(40);
+        check(control.take_signals(200).empty(), "nothing between the marks");
+        control.set_depth(10);
+        check(control.take_signals(210).size() == 2, "one clear signal once drained");
+        check(control.take_signals(300).empty(), "... only once");
+        check(control.stats().signals == 6, "signals counted");
+    }
+
+    std::cout << "\n[5] Overloaded relay...\n";
+    {
+        const RelayRun plain = overload(false);
+        const RelayRun paced = overload(true);
+        std::cout << "      without: delivered " << plain.delivered << ", shed " << plain.shed
+                  << ", peak depth " << plain.peak_depth << "\n";
+        std::cout << "      with:    delivered " << paced.delivered << ", shed " << paced.shed
+                  << ", peak depth " << paced.peak_depth << ", cuts " << paced.decreases
+                  << ", held " << paced.held << ", " << paced.seconds << " s\n";
+
+        check(plain.delivered + plain.shed + plain.refused + plain.dropped == 1500 &&
+              paced.delivered + paced.shed + paced.refused + paced.dropped == 1500, "every message accounted for");
+        check(paced.signals > 0 && paced.decreases > 0 && paced.held > 0, "relay signalled, sender backed off");
+        check(paced.peak_depth <= 2 * 64 && plain.peak_depth <= 2 * 64, "relay queue bounded");
+        check(paced.shed * 4 < plain.shed, "backpressure instead of shedding");
+        check(paced.delivered >= 1350, "nearly everything delivered");
+    }
+
+    std::cout << "\n[6] C API...\n";
+    {
+        meshcore* core = meshcore_create();
+
+        meshcore_congestion_policy policy = {};
+        policy.queue_capacity = 32;
+        policy.high_water = 100;
+        policy.low_water = 50;
+        policy.max_rate = 500;
+        policy.min_rate = 5;
+        policy.max_pending = 16;
+        check(meshcore_set_congestion_policy(core, &policy) == MESHCORE_OK, "policy set");
+        policy.low_water = 200;
+        check(meshcore_set_congestion_policy(core, &policy) == MESHCORE_ERROR_INVALID_PARAM, "inverted marks rejected");
+        check(meshcore_set_congestion_policy(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null policy rejected");
+
+        meshcore_congestion_stats stats;
+        check(meshcore_get_congestion_stats(core, &stats) == MESHCORE_OK, "stats read");
+        check(stats.local_hint == 1 && stats.shed == 0 && stats.paced_peers == 0, "idle core");
+        check(meshcore_get_congestion_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+
+        meshcore_destroy(core);
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,230 @@
+/**
+ * Contact Directory Test
+ *
+ * Tests perfect-hash construction, lookups, mapped files, atomic
+ * background rebuilds and inbound admission.
+ */
+
+#include "contact_directory.h"
+#include "meshcore.h"
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static std::vector<ContactRecord> make_records(size_t n, const std::string& prefix) {
+    std::vector<ContactRecord> records;
+    records.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        records.push_back(ContactRecord{ prefix + std::to_string(i) + "@mesh",
+                                         static_cast<uint32_t>(i % 3 == 0 ? kContactFlagMember : kContactFlagContact),
+                                         "User " + std::to_string(i) });
+    }
+    return records;
+}
+
+static std::atomic<int> messages(0);
+
+static void on_message(void*, uint64_t, const char*, const char*, size_t, int64_t) {
+    messages++;
+}
+
+int main() {
+    std::cout << "=== Contact Directory Test ===\n\n";
+
+    const std::filesystem::path root =
+        std::filesystem::temp_directory_path() / "meshcore_contact_directory_test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+
+    std::cout << "[1] Build and lookup...\n";
+    const size_t kCount = 200000;
+    auto records = make_records(kCount, "u");
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto table = ContactTable::build(records);
+    double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    check(table && table->size() == kCount, "table built");
+    std::cout << "    " << kCount << " UIDs in " << build_ms << " ms\n";
+
+    bool all_found = true;
+    ContactRecord rec;
+    for (size_t i = 0; i < kCount && all_found; i += 7) {
+        all_found = table->lookup(records[i].uid, rec) && rec.flags == records[i].flags &&
+                    rec.label == records[i].label;
+    }
+    check(all_found, "every UID maps to its record");
+
+    bool none_found = true;
+    for (size_t i = 0; i < 10000 && none_found; ++i) {
+        std::string uid = "x" + std::to_string(i) + "@mesh";
+        none_found = !table->find(uid.data(), uid.size(), nullptr);
+    }
+    check(none_found, "unknown UIDs are rejected");
+
+    t0 = std::chrono::steady_clock::now();
+    size_t hits = 0;
+    for (int round = 0; round < 5; ++round) {
+        for (size_t i = 0; i < kCount; ++i) {
+            hits += table->find(records[i].uid.data(), records[i].uid.size(), nullptr);
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / (5.0 * kCount);
+    check(hits == 5 * kCount, "lookup loop");
+    std::cout << "    " << ns << " ns per lookup\n";
+
+    std::vector<ContactRecord> dups = { { "a", kContactFlagContact, "old" }, { "a", kContactFlagBlocked, "new" } };
+    auto dup_table = ContactTable::build(dups);
+    check(dup_table && dup_table->size() == 1 && dup_table->lookup("a", rec) && rec.label == "new",
+          "duplicate UID keeps the last record");
+
+    const std::string key(kContactKeyBytes, '\x5A');
+    std::vector<ContactRecord> signers = { { "s", kContactFlagContact, "Signer", key }, { "t", kContactFlagContact, "" } };
+    auto signer_table = ContactTable::build(signers);
+    ContactKey listed{};
+    check(signer_table && signer_table->signing_key("s", listed) && listed[0] == 0x5A && listed[31] == 0x5A &&
+          !signer_table->signing_key("t", listed), "signing keys kept per record");
+    check(signer_table->lookup("s", rec) && rec.signing_key == key && rec.flags == kContactFlagContact &&
+          signer_table->lookup("t", rec) && rec.signing_key.empty() && rec.label.empty(), "lookup returns the key");
+    signers[1].signing_key = "short";
+    check(!ContactTable::build(signers), "malformed signing key rejected");
+
+    auto empty = ContactTable::build({});
+    check(empty && empty->size() == 0 && !empty->find("a", 1, nullptr), "empty table");
+
+    std::cout << "\n[2] Mapped files...\n";
+    const std::string path = (root / "contacts.mcd").string();
+    check(table->write_file(path), "written");
+    auto mapped = ContactTable::map_file(path);
+    check(mapped && mapped->size() == kCount && mapped->lookup(records[12345].uid, rec) &&
+          rec.label == records[12345].label, "mapped table answers lookups");
+
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    bytes[bytes.size() / 2] ^= 0x20;
+    std::ofstream((root / "bad.mcd").string(), std::ios::binary) << bytes;
+    check(!ContactTable::map_file((root / "bad.mcd").string()), "damaged file rejected");
+
+    std::cout << "\n[3] Background rebuild swaps atomically...\n";
+    ContactDirectory directory;
+    check(directory.load(path) && directory.size() == kCount, "directory loaded");
+
+    // Every table contains "stable@mesh"; a reader must never miss it
+    auto next = make_records(50000, "v");
+    next.push_back(ContactRecord{ "stable@mesh", kContactFlagContact, "" });
+    records.push_back(ContactRecord{ "stable@mesh", kContactFlagContact, "" });
+    check(directory.load(path), "reload");
+    directory.rebuild(records, "", nullptr);
+    directory.wait_idle();
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> misses(0), reads(0);
+    std::thread reader([&] {
+        while (!stop) {
+            ContactRecord r;
+            misses += directory.lookup("stable@mesh", r) ? 0 : 1;
+            reads++;
+        }
+    });
+
+    for (int i = 0; i < 4; ++i) {
+        directory.rebuild(i % 2 ? records : next, (root / "swap.mcd").string(), nullptr);
+    }
+    directory.wait_idle();
+    stop = true;
+    reader.join();
+    check(misses == 0, "no lookup observed a half-built table");
+    check(directory.size() == records.size(), "last rebuild wins");
+    std::cout << "    " << reads << " lookups during rebuilds\n";
+
+    // A rebuild never waits for the running one; a queued list is superseded
+    std::atomic<bool> building(false), release(false);
+    std::atomic<int> first(-1), second(-1), third(-1);
+    directory.rebuild(next, "", [&](bool ok) {
+        building = true;
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        first = ok;
+    });
+    while (!building) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto next_copy = next;
+    auto records_copy = records;
+    const auto queued_at = std::chrono::steady_clock::now();
+    directory.rebuild(std::move(next_copy), "", [&](bool ok) { second = ok; });
+    directory.rebuild(std::move(records_copy), "", [&](bool ok) { third = ok; });
+    check(std::chrono::steady_clock::now() - queued_at < std::chrono::milliseconds(100), "rebuild returns while building");
+    release = true;
+    directory.wait_idle();
+    check(first == 1 && second == 0 && third == 1, "queued list superseded by the newest");
+    check(directory.size() == records.size(), "newest list swapped in");
+
+    check(!ContactTable::build({ { std::string(0x10000, 'u'), kContactFlagContact, "" } }), "over-long UID rejected");
+
+    std::cout << "\n[4] Admission...\n";
+    directory.rebuild({ { "friend", kContactFlagContact, "" }, { "spam", kContactFlagBlocked, "" } }, "", nullptr);
+    directory.wait_idle();
+    check(directory.admits("friend") && !directory.admits("spam") && directory.admits("stranger"),
+          "blocklist mode");
+    directory.set_allowlist(true);
+    check(directory.admits("friend") && !directory.admits("stranger"), "allowlist mode");
+
+    meshcore* core = meshcore_create();
+    meshcore_callbacks callbacks = {};
+    callbacks.on_message = on_message;
+    meshcore_set_callbacks(core, &callbacks);
+
+    meshcore_contact contacts[] = {
+        { "friend", MESHCORE_CONTACT_CONTACT, "Friend" },
+        { "spam", MESHCORE_CONTACT_BLOCKED, nullptr }
+    };
+    check(meshcore_rebuild_contacts(core, contacts, 2, (root / "core.mcd").string().c_str(), false) == MESHCORE_OK,
+          "rebuild via C API");
+    uint32_t flags = 0;
+    for (int i = 0; i < 100 && meshcore_lookup_contact(core, "spam", &flags) != MESHCORE_OK; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    check(flags == MESHCORE_CONTACT_BLOCKED, "lookup via C API");
+    check(meshcore_lookup_contact(core, "nobody", nullptr) == MESHCORE_ERROR_PEER_NOT_FOUND, "unknown UID");
+
+    meshcore_simulate_peer_connect(core, 1, "friend");
+    meshcore_simulate_peer_connect(core, 2, "spam");
+    meshcore_simulate_message(core, 1, "hello", 5);
+    meshcore_simulate_message(core, 2, "buy now", 7);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    check(messages == 1, "blocked sender dropped");
+
+    check(meshcore_load_contacts(core, (root / "core.mcd").string().c_str(), true) == MESHCORE_OK,
+          "load written directory in allowlist mode");
+    meshcore_simulate_peer_connect(core, 3, "stranger");
+    meshcore_simulate_message(core, 3, "hi", 2);
+    meshcore_simulate_message(core, 1, "again", 5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    check(messages == 2, "unlisted sender dropped in allowlist mode");
+
+    meshcore_destroy(core);
+    std::filesystem::remove_all(root);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
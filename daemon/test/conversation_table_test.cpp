@@ -0,0 +1,116 @@
+/**
+ * Conversation Table Test
+ *
+ * Tests incremental summaries, unread counters and change notifications.
+ */
+
+#include "conversation_table.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <string>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static std::atomic<int> change_batches(0);
+static std::atomic<int> changed_total(0);
+static std::atomic<uint32_t> bob_unread(0);
+
+static void on_changes(void*, const meshcore_conversation* convs, size_t count) {
+    change_batches++;
+    changed_total += static_cast<int>(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (std::string(convs[i].uid) == "bob@mesh") {
+            bob_unread = convs[i].unread_count;
+        }
+    }
+}
+
+static void on_all(void* user_data, const meshcore_conversation* convs, size_t count) {
+    *static_cast<size_t*>(user_data) = count;
+    for (size_t i = 0; i < count; ++i) {
+        std::cout << "    " << convs[i].uid << ": \""
+                  << std::string(convs[i].last_message, convs[i].last_message_len)
+                  << "\" unread=" << convs[i].unread_count << "\n";
+    }
+}
+
+int main() {
+    std::cout << "=== Conversation Table Test ===\n\n";
+
+    std::cout << "[1] Table updates...\n";
+    ConversationTable table;
+    table.on_message("alice", false, 100, "hi");
+    table.on_message("alice", false, 200, "how are you?");
+    table.on_message("alice", true, 300, "fine");
+    table.on_message("bob", false, 150, std::string(500, 'b'));
+    table.on_message("alice", false, 50, "late arrival");
+
+    auto changes = table.take_changes();
+    check(changes.size() == 2, "two conversations changed");
+    check(table.take_changes().empty(), "changes are consumed");
+
+    auto all = table.all();
+    for (const auto& s : all) {
+        if (s.conversation == "alice") {
+            check(s.last_message == "fine" && s.last_outbound, "newest message is the preview");
+            check(s.unread() == 3 && s.message_count == 4, "alice unread counts inbound only");
+        } else {
+            check(s.last_message.size() == ConversationTable::kPreviewBytes, "preview truncated");
+        }
+    }
+
+    table.mark_read("alice");
+    changes = table.take_changes();
+    check(changes.size() == 1 && changes[0].unread() == 0, "read receipt clears unread");
+
+    table.on_message("alice", false, 400, "new");
+    check(table.all().size() == 2, "summaries kept per conversation");
+    changes = table.take_changes();
+    check(changes.size() == 1 && changes[0].unread() == 1, "only new messages are unread");
+
+    table.remove("bob");
+    changes = table.take_changes();
+    check(changes.size() == 1 && changes[0].message_count == 0, "delete reported once");
+    check(table.all().size() == 1, "deleted conversation dropped");
+
+    std::cout << "\n[2] C API notifications...\n";
+    meshcore* core = meshcore_create();
+    meshcore_set_conversations_callback(core, on_changes, nullptr);
+    meshcore_simulate_peer_connect(core, 9, "bob@mesh");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    for (int i = 0; i < 20; ++i) {
+        std::string msg = "burst " + std::to_string(i);
+        meshcore_simulate_message(core, 9, msg.c_str(), msg.size());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    check(bob_unread == 20, "20 unread from bob");
+    check(change_batches > 0 && changed_total == change_batches,
+          "notifications carry only the changed conversation");
+
+    size_t count = 0;
+    check(meshcore_get_conversations(core, on_all, &count) == 1 && count == 1,
+          "bulk query returns one conversation");
+
+    meshcore_mark_read(core, "bob@mesh");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    check(bob_unread == 0, "mark read notified");
+
+    meshcore_destroy(core);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
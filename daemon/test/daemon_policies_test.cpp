@@ -0,0 +1,167 @@
+/**
+ * Daemon Policies Test
+ *
+ * Tests policy selection, the ring queue and spin lock, and a
+ * non-default BasicDaemon configuration instantiated in this file
+ * (ring queue, spin lock, manual clock, logging compiled out).
+ */
+
+#include "daemon.h"
+#include "basic_daemon_impl.h"
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using TestDaemon = BasicDaemon<NullLogger, ManualClock, SpinSync, RingQueue>;
+
+// Policy slots are resolved at compile time, in any order
+static_assert(std::is_same<Daemon::Queue, StdQueue>::value, "default queue");
+static_assert(std::is_same<Daemon::Sync, StdSync>::value, "default sync");
+static_assert(std::is_same<Daemon::Clock, SystemClock>::value, "default clock");
+static_assert(std::is_same<Daemon::Logger, AsyncLogger>::value, "default logger");
+static_assert(std::is_same<TestDaemon::Queue, RingQueue>::value, "queue selected");
+static_assert(std::is_same<TestDaemon::Sync, SpinSync>::value, "sync selected");
+static_assert(std::is_same<TestDaemon::Clock, ManualClock>::value, "clock selected");
+static_assert(!TestDaemon::Logger::enabled, "logger compiled out");
+static_assert(std::is_same<BasicDaemon<NullLogger>::Queue, StdQueue>::value, "unset slots keep defaults");
+static_assert(std::is_same<TestDaemon::Event, Daemon::Event>::value, "events shared across configurations");
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Daemon Policies Test ===\n\n";
+
+    std::cout << "[1] Ring queue...\n";
+    {
+        RingQueue::type<int> queue;
+        bool in_order = true;
+        int next_in = 0;
+        int next_out = 0;
+        // Interleave pushes and pops so the head wraps before each growth
+        for (int round = 0; round < 6; ++round) {
+            for (int i = 0; i < 10 + round * 10; ++i) {
+                queue.push(int(next_in++));
+            }
+            for (int i = 0; i < 7; ++i) {
+                in_order = in_order && queue.front() == next_out++;
+                queue.pop();
+            }
+        }
+        check(queue.size() == size_t(next_in - next_out), "size tracks pushes and pops");
+        while (!queue.empty()) {
+            in_order = in_order && queue.front() == next_out++;
+            queue.pop();
+        }
+        check(in_order && next_out == next_in, "FIFO across wraparound and growth");
+
+        RingQueue::type<std::string> strings;
+        strings.push(std::string(64, 'x'));
+        strings.pop();
+        check(strings.empty(), "popped slots released");
+    }
+
+    std::cout << "\n[2] Spin lock...\n";
+    {
+        SpinMutex mutex;
+        int counter = 0;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 10000; ++i) {
+                    std::lock_guard<SpinMutex> lock(mutex);
+                    counter++;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        check(counter == 40000, "mutual exclusion");
+        check(mutex.try_lock(), "try_lock on a free lock");
+        check(!mutex.try_lock(), "try_lock on a held lock");
+        mutex.unlock();
+    }
+
+    std::cout << "\n[3] Custom configuration...\n";
+    {
+        ManualClock::set_ms(1700000000000);
+
+        // Nothing from the daemon may reach stdout with NullLogger
+        std::ostringstream captured;
+        std::streambuf* saved = std::cout.rdbuf(captured.rdbuf());
+
+        TestDaemon daemon;
+        std::mutex mutex;
+        std::vector<int64_t> timestamps;
+        std::vector<std::string> messages;
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string& message, int64_t timestamp) {
+            std::lock_guard<std::mutex> lock(mutex);
+            timestamps.push_back(timestamp);
+            messages.push_back(message);
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        TestDaemon::Event connect;
+        connect.type = TestDaemon::EventType::PeerConnected;
+        connect.peer_id = 9;
+        connect.peer_uid = "policy-peer";
+        daemon.enqueue_event(std::move(connect));
+
+        for (int i = 0; i < 100; ++i) {
+            TestDaemon::Event event;
+            event.type = TestDaemon::EventType::DataReceived;
+            event.peer_id = 9;
+            event.data = "msg " + std::to_string(i);
+            daemon.enqueue_event(std::move(event));
+        }
+
+        const bool delivered = wait_until([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return messages.size() == 100;
+        });
+        const auto peers = daemon.known_peers();
+        daemon.stop();
+        std::cout.rdbuf(saved);
+
+        check(delivered, "all messages delivered");
+        bool ordered = true;
+        bool stamped = true;
+        for (size_t i = 0; i < messages.size(); ++i) {
+            ordered = ordered && messages[i] == "msg " + std::to_string(i);
+            stamped = stamped && timestamps[i] == 1700000000000;
+        }
+        check(ordered, "delivered in order");
+        check(stamped, "timestamps come from the clock policy");
+        check(peers.size() == 1 && peers[0].last_seen == 1700000000000, "peer bookkeeping uses the clock policy");
+        check(captured.str().empty(), "no log output");
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
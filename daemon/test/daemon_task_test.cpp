@@ -0,0 +1,292 @@
+/**
+ * Daemon Task Test
+ *
+ * Tests the C++20 coroutine layer: tasks run on the worker thread,
+ * timers, nested tasks, acknowledged sends and receives between two
+ * daemons, timeouts, disconnects, and tasks left suspended at stop.
+ */
+
+#include "daemon.h"
+#include "daemon_task.h"
+#include "transport.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * Delivers everything sent to the other daemon, as coming from `as_peer`
+ */
+class PairTransport : public Transport {
+public:
+    explicit PairTransport(uint64_t as_peer) : remote_(nullptr), as_peer_(as_peer) {}
+
+    void connect_to(Daemon* remote) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        remote_ = remote;
+    }
+
+    void send(uint64_t, const std::string& data) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (remote_) {
+            Daemon::Event event;
+            event.type = Daemon::EventType::DataReceived;
+            event.peer_id = as_peer_;
+            event.data = data;
+            remote_->enqueue_event(std::move(event));
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    Daemon* remote_;
+    uint64_t as_peer_;
+};
+
+static void connect(Daemon& daemon, uint64_t peer_id, const char* uid) {
+    Daemon::Event event;
+    event.type = Daemon::EventType::PeerConnected;
+    event.peer_id = peer_id;
+    event.peer_uid = uid;
+    daemon.enqueue_event(std::move(event));
+}
+
+static std::thread::id worker_id(Daemon& daemon) {
+    std::promise<std::thread::id> id;
+    Daemon::Event event;
+    event.type = Daemon::EventType::OffloadComplete;
+    event.completion = [&id] { id.set_value(std::this_thread::get_id()); };
+    daemon.enqueue_event(std::move(event));
+    return id.get_future().get();
+}
+
+// Sets a flag when the coroutine frame holding it is destroyed
+struct FrameGuard {
+    std::atomic<bool>* destroyed;
+    ~FrameGuard() { destroyed->store(true); }
+};
+
+static DaemonTask<int> add_later(TaskScheduler& tasks, int a, int b) {
+    co_await task_sleep(tasks, 5ms);
+    co_return a + b;
+}
+
+static DaemonTask<> basics(TaskScheduler& tasks, std::thread::id* ran_on, int64_t* slept_ms, int* sum,
+                           std::atomic<bool>* done) {
+    *ran_on = std::this_thread::get_id();
+    const auto start = std::chrono::steady_clock::now();
+    co_await task_sleep(tasks, 30ms);
+    *slept_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    co_await task_yield(tasks);
+    *sum = co_await add_later(tasks, 20, 22);
+    done->store(true);
+}
+
+// One request/response round: send, then wait for the reply
+static DaemonTask<> client(TaskScheduler& tasks, uint64_t server, int rounds,
+                           std::vector<std::string>* replies, int* acked, std::atomic<bool>* done) {
+    for (int i = 0; i < rounds; ++i) {
+        if (co_await task_send(tasks, server, 7, "ping " + std::to_string(i), 1s)) {
+            (*acked)++;
+        }
+        auto reply = co_await task_receive(tasks, server, 7, 1s);
+        if (!reply) {
+            break;
+        }
+        replies->push_back(*reply);
+    }
+    done->store(true);
+}
+
+static DaemonTask<> server(TaskScheduler& tasks, uint64_t client, int rounds, std::atomic<int>* served) {
+    for (int i = 0; i < rounds; ++i) {
+        auto request = co_await task_receive(tasks, client, 7);
+        if (!request) {
+            co_return;
+        }
+        co_await task_send(tasks, client, 7, "pong" + request->substr(4), 1s);
+        (*served)++;
+    }
+}
+
+static DaemonTask<> never_started(std::atomic<bool>* resumed) {
+    resumed->store(true);
+    co_return;
+}
+
+// Results cross back to the test thread through promises
+static DaemonTask<> send_one(TaskScheduler& tasks, uint64_t peer, std::promise<bool>* acked) {
+    acked->set_value(co_await task_send(tasks, peer, 1, "anyone?", 40ms));
+}
+
+static DaemonTask<> receive_one(TaskScheduler& tasks, uint64_t peer, std::chrono::milliseconds timeout,
+                                std::promise<std::optional<std::string>>* result) {
+    result->set_value(co_await task_receive(tasks, peer, 1, timeout));
+}
+
+static DaemonTask<> wait_forever(TaskScheduler& tasks, std::atomic<bool>* destroyed, std::atomic<bool>* resumed) {
+    FrameGuard guard{destroyed};
+    co_await task_receive(tasks, 99, 3);
+    resumed->store(true);
+}
+
+int main() {
+    std::cout << "=== Daemon Task Test ===\n\n";
+
+    std::cout << "[1] Worker thread, timers, nested tasks...\n";
+    {
+        Daemon daemon;
+        daemon.start();
+
+        std::thread::id ran_on;
+        int64_t slept_ms = 0;
+        int sum = 0;
+        std::atomic<bool> done(false);
+        check(spawn(daemon.tasks(), basics(daemon.tasks(), &ran_on, &slept_ms, &sum, &done)), "spawned");
+        check(wait_until([&] { return done.load(); }), "task finished");
+        check(ran_on == worker_id(daemon), "ran on the worker thread");
+        check(slept_ms >= 30, "slept for the full delay");
+        check(sum == 42, "nested task result");
+
+        const TaskStats stats = daemon.task_stats();
+        check(stats.wakeups == 2 && stats.timers == 2, "wakeups and timers counted");
+        daemon.stop();
+
+        std::atomic<bool> resumed(false);
+        check(!spawn(daemon.tasks(), never_started(&resumed)), "spawn refused when stopped");
+        check(!resumed, "refused task never started");
+    }
+
+    std::cout << "\n[2] Request/response between daemons...\n";
+    {
+        Daemon a;
+        Daemon b;
+        PairTransport a_out(1);    // b sees a as peer 1
+        PairTransport b_out(2);    // a sees b as peer 2
+        a.set_transport(&a_out);
+        b.set_transport(&b_out);
+        a_out.connect_to(&b);
+        b_out.connect_to(&a);
+        a.start();
+        b.start();
+        connect(a, 2, "peer-b");
+        connect(b, 1, "peer-a");
+
+        std::vector<std::string> replies;
+        int acked = 0;
+        std::atomic<bool> done(false);
+        std::atomic<int> served(0);
+        spawn(b.tasks(), server(b.tasks(), 1, 20, &served));
+        spawn(a.tasks(), client(a.tasks(), 2, 20, &replies, &acked, &done));
+        check(wait_until([&] { return done.load(); }), "client finished");
+
+        check(wait_until([&] { return served == 20; }), "server answered every request");
+        check(acked == 20, "every request acknowledged");
+        bool in_order = replies.size() == 20;
+        for (size_t i = 0; in_order && i < replies.size(); ++i) {
+            in_order = replies[i] == "pong " + std::to_string(i);
+        }
+        check(in_order, "replies in order");
+        check(a.task_stats().sent == 20 && a.task_stats().acked == 20 && b.task_stats().received == 20,
+              "send/ack counters");
+
+        // Frames that arrive before anyone receives are buffered
+        std::promise<bool> sent;
+        std::promise<std::optional<std::string>> early;
+        auto sent_result = sent.get_future();
+        auto early_result = early.get_future();
+        spawn(a.tasks(), send_one(a.tasks(), 2, &sent));
+        check(sent_result.wait_for(2s) == std::future_status::ready && sent_result.get(),
+              "send acknowledged without a receiver");
+        spawn(b.tasks(), receive_one(b.tasks(), 1, 100ms, &early));
+        check(early_result.wait_for(2s) == std::future_status::ready && early_result.get() == "anyone?",
+              "buffered frame received");
+
+        a.stop();
+        b.stop();
+    }
+
+    std::cout << "\n[3] Timeouts and disconnects...\n";
+    {
+        Daemon daemon;
+        daemon.start();
+        connect(daemon, 5, "silent-peer");
+
+        std::promise<bool> acked;
+        std::promise<std::optional<std::string>> received;
+        auto acked_result = acked.get_future();
+        auto received_result = received.get_future();
+        const auto start = std::chrono::steady_clock::now();
+        spawn(daemon.tasks(), send_one(daemon.tasks(), 5, &acked));
+        spawn(daemon.tasks(), receive_one(daemon.tasks(), 5, 40ms, &received));
+        const bool finished = acked_result.wait_for(2s) == std::future_status::ready &&
+                              received_result.wait_for(2s) == std::future_status::ready;
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        check(finished && !acked_result.get(), "unacknowledged send times out");
+        check(finished && !received_result.get(), "receive times out");
+        check(elapsed >= 40ms, "after the timeout");
+        check(daemon.task_stats().timed_out == 2, "timeouts counted");
+
+        std::promise<std::optional<std::string>> cut;
+        auto cut_result = cut.get_future();
+        spawn(daemon.tasks(), receive_one(daemon.tasks(), 5, 0ms, &cut));
+        check(cut_result.wait_for(10ms) == std::future_status::timeout, "receive without timeout waits");
+        Daemon::Event event;
+        event.type = Daemon::EventType::PeerDisconnected;
+        event.peer_id = 5;
+        daemon.enqueue_event(std::move(event));
+        check(cut_result.wait_for(2s) == std::future_status::ready && !cut_result.get(),
+              "disconnect ends the receive");
+
+        daemon.stop();
+    }
+
+    std::cout << "\n[4] Suspended tasks at stop...\n";
+    {
+        std::atomic<bool> destroyed(false);
+        std::atomic<bool> resumed(false);
+        {
+            Daemon daemon;
+            daemon.start();
+            spawn(daemon.tasks(), wait_forever(daemon.tasks(), &destroyed, &resumed));
+            wait_until([&] { return daemon.task_stats().wakeups == 1 && !daemon.is_busy(); });
+            std::this_thread::sleep_for(10ms);
+            check(!destroyed, "suspended while running");
+            daemon.stop();
+            check(destroyed, "destroyed at stop");
+        }
+        check(!resumed, "never resumed");
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+/**
+ * Duty Cycle Test
+ *
+ * Tests the busy schedule at startup, exponential backoff while the mesh
+ * is idle, waking on traffic and churn, the outbox cap, then schedules
+ * from a running daemon and the C API.
+ */
+
+#include "duty_cycle.h"
+#include "daemon.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+struct Change {
+    int64_t      at_ms;
+    DutySchedule schedule;
+};
+
+// Updates once per 100 ms over [from, to); the changes reported
+static std::vector<Change> run(DutyCycleScheduler& duty, int64_t from, int64_t to) {
+    std::vector<Change> changes;
+    for (int64_t t = from; t < to; t += 100) {
+        DutySchedule schedule;
+        if (duty.update(t, schedule)) {
+            changes.push_back(Change{t, schedule});
+        }
+    }
+    return changes;
+}
+
+int main() {
+    std::cout << "=== Duty Cycle Test ===\n\n";
+
+    std::cout << "[1] Busy at startup...\n";
+    {
+        DutyCycleScheduler duty;
+        DutySchedule schedule;
+        check(duty.update(0, schedule), "first schedule reported");
+        check(schedule.level == 0 && schedule.scan_window_ms == schedule.scan_interval_ms,
+              "scanning continuously");
+        check(schedule.scan_interval_ms == 2000 && schedule.advertise_interval_ms == 100, "minimum intervals");
+        check(!duty.update(100, schedule), "unchanged schedule not repeated");
+    }
+
+    std::cout << "\n[2] Exponential backoff...\n";
+    {
+        DutyCycleScheduler duty;
+        const std::vector<Change> changes = run(duty, 0, 600000);
+
+        check(changes.size() == 7, "busy, then six steps to the maxima");
+        check(changes[1].at_ms >= 15000, "nothing before quiet_after_ms");
+
+        bool doubling = true;
+        bool spacing = true;
+        for (size_t i = 2; i < changes.size(); ++i) {
+            const DutySchedule& prev = changes[i - 1].schedule;
+            const DutySchedule& next = changes[i].schedule;
+            doubling = doubling && (next.scan_interval_ms == prev.scan_interval_ms * 2 || next.scan_interval_ms == 120000);
+            spacing = spacing && changes[i].at_ms - changes[i - 1].at_ms >= int64_t(prev.scan_interval_ms);
+        }
+        check(doubling, "each step doubles the interval");
+        check(spacing, "each step waits out a whole interval");
+
+        const DutySchedule last = changes.back().schedule;
+        check(last.scan_interval_ms == 120000 && last.scan_window_ms == 2000, "backed off to a 2 s scan every 2 min");
+        check(last.advertise_interval_ms == 2000, "advertising backed off too");
+        check(duty.stats().backoffs == 6, "backoffs counted");
+
+        const double duty_percent = 100.0 * last.scan_window_ms / last.scan_interval_ms;
+        std::cout << "    Idle scan duty: " << duty_percent << "%\n";
+        check(duty_percent < 2.0, "idle scan duty under 2%");
+    }
+
+    std::cout << "\n[3] Waking on activity...\n";
+    {
+        DutyCycleScheduler duty;
+        run(duty, 0, 100000);
+        check(duty.schedule().level > 0, "backed off");
+
+        check(duty.note_traffic(100000), "traffic asks for an update");
+        DutySchedule schedule;
+        check(duty.update(100000, schedule) && schedule.level == 0, "busy again at once");
+        check(!duty.note_traffic(100050), "no update needed while busy");
+        check(duty.stats().wakeups == 1, "wakeup counted");
+
+        check(!duty.note_churn(0, 200000), "no churn, no wakeup");
+        run(duty, 100100, 300000);
+        check(duty.note_churn(2, 300000), "churn asks for an update");
+        check(duty.update(300000, schedule) && schedule.level == 0, "churn wakes it too");
+        check(duty.stats().churn == 2 && duty.stats().traffic == 2, "activity counted");
+    }
+
+    std::cout << "\n[4] Outbox cap...\n";
+    {
+        DutyCycleScheduler duty;
+        run(duty, 0, 600000);
+        check(duty.schedule().scan_interval_ms == 120000, "fully backed off");
+
+        check(duty.set_outbox(3), "waiting messages ask for an update");
+        DutySchedule schedule;
+        check(duty.update(600000, schedule) && schedule.scan_interval_ms <= 10000, "interval capped");
+        check(!duty.set_outbox(5), "more messages change nothing");
+        check(run(duty, 600100, 900000).empty(), "held at the cap");
+
+        check(duty.set_outbox(0), "empty outbox lifts the cap");
+        const std::vector<Change> changes = run(duty, 900000, 1200000);
+        check(!changes.empty() && changes.back().schedule.scan_interval_ms == 120000, "backs off again");
+    }
+
+    std::cout << "\n[5] Daemon schedules...\n";
+    {
+        // Daemon log lines are not part of the test output
+        std::ostringstream sink;
+        std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+
+        Daemon daemon;
+        DutyCycleConfig config;
+        config.min_scan_interval_ms = 20;
+        config.scan_window_ms = 20;
+        config.max_scan_interval_ms = 80;
+        config.quiet_after_ms = 50;
+        daemon.set_duty_cycle_config(config);
+
+        std::mutex mutex;
+        std::vector<DutySchedule> seen;
+        DaemonCallbacks callbacks;
+        callbacks.on_duty_cycle = [&](const DutySchedule& schedule) {
+            std::lock_guard<std::mutex> lock(mutex);
+            seen.push_back(schedule);
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        auto last_level = [&]() -> int {
+            std::lock_guard<std::mutex> lock(mutex);
+            return seen.empty() ? -1 : int(seen.back().level);
+        };
+        const bool started = wait_until([&] { return last_level() >= 0; });
+        const bool backed_off = wait_until([&] { return last_level() >= 1; }, 4000);
+
+        Daemon::Event connect;
+        connect.type = Daemon::EventType::PeerConnected;
+        connect.peer_id = 51;
+        connect.peer_uid = "new@mesh";
+        daemon.enqueue_event(connect);
+        const bool woke = wait_until([&] { return last_level() == 0; }, 500);
+
+        daemon.stop();
+        std::cout.rdbuf(saved);
+
+        check(started, "schedule reported after start");
+        check(backed_off, "backs off when idle");
+        check(woke, "a new neighbour wakes it without waiting for maintenance");
+    }
+
+    std::cout << "\n[6] C API...\n";
+    {
+        meshcore* core = meshcore_create();
+
+        meshcore_duty_cycle_policy policy = {};
+        policy.scan_window_ms = 1000;
+        policy.min_scan_interval_ms = 1000;
+        policy.max_scan_interval_ms = 60000;
+        policy.min_advertise_interval_ms = 100;
+        policy.max_advertise_interval_ms = 1000;
+        policy.quiet_after_ms = 10000;
+        policy.outbox_max_interval_ms = 5000;
+        check(meshcore_set_duty_cycle_policy(core, &policy) == MESHCORE_OK, "policy set");
+        policy.min_scan_interval_ms = 120000;
+        check(meshcore_set_duty_cycle_policy(core, &policy) == MESHCORE_ERROR_INVALID_PARAM, "inverted interval rejected");
+        policy.min_scan_interval_ms = 0;
+        check(meshcore_set_duty_cycle_policy(core, &policy) == MESHCORE_ERROR_INVALID_PARAM, "zero interval rejected");
+        check(meshcore_set_duty_cycle_policy(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null policy rejected");
+
+        check(meshcore_set_outbox_pending(core, 4) == MESHCORE_OK, "outbox reported");
+
+        meshcore_duty_schedule schedule;
+        check(meshcore_get_duty_schedule(core, &schedule) == MESHCORE_OK, "schedule read");
+        check(meshcore_get_duty_schedule(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null schedule rejected");
+
+        meshcore_duty_cycle_stats stats;
+        check(meshcore_get_duty_cycle_stats(core, &stats) == MESHCORE_OK, "stats read");
+        check(stats.outbox == 4, "outbox carried");
+        check(meshcore_get_duty_cycle_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+
+        meshcore_destroy(core);
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,322 @@
+/**
+ * Flight Recorder Test
+ *
+ * Tests the circular buffer and its overwrite, the dump format and its
+ * decoder, recording cost, concurrent writers racing a dump, the records
+ * a running daemon leaves, dumps on abort, terminate and a segfault in
+ * a child process (chaining to the host's own handler), and the C API.
+ */
+
+#include "flight_recorder.h"
+#include "daemon.h"
+#include "meshcore.h"
+#include "transport.h"
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+static bool read_dump(const std::string& path, FlightDump& dump) {
+    return decode_flight_dump(read_file(path), dump);
+}
+
+static size_t count_of(const FlightDump& dump, DaemonEventType type, FlightOutcome outcome) {
+    size_t count = 0;
+    for (const FlightRecord& record : dump.records) {
+        if (record.type == uint8_t(type) && record.outcome == outcome) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Exit status of a crash handler the host installed before arming
+constexpr int kHostHandled = 77;
+
+static void host_crash_handler(int) {
+    _exit(kHostHandled);
+}
+
+// Child process: arm, record, then die through `crash`; returns the wait status
+static int crash_child(const std::string& path, const std::function<void()>& crash,
+                       const std::function<void()>& before_arming = nullptr) {
+    const pid_t pid = fork();
+    if (pid == 0) {
+        if (before_arming) {
+            before_arming();
+        }
+        FlightRecorder recorder(64);
+        recorder.set_dump_path(path);
+        for (uint64_t i = 1; i <= 3; ++i) {
+            recorder.record(FlightRecord{i, i + 1, 0, 40 + i, 10, uint8_t(DaemonEventType::DataReceived),
+                                         FlightOutcome::Completed});
+        }
+        crash();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+
+class NullTransport : public Transport {
+public:
+    void send(uint64_t, const std::string&) override {}
+};
+
+int main() {
+    std::cout << "=== Flight Recorder Test ===\n\n";
+    const std::string path = "/tmp/meshcore_flight_test.bin";
+
+    std::cout << "[1] Circular buffer...\n";
+    {
+        FlightRecorder recorder(16);
+        for (uint64_t i = 0; i < 40; ++i) {
+            recorder.record(FlightRecord{1000 + i, 2000 + i, 5, i, uint32_t(i * 3), uint8_t(i % 11),
+                                         FlightOutcome(i % 4)});
+        }
+        const FlightStats stats = recorder.stats();
+        check(stats.capacity == 16 && stats.recorded == 40 && !stats.armed, "stats");
+        check(recorder.dump(path) && recorder.stats().dumps == 1, "dumped");
+
+        FlightDump dump;
+        check(read_dump(path, dump), "decoded");
+        check(dump.reason == FlightDumpReason::OnDemand && dump.recorded == 40, "header");
+        check(dump.records.size() == 16 && dump.records.front().peer_id == 24 && dump.records.back().peer_id == 39,
+              "newest kept, oldest first");
+        const FlightRecord& last = dump.records.back();
+        check(last.queued_ns == 1039 && last.started_ns == 2039 && last.duration_ns == 5 && last.size == 117 &&
+              last.type == 39 % 11 && last.outcome == FlightOutcome(39 % 4), "fields round-trip");
+        check(read_file(path).size() == FlightRecorder::kHeaderSize + 16 * FlightRecorder::kRecordSize,
+              "compact: fixed-size records");
+    }
+
+    std::cout << "\n[2] Decoder...\n";
+    {
+        const std::string bytes = read_file(path);
+        FlightDump dump;
+        check(!decode_flight_dump(bytes.substr(0, bytes.size() - 1), dump), "truncated dump rejected");
+        check(!decode_flight_dump("not a dump at all, but long enough to hold a header", dump), "garbage rejected");
+        check(!decode_flight_dump(std::string(), dump), "empty rejected");
+
+        FlightRecorder empty;
+        check(empty.dump(path) && read_dump(path, dump) && dump.records.empty() && dump.recorded == 0,
+              "empty recorder dumps");
+        check(!empty.dump("/nonexistent/dir/flight.bin"), "unwritable path reported");
+    }
+
+    std::cout << "\n[3] Cost...\n";
+    {
+        FlightRecorder recorder;
+        const int kRecords = 1000000;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kRecords; ++i) {
+            recorder.record(FlightRecord{uint64_t(i), uint64_t(i), 0, 7, 64, 2, FlightOutcome::Completed});
+        }
+        const double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()) / kRecords;
+        std::cout << "    " << ns << " ns per record\n";
+        check(recorder.stats().recorded == uint64_t(kRecords), "all recorded");
+    }
+
+    std::cout << "\n[4] Concurrent writers...\n";
+    {
+        // The worker and the watchdog both record; dumps run alongside
+        FlightRecorder recorder(16);
+        std::atomic<bool> writing(true);
+        auto writer = [&](uint64_t id) {
+            for (int i = 0; i < 20000; ++i) {
+                recorder.record(FlightRecord{id, id, id, id, uint32_t(id), uint8_t(id), FlightOutcome::Stalled});
+            }
+        };
+        std::thread a(writer, 1);
+        std::thread b(writer, 2);
+        std::thread done([&] {
+            a.join();
+            b.join();
+            writing = false;
+        });
+
+        bool consistent = true;
+        int dumps = 0;
+        while (writing || dumps == 0) {
+            FlightDump dump;
+            if (!recorder.dump(path) || !read_dump(path, dump) || dump.records.size() > 16) {
+                consistent = false;
+                break;
+            }
+            for (const FlightRecord& record : dump.records) {
+                const uint64_t id = record.peer_id;
+                consistent = consistent && (id == 1 || id == 2) && record.queued_ns == id &&
+                             record.started_ns == id && record.duration_ns == id && record.size == id &&
+                             record.type == id && record.outcome == FlightOutcome::Stalled;
+            }
+            dumps++;
+        }
+        done.join();
+        check(consistent, "no torn or mixed records");
+        check(recorder.stats().recorded == 40000, "every write counted");
+    }
+
+    std::cout << "\n[5] Daemon records...\n";
+    {
+        Daemon daemon;
+        NullTransport transport;
+        daemon.set_transport(&transport);
+        AdmissionConfig tight;
+        tight.frames_per_sec = 1;
+        tight.burst_frames = 5;
+        daemon.set_admission_config(tight);
+
+        std::atomic<int> delivered(0);
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) { delivered++; };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        Daemon::Event connect;
+        connect.type = Daemon::EventType::PeerConnected;
+        connect.peer_id = 71;
+        connect.peer_uid = "recorded@mesh";
+        daemon.enqueue_event(connect);
+        for (int i = 0; i < 8; ++i) {
+            Daemon::Event data;
+            data.type = Daemon::EventType::DataReceived;
+            data.peer_id = 71;
+            data.data = "message " + std::to_string(i);
+            daemon.enqueue_event(data);
+        }
+        Daemon::Event send;
+        send.type = Daemon::EventType::SendMessage;
+        send.peer_id = 71;
+        send.data = "reply";
+        daemon.enqueue_event(send);
+
+        wait_until([&] { return delivered == 5; });
+        wait_until([&] { return daemon.flight_stats().recorded >= 10; });
+        check(daemon.dump_flight_recorder(path), "dumped");
+        daemon.stop();
+
+        FlightDump dump;
+        check(read_dump(path, dump), "decoded");
+        check(count_of(dump, DaemonEventType::PeerConnected, FlightOutcome::Stopped) == 1, "control event stopped");
+        check(count_of(dump, DaemonEventType::DataDecoded, FlightOutcome::Completed) == 5, "deliveries completed");
+        check(count_of(dump, DaemonEventType::DataReceived, FlightOutcome::Refused) == 3, "policed frames refused");
+        check(count_of(dump, DaemonEventType::SendMessage, FlightOutcome::Completed) == 1, "send completed");
+
+        bool ordered = true;
+        for (const FlightRecord& record : dump.records) {
+            if (record.outcome != FlightOutcome::Refused &&
+                (record.queued_ns == 0 || record.started_ns < record.queued_ns || record.duration_ns == 0)) {
+                ordered = false;
+            }
+        }
+        check(ordered, "queued, started and handler times set");
+        bool sized = false;
+        for (const FlightRecord& record : dump.records) {
+            sized = sized || (record.peer_id == 71 && record.size == 9);
+        }
+        check(sized, "peer and size kept");
+    }
+
+    std::cout << "\n[6] Automatic dumps...\n";
+    {
+        std::remove(path.c_str());
+        int status = crash_child(path, [] { std::abort(); });
+        FlightDump dump;
+        check(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT, "child still dies of its signal");
+        check(read_dump(path, dump) && dump.reason == FlightDumpReason::Fatal && dump.records.size() == 3,
+              "abort dumped");
+
+        std::remove(path.c_str());
+        crash_child(path, [] { std::terminate(); });
+        check(read_dump(path, dump) && dump.reason == FlightDumpReason::Fatal && dump.records.size() == 3 &&
+              dump.records[2].peer_id == 43, "terminate dumped");
+
+        std::remove(path.c_str());
+        status = crash_child(path, [] { std::raise(SIGSEGV); },
+                             [] { std::signal(SIGSEGV, host_crash_handler); });
+        check(read_dump(path, dump) && dump.reason == FlightDumpReason::Fatal, "segfault dumped");
+        check(WIFEXITED(status) && WEXITSTATUS(status) == kHostHandled, "host's earlier handler still runs");
+
+        FlightRecorder recorder;
+        check(!recorder.trip(FlightDumpReason::Watchdog), "disarmed trip does nothing");
+        check(recorder.set_dump_path(path) && recorder.stats().armed, "armed");
+        check(recorder.trip(FlightDumpReason::Watchdog) && read_dump(path, dump) &&
+              dump.reason == FlightDumpReason::Watchdog, "trip dumps to the armed path");
+        check(!recorder.set_dump_path(std::string(FlightRecorder::kMaxPath, 'p')), "overlong path refused");
+        check(recorder.set_dump_path(std::string()) && !recorder.stats().armed, "disarmed");
+    }
+
+    std::cout << "\n[7] C API...\n";
+    {
+        meshcore* core = meshcore_create();
+        meshcore_simulate_peer_connect(core, 91, "api@mesh");
+        wait_until([&] {
+            meshcore_flight_stats stats;
+            meshcore_get_flight_stats(core, &stats);
+            return stats.recorded > 0;
+        });
+
+        check(meshcore_dump_flight_recorder(core, path.c_str()) == MESHCORE_OK, "dumped");
+        FlightDump dump;
+        check(read_dump(path, dump) && count_of(dump, DaemonEventType::PeerConnected, FlightOutcome::Stopped) == 1,
+              "file holds the events");
+        check(meshcore_dump_flight_recorder(core, "/nonexistent/dir/flight.bin") == MESHCORE_ERROR_STORAGE,
+              "unwritable path reported");
+        check(meshcore_dump_flight_recorder(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null path rejected");
+
+        check(meshcore_set_flight_dump_path(core, path.c_str()) == MESHCORE_OK, "armed");
+        meshcore_flight_stats stats;
+        check(meshcore_get_flight_stats(core, &stats) == MESHCORE_OK && stats.armed && stats.dumps == 1 &&
+              stats.capacity > 0, "stats read");
+        check(meshcore_set_flight_dump_path(core, std::string(4096, 'p').c_str()) == MESHCORE_ERROR_INVALID_PARAM,
+              "overlong path rejected");
+        check(meshcore_set_flight_dump_path(core, nullptr) == MESHCORE_OK &&
+              meshcore_get_flight_stats(core, &stats) == MESHCORE_OK && !stats.armed, "disarmed");
+        check(meshcore_get_flight_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+
+        meshcore_destroy(core);
+    }
+
+    std::remove(path.c_str());
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+/**
+ * Handshake Test
+ *
+ * Tests X25519 against RFC 7748, then runs two daemons over a paired
+ * transport: full handshake, 0-RTT resumption, replay rejection and
+ * fallback when the responder no longer accepts the ticket, and re-keying
+ * when a session is evicted.
+ */
+
+#include "daemon.h"
+#include "transport.h"
+#include "handshake.h"
+#include "frame.h"
+#include "x25519.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static std::vector<uint8_t> unhex(const char* s) {
+    std::vector<uint8_t> out;
+    for (; s[0] && s[1]; s += 2) {
+        out.push_back(static_cast<uint8_t>(std::stoi(std::string(s, 2), nullptr, 16)));
+    }
+    return out;
+}
+
+/**
+ * Delivers everything sent to the other daemon, as coming from `as_peer`
+ */
+class PairTransport : public Transport {
+public:
+    explicit PairTransport(uint64_t as_peer) : remote_(nullptr), as_peer_(as_peer) {}
+
+    void connect_to(Daemon* remote) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        remote_ = remote;
+    }
+
+    void send(uint64_t, const std::string& data) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        log_.push_back(data);
+        if (remote_) {
+            Daemon::Event event;
+            event.type = Daemon::EventType::DataReceived;
+            event.peer_id = as_peer_;
+            event.data = data;
+            remote_->enqueue_event(std::move(event));
+        }
+    }
+
+    std::vector<std::string> take_log() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> out;
+        out.swap(log_);
+        return out;
+    }
+
+private:
+    std::mutex mutex_;
+    Daemon* remote_;
+    uint64_t as_peer_;
+    std::vector<std::string> log_;
+};
+
+static std::mutex inbox_mutex;
+static std::vector<std::string> inbox;
+
+static DaemonCallbacks collecting_callbacks() {
+    DaemonCallbacks callbacks;
+    callbacks.on_message = [](uint64_t, const std::string&, const std::string& message, int64_t) {
+        std::lock_guard<std::mutex> lock(inbox_mutex);
+        inbox.push_back(message);
+    };
+    return callbacks;
+}
+
+static size_t inbox_count(const std::string& message) {
+    std::lock_guard<std::mutex> lock(inbox_mutex);
+    size_t n = 0;
+    for (const auto& m : inbox) {
+        n += m == message;
+    }
+    return n;
+}
+
+static void peer_event(Daemon& d, Daemon::EventType type, uint64_t peer_id, const char* uid) {
+    Daemon::Event event;
+    event.type = type;
+    event.peer_id = peer_id;
+    event.peer_uid = uid;
+    d.enqueue_event(std::move(event));
+}
+
+static void send_message(Daemon& d, uint64_t peer_id, const char* text) {
+    Daemon::Event event;
+    event.type = Daemon::EventType::SendMessage;
+    event.peer_id = peer_id;
+    event.data = text;
+    d.enqueue_event(std::move(event));
+}
+
+static FrameType type_of(const std::string& frame) {
+    return is_frame(frame) ? frame_header(frame).type : FrameType::ChunkOffer;
+}
+
+static void settle() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+int main() {
+    std::cout << "=== Handshake Test ===\n\n";
+
+    std::cout << "[1] X25519 (RFC 7748)...\n";
+    const auto a = unhex("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a");
+    const auto b = unhex("5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb");
+    uint8_t pa[32], pb[32], s1[32], s2[32];
+    x25519_public_key(pa, a.data());
+    x25519_public_key(pb, b.data());
+    check(std::memcmp(pa, unhex("8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a").data(), 32) == 0,
+          "public key");
+    check(x25519(s1, a.data(), pb) && x25519(s2, b.data(), pa) &&
+          std::memcmp(s1, unhex("4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742").data(), 32) == 0 &&
+          std::memcmp(s1, s2, 32) == 0, "shared secret");
+    const uint8_t zero[32] = {};
+    check(!x25519(s1, a.data(), zero), "low-order point refused");
+
+    // alice sees bob as peer 2, bob sees alice as peer 1
+    PairTransport to_bob(1);
+    PairTransport to_alice(2);
+    Daemon alice;
+    Daemon bob;
+    alice.set_transport(&to_bob);
+    bob.set_transport(&to_alice);
+    alice.set_callbacks(collecting_callbacks());
+    bob.set_callbacks(collecting_callbacks());
+    to_bob.connect_to(&bob);
+    to_alice.connect_to(&alice);
+    alice.start();
+    bob.start();
+
+    std::cout << "\n[2] Full handshake...\n";
+    peer_event(alice, Daemon::EventType::PeerConnected, 2, "bob");
+    peer_event(bob, Daemon::EventType::PeerConnected, 1, "alice");
+    settle();
+
+    check(alice.start_handshake(2), "handshake started");
+    check(!alice.start_handshake(99), "unknown peer refused");
+    send_message(alice, 2, "first");
+    settle();
+
+    std::vector<std::string> wire = to_bob.take_log();
+    check(wire.size() == 2 && type_of(wire[0]) == FrameType::Hello && type_of(wire[1]) == FrameType::Sealed,
+          "message held until the handshake completed, then sealed");
+    check(inbox_count("first") == 1, "delivered");
+    check(alice.handshake_stats().full == 1 && bob.handshake_stats().full == 1, "both sides count it");
+
+    send_message(bob, 1, "reply");
+    settle();
+    check(inbox_count("reply") == 1 && type_of(to_alice.take_log().back()) == FrameType::Sealed,
+          "responder sends sealed");
+
+    std::cout << "\n[3] Resumption (0-RTT)...\n";
+    peer_event(alice, Daemon::EventType::PeerDisconnected, 2, "bob");
+    peer_event(bob, Daemon::EventType::PeerDisconnected, 1, "alice");
+    settle();
+    check(!alice.sessions().has(2) && !bob.sessions().has(1), "sessions end with the connection");
+
+    peer_event(alice, Daemon::EventType::PeerConnected, 2, "bob");
+    peer_event(bob, Daemon::EventType::PeerConnected, 1, "alice");
+    settle();
+    to_bob.take_log();
+    to_alice.take_log();
+
+    alice.start_handshake(2);
+    send_message(alice, 2, "early");
+    settle();
+
+    wire = to_bob.take_log();
+    check(wire.size() == 2 && type_of(wire[0]) == FrameType::Resume && type_of(wire[1]) == FrameType::Sealed,
+          "early data sent right behind the Resume");
+    check(inbox_count("early") == 1, "early data delivered");
+    check(type_of(to_alice.take_log().front()) == FrameType::ResumeAck, "acknowledged with a fresh ticket");
+    check(alice.handshake_stats().resumed == 1 && bob.handshake_stats().resumed == 1, "resumed, no key exchange");
+
+    std::cout << "\n[4] Replay...\n";
+    peer_event(bob, Daemon::EventType::PeerDisconnected, 1, "alice");
+    peer_event(bob, Daemon::EventType::PeerConnected, 1, "alice");
+    settle();
+    to_bob.connect_to(nullptr);
+    for (const auto& frame : wire) {
+        Daemon::Event event;
+        event.type = Daemon::EventType::DataReceived;
+        event.peer_id = 1;
+        event.data = frame;
+        bob.enqueue_event(std::move(event));
+    }
+    settle();
+    check(bob.handshake_stats().rejected == 1, "replayed ticket refused");
+    check(inbox_count("early") == 1, "replayed early data dropped");
+    to_bob.connect_to(&bob);
+
+    std::cout << "\n[5] Fallback after responder restart...\n";
+    peer_event(alice, Daemon::EventType::PeerDisconnected, 2, "bob");
+    bob.stop();
+
+    Daemon bob2;   // New ticket key: alice's ticket is now worthless
+    bob2.set_transport(&to_alice);
+    bob2.set_callbacks(collecting_callbacks());
+    to_bob.connect_to(&bob2);
+    bob2.start();
+    peer_event(bob2, Daemon::EventType::PeerConnected, 1, "alice");
+    peer_event(alice, Daemon::EventType::PeerConnected, 2, "bob");
+    settle();
+    to_bob.take_log();
+
+    alice.start_handshake(2);
+    send_message(alice, 2, "after restart");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    check(alice.handshake_stats().fallbacks == 1 && bob2.handshake_stats().full == 1, "fell back to a full handshake");
+    check(inbox_count("after restart") == 1, "early data re-sent exactly once");
+
+    std::cout << "\n[6] Lost session...\n";
+    for (uint64_t peer = 100; peer < 100 + SessionCache::kDefaultCapacity; ++peer) {
+        alice.sessions().install(peer, SessionKey{}, SessionKey{});
+    }
+    check(alice.sessions().has(2), "connected peer's session survives the churn");
+
+    // As if bob had not been connected through the churn
+    alice.sessions().set_connected(2, false);
+    for (uint64_t peer = 400; peer < 400 + SessionCache::kDefaultCapacity; ++peer) {
+        alice.sessions().install(peer, SessionKey{}, SessionKey{});
+    }
+    check(!alice.sessions().has(2), "evicted");
+    to_bob.take_log();
+
+    send_message(alice, 2, "after eviction");
+    settle();
+    wire = to_bob.take_log();
+    check(wire.size() == 2 && Handshake::is_handshake_frame(wire[0]) && type_of(wire[1]) == FrameType::Sealed,
+          "re-keyed, never sent in plaintext");
+    check(inbox_count("after eviction") == 1, "delivered");
+
+    alice.stop();
+    bob2.stop();
+
+    std::cout << "\n[7] C API...\n";
+    meshcore* core = meshcore_create();
+    check(meshcore_start_handshake(core, 5) == MESHCORE_ERROR_PEER_NOT_FOUND, "unknown peer");
+    meshcore_handshake_stats stats;
+    check(meshcore_get_handshake_stats(core, &stats) == MESHCORE_OK && stats.full == 0, "stats");
+    meshcore_destroy(core);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+/**
+ * Hibernation Test
+ *
+ * Tests deadlines coalescing onto the slack grid, deferred optional
+ * work, the wakeups-per-minute window, then a hibernating daemon that
+ * stays asleep yet delivers traffic at once, and the C API.
+ */
+
+#include "hibernation.h"
+#include "daemon.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+using Clock = Hibernation::Clock;
+using std::chrono::milliseconds;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Hibernation Test ===\n\n";
+
+    const Clock::time_point t0 = Clock::now();
+
+    std::cout << "[1] Coalescing...\n";
+    {
+        HibernationConfig config;
+        config.slack_ms = 1000;
+        Hibernation hibernation(config);
+
+        const Clock::time_point deadline = t0 + milliseconds(250);
+        check(hibernation.coalesce(deadline, t0) == deadline, "awake: deadline unchanged");
+
+        check(hibernation.set_active(true, t0), "entered");
+        check(!hibernation.set_active(true, t0), "entering twice changes nothing");
+
+        check(hibernation.coalesce(t0 + milliseconds(250), t0) == t0 + milliseconds(1000), "rounded up to the grid");
+        check(hibernation.coalesce(t0 + milliseconds(900), t0) == t0 + milliseconds(1000), "neighbours share a wakeup");
+        check(hibernation.coalesce(t0 + milliseconds(2000), t0) == t0 + milliseconds(2000), "on the grid already");
+        check(hibernation.coalesce(t0 + milliseconds(2001), t0 + milliseconds(1500)) == t0 + milliseconds(3000),
+              "grid stays anchored at entry");
+        check(hibernation.coalesce(t0, t0 + milliseconds(10)) == t0, "due deadlines are not delayed");
+        check(hibernation.stats(t0).coalesced == 3, "moved deadlines counted");
+
+        check(hibernation.set_active(false, t0) && !hibernation.active(), "left");
+        check(hibernation.stats(t0).hibernations == 1, "hibernations counted");
+    }
+
+    std::cout << "\n[2] Optional work...\n";
+    {
+        HibernationConfig config;
+        config.optional_every_ms = 10000;
+        Hibernation hibernation(config);
+
+        check(hibernation.optional_due(t0), "awake: always due");
+        hibernation.optional_done(t0);
+        check(hibernation.optional_due(t0 + milliseconds(1)), "awake: still due");
+
+        hibernation.set_active(true, t0);
+        check(!hibernation.optional_due(t0 + milliseconds(5000)), "hibernating: put off");
+        check(!hibernation.optional_due(t0 + milliseconds(9999)), "put off until the period ends");
+        check(hibernation.optional_due(t0 + milliseconds(10000)), "due once a period has passed");
+        hibernation.optional_done(t0 + milliseconds(10000));
+        check(!hibernation.optional_due(t0 + milliseconds(11000)), "put off again after running");
+        check(hibernation.stats(t0).deferred == 3, "deferrals counted");
+    }
+
+    std::cout << "\n[3] Wakeups per minute...\n";
+    {
+        Hibernation hibernation;
+        for (int i = 0; i < 90; ++i) {
+            hibernation.note_wakeup(t0 + std::chrono::seconds(i), i % 3 == 0);
+        }
+        const HibernationStats stats = hibernation.stats(t0 + std::chrono::seconds(89));
+        check(stats.wakeups == 90 && stats.traffic_wakeups == 30, "all wakeups counted");
+        check(stats.wakeups_per_minute == 60, "only the last minute in the rate");
+        check(hibernation.stats(t0 + std::chrono::seconds(200)).wakeups_per_minute == 0, "rate decays when idle");
+    }
+
+    std::cout << "\n[4] Hibernating daemon...\n";
+    {
+        // Daemon log lines are not part of the test output
+        std::ostringstream sink;
+        std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+
+        Daemon daemon;
+        HibernationConfig config;
+        config.slack_ms = 5000;
+        daemon.set_hibernation_config(config);
+
+        std::mutex mutex;
+        std::string received;
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string& message, int64_t) {
+            std::lock_guard<std::mutex> lock(mutex);
+            received = message;
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        daemon.set_hibernation(true);
+        const bool entered = daemon.hibernating();
+
+        // Awake, maintenance would run at least once a second
+        const HibernationStats before = daemon.hibernation_stats();
+        std::this_thread::sleep_for(milliseconds(2500));
+        const HibernationStats after = daemon.hibernation_stats();
+        const uint64_t timed = (after.wakeups - after.traffic_wakeups) - (before.wakeups - before.traffic_wakeups);
+
+        Daemon::Event connect;
+        connect.type = Daemon::EventType::PeerConnected;
+        connect.peer_id = 61;
+        connect.peer_uid = "sleeper@mesh";
+        daemon.enqueue_event(connect);
+
+        Daemon::Event data;
+        data.type = Daemon::EventType::DataReceived;
+        data.peer_id = 61;
+        data.data = "wake up";
+        const auto sent_at = std::chrono::steady_clock::now();
+        daemon.enqueue_event(data);
+        const bool delivered = wait_until([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return received == "wake up";
+        }, 500);
+        const auto latency = std::chrono::steady_clock::now() - sent_at;
+
+        const HibernationStats stats = daemon.hibernation_stats();
+        daemon.set_hibernation(false);
+        const bool left = !daemon.hibernating();
+        daemon.stop();
+        std::cout.rdbuf(saved);
+
+        std::cout << "    Timer wakeups in 2.5 s: " << timed << ", traffic latency: "
+                  << std::chrono::duration_cast<milliseconds>(latency).count() << " ms\n";
+        check(entered, "hibernation entered");
+        check(timed == 0, "maintenance coalesced: no timer wakeups within the slack");
+        check(delivered, "inbound traffic delivered at once");
+        check(stats.traffic_wakeups > after.traffic_wakeups, "traffic wakeups counted");
+        check(stats.coalesced > 0, "deadlines moved onto the grid");
+        check(left, "hibernation left");
+    }
+
+    std::cout << "\n[5] C API...\n";
+    {
+        meshcore* core = meshcore_create();
+
+        meshcore_hibernation_policy policy = {};
+        policy.slack_ms = 20000;
+        policy.optional_every_ms = 300000;
+        check(meshcore_set_hibernation_policy(core, &policy) == MESHCORE_OK, "policy set");
+        policy.slack_ms = 0;
+        check(meshcore_set_hibernation_policy(core, &policy) == MESHCORE_ERROR_INVALID_PARAM, "zero slack rejected");
+        check(meshcore_set_hibernation_policy(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null policy rejected");
+
+        check(meshcore_set_hibernation(core, true) == MESHCORE_OK, "entered");
+
+        meshcore_hibernation_stats stats;
+        check(meshcore_get_hibernation_stats(core, &stats) == MESHCORE_OK, "stats read");
+        check(stats.hibernating && stats.hibernations == 1, "hibernating reported");
+        check(meshcore_get_hibernation_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+
+        check(meshcore_set_hibernation(core, false) == MESHCORE_OK, "left");
+        meshcore_get_hibernation_stats(core, &stats);
+        check(!stats.hibernating, "awake reported");
+        check(meshcore_set_hibernation(nullptr, true) == MESHCORE_ERROR_UNKNOWN, "null core rejected");
+
+        meshcore_destroy(core);
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,335 @@
+/**
+ * Ingress Test
+ *
+ * Tests per-peer ordering with barrier frames, backlog limits, parallel
+ * decoding across peers, reset() and destruction while a drain runs,
+ * consumed frames finished out of order, and sealed traffic decoded
+ * before it reaches the daemon worker.
+ */
+
+#include "ingress.h"
+#include "daemon.h"
+#include "session_cache.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * Records what the ingress decodes and posts; "B..." frames are
+ * barriers, "X..." frames are dropped, "C..." frames are consumed
+ */
+struct Recorder {
+    std::mutex               mutex;
+    std::vector<std::string> decoded;
+    std::vector<std::string> posted;
+    std::vector<uint64_t>    tickets;     // Of consumed frames
+    std::chrono::milliseconds delay{0};
+
+    Ingress::Verdict decode(std::string& data, uint64_t ticket = 0) {
+        std::this_thread::sleep_for(delay);
+        std::lock_guard<std::mutex> lock(mutex);
+        decoded.push_back(data);
+        if (data[0] == 'B') {
+            return Ingress::Verdict::Barrier;
+        }
+        if (data[0] == 'C') {
+            tickets.push_back(ticket);
+            return Ingress::Verdict::Consumed;
+        }
+        return data[0] == 'X' ? Ingress::Verdict::Drop : Ingress::Verdict::Deliver;
+    }
+
+    void post(InboundFrame&& frame, bool barrier) {
+        std::lock_guard<std::mutex> lock(mutex);
+        posted.push_back(barrier ? "[" + frame.data + "]" : frame.data);
+    }
+
+    size_t posted_count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return posted.size();
+    }
+};
+
+
+int main() {
+    std::cout << "=== Ingress Test ===\n\n";
+
+    OffloadConfig pool_config;
+    pool_config.threads = 4;
+    OffloadPool pool(pool_config, nullptr);
+
+    std::cout << "[1] Barriers...\n";
+    {
+        Recorder rec;
+        Ingress::Config config;
+        Ingress ingress(pool,
+                        [&rec](uint64_t, std::string& data, uint64_t) { return rec.decode(data); },
+                        [&rec](InboundFrame&& frame, bool barrier) { rec.post(std::move(frame), barrier); },
+                        config);
+        for (const char* data : { "a1", "X", "B1", "a2", "a3" }) {
+            ingress.submit(InboundFrame{1, data, 0});
+        }
+        wait_until([&] { return rec.posted_count() == 2; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        {
+            std::lock_guard<std::mutex> lock(rec.mutex);
+            check(rec.posted == std::vector<std::string>({ "a1", "[B1]" }), "barrier posted undecoded, in order");
+            check(rec.decoded.size() == 3, "later frames wait for the worker");
+        }
+
+        ingress.resume(1);
+        wait_until([&] { return rec.posted_count() == 4; });
+        {
+            std::lock_guard<std::mutex> lock(rec.mutex);
+            check(rec.posted == std::vector<std::string>({ "a1", "[B1]", "a2", "a3" }), "resumed in order");
+        }
+        const IngressStats stats = ingress.stats();
+        check(stats.decoded == 3 && stats.dropped == 1 && stats.barriers == 1, "stats");
+    }
+
+    std::cout << "\n[2] Backlog...\n";
+    {
+        Recorder rec;
+        Ingress::Config config;
+        config.max_backlog = 2;
+        Ingress ingress(pool,
+                        [&rec](uint64_t, std::string& data, uint64_t) { return rec.decode(data); },
+                        [&rec](InboundFrame&& frame, bool barrier) { rec.post(std::move(frame), barrier); },
+                        config);
+        ingress.submit(InboundFrame{1, "B", 0});
+        wait_until([&] { return rec.posted_count() == 1; });
+        check(ingress.submit(InboundFrame{1, "a", 0}) && ingress.submit(InboundFrame{1, "b", 0}), "queued behind the barrier");
+        check(!ingress.submit(InboundFrame{1, "c", 0}), "full backlog refused");
+        check(ingress.submit(InboundFrame{2, "d", 0}), "other peers unaffected");
+        check(ingress.stats().overflow == 1, "overflow counted");
+        wait_until([&] { return rec.posted_count() == 2; });
+
+        ingress.reset();
+        ingress.resume(1);
+        check(ingress.submit(InboundFrame{1, "e", 0}) && wait_until([&] { return rec.posted_count() >= 3; }),
+              "reset clears a stuck peer");
+    }
+
+    std::cout << "\n[3] Reset while draining...\n";
+    {
+        Recorder rec;
+        std::atomic<int> active(0);
+        std::atomic<int> overlaps(0);
+        {
+            Ingress ingress(pool,
+                            [&](uint64_t, std::string& data, uint64_t) {
+                                if (active++ > 0) {
+                                    overlaps++;
+                                }
+                                std::this_thread::sleep_for(std::chrono::milliseconds(30));
+                                active--;
+                                return rec.decode(data);
+                            },
+                            [&rec](InboundFrame&& frame, bool barrier) { rec.post(std::move(frame), barrier); });
+            ingress.submit(InboundFrame{1, "old", 0});
+            wait_until([&] { return active == 1; });
+            ingress.reset();
+            ingress.submit(InboundFrame{1, "n1", 0});
+            ingress.submit(InboundFrame{1, "n2", 0});
+            wait_until([&] { return rec.posted_count() == 2; });
+            {
+                std::lock_guard<std::mutex> lock(rec.mutex);
+                check(rec.posted == std::vector<std::string>({ "n1", "n2" }), "frame decoded across the reset dropped");
+            }
+            check(overlaps == 0, "one drain per peer across the reset");
+
+            // Left queued for the destructor
+            for (int i = 0; i < 5; ++i) {
+                ingress.submit(InboundFrame{2, "late", 0});
+            }
+            wait_until([&] { return active == 1; });
+        }
+        check(active == 0, "destructor waits for running drains");
+    }
+
+    std::cout << "\n[4] Parallel across peers...\n";
+    {
+        Recorder rec;
+        rec.delay = std::chrono::milliseconds(40);
+        Ingress::Config config;
+        Ingress ingress(pool,
+                        [&rec](uint64_t, std::string& data, uint64_t) { return rec.decode(data); },
+                        [&rec](InboundFrame&& frame, bool barrier) { rec.post(std::move(frame), barrier); },
+                        config);
+        const auto t0 = std::chrono::steady_clock::now();
+        for (uint64_t peer = 1; peer <= 4; ++peer) {
+            ingress.submit(InboundFrame{peer, "m", 0});
+        }
+        wait_until([&] { return rec.posted_count() == 4; });
+        const auto elapsed = std::chrono::steady_clock::now() - t0;
+        check(elapsed < std::chrono::milliseconds(120), "peers decode concurrently");
+    }
+
+    std::cout << "\n[5] Consumed frames...\n";
+    {
+        Recorder rec;
+        Ingress ingress(pool,
+                        [&rec](uint64_t, std::string& data, uint64_t ticket) { return rec.decode(data, ticket); },
+                        [&rec](InboundFrame&& frame, bool barrier) { rec.post(std::move(frame), barrier); });
+        for (const char* data : { "a1", "C1", "a2", "C2", "C3", "a3" }) {
+            ingress.submit(InboundFrame{1, data, 0});
+        }
+        wait_until([&] {
+            std::lock_guard<std::mutex> lock(rec.mutex);
+            return rec.decoded.size() == 6;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        {
+            std::lock_guard<std::mutex> lock(rec.mutex);
+            check(rec.posted == std::vector<std::string>({ "a1" }), "later frames held behind a consumed one");
+        }
+
+        // Finished out of order, from other threads
+        std::vector<uint64_t> tickets;
+        {
+            std::lock_guard<std::mutex> lock(rec.mutex);
+            tickets = rec.tickets;
+        }
+        std::thread([&] { ingress.finish(1, tickets[2], true); }).join();
+        std::thread([&] { ingress.finish(1, tickets[1], false); }).join();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        check(rec.posted_count() == 1, "nothing passes the first consumed frame");
+
+        ingress.finish(1, tickets[0], true);
+        ingress.finish(1, tickets[0], false);
+        wait_until([&] { return rec.posted_count() == 5; });
+        {
+            std::lock_guard<std::mutex> lock(rec.mutex);
+            check(rec.posted == std::vector<std::string>({ "a1", "C1", "a2", "C3", "a3" }), "posted in arrival order");
+        }
+        const IngressStats stats = ingress.stats();
+        check(stats.decoded == 5 && stats.dropped == 1, "finished frames counted once");
+
+        ingress.submit(InboundFrame{1, "C4", 0});
+        wait_until([&] {
+            std::lock_guard<std::mutex> lock(rec.mutex);
+            return rec.tickets.size() == 4;
+        });
+        ingress.reset();
+        ingress.finish(1, rec.tickets[3], true);
+        check(ingress.submit(InboundFrame{1, "a4", 0}) && wait_until([&] { return rec.posted_count() == 6; }) &&
+              rec.posted.back() == "a4", "tickets from before a reset ignored");
+    }
+    {
+        // The consumer finishes before the decode callback has returned
+        Recorder rec;
+        Ingress* self = nullptr;
+        Ingress ingress(pool,
+                        [&](uint64_t peer_id, std::string& data, uint64_t ticket) {
+                            const Ingress::Verdict verdict = rec.decode(data, ticket);
+                            if (verdict == Ingress::Verdict::Consumed) {
+                                std::thread([&] { self->finish(peer_id, ticket, true); }).join();
+                            }
+                            return verdict;
+                        },
+                        [&rec](InboundFrame&& frame, bool barrier) { rec.post(std::move(frame), barrier); });
+        self = &ingress;
+        for (const char* data : { "C1", "a1", "C2" }) {
+            ingress.submit(InboundFrame{1, data, 0});
+        }
+        check(wait_until([&] { return rec.posted_count() == 3; }), "early finish not lost");
+    }
+
+    std::cout << "\n[6] Daemon (sealed traffic)...\n";
+    {
+        Daemon daemon;
+        std::mutex mutex;
+        std::vector<std::string> received;
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string& message, int64_t) {
+            std::lock_guard<std::mutex> lock(mutex);
+            received.push_back(message);
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        SessionKey k1{};
+        SessionKey k2{};
+        k1[0] = 1;
+        k2[0] = 2;
+        SessionCache remote;
+        remote.install(3, k1, k2);
+        daemon.sessions().install(3, k2, k1);
+
+        for (int i = 0; i < 50; ++i) {
+            const std::string text = "sealed " + std::to_string(i);
+            std::string frame;
+            remote.seal(3, text.data(), text.size(), frame);
+            if (i == 25) {
+                std::string forged = frame;
+                forged[forged.size() - 1] ^= 1;
+                Daemon::Event bad;
+                bad.type = Daemon::EventType::DataReceived;
+                bad.peer_id = 3;
+                bad.data = forged;
+                daemon.enqueue_event(std::move(bad));
+            }
+            Daemon::Event event;
+            event.type = Daemon::EventType::DataReceived;
+            event.peer_id = 3;
+            event.data = frame;
+            daemon.enqueue_event(std::move(event));
+        }
+
+        wait_until([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return received.size() == 50;
+        });
+        bool in_order = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            in_order = received.size() == 50;
+            for (size_t i = 0; i < received.size() && in_order; ++i) {
+                in_order = received[i] == "sealed " + std::to_string(i);
+            }
+        }
+        check(in_order, "decrypted off the worker, delivered in order");
+        const IngressStats stats = daemon.ingress_stats();
+        check(stats.decoded == 50 && stats.dropped == 1, "forged frame dropped during ingress");
+        check(daemon.refused_count() == 1, "counted as refused");
+
+        daemon.stop();
+    }
+
+    std::cout << "\n[7] C API...\n";
+    meshcore* core = meshcore_create();
+    meshcore_ingress_stats stats;
+    check(meshcore_get_ingress_stats(core, &stats) == MESHCORE_OK && stats.decoded == 0, "stats");
+    check(meshcore_get_ingress_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats");
+    meshcore_destroy(core);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
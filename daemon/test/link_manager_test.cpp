@@ -0,0 +1,288 @@
+/**
+ * Link Manager Test
+ *
+ * Tests filling the link budget by quality, connect timeouts and
+ * backoff, ranking by activity and topology diversity, swaps with
+ * hysteresis and a minimum link age, shrinking the budget, then the
+ * recommendations from a running daemon and the C API.
+ */
+
+#include "link_manager.h"
+#include "daemon.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static DeviceId device(uint8_t n) {
+    DeviceId id{};
+    id[0] = n;
+    return id;
+}
+
+static DiscoveryChange found(uint8_t n, int32_t rssi) {
+    return DiscoveryChange{device(n), DiscoveryKind::Found, rssi, 0};
+}
+
+static bool has(const std::vector<LinkRecommendation>& out, uint8_t n, LinkAction action) {
+    for (const auto& r : out) {
+        if (r.id == device(n) && r.action == action) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main() {
+    std::cout << "=== Link Manager Test ===\n\n";
+
+    std::cout << "[1] Filling the budget...\n";
+    {
+        LinkConfig config;
+        config.max_links = 3;
+        LinkManager links(config);
+
+        links.on_discovery({found(1, -90), found(2, -50), found(3, -70), found(4, -60), found(5, -80)});
+        auto out = links.plan(1000);
+        check(out.size() == 3, "three connects for three slots");
+        check(has(out, 2, LinkAction::Connect) && has(out, 4, LinkAction::Connect) && has(out, 3, LinkAction::Connect),
+              "strongest three chosen");
+        check(out[0].id == device(2), "best first");
+        check(links.plan(1100).empty(), "pending connects hold their slots");
+
+        const LinkStats stats = links.stats();
+        check(stats.pending == 3 && stats.candidates == 2 && stats.connects == 3, "counters");
+    }
+
+    std::cout << "\n[2] Connect timeouts...\n";
+    {
+        LinkConfig config;
+        config.max_links = 2;
+        config.connect_timeout_ms = 1000;
+        config.retry_backoff_ms = 5000;
+        LinkManager links(config);
+
+        links.on_discovery({found(1, -50), found(2, -60), found(3, -70)});
+        links.plan(0);
+        links.bind(device(1), 101, 200);
+
+        auto out = links.plan(1500);
+        check(out.size() == 1 && has(out, 3, LinkAction::Connect), "unanswered connect replaced");
+        check(links.stats().timeouts == 1, "timeout counted");
+
+        links.bind(device(3), 103, 1600);
+        links.unbind(103);
+        out = links.plan(1700);
+        check(out.size() == 1 && has(out, 3, LinkAction::Connect), "device 2 rested, 3 retried");
+        links.bind(device(3), 103, 1800);
+        check(links.plan(6600).empty(), "full again");
+        links.unbind(103);
+        out = links.plan(6800);
+        check(has(out, 2, LinkAction::Connect), "device 2 retried after its backoff");
+    }
+
+    std::cout << "\n[3] Activity and diversity...\n";
+    {
+        LinkManager links;
+        links.on_discovery({found(1, -60), found(2, -60)});
+        links.bind(device(1), 11, 0);
+        links.bind(device(2), 12, 0);
+        for (int i = 0; i < 20; ++i) {
+            links.note_activity(11, 100 + i);
+        }
+        float chatty = 0;
+        float idle = 0;
+        links.score(device(1), 200, chatty);
+        links.score(device(2), 200, idle);
+        check(chatty > idle + 0.15f, "conversation activity raises the score");
+
+        float later = 0;
+        links.score(device(1), 200 + 10 * 60000, later);
+        check(later < idle + 0.01f, "activity decays");
+
+        // Device 2 already reaches 30 and 31; 3 reaches the same, 4 reaches new ones
+        links.set_neighbours(device(2), {device(30), device(31)});
+        links.set_neighbours(device(3), {device(30), device(31)});
+        links.set_neighbours(device(4), {device(40), device(41)});
+        links.on_discovery({found(3, -60), found(4, -60)});
+        float redundant = 0;
+        float diverse = 0;
+        links.score(device(3), 200, redundant);
+        links.score(device(4), 200, diverse);
+        check(diverse > redundant + 0.15f, "new neighbourhoods rank higher");
+
+        LinkConfig config;
+        config.max_links = 3;
+        links.set_config(config);
+        auto out = links.plan(200);
+        check(out.size() == 1 && has(out, 4, LinkAction::Connect), "free slot goes to the diverse candidate");
+    }
+
+    std::cout << "\n[4] Swaps...\n";
+    {
+        LinkConfig config;
+        config.max_links = 2;
+        config.min_link_ms = 10000;
+        config.switch_margin = 0.15f;
+        LinkManager links(config);
+
+        links.on_discovery({found(1, -60), found(2, -80)});
+        links.bind(device(1), 21, 0);
+        links.bind(device(2), 22, 0);
+
+        links.on_discovery({found(3, -75)});
+        check(links.plan(20000).empty(), "small gain: no swap");
+
+        links.on_discovery({found(4, -50)});
+        check(links.plan(5000).empty(), "young links are not evicted");
+
+        auto out = links.plan(20000);
+        check(out.size() == 2, "one swap");
+        check(has(out, 2, LinkAction::Disconnect) && has(out, 4, LinkAction::Connect), "worst link for best candidate");
+        check(out[0].peer_id == 22, "disconnect names the connection");
+        check(links.plan(20100).empty(), "no further churn");
+        check(links.stats().swaps == 1, "swap counted");
+
+        links.unbind(22);
+        links.bind(device(4), 24, 20200);
+        check(links.plan(20300).empty(), "settled on the new set");
+    }
+
+    std::cout << "\n[5] Shrinking the budget...\n";
+    {
+        LinkManager links;
+        links.on_discovery({found(1, -50), found(2, -60), found(3, -90)});
+        links.bind(device(1), 31, 0);
+        links.bind(device(2), 32, 0);
+        links.bind(device(3), 33, 0);
+
+        LinkConfig config;
+        config.max_links = 2;
+        links.set_config(config);
+        auto out = links.plan(100);
+        check(out.size() == 1 && has(out, 3, LinkAction::Disconnect) && out[0].peer_id == 33, "weakest link dropped");
+    }
+
+    std::cout << "\n[6] Daemon recommendations...\n";
+    {
+        // Daemon log lines are not part of the test output
+        std::ostringstream sink;
+        std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+
+        Daemon daemon;
+        LinkConfig config;
+        config.max_links = 1;
+        config.min_link_ms = 0;
+        daemon.set_link_config(config);
+
+        std::mutex mutex;
+        std::vector<LinkRecommendation> seen;
+        DaemonCallbacks callbacks;
+        callbacks.on_link = [&](const std::vector<LinkRecommendation>& recommendations) {
+            std::lock_guard<std::mutex> lock(mutex);
+            seen.insert(seen.end(), recommendations.begin(), recommendations.end());
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        const ScanReport reports[] = {
+            ScanReport{device(1), -60, now},
+            ScanReport{device(2), -70, now},
+        };
+        daemon.ingest_scans(reports, 2);
+
+        auto seen_count = [&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return seen.size();
+        };
+        const bool recommended = wait_until([&] { return seen_count() == 1; });
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            check(recommended && seen[0].id == device(1) && seen[0].action == LinkAction::Connect,
+                  "connect recommended for the best device");
+        }
+
+        Daemon::Event connect;
+        connect.type = Daemon::EventType::PeerConnected;
+        connect.peer_id = 41;
+        connect.peer_uid = "one@mesh";
+        daemon.enqueue_event(connect);
+        daemon.bind_link(device(1), 41);
+
+        Daemon::Event disconnect;
+        disconnect.type = Daemon::EventType::PeerDisconnected;
+        disconnect.peer_id = 41;
+        daemon.enqueue_event(disconnect);
+
+        const bool replanned = wait_until([&] { return seen_count() == 2; });
+        daemon.stop();
+        std::cout.rdbuf(saved);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        check(replanned && seen[1].id == device(1) && seen[1].action == LinkAction::Connect,
+              "the freed slot is planned again");
+    }
+
+    std::cout << "\n[7] C API...\n";
+    {
+        meshcore* core = meshcore_create();
+
+        meshcore_link_policy policy = {};
+        policy.max_links = 2;
+        policy.quality_weight = 1.0f;
+        policy.rssi_floor = -95;
+        policy.rssi_ceiling = -45;
+        policy.activity_scale = 8.0f;
+        policy.switch_margin = 0.15f;
+        policy.connect_timeout_ms = 5000;
+        check(meshcore_set_link_policy(core, &policy) == MESHCORE_OK, "policy set");
+        policy.rssi_ceiling = -100;
+        check(meshcore_set_link_policy(core, &policy) == MESHCORE_ERROR_INVALID_PARAM, "inverted RSSI range rejected");
+        check(meshcore_set_link_policy(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null policy rejected");
+
+        uint8_t id[MESHCORE_DEVICE_ID_SIZE] = {7};
+        uint8_t neighbours[2 * MESHCORE_DEVICE_ID_SIZE] = {0};
+        neighbours[0] = 8;
+        neighbours[MESHCORE_DEVICE_ID_SIZE] = 9;
+        check(meshcore_link_bind(core, id, 77) == MESHCORE_OK, "bound");
+        check(meshcore_link_bind(core, nullptr, 77) == MESHCORE_ERROR_INVALID_PARAM, "null identifier rejected");
+        check(meshcore_link_set_neighbours(core, id, neighbours, 2) == MESHCORE_OK, "neighbours set");
+        check(meshcore_link_set_neighbours(core, id, nullptr, 2) == MESHCORE_ERROR_INVALID_PARAM, "null neighbours rejected");
+
+        meshcore_link_stats stats;
+        check(meshcore_get_link_stats(core, &stats) == MESHCORE_OK, "stats read");
+        check(stats.links == 1 && stats.pending == 0, "one link");
+        check(meshcore_get_link_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+
+        meshcore_destroy(core);
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,262 @@
+/**
+ * Logger Test
+ *
+ * Tests argument encoding and formatting, truncation, redaction, the
+ * level threshold, a full ring dropping records, then the default
+ * daemon's log lines and the C API.
+ */
+
+#include "logger.h"
+#include "daemon.h"
+#include "meshcore.h"
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// Lines reaching the sink
+static std::mutex lines_mutex;
+static std::vector<std::pair<LogLevel, std::string>> lines;
+
+static void capture() {
+    AsyncLog::instance().set_sink([](LogLevel level, const char* line, size_t length) {
+        std::lock_guard<std::mutex> lock(lines_mutex);
+        lines.emplace_back(level, std::string(line, length));
+    });
+}
+
+static std::vector<std::pair<LogLevel, std::string>> take() {
+    AsyncLog::instance().flush();
+    std::lock_guard<std::mutex> lock(lines_mutex);
+    std::vector<std::pair<LogLevel, std::string>> taken;
+    taken.swap(lines);
+    return taken;
+}
+
+static bool contains(const std::vector<std::pair<LogLevel, std::string>>& taken, const std::string& needle) {
+    for (const auto& line : taken) {
+        if (line.second.find(needle) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::vector<std::string> api_lines;
+
+static void on_log(void* user_data, meshcore_log_level level, const char* line) {
+    (*static_cast<int*>(user_data))++;
+    if (level == MESHCORE_LOG_INFO) {
+        api_lines.push_back(line);
+    }
+}
+
+int main() {
+    std::cout << "=== Logger Test ===\n\n";
+    AsyncLog& log = AsyncLog::instance();
+    capture();
+
+    std::cout << "[1] Encoding...\n";
+    {
+        const std::string name = "node-7";
+        const char* owned = "copied";
+        log.write(LogLevel::Info, "peer ", uint64_t(42), " rssi ", -71, " ratio ", 0.5, " ", name, " ", owned,
+                  " ", true, ' ', 'x');
+        const auto taken = take();
+        check(taken.size() == 1, "one line");
+        check(!taken.empty() && taken[0].first == LogLevel::Info, "level carried");
+        check(!taken.empty() && taken[0].second == "peer 42 rssi -71 ratio 0.5 node-7 copied true x",
+              "arguments formatted");
+
+        // Overwritten before the logging thread gets to it
+        char buffer[16] = "stage-a";
+        log.write(LogLevel::Info, literal("buffer "), buffer);
+        std::memset(buffer, 'X', sizeof(buffer));
+        log.write(LogLevel::Info, buffer);
+        const auto copied = take();
+        check(copied.size() == 2 && copied[0].second == "buffer stage-a", "char arrays copied, literal() kept");
+        check(copied.size() == 2 && copied[1].second == std::string(sizeof(buffer), 'X'), "unterminated array cut at its size");
+    }
+
+    std::cout << "\n[2] Truncation...\n";
+    {
+        const LogStats before = log.stats();
+        log.write(LogLevel::Info, "long ", std::string(200, 'a'));
+        log.write(LogLevel::Info, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+                  21, 22, 23, 24, 25, 26, 27, 28);
+        const auto taken = take();
+        check(taken.size() == 2, "both written");
+        check(taken.size() == 2 && taken[0].second == "long " + std::string(AsyncLog::kMaxString, 'a') + "...",
+              "string cut at kMaxString");
+        check(taken.size() == 2 && taken[1].second.find("24...") != std::string::npos, "record cut at kDataSize");
+        check(log.stats().truncated - before.truncated == 2, "truncations counted");
+    }
+
+    std::cout << "\n[3] Redaction and levels...\n";
+    {
+        const std::string body = "meet at the north gate";
+        log.write(LogLevel::Info, "body: ", sensitive(body));
+        LogControl::set_redaction(false);
+        log.write(LogLevel::Info, "body: ", sensitive(body));
+        LogControl::set_redaction(true);
+        auto taken = take();
+        check(taken.size() == 2 && taken[0].second == "body: <22 bytes>", "redacted by default");
+        check(taken.size() == 2 && taken[1].second == "body: " + body, "shown with redaction off");
+
+        check(LogControl::level() == LogLevel::Info, "Info by default");
+        check(!LogControl::enabled(LogLevel::Debug) && LogControl::enabled(LogLevel::Error), "threshold");
+        LogControl::set_level(LogLevel::Off);
+        check(!LogControl::enabled(LogLevel::Error), "Off disables everything");
+        LogControl::set_level(LogLevel::Info);
+
+        std::ostringstream out;
+        std::streambuf* saved = std::cout.rdbuf(out.rdbuf());
+        StdoutLogger::write(LogLevel::Info, "body: ", sensitive(body), " from ", 3);
+        std::cout.rdbuf(saved);
+        check(out.str() == "body: <22 bytes> from 3\n", "StdoutLogger redacts too");
+    }
+
+    std::cout << "\n[4] Full ring...\n";
+    {
+        // Hold the logging thread in the sink so nothing drains
+        std::atomic<bool> entered(false);
+        std::atomic<bool> release(false);
+        log.set_sink([&](LogLevel level, const char* line, size_t length) {
+            entered = true;
+            while (!release) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            std::lock_guard<std::mutex> lock(lines_mutex);
+            lines.emplace_back(level, std::string(line, length));
+        });
+        log.write(LogLevel::Info, "block");
+        wait_until([&] { return entered.load(); });
+
+        const LogStats before = log.stats();
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < AsyncLog::kCapacity + 76; ++i) {
+            log.write(LogLevel::Info, "record ", i);
+        }
+        const double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()) / double(AsyncLog::kCapacity + 76);
+        std::cout << "    " << ns << " ns per log call\n";
+        check(log.stats().dropped - before.dropped == 76, "overflow dropped, not blocked");
+
+        release = true;
+        const auto taken = take();
+        capture();
+        check(log.stats().written - before.written == AsyncLog::kCapacity + 1, "ring drained after the stall");
+        check(taken.size() == AsyncLog::kCapacity + 1 && taken.back().second == "record 1023",
+              "oldest kept, in order");
+    }
+
+    std::cout << "\n[5] Many writers...\n";
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&log, t] {
+                for (int i = 0; i < 200; ++i) {
+                    log.write(LogLevel::Warn, "writer ", t, " line ", i);
+                    if (i % 50 == 0) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const auto taken = take();
+        check(taken.size() == 800, "every line written");
+        check(contains(taken, "writer 3 line 199"), "lines intact");
+    }
+
+    std::cout << "\n[6] Daemon log lines...\n";
+    {
+        Daemon daemon;
+        std::atomic<int> delivered(0);
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) { delivered++; };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        Daemon::Event connect;
+        connect.type = Daemon::EventType::PeerConnected;
+        connect.peer_id = 61;
+        connect.peer_uid = "logged@mesh";
+        daemon.enqueue_event(connect);
+
+        Daemon::Event data;
+        data.type = Daemon::EventType::DataReceived;
+        data.peer_id = 61;
+        data.data = "private words";
+        daemon.enqueue_event(data);
+        wait_until([&] { return delivered == 1; });
+        auto taken = take();
+        check(contains(taken, "[Daemon] Peer connected: 61 (uid: logged@mesh)"), "Info line written");
+        check(!contains(taken, "Data received"), "Debug line skipped at Info");
+
+        LogControl::set_level(LogLevel::Debug);
+        daemon.enqueue_event(data);
+        wait_until([&] { return delivered == 2; });
+        taken = take();
+        check(contains(taken, "[Daemon] Data received from peer 61: <13 bytes>"), "Debug line written");
+        check(!contains(taken, "private words"), "payload redacted");
+        LogControl::set_level(LogLevel::Info);
+
+        daemon.stop();
+    }
+
+    std::cout << "\n[7] C API...\n";
+    {
+        int calls = 0;
+        meshcore_set_log_callback(on_log, &calls);
+        check(meshcore_set_log_level(MESHCORE_LOG_WARN) == MESHCORE_OK, "level set");
+        check(LogControl::level() == LogLevel::Warn, "level applied");
+        check(meshcore_set_log_level(meshcore_log_level(9)) == MESHCORE_ERROR_INVALID_PARAM, "bad level rejected");
+        meshcore_set_log_level(MESHCORE_LOG_INFO);
+
+        meshcore_set_log_redaction(false);
+        const std::string body = "plain";
+        log.write(LogLevel::Info, "api ", sensitive(body));
+        meshcore_set_log_redaction(true);
+        meshcore_flush_log();
+        check(calls == 1 && api_lines.size() == 1 && api_lines[0] == "api plain", "callback receives lines");
+
+        meshcore_log_stats stats;
+        check(meshcore_get_log_stats(&stats) == MESHCORE_OK && stats.written > 0 && stats.dropped == 76,
+              "stats read");
+        check(meshcore_get_log_stats(nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+
+        meshcore_set_log_callback(nullptr, nullptr);
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+/**
+ * Message Store Test
+ *
+ * Tests persistence, retention policies and time-sliced compaction.
+ */
+
+#include "message_store.h"
+#include <iostream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+int main() {
+    std::cout << "=== Message Store Test ===\n\n";
+
+    const std::string dir =
+        (std::filesystem::temp_directory_path() / "meshcore_message_store_test").string();
+    std::filesystem::remove_all(dir);
+
+    const int64_t now = 1700000000000;
+    const std::string body(1000, 'x');
+
+    // Fill several segments
+    std::cout << "[1] Appending messages...\n";
+    {
+        MessageStore store;
+        check(store.open(dir), "store opens");
+
+        for (int i = 0; i < 2000; ++i) {
+            store.append("alice", MessageDirection::Inbound, now - 10000 + i, body);
+        }
+        for (int i = 0; i < 1000; ++i) {
+            // First half is older than a minute
+            int64_t ts = i < 500 ? now - 120000 : now;
+            store.append("bob", MessageDirection::Outbound, ts, body);
+        }
+        // Imported history: old messages behind newer ones in seq order
+        for (int i = 0; i < 6; ++i) {
+            store.append("dave", MessageDirection::Inbound, i % 2 ? now - 120000 : now, body);
+        }
+        uint64_t doomed = store.append("carol", MessageDirection::Inbound, now, "secret", now - 1);
+        store.append("carol", MessageDirection::Inbound, now, "keep me");
+        uint64_t deleted = store.append("carol", MessageDirection::Inbound, now, "delete me");
+        check(doomed != 0 && deleted != 0, "append returns sequence numbers");
+        check(store.remove("carol", deleted), "explicit delete");
+
+        check(store.message_count("alice") == 2000, "alice has 2000 messages");
+        check(store.compaction_stats().disk_bytes > 2 * MessageStore::kSegmentBytes,
+              "log spans several segments");
+    }
+
+    // Retention + compaction in small steps
+    std::cout << "\n[2] Applying retention and compacting...\n";
+    {
+        MessageStore store;
+        check(store.open(dir), "store reopens");
+        check(store.message_count("carol") == 2, "delete survived restart");
+
+        RetentionPolicy keep_100;
+        keep_100.max_count = 100;
+        store.set_policy("alice", keep_100);
+
+        RetentionPolicy one_minute;
+        one_minute.max_age_ms = 60000;
+        store.set_policy("bob", one_minute);
+        store.set_policy("dave", one_minute);
+
+        int steps = 0;
+        while (store.compact_step(std::chrono::microseconds(500), now) && steps < 100000) {
+            steps++;
+        }
+
+        CompactionStats stats = store.compaction_stats();
+        std::cout << "    steps: " << steps
+                  << ", reclaimed: " << stats.bytes_reclaimed
+                  << ", dropped: " << stats.records_dropped
+                  << ", on disk: " << stats.disk_bytes << "\n";
+
+        check(store.message_count("alice") == 100, "alice capped at 100");
+        check(store.message_count("bob") == 500, "bob keeps last minute");
+        check(store.message_count("dave") == 3, "expired messages behind newer ones dropped");
+        check(store.message_count("carol") == 1, "expired message dropped");
+        check(stats.bytes_reclaimed > MessageStore::kSegmentBytes, "bytes reclaimed reported");
+        check(steps > 1, "compaction was split into slices");
+
+        std::vector<StoredMessage> alice;
+        store.load_conversation("alice", alice);
+        check(alice.size() == 100 && alice.back().body == body, "alice history readable");
+        check(alice.front().timestamp == now - 10000 + 1900, "oldest alice messages dropped");
+    }
+
+    // Everything must still be consistent after restart
+    std::cout << "\n[3] Reopening compacted store...\n";
+    {
+        MessageStore store;
+        check(store.open(dir), "store reopens after compaction");
+        check(store.message_count("alice") == 100, "alice count persisted");
+        check(store.message_count("bob") == 500, "bob count persisted");
+        check(store.message_count("dave") == 3, "dave count persisted");
+
+        std::vector<StoredMessage> carol;
+        store.load_conversation("carol", carol);
+        check(carol.size() == 1 && carol[0].body == "keep me", "carol history persisted");
+
+        uint64_t seq = store.append("alice", MessageDirection::Inbound, now, "new");
+        check(seq > 3009, "sequence numbers keep increasing");
+
+        check(store.remove_conversation("bob"), "conversation delete");
+        check(store.message_count("bob") == 0, "bob is empty");
+    }
+
+    std::filesystem::remove_all(dir);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
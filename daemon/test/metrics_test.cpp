@@ -0,0 +1,237 @@
+/**
+ * Metrics Test
+ *
+ * Tests histogram bucketing and percentiles, per-thread counters under
+ * contention, the queue-depth gauge, then the metrics of a running
+ * daemon and the C API.
+ */
+
+#include "metrics.h"
+#include "daemon.h"
+#include "meshcore.h"
+#include "transport.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// Counts what the daemon hands it
+class CountingTransport : public Transport {
+public:
+    void send(uint64_t, const std::string&) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sent_++;
+    }
+
+    int sent() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sent_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    int sent_ = 0;
+};
+
+int main() {
+    std::cout << "=== Metrics Test ===\n\n";
+
+    std::cout << "[1] Bucketing...\n";
+    {
+        bool exact = true;
+        for (uint64_t v = 0; v < Metrics::kSubBuckets; ++v) {
+            exact = exact && Metrics::bucket_max(Metrics::bucket_of(v)) == v;
+        }
+        check(exact, "small values exact");
+
+        bool bounded = true;
+        bool monotonic = true;
+        size_t last = 0;
+        for (uint64_t v = 1; v < (uint64_t(1) << 40); v += v / 7 + 1) {
+            const size_t bucket = Metrics::bucket_of(v);
+            const uint64_t max = Metrics::bucket_max(bucket);
+            bounded = bounded && max >= v && double(max - v) <= double(v) * 0.0625;
+            monotonic = monotonic && bucket >= last;
+            last = bucket;
+        }
+        check(bounded, "bucket bound within 6.25% of the value");
+        check(monotonic, "buckets ordered by value");
+        check(Metrics::bucket_of(UINT64_MAX) == Metrics::kBuckets - 1, "largest value fits");
+        check(Metrics::bucket_max(Metrics::kBuckets - 1) == UINT64_MAX, "last bucket ends at the top");
+    }
+
+    std::cout << "\n[2] Percentiles...\n";
+    {
+        Metrics metrics;
+        for (uint64_t ns = 1; ns <= 1000; ++ns) {
+            metrics.record(Timing::Handler, ns * 1000);
+        }
+        const LatencySummary s = metrics.snapshot().timing(Timing::Handler);
+
+        check(s.count == 1000, "every record counted");
+        check(s.total_ns == 500500000, "total exact");
+        check(s.max_ns == 1000000, "max exact");
+        check(s.p50_ns >= 500000 && s.p50_ns <= 532000, "p50 within a bucket");
+        check(s.p90_ns >= 900000 && s.p90_ns <= 957000, "p90 within a bucket");
+        check(s.p99_ns >= 990000 && s.p99_ns <= 1053000, "p99 within a bucket");
+
+        const LatencySummary empty = metrics.snapshot().timing(Timing::Callback);
+        check(empty.count == 0 && empty.p99_ns == 0 && empty.max_ns == 0, "untouched histogram empty");
+    }
+
+    std::cout << "\n[3] Counters across threads...\n";
+    {
+        Metrics metrics;
+        const int kThreads = 8;
+        const int kAdds = 200000;
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < kThreads; ++i) {
+            threads.emplace_back([&metrics] {
+                for (int n = 0; n < kAdds; ++n) {
+                    metrics.add(Counter::FramesSent);
+                    metrics.add(Counter::BytesSent, 3);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const double elapsed_ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        const MetricsSnapshot s = metrics.snapshot();
+        check(s.counter(Counter::FramesSent) == uint64_t(kThreads) * kAdds, "no adds lost");
+        check(s.counter(Counter::BytesSent) == uint64_t(kThreads) * kAdds * 3, "amounts added");
+
+        Metrics single;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int n = 0; n < 1000000; ++n) {
+            single.record(Timing::QueueWait, uint64_t(n & 0xffff));
+        }
+        const double per_record = double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count()) / 1000000.0;
+        std::cout << "    " << elapsed_ns / (2.0 * kThreads * kAdds) << " ns per add (8 threads, wall), "
+                  << per_record << " ns per record\n";
+        check(single.snapshot().timing(Timing::QueueWait).count == 1000000, "records counted");
+    }
+
+    std::cout << "\n[4] Queue depth gauge...\n";
+    {
+        Metrics metrics;
+        metrics.set_queue_depth(3);
+        metrics.set_queue_depth(40);
+        metrics.set_queue_depth(7);
+        const MetricsSnapshot s = metrics.snapshot();
+        check(s.queue_depth == 7, "current depth");
+        check(s.queue_depth_max == 40, "high-water mark kept");
+    }
+
+    std::cout << "\n[5] Daemon metrics...\n";
+    {
+        // Daemon log lines are not part of the test output
+        std::ostringstream sink;
+        std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+
+        Daemon daemon;
+        CountingTransport transport;
+        daemon.set_transport(&transport);
+
+        std::mutex mutex;
+        int delivered = 0;
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) {
+            std::lock_guard<std::mutex> lock(mutex);
+            delivered++;
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        Daemon::Event connect;
+        connect.type = Daemon::EventType::PeerConnected;
+        connect.peer_id = 71;
+        connect.peer_uid = "measured@mesh";
+        daemon.enqueue_event(connect);
+
+        for (int i = 0; i < 50; ++i) {
+            Daemon::Event data;
+            data.type = Daemon::EventType::DataReceived;
+            data.peer_id = 71;
+            data.data = "msg " + std::to_string(i);
+            daemon.enqueue_event(data);
+        }
+        for (int i = 0; i < 10; ++i) {
+            Daemon::Event send;
+            send.type = Daemon::EventType::SendMessage;
+            send.peer_id = 71;
+            send.data = "out " + std::to_string(i);
+            daemon.enqueue_event(send);
+        }
+
+        const bool received = wait_until([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return delivered == 50;
+        });
+        const bool sent = wait_until([&] { return transport.sent() == 10; });
+        const bool settled = wait_until([&] {
+            const MetricsSnapshot s = daemon.metrics();
+            return s.counter(Counter::EventsDispatched) == s.counter(Counter::EventsQueued);
+        });
+        const MetricsSnapshot s = daemon.metrics();
+
+        daemon.stop();
+        std::cout.rdbuf(saved);
+
+        check(received && sent && settled, "traffic processed");
+        check(s.counter(Counter::MessagesDelivered) == 50, "deliveries counted");
+        check(s.counter(Counter::FramesSent) == 10 && s.counter(Counter::BytesSent) > 0, "sends counted");
+        check(s.counter(Counter::Batches) > 0 && s.counter(Counter::Batches) <= s.counter(Counter::EventsDispatched),
+              "batches counted");
+        check(s.timing(Timing::QueueWait).count == s.counter(Counter::EventsDispatched), "a queue wait per event");
+        check(s.timing(Timing::Callback).count >= 50, "callbacks timed");
+        check(s.timing(Timing::TransportSend).count == 10, "sends timed");
+        check(s.timing(Timing::Handler).count > 0 && s.timing(Timing::Handler).p50_ns > 0, "handlers timed");
+        check(s.queue_depth_max > 0, "queue depth seen");
+    }
+
+    std::cout << "\n[6] C API...\n";
+    {
+        meshcore* core = meshcore_create();
+
+        meshcore_stats stats;
+        check(meshcore_get_stats(core, &stats) == MESHCORE_OK, "stats read");
+        check(stats.events_dispatched <= stats.events_queued, "consistent counters");
+        check(meshcore_get_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+        check(meshcore_get_stats(nullptr, &stats) == MESHCORE_ERROR_UNKNOWN, "null core rejected");
+
+        meshcore_destroy(core);
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
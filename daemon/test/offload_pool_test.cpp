@@ -0,0 +1,280 @@
+/**
+ * Offload Pool Test
+ *
+ * Tests job completion, per-key ordering, the in-flight bound, work
+ * stealing, and that the daemon keeps handling traffic while a slow job
+ * runs.
+ */
+
+#include "offload_pool.h"
+#include "daemon.h"
+#include "signature_verifier.h"
+#include "chunk_store.h"
+#include "frame.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Offload Pool Test ===\n\n";
+
+    std::cout << "[1] Completion...\n";
+    {
+        std::atomic<int> ran(0);
+        std::atomic<int> posted(0);
+        OffloadPool pool(OffloadConfig(), [&](uint64_t, OffloadPool::Continuation&& c) {
+            c();
+            posted++;
+        });
+        for (int i = 0; i < 100; ++i) {
+            pool.submit(0, [&, i]() -> OffloadPool::Continuation {
+                ran++;
+                if (i % 2) {
+                    return nullptr;
+                }
+                return [] {};
+            });
+        }
+        check(wait_until([&] { return pool.stats().completed == 100; }), "all jobs completed");
+        check(ran == 100 && posted == 50, "only non-empty continuations posted");
+    }
+
+    std::cout << "\n[2] Per-key ordering...\n";
+    {
+        std::mutex mutex;
+        std::map<uint64_t, std::vector<int>> order;
+        std::atomic<int> overlaps(0);
+        std::atomic<int> running[5] = {};
+
+        OffloadConfig config;
+        config.threads = 4;
+        OffloadPool pool(config, [&](uint64_t key, OffloadPool::Continuation&& c) {
+            std::lock_guard<std::mutex> lock(mutex);
+            c();
+            (void)key;
+        });
+        for (int i = 0; i < 200; ++i) {
+            const uint64_t key = 1 + i % 4;
+            pool.submit(key, [&, key, i]() -> OffloadPool::Continuation {
+                if (running[key]++ != 0) {
+                    overlaps++;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds((i * 37) % 200));
+                running[key]--;
+                return [&, key, i] { order[key].push_back(i); };
+            });
+        }
+        wait_until([&] { return pool.stats().completed == 200; });
+
+        bool in_order = order.size() == 4;
+        for (const auto& pair : order) {
+            in_order = in_order && pair.second.size() == 50;
+            for (size_t j = 1; j < pair.second.size(); ++j) {
+                in_order = in_order && pair.second[j - 1] < pair.second[j];
+            }
+        }
+        check(overlaps == 0, "a key never runs two jobs at once");
+        check(in_order, "continuations posted in submission order per key");
+    }
+
+    std::cout << "\n[3] Bounded...\n";
+    {
+        std::atomic<bool> release(false);
+        OffloadConfig config;
+        config.threads = 1;
+        config.capacity = 4;
+        OffloadPool pool(config, nullptr);
+
+        auto blocker = [&]() -> OffloadPool::Continuation {
+            while (!release) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return nullptr;
+        };
+        for (int i = 0; i < 4; ++i) {
+            check(pool.try_submit(0, blocker), i == 0 ? "accepted up to capacity" : "accepted");
+        }
+        check(!pool.try_submit(0, blocker), "refused when full");
+
+        std::atomic<bool> submitted(false);
+        std::thread producer([&] {
+            pool.submit(0, [] { return OffloadPool::Continuation(); });
+            submitted = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        check(!submitted, "submit blocks while full");
+        release = true;
+        producer.join();
+        check(submitted && wait_until([&] { return pool.stats().completed == 5; }), "unblocked once jobs finish");
+        check(pool.stats().blocked == 1 && pool.stats().rejected == 1 && pool.stats().max_in_flight == 4, "stats");
+    }
+
+    std::cout << "\n[4] Nested submission and stealing...\n";
+    {
+        OffloadConfig config;
+        config.threads = 2;
+        config.capacity = 2;
+        OffloadPool* self = nullptr;
+        std::atomic<int> children(0);
+        OffloadPool pool(config, nullptr);
+        self = &pool;
+
+        // The job fans out past the bound onto its own worker's deque while
+        // it keeps running; the other worker has to steal to help
+        {
+            pool.submit(0, [&]() -> OffloadPool::Continuation {
+                for (int c = 0; c < 32; ++c) {
+                    self->submit(0, [&]() -> OffloadPool::Continuation {
+                        std::this_thread::sleep_for(std::chrono::microseconds(200));
+                        children++;
+                        return nullptr;
+                    });
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                return nullptr;
+            });
+        }
+        check(wait_until([&] { return children == 32; }), "jobs submitted from the pool never block");
+        check(pool.stats().stolen > 0, "idle worker steals queued work");
+    }
+
+    std::cout << "\n[5] Daemon...\n";
+    {
+        Daemon daemon;
+        std::atomic<int> received(0);
+        std::thread::id message_thread;
+        std::mutex order_mutex;
+        std::vector<std::string> order;
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string& message, int64_t) {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            message_thread = std::this_thread::get_id();
+            order.push_back(message);
+            received++;
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        Daemon::Event connect;
+        connect.type = Daemon::EventType::PeerConnected;
+        connect.peer_id = 7;
+        connect.peer_uid = "peer-7";
+        daemon.enqueue_event(std::move(connect));
+
+        std::atomic<bool> slow_done(false);
+        std::thread::id continuation_thread;
+        const auto t0 = std::chrono::steady_clock::now();
+        check(daemon.offload(7, [&]() -> OffloadPool::Continuation {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            return [&] {
+                continuation_thread = std::this_thread::get_id();
+                slow_done = true;
+            };
+        }), "job accepted");
+
+        Daemon::Event chat;
+        chat.type = Daemon::EventType::DataReceived;
+        chat.peer_id = 7;
+        chat.data = "not stuck";
+        daemon.enqueue_event(std::move(chat));
+        wait_until([&] { return received == 1; });
+        const auto waited = std::chrono::steady_clock::now() - t0;
+        check(received == 1 && waited < std::chrono::milliseconds(200), "traffic flows while the job runs");
+
+        check(wait_until([&] { return slow_done.load(); }), "continuation ran");
+        check(continuation_thread == message_thread, "on the worker thread");
+
+        // Signed frames verified inline go through the pool, in order
+        uint8_t seed[32] = { 9 };
+        const SigningKey key = SigningKey::from_seed(seed);
+        {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.clear();
+        }
+        for (int i = 0; i < 20; ++i) {
+            Daemon::Event signed_chat;
+            signed_chat.type = Daemon::EventType::DataReceived;
+            signed_chat.peer_id = 7;
+            signed_chat.data = SignatureVerifier::sign_frame(key, "m" + std::to_string(i));
+            daemon.enqueue_event(std::move(signed_chat));
+        }
+        wait_until([&] { return received == 21; });
+        bool in_order = true;
+        {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            in_order = order.size() == 20;
+            for (int i = 0; i < 20 && in_order; ++i) {
+                in_order = order[i] == "m" + std::to_string(i);
+            }
+        }
+        check(in_order, "signed messages delivered in order");
+        check(daemon.offload_stats().completed > 1, "verified on the pool");
+
+        // A full pool refuses attachment frames instead of stalling the worker
+        ChunkStore store;
+        daemon.set_chunk_store(&store);
+        std::atomic<bool> release(false);
+        wait_until([&] { return daemon.offload_stats().completed == daemon.offload_stats().submitted; });
+        for (size_t i = 0; i < OffloadConfig().capacity; ++i) {
+            daemon.offload(100 + i, [&]() -> OffloadPool::Continuation {
+                while (!release) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                return nullptr;
+            });
+        }
+        const uint64_t refused = daemon.refused_count();
+        Daemon::Event offer;
+        offer.type = Daemon::EventType::DataDecoded;   // Past ingress, which needs the pool too
+        offer.peer_id = 7;
+        offer.data = make_frame(FrameType::ChunkOffer, "manifest");
+        daemon.enqueue_event(std::move(offer));
+        check(wait_until([&] { return daemon.refused_count() == refused + 1; }), "attachment frame refused");
+        check(daemon.offload_stats().rejected == 1, "counted");
+        release = true;
+        check(wait_until([&] { return daemon.offload_stats().completed == daemon.offload_stats().submitted; }),
+              "pool drains");
+        daemon.set_chunk_store(nullptr);
+
+        daemon.stop();
+        check(!daemon.offload(1, [] { return OffloadPool::Continuation(); }), "refused when stopped");
+    }
+
+    std::cout << "\n[6] C API...\n";
+    meshcore* core = meshcore_create();
+    meshcore_offload_stats stats;
+    check(meshcore_get_offload_stats(core, &stats) == MESHCORE_OK && stats.submitted == 0, "stats");
+    check(meshcore_get_offload_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats");
+    meshcore_destroy(core);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
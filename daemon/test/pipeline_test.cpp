@@ -0,0 +1,290 @@
+/**
+ * Pipeline Test
+ *
+ * Tests stage composition and timing, the daemon's default stages, a
+ * custom stage, a relay configuration without storage/UI stages, and
+ * batched persistence.
+ */
+
+#include "pipeline.h"
+#include "daemon.h"
+#include "message_store.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static void receive(Daemon& daemon, uint64_t peer_id, const std::string& text) {
+    Daemon::Event event;
+    event.type = Daemon::EventType::DataReceived;
+    event.peer_id = peer_id;
+    event.data = text;
+    daemon.enqueue_event(std::move(event));
+}
+
+// Keeps the worker busy so the next events queue up into one batch
+static void stall_worker(Daemon& daemon, int ms) {
+    Daemon::Event event;
+    event.type = Daemon::EventType::OffloadComplete;
+    event.completion = [ms] { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); };
+    daemon.enqueue_event(std::move(event));
+}
+
+static const StageStats* find_stage(const std::vector<StageStats>& stats, const std::string& name) {
+    for (const auto& s : stats) {
+        if (s.name == name) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+int main() {
+    std::cout << "=== Pipeline Test ===\n\n";
+
+    const std::filesystem::path root =
+        std::filesystem::temp_directory_path() / "meshcore_pipeline_test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+
+    std::cout << "[1] Composition...\n";
+    {
+        Pipeline<int> pipeline;
+        std::vector<int> seen;
+        check(pipeline.add(make_stage<int>("double", [](int& v) { v *= 2; return true; })), "stage added");
+        check(pipeline.add(make_stage<int>("odd", [](int& v) { return v % 2 == 1; }), "double"), "inserted before");
+        check(pipeline.add(make_stage<int>("tail", [&](int& v) { seen.push_back(v); return true; })), "appended");
+        check(!pipeline.add(make_stage<int>("odd", [](int&) { return true; })), "duplicate name refused");
+        check(!pipeline.add(make_stage<int>("x", [](int&) { return true; }), "missing"), "unknown anchor refused");
+        check(pipeline.stage_names() == std::vector<std::string>({ "odd", "double", "tail" }), "order");
+
+        std::vector<int> batch = { 1, 2, 3, 4 };
+        pipeline.run(batch);
+        check(seen == std::vector<int>({ 2, 6 }) && batch == seen, "events dropped by a stage go no further");
+
+        const std::vector<StageStats> stats = pipeline.stats();
+        check(stats[0].batches == 1 && stats[0].events == 4 && stats[1].events == 2, "per-stage counts");
+
+        check(pipeline.remove("odd") && !pipeline.remove("odd"), "removed");
+        std::vector<int> empty_out = { 1 };
+        pipeline.add(make_stage<int>("drop", [](int&) { return false; }), "double");
+        pipeline.run(empty_out);
+        check(pipeline.stats()[1].batches == 1, "empty batch stops the run");
+
+        // Stages run unlocked: one may inspect and change its own pipeline
+        Pipeline<int> reentrant;
+        size_t stages_seen = 0;
+        reentrant.add(make_stage<int>("first", [&](int&) {
+            stages_seen = reentrant.stats().size();
+            reentrant.remove("first");
+            return reentrant.add(make_stage<int>("late", [](int&) { return true; }));
+        }));
+        reentrant.add(make_stage<int>("second", [](int&) { return true; }));
+        std::vector<int> once = { 1 };
+        reentrant.run(once);
+        check(stages_seen == 2 && once.size() == 1 && reentrant.stats()[0].batches == 1,
+              "a stage may call back into its pipeline");
+        check(reentrant.stage_names() == std::vector<std::string>({ "second", "late" }), "changes apply from the next run");
+    }
+
+    std::cout << "\n[2] Daemon stages...\n";
+    {
+        Daemon daemon;
+        check(daemon.stage_names(Daemon::Direction::Inbound) ==
+              std::vector<std::string>({ "control", "decode", "frames", "peers", "store", "conversations", "ui" }),
+              "inbound defaults");
+        check(daemon.stage_names(Daemon::Direction::Outbound) ==
+              std::vector<std::string>({ "send", "store", "conversations" }), "outbound defaults");
+
+        // A deployment-specific dedup stage before anything is recorded
+        auto seen = std::make_shared<std::set<std::string>>();
+        check(daemon.add_stage(Daemon::Direction::Inbound,
+                               make_stage<Daemon::Event>("dedup", [seen](Daemon::Event& event) {
+                                   return seen->insert(event.data).second;
+                               }), "peers"), "custom stage added");
+
+        std::atomic<int> received(0);
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) { received++; };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        stall_worker(daemon, 50);
+        for (int i = 0; i < 20; ++i) {
+            receive(daemon, 1, "m" + std::to_string(i % 10));
+        }
+        wait_until([&] { return received == 10; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        check(received == 10, "duplicates dropped by the custom stage");
+
+        const std::vector<StageStats> stats = daemon.stage_stats(Daemon::Direction::Inbound);
+        const StageStats* ui = find_stage(stats, "ui");
+        const StageStats* control = find_stage(stats, "control");
+        check(ui && ui->events == 10 && ui->batches < 10, "messages processed in batches");
+        check(control && control->max_ns >= 50000000ull, "slow stage shows in its timing");
+
+        daemon.stop();
+    }
+
+    std::cout << "\n[3] Relay configuration...\n";
+    {
+        MessageStore store;
+        store.open((root / "relay").string());
+
+        Daemon daemon;
+        daemon.set_message_store(&store);
+        for (const char* name : { "store", "conversations", "ui" }) {
+            daemon.remove_stage(Daemon::Direction::Inbound, name);
+            daemon.remove_stage(Daemon::Direction::Outbound, name);
+        }
+
+        std::atomic<int> received(0);
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) { received++; };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        Daemon::Event connect;
+        connect.type = Daemon::EventType::PeerConnected;
+        connect.peer_id = 4;
+        connect.peer_uid = "relay-peer";
+        daemon.enqueue_event(std::move(connect));
+        receive(daemon, 4, "passing through");
+
+        Daemon::Event send;
+        send.type = Daemon::EventType::SendMessage;
+        send.peer_id = 4;
+        send.data = "forwarded";
+        daemon.enqueue_event(std::move(send));
+
+        wait_until([&] {
+            const auto stats = daemon.stage_stats(Daemon::Direction::Outbound);
+            return !stats.empty() && stats[0].events == 1;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        check(received == 0, "no UI callbacks");
+        check(daemon.conversations().all().empty(), "no conversation summaries");
+        check(store.message_count("relay-peer") == 0, "nothing persisted");
+        const auto peers = daemon.known_peers();
+        check(peers.size() == 1 && peers[0].rx_seq == 1 && peers[0].tx_seq == 1, "peer bookkeeping still runs");
+
+        // A send by UID queues behind earlier sends and runs on the worker
+        std::mutex mutex;
+        std::vector<std::string> order;
+        bool on_caller = false;
+        const std::thread::id caller = std::this_thread::get_id();
+        daemon.add_stage(Daemon::Direction::Outbound,
+                         make_stage<Daemon::Event>("order", [&](Daemon::Event& event) {
+                             std::lock_guard<std::mutex> lock(mutex);
+                             order.push_back(event.data);
+                             on_caller = on_caller || std::this_thread::get_id() == caller;
+                             return true;
+                         }), "send");
+        stall_worker(daemon, 30);
+        Daemon::Event queued;
+        queued.type = Daemon::EventType::SendMessage;
+        queued.peer_id = 4;
+        queued.data = "queued";
+        daemon.enqueue_event(std::move(queued));
+        daemon.send_to_uid("relay-peer", "by uid");
+        wait_until([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return order.size() == 2;
+        });
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            check(order == std::vector<std::string>({ "queued", "by uid" }) && !on_caller,
+                  "send by UID keeps its place, on the worker");
+        }
+
+        daemon.stop();
+        store.close();
+    }
+
+    std::cout << "\n[4] Batched persistence...\n";
+    {
+        MessageStore store;
+        store.open((root / "full").string());
+
+        Daemon daemon;
+        daemon.set_message_store(&store);
+        std::atomic<int> received(0);
+        std::atomic<bool> stored_first(true);
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string& message, int64_t) {
+            const size_t index = std::stoul(message.substr(7));
+            if (store.message_count("peer:9") < index + 1) {
+                stored_first = false;
+            }
+            received++;
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        stall_worker(daemon, 30);
+        for (int i = 0; i < 25; ++i) {
+            receive(daemon, 9, "stored " + std::to_string(i));
+        }
+        wait_until([&] { return received == 25; });
+
+        std::vector<StoredMessage> messages;
+        store.load_conversation("peer:9", messages);
+        bool in_order = messages.size() == 25;
+        for (size_t i = 0; i < messages.size() && in_order; ++i) {
+            in_order = messages[i].body == "stored " + std::to_string(i);
+        }
+        check(in_order, "every message persisted in order");
+        check(stored_first, "persisted before the UI is told");
+        const std::vector<StageStats> stats = daemon.stage_stats(Daemon::Direction::Inbound);
+        const StageStats* stage = find_stage(stats, "store");
+        check(stage && stage->batches < 25, "written in batches");
+
+        daemon.stop();
+        store.close();
+    }
+
+    std::cout << "\n[5] C API...\n";
+    meshcore* core = meshcore_create();
+    meshcore_stage_stats stats[8];
+    check(meshcore_get_stage_stats(core, MESHCORE_INBOUND, nullptr, 0) == 7, "stage count");
+    check(meshcore_get_stage_stats(core, MESHCORE_OUTBOUND, stats, 8) == 3 &&
+          std::string(stats[0].name) == "send", "stage names");
+    check(meshcore_remove_stage(core, MESHCORE_INBOUND, "ui") == MESHCORE_OK, "stage removed");
+    check(meshcore_remove_stage(core, MESHCORE_INBOUND, "ui") == MESHCORE_ERROR_INVALID_PARAM, "unknown stage");
+    check(meshcore_get_stage_stats(core, MESHCORE_INBOUND, stats, 2) == 6, "count beyond capacity");
+    meshcore_destroy(core);
+
+    std::filesystem::remove_all(root);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
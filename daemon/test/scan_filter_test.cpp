@@ -0,0 +1,321 @@
+/**
+ * Scan Filter Test
+ *
+ * Tests duplicate and stale report dropping, EWMA and Kalman smoothing
+ * of noisy RSSI, the Found / Updated / Lost changes (one per device per
+ * batch), expiry and eviction, then delivery through a running daemon
+ * and the C API.
+ */
+
+#include "scan_filter.h"
+#include "daemon.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static DeviceId device(uint8_t n) {
+    DeviceId id{};
+    id[0] = n;
+    id[15] = uint8_t(0xA0 | n);
+    return id;
+}
+
+static ScanReport report(uint8_t n, int32_t rssi, int64_t timestamp_ms) {
+    return ScanReport{device(n), rssi, timestamp_ms};
+}
+
+static size_t count_kind(const std::vector<DiscoveryChange>& changes, DiscoveryKind kind) {
+    size_t n = 0;
+    for (const auto& change : changes) {
+        n += change.kind == kind ? 1 : 0;
+    }
+    return n;
+}
+
+// Mean absolute error of a filter tracking a steady -70 dBm device
+// through ±12 dB of noise, one sample every 100 ms
+static double tracking_error(RssiFilter filter) {
+    ScanConfig config;
+    config.filter = filter;
+    config.rssi_change_db = 1000;
+    ScanFilter scans(config);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> noise(-12, 12);
+    std::vector<DiscoveryChange> changes;
+    double error = 0;
+    int samples = 0;
+    for (int i = 0; i < 200; ++i) {
+        const ScanReport r = report(1, -70 + noise(rng), 1000 + i * 100);
+        scans.ingest(&r, 1, changes);
+        int32_t rssi = 0;
+        if (i >= 20 && scans.rssi(device(1), rssi)) {
+            error += std::abs(rssi + 70);
+            samples++;
+        }
+    }
+    return samples ? error / samples : 1e9;
+}
+
+int main() {
+    std::cout << "=== Scan Filter Test ===\n\n";
+
+    std::cout << "[1] Duplicates and stale reports...\n";
+    {
+        ScanFilter scans;
+        std::vector<DiscoveryChange> changes;
+
+        const ScanReport first[] = {
+            report(1, -60, 1000),
+            report(1, -60, 1000),     // Same advertisement reported twice
+            report(1, -61, 900),      // Older than what we have
+            report(2, -70, 1000),
+        };
+        check(scans.ingest(first, 4, changes) == 2, "two devices found");
+        check(count_kind(changes, DiscoveryKind::Found) == 2, "both Found");
+
+        const ScanStats stats = scans.stats();
+        check(stats.reports == 4, "every report counted");
+        check(stats.duplicates == 2, "repeat and stale report dropped");
+        check(stats.devices == 2 && stats.present == 2, "two tracked, two present");
+
+        changes.clear();
+        const ScanReport again[] = { report(1, -60, 1000), report(2, -70, 1000) };
+        check(scans.ingest(again, 2, changes) == 0, "replayed batch yields nothing");
+    }
+
+    std::cout << "\n[2] Smoothing...\n";
+    {
+        const double ewma = tracking_error(RssiFilter::Ewma);
+        const double kalman = tracking_error(RssiFilter::Kalman);
+        std::cout << "    Mean error: EWMA " << ewma << " dB, Kalman " << kalman << " dB (raw ~6 dB)\n";
+        check(ewma < 4.0, "EWMA well under the raw noise");
+        check(kalman < 3.0, "Kalman settles closer still");
+
+        // A steady device in ±4 dB of noise is never reported as moving
+        ScanFilter scans;
+        std::vector<DiscoveryChange> changes;
+        for (int i = 0; i < 100; ++i) {
+            const ScanReport r = report(1, -65 + (i % 2 ? 4 : -4), 1000 + i * 100);
+            scans.ingest(&r, 1, changes);
+        }
+        check(changes.size() == 1 && changes[0].kind == DiscoveryKind::Found, "jitter alone never Updated");
+    }
+
+    std::cout << "\n[3] Found, Updated and Lost...\n";
+    {
+        ScanConfig config;
+        config.filter = RssiFilter::Ewma;
+        config.ewma_alpha = 1.0f;     // Raw values, to pin the thresholds
+        config.rssi_change_db = 5;
+        config.min_rssi = -90;
+        ScanFilter scans(config);
+        std::vector<DiscoveryChange> changes;
+
+        ScanReport r = report(1, -95, 1000);
+        scans.ingest(&r, 1, changes);
+        check(changes.empty(), "too weak to be present");
+
+        r = report(1, -80, 1100);
+        scans.ingest(&r, 1, changes);
+        check(changes.size() == 1 && changes[0].kind == DiscoveryKind::Found && changes[0].rssi == -80,
+              "Found once strong enough");
+
+        changes.clear();
+        r = report(1, -77, 1200);
+        scans.ingest(&r, 1, changes);
+        check(changes.empty(), "3 dB move not reported");
+        r = report(1, -75, 1300);
+        scans.ingest(&r, 1, changes);
+        check(changes.size() == 1 && changes[0].kind == DiscoveryKind::Updated && changes[0].rssi == -75,
+              "5 dB move Updated");
+
+        changes.clear();
+        r = report(1, -92, 1400);
+        scans.ingest(&r, 1, changes);
+        check(changes.size() == 1 && changes[0].kind == DiscoveryKind::Lost, "Lost under the floor");
+
+        changes.clear();
+        const ScanReport burst[] = {
+            report(1, -70, 1500), report(1, -60, 1510), report(1, -50, 1520), report(1, -40, 1530),
+        };
+        scans.ingest(burst, 4, changes);
+        check(changes.size() == 1 && changes[0].kind == DiscoveryKind::Found && changes[0].rssi == -40,
+              "one change per device per batch, at the latest value");
+        check(changes[0].last_seen == 1530, "last_seen is the latest report");
+    }
+
+    std::cout << "\n[4] Expiry and eviction...\n";
+    {
+        ScanConfig config;
+        config.lost_after_ms = 1000;
+        config.max_devices = 3;
+        ScanFilter scans(config);
+        std::vector<DiscoveryChange> changes;
+
+        const ScanReport first[] = { report(1, -60, 1000), report(2, -60, 1500), report(3, -60, 1800) };
+        scans.ingest(first, 3, changes);
+        changes.clear();
+
+        check(scans.expire(1900, changes) == 0, "nothing silent yet");
+        check(scans.expire(2100, changes) == 1 && changes[0].id == device(1), "silent device Lost");
+        int32_t rssi = 0;
+        check(!scans.rssi(device(1), rssi) && scans.rssi(device(2), rssi), "lost device no longer present");
+        check(scans.stats().devices == 3, "kept for a quick return");
+
+        changes.clear();
+        check(scans.expire(3100, changes) == 2, "the other two Lost");
+        check(scans.stats().devices == 2, "device 1 forgotten after twice lost_after");
+
+        changes.clear();
+        const ScanReport back[] = { report(2, -50, 3200), report(3, -50, 3200), report(4, -50, 3200), report(5, -50, 3200) };
+        scans.ingest(back, 4, changes);
+        const ScanStats stats = scans.stats();
+        check(stats.evicted == 1 && stats.devices == 3, "table bounded, one device evicted");
+        check(count_kind(changes, DiscoveryKind::Found) == 3, "the survivors Found");
+    }
+
+    std::cout << "\n[5] Daemon delivery...\n";
+    {
+        // Daemon log lines are not part of the test output
+        std::ostringstream sink;
+        std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+
+        Daemon daemon;
+        ScanConfig config;
+        config.lost_after_ms = 100;
+        daemon.set_scan_config(config);
+
+        std::mutex mutex;
+        std::vector<DiscoveryChange> seen;
+        std::atomic<bool> on_worker{true};
+        std::thread::id caller = std::this_thread::get_id();
+
+        DaemonCallbacks callbacks;
+        callbacks.on_discovery = [&](const std::vector<DiscoveryChange>& changes) {
+            if (std::this_thread::get_id() == caller) {
+                on_worker = false;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            seen.insert(seen.end(), changes.begin(), changes.end());
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+
+        const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        std::vector<ScanReport> batch;
+        for (int i = 0; i < 50; ++i) {
+            batch.push_back(report(uint8_t(i % 5), -60 - i % 3, now + i));
+        }
+        const size_t changed = daemon.ingest_scans(batch.data(), batch.size());
+
+        auto seen_count = [&](DiscoveryKind kind) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return count_kind(seen, kind);
+        };
+        const bool found = wait_until([&] { return seen_count(DiscoveryKind::Found) == 5; });
+        const bool lost = wait_until([&] { return seen_count(DiscoveryKind::Lost) == 5; }, 3000);
+        daemon.stop();
+        std::cout.rdbuf(saved);
+
+        check(changed == 5, "50 reports, 5 changes");
+        check(found, "Found changes delivered");
+        check(lost, "Lost changes delivered by maintenance");
+        check(on_worker, "callbacks on the worker thread");
+        check(daemon.scan_stats().present == 0, "nothing present afterwards");
+    }
+
+    std::cout << "\n[6] C API...\n";
+    {
+        meshcore* core = meshcore_create();
+
+        struct Seen {
+            std::mutex mutex;
+            std::vector<meshcore_discovery> changes;
+        } seen;
+        meshcore_set_discovery_callback(core, [](void* user_data, const meshcore_discovery* changes, size_t count) {
+            Seen* seen = static_cast<Seen*>(user_data);
+            std::lock_guard<std::mutex> lock(seen->mutex);
+            seen->changes.insert(seen->changes.end(), changes, changes + count);
+        }, &seen);
+
+        meshcore_scan_policy policy = {};
+        policy.filter = MESHCORE_RSSI_EWMA;
+        policy.ewma_alpha = 0.5f;
+        policy.rssi_change_db = 5;
+        policy.min_rssi = -90;
+        policy.lost_after_ms = 10000;
+        policy.max_devices = 16;
+        check(meshcore_set_scan_policy(core, &policy) == MESHCORE_OK, "policy set");
+        policy.ewma_alpha = 0.0f;
+        check(meshcore_set_scan_policy(core, &policy) == MESHCORE_ERROR_INVALID_PARAM, "zero alpha rejected");
+        check(meshcore_set_scan_policy(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null policy rejected");
+
+        meshcore_scan_report reports[3] = {};
+        for (int i = 0; i < 3; ++i) {
+            reports[i].identifier[0] = 0x42;
+            reports[i].rssi = -60;
+            reports[i].timestamp = 0;     // Stamped on arrival
+        }
+        reports[2].identifier[0] = 0x43;
+        reports[2].rssi = -99;
+        size_t changes = 0;
+        check(meshcore_ingest_scan_batch(core, reports, 3, &changes) == MESHCORE_OK && changes == 1,
+              "one device strong enough");
+        check(meshcore_ingest_scan_batch(core, nullptr, 1, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null batch rejected");
+        check(meshcore_ingest_scan_batch(core, nullptr, 0, nullptr) == MESHCORE_OK, "empty batch accepted");
+
+        const bool delivered = wait_until([&] {
+            std::lock_guard<std::mutex> lock(seen.mutex);
+            return !seen.changes.empty();
+        });
+        {
+            std::lock_guard<std::mutex> lock(seen.mutex);
+            check(delivered && seen.changes.size() == 1, "change delivered");
+            check(delivered && seen.changes[0].identifier[0] == 0x42 &&
+                  seen.changes[0].kind == MESHCORE_DISCOVERY_FOUND && seen.changes[0].rssi == -60,
+                  "identifier, kind and RSSI carried");
+            check(delivered && seen.changes[0].last_seen > 0, "timestamp stamped");
+        }
+
+        meshcore_scan_stats stats;
+        check(meshcore_get_scan_stats(core, &stats) == MESHCORE_OK, "stats read");
+        check(stats.reports == 3 && stats.devices == 2 && stats.present == 1, "counters match");
+        check(meshcore_get_scan_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+
+        meshcore_destroy(core);
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,288 @@
+/**
+ * Signature Test
+ *
+ * Tests Ed25519 against RFC 8032 vectors, batch verification (including
+ * isolating bad signatures), the verifier pool's batching of a burst,
+ * signed delivery through the core, and signer keys bound to UIDs.
+ */
+
+#include "ed25519.h"
+#include "sha512.h"
+#include "signature_verifier.h"
+#include "meshcore.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static std::vector<uint8_t> unhex(const char* s) {
+    std::vector<uint8_t> out;
+    for (; s[0] && s[1]; s += 2) {
+        out.push_back(static_cast<uint8_t>(std::stoi(std::string(s, 2), nullptr, 16)));
+    }
+    return out;
+}
+
+static bool equal(const uint8_t* a, const std::vector<uint8_t>& b) {
+    return std::memcmp(a, b.data(), b.size()) == 0;
+}
+
+struct Signed {
+    uint8_t     public_key[32];
+    uint8_t     signature[64];
+    std::string message;
+};
+
+static std::vector<Signed> make_signed(size_t count) {
+    std::vector<Signed> out(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t seed[32] = {};
+        seed[0] = static_cast<uint8_t>(i);
+        seed[1] = static_cast<uint8_t>(i >> 8);
+        out[i].message = "relayed message " + std::to_string(i);
+        ed25519_public_key(seed, out[i].public_key);
+        ed25519_sign(seed, out[i].public_key,
+                     reinterpret_cast<const uint8_t*>(out[i].message.data()), out[i].message.size(),
+                     out[i].signature);
+    }
+    return out;
+}
+
+static std::vector<Ed25519BatchItem> items_of(const std::vector<Signed>& sigs) {
+    std::vector<Ed25519BatchItem> items;
+    for (const auto& s : sigs) {
+        items.push_back(Ed25519BatchItem{
+            s.public_key, reinterpret_cast<const uint8_t*>(s.message.data()), s.message.size(), s.signature
+        });
+    }
+    return items;
+}
+
+static std::atomic<int> received(0);
+static std::mutex received_mutex;
+static std::vector<std::string> messages;
+
+static std::vector<std::string> signers;
+
+static void on_message(void*, uint64_t, const char*, const char* msg, size_t len, int64_t) {
+    std::lock_guard<std::mutex> lock(received_mutex);
+    messages.emplace_back(msg, len);
+    received++;
+}
+
+static void on_signed_message(void*, uint64_t, const char*, const char* msg, size_t len, int64_t,
+                              const uint8_t* public_key) {
+    std::lock_guard<std::mutex> lock(received_mutex);
+    messages.emplace_back(msg, len);
+    signers.emplace_back(reinterpret_cast<const char*>(public_key), MESHCORE_PUBLIC_KEY_SIZE);
+    received++;
+}
+
+static std::string key_bytes(const uint8_t* key) {
+    return std::string(reinterpret_cast<const char*>(key), MESHCORE_PUBLIC_KEY_SIZE);
+}
+
+int main() {
+    std::cout << "=== Signature Test ===\n\n";
+
+    std::cout << "[1] RFC 8032 vectors...\n";
+    Sha512Digest abc = Sha512::hash("abc", 3);
+    check(equal(abc.data(), unhex("ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                                  "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f")),
+          "SHA-512(\"abc\")");
+
+    const auto seed1 = unhex("9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60");
+    uint8_t pk[32];
+    uint8_t sig[64];
+    ed25519_public_key(seed1.data(), pk);
+    check(equal(pk, unhex("d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a")),
+          "public key (test 1)");
+    ed25519_sign(seed1.data(), pk, nullptr, 0, sig);
+    check(equal(sig, unhex("e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e06522490155"
+                           "5fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b")),
+          "signature (test 1)");
+    check(ed25519_verify(pk, nullptr, 0, sig), "verifies");
+
+    const auto seed2 = unhex("4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb");
+    const uint8_t msg2 = 0x72;
+    ed25519_public_key(seed2.data(), pk);
+    ed25519_sign(seed2.data(), pk, &msg2, 1, sig);
+    check(equal(sig, unhex("92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da"
+                           "085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00")),
+          "signature (test 2)");
+
+    uint8_t other = 0x73;
+    check(!ed25519_verify(pk, &other, 1, sig), "wrong message rejected");
+
+    // S + L verifies the same equation but is not canonical
+    uint8_t malleable[64];
+    std::memcpy(malleable, sig, 64);
+    const auto l = unhex("edd3f55c1a631258d69cf7a2def9de1400000000000000000000000000000010");
+    unsigned carry = 0;
+    for (int i = 0; i < 32; ++i) {
+        carry += malleable[32 + i] + l[i];
+        malleable[32 + i] = static_cast<uint8_t>(carry);
+        carry >>= 8;
+    }
+    check(!ed25519_verify(pk, &msg2, 1, malleable), "non-canonical S rejected");
+
+    std::cout << "\n[2] Batch verification...\n";
+    std::vector<Signed> sigs = make_signed(48);
+    std::vector<Ed25519BatchItem> items = items_of(sigs);
+    bool valid[48];
+    check(ed25519_verify_batch(items.data(), items.size(), valid), "48 valid signatures");
+
+    sigs[5].signature[10] ^= 1;
+    sigs[31].message[0] = 'R';
+    sigs[40].public_key[3] ^= 0x40;
+    items = items_of(sigs);
+    const bool all = ed25519_verify_batch(items.data(), items.size(), valid);
+    bool isolated = !all;
+    for (size_t i = 0; i < sigs.size(); ++i) {
+        isolated = isolated && (valid[i] == (i != 5 && i != 31 && i != 40));
+    }
+    check(isolated, "bad signatures isolated by bisection");
+
+    std::cout << "\n[3] Verifier pool...\n";
+    std::atomic<int> good(0);
+    std::atomic<int> bad(0);
+    {
+        VerifierConfig config;
+        config.max_batch = 32;
+        config.latency_budget = std::chrono::milliseconds(100);
+        config.threads = 2;
+
+        SignatureVerifier verifier(config, [&](uint64_t, uint64_t, std::string&& payload, const SignerKey&, bool ok) {
+            (ok && payload.compare(0, 7, "payload") == 0 ? good : bad)++;
+        });
+
+        // Signed up front so the frames arrive as one burst, however slow
+        // the build signs
+        uint8_t seed[32] = { 7 };
+        const SigningKey key = SigningKey::from_seed(seed);
+        std::vector<std::string> frames;
+        for (int i = 0; i < 100; ++i) {
+            frames.push_back(SignatureVerifier::sign_frame(key, "payload " + std::to_string(i)));
+            if (i % 25 == 0) {
+                frames.back().back() ^= 1;
+            }
+        }
+        frames.push_back("not a signed frame");
+        for (size_t i = 0; i < frames.size(); ++i) {
+            verifier.submit(1, i, std::move(frames[i]));
+        }
+
+        for (int i = 0; i < 6000 && good + bad < 101; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        VerifierStats stats = verifier.stats();
+        std::cout << "    batches=" << stats.batches << " max_latency=" << stats.max_latency_us << "us\n";
+        check(good == 96 && bad == 5, "valid delivered, invalid rejected");
+        check(stats.verified == 96 && stats.rejected == 5, "stats account for every frame");
+        check(stats.batches >= 4, "batches capped at max_batch");
+        check(stats.batches <= 16, "a burst is verified in full batches");
+    }
+    {
+        VerifierConfig config;
+        config.latency_budget = std::chrono::seconds(10);
+        config.max_pending = 2;
+
+        SignatureVerifier verifier(config, [](uint64_t, uint64_t, std::string&&, const SignerKey&, bool) {});
+        bool queued = true;
+        for (uint64_t i = 0; i < 2; ++i) {
+            queued = verifier.submit(1, i, "frame") && queued;
+        }
+        check(queued && !verifier.submit(1, 2, "frame"), "queue bounded by max_pending");
+        check(verifier.stats().dropped == 1, "overflow counted");
+    }
+
+    std::cout << "\n[4] Signed delivery...\n";
+    meshcore* core = meshcore_create();
+    meshcore_callbacks callbacks = {};
+    callbacks.on_message = on_message;
+    meshcore_set_callbacks(core, &callbacks);
+    meshcore_set_signed_message_callback(core, on_signed_message, nullptr);
+    meshcore_simulate_peer_connect(core, 3, "dave");
+
+    uint8_t seed[MESHCORE_SIGNING_SEED_SIZE] = { 1, 2, 3 };
+    uint8_t public_key[MESHCORE_PUBLIC_KEY_SIZE];
+    check(meshcore_set_signing_key(core, seed, public_key) == MESHCORE_OK, "signing key set");
+
+    // Inline verification (no pool yet); pins the key to "dave"
+    meshcore_send_message(core, 3, "signed inline", 13);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    {
+        std::lock_guard<std::mutex> lock(received_mutex);
+        check(received == 1 && messages.back() == "signed inline", "verified inline");
+        check(signers.size() == 1 && signers.back() == key_bytes(public_key), "signer reported");
+    }
+
+    check(meshcore_enable_batch_verification(core, 16, 5000, 2) == MESHCORE_OK, "pool enabled");
+    check(meshcore_enable_batch_verification(core, 16, 5000, 2) == MESHCORE_ERROR_INVALID_PARAM,
+          "pool enabled only once");
+
+    for (int i = 0; i < 20; ++i) {
+        std::string msg = "signed " + std::to_string(i);
+        meshcore_send_message(core, 3, msg.c_str(), msg.size());
+    }
+
+    // Tampered under dave's key: fails verification
+    std::string frame = SignatureVerifier::sign_frame(SigningKey::from_seed(seed), "tampered");
+    frame[frame.size() - 1] = 'X';
+    meshcore_simulate_message(core, 3, frame.data(), frame.size());
+
+    // Validly signed with a key of the sender's own: not dave's
+    uint8_t stranger[32] = { 9 };
+    const SigningKey impostor = SigningKey::from_seed(stranger);
+    frame = SignatureVerifier::sign_frame(impostor, "impostor");
+    meshcore_simulate_message(core, 3, frame.data(), frame.size());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    check(received == 21, "batched messages delivered, forgeries dropped");
+
+    meshcore_verification_stats stats;
+    meshcore_get_verification_stats(core, &stats);
+    check(stats.verified == 20 && stats.rejected == 1, "stats count verified and rejected frames");
+
+    std::cout << "\n[5] Directory keys...\n";
+    // The directory's key for a UID overrides the pinned one
+    const meshcore_contact contacts[] = { { "dave", MESHCORE_CONTACT_CONTACT, "Dave", impostor.public_key.data() } };
+    check(meshcore_rebuild_contacts(core, contacts, 1, nullptr, false) == MESHCORE_OK, "directory with dave's key");
+    for (int i = 0; i < 100 && meshcore_lookup_contact(core, "dave", nullptr) != MESHCORE_OK; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    meshcore_simulate_message(core, 3, frame.data(), frame.size());
+    meshcore_send_message(core, 3, "old key", 7);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    {
+        std::lock_guard<std::mutex> lock(received_mutex);
+        check(received == 22 && messages.back() == "impostor" &&
+              signers.back() == key_bytes(impostor.public_key.data()), "listed key accepted and reported");
+    }
+
+    meshcore_simulate_peer_connect(core, 4, "");
+    meshcore_simulate_message(core, 4, frame.data(), frame.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    check(received == 22, "signed frames from peers without a UID refused");
+
+    meshcore_destroy(core);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+/**
+ * Snapshot Test
+ *
+ * Tests snapshot encoding, validation and warm restart through the C API.
+ */
+
+#include "snapshot.h"
+#include "meshcore.h"
+#include <iostream>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+#include <cstring>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+int main() {
+    std::cout << "=== Snapshot Test ===\n\n";
+
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "meshcore_snapshot_test.bin").string();
+    std::filesystem::remove(path);
+
+    // Round trip
+    std::cout << "[1] Encoding/decoding...\n";
+    DaemonState state;
+    state.saved_at = 1700000000000;
+    for (int i = 0; i < 10000; ++i) {
+        KnownPeer peer;
+        peer.uid = "peer-" + std::to_string(i) + "@mesh";
+        peer.last_peer_id = 1000 + i;
+        peer.last_seen = 1700000000000 - i;
+        peer.tx_seq = i * 3;
+        peer.rx_seq = i * 7;
+        state.peers.push_back(peer);
+    }
+
+    std::string bytes = encode_snapshot(state);
+    DaemonState decoded;
+    check(decode_snapshot(bytes, decoded), "decodes");
+    check(decoded.peers.size() == 10000 && decoded.peers[42].uid == "peer-42@mesh" &&
+          decoded.peers[42].rx_seq == 294, "peers round-trip");
+    std::cout << "    10000 peers = " << bytes.size() << " bytes\n";
+
+    // Validation
+    std::cout << "\n[2] Rejecting damaged snapshots...\n";
+    std::string corrupt = bytes;
+    corrupt[bytes.size() / 2] ^= 0x40;
+    check(!decode_snapshot(corrupt, decoded), "bit flip rejected");
+    check(!decode_snapshot(bytes.substr(0, bytes.size() - 1), decoded), "truncation rejected");
+    check(!decode_snapshot(std::string(64, '\0'), decoded), "garbage rejected");
+
+    // Strings past the u16 length: keys are left out, previews cut
+    DaemonState oversized;
+    KnownPeer long_peer = state.peers[1];
+    long_peer.uid = std::string(70000, 'u');
+    oversized.peers.push_back(long_peer);
+    oversized.peers.push_back(state.peers[0]);
+    ConversationSummary long_key{};
+    long_key.conversation = std::string(70000, 'k');
+    ConversationSummary long_preview{};
+    long_preview.conversation = "bob@mesh";
+    long_preview.last_message = std::string(70000, 'p');
+    oversized.conversations.push_back(long_key);
+    oversized.conversations.push_back(long_preview);
+    uint64_t skipped = 0;
+    DaemonState restored;
+    check(decode_snapshot(encode_snapshot(oversized, &skipped), restored), "over-long strings still decode");
+    check(skipped == 2 && restored.peers.size() == 1 && restored.peers[0].uid == state.peers[0].uid,
+          "over-long UID skipped and counted");
+    check(restored.conversations.size() == 1 && restored.conversations[0].last_message.size() == 0xFFFF,
+          "over-long preview cut to fit");
+
+    // Restore speed
+    std::cout << "\n[3] Restoring from disk...\n";
+    check(write_snapshot_file(path, state), "atomic write");
+    auto t0 = std::chrono::steady_clock::now();
+    Daemon daemon;
+    DaemonState loaded;
+    bool ok = read_snapshot_file(path, loaded);
+    daemon.restore_known_peers(loaded.peers);
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+    check(ok && daemon.known_peers().size() == 10000, "10000 peers restored");
+    std::cout << "    restore took " << us << " us\n";
+    std::filesystem::remove(path);
+
+    // Warm restart through the C API
+    std::cout << "\n[4] Warm restart via C API...\n";
+    meshcore* core = meshcore_create_with_snapshot(path.c_str(), 50);
+    meshcore_simulate_peer_connect(core, 7, "alice@mesh");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    meshcore_send_message(core, 7, "hi", 2);
+    meshcore_send_message(core, 7, "again", 5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    meshcore_destroy(core);
+
+    DaemonState after;
+    check(read_snapshot_file(path, after), "snapshot written on destroy");
+    bool found = false;
+    for (const auto& peer : after.peers) {
+        if (peer.uid == "alice@mesh") {
+            found = peer.last_peer_id == 7 && peer.tx_seq == 2;
+        }
+    }
+    check(found, "alice and her sequence numbers saved");
+
+    core = meshcore_create_with_snapshot(path.c_str(), 0);
+    check(core != nullptr && meshcore_save_snapshot(core) == MESHCORE_OK, "restart from snapshot");
+    meshcore_destroy(core);
+    std::filesystem::remove(path);
+
+    std::cout << "\n=== Test Complete ===\n";
+    std::cout << "Failures: " << failures << "\n";
+
+    return failures == 0 ? 0 : 1;
+}
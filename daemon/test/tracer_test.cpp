@@ -0,0 +1,257 @@
+/**
+ * Tracer Test
+ *
+ * Tests that a disabled tracer records nothing, per-thread rings and
+ * their overwrite, clearing, the Chrome trace JSON, then the spans of a
+ * running daemon and the C API.
+ */
+
+#include "tracer.h"
+#include "daemon.h"
+#include "meshcore.h"
+#include "transport.h"
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static size_t count_of(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        count++;
+    }
+    return count;
+}
+
+static std::string exported(const Tracer& tracer) {
+    std::ostringstream out;
+    tracer.export_json(out);
+    return out.str();
+}
+
+class NullTransport : public Transport {
+public:
+    void send(uint64_t, const std::string&) override {}
+};
+
+int main() {
+    std::cout << "=== Tracer Test ===\n\n";
+
+    std::cout << "[1] Disabled...\n";
+    {
+        Tracer tracer;
+        Metrics metrics;
+        {
+            ScopedSpan span(metrics, Timing::Callback, tracer, TraceCategory::Callback, "on_message", 7);
+        }
+        check(tracer.stats().recorded == 0 && tracer.stats().threads == 0, "nothing recorded, no ring allocated");
+        check(metrics.snapshot().timing(Timing::Callback).count == 1, "metrics still recorded");
+
+        uint64_t hits = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 10000000; ++i) {
+            if (tracer.enabled()) {
+                hits++;
+            }
+        }
+        const double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()) / 10000000.0;
+        std::cout << "    " << ns << " ns per disabled check\n";
+        check(hits == 0, "branch never taken");
+    }
+
+    std::cout << "\n[2] Per-thread rings...\n";
+    {
+        Tracer tracer;
+        tracer.set_enabled(true);
+        tracer.name_thread("main");
+        tracer.instant(TraceCategory::Enqueue, "start", Metrics::now_ns());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&tracer, t] {
+                tracer.name_thread("writer " + std::to_string(t));
+                for (int i = 0; i < 100; ++i) {
+                    const uint64_t start = Metrics::now_ns();
+                    tracer.span(TraceCategory::Stage, "work", start, 1000, uint64_t(t), uint64_t(i));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        const TraceStats stats = tracer.stats();
+        check(stats.threads == 5, "one ring per thread");
+        check(stats.recorded == 401 && stats.retained == 401, "every record kept");
+
+        const std::string json = exported(tracer);
+        check(json.find("{\"displayTimeUnit") == 0 && json.find("]}") != std::string::npos, "JSON document");
+        check(count_of(json, "\"ph\":\"X\"") == 400, "spans exported");
+        check(count_of(json, "\"ph\":\"i\"") == 1, "instant exported");
+        check(count_of(json, "\"thread_name\"") == 5, "threads named");
+        check(json.find("\"writer 3\"") != std::string::npos && json.find("\"main\"") != std::string::npos,
+              "names carried");
+        check(json.find("\"dur\":1.000") != std::string::npos, "durations in microseconds");
+    }
+
+    std::cout << "\n[3] Overwrite and clear...\n";
+    {
+        Tracer tracer(16);
+        tracer.set_enabled(true);
+        for (int i = 0; i < 40; ++i) {
+            tracer.instant(TraceCategory::Dequeue, "event", Metrics::now_ns(), 0, uint64_t(i));
+        }
+        const TraceStats stats = tracer.stats();
+        check(stats.recorded == 40 && stats.retained == 16, "ring keeps the newest");
+
+        const std::string json = exported(tracer);
+        check(json.find("\"arg\":23}") == std::string::npos && json.find("\"arg\":24}") != std::string::npos &&
+              json.find("\"arg\":39}") != std::string::npos, "oldest overwritten");
+
+        tracer.clear();
+        check(tracer.stats().retained == 0, "cleared");
+        tracer.instant(TraceCategory::Dequeue, "after", Metrics::now_ns());
+        check(count_of(exported(tracer), "\"ph\":\"i\"") == 1, "records after clear kept");
+
+        tracer.instant(TraceCategory::Stage, "say \"hi\"\\\n", Metrics::now_ns());
+        check(exported(tracer).find("say \\\"hi\\\"\\\\\\u000a") != std::string::npos, "names escaped");
+
+        tracer.instant(TraceCategory::Stage, "a-name-well-over-the-record-limit", Metrics::now_ns());
+        check(exported(tracer).find("\"a-name-well-over-the-r\"") != std::string::npos, "long names cut");
+    }
+
+    std::cout << "\n[4] Daemon trace...\n";
+    {
+        // Daemon log lines are not part of the test output
+        std::ostringstream sink;
+        std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+
+        Daemon daemon;
+        NullTransport transport;
+        daemon.set_transport(&transport);
+
+        std::mutex mutex;
+        int delivered = 0;
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) {
+            std::lock_guard<std::mutex> lock(mutex);
+            delivered++;
+        };
+        daemon.set_callbacks(callbacks);
+        daemon.start();
+        daemon.set_tracing(true);
+
+        Daemon::Event connect;
+        connect.type = Daemon::EventType::PeerConnected;
+        connect.peer_id = 81;
+        connect.peer_uid = "traced@mesh";
+        daemon.enqueue_event(connect);
+        for (int i = 0; i < 20; ++i) {
+            Daemon::Event data;
+            data.type = Daemon::EventType::DataReceived;
+            data.peer_id = 81;
+            data.data = "msg " + std::to_string(i);
+            daemon.enqueue_event(data);
+        }
+        Daemon::Event send;
+        send.type = Daemon::EventType::SendMessage;
+        send.peer_id = 81;
+        send.data = "reply";
+        daemon.enqueue_event(send);
+
+        const bool received = wait_until([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return delivered == 20;
+        });
+        wait_until([&] {
+            const MetricsSnapshot s = daemon.metrics();
+            return s.counter(Counter::FramesSent) == 1;
+        });
+
+        std::ostringstream out;
+        daemon.export_trace(out);
+        const std::string json = out.str();
+        daemon.set_tracing(false);
+        const uint64_t before = daemon.trace_stats().recorded;
+        daemon.enqueue_event(connect);
+        wait_until([&] { return !daemon.is_busy(); }, 200);
+        const uint64_t after = daemon.trace_stats().recorded;
+
+        daemon.stop();
+        std::cout.rdbuf(saved);
+
+        check(received, "traffic processed");
+        check(json.find("\"name\":\"worker\"") != std::string::npos, "worker thread named");
+        check(json.find("\"cat\":\"enqueue\"") != std::string::npos, "enqueues traced");
+        check(json.find("\"name\":\"DataDecoded\",\"cat\":\"dequeue\"") != std::string::npos, "dequeues traced");
+        check(json.find("\"name\":\"inbound\",\"cat\":\"batch\"") != std::string::npos &&
+              json.find("\"name\":\"outbound\",\"cat\":\"batch\"") != std::string::npos, "batches traced");
+        check(json.find("\"name\":\"ui\",\"cat\":\"stage\"") != std::string::npos, "stages traced");
+        check(count_of(json, "\"name\":\"on_message\"") == 20, "each callback traced");
+        check(json.find("\"name\":\"send\",\"cat\":\"send\"") != std::string::npos, "transport send traced");
+        check(after == before, "nothing recorded once off");
+    }
+
+    std::cout << "\n[5] C API...\n";
+    {
+        meshcore* core = meshcore_create();
+        const std::string path = "/tmp/meshcore_tracer_test.json";
+
+        check(meshcore_set_tracing(core, true) == MESHCORE_OK, "tracing on");
+        meshcore_simulate_peer_connect(core, 91, "api@mesh");
+        wait_until([&] {
+            meshcore_trace_stats stats;
+            meshcore_get_trace_stats(core, &stats);
+            return stats.recorded > 0;
+        });
+
+        meshcore_trace_stats stats;
+        check(meshcore_get_trace_stats(core, &stats) == MESHCORE_OK && stats.enabled && stats.recorded > 0,
+              "stats read");
+        check(meshcore_export_trace(core, path.c_str()) == MESHCORE_OK, "exported");
+
+        std::ifstream in(path);
+        std::stringstream contents;
+        contents << in.rdbuf();
+        check(contents.str().find("\"PeerConnected\"") != std::string::npos, "file holds the trace");
+
+        check(meshcore_export_trace(core, "/nonexistent/dir/trace.json") == MESHCORE_ERROR_STORAGE,
+              "unwritable path reported");
+        check(meshcore_export_trace(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null path rejected");
+        check(meshcore_clear_trace(core) == MESHCORE_OK, "cleared");
+        check(meshcore_get_trace_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+
+        meshcore_destroy(core);
+        std::remove(path.c_str());
+    }
+
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
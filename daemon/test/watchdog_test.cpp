@@ -0,0 +1,408 @@
+/**
+ * Watchdog Test
+ *
+ * Tests stall checks against thresholds and their once-per-stall
+ * reports, stage names, the slow-handler histogram, the idle thread, a
+ * daemon whose message callback blocks (report, flight record and
+ * dump), a stale queue, and the C API.
+ */
+
+#include "watchdog.h"
+#include "daemon.h"
+#include "meshcore.h"
+#include "transport.h"
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << "    " << (ok ? "PASS" : "FAIL") << ": " << what << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool wait_until(const std::function<bool()>& done, int timeout_ms = 2000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+const uint64_t kMs = 1000000;
+
+// A message callback that blocks until released
+class Gate {
+public:
+    void block() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        entered_++;
+        cv_.wait(lock, [this] { return open_; });
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    int entered() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entered_;
+    }
+
+private:
+    std::mutex              mutex_;
+    std::condition_variable cv_;
+    bool                    open_ = false;
+    int                     entered_ = 0;
+};
+
+// Captured stall reports
+struct Reports {
+    std::mutex               mutex;
+    std::vector<StallReport> list;
+
+    void add(const StallReport& report) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_back(report);
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return list.size();
+    }
+
+    StallReport at(size_t i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return list[i];
+    }
+};
+
+class NullTransport : public Transport {
+public:
+    void send(uint64_t, const std::string&) override {}
+};
+
+static void connect_and_send(Daemon& daemon, uint64_t peer_id, int messages) {
+    Daemon::Event connect;
+    connect.type = Daemon::EventType::PeerConnected;
+    connect.peer_id = peer_id;
+    connect.peer_uid = "stalled@mesh";
+    daemon.enqueue_event(connect);
+    for (int i = 0; i < messages; ++i) {
+        Daemon::Event data;
+        data.type = Daemon::EventType::DataReceived;
+        data.peer_id = peer_id;
+        data.data = "message " + std::to_string(i);
+        daemon.enqueue_event(data);
+    }
+}
+
+int main() {
+    std::cout << "=== Watchdog Test ===\n\n";
+    const std::string path = "/tmp/meshcore_watchdog_test.bin";
+
+    std::cout << "[1] Thresholds...\n";
+    {
+        Metrics metrics;
+        Watchdog watchdog(metrics);
+        WatchdogConfig config;
+        config.handler_stall_ms = 100;
+        config.queue_stall_ms = 300;
+        watchdog.set_config(config);
+        Reports reports;
+        watchdog.set_callback([&](const StallReport& report) { reports.add(report); });
+
+        const uint64_t t0 = 1000 * kMs;
+        watchdog.set_queue(4, t0);
+        watchdog.begin("inbound", uint8_t(DaemonEventType::DataDecoded), 42, t0 + 10 * kMs);
+        watchdog.enter_stage("ui");
+
+        watchdog.check(t0 + 50 * kMs);
+        check(reports.size() == 0, "nothing under the thresholds");
+
+        watchdog.check(t0 + 120 * kMs);
+        check(reports.size() == 1, "handler stall reported");
+        const StallReport handler = reports.at(0);
+        check(handler.kind == StallKind::Handler && std::strcmp(handler.phase, "inbound") == 0 &&
+              std::strcmp(handler.stage, "ui") == 0, "phase and stage");
+        check(handler.event_type == uint8_t(DaemonEventType::DataDecoded) && handler.peer_id == 42 &&
+              handler.running_ns == 110 * kMs, "event and running time");
+        check(handler.queue_depth == 4 && handler.oldest_queued_ns == 120 * kMs, "queue state");
+
+        watchdog.check(t0 + 200 * kMs);
+        check(reports.size() == 1, "reported once per stall");
+
+        watchdog.check(t0 + 310 * kMs);
+        check(reports.size() == 2 && reports.at(1).kind == StallKind::Queue, "queue stall reported");
+        watchdog.check(t0 + 400 * kMs);
+        check(reports.size() == 2, "queue stall reported once");
+
+        // New work and a new oldest event are new stalls
+        watchdog.end(t0 + 400 * kMs);
+        watchdog.begin("task", uint8_t(DaemonEventType::TaskWakeup), 0, t0 + 500 * kMs);
+        watchdog.set_queue(1, t0 + 500 * kMs);
+        watchdog.check(t0 + 900 * kMs);
+        check(reports.size() == 4, "new work and queue reported again");
+        check(std::strcmp(reports.at(2).stage, "") == 0, "stage cleared with the work");
+
+        const WatchdogStats stats = watchdog.stats();
+        check(stats.checks == 6 && stats.handler_stalls == 2 && stats.queue_stalls == 2, "counters");
+
+        watchdog.end(t0 + 900 * kMs);
+        watchdog.set_queue(0, 0);
+        config.handler_stall_ms = 0;
+        config.queue_stall_ms = 0;
+        watchdog.set_config(config);
+        watchdog.begin("task", 0, 0, t0);
+        watchdog.set_queue(9, t0);
+        watchdog.check(t0 + 100000 * kMs);
+        check(reports.size() == 4, "zero thresholds not watched");
+        watchdog.end(t0);
+    }
+
+    std::cout << "\n[2] Stage names...\n";
+    {
+        Metrics metrics;
+        Watchdog watchdog(metrics);
+        Reports reports;
+        watchdog.set_callback([&](const StallReport& report) { reports.add(report); });
+        WatchdogConfig config;
+        config.handler_stall_ms = 1;
+        watchdog.set_config(config);
+
+        watchdog.begin("inbound", 0, 0, kMs);
+        watchdog.enter_stage(std::string(100, 's'));
+        watchdog.check(10 * kMs);
+        check(reports.size() == 1 && std::strlen(reports.at(0).stage) == StallReport::kStageSize - 1,
+              "long names truncated");
+
+        // Read while the worker renames the stage: always a whole name
+        watchdog.enter_stage("ui");
+        std::atomic<bool> done(false);
+        std::thread worker([&] {
+            for (int i = 0; !done; ++i) {
+                watchdog.enter_stage(i % 2 ? "conversations" : "ui");
+            }
+        });
+        bool whole = true;
+        for (uint64_t i = 0; i < 2000; ++i) {
+            watchdog.begin("inbound", 0, 0, (100 + i) * kMs);
+            watchdog.check((110 + i) * kMs);
+            const StallReport report = reports.at(reports.size() - 1);
+            whole = whole && (std::strcmp(report.stage, "ui") == 0 || std::strcmp(report.stage, "conversations") == 0);
+        }
+        done = true;
+        worker.join();
+        check(whole && reports.size() == 2001, "no torn names");
+    }
+
+    std::cout << "\n[3] Slow handlers...\n";
+    {
+        Metrics metrics;
+        Watchdog watchdog(metrics);
+        WatchdogConfig config;
+        config.slow_handler_ms = 20;
+        watchdog.set_config(config);
+
+        const uint64_t durations_ms[] = {1, 19, 20, 35, 500};
+        for (uint64_t ms : durations_ms) {
+            watchdog.begin("inbound", 0, 0, kMs);
+            watchdog.end(kMs + ms * kMs);
+        }
+        const LatencySummary slow = metrics.snapshot().timing(Timing::SlowHandler);
+        check(watchdog.stats().slow_handlers == 3 && slow.count == 3, "work past the threshold counted");
+        check(slow.max_ns >= 500 * kMs, "histogram holds the durations");
+    }
+
+    std::cout << "\n[4] Idle thread...\n";
+    {
+        Metrics metrics;
+        Watchdog watchdog(metrics);
+        WatchdogConfig config;
+        config.check_interval_ms = 5;
+        watchdog.set_config(config);
+        watchdog.start();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        check(watchdog.stats().checks == 0, "no checks while idle");
+
+        watchdog.begin("timers", 0, 0, Metrics::now_ns());
+        check(wait_until([&] { return watchdog.stats().checks >= 3; }), "checks while work runs");
+        watchdog.end(Metrics::now_ns());
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const uint64_t settled = watchdog.stats().checks;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        check(watchdog.stats().checks == settled, "asleep again once idle");
+
+        watchdog.set_queue(3, Metrics::now_ns());
+        check(wait_until([&] { return watchdog.stats().checks > settled; }), "queued events wake it");
+        watchdog.set_queue(0, 0);
+        watchdog.stop();
+    }
+
+    std::cout << "\n[5] Blocked callback...\n";
+    {
+        Daemon daemon;
+        NullTransport transport;
+        daemon.set_transport(&transport);
+        WatchdogConfig config;
+        config.handler_stall_ms = 100;
+        config.queue_stall_ms = 0;
+        config.check_interval_ms = 10;
+        daemon.set_watchdog_config(config);
+        std::remove(path.c_str());
+        daemon.set_flight_dump_path(path);
+
+        Gate gate;
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) { gate.block(); };
+        daemon.set_callbacks(callbacks);
+        Reports reports;
+        daemon.set_stall_callback([&](const StallReport& report) { reports.add(report); });
+        daemon.start();
+
+        connect_and_send(daemon, 77, 1);
+        check(wait_until([&] { return gate.entered() == 1; }), "worker blocked in the callback");
+        connect_and_send(daemon, 78, 3);
+
+        check(wait_until([&] { return reports.size() == 1; }), "stall reported");
+        const StallReport report = reports.at(0);
+        check(report.kind == StallKind::Handler && std::strcmp(report.phase, "inbound") == 0 &&
+              std::strcmp(report.stage, "ui") == 0, "phase and stage");
+        check(report.peer_id == 77 && report.running_ns >= 100 * kMs, "blocked work");
+        check(report.queue_depth >= 1 && report.oldest_queued_ns > 0, "queue grew behind it");
+        check(daemon.watchdog_stats().handler_stalls == 1, "counted");
+
+        FlightDump dump;
+        check(decode_flight_dump(read_file(path), dump) && dump.reason == FlightDumpReason::Watchdog,
+              "flight recorder dumped");
+        bool stalled = false;
+        for (const FlightRecord& record : dump.records) {
+            stalled = stalled || (record.outcome == FlightOutcome::Stalled && record.peer_id == 77 &&
+                                  record.type == uint8_t(DaemonEventType::DataDecoded));
+        }
+        check(stalled, "stalled work recorded");
+
+        gate.release();
+        check(wait_until([&] { return daemon.metrics().timing(Timing::SlowHandler).count >= 1; }),
+              "stall counted as a slow handler");
+        daemon.set_flight_dump_path(std::string());
+        daemon.stop();
+        check(reports.size() == 1, "one report for one stall");
+    }
+
+    std::cout << "\n[6] Stale queue...\n";
+    {
+        Daemon daemon;
+        NullTransport transport;
+        daemon.set_transport(&transport);
+        WatchdogConfig config;
+        config.handler_stall_ms = 0;
+        config.queue_stall_ms = 100;
+        config.check_interval_ms = 10;
+        daemon.set_watchdog_config(config);
+
+        Gate gate;
+        DaemonCallbacks callbacks;
+        callbacks.on_message = [&](uint64_t, const std::string&, const std::string&, int64_t) { gate.block(); };
+        daemon.set_callbacks(callbacks);
+        Reports reports;
+        daemon.set_stall_callback([&](const StallReport& report) { reports.add(report); });
+        daemon.start();
+
+        connect_and_send(daemon, 81, 1);
+        check(wait_until([&] { return gate.entered() == 1; }), "worker blocked");
+        check(daemon.watchdog_stats().queue_stalls == 0, "empty queue is not stale");
+        connect_and_send(daemon, 82, 2);
+
+        check(wait_until([&] { return reports.size() == 1; }), "stale queue reported");
+        const StallReport report = reports.at(0);
+        check(report.kind == StallKind::Queue && report.oldest_queued_ns >= 100 * kMs && report.queue_depth >= 1,
+              "queue state");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        check(reports.size() == 1 && daemon.watchdog_stats().handler_stalls == 0, "once, and handlers unwatched");
+
+        gate.release();
+        daemon.stop();
+    }
+
+    std::cout << "\n[7] C API...\n";
+    {
+        struct Captured {
+            std::atomic<int>   stalls{0};
+            std::atomic<int>   kind{-1};
+            std::atomic<bool>  ui{false};
+        } captured;
+
+        meshcore* core = meshcore_create();
+        meshcore_watchdog_policy policy = {50, 0, 5, 10};
+        check(meshcore_set_watchdog_policy(core, &policy) == MESHCORE_OK, "policy set");
+        meshcore_watchdog_policy bad = {50, 0, 0, 10};
+        check(meshcore_set_watchdog_policy(core, &bad) == MESHCORE_ERROR_INVALID_PARAM, "zero interval rejected");
+        check(meshcore_set_watchdog_policy(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null policy rejected");
+
+        Gate gate;
+        meshcore_callbacks callbacks = {};
+        callbacks.on_message = [](void* user_data, uint64_t, const char*, const char*, size_t, int64_t) {
+            static_cast<Gate*>(user_data)->block();
+        };
+        callbacks.user_data = &gate;
+        meshcore_set_callbacks(core, &callbacks);
+        check(meshcore_set_stall_callback(core, [](void* user_data, const meshcore_stall_report* report) {
+            Captured* c = static_cast<Captured*>(user_data);
+            c->kind = int(report->kind);
+            c->ui = std::strcmp(report->stage, "ui") == 0 && report->peer_id == 93 && report->running_ms >= 50;
+            c->stalls++;
+        }, &captured) == MESHCORE_OK, "callback set");
+
+        meshcore_simulate_peer_connect(core, 93, "api@mesh");
+        meshcore_simulate_message(core, 93, "hello", 5);
+        check(wait_until([&] { return captured.stalls == 1; }), "stall delivered");
+        check(captured.kind == MESHCORE_STALL_HANDLER && captured.ui, "report converted");
+
+        meshcore_watchdog_stats stats;
+        check(meshcore_get_watchdog_stats(core, &stats) == MESHCORE_OK && stats.handler_stalls == 1 &&
+              stats.checks > 0, "stats read");
+        check(meshcore_get_watchdog_stats(core, nullptr) == MESHCORE_ERROR_INVALID_PARAM, "null stats rejected");
+
+        gate.release();
+        meshcore_stats core_stats;
+        check(wait_until([&] {
+            return meshcore_get_stats(core, &core_stats) == MESHCORE_OK && core_stats.slow_handler.count >= 1;
+        }), "slow handler in meshcore_get_stats");
+        check(meshcore_set_stall_callback(core, nullptr, nullptr) == MESHCORE_OK, "callback cleared");
+
+        meshcore_destroy(core);
+    }
+
+    std::remove(path.c_str());
+    std::cout << "\nFailures: " << failures << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+/**
+ * Flight Decode
+ *
+ * Prints a flight recorder dump (meshcore_dump_flight_recorder, or the
+ * file a crash or watchdog wrote), oldest record first:
+ *
+ *   flight_decode <dump>
+ */
+
+#include "daemon.h"
+#include "basic_daemon_impl.h"
+#include "flight_recorder.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+static const char* reason_name(FlightDumpReason reason) {
+    switch (reason) {
+        case FlightDumpReason::OnDemand: return "on demand";
+        case FlightDumpReason::Fatal:    return "fatal error";
+        case FlightDumpReason::Watchdog: return "watchdog";
+    }
+    return "unknown";
+}
+
+static const char* outcome_name(FlightOutcome outcome) {
+    switch (outcome) {
+        case FlightOutcome::Completed: return "completed";
+        case FlightOutcome::Stopped:   return "stopped";
+        case FlightOutcome::Refused:   return "refused";
+        case FlightOutcome::Resumed:   return "resumed";
+        case FlightOutcome::Stalled:   return "STALLED";
+    }
+    return "unknown";
+}
+
+static const char* type_name(uint8_t type) {
+    return type == FlightRecorder::kNoEvent ? "-" : daemon_detail::event_name(DaemonEventType(type));
+}
+
+static double ms(uint64_t ns) {
+    return double(ns) / 1e6;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <dump>\n", argv[0]);
+        return 2;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    std::stringstream bytes;
+    bytes << in.rdbuf();
+    FlightDump dump;
+    if (!in || !decode_flight_dump(bytes.str(), dump)) {
+        std::fprintf(stderr, "%s: not a flight recorder dump\n", argv[1]);
+        return 1;
+    }
+
+    std::printf("=== Flight Recorder Dump (%s) ===\n\n", reason_name(dump.reason));
+    std::printf("  dumped at unix ms %lld; %zu records kept of %llu written\n\n",
+                static_cast<long long>(dump.dumped_unix_ms), dump.records.size(),
+                static_cast<unsigned long long>(dump.recorded));
+    std::printf("  %12s %10s %10s %10s %8s  %-18s %s\n",
+                "age ms", "wait ms", "handler ms", "peer", "bytes", "type", "outcome");
+
+    for (const FlightRecord& record : dump.records) {
+        const uint64_t age = dump.dumped_ns > record.started_ns ? dump.dumped_ns - record.started_ns : 0;
+        char wait[16] = "-";
+        if (record.queued_ns != 0 && record.started_ns >= record.queued_ns) {
+            std::snprintf(wait, sizeof(wait), "%.3f", ms(record.started_ns - record.queued_ns));
+        }
+        std::printf("  %12.3f %10s %10.3f %10llu %8u  %-18s %s\n",
+                    ms(age), wait, ms(record.duration_ns), static_cast<unsigned long long>(record.peer_id),
+                    record.size, type_name(record.type), outcome_name(record.outcome));
+    }
+    return 0;
+}